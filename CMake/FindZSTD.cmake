@@ -0,0 +1,24 @@
+# Find the Zstandard (zstd) include files and library.
+#
+# Zstandard is a fast lossless compression library.  See
+# http://www.zstd.net for more details.
+#
+# This module defines:
+# ZSTD_INCLUDE_DIRS - where to find zstd.h
+# ZSTD_LIBRARIES - the libraries to link against to use zstd
+# ZSTD_FOUND - if false the library was not found.
+
+find_path(ZSTD_INCLUDE_DIR "zstd.h"
+  DOC "Specify the zstd include directory here")
+
+find_library(ZSTD_LIBRARY
+  NAMES zstd
+  DOC "Specify the zstd library here")
+set(ZSTD_INCLUDE_DIRS ${ZSTD_INCLUDE_DIR})
+set(ZSTD_LIBRARIES "${ZSTD_LIBRARY}")
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(ZSTD DEFAULT_MSG
+  ZSTD_LIBRARIES ZSTD_INCLUDE_DIRS)
+
+mark_as_advanced(ZSTD_INCLUDE_DIR ZSTD_LIBRARY)
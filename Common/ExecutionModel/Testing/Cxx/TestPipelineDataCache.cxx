@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineDataCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataArray.h"
+#include "vtkImageAlgorithm.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineDataCache.h"
+#include "vtkPointData.h"
+#include "vtkSharedCachedStreamingDemandDrivenPipeline.h"
+
+#define CHECK(b, errors) if(!(b)){ errors++; cerr<<"Error on Line "<<__LINE__<<":"<<endl;}
+
+// An image source with ten time steps that counts its executions.
+class TestCachedTimeSource : public vtkImageAlgorithm
+{
+public:
+  static TestCachedTimeSource *New();
+  vtkTypeMacro(TestCachedTimeSource,vtkImageAlgorithm);
+  vtkGetMacro(NumberOfExecutions, int);
+
+protected:
+  TestCachedTimeSource()
+  {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfExecutions = 0;
+  }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+  {
+    vtkInformation *outInfo = outputVector->GetInformationObject(0);
+    int extent[6] = {0, 9, 0, 9, 0, 9};
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent, 6);
+    double steps[10];
+    for (int i = 0; i < 10; ++i)
+      {
+      steps[i] = i;
+      }
+    double range[2] = {0, 9};
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps, 10);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_FLOAT, 1);
+    return 1;
+  }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+  {
+    vtkInformation *outInfo = outputVector->GetInformationObject(0);
+    vtkImageData *output = vtkImageData::GetData(outInfo);
+    double time =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    output->SetExtent(
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()));
+    output->AllocateScalars(VTK_FLOAT, 1);
+    output->GetPointData()->GetScalars()->FillComponent(0, time);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    this->NumberOfExecutions++;
+    return 1;
+  }
+
+  int NumberOfExecutions;
+};
+vtkStandardNewMacro(TestCachedTimeSource);
+
+static double GetValueAtTime(TestCachedTimeSource* source,
+                             vtkStreamingDemandDrivenPipeline* executive,
+                             double time)
+{
+  source->UpdateInformation();
+  executive->SetUpdateTimeStep(0, time);
+  source->Update();
+  return source->GetOutput()->GetScalarComponentAsDouble(0, 0, 0, 0);
+}
+
+int TestPipelineDataCache(int, char*[])
+{
+  int errors = 0;
+
+  vtkNew<vtkPipelineDataCache> cache;
+  vtkNew<vtkSharedCachedStreamingDemandDrivenPipeline> executive;
+  executive->SetCache(cache.GetPointer());
+
+  vtkNew<TestCachedTimeSource> source;
+  source->SetExecutive(executive.GetPointer());
+
+  // Revisiting time steps must not execute the source again.
+  CHECK(GetValueAtTime(source.GetPointer(), executive.GetPointer(), 0) == 0,
+        errors);
+  CHECK(GetValueAtTime(source.GetPointer(), executive.GetPointer(), 1) == 1,
+        errors);
+  CHECK(GetValueAtTime(source.GetPointer(), executive.GetPointer(), 0) == 0,
+        errors);
+  CHECK(GetValueAtTime(source.GetPointer(), executive.GetPointer(), 1) == 1,
+        errors);
+  CHECK(source->GetNumberOfExecutions() == 2, errors);
+  CHECK(cache->GetNumberOfEntries() == 2, errors);
+  CHECK(cache->GetNumberOfHits() == 2, errors);
+
+  // Modifying the source invalidates the cache.
+  source->Modified();
+  CHECK(GetValueAtTime(source.GetPointer(), executive.GetPointer(), 0) == 0,
+        errors);
+  CHECK(source->GetNumberOfExecutions() == 3, errors);
+  CHECK(cache->GetNumberOfEntries() == 1, errors);
+
+  // A budget that holds a single output evicts the older time step.
+  cache->SetMaximumMemorySize(cache->GetMemorySize() * 3 / 2);
+  CHECK(GetValueAtTime(source.GetPointer(), executive.GetPointer(), 1) == 1,
+        errors);
+  CHECK(GetValueAtTime(source.GetPointer(), executive.GetPointer(), 0) == 0,
+        errors);
+  CHECK(source->GetNumberOfExecutions() == 5, errors);
+  CHECK(cache->GetNumberOfEntries() == 1, errors);
+  CHECK(cache->GetNumberOfEvictions() == 2, errors);
+
+  executive->SetCache(NULL);
+  CHECK(cache->GetNumberOfEntries() == 0, errors);
+
+  return errors;
+}
@@ -0,0 +1,110 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkExecutive.h"
+#include "vtkImageData.h"
+#include "vtkImageToStructuredGrid.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+#include "vtkTrivialProducer.h"
+
+#include <string>
+#include <vtksys/ios/sstream>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+int TestPipelineProfiler(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(10, 10, 10);
+  image->AllocateScalars(VTK_FLOAT, 1);
+
+  vtkNew<vtkTrivialProducer> producer;
+  producer->SetOutput(image.GetPointer());
+
+  vtkNew<vtkImageToStructuredGrid> filter;
+  filter->SetInputConnection(producer->GetOutputPort());
+
+  vtkNew<vtkPipelineProfiler> profiler;
+  vtkExecutive::SetPipelineProfiler(profiler.GetPointer());
+
+  // The first update executes the filter, the second must be
+  // satisfied from the existing output.
+  filter->Update();
+  filter->Update();
+
+  vtkExecutive::SetPipelineProfiler(NULL);
+
+  vtkNew<vtkTable> table;
+  profiler->ExportToTable(table.GetPointer());
+  if (table->GetNumberOfRows() != profiler->GetNumberOfRecords() ||
+      table->GetNumberOfRows() == 0)
+    {
+    cerr << "Unexpected number of records: "
+         << table->GetNumberOfRows() << endl;
+    return TEST_FAILURE;
+    }
+
+  vtkStringArray* classes =
+    vtkStringArray::SafeDownCast(table->GetColumnByName("Class"));
+  vtkStringArray* passes =
+    vtkStringArray::SafeDownCast(table->GetColumnByName("Pass"));
+  vtkIntArray* cacheHits =
+    vtkIntArray::SafeDownCast(table->GetColumnByName("CacheHit"));
+  if (!classes || !passes || !cacheHits)
+    {
+    cerr << "Missing table columns." << endl;
+    return TEST_FAILURE;
+    }
+
+  int executed = 0;
+  int skipped = 0;
+  for (vtkIdType i = 0; i < table->GetNumberOfRows(); ++i)
+    {
+    if (classes->GetValue(i) == "vtkImageToStructuredGrid" &&
+        passes->GetValue(i) == "RequestData")
+      {
+      if (cacheHits->GetValue(i))
+        {
+        ++skipped;
+        }
+      else
+        {
+        ++executed;
+        }
+      }
+    }
+  if (executed != 1 || skipped != 1)
+    {
+    cerr << "Expected one executed and one skipped RequestData pass, got "
+         << executed << " and " << skipped << endl;
+    return TEST_FAILURE;
+    }
+
+  vtksys_ios::ostringstream trace;
+  profiler->WriteChromeTrace(trace);
+  std::string json = trace.str();
+  if (json.find("\"traceEvents\"") == std::string::npos ||
+      json.find("\"name\":\"vtkImageToStructuredGrid\"") == std::string::npos)
+    {
+    cerr << "Unexpected trace output:\n" << json << endl;
+    return TEST_FAILURE;
+    }
+
+  return TEST_SUCCESS;
+}
@@ -0,0 +1,172 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedImageAlgorithmSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkThreadedImageAlgorithm.h"
+
+#include <vector>
+
+#define CHECK(b, errors) if(!(b)){ errors++; cerr<<"Error on Line "<<__LINE__<<":"<<endl;}
+
+//
+// This test checks that every output voxel is generated exactly once,
+// whatever the split mode and the execution method.
+//
+
+// A filter that adds one to its input and counts the writes of each voxel.
+class TestCountingImageFilter : public vtkThreadedImageAlgorithm
+{
+public:
+  static TestCountingImageFilter *New();
+  vtkTypeMacro(TestCountingImageFilter,vtkThreadedImageAlgorithm);
+
+  std::vector<int> Counts;
+  int WholeExtent[6];
+  int MaximumThreadId;
+
+protected:
+  TestCountingImageFilter()
+  {
+    this->MaximumThreadId = -1;
+  }
+
+  virtual void ThreadedRequestData(vtkInformation*, vtkInformationVector**,
+                                   vtkInformationVector*,
+                                   vtkImageData ***inData,
+                                   vtkImageData **outData,
+                                   int ext[6], int threadId)
+  {
+    int *we = this->WholeExtent;
+    int nx = we[1] - we[0] + 1;
+    int ny = we[3] - we[2] + 1;
+    for (int k = ext[4]; k <= ext[5]; k++)
+      {
+      for (int j = ext[2]; j <= ext[3]; j++)
+        {
+        for (int i = ext[0]; i <= ext[1]; i++)
+          {
+          float *inPtr =
+            static_cast<float *>(inData[0][0]->GetScalarPointer(i, j, k));
+          float *outPtr =
+            static_cast<float *>(outData[0]->GetScalarPointer(i, j, k));
+          *outPtr = *inPtr + 1;
+          this->Counts[((k - we[4])*ny + (j - we[2]))*nx + (i - we[0])]++;
+          }
+        }
+      }
+    // with the sequential backend there is no race on this value
+    if (threadId > this->MaximumThreadId)
+      {
+      this->MaximumThreadId = threadId;
+      }
+  }
+};
+vtkStandardNewMacro(TestCountingImageFilter);
+
+static int CheckSplit(vtkImageData *image, bool smp, int mode)
+{
+  int errors = 0;
+
+  vtkNew<TestCountingImageFilter> filter;
+  filter->SetInputData(image);
+  filter->SetEnableSMP(smp);
+  filter->SetSplitMode(mode);
+  filter->SetNumberOfThreads(3);
+  filter->SetMinimumPieceSize(4, 1, 1);
+  filter->SetDesiredBytesPerPiece(1000);
+  image->GetExtent(filter->WholeExtent);
+  filter->Counts.assign(image->GetNumberOfPoints(), 0);
+  filter->Update();
+
+  vtkImageData *output = filter->GetOutput();
+  int *ext = filter->WholeExtent;
+  vtkIdType idx = 0;
+  for (int k = ext[4]; k <= ext[5]; k++)
+    {
+    for (int j = ext[2]; j <= ext[3]; j++)
+      {
+      for (int i = ext[0]; i <= ext[1]; i++)
+        {
+        if (filter->Counts[idx] != 1 ||
+            output->GetScalarComponentAsDouble(i, j, k, 0) !=
+            image->GetScalarComponentAsDouble(i, j, k, 0) + 1)
+          {
+          cerr << "Voxel (" << i << "," << j << "," << k << ") written "
+               << filter->Counts[idx] << " times with SMP "
+               << (smp ? "on" : "off") << " and split mode " << mode << "\n";
+          return 1;
+          }
+        idx++;
+        }
+      }
+    }
+
+  // many more pieces than threads are expected, but slabs can be no
+  // thinner than one slice
+  if (smp)
+    {
+    int pieces = filter->MaximumThreadId + 1;
+    CHECK(pieces > 3, errors);
+    if (mode == vtkThreadedImageAlgorithm::SLAB)
+      {
+      int slices = (ext[5] > ext[4] ? ext[5] - ext[4] : ext[3] - ext[2]) + 1;
+      CHECK(pieces <= slices, errors);
+      }
+    }
+
+  return errors;
+}
+
+int TestThreadedImageAlgorithmSMP(int, char*[])
+{
+  int errors = 0;
+
+  CHECK(!vtkThreadedImageAlgorithm::GetGlobalDefaultEnableSMP(), errors);
+
+  // an image of 7200 floats, with odd sizes to get uneven pieces
+  vtkNew<vtkImageData> image;
+  image->SetExtent(-2, 17, 1, 18, 3, 22);
+  image->AllocateScalars(VTK_FLOAT, 1);
+  float *ptr = static_cast<float *>(image->GetScalarPointer());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); i++)
+    {
+    ptr[i] = static_cast<float>(i % 101);
+    }
+
+  for (int mode = vtkThreadedImageAlgorithm::SLAB;
+       mode <= vtkThreadedImageAlgorithm::BLOCK; mode++)
+    {
+    errors += CheckSplit(image.GetPointer(), false, mode);
+    errors += CheckSplit(image.GetPointer(), true, mode);
+    }
+
+  // a single slice is split along y
+  vtkNew<vtkImageData> slice;
+  slice->SetExtent(0, 99, 0, 79, 0, 0);
+  slice->AllocateScalars(VTK_FLOAT, 1);
+  ptr = static_cast<float *>(slice->GetScalarPointer());
+  for (vtkIdType i = 0; i < slice->GetNumberOfPoints(); i++)
+    {
+    ptr[i] = static_cast<float>(i % 37);
+    }
+  for (int mode = vtkThreadedImageAlgorithm::SLAB;
+       mode <= vtkThreadedImageAlgorithm::BLOCK; mode++)
+    {
+    errors += CheckSplit(slice.GetPointer(), true, mode);
+    }
+
+  return errors;
+}
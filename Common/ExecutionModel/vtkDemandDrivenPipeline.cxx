@@ -34,6 +34,7 @@
 #include "vtkInstantiator.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPipelineProfiler.h"
 
 #include <vector>
 
@@ -213,6 +214,7 @@ int vtkDemandDrivenPipeline::ProcessRequest(vtkInformation* request,
     // if we are up to date then short circuit
     if (this->PipelineMTime < this->InformationTime.GetMTime())
       {
+      this->RecordCacheHit(vtkPipelineProfiler::REQUEST_INFORMATION_PASS);
       return 1;
       }
     // Update inputs first.
@@ -287,6 +289,10 @@ int vtkDemandDrivenPipeline::ProcessRequest(vtkInformation* request,
       this->InformationTime.Modified();
       this->DataObjectTime.Modified();
       }
+    else
+      {
+      this->RecordCacheHit(vtkPipelineProfiler::REQUEST_DATA_PASS);
+      }
     return result;
     }
 
@@ -26,7 +26,9 @@
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
 
 #include <vector>
 #include <vtksys/ios/sstream>
@@ -42,6 +44,9 @@ vtkInformationKeyMacro(vtkExecutive, FROM_OUTPUT_PORT, Integer);
 vtkInformationKeyMacro(vtkExecutive, KEYS_TO_COPY, KeyVector);
 vtkInformationKeyMacro(vtkExecutive, PRODUCER, ExecutivePort);
 
+// The profiler shared by all executives.
+static vtkPipelineProfiler* vtkExecutivePipelineProfiler = 0;
+
 //----------------------------------------------------------------------------
 class vtkExecutiveInternals
 {
@@ -770,11 +775,27 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   // Copy default information in the direction of information flow.
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
+  // Time the request if the pipeline is being profiled.
+  vtkPipelineProfiler* profiler = vtkExecutivePipelineProfiler;
+  int pass = vtkPipelineProfiler::UNKNOWN_PASS;
+  double startTime = 0.0;
+  if(profiler)
+    {
+    pass = vtkPipelineProfiler::GetPassType(request);
+    startTime = vtkTimerLog::GetUniversalTime();
+    }
+
   // Invoke the request on the algorithm.
   this->InAlgorithm = 1;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
   this->InAlgorithm = 0;
 
+  if(profiler && pass != vtkPipelineProfiler::UNKNOWN_PASS)
+    {
+    profiler->RecordPass(this->Algorithm, pass, startTime,
+                         vtkTimerLog::GetUniversalTime(), inInfo, outInfo);
+    }
+
   // If the algorithm failed report it now.
   if(!result)
     {
@@ -787,6 +808,40 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   return result;
 }
 
+//----------------------------------------------------------------------------
+void vtkExecutive::SetPipelineProfiler(vtkPipelineProfiler* profiler)
+{
+  if(vtkExecutivePipelineProfiler == profiler)
+    {
+    return;
+    }
+  if(profiler)
+    {
+    profiler->Register(0);
+    }
+  vtkPipelineProfiler* old = vtkExecutivePipelineProfiler;
+  vtkExecutivePipelineProfiler = profiler;
+  if(old)
+    {
+    old->UnRegister(0);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler* vtkExecutive::GetPipelineProfiler()
+{
+  return vtkExecutivePipelineProfiler;
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutive::RecordCacheHit(int pass)
+{
+  if(vtkPipelineProfiler* profiler = vtkExecutivePipelineProfiler)
+    {
+    profiler->RecordCacheHit(this->Algorithm, pass);
+    }
+}
+
 //----------------------------------------------------------------------------
 int vtkExecutive::CheckAlgorithm(const char* method,
                                  vtkInformation* request)
@@ -39,6 +39,7 @@ class vtkInformationIntegerKey;
 class vtkInformationRequestKey;
 class vtkInformationKeyVectorKey;
 class vtkInformationVector;
+class vtkPipelineProfiler;
 
 class VTKCOMMONEXECUTIONMODEL_EXPORT vtkExecutive : public vtkObject
 {
@@ -187,6 +188,14 @@ public:
                             vtkInformationVector** inInfo,
                             vtkInformationVector* outInfo);
 
+  // Description:
+  // Set/Get the profiler that records the pipeline passes executed by
+  // all executives.  A reference is held to the profiler until it is
+  // replaced or set to NULL.  Profiling is disabled when no profiler
+  // is set, which is the default.
+  static void SetPipelineProfiler(vtkPipelineProfiler* profiler);
+  static vtkPipelineProfiler* GetPipelineProfiler();
+
 protected:
   vtkExecutive();
   ~vtkExecutive();
@@ -206,6 +215,11 @@ protected:
   // construct the error message.
   int CheckAlgorithm(const char* method, vtkInformation* request);
 
+  // Report to the pipeline profiler, if any, that the given pass (one
+  // of vtkPipelineProfiler::PassType) was satisfied without invoking
+  // the algorithm because the outputs are up to date.
+  void RecordCacheHit(int pass);
+
   virtual int ForwardDownstream(vtkInformation* request);
   virtual int ForwardUpstream(vtkInformation* request);
   virtual void CopyDefaultInformation(vtkInformation* request, int direction,
@@ -0,0 +1,352 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineDataCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPipelineDataCache.h"
+
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
+
+#include <list>
+#include <string>
+
+vtkStandardNewMacro(vtkPipelineDataCache);
+
+//----------------------------------------------------------------------------
+namespace
+{
+struct vtkPipelineDataCacheEntry
+{
+  vtkExecutive* Owner;
+  int Port;
+  std::string Signature;
+  vtkDataObject* Data;
+  unsigned long Time;
+  unsigned long Size;
+};
+}
+
+//----------------------------------------------------------------------------
+class vtkPipelineDataCacheInternals
+{
+public:
+  typedef std::list<vtkPipelineDataCacheEntry> EntryList;
+
+  // Most recently used entries are at the front.
+  EntryList Entries;
+  unsigned long MemorySize;
+  vtkSimpleCriticalSection Lock;
+
+  EntryList::iterator Erase(EntryList::iterator it)
+    {
+    this->MemorySize -= it->Size;
+    it->Data->Delete();
+    return this->Entries.erase(it);
+    }
+};
+
+//----------------------------------------------------------------------------
+// The global instance and its cleanup at exit.
+static vtkPipelineDataCache* vtkPipelineDataCacheGlobalInstance = 0;
+
+class vtkPipelineDataCacheCleanup
+{
+public:
+  ~vtkPipelineDataCacheCleanup()
+    {
+    vtkPipelineDataCache::SetGlobalCache(0);
+    }
+};
+static vtkPipelineDataCacheCleanup vtkPipelineDataCacheCleanupInstance;
+
+//----------------------------------------------------------------------------
+vtkPipelineDataCache::vtkPipelineDataCache()
+{
+  this->MaximumMemorySize = 1024 * 1024;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+  this->Internals = new vtkPipelineDataCacheInternals;
+  this->Internals->MemorySize = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineDataCache::~vtkPipelineDataCache()
+{
+  this->Clear();
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineDataCache* vtkPipelineDataCache::GetGlobalCache()
+{
+  if(!vtkPipelineDataCacheGlobalInstance)
+    {
+    vtkPipelineDataCacheGlobalInstance = vtkPipelineDataCache::New();
+    }
+  return vtkPipelineDataCacheGlobalInstance;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::SetGlobalCache(vtkPipelineDataCache* cache)
+{
+  if(vtkPipelineDataCacheGlobalInstance == cache)
+    {
+    return;
+    }
+  if(cache)
+    {
+    cache->Register(0);
+    }
+  vtkPipelineDataCache* old = vtkPipelineDataCacheGlobalInstance;
+  vtkPipelineDataCacheGlobalInstance = cache;
+  if(old)
+    {
+    old->UnRegister(0);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::SetMaximumMemorySize(unsigned long size)
+{
+  if(this->MaximumMemorySize == size)
+    {
+    return;
+    }
+  this->Internals->Lock.Lock();
+  this->MaximumMemorySize = size;
+  this->Prune();
+  this->Internals->Lock.Unlock();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPipelineDataCache::GetMemorySize()
+{
+  this->Internals->Lock.Lock();
+  unsigned long size = this->Internals->MemorySize;
+  this->Internals->Lock.Unlock();
+  return size;
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineDataCache::GetNumberOfEntries()
+{
+  this->Internals->Lock.Lock();
+  int n = static_cast<int>(this->Internals->Entries.size());
+  this->Internals->Lock.Unlock();
+  return n;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::ResetStatistics()
+{
+  this->Internals->Lock.Lock();
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::Clear()
+{
+  this->Internals->Lock.Lock();
+  vtkPipelineDataCacheInternals::EntryList::iterator it =
+    this->Internals->Entries.begin();
+  while(it != this->Internals->Entries.end())
+    {
+    it = this->Internals->Erase(it);
+    }
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::RemoveEntries(vtkExecutive* owner)
+{
+  this->Internals->Lock.Lock();
+  vtkPipelineDataCacheInternals::EntryList::iterator it =
+    this->Internals->Entries.begin();
+  while(it != this->Internals->Entries.end())
+    {
+    if(it->Owner == owner)
+      {
+      it = this->Internals->Erase(it);
+      }
+    else
+      {
+      ++it;
+      }
+    }
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::RemoveStaleEntries(vtkExecutive* owner,
+                                              unsigned long time)
+{
+  this->Internals->Lock.Lock();
+  vtkPipelineDataCacheInternals::EntryList::iterator it =
+    this->Internals->Entries.begin();
+  while(it != this->Internals->Entries.end())
+    {
+    if(it->Owner == owner && it->Time < time)
+      {
+      it = this->Internals->Erase(it);
+      }
+    else
+      {
+      ++it;
+      }
+    }
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineDataCache::Retrieve(vtkExecutive* owner, int port,
+                                   const char* signature, int extentType,
+                                   const int updateExtent[6],
+                                   vtkDataObject* output)
+{
+  if(!output || !signature)
+    {
+    return 0;
+    }
+
+  bool checkExtent = extentType == VTK_3D_EXTENT && updateExtent &&
+    updateExtent[0] <= updateExtent[1] &&
+    updateExtent[2] <= updateExtent[3] &&
+    updateExtent[4] <= updateExtent[5];
+
+  this->Internals->Lock.Lock();
+  vtkPipelineDataCacheInternals::EntryList::iterator it;
+  for(it = this->Internals->Entries.begin();
+      it != this->Internals->Entries.end(); ++it)
+    {
+    if(it->Owner != owner || it->Port != port ||
+       it->Signature != signature ||
+       strcmp(it->Data->GetClassName(), output->GetClassName()) != 0)
+      {
+      continue;
+      }
+    if(checkExtent)
+      {
+      int* dataExtent =
+        it->Data->GetInformation()->Get(vtkDataObject::DATA_EXTENT());
+      if(!dataExtent ||
+         updateExtent[0] < dataExtent[0] ||
+         updateExtent[1] > dataExtent[1] ||
+         updateExtent[2] < dataExtent[2] ||
+         updateExtent[3] > dataExtent[3] ||
+         updateExtent[4] < dataExtent[4] ||
+         updateExtent[5] > dataExtent[5])
+        {
+        continue;
+        }
+      }
+    break;
+    }
+
+  if(it == this->Internals->Entries.end())
+    {
+    ++this->NumberOfMisses;
+    this->Internals->Lock.Unlock();
+    return 0;
+    }
+
+  // Move the entry to the front of the LRU list.
+  this->Internals->Entries.splice(this->Internals->Entries.begin(),
+                                  this->Internals->Entries, it);
+  ++this->NumberOfHits;
+
+  output->ShallowCopy(it->Data);
+  output->DataHasBeenGenerated();
+  output->GetInformation()->Copy(it->Data->GetInformation());
+  this->Internals->Lock.Unlock();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::Insert(vtkExecutive* owner, int port,
+                                  const char* signature, vtkDataObject* data)
+{
+  if(!data || !signature)
+    {
+    return;
+    }
+
+  unsigned long size = data->GetActualMemorySize();
+
+  this->Internals->Lock.Lock();
+
+  // Replace any entry for the same request.
+  vtkPipelineDataCacheInternals::EntryList::iterator it =
+    this->Internals->Entries.begin();
+  while(it != this->Internals->Entries.end())
+    {
+    if(it->Owner == owner && it->Port == port && it->Signature == signature)
+      {
+      it = this->Internals->Erase(it);
+      }
+    else
+      {
+      ++it;
+      }
+    }
+
+  if(size <= this->MaximumMemorySize)
+    {
+    vtkPipelineDataCacheEntry entry;
+    entry.Owner = owner;
+    entry.Port = port;
+    entry.Signature = signature;
+    entry.Data = data->NewInstance();
+    entry.Data->ShallowCopy(data);
+    entry.Data->GetInformation()->Copy(data->GetInformation());
+    entry.Time = data->GetUpdateTime();
+    entry.Size = size;
+    this->Internals->Entries.push_front(entry);
+    this->Internals->MemorySize += size;
+    this->Prune();
+    }
+
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::Prune()
+{
+  while(this->Internals->MemorySize > this->MaximumMemorySize &&
+        !this->Internals->Entries.empty())
+    {
+    vtkPipelineDataCacheInternals::EntryList::iterator last =
+      this->Internals->Entries.end();
+    --last;
+    this->Internals->Erase(last);
+    ++this->NumberOfEvictions;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "MaximumMemorySize: " << this->MaximumMemorySize << endl;
+  os << indent << "MemorySize: " << this->GetMemorySize() << endl;
+  os << indent << "NumberOfEntries: " << this->GetNumberOfEntries() << endl;
+  os << indent << "NumberOfHits: " << this->NumberOfHits << endl;
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << endl;
+  os << indent << "NumberOfEvictions: " << this->NumberOfEvictions << endl;
+}
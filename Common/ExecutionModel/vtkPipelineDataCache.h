@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineDataCache.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPipelineDataCache - Memory budgeted LRU cache of algorithm outputs.
+// .SECTION Description
+// vtkPipelineDataCache stores shallow copies of the outputs produced by
+// algorithms, keyed by the executive and output port that produced them
+// and by the request they satisfied.  The request is described by a
+// signature string (piece, number of pieces, ghost levels, time step
+// and any other request keys the executive chooses to include) and a
+// structured extent.  A cached structured output satisfies any request
+// with the same signature whose update extent it contains.
+//
+// The total size of the cached data objects, as reported by
+// vtkDataObject::GetActualMemorySize(), is kept below
+// MaximumMemorySize by discarding the least recently used entries.
+// A single cache is normally shared by all executives of a pipeline
+// (see GetGlobalCache()) so that the budget applies to the pipeline
+// as a whole.  All methods are thread safe.
+//
+// .SECTION See Also
+// vtkSharedCachedStreamingDemandDrivenPipeline
+// vtkCachedStreamingDemandDrivenPipeline
+
+#ifndef __vtkPipelineDataCache_h
+#define __vtkPipelineDataCache_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkDataObject;
+class vtkExecutive;
+class vtkPipelineDataCacheInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineDataCache : public vtkObject
+{
+public:
+  static vtkPipelineDataCache *New();
+  vtkTypeMacro(vtkPipelineDataCache,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get the cache shared by all executives that have not been given a
+  // cache explicitly.  The instance is created on first use and
+  // deleted at exit.  SetGlobalCache() replaces it.
+  static vtkPipelineDataCache* GetGlobalCache();
+  static void SetGlobalCache(vtkPipelineDataCache* cache);
+
+  // Description:
+  // Set/Get the maximum total size of the cached data in kibibytes.
+  // Least recently used entries are discarded when the budget is
+  // exceeded.  Data objects larger than the budget are never cached.
+  // The default is 1 GiB.
+  virtual void SetMaximumMemorySize(unsigned long size);
+  vtkGetMacro(MaximumMemorySize, unsigned long);
+
+  // Description:
+  // Get the current total size of the cached data in kibibytes.
+  unsigned long GetMemorySize();
+
+  // Description:
+  // Get the number of cached data objects.
+  int GetNumberOfEntries();
+
+  // Description:
+  // Statistics on the use of the cache: the number of lookups that
+  // found a matching entry, the number that did not, and the number
+  // of entries discarded to stay within the memory budget.
+  vtkGetMacro(NumberOfHits, vtkIdType);
+  vtkGetMacro(NumberOfMisses, vtkIdType);
+  vtkGetMacro(NumberOfEvictions, vtkIdType);
+  void ResetStatistics();
+
+  // Description:
+  // Discard all entries.
+  void Clear();
+
+  // Description:
+  // Discard all entries produced by the given executive.
+  void RemoveEntries(vtkExecutive* owner);
+
+  // Description:
+  // Discard the entries produced by the given executive that were
+  // generated before the given modified time.
+  void RemoveStaleEntries(vtkExecutive* owner, unsigned long time);
+
+  // Description:
+  // Look for an entry produced by the given executive and port that
+  // satisfies a request.  If extentType is VTK_3D_EXTENT the cached
+  // extent must contain the given update extent; otherwise the extent
+  // is ignored.  On success the entry is shallow copied into output,
+  // together with its data information, and 1 is returned.
+  int Retrieve(vtkExecutive* owner, int port, const char* signature,
+               int extentType, const int updateExtent[6],
+               vtkDataObject* output);
+
+  // Description:
+  // Store a shallow copy of data generated by the given executive and
+  // port for the request described by signature.  Any entry for the
+  // same request is replaced.
+  void Insert(vtkExecutive* owner, int port, const char* signature,
+              vtkDataObject* data);
+
+protected:
+  vtkPipelineDataCache();
+  ~vtkPipelineDataCache();
+
+  // Discard least recently used entries until the budget is met.
+  // Must be called with the lock held.
+  void Prune();
+
+  unsigned long MaximumMemorySize;
+  vtkIdType NumberOfHits;
+  vtkIdType NumberOfMisses;
+  vtkIdType NumberOfEvictions;
+
+  vtkPipelineDataCacheInternals* Internals;
+
+private:
+  vtkPipelineDataCache(const vtkPipelineDataCache&);  // Not implemented.
+  void operator=(const vtkPipelineDataCache&);  // Not implemented.
+};
+
+#endif
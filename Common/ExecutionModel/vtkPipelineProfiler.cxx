@@ -0,0 +1,377 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPipelineProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+#include "vtkTimerLog.h"
+
+#include <string>
+#include <vector>
+#include <vtksys/ios/sstream>
+
+vtkStandardNewMacro(vtkPipelineProfiler);
+
+//----------------------------------------------------------------------------
+namespace
+{
+struct vtkPipelineProfilerRecord
+{
+  std::string ClassName;
+  vtkAlgorithm* Algorithm;
+  int Pass;
+  double Start;
+  double Duration;
+  int Thread;
+  vtkIdType InputSize;
+  vtkIdType OutputSize;
+  bool CacheHit;
+};
+
+// Sum the memory size of all data objects in a set of information vectors.
+vtkIdType vtkPipelineProfilerDataSize(vtkInformationVector* infoVec)
+{
+  vtkIdType size = 0;
+  if(!infoVec)
+    {
+    return size;
+    }
+  for(int i=0; i < infoVec->GetNumberOfInformationObjects(); ++i)
+    {
+    vtkInformation* info = infoVec->GetInformationObject(i);
+    if(vtkDataObject* data = info->Get(vtkDataObject::DATA_OBJECT()))
+      {
+      size += static_cast<vtkIdType>(data->GetActualMemorySize());
+      }
+    }
+  return size;
+}
+}
+
+//----------------------------------------------------------------------------
+class vtkPipelineProfilerInternals
+{
+public:
+  std::vector<vtkPipelineProfilerRecord> Records;
+  std::vector<vtkMultiThreaderIDType> Threads;
+  vtkSimpleCriticalSection Lock;
+  double Origin;
+
+  // Map the calling thread to a small integer.  Must be called with
+  // the lock held.
+  int GetThreadIndex()
+    {
+    vtkMultiThreaderIDType id = vtkMultiThreader::GetCurrentThreadID();
+    int n = static_cast<int>(this->Threads.size());
+    for(int i=0; i < n; ++i)
+      {
+      if(vtkMultiThreader::ThreadsEqual(this->Threads[i], id))
+        {
+        return i;
+        }
+      }
+    this->Threads.push_back(id);
+    return n;
+    }
+};
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler::vtkPipelineProfiler()
+{
+  this->Internals = new vtkPipelineProfilerInternals;
+  this->Internals->Origin = vtkTimerLog::GetUniversalTime();
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler::~vtkPipelineProfiler()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::GetPassType(vtkInformation* request)
+{
+  if(!request)
+    {
+    return UNKNOWN_PASS;
+    }
+  if(request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+    {
+    return REQUEST_DATA_PASS;
+    }
+  if(request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_UPDATE_EXTENT()))
+    {
+    return REQUEST_UPDATE_EXTENT_PASS;
+    }
+  if(request->Has(vtkDemandDrivenPipeline::REQUEST_INFORMATION()))
+    {
+    return REQUEST_INFORMATION_PASS;
+    }
+  return UNKNOWN_PASS;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPipelineProfiler::GetPassTypeAsString(int pass)
+{
+  switch(pass)
+    {
+    case REQUEST_INFORMATION_PASS:
+      return "RequestInformation";
+    case REQUEST_UPDATE_EXTENT_PASS:
+      return "RequestUpdateExtent";
+    case REQUEST_DATA_PASS:
+      return "RequestData";
+    default:
+      return "Unknown";
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPipelineProfiler::GetNumberOfRecords()
+{
+  this->Internals->Lock.Lock();
+  vtkIdType n = static_cast<vtkIdType>(this->Internals->Records.size());
+  this->Internals->Lock.Unlock();
+  return n;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::Reset()
+{
+  this->Internals->Lock.Lock();
+  this->Internals->Records.clear();
+  this->Internals->Threads.clear();
+  this->Internals->Origin = vtkTimerLog::GetUniversalTime();
+  this->Internals->Lock.Unlock();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::RecordPass(vtkAlgorithm* algorithm, int pass,
+                                     double startTime, double endTime,
+                                     vtkInformationVector** inInfoVec,
+                                     vtkInformationVector* outInfoVec)
+{
+  if(!algorithm || pass == UNKNOWN_PASS)
+    {
+    return;
+    }
+
+  vtkPipelineProfilerRecord record;
+  record.ClassName = algorithm->GetClassName();
+  record.Algorithm = algorithm;
+  record.Pass = pass;
+  record.Duration = endTime - startTime;
+  record.InputSize = 0;
+  record.OutputSize = 0;
+  record.CacheHit = false;
+
+  // Data sizes are only meaningful once the data have been generated.
+  if(pass == REQUEST_DATA_PASS)
+    {
+    if(inInfoVec)
+      {
+      for(int i=0; i < algorithm->GetNumberOfInputPorts(); ++i)
+        {
+        record.InputSize += vtkPipelineProfilerDataSize(inInfoVec[i]);
+        }
+      }
+    record.OutputSize = vtkPipelineProfilerDataSize(outInfoVec);
+    }
+
+  this->Internals->Lock.Lock();
+  record.Start = startTime - this->Internals->Origin;
+  record.Thread = this->Internals->GetThreadIndex();
+  this->Internals->Records.push_back(record);
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::RecordCacheHit(vtkAlgorithm* algorithm, int pass)
+{
+  if(!algorithm || pass == UNKNOWN_PASS)
+    {
+    return;
+    }
+
+  vtkPipelineProfilerRecord record;
+  record.ClassName = algorithm->GetClassName();
+  record.Algorithm = algorithm;
+  record.Pass = pass;
+  record.Duration = 0.0;
+  record.InputSize = 0;
+  record.OutputSize = 0;
+  record.CacheHit = true;
+
+  double now = vtkTimerLog::GetUniversalTime();
+  this->Internals->Lock.Lock();
+  record.Start = now - this->Internals->Origin;
+  record.Thread = this->Internals->GetThreadIndex();
+  this->Internals->Records.push_back(record);
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::WriteChromeTrace(ostream& os)
+{
+  this->Internals->Lock.Lock();
+  os << "{\"traceEvents\":[";
+  std::vector<vtkPipelineProfilerRecord>::const_iterator it;
+  for(it = this->Internals->Records.begin();
+      it != this->Internals->Records.end(); ++it)
+    {
+    const vtkPipelineProfilerRecord& r = *it;
+    if(it != this->Internals->Records.begin())
+      {
+      os << ",";
+      }
+    // Trace-event times are in microseconds.
+    os << "\n{\"name\":\"" << r.ClassName << "\""
+       << ",\"cat\":\"" << GetPassTypeAsString(r.Pass) << "\""
+       << ",\"pid\":0,\"tid\":" << r.Thread
+       << ",\"ts\":" << r.Start * 1.0e6;
+    if(r.CacheHit)
+      {
+      os << ",\"ph\":\"i\",\"s\":\"t\"";
+      }
+    else
+      {
+      os << ",\"ph\":\"X\",\"dur\":" << r.Duration * 1.0e6;
+      }
+    os << ",\"args\":{\"algorithm\":\"" << r.Algorithm << "\""
+       << ",\"cacheHit\":" << (r.CacheHit ? "true" : "false");
+    if(r.Pass == REQUEST_DATA_PASS && !r.CacheHit)
+      {
+      os << ",\"inputKiB\":" << r.InputSize
+         << ",\"outputKiB\":" << r.OutputSize;
+      }
+    os << "}}";
+    }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::WriteChromeTrace(const char* filename)
+{
+  if(!filename)
+    {
+    vtkErrorMacro("No file name specified.");
+    return 0;
+    }
+  ofstream os(filename, ios::out);
+  if(!os)
+    {
+    vtkErrorMacro("Unable to open file " << filename);
+    return 0;
+    }
+  this->WriteChromeTrace(os);
+  return os ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::ExportToTable(vtkTable* table)
+{
+  if(!table)
+    {
+    return;
+    }
+  table->Initialize();
+
+  vtkSmartPointer<vtkStringArray> algorithms =
+    vtkSmartPointer<vtkStringArray>::New();
+  algorithms->SetName("Algorithm");
+  vtkSmartPointer<vtkStringArray> classes =
+    vtkSmartPointer<vtkStringArray>::New();
+  classes->SetName("Class");
+  vtkSmartPointer<vtkStringArray> passes =
+    vtkSmartPointer<vtkStringArray>::New();
+  passes->SetName("Pass");
+  vtkSmartPointer<vtkDoubleArray> starts =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  starts->SetName("Start");
+  vtkSmartPointer<vtkDoubleArray> durations =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  durations->SetName("Duration");
+  vtkSmartPointer<vtkIntArray> threads =
+    vtkSmartPointer<vtkIntArray>::New();
+  threads->SetName("Thread");
+  vtkSmartPointer<vtkIdTypeArray> inputSizes =
+    vtkSmartPointer<vtkIdTypeArray>::New();
+  inputSizes->SetName("InputSize");
+  vtkSmartPointer<vtkIdTypeArray> outputSizes =
+    vtkSmartPointer<vtkIdTypeArray>::New();
+  outputSizes->SetName("OutputSize");
+  vtkSmartPointer<vtkIntArray> cacheHits =
+    vtkSmartPointer<vtkIntArray>::New();
+  cacheHits->SetName("CacheHit");
+
+  this->Internals->Lock.Lock();
+  vtkIdType n = static_cast<vtkIdType>(this->Internals->Records.size());
+  algorithms->SetNumberOfValues(n);
+  classes->SetNumberOfValues(n);
+  passes->SetNumberOfValues(n);
+  starts->SetNumberOfValues(n);
+  durations->SetNumberOfValues(n);
+  threads->SetNumberOfValues(n);
+  inputSizes->SetNumberOfValues(n);
+  outputSizes->SetNumberOfValues(n);
+  cacheHits->SetNumberOfValues(n);
+  for(vtkIdType i=0; i < n; ++i)
+    {
+    const vtkPipelineProfilerRecord& r = this->Internals->Records[i];
+    vtksys_ios::ostringstream name;
+    name << r.ClassName << "(" << r.Algorithm << ")";
+    algorithms->SetValue(i, name.str());
+    classes->SetValue(i, r.ClassName);
+    passes->SetValue(i, GetPassTypeAsString(r.Pass));
+    starts->SetValue(i, r.Start);
+    durations->SetValue(i, r.Duration);
+    threads->SetValue(i, r.Thread);
+    inputSizes->SetValue(i, r.InputSize);
+    outputSizes->SetValue(i, r.OutputSize);
+    cacheHits->SetValue(i, r.CacheHit ? 1 : 0);
+    }
+  this->Internals->Lock.Unlock();
+
+  table->AddColumn(algorithms);
+  table->AddColumn(classes);
+  table->AddColumn(passes);
+  table->AddColumn(starts);
+  table->AddColumn(durations);
+  table->AddColumn(threads);
+  table->AddColumn(inputSizes);
+  table->AddColumn(outputSizes);
+  table->AddColumn(cacheHits);
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "NumberOfRecords: " << this->GetNumberOfRecords() << endl;
+}
@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPipelineProfiler - Record the passes executed by all pipeline executives.
+// .SECTION Description
+// vtkPipelineProfiler collects one record for every
+// REQUEST_INFORMATION, REQUEST_UPDATE_EXTENT and REQUEST_DATA pass
+// that any vtkExecutive forwards to its algorithm while the profiler
+// is installed with vtkExecutive::SetPipelineProfiler().  Each record
+// holds the algorithm, the pass, the wall-clock start time and
+// duration, the thread that ran the pass and, for REQUEST_DATA, the
+// total size of the input and output data objects as reported by
+// vtkDataObject::GetActualMemorySize().  Passes that the executive
+// short-circuits because its outputs are up to date with respect to
+// the pipeline modified time are recorded as cache hits with a zero
+// duration.
+//
+// The time of a pass does not include the time spent updating the
+// upstream part of the pipeline, so the durations of all records add
+// up to the total time spent in algorithms.
+//
+// The records can be written in the Chrome trace-event JSON format,
+// which can be loaded in chrome://tracing or similar viewers, or
+// copied into a vtkTable for further processing.  Recording is
+// thread safe.
+//
+// .SECTION See Also
+// vtkExecutive vtkExecutionTimer vtkTimerLog
+
+#ifndef __vtkPipelineProfiler_h
+#define __vtkPipelineProfiler_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkAlgorithm;
+class vtkInformation;
+class vtkInformationVector;
+class vtkTable;
+class vtkPipelineProfilerInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineProfiler : public vtkObject
+{
+public:
+  static vtkPipelineProfiler *New();
+  vtkTypeMacro(vtkPipelineProfiler,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  //BTX
+  // Description:
+  // The pipeline passes that are recorded.
+  enum PassType
+    {
+    UNKNOWN_PASS = -1,
+    REQUEST_INFORMATION_PASS = 0,
+    REQUEST_UPDATE_EXTENT_PASS,
+    REQUEST_DATA_PASS,
+    NUMBER_OF_PASS_TYPES
+    };
+  //ETX
+
+  // Description:
+  // Return the pass type of the given request, or UNKNOWN_PASS if the
+  // request is not one of the recorded passes.
+  static int GetPassType(vtkInformation* request);
+
+  // Description:
+  // Return a printable name for a pass type.
+  static const char* GetPassTypeAsString(int pass);
+
+  // Description:
+  // Get the number of records collected since the last Reset().
+  vtkIdType GetNumberOfRecords();
+
+  // Description:
+  // Discard all records.  Times of subsequent records are relative
+  // to the time of this call.
+  void Reset();
+
+  // Description:
+  // Record a pass that was executed by an algorithm.  The times are
+  // absolute, as returned by vtkTimerLog::GetUniversalTime().  This is
+  // called by vtkExecutive.
+  void RecordPass(vtkAlgorithm* algorithm, int pass,
+                  double startTime, double endTime,
+                  vtkInformationVector** inInfoVec,
+                  vtkInformationVector* outInfoVec);
+
+  // Description:
+  // Record a pass that the executive skipped because the outputs of
+  // the algorithm were up to date.  This is called by vtkExecutive.
+  void RecordCacheHit(vtkAlgorithm* algorithm, int pass);
+
+  // Description:
+  // Write all records as a Chrome trace-event JSON document.  Executed
+  // passes are written as complete ("X") events and cache hits as
+  // instant ("i") events.  Returns 0 on failure.
+  void WriteChromeTrace(ostream& os);
+  int WriteChromeTrace(const char* filename);
+
+  // Description:
+  // Fill the given table with one row per record.  The columns are
+  // "Algorithm", "Class", "Pass", "Start", "Duration" (seconds),
+  // "Thread", "InputSize", "OutputSize" (kibibytes) and "CacheHit".
+  // Any previous content of the table is removed.
+  void ExportToTable(vtkTable* table);
+
+protected:
+  vtkPipelineProfiler();
+  ~vtkPipelineProfiler();
+
+  vtkPipelineProfilerInternals* Internals;
+
+private:
+  vtkPipelineProfiler(const vtkPipelineProfiler&);  // Not implemented.
+  void operator=(const vtkPipelineProfiler&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,227 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSharedCachedStreamingDemandDrivenPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSharedCachedStreamingDemandDrivenPipeline.h"
+
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineDataCache.h"
+
+#include <string>
+#include <vector>
+#include <vtksys/ios/sstream>
+
+vtkStandardNewMacro(vtkSharedCachedStreamingDemandDrivenPipeline);
+
+//----------------------------------------------------------------------------
+class vtkSharedCachedStreamingDemandDrivenPipelineInternals
+{
+public:
+  std::vector<vtkInformationKey*> RequestKeys;
+};
+
+//----------------------------------------------------------------------------
+namespace
+{
+// Build the string identifying the request made on an output port.
+std::string vtkSharedCachedSDDPSignature(
+  vtkInformation* outInfo, const std::vector<vtkInformationKey*>& keys)
+{
+  typedef vtkStreamingDemandDrivenPipeline vtkSDDP;
+  vtksys_ios::ostringstream os;
+  os.precision(17);
+  os << "piece=" << outInfo->Get(vtkSDDP::UPDATE_PIECE_NUMBER())
+     << "/" << outInfo->Get(vtkSDDP::UPDATE_NUMBER_OF_PIECES())
+     << " ghosts=" << outInfo->Get(vtkSDDP::UPDATE_NUMBER_OF_GHOST_LEVELS());
+
+  // The time step is only part of the request when the data depend on
+  // it, see vtkStreamingDemandDrivenPipeline::NeedToExecuteBasedOnTime.
+  if(outInfo->Has(vtkSDDP::TIME_RANGE()) &&
+     outInfo->Has(vtkSDDP::UPDATE_TIME_STEP()))
+    {
+    os << " time=" << outInfo->Get(vtkSDDP::UPDATE_TIME_STEP());
+    }
+
+  for(std::vector<vtkInformationKey*>::const_iterator it = keys.begin();
+      it != keys.end(); ++it)
+    {
+    if(outInfo->Has(*it))
+      {
+      os << " " << (*it)->GetLocation() << "::" << (*it)->GetName() << "=";
+      (*it)->Print(os, outInfo);
+      }
+    }
+  return os.str();
+}
+}
+
+//----------------------------------------------------------------------------
+vtkSharedCachedStreamingDemandDrivenPipeline
+::vtkSharedCachedStreamingDemandDrivenPipeline()
+{
+  this->Cache = 0;
+  this->Internals = new vtkSharedCachedStreamingDemandDrivenPipelineInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkSharedCachedStreamingDemandDrivenPipeline
+::~vtkSharedCachedStreamingDemandDrivenPipeline()
+{
+  this->SetCache(0);
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkSharedCachedStreamingDemandDrivenPipeline
+::SetCache(vtkPipelineDataCache* cache)
+{
+  if(this->Cache == cache)
+    {
+    return;
+    }
+  if(this->Cache)
+    {
+    this->Cache->RemoveEntries(this);
+    this->Cache->UnRegister(this);
+    }
+  this->Cache = cache;
+  if(this->Cache)
+    {
+    this->Cache->Register(this);
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineDataCache* vtkSharedCachedStreamingDemandDrivenPipeline::GetCache()
+{
+  if(!this->Cache)
+    {
+    this->SetCache(vtkPipelineDataCache::GetGlobalCache());
+    }
+  return this->Cache;
+}
+
+//----------------------------------------------------------------------------
+void vtkSharedCachedStreamingDemandDrivenPipeline
+::AddRequestKey(vtkInformationKey* key)
+{
+  if(key)
+    {
+    this->Internals->RequestKeys.push_back(key);
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkSharedCachedStreamingDemandDrivenPipeline::RemoveAllRequestKeys()
+{
+  if(!this->Internals->RequestKeys.empty())
+    {
+    this->Internals->RequestKeys.clear();
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkSharedCachedStreamingDemandDrivenPipeline
+::NeedToExecuteData(int outputPort,
+                    vtkInformationVector** inInfoVec,
+                    vtkInformationVector* outInfoVec)
+{
+  // If no port is specified, check all ports.  This behavior is
+  // implemented by the superclass.
+  if(outputPort < 0 || this->ContinueExecuting)
+    {
+    return this->Superclass::NeedToExecuteData(outputPort,
+                                               inInfoVec, outInfoVec);
+    }
+
+  // Entries generated before the last modification of the pipeline
+  // can never be used again.
+  vtkPipelineDataCache* cache = this->GetCache();
+  cache->RemoveStaleEntries(this, this->GetPipelineMTime());
+
+  // Nothing to do if the current output satisfies the request.
+  if(!this->Superclass::NeedToExecuteData(outputPort, inInfoVec, outInfoVec))
+    {
+    return 0;
+    }
+
+  // Look for a previous output that satisfies the request.
+  vtkInformation* outInfo = outInfoVec->GetInformationObject(outputPort);
+  vtkDataObject* dataObject = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  std::string signature =
+    vtkSharedCachedSDDPSignature(outInfo, this->Internals->RequestKeys);
+  int* updateExtent = outInfo->Get(UPDATE_EXTENT());
+  if(cache->Retrieve(this, outputPort, signature.c_str(),
+                     dataObject->GetExtentType(), updateExtent, dataObject))
+    {
+    // Keep track of the time request as if the algorithm had executed,
+    // see vtkStreamingDemandDrivenPipeline::MarkOutputsGenerated.
+    if(outInfo->Has(UPDATE_TIME_STEP()))
+      {
+      outInfo->Set(PREVIOUS_UPDATE_TIME_STEP(), outInfo->Get(UPDATE_TIME_STEP()));
+      }
+    else
+      {
+      outInfo->Remove(PREVIOUS_UPDATE_TIME_STEP());
+      }
+    return 0;
+    }
+
+  // We do need to execute
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkSharedCachedStreamingDemandDrivenPipeline
+::ExecuteData(vtkInformation* request,
+              vtkInformationVector** inInfoVec,
+              vtkInformationVector* outInfoVec)
+{
+  int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+
+  // Store the new outputs once the algorithm has finished executing.
+  if(result && !this->ContinueExecuting)
+    {
+    vtkPipelineDataCache* cache = this->GetCache();
+    for(int i=0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+      {
+      vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+      vtkDataObject* dataObject = outInfo->Get(vtkDataObject::DATA_OBJECT());
+      if(dataObject)
+        {
+        std::string signature =
+          vtkSharedCachedSDDPSignature(outInfo, this->Internals->RequestKeys);
+        cache->Insert(this, i, signature.c_str(), dataObject);
+        }
+      }
+    }
+
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkSharedCachedStreamingDemandDrivenPipeline
+::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Cache: " << this->Cache << "\n";
+  os << indent << "NumberOfRequestKeys: "
+     << this->Internals->RequestKeys.size() << "\n";
+}
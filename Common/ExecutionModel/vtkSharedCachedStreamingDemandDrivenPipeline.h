@@ -0,0 +1,92 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSharedCachedStreamingDemandDrivenPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSharedCachedStreamingDemandDrivenPipeline - Executive that keeps previous outputs in a shared cache.
+// .SECTION Description
+// vtkSharedCachedStreamingDemandDrivenPipeline is a streaming demand
+// driven executive that stores every output its algorithm generates in
+// a vtkPipelineDataCache.  When a later request can be satisfied by a
+// cached output, the output is restored from the cache instead of
+// executing the algorithm and the upstream pipeline.
+//
+// Cache entries are keyed by the full request: the update extent, the
+// piece, number of pieces and ghost levels, the update time step and
+// the value of any additional request keys given with AddRequestKey().
+// Entries are discarded as soon as the pipeline modified time of the
+// executive changes, so settings stored on the algorithm itself (for
+// instance the array selection of a reader) are honored by
+// invalidation.
+//
+// Unlike vtkCachedStreamingDemandDrivenPipeline, which keeps a fixed
+// number of images per executive, the cache is bounded in bytes and
+// uses a least recently used policy.  By default all executives of this
+// type share vtkPipelineDataCache::GetGlobalCache(), so the memory
+// budget applies to the whole pipeline.
+//
+// .SECTION See Also
+// vtkPipelineDataCache vtkCachedStreamingDemandDrivenPipeline
+
+#ifndef __vtkSharedCachedStreamingDemandDrivenPipeline_h
+#define __vtkSharedCachedStreamingDemandDrivenPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+class vtkInformationKey;
+class vtkPipelineDataCache;
+class vtkSharedCachedStreamingDemandDrivenPipelineInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkSharedCachedStreamingDemandDrivenPipeline :
+  public vtkStreamingDemandDrivenPipeline
+{
+public:
+  static vtkSharedCachedStreamingDemandDrivenPipeline* New();
+  vtkTypeMacro(vtkSharedCachedStreamingDemandDrivenPipeline,
+               vtkStreamingDemandDrivenPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set/Get the cache used to store outputs.  When no cache is set,
+  // vtkPipelineDataCache::GetGlobalCache() is used.
+  void SetCache(vtkPipelineDataCache* cache);
+  vtkPipelineDataCache* GetCache();
+
+  // Description:
+  // Add a key of the output information whose value is part of the
+  // request, in addition to the extent, piece and time keys.  Outputs
+  // are only reused for requests with the same value of these keys.
+  void AddRequestKey(vtkInformationKey* key);
+  void RemoveAllRequestKeys();
+
+protected:
+  vtkSharedCachedStreamingDemandDrivenPipeline();
+  ~vtkSharedCachedStreamingDemandDrivenPipeline();
+
+  virtual int NeedToExecuteData(int outputPort,
+                                vtkInformationVector** inInfoVec,
+                                vtkInformationVector* outInfoVec);
+  virtual int ExecuteData(vtkInformation* request,
+                          vtkInformationVector** inInfoVec,
+                          vtkInformationVector* outInfoVec);
+
+  vtkPipelineDataCache* Cache;
+
+private:
+  vtkSharedCachedStreamingDemandDrivenPipelineInternals* Internals;
+
+  vtkSharedCachedStreamingDemandDrivenPipeline(const vtkSharedCachedStreamingDemandDrivenPipeline&);  // Not implemented.
+  void operator=(const vtkSharedCachedStreamingDemandDrivenPipeline&);  // Not implemented.
+};
+
+#endif
@@ -36,6 +36,7 @@
 #include "vtkInformationUnsignedLongKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
 
 vtkStandardNewMacro(vtkStreamingDemandDrivenPipeline);
@@ -295,6 +296,7 @@ int vtkStreamingDemandDrivenPipeline
       }
     if (!N2E)
       {
+      this->RecordCacheHit(vtkPipelineProfiler::REQUEST_UPDATE_EXTENT_PASS);
       if(outInfo && outInfo->Has(COMBINED_UPDATE_EXTENT()))
         {
         static int emptyExt[6] = { 0, -1, 0, -1, 0, -1 };
@@ -362,6 +364,11 @@ int vtkStreamingDemandDrivenPipeline::Update(int port)
         {
         retval = retval && this->UpdateData(port);
         }
+      else if (retval)
+        {
+        // The data pass is skipped because the outputs are up to date.
+        this->RecordCacheHit(vtkPipelineProfiler::REQUEST_DATA_PASS);
+        }
       }
     while (this->ContinueExecuting);
     return retval;
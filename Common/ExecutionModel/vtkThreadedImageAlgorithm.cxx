@@ -23,14 +23,25 @@
 #include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+// the default for EnableSMP
+static bool vtkThreadedImageAlgorithmGlobalDefaultEnableSMP = false;
 
 //----------------------------------------------------------------------------
 vtkThreadedImageAlgorithm::vtkThreadedImageAlgorithm()
 {
   this->Threader = vtkMultiThreader::New();
   this->NumberOfThreads = this->Threader->GetNumberOfThreads();
+
+  this->EnableSMP = vtkThreadedImageAlgorithmGlobalDefaultEnableSMP;
+  this->MinimumPieceSize[0] = 16;
+  this->MinimumPieceSize[1] = 1;
+  this->MinimumPieceSize[2] = 1;
+  this->DesiredBytesPerPiece = 65536;
+  this->SplitMode = SLAB;
+  this->SMPSupported = true;
 }
 
 //----------------------------------------------------------------------------
@@ -45,6 +56,26 @@ void vtkThreadedImageAlgorithm::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On\n" : "Off\n");
+  os << indent << "MinimumPieceSize: " << this->MinimumPieceSize[0] << " "
+     << this->MinimumPieceSize[1] << " " << this->MinimumPieceSize[2] << "\n";
+  os << indent << "DesiredBytesPerPiece: "
+     << this->DesiredBytesPerPiece << "\n";
+  os << indent << "SplitMode: "
+     << (this->SplitMode == SLAB ? "Slab\n" :
+         (this->SplitMode == BEAM ? "Beam\n" : "Block\n"));
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadedImageAlgorithm::SetGlobalDefaultEnableSMP(bool enable)
+{
+  vtkThreadedImageAlgorithmGlobalDefaultEnableSMP = enable;
+}
+
+//----------------------------------------------------------------------------
+bool vtkThreadedImageAlgorithm::GetGlobalDefaultEnableSMP()
+{
+  return vtkThreadedImageAlgorithmGlobalDefaultEnableSMP;
 }
 
 struct vtkImageThreadStruct
@@ -79,6 +110,66 @@ int vtkThreadedImageAlgorithm::SplitExtent(int splitExt[6],
   // start with same extent
   memcpy(splitExt, startExt, 6 * sizeof(int));
 
+  if (this->SplitMode != SLAB)
+    {
+    // split along the two or three slowest axes, always dividing the
+    // axis with the largest pieces that can still be divided
+    int numAxes = (this->SplitMode == BEAM ? 2 : 3);
+    int size[3];
+    int divs[3] = { 1, 1, 1 };
+    for (int i = 0; i < 3; i++)
+      {
+      size[i] = startExt[2*i+1] - startExt[2*i] + 1;
+      if (size[i] <= 0)
+        {
+        return 1;
+        }
+      }
+    int product = 1;
+    for (;;)
+      {
+      int bestAxis = -1;
+      for (int j = 0; j < numAxes; j++)
+        {
+        int axis = 2 - j;
+        int minSize = this->MinimumPieceSize[axis];
+        minSize = (minSize > 1 ? minSize : 1);
+        if ((product/divs[axis])*(divs[axis] + 1) <= total &&
+            size[axis]/(divs[axis] + 1) >= minSize &&
+            (bestAxis < 0 ||
+             size[axis]/divs[axis] > size[bestAxis]/divs[bestAxis]))
+          {
+          bestAxis = axis;
+          }
+        }
+      if (bestAxis < 0)
+        {
+        break;
+        }
+      product = (product/divs[bestAxis])*(divs[bestAxis] + 1);
+      divs[bestAxis]++;
+      }
+
+    int idx[3];
+    idx[0] = num % divs[0];
+    idx[1] = (num / divs[0]) % divs[1];
+    idx[2] = num / (divs[0]*divs[1]);
+    if (idx[2] < divs[2])
+      {
+      for (int i = 0; i < 3; i++)
+        {
+        splitExt[2*i] = startExt[2*i] + (size[i]*idx[i])/divs[i];
+        splitExt[2*i+1] = startExt[2*i] + (size[i]*(idx[i] + 1))/divs[i] - 1;
+        }
+      }
+
+    vtkDebugMacro("  Split Piece: ( " <<splitExt[0]<< ", " <<splitExt[1]<< ", "
+                  << splitExt[2] << ", " << splitExt[3] << ", "
+                  << splitExt[4] << ", " << splitExt[5] << ")");
+
+    return product;
+    }
+
   splitAxis = 2;
   min = startExt[4];
   max = startExt[5];
@@ -121,22 +212,12 @@ int vtkThreadedImageAlgorithm::SplitExtent(int splitExt[6],
 }
 
 
-// this mess is really a simple function. All it does is call
-// the ThreadedExecute method after setting the correct
-// extent for this thread. Its just a pain to calculate
-// the correct extent.
-static VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
+//----------------------------------------------------------------------------
+// Get the extent that has to be generated: the update extent of the output
+// port that made the request, or of the first input if there is no output.
+static bool vtkThreadedImageAlgorithmGetExtent(vtkImageThreadStruct *str,
+                                               int ext[6])
 {
-  vtkImageThreadStruct *str;
-  int ext[6], splitExt[6], total;
-  int threadId, threadCount;
-
-  threadId = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->ThreadID;
-  threadCount = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->NumberOfThreads;
-
-  str = static_cast<vtkImageThreadStruct *>
-    (static_cast<vtkMultiThreader::ThreadInfo *>(arg)->UserData);
-
   // if we have an output
   if (str->Filter->GetNumberOfOutputPorts())
     {
@@ -148,7 +229,7 @@ static VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *ar
     // update directly, for now an error
     if (outputPort == -1)
       {
-      return VTK_THREAD_RETURN_VALUE;
+      return false;
       }
 
     // get the update extent from the output port
@@ -178,10 +259,34 @@ static VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *ar
       }
     if (inPort >= str->Filter->GetNumberOfInputPorts())
       {
-      return VTK_THREAD_RETURN_VALUE;
+      return false;
       }
     }
 
+  return true;
+}
+
+// this mess is really a simple function. All it does is call
+// the ThreadedExecute method after setting the correct
+// extent for this thread. Its just a pain to calculate
+// the correct extent.
+static VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
+{
+  vtkImageThreadStruct *str;
+  int ext[6], splitExt[6], total;
+  int threadId, threadCount;
+
+  threadId = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->ThreadID;
+  threadCount = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->NumberOfThreads;
+
+  str = static_cast<vtkImageThreadStruct *>
+    (static_cast<vtkMultiThreader::ThreadInfo *>(arg)->UserData);
+
+  if (!vtkThreadedImageAlgorithmGetExtent(str, ext))
+    {
+    return VTK_THREAD_RETURN_VALUE;
+    }
+
   // execute the actual method with appropriate extent
   // first find out how many pieces extent can be split into.
   total = str->Filter->SplitExtent(splitExt, ext, threadId, threadCount);
@@ -211,6 +316,112 @@ static VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *ar
 }
 
 
+//----------------------------------------------------------------------------
+// The functor that executes the pieces with vtkSMPTools.
+class vtkThreadedImageAlgorithmFunctor
+{
+public:
+  vtkThreadedImageAlgorithmFunctor(vtkImageThreadStruct *str,
+                                   int extent[6], vtkIdType pieces)
+    : Str(str), NumberOfPieces(pieces)
+  {
+    for (int i = 0; i < 6; i++)
+      {
+      this->Extent[i] = extent[i];
+      }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    int extent[6];
+    for (int i = 0; i < 6; i++)
+      {
+      extent[i] = this->Extent[i];
+      }
+    this->Str->Filter->SMPRequestData(
+      this->Str->Request, this->Str->InputsInfo, this->Str->OutputsInfo,
+      this->Str->Inputs, this->Str->Outputs,
+      begin, end, this->NumberOfPieces, extent);
+  }
+
+private:
+  vtkImageThreadStruct *Str;
+  int Extent[6];
+  vtkIdType NumberOfPieces;
+};
+
+//----------------------------------------------------------------------------
+vtkIdType vtkThreadedImageAlgorithm::ComputeNumberOfPieces(
+  int extent[6], int bytesPerPoint)
+{
+  vtkIdType size[3];
+  for (int i = 0; i < 3; i++)
+    {
+    size[i] = extent[2*i+1] - extent[2*i] + 1;
+    }
+
+  // the number of pieces needed to reach the desired piece size
+  vtkIdType bytes = size[0]*size[1]*size[2]*bytesPerPoint;
+  vtkIdType bytesPerPiece = this->DesiredBytesPerPiece;
+  bytesPerPiece = (bytesPerPiece > 0 ? bytesPerPiece : 1);
+  vtkIdType pieces = (bytes + bytesPerPiece - 1)/bytesPerPiece;
+
+  // the pieces cannot be smaller than the minimum piece size
+  vtkIdType maxPieces = 1;
+  for (int axis = 2; axis >= 0; axis--)
+    {
+    vtkIdType minSize = this->MinimumPieceSize[axis];
+    minSize = (minSize > 1 ? minSize : 1);
+    vtkIdType divs = size[axis]/minSize;
+    divs = (divs > 1 ? divs : 1);
+    if (this->SplitMode == SLAB)
+      {
+      // only the slowest axis with more than one slice is split
+      if (size[axis] > 1)
+        {
+        maxPieces = divs;
+        break;
+        }
+      }
+    else if (axis > 0 || this->SplitMode == BLOCK)
+      {
+      maxPieces *= divs;
+      }
+    }
+
+  pieces = (pieces < maxPieces ? pieces : maxPieces);
+  return (pieces > 1 ? pieces : 1);
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadedImageAlgorithm::SMPRequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector,
+  vtkImageData ***inData,
+  vtkImageData **outData,
+  vtkIdType begin, vtkIdType end,
+  vtkIdType pieces, int extent[6])
+{
+  for (vtkIdType piece = begin; piece < end; piece++)
+    {
+    int splitExt[6];
+    int total = this->SplitExtent(splitExt, extent, static_cast<int>(piece),
+                                  static_cast<int>(pieces));
+
+    // skip pieces that are not generated or are empty
+    if (piece < total &&
+        splitExt[0] <= splitExt[1] &&
+        splitExt[2] <= splitExt[3] &&
+        splitExt[4] <= splitExt[5])
+      {
+      this->ThreadedRequestData(request, inputVector, outputVector,
+                                inData, outData, splitExt,
+                                static_cast<int>(piece));
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 // This is the superclasses style of Execute method.  Convert it into
 // an imaging style Execute method.
@@ -283,13 +494,38 @@ int vtkThreadedImageAlgorithm::RequestData(
     this->CopyAttributeData(str.Inputs[0][0],str.Outputs[0],inputVector);
     }
 
-  this->Threader->SetNumberOfThreads(this->NumberOfThreads);
-  this->Threader->SetSingleMethod(vtkThreadedImageAlgorithmThreadedExecute, &str);
-
   // always shut off debugging to avoid threading problems with GetMacros
   int debug = this->Debug;
   this->Debug = 0;
-  this->Threader->SingleMethodExecute();
+
+  if (this->EnableSMP && this->SMPSupported)
+    {
+    int ext[6];
+    if (vtkThreadedImageAlgorithmGetExtent(&str, ext) &&
+        ext[0] <= ext[1] && ext[2] <= ext[3] && ext[4] <= ext[5])
+      {
+      // the size of the pieces is based on the first output
+      int bytesPerPoint = 1;
+      if (str.Outputs && str.Outputs[0] &&
+          str.Outputs[0]->GetPointData()->GetScalars())
+        {
+        bytesPerPoint = str.Outputs[0]->GetScalarSize()*
+          str.Outputs[0]->GetNumberOfScalarComponents();
+        }
+
+      vtkIdType pieces = this->ComputeNumberOfPieces(ext, bytesPerPoint);
+      vtkThreadedImageAlgorithmFunctor functor(&str, ext, pieces);
+      vtkSMPTools::For(0, pieces, 1, functor);
+      }
+    }
+  else
+    {
+    this->Threader->SetNumberOfThreads(this->NumberOfThreads);
+    this->Threader->SetSingleMethod(
+      vtkThreadedImageAlgorithmThreadedExecute, &str);
+    this->Threader->SingleMethodExecute();
+    }
+
   this->Debug = debug;
 
   // free up the arrays
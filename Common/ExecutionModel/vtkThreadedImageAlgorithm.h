@@ -19,6 +19,15 @@
 // into smaller extents so that the vtkImageData limits are observed. It
 // also provides support for multithreading. If you don't need any of this
 // functionality, consider using vtkSimpleImageToImageAlgorithm instead.
+//
+// By default the output extent is split into NumberOfThreads pieces that
+// are executed by a vtkMultiThreader.  When EnableSMP is on, the extent is
+// instead split into many small pieces of about DesiredBytesPerPiece bytes
+// that are executed by vtkSMPTools, so that the pieces are balanced over
+// the pooled worker threads of the SMP backend.  In this mode the threadId
+// given to ThreadedRequestData() is the piece number, which can be much
+// larger than NumberOfThreads, so subclasses that keep per-thread storage
+// indexed by threadId must turn SMPSupported off in their constructor.
 // .SECTION See also
 // vtkSimpleImageToImageAlgorithm
 
@@ -59,11 +68,70 @@ public:
   vtkSetClampMacro( NumberOfThreads, int, 1, VTK_MAX_THREADS );
   vtkGetMacro( NumberOfThreads, int );
 
+  // Description:
+  // Enable/Disable the use of vtkSMPTools instead of vtkMultiThreader.
+  // The default is given by GetGlobalDefaultEnableSMP().
+  vtkSetMacro(EnableSMP, bool);
+  vtkGetMacro(EnableSMP, bool);
+  vtkBooleanMacro(EnableSMP, bool);
+
+  // Description:
+  // Set/Get the default value of EnableSMP for new imaging filters.
+  // The default is off.
+  static void SetGlobalDefaultEnableSMP(bool enable);
+  static bool GetGlobalDefaultEnableSMP();
+
+  // Description:
+  // The minimum size of the pieces, along each axis, when the extent is
+  // split for SMP execution.  The default is (16,1,1).
+  vtkSetVector3Macro(MinimumPieceSize, int);
+  vtkGetVector3Macro(MinimumPieceSize, int);
+
+  // Description:
+  // The desired size of the pieces, in bytes of output data, when the
+  // extent is split for SMP execution.  Smaller pieces give a better load
+  // balance but a higher overhead.  The default is 65536 bytes.
+  vtkSetMacro(DesiredBytesPerPiece, vtkIdType);
+  vtkGetMacro(DesiredBytesPerPiece, vtkIdType);
+
+//BTX
+  enum SplitModes
+  {
+    SLAB = 0,
+    BEAM = 1,
+    BLOCK = 2
+  };
+//ETX
+
+  // Description:
+  // Set the method used to split the extent into pieces.  Slab mode (the
+  // default) splits along the slowest axis that has more than one slice,
+  // beam mode splits along the Z and Y axes, and block mode splits along
+  // all three axes.
+  vtkSetClampMacro(SplitMode, int, SLAB, BLOCK);
+  void SetSplitModeToSlab() { this->SetSplitMode(SLAB); }
+  void SetSplitModeToBeam() { this->SetSplitMode(BEAM); }
+  void SetSplitModeToBlock() { this->SetSplitMode(BLOCK); }
+  vtkGetMacro(SplitMode, int);
+
   // Description:
   // Putting this here until I merge graphics and imaging streaming.
   virtual int SplitExtent(int splitExt[6], int startExt[6],
                           int num, int total);
 
+  // Description:
+  // Execute ThreadedRequestData() for the pieces numbered from begin up
+  // to, but not including, end, after splitting the extent into the
+  // given number of pieces.  It is public so that the vtkSMPTools
+  // functor can call this method.
+  virtual void SMPRequestData(vtkInformation *request,
+                              vtkInformationVector **inputVector,
+                              vtkInformationVector *outputVector,
+                              vtkImageData ***inData,
+                              vtkImageData **outData,
+                              vtkIdType begin, vtkIdType end,
+                              vtkIdType pieces, int extent[6]);
+
 protected:
   vtkThreadedImageAlgorithm();
   ~vtkThreadedImageAlgorithm();
@@ -71,6 +139,22 @@ protected:
   vtkMultiThreader *Threader;
   int NumberOfThreads;
 
+  bool EnableSMP;
+  int MinimumPieceSize[3];
+  vtkIdType DesiredBytesPerPiece;
+  int SplitMode;
+
+  // Description:
+  // Whether this filter can be executed with vtkSMPTools.  Subclasses that
+  // keep per-thread storage indexed by threadId set this to false, so that
+  // they always execute with vtkMultiThreader, whatever EnableSMP is.
+  // The default is true.
+  bool SMPSupported;
+
+  // Description:
+  // Compute the number of pieces to use for SMP execution of the extent.
+  vtkIdType ComputeNumberOfPieces(int extent[6], int bytesPerPoint);
+
   // Description:
   // This is called by the superclass.
   // This is the method you should override.
@@ -0,0 +1,143 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTemporalCachePrefetch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataArray.h"
+#include "vtkImageAlgorithm.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTemporalDataSetCache.h"
+
+#define CHECK(b, errors) if(!(b)){ errors++; cerr<<"Error on Line "<<__LINE__<<":"<<endl;}
+
+//
+// This test checks that the time steps following the requested one are
+// read ahead and served from the cache without executing the source.
+//
+
+// An image source with ten time steps that counts its executions.
+class vtkPrefetchTimeSource : public vtkImageAlgorithm
+{
+public:
+  static vtkPrefetchTimeSource *New();
+  vtkTypeMacro(vtkPrefetchTimeSource,vtkImageAlgorithm);
+  vtkGetMacro(NumberOfExecutions, int);
+
+protected:
+  vtkPrefetchTimeSource()
+  {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfExecutions = 0;
+  }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+  {
+    vtkInformation *outInfo = outputVector->GetInformationObject(0);
+    int extent[6] = {0, 9, 0, 9, 0, 9};
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent, 6);
+    double steps[10];
+    for (int i = 0; i < 10; ++i)
+      {
+      steps[i] = i;
+      }
+    double range[2] = {0, 9};
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps, 10);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_FLOAT, 1);
+    return 1;
+  }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+  {
+    vtkInformation *outInfo = outputVector->GetInformationObject(0);
+    vtkImageData *output = vtkImageData::GetData(outInfo);
+    double time =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    output->SetExtent(
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()));
+    output->AllocateScalars(VTK_FLOAT, 1);
+    output->GetPointData()->GetScalars()->FillComponent(0, time);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    this->NumberOfExecutions++;
+    return 1;
+  }
+
+  int NumberOfExecutions;
+};
+vtkStandardNewMacro(vtkPrefetchTimeSource);
+
+static double GetValueAtTime(vtkTemporalDataSetCache* cache, double time)
+{
+  cache->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline::SafeDownCast(cache->GetExecutive())
+    ->SetUpdateTimeStep(0, time);
+  cache->Update();
+  vtkImageData* output = vtkImageData::SafeDownCast(cache->GetOutputDataObject(0));
+  return output->GetScalarComponentAsDouble(0, 0, 0, 0);
+}
+
+int TestTemporalCachePrefetch(int, char*[])
+{
+  int errors = 0;
+
+  vtkNew<vtkPrefetchTimeSource> source;
+  vtkNew<vtkTemporalDataSetCache> cache;
+  cache->SetInputConnection(source->GetOutputPort());
+  cache->SetCacheSize(5);
+  cache->SetPrefetchSize(3);
+  cache->SetPrefetchDirectionToForward();
+
+  // The first request reads the three following time steps ahead.
+  CHECK(GetValueAtTime(cache.GetPointer(), 0) == 0, errors);
+  cache->WaitForPrefetch();
+  CHECK(source->GetNumberOfExecutions() == 4, errors);
+  CHECK(cache->GetNumberOfPrefetchedTimeSteps() == 3, errors);
+
+  // Playing forward only reads the time step entering the window.
+  for (int i = 1; i <= 3; ++i)
+    {
+    CHECK(GetValueAtTime(cache.GetPointer(), i) == i, errors);
+    cache->WaitForPrefetch();
+    CHECK(source->GetNumberOfExecutions() == 4 + i, errors);
+    }
+
+  // Seeking discards the window of the previous position.
+  CHECK(GetValueAtTime(cache.GetPointer(), 8) == 8, errors);
+  cache->WaitForPrefetch();
+  CHECK(source->GetNumberOfExecutions() == 9, errors);
+  CHECK(GetValueAtTime(cache.GetPointer(), 9) == 9, errors);
+  CHECK(source->GetNumberOfExecutions() == 9, errors);
+
+  // Playing backward with a memory budget and the farthest eviction.
+  cache->CancelPrefetch();
+  unsigned long stepSize = cache->GetCacheMemorySize() / 5;
+  cache->SetCacheMemoryLimit(3 * stepSize);
+  cache->SetEvictionPolicyToFarthestFromRequest();
+  cache->SetPrefetchDirectionToBackward();
+  for (int i = 7; i >= 4; --i)
+    {
+    CHECK(GetValueAtTime(cache.GetPointer(), i) == i, errors);
+    cache->WaitForPrefetch();
+    CHECK(cache->GetCacheMemorySize() <= 3 * stepSize, errors);
+    }
+  CHECK(GetValueAtTime(cache.GetPointer(), 3) == 3, errors);
+
+  return errors;
+}
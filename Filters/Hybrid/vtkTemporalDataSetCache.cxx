@@ -14,8 +14,11 @@
 =========================================================================*/
 #include "vtkTemporalDataSetCache.h"
 
+#include "vtkConditionVariable.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkCompositeDataPipeline.h"
@@ -23,17 +26,267 @@
 #include "vtkCompositeDataIterator.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
+#include <deque>
+#include <set>
 #include <vector>
 
 //---------------------------------------------------------------------------
 vtkStandardNewMacro(vtkTemporalDataSetCache);
 
+//----------------------------------------------------------------------------
+// The executive of the filter resumes prefetching once it is done with the
+// data pass, that is after the input information and the input data were
+// last used, possibly to release the input data.
+class vtkTemporalDataSetCacheExecutive : public vtkCompositeDataPipeline
+{
+public:
+  static vtkTemporalDataSetCacheExecutive* New();
+  vtkTypeMacro(vtkTemporalDataSetCacheExecutive,vtkCompositeDataPipeline);
+
+protected:
+  vtkTemporalDataSetCacheExecutive() {}
+  ~vtkTemporalDataSetCacheExecutive() {}
+
+  virtual int ExecuteData(vtkInformation* request,
+                          vtkInformationVector** inInfoVec,
+                          vtkInformationVector* outInfoVec)
+    {
+    int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+    vtkTemporalDataSetCache* cache =
+      vtkTemporalDataSetCache::SafeDownCast(this->Algorithm);
+    if (cache)
+      {
+      cache->ResumePrefetch();
+      }
+    return result;
+    }
+
+private:
+  vtkTemporalDataSetCacheExecutive(const vtkTemporalDataSetCacheExecutive&);  // Not implemented.
+  void operator=(const vtkTemporalDataSetCacheExecutive&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkTemporalDataSetCacheExecutive);
+
+//----------------------------------------------------------------------------
+class vtkTemporalDataSetCacheInternals
+{
+public:
+  vtkTemporalDataSetCacheInternals()
+    {
+    this->Threader = vtkMultiThreader::New();
+    this->ThreadId = -1;
+    this->Lock = vtkMutexLock::New();
+    this->Condition = vtkConditionVariable::New();
+    this->Paused = true;
+    this->Busy = false;
+    this->StopThread = false;
+    this->ProducerPort = 0;
+    this->MemorySize = 0;
+    this->CurrentTime = 0.0;
+    this->HasCurrentTime = false;
+    this->Direction = 1;
+    }
+  ~vtkTemporalDataSetCacheInternals()
+    {
+    this->Condition->Delete();
+    this->Lock->Delete();
+    this->Threader->Delete();
+    }
+
+  static VTK_THREAD_RETURN_TYPE PrefetchThreadStart(void* arg);
+  void PrefetchThread(vtkTemporalDataSetCache* self);
+  vtkDataObject* FetchTimeStep(double time, unsigned long& stamp);
+  vtkTemporalDataSetCache::CacheType::iterator FindEvictionCandidate(
+    vtkTemporalDataSetCache* self, double time, bool prefetched);
+
+  // The background thread and its synchronization.  The lock protects
+  // the members below as well as the cache itself.
+  vtkMultiThreader* Threader;
+  int ThreadId;
+  vtkMutexLock* Lock;
+  vtkConditionVariable* Condition;
+  bool Paused;
+  bool Busy;
+  bool StopThread;
+
+  // The time steps waiting to be prefetched, the time steps that the
+  // current prefetch aims at keeping in the cache, and where to read
+  // them from.
+  std::deque<double> Queue;
+  std::set<double> Window;
+  vtkSmartPointer<vtkAlgorithm> Producer;
+  int ProducerPort;
+
+  // Memory used by each cached time step, in kibibytes.
+  std::map<double, unsigned long> Sizes;
+  unsigned long MemorySize;
+
+  // The last requested time step and the direction of playback.
+  double CurrentTime;
+  bool HasCurrentTime;
+  int Direction;
+};
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE
+vtkTemporalDataSetCacheInternals::PrefetchThreadStart(void* arg)
+{
+  vtkTemporalDataSetCache* self = static_cast<vtkTemporalDataSetCache*>(
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg)->UserData);
+  self->Internals->PrefetchThread(self);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCacheInternals::PrefetchThread(
+  vtkTemporalDataSetCache* self)
+{
+  this->Lock->Lock();
+  while (!this->StopThread)
+    {
+    if (this->Paused || this->Queue.empty())
+      {
+      // Let WaitForPrefetch() know that there is nothing left to do.
+      this->Condition->Broadcast();
+      this->Condition->Wait(this->Lock);
+      continue;
+      }
+
+    double time = this->Queue.front();
+    this->Queue.pop_front();
+    if (self->Cache.find(time) != self->Cache.end())
+      {
+      continue;
+      }
+
+    // The pipeline is updated without holding the lock so that the
+    // requests of the main thread can cancel the pending time steps.
+    this->Busy = true;
+    this->Lock->Unlock();
+    unsigned long stamp = 0;
+    vtkDataObject* data = this->FetchTimeStep(time, stamp);
+    this->Lock->Lock();
+    this->Busy = false;
+
+    if (data)
+      {
+      double dataTime =
+        data->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP());
+      if (self->InsertTimeStep(dataTime, data, stamp, true))
+        {
+        self->NumberOfPrefetchedTimeSteps++;
+        }
+      else
+        {
+        // The cache is full of time steps that are more useful.
+        this->Queue.clear();
+        }
+      data->Delete();
+      }
+    else
+      {
+      this->Queue.clear();
+      }
+    this->Condition->Broadcast();
+    }
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkTemporalDataSetCacheInternals::FetchTimeStep(
+  double time, unsigned long& stamp)
+{
+  vtkStreamingDemandDrivenPipeline* sddp =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(
+      this->Producer->GetExecutive());
+  if (!sddp)
+    {
+    return 0;
+    }
+
+  sddp->SetUpdateTimeStep(this->ProducerPort, time);
+  if (!sddp->Update(this->ProducerPort))
+    {
+    return 0;
+    }
+
+  vtkDataObject* output = sddp->GetOutputData(this->ProducerPort);
+  if (!output ||
+      !output->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()))
+    {
+    return 0;
+    }
+
+  vtkDataObject* data = output->NewInstance();
+  data->ShallowCopy(output);
+  data->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(),
+    output->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()));
+  stamp = output->GetUpdateTime();
+  return data;
+}
+
+//----------------------------------------------------------------------------
+vtkTemporalDataSetCache::CacheType::iterator
+vtkTemporalDataSetCacheInternals::FindEvictionCandidate(
+  vtkTemporalDataSetCache* self, double time, bool prefetched)
+{
+  vtkTemporalDataSetCache::CacheType::iterator candidate = self->Cache.end();
+  double candidateDistance = 0.0;
+  vtkTemporalDataSetCache::CacheType::iterator pos = self->Cache.begin();
+  for (; pos != self->Cache.end(); ++pos)
+    {
+    // Never evict the requested time step for a prefetched one, nor a
+    // time step that the prefetch is meant to keep.
+    if (prefetched &&
+        ((this->HasCurrentTime && pos->first == this->CurrentTime) ||
+         this->Window.find(pos->first) != this->Window.end()))
+      {
+      continue;
+      }
+    double distance = pos->first - this->CurrentTime;
+    distance = distance < 0.0 ? -distance : distance;
+    if (candidate == self->Cache.end() ||
+        (self->EvictionPolicy ==
+           vtkTemporalDataSetCache::EVICT_LEAST_RECENTLY_USED &&
+         pos->second.first < candidate->second.first) ||
+        (self->EvictionPolicy ==
+           vtkTemporalDataSetCache::EVICT_FARTHEST_FROM_REQUEST &&
+         distance > candidateDistance))
+      {
+      candidate = pos;
+      candidateDistance = distance;
+      }
+    }
+
+  // A prefetched time step farther from the request than all the cached
+  // ones is not worth keeping.
+  if (prefetched && candidate != self->Cache.end() &&
+      self->EvictionPolicy ==
+        vtkTemporalDataSetCache::EVICT_FARTHEST_FROM_REQUEST)
+    {
+    double distance = time - this->CurrentTime;
+    distance = distance < 0.0 ? -distance : distance;
+    if (candidateDistance <= distance)
+      {
+      return self->Cache.end();
+      }
+    }
+  return candidate;
+}
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 vtkTemporalDataSetCache::vtkTemporalDataSetCache()
 {
   this->CacheSize = 10;
+  this->CacheMemoryLimit = 0;
+  this->EvictionPolicy = EVICT_LEAST_RECENTLY_USED;
+  this->PrefetchSize = 0;
+  this->PrefetchDirection = PREFETCH_AUTOMATIC;
+  this->NumberOfPrefetchedTimeSteps = 0;
+  this->Internals = new vtkTemporalDataSetCacheInternals;
   this->SetNumberOfInputPorts(1);
   this->SetNumberOfOutputPorts(1);
 }
@@ -41,19 +294,32 @@ vtkTemporalDataSetCache::vtkTemporalDataSetCache()
 //----------------------------------------------------------------------------
 vtkTemporalDataSetCache::~vtkTemporalDataSetCache()
 {
+  if (this->Internals->ThreadId >= 0)
+    {
+    this->Internals->Lock->Lock();
+    this->Internals->StopThread = true;
+    this->Internals->Condition->Broadcast();
+    this->Internals->Lock->Unlock();
+    this->Internals->Threader->TerminateThread(this->Internals->ThreadId);
+    }
+
   CacheType::iterator pos = this->Cache.begin();
   for (; pos != this->Cache.end();)
     {
-    pos->second.second->UnRegister(this);
-    this->Cache.erase(pos++);
+    this->RemoveTimeStep(pos++);
     }
+  delete this->Internals;
 }
 
+//----------------------------------------------------------------------------
 int vtkTemporalDataSetCache::ProcessRequest(
   vtkInformation* request,
   vtkInformationVector** inputVector,
   vtkInformationVector* outputVector)
 {
+  // the input must not be updated by the prefetch thread from now on
+  this->PausePrefetch();
+
   // create the output
   if(request->Has(vtkDemandDrivenPipeline::REQUEST_DATA_OBJECT()))
     {
@@ -103,6 +369,12 @@ void vtkTemporalDataSetCache::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "CacheSize: " << this->CacheSize << endl;
+  os << indent << "CacheMemoryLimit: " << this->CacheMemoryLimit << endl;
+  os << indent << "EvictionPolicy: " << this->EvictionPolicy << endl;
+  os << indent << "PrefetchSize: " << this->PrefetchSize << endl;
+  os << indent << "PrefetchDirection: " << this->PrefetchDirection << endl;
+  os << indent << "NumberOfPrefetchedTimeSteps: "
+     << this->NumberOfPrefetchedTimeSteps << endl;
 }
 //----------------------------------------------------------------------------
 void vtkTemporalDataSetCache::SetCacheSize(int size)
@@ -114,9 +386,11 @@ void vtkTemporalDataSetCache::SetCacheSize(int size)
     }
 
   // if growing the cache, there is no need to do anything
+  this->Internals->Lock->Lock();
   this->CacheSize = size;
   if (this->Cache.size() <= static_cast<unsigned long>(size))
     {
+    this->Internals->Lock->Unlock();
     return;
     }
 
@@ -126,9 +400,205 @@ void vtkTemporalDataSetCache::SetCacheSize(int size)
   CacheType::iterator pos = this->Cache.begin();
   for (; i > 0; --i)
     {
-    pos->second.second->UnRegister(this);
-    this->Cache.erase(pos++);
+    this->RemoveTimeStep(pos++);
+    }
+  this->Internals->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::SetCacheMemoryLimit(unsigned long limit)
+{
+  this->Internals->Lock->Lock();
+  this->CacheMemoryLimit = limit;
+  while (limit > 0 && this->Internals->MemorySize > limit)
+    {
+    CacheType::iterator pos =
+      this->Internals->FindEvictionCandidate(this, 0.0, false);
+    if (pos == this->Cache.end())
+      {
+      break;
+      }
+    this->RemoveTimeStep(pos);
+    }
+  this->Internals->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkTemporalDataSetCache::GetCacheMemorySize()
+{
+  this->Internals->Lock->Lock();
+  unsigned long size = this->Internals->MemorySize;
+  this->Internals->Lock->Unlock();
+  return size;
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::RemoveTimeStep(CacheType::iterator pos)
+{
+  std::map<double, unsigned long>::iterator size =
+    this->Internals->Sizes.find(pos->first);
+  if (size != this->Internals->Sizes.end())
+    {
+    this->Internals->MemorySize -= size->second;
+    this->Internals->Sizes.erase(size);
+    }
+  pos->second.second->UnRegister(this);
+  this->Cache.erase(pos);
+}
+
+//----------------------------------------------------------------------------
+bool vtkTemporalDataSetCache::InsertTimeStep(double time, vtkDataObject* data,
+                                             unsigned long stamp,
+                                             bool prefetched)
+{
+  if (this->Cache.find(time) != this->Cache.end())
+    {
+    return true;
+    }
+
+  // make room for the new data
+  unsigned long size = data->GetActualMemorySize();
+  while (this->Cache.size() >= static_cast<unsigned long>(this->CacheSize) ||
+         (this->CacheMemoryLimit > 0 && !this->Cache.empty() &&
+          this->Internals->MemorySize + size > this->CacheMemoryLimit))
+    {
+    CacheType::iterator pos =
+      this->Internals->FindEvictionCandidate(this, time, prefetched);
+    if (pos == this->Cache.end())
+      {
+      return false;
+      }
+    this->RemoveTimeStep(pos);
+    }
+
+  vtkDataObject* cachedData = data->NewInstance();
+  cachedData->ShallowCopy(data);
+  this->Cache[time] =
+    std::pair<unsigned long, vtkDataObject *>(stamp, cachedData);
+  this->Internals->Sizes[time] = size;
+  this->Internals->MemorySize += size;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::PausePrefetch()
+{
+  this->Internals->Lock->Lock();
+  this->Internals->Paused = true;
+  this->Internals->Queue.clear();
+  while (this->Internals->Busy)
+    {
+    this->Internals->Condition->Wait(this->Internals->Lock);
+    }
+  this->Internals->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::CancelPrefetch()
+{
+  this->PausePrefetch();
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::WaitForPrefetch()
+{
+  this->Internals->Lock->Lock();
+  while (this->Internals->Busy ||
+         (!this->Internals->Paused && !this->Internals->Queue.empty()))
+    {
+    this->Internals->Condition->Wait(this->Internals->Lock);
+    }
+  this->Internals->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::SchedulePrefetch(double upTime,
+                                               vtkInformation* inInfo)
+{
+  int count = std::min(this->PrefetchSize, this->CacheSize - 1);
+  if (count <= 0 ||
+      !inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+    {
+    return;
+    }
+
+  int producerPort = 0;
+  vtkAlgorithm* producer = this->GetInputAlgorithm(0, 0, producerPort);
+  if (!producer ||
+      !vtkStreamingDemandDrivenPipeline::SafeDownCast(producer->GetExecutive()))
+    {
+    return;
+    }
+
+  int direction = this->Internals->Direction;
+  if (this->PrefetchDirection == PREFETCH_FORWARD)
+    {
+    direction = 1;
+    }
+  else if (this->PrefetchDirection == PREFETCH_BACKWARD)
+    {
+    direction = -1;
+    }
+
+  // the time steps following the requested one in the playback direction
+  int numSteps = inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  double* steps = inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  int index = direction > 0 ?
+    static_cast<int>(std::upper_bound(steps, steps + numSteps, upTime) - steps) :
+    static_cast<int>(std::lower_bound(steps, steps + numSteps, upTime) - steps) - 1;
+
+  this->Internals->Lock->Lock();
+  this->Internals->Producer = producer;
+  this->Internals->ProducerPort = producerPort;
+  this->Internals->Queue.clear();
+  this->Internals->Window.clear();
+  for (; index >= 0 && index < numSteps && count > 0; index += direction, --count)
+    {
+    this->Internals->Window.insert(steps[index]);
+    if (this->Cache.find(steps[index]) == this->Cache.end())
+      {
+      this->Internals->Queue.push_back(steps[index]);
+      }
     }
+  this->Internals->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::ResumePrefetch()
+{
+  this->Internals->Lock->Lock();
+  if (!this->Internals->Queue.empty())
+    {
+    this->Internals->Paused = false;
+    if (this->Internals->ThreadId < 0)
+      {
+      this->Internals->ThreadId = this->Internals->Threader->SpawnThread(
+        vtkTemporalDataSetCacheInternals::PrefetchThreadStart, this);
+      }
+    this->Internals->Condition->Broadcast();
+    }
+  this->Internals->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+vtkExecutive* vtkTemporalDataSetCache::CreateDefaultExecutive()
+{
+  return vtkTemporalDataSetCacheExecutive::New();
+}
+
+//----------------------------------------------------------------------------
+int vtkTemporalDataSetCache::ComputePipelineMTime(
+  vtkInformation* request,
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec,
+  int requestFromOutputPort,
+  unsigned long* mtime)
+{
+  // This is the first request of every pipeline update, the upstream
+  // pipeline is about to be used by the main thread.
+  this->PausePrefetch();
+  return this->Superclass::ComputePipelineMTime(request, inInfoVec, outInfoVec,
+                                                requestFromOutputPort, mtime);
 }
 
 int vtkTemporalDataSetCache::RequestDataObject( vtkInformation*,
@@ -192,8 +662,7 @@ int vtkTemporalDataSetCache
     {
     if (pos->second.first < pmt)
       {
-      pos->second.second->Delete();
-      this->Cache.erase(pos++);
+      this->RemoveTimeStep(pos++);
       }
     else
       {
@@ -284,6 +753,14 @@ int vtkTemporalDataSetCache::RequestData(
 
   double inTime =  input->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP());
 
+  // keep track of the playback direction
+  if (this->Internals->HasCurrentTime && upTime != this->Internals->CurrentTime)
+    {
+    this->Internals->Direction = upTime > this->Internals->CurrentTime ? 1 : -1;
+    }
+  this->Internals->CurrentTime = upTime;
+  this->Internals->HasCurrentTime = true;
+
   // // fill in the request by using the cached data and input data
   // outData->Initialize();
 
@@ -324,43 +801,13 @@ int vtkTemporalDataSetCache::RequestData(
   // size add the requested data to the cache first
   if(input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()))
     {
-
-// is the input time not already in the cache?
-    CacheType::iterator pos1 = this->Cache.find(inTime);
-    if (pos1 == this->Cache.end())
-      {
-      // if we have room in the Cache then just add the new data
-      if (this->Cache.size() < static_cast<unsigned long>(this->CacheSize))
-        {
-        vtkDataObject* cachedData  = input->NewInstance();
-        cachedData->ShallowCopy(input);
-
-        this->Cache[inTime] =
-          std::pair<unsigned long, vtkDataObject *>
-          (outputUpdateTime, cachedData);
-        }
-      // no room in the cache, we need to get rid of something
-      else
-        {
-        // get rid of the oldest data in the cache
-        CacheType::iterator pos2 = this->Cache.begin();
-        CacheType::iterator oldestpos = this->Cache.begin();
-        for (; pos2 != this->Cache.end(); ++pos2)
-          {
-          if (pos2->second.first < oldestpos->second.first)
-            {
-            oldestpos = pos2;
-            }
-          }
-        //was there old data?
-        if (oldestpos->second.first < outputUpdateTime)
-          {
-          oldestpos->second.second->UnRegister(this);
-          this->Cache.erase(oldestpos);
-          }
-        // if no old data and no room then we are done
-        }
-      }
+    this->Internals->Lock->Lock();
+    this->InsertTimeStep(inTime, input, outputUpdateTime, false);
+    this->Internals->Lock->Unlock();
     }
+
+  // plan the read ahead of the next time steps, which starts when the
+  // executive is done with this pass
+  this->SchedulePrefetch(upTime, inInfo);
   return 1;
 }
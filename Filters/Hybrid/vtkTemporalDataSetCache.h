@@ -16,6 +16,28 @@
 // .SECTION Description
 // vtkTemporalDataSetCache cache time step requests of a temporal dataset,
 // when cached data is requested it is returned using a shallow copy.
+//
+// The cache is bounded by a number of time steps (CacheSize) and
+// optionally by memory (CacheMemoryLimit).  When it is full, the entry
+// to discard is chosen according to the EvictionPolicy.
+//
+// When PrefetchSize is larger than zero, the time steps following the
+// requested one in the playback direction are read ahead on a
+// background thread, so that animation playback does not stall on the
+// input.  Prefetching is suspended whenever the pipeline is updated and
+// the pending time steps are discarded and planned again after each
+// request, so seeking to another time cancels the read ahead of the
+// previous position.  While prefetching, the input of this filter is
+// updated from the background thread: the upstream pipeline must only
+// be consumed through this filter and should not be modified while
+// prefetching is in progress (see CancelPrefetch()).  Prefetching starts
+// when the executive has completed the data pass of this filter, so it
+// requires the default executive of the filter.
+//
+// The filter can be placed upstream of vtkTemporalInterpolator.  Since
+// the interpolator requests the two time steps that bracket each
+// interpolated time, setting the PrefetchDirection explicitly is
+// recommended in that case.
 // .SECTION Thanks
 // Ken Martin (Kitware) and John Bidiscombe of
 // CSCS - Swiss National Supercomputing Centre
@@ -33,6 +55,8 @@
 #include "vtkAlgorithm.h"
 #include <map> // used for the cache
 
+class vtkTemporalDataSetCacheInternals;
+
 class VTKFILTERSHYBRID_EXPORT vtkTemporalDataSetCache : public vtkAlgorithm
 {
 public:
@@ -46,11 +70,90 @@ public:
   void SetCacheSize(int size);
   vtkGetMacro(CacheSize,int);
 
+  // Description:
+  // Maximum amount of memory, in kibibytes, used by the cached time
+  // steps.  The default of 0 means that only CacheSize bounds the cache.
+  void SetCacheMemoryLimit(unsigned long limit);
+  vtkGetMacro(CacheMemoryLimit,unsigned long);
+
+  // Description:
+  // Return the amount of memory, in kibibytes, used by the cached time
+  // steps.
+  unsigned long GetCacheMemorySize();
+
+//BTX
+  enum EvictionPolicies
+  {
+    EVICT_LEAST_RECENTLY_USED = 0,
+    EVICT_FARTHEST_FROM_REQUEST
+  };
+//ETX
+
+  // Description:
+  // Select which time step is discarded when the cache is full: the one
+  // that was used least recently (the default) or the one farthest in
+  // time from the last requested time step.
+  vtkSetClampMacro(EvictionPolicy,int,EVICT_LEAST_RECENTLY_USED,
+                   EVICT_FARTHEST_FROM_REQUEST);
+  vtkGetMacro(EvictionPolicy,int);
+  void SetEvictionPolicyToLeastRecentlyUsed()
+    {this->SetEvictionPolicy(EVICT_LEAST_RECENTLY_USED);}
+  void SetEvictionPolicyToFarthestFromRequest()
+    {this->SetEvictionPolicy(EVICT_FARTHEST_FROM_REQUEST);}
+
+  // Description:
+  // Number of time steps following the requested one that are read
+  // ahead on a background thread.  It is limited to CacheSize - 1.
+  // Defaults to 0, which disables prefetching.
+  vtkSetClampMacro(PrefetchSize,int,0,VTK_INT_MAX);
+  vtkGetMacro(PrefetchSize,int);
+
+//BTX
+  enum PrefetchDirections
+  {
+    PREFETCH_AUTOMATIC = 0,
+    PREFETCH_FORWARD,
+    PREFETCH_BACKWARD
+  };
+//ETX
+
+  // Description:
+  // Direction in which time steps are prefetched.  In automatic mode
+  // (the default) the direction is the one of the last change of the
+  // requested time.
+  vtkSetClampMacro(PrefetchDirection,int,PREFETCH_AUTOMATIC,
+                   PREFETCH_BACKWARD);
+  vtkGetMacro(PrefetchDirection,int);
+  void SetPrefetchDirectionToAutomatic()
+    {this->SetPrefetchDirection(PREFETCH_AUTOMATIC);}
+  void SetPrefetchDirectionToForward()
+    {this->SetPrefetchDirection(PREFETCH_FORWARD);}
+  void SetPrefetchDirectionToBackward()
+    {this->SetPrefetchDirection(PREFETCH_BACKWARD);}
+
+  // Description:
+  // Discard the time steps waiting to be prefetched and wait for the
+  // one being read, if any.  Prefetching resumes with the next request.
+  void CancelPrefetch();
+
+  // Description:
+  // Wait until all the time steps scheduled for prefetching are cached.
+  void WaitForPrefetch();
+
+  // Description:
+  // Return the number of time steps read by the background thread.
+  vtkGetMacro(NumberOfPrefetchedTimeSteps,int);
+
 protected:
   vtkTemporalDataSetCache();
   ~vtkTemporalDataSetCache();
 
   int CacheSize;
+  unsigned long CacheMemoryLimit;
+  int EvictionPolicy;
+  int PrefetchSize;
+  int PrefetchDirection;
+  int NumberOfPrefetchedTimeSteps;
 
 //BTX
   typedef std::map<double,std::pair<unsigned long,vtkDataObject *> >
@@ -58,6 +161,46 @@ protected:
   CacheType Cache;
 //ETX
 
+  // Description:
+  // Add a time step to the cache, evicting other entries as needed.
+  // Prefetched time steps are not added when this would evict a time
+  // step closer to the request or another prefetched time step not
+  // used yet.  Return false when the time step was not added.
+  bool InsertTimeStep(double time, vtkDataObject* data,
+                      unsigned long stamp, bool prefetched);
+
+  // Description:
+  // Remove the given entry from the cache.
+  void RemoveTimeStep(CacheType::iterator pos);
+
+  // Description:
+  // Queue the time steps following upTime for prefetching.  They are only
+  // read once ResumePrefetch() is called.
+  void SchedulePrefetch(double upTime, vtkInformation* inInfo);
+
+  // Description:
+  // Start reading the queued time steps on the background thread.  It is
+  // called by the executive of this filter once the data pass of the
+  // filter has completed, since the input information must not be used
+  // by the background thread while the executive still uses it.
+  void ResumePrefetch();
+
+  // Description:
+  // Suspend prefetching, discarding the pending time steps, and wait for
+  // the time step currently read.
+  void PausePrefetch();
+
+  // Description:
+  // Create an executive that resumes prefetching after each data pass.
+  virtual vtkExecutive* CreateDefaultExecutive();
+
+  // Description:
+  // Suspend prefetching before the pipeline is updated.
+  virtual int ComputePipelineMTime(vtkInformation* request,
+                                   vtkInformationVector** inInfoVec,
+                                   vtkInformationVector* outInfoVec,
+                                   int requestFromOutputPort,
+                                   unsigned long* mtime);
 
   // Description:
   // see vtkAlgorithm for details
@@ -80,6 +223,10 @@ protected:
                           vtkInformationVector *);
 
 private:
+  vtkTemporalDataSetCacheInternals* Internals;
+  friend class vtkTemporalDataSetCacheInternals;
+  friend class vtkTemporalDataSetCacheExecutive;
+
   vtkTemporalDataSetCache(const vtkTemporalDataSetCache&);  // Not implemented.
   void operator=(const vtkTemporalDataSetCache&);  // Not implemented.
 };
@@ -0,0 +1,219 @@
+/*=========================================================================
+
+ Program:   Visualization Toolkit
+ Module:    TestPUnstructuredGridGhostCellsGenerator.cxx
+
+ Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+ All rights reserved.
+ See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+ This software is distributed WITHOUT ANY WARRANTY; without even
+ the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ PURPOSE.  See the above copyright notice for more information.
+
+ =========================================================================*/
+// Builds one and two layers of ghost cells for a distributed hexahedral grid,
+// matching the points by global IDs, given by name or by the GlobalIds
+// attribute, and by coordinates, and checks the ghost levels and the fields
+// of the ghost cells and points.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkExtentRCBPartitioner.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMPIController.h"
+#include "vtkMPIUtilities.h"
+#include "vtkMultiProcessController.h"
+#include "vtkPUnstructuredGridGhostCellsGenerator.h"
+#include "vtkPointData.h"
+#include "vtkStructuredData.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "UnstructuredGhostZonesCommon.h"
+
+//------------------------------------------------------------------------------
+// Checks the number of cells and points and the ghost level of each cell,
+// given the cell extent of the process grown by the number of layers.
+int CheckGhostLevels(vtkUnstructuredGrid* grid, const int ext[6],
+                     const int numLayers)
+{
+  int grown[6];
+  vtkIdType numCells = 1;
+  vtkIdType numPoints = 1;
+  for (int dim = 0; dim < 3; ++dim)
+    {
+    grown[2*dim] = std::max(0, ext[2*dim] - numLayers);
+    grown[2*dim+1] = std::min(global::Dims[dim] - 1, ext[2*dim+1] + numLayers);
+    numCells *= grown[2*dim+1] - grown[2*dim];
+    numPoints *= grown[2*dim+1] - grown[2*dim] + 1;
+    }
+  if (grid->GetNumberOfCells() != numCells ||
+      grid->GetNumberOfPoints() != numPoints)
+    {
+    cerr << "[ERROR]: rank " << global::Rank << " has "
+         << grid->GetNumberOfCells() << " cells and "
+         << grid->GetNumberOfPoints() << " points instead of " << numCells
+         << " and " << numPoints << endl;
+    return 1;
+    }
+
+  vtkDataArray* ghosts = grid->GetCellData()->GetArray("vtkGhostLevels");
+  if (ghosts == NULL)
+    {
+    cerr << "[ERROR]: no ghost levels on rank " << global::Rank << endl;
+    return 1;
+    }
+  vtkIdList* ptIds = vtkIdList::New();
+  int rc = 0;
+  for (vtkIdType cellIdx = 0; cellIdx < grid->GetNumberOfCells(); ++cellIdx)
+    {
+    // the lowest point of a hexahedron is its first point
+    grid->GetCellPoints(cellIdx, ptIds);
+    double pnt[3];
+    grid->GetPoint(ptIds->GetId(0), pnt);
+    int expected = 0;
+    for (int dim = 0; dim < 3; ++dim)
+      {
+      int ijk = static_cast<int>(
+        std::floor((pnt[dim] - global::Origin[dim]) / global::Spacing[dim] +
+                   0.5));
+      expected = std::max(expected, ext[2*dim] - ijk);
+      expected = std::max(expected, ijk - ext[2*dim+1] + 1);
+      }
+    if (ghosts->GetTuple1(cellIdx) != expected)
+      {
+      cerr << "[ERROR]: cell " << cellIdx << " on rank " << global::Rank
+           << " has ghost level " << ghosts->GetTuple1(cellIdx)
+           << " instead of " << expected << endl;
+      rc = 1;
+      break;
+      }
+    }
+  ptIds->Delete();
+  return rc;
+}
+
+//------------------------------------------------------------------------------
+// Checks that the global ID of each point, including the ghost points, is
+// the ID of the point in the global grid.
+int CheckGlobalIds(vtkUnstructuredGrid* grid)
+{
+  vtkDataArray* ids = grid->GetPointData()->GetGlobalIds();
+  if (ids == NULL)
+    {
+    cerr << "[ERROR]: no global IDs in the output of rank " << global::Rank
+         << endl;
+    return 1;
+    }
+  for (vtkIdType ptIdx = 0; ptIdx < grid->GetNumberOfPoints(); ++ptIdx)
+    {
+    double pnt[3];
+    grid->GetPoint(ptIdx, pnt);
+    int ijk[3];
+    for (int dim = 0; dim < 3; ++dim)
+      {
+      ijk[dim] = static_cast<int>(
+        std::floor((pnt[dim] - global::Origin[dim]) / global::Spacing[dim] +
+                   0.5));
+      }
+    const vtkIdType expected =
+      vtkStructuredData::ComputePointId(global::Dims, ijk);
+    if (static_cast<vtkIdType>(ids->GetTuple1(ptIdx)) != expected)
+      {
+      cerr << "[ERROR]: point " << ptIdx << " on rank " << global::Rank
+           << " has global ID " << ids->GetTuple1(ptIdx) << " instead of "
+           << expected << endl;
+      return 1;
+      }
+    }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Program main
+int TestPUnstructuredGridGhostCellsGenerator(int argc, char* argv[])
+{
+  int rc = 0;
+
+  // STEP 0: Initialize
+  vtkMPIController* cntrl = vtkMPIController::New();
+  cntrl->Initialize( &argc, &argv, 0 );
+  vtkMultiProcessController::SetGlobalController( cntrl );
+  global::Rank   = cntrl->GetLocalProcessId();
+  global::NRanks = cntrl->GetNumberOfProcesses();
+
+  // STEP 1: Generate grid in parallel in each process, and get the extent
+  // of this process
+  global::Grid = vtkUnstructuredGrid::New();
+  GenerateDataSet();
+
+  vtkExtentRCBPartitioner* partitioner = vtkExtentRCBPartitioner::New();
+  partitioner->SetGlobalExtent(
+    0,global::Dims[0]-1,0,global::Dims[1]-1,0,global::Dims[2]-1);
+  partitioner->SetNumberOfPartitions( global::NRanks );
+  partitioner->Partition();
+  int ext[6];
+  partitioner->GetPartitionExtent(global::Rank,ext);
+  partitioner->Delete();
+
+  // STEP 2: Build the layers of ghost cells
+  vtkPUnstructuredGridGhostCellsGenerator* ghostGenerator =
+      vtkPUnstructuredGridGhostCellsGenerator::New();
+  ghostGenerator->SetInputData(global::Grid);
+  ghostGenerator->SetGlobalIdsArrayName("GlobalID");
+  for (int useIds = 1; useIds >= 0; --useIds)
+    {
+    for (int numLayers = 1; numLayers <= 2; ++numLayers)
+      {
+      vtkMPIUtilities::Printf(
+        cntrl,"[INFO]: %d layers, matched by %s\n",
+        numLayers, useIds ? "global IDs" : "coordinates");
+      ghostGenerator->SetUseGlobalIds(useIds);
+      ghostGenerator->SetNumberOfGhostLayers(numLayers);
+      ghostGenerator->Update();
+
+      vtkUnstructuredGrid* ghostGrid = ghostGenerator->GetOutput();
+      rc += CheckGhostLevels(ghostGrid,ext,numLayers);
+      rc += CheckGrid(ghostGrid,0);
+      }
+    }
+
+  // STEP 3: Match the points by the GlobalIds attribute, the default when
+  // no array name is given. The attribute is unnamed, so the ghost points
+  // get their IDs from the attribute of the neighbors rather than by name.
+  vtkIdTypeArray* globalIds = vtkIdTypeArray::New();
+  globalIds->DeepCopy(global::Grid->GetPointData()->GetArray("GlobalID"));
+  globalIds->SetName(NULL);
+  global::Grid->GetPointData()->SetGlobalIds(globalIds);
+  globalIds->Delete();
+  ghostGenerator->SetGlobalIdsArrayName(NULL);
+  ghostGenerator->SetUseGlobalIds(1);
+  for (int numLayers = 1; numLayers <= 2; ++numLayers)
+    {
+    vtkMPIUtilities::Printf(
+      cntrl,"[INFO]: %d layers, matched by the GlobalIds attribute\n",
+      numLayers);
+    ghostGenerator->SetNumberOfGhostLayers(numLayers);
+    ghostGenerator->Modified();
+    ghostGenerator->Update();
+
+    vtkUnstructuredGrid* ghostGrid = ghostGenerator->GetOutput();
+    rc += CheckGhostLevels(ghostGrid,ext,numLayers);
+    rc += CheckGrid(ghostGrid,0);
+    rc += CheckGlobalIds(ghostGrid);
+    }
+
+  int globalRc = 0;
+  cntrl->AllReduce(&rc,&globalRc,1,vtkCommunicator::SUM_OP);
+
+  // STEP 4: Delete the ghost generator
+  ghostGenerator->Delete();
+  global::Grid->Delete();
+  cntrl->Finalize();
+  cntrl->Delete();
+  return( globalRc );
+}
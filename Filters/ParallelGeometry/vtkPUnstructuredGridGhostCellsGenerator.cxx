@@ -0,0 +1,1133 @@
+/*=========================================================================
+
+ Program:   Visualization Toolkit
+ Module:    vtkPUnstructuredGridGhostCellsGenerator.cxx
+
+ Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+ All rights reserved.
+ See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+ This software is distributed WITHOUT ANY WARRANTY; without even
+ the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ PURPOSE.  See the above copyright notice for more information.
+
+ =========================================================================*/
+#include "vtkPUnstructuredGridGhostCellsGenerator.h"
+
+// VTK includes
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCharArray.h"
+#include "vtkCommunicator.h"
+#include "vtkDataArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMPICommunicator.h"
+#include "vtkMPIController.h"
+#include "vtkMath.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+// C/C++ includes
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+// Tags of the messages that find the neighbors of a process.
+const int GHOST_BOUNDS_TAG          = 7801;
+const int GHOST_NEIGHBOR_COUNT_TAG  = 7802;
+const int GHOST_NEIGHBOR_BOUNDS_TAG = 7803;
+
+// Name of the ghost level arrays.
+const char* GHOST_LEVELS = "vtkGhostLevels";
+
+// Name of the cell array that holds, in the cells sent to a neighbor, the ID
+// of each cell on the process that owns it.
+const char* OWNER_CELL_IDS = "vtkGhostCellsOwnerIds";
+
+//------------------------------------------------------------------------------
+// Identifies a point across processes, by its global ID or its coordinates.
+struct PointKey
+{
+  vtkIdType Id;
+  double X[3];
+
+  bool operator<(const PointKey& other) const
+  {
+    if (this->Id != other.Id)
+      {
+      return this->Id < other.Id;
+      }
+    for (int i = 0; i < 3; ++i)
+      {
+      if (this->X[i] != other.X[i])
+        {
+        return this->X[i] < other.X[i];
+        }
+      }
+    return false;
+  }
+};
+
+typedef std::pair<PointKey, vtkIdType> KeyedPoint;
+typedef std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*> >
+  ArrayPairs;
+
+//------------------------------------------------------------------------------
+bool KeyLess(const KeyedPoint& a, const KeyedPoint& b)
+{
+  return a.first < b.first;
+}
+
+//------------------------------------------------------------------------------
+// Returns the global IDs of the points, or NULL.
+vtkDataArray* GetGlobalIds(vtkPointData* pd, const char* name)
+{
+  return name ? pd->GetArray(name) : pd->GetGlobalIds();
+}
+
+//------------------------------------------------------------------------------
+void GetPointKey(vtkPointSet* grid, vtkDataArray* ids, vtkIdType ptId,
+                 PointKey& key)
+{
+  if (ids)
+    {
+    key.Id = static_cast<vtkIdType>(ids->GetTuple1(ptId));
+    key.X[0] = key.X[1] = key.X[2] = 0.0;
+    }
+  else
+    {
+    key.Id = 0;
+    grid->GetPoint(ptId, key.X);
+    }
+}
+
+//------------------------------------------------------------------------------
+// The keys are sent as one global ID or as three coordinates.
+int GetKeySize(const vtkIdType*)
+{
+  return 1;
+}
+
+int GetKeySize(const double*)
+{
+  return 3;
+}
+
+void AppendKey(const PointKey& key, std::vector<vtkIdType>& message)
+{
+  message.push_back(key.Id);
+}
+
+void AppendKey(const PointKey& key, std::vector<double>& message)
+{
+  message.insert(message.end(), key.X, key.X + 3);
+}
+
+void ReadKey(const vtkIdType* message, PointKey& key)
+{
+  key.Id = message[0];
+  key.X[0] = key.X[1] = key.X[2] = 0.0;
+}
+
+void ReadKey(const double* message, PointKey& key)
+{
+  key.Id = 0;
+  std::copy(message, message + 3, key.X);
+}
+
+//------------------------------------------------------------------------------
+// Exchanges a buffer of values with each neighbor. The neighbors of all
+// processes must be symmetric.
+template <class T>
+bool ExchangeWithNeighbors(vtkMultiProcessController* controller,
+                           const std::vector<int>& neighbors,
+                           const std::vector<std::vector<T> >& sendValues,
+                           std::vector<std::vector<T> >& recvValues)
+{
+  const int numNeighbors = static_cast<int>(neighbors.size());
+  recvValues.assign(numNeighbors, std::vector<T>());
+  if (numNeighbors == 0)
+    {
+    return true;
+    }
+
+  // STEP 0: Exchange the lengths of the buffers
+  std::vector<vtkIdType> sendLengths(numNeighbors);
+  std::vector<vtkIdType> recvLengths(numNeighbors);
+  std::vector<vtkIdType> ones(numNeighbors, 1);
+  std::vector<vtkIdType> sendOffsets(numNeighbors);
+  std::vector<vtkIdType> recvOffsets(numNeighbors);
+  vtkIdType sendTotal = 0;
+  for (int i = 0; i < numNeighbors; ++i)
+    {
+    sendLengths[i] = static_cast<vtkIdType>(sendValues[i].size());
+    sendOffsets[i] = i;
+    sendTotal += sendLengths[i];
+    }
+  if (!controller->NeighborExchange(
+        &sendLengths[0], &ones[0], &sendOffsets[0],
+        &recvLengths[0], &ones[0], &sendOffsets[0],
+        numNeighbors, &neighbors[0]))
+    {
+    return false;
+    }
+
+  // STEP 1: Exchange the buffers, stored contiguously
+  std::vector<T> sendBuffer(std::max<vtkIdType>(sendTotal, 1));
+  vtkIdType recvTotal = 0;
+  for (int i = 0; i < numNeighbors; ++i)
+    {
+    sendOffsets[i] = (i == 0) ? 0 : sendOffsets[i-1] + sendLengths[i-1];
+    std::copy(sendValues[i].begin(), sendValues[i].end(),
+              sendBuffer.begin() + sendOffsets[i]);
+    recvOffsets[i] = recvTotal;
+    recvTotal += recvLengths[i];
+    }
+  std::vector<T> recvBuffer(std::max<vtkIdType>(recvTotal, 1));
+  if (!controller->NeighborExchange(
+        &sendBuffer[0], &sendLengths[0], &sendOffsets[0],
+        &recvBuffer[0], &recvLengths[0], &recvOffsets[0],
+        numNeighbors, &neighbors[0]))
+    {
+    return false;
+    }
+
+  for (int i = 0; i < numNeighbors; ++i)
+    {
+    recvValues[i].assign(recvBuffer.begin() + recvOffsets[i],
+                         recvBuffer.begin() + recvOffsets[i] + recvLengths[i]);
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool BoundsOverlap(const double* a, const double* b, double tolerance)
+{
+  for (int i = 0; i < 3; ++i)
+    {
+    if (a[2*i] > b[2*i+1] + tolerance || b[2*i] > a[2*i+1] + tolerance)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Computes the range of the bins, along each axis, that the bounds overlap.
+void GetBinRange(const double* bounds, const double globalMin[3],
+                 const double globalMax[3], const int dims[3],
+                 double tolerance, int range[6])
+{
+  for (int i = 0; i < 3; ++i)
+    {
+    range[2*i] = range[2*i+1] = 0;
+    if (dims[i] > 1)
+      {
+      const double width = (globalMax[i] - globalMin[i]) / dims[i];
+      const double lo = (bounds[2*i] - tolerance - globalMin[i]) / width;
+      const double hi = (bounds[2*i+1] + tolerance - globalMin[i]) / width;
+      range[2*i] = std::max(0, std::min(dims[i] - 1,
+                                        static_cast<int>(std::floor(lo))));
+      range[2*i+1] = std::max(0, std::min(dims[i] - 1,
+                                          static_cast<int>(std::floor(hi))));
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Waits for the messages sent without blocking, so that their buffers can
+// be released.
+void WaitForSends(vtkMPIController* controller,
+                  std::vector<vtkMPICommunicator::Request>& requests,
+                  int numRequests)
+{
+  if (numRequests > 0)
+    {
+    controller->WaitAll(numRequests, &requests[0]);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Finds the processes whose bounds overlap the bounds of this process. The
+// global bounds are split in one bin per process, and each process sends its
+// bounds to the processes that own the bins they overlap. The owner of a bin
+// collides the bounds it received and returns to each process the ranks and
+// bounds of the processes it overlaps. Uninitialized bounds, for a process
+// that has no points, overlap nothing.
+bool FindNeighbors(vtkMPIController* controller, const double bounds[6],
+                   std::vector<int>& neighbors,
+                   std::vector<double>& neighborBounds)
+{
+  neighbors.clear();
+  neighborBounds.clear();
+  const int numProcs = controller->GetNumberOfProcesses();
+  const int rank = controller->GetLocalProcessId();
+  const bool empty = !vtkMath::AreBoundsInitialized(const_cast<double*>(bounds));
+
+  // STEP 0: Compute the global bounds
+  double localMin[3], localMax[3], globalMin[3], globalMax[3];
+  for (int i = 0; i < 3; ++i)
+    {
+    localMin[i] = empty ? VTK_DOUBLE_MAX : bounds[2*i];
+    localMax[i] = empty ? -VTK_DOUBLE_MAX : bounds[2*i+1];
+    }
+  if (!controller->AllReduce(localMin, globalMin, 3, vtkCommunicator::MIN_OP) ||
+      !controller->AllReduce(localMax, globalMax, 3, vtkCommunicator::MAX_OP))
+    {
+    return false;
+    }
+  if (globalMin[0] > globalMax[0])
+    {
+    // no process has points
+    return true;
+    }
+
+  // STEP 1: Split the global bounds in about one bin per process, evenly
+  // along the axes they span
+  int numAxes = 0;
+  double maxWidth = 0.0;
+  for (int i = 0; i < 3; ++i)
+    {
+    numAxes += (globalMax[i] > globalMin[i]) ? 1 : 0;
+    maxWidth = std::max(maxWidth, globalMax[i] - globalMin[i]);
+    }
+  const int binsPerAxis = (numAxes == 0) ? 1 : std::max(1,
+    static_cast<int>(std::floor(std::pow(static_cast<double>(numProcs),
+                                         1.0 / numAxes) + 1.0e-6)));
+  int dims[3];
+  for (int i = 0; i < 3; ++i)
+    {
+    dims[i] = (globalMax[i] > globalMin[i]) ? binsPerAxis : 1;
+    }
+  const double tolerance = 1.0e-6 * maxWidth;
+
+  // STEP 2: Find the owners of the bins the bounds of this process overlap
+  std::set<int> owners;
+  int range[6];
+  if (!empty)
+    {
+    GetBinRange(bounds, globalMin, globalMax, dims, tolerance, range);
+    for (int k = range[4]; k <= range[5]; ++k)
+      {
+      for (int j = range[2]; j <= range[3]; ++j)
+        {
+        for (int i = range[0]; i <= range[1]; ++i)
+          {
+          owners.insert((i + dims[0]*(j + dims[1]*k)) % numProcs);
+          }
+        }
+      }
+    }
+
+  // STEP 3: Count the bounds each process receives. Each process only keeps
+  // its own count.
+  std::vector<int> counts(numProcs, 0);
+  std::vector<int> totals(numProcs, 0);
+  std::set<int>::const_iterator owner;
+  for (owner = owners.begin(); owner != owners.end(); ++owner)
+    {
+    counts[*owner] = 1;
+    }
+  if (!controller->AllReduce(&counts[0], &totals[0], numProcs,
+                             vtkCommunicator::SUM_OP))
+    {
+    return false;
+    }
+  const int numReceived = totals[rank];
+  std::vector<int>().swap(counts);
+  std::vector<int>().swap(totals);
+
+  // STEP 4: Send the rank and bounds of this process to the owners
+  double message[7] = { static_cast<double>(rank), 0, 0, 0, 0, 0, 0 };
+  std::copy(bounds, bounds + 6, message + 1);
+  std::vector<double> boxes;
+  std::vector<vtkMPICommunicator::Request> requests(
+    owners.size() + 2*numReceived);
+  int numRequests = 0;
+  for (owner = owners.begin(); owner != owners.end(); ++owner)
+    {
+    if (*owner == rank)
+      {
+      boxes.insert(boxes.end(), message, message + 7);
+      }
+    else
+      {
+      controller->NoBlockSend(message, 7, *owner, GHOST_BOUNDS_TAG,
+                              requests[numRequests++]);
+      }
+    }
+
+  // STEP 5: Receive the bounds sent to the bins of this process
+  while (static_cast<int>(boxes.size()) < 7*numReceived)
+    {
+    double box[7];
+    if (!controller->Receive(box, 7, vtkMultiProcessController::ANY_SOURCE,
+                             GHOST_BOUNDS_TAG))
+      {
+      WaitForSends(controller, requests, numRequests);
+      return false;
+      }
+    boxes.insert(boxes.end(), box, box + 7);
+    }
+
+  // STEP 6: Collide the bounds that share a bin of this process
+  const int numBoxes = static_cast<int>(boxes.size() / 7);
+  std::map<int, std::vector<int> > bins;
+  for (int b = 0; b < numBoxes; ++b)
+    {
+    GetBinRange(&boxes[7*b+1], globalMin, globalMax, dims, tolerance, range);
+    for (int k = range[4]; k <= range[5]; ++k)
+      {
+      for (int j = range[2]; j <= range[3]; ++j)
+        {
+        for (int i = range[0]; i <= range[1]; ++i)
+          {
+          const int bin = i + dims[0]*(j + dims[1]*k);
+          if (bin % numProcs == rank)
+            {
+            bins[bin].push_back(b);
+            }
+          }
+        }
+      }
+    }
+  std::vector<std::set<int> > overlaps(numBoxes);
+  std::map<int, std::vector<int> >::const_iterator bin;
+  for (bin = bins.begin(); bin != bins.end(); ++bin)
+    {
+    const std::vector<int>& inBin = bin->second;
+    for (size_t a = 0; a < inBin.size(); ++a)
+      {
+      for (size_t b = a + 1; b < inBin.size(); ++b)
+        {
+        if (BoundsOverlap(&boxes[7*inBin[a]+1], &boxes[7*inBin[b]+1],
+                          tolerance))
+          {
+          overlaps[inBin[a]].insert(inBin[b]);
+          overlaps[inBin[b]].insert(inBin[a]);
+          }
+        }
+      }
+    }
+
+  // STEP 7: Answer each process with the ranks and bounds it overlaps
+  std::map<int, std::vector<double> > found;
+  std::vector<int> replyCounts(numBoxes);
+  std::vector<std::vector<double> > replies(numBoxes);
+  for (int b = 0; b < numBoxes; ++b)
+    {
+    std::set<int>::const_iterator o;
+    for (o = overlaps[b].begin(); o != overlaps[b].end(); ++o)
+      {
+      replies[b].insert(replies[b].end(), &boxes[7 * *o], &boxes[7 * *o] + 7);
+      }
+    replyCounts[b] = static_cast<int>(overlaps[b].size());
+    const int requester = static_cast<int>(boxes[7*b]);
+    if (requester == rank)
+      {
+      for (int n = 0; n < replyCounts[b]; ++n)
+        {
+        found[static_cast<int>(replies[b][7*n])].assign(
+          &replies[b][7*n+1], &replies[b][7*n+1] + 6);
+        }
+      continue;
+      }
+    controller->NoBlockSend(&replyCounts[b], 1, requester,
+                            GHOST_NEIGHBOR_COUNT_TAG, requests[numRequests++]);
+    if (replyCounts[b] > 0)
+      {
+      controller->NoBlockSend(&replies[b][0], 7*replyCounts[b], requester,
+                              GHOST_NEIGHBOR_BOUNDS_TAG,
+                              requests[numRequests++]);
+      }
+    }
+
+  // STEP 8: Receive the answers of the owners of the bins of this process
+  for (owner = owners.begin(); owner != owners.end(); ++owner)
+    {
+    if (*owner == rank)
+      {
+      continue;
+      }
+    int count = 0;
+    if (!controller->Receive(&count, 1, *owner, GHOST_NEIGHBOR_COUNT_TAG))
+      {
+      WaitForSends(controller, requests, numRequests);
+      return false;
+      }
+    if (count > 0)
+      {
+      std::vector<double> reply(7*count);
+      if (!controller->Receive(&reply[0], 7*count, *owner,
+                               GHOST_NEIGHBOR_BOUNDS_TAG))
+        {
+        WaitForSends(controller, requests, numRequests);
+        return false;
+        }
+      for (int n = 0; n < count; ++n)
+        {
+        found[static_cast<int>(reply[7*n])].assign(
+          &reply[7*n+1], &reply[7*n+1] + 6);
+        }
+      }
+    }
+  WaitForSends(controller, requests, numRequests);
+
+  std::map<int, std::vector<double> >::const_iterator iter;
+  for (iter = found.begin(); iter != found.end(); ++iter)
+    {
+    if (iter->first != rank)
+      {
+      neighbors.push_back(iter->first);
+      neighborBounds.insert(neighborBounds.end(),
+                            iter->second.begin(), iter->second.end());
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Finds the points of the faces of 3D cells, the edges of 2D cells and the
+// points of other cells that no other cell of the grid shares, and computes
+// their bounds. The cell links of the grid must be built.
+void FindBoundaryPoints(vtkUnstructuredGrid* grid,
+                        std::vector<vtkIdType>& boundary, double bounds[6])
+{
+  const vtkIdType numPoints = grid->GetNumberOfPoints();
+  const vtkIdType numCells = grid->GetNumberOfCells();
+  std::vector<char> onBoundary(numPoints, 0);
+  vtkNew<vtkGenericCell> cell;
+  vtkNew<vtkIdList> facet;
+  vtkNew<vtkIdList> neighbors;
+  facet->SetNumberOfIds(1);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    grid->GetCell(cellId, cell.GetPointer());
+    const int dimension = cell->GetCellDimension();
+    const int numFacets = (dimension == 3) ? cell->GetNumberOfFaces() :
+                          (dimension == 2) ? cell->GetNumberOfEdges() :
+                          cell->GetNumberOfPoints();
+    for (int f = 0; f < numFacets; ++f)
+      {
+      vtkIdList* ids = facet.GetPointer();
+      if (dimension == 3)
+        {
+        ids = cell->GetFace(f)->GetPointIds();
+        }
+      else if (dimension == 2)
+        {
+        ids = cell->GetEdge(f)->GetPointIds();
+        }
+      else
+        {
+        facet->SetId(0, cell->GetPointId(f));
+        }
+      grid->GetCellNeighbors(cellId, ids, neighbors.GetPointer());
+      if (neighbors->GetNumberOfIds() == 0)
+        {
+        for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+          {
+          onBoundary[ids->GetId(i)] = 1;
+          }
+        }
+      }
+    }
+
+  boundary.clear();
+  vtkMath::UninitializeBounds(bounds);
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+    {
+    if (!onBoundary[ptId])
+      {
+      continue;
+      }
+    double x[3];
+    grid->GetPoint(ptId, x);
+    for (int i = 0; i < 3; ++i)
+      {
+      if (boundary.empty() || x[i] < bounds[2*i])
+        {
+        bounds[2*i] = x[i];
+        }
+      if (boundary.empty() || x[i] > bounds[2*i+1])
+        {
+        bounds[2*i+1] = x[i];
+        }
+      }
+    boundary.push_back(ptId);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Inserts a cell of source in dest, with its points renumbered by pointMap.
+// The faces of polyhedra are renumbered as well.
+template <class PointMap>
+vtkIdType InsertMappedCell(vtkUnstructuredGrid* source, vtkIdType cellId,
+                           PointMap& pointMap, vtkUnstructuredGrid* dest,
+                           std::vector<vtkIdType>& ids)
+{
+  vtkIdType npts, *pts;
+  source->GetCellPoints(cellId, npts, pts);
+  ids.resize(npts + 1);
+  for (vtkIdType i = 0; i < npts; ++i)
+    {
+    ids[i] = pointMap[pts[i]];
+    }
+  const int type = source->GetCellType(cellId);
+  if (type != VTK_POLYHEDRON)
+    {
+    return dest->InsertNextCell(type, npts, &ids[0]);
+    }
+
+  vtkIdType nfaces, *faces;
+  source->GetFaceStream(cellId, nfaces, faces);
+  std::vector<vtkIdType> faceIds;
+  for (vtkIdType f = 0; f < nfaces; ++f)
+    {
+    const vtkIdType nfacePts = *faces++;
+    faceIds.push_back(nfacePts);
+    for (vtkIdType i = 0; i < nfacePts; ++i)
+      {
+      faceIds.push_back(pointMap[*faces++]);
+      }
+    }
+  return dest->InsertNextCell(type, npts, &ids[0], nfaces, &faceIds[0]);
+}
+
+//------------------------------------------------------------------------------
+// Pairs the arrays of dest with the arrays of the same name in source, and
+// the unnamed attributes of dest, such as unnamed global IDs, with the same
+// attributes of source. The ghost levels are left out since they are set
+// separately.
+void PairArrays(vtkDataSetAttributes* dest, vtkDataSetAttributes* source,
+                ArrayPairs& pairs)
+{
+  pairs.clear();
+  for (int i = 0; i < dest->GetNumberOfArrays(); ++i)
+    {
+    vtkAbstractArray* array = dest->GetAbstractArray(i);
+    const char* name = array->GetName();
+    if (name && strcmp(name, GHOST_LEVELS) == 0)
+      {
+      continue;
+      }
+    vtkAbstractArray* sourceArray = NULL;
+    if (name)
+      {
+      sourceArray = source->GetAbstractArray(name);
+      }
+    else
+      {
+      const int attribute = dest->IsArrayAnAttribute(i);
+      sourceArray = (attribute >= 0) ?
+        source->GetAbstractAttribute(attribute) : NULL;
+      }
+    pairs.push_back(std::make_pair(array, sourceArray));
+    }
+}
+
+//------------------------------------------------------------------------------
+// Copies a tuple between the paired arrays. The numeric arrays that the
+// source lacks are filled with zeros.
+void CopyTuple(const ArrayPairs& pairs, vtkIdType srcId, vtkIdType dstId)
+{
+  ArrayPairs::const_iterator iter;
+  for (iter = pairs.begin(); iter != pairs.end(); ++iter)
+    {
+    if (iter->second)
+      {
+      iter->first->InsertTuple(dstId, srcId, iter->second);
+      }
+    else if (vtkDataArray* array = vtkDataArray::SafeDownCast(iter->first))
+      {
+      std::vector<double> zeros(array->GetNumberOfComponents(), 0.0);
+      array->InsertTuple(dstId, &zeros[0]);
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Adds the layers of ghost cells to a copy of the input grid, one at a time.
+class GhostLayerBuilder
+{
+public:
+  GhostLayerBuilder(vtkMPIController* controller, vtkUnstructuredGrid* input,
+                    vtkUnstructuredGrid* output, const char* idsName,
+                    bool useIds) :
+    Controller(controller), Input(input), Output(output), IdsName(idsName),
+    UseIds(useIds)
+  {
+    this->NumberOfInputPoints = input->GetNumberOfPoints();
+    this->NumberOfInputCells = input->GetNumberOfCells();
+    this->PointGhosts = vtkUnsignedCharArray::SafeDownCast(
+      output->GetPointData()->GetArray(GHOST_LEVELS));
+    this->CellGhosts = vtkUnsignedCharArray::SafeDownCast(
+      output->GetCellData()->GetArray(GHOST_LEVELS));
+  }
+
+  // Description:
+  // Adds the cells of the other processes that touch the boundary of the
+  // grid, with the given ghost level.
+  bool AddLayer(int level)
+  {
+    vtkUnstructuredGrid* grid = this->Output;
+    grid->BuildLinks();
+
+    // STEP 0: Find the boundary of the grid and the neighbors of this layer
+    std::vector<vtkIdType> boundary;
+    double bounds[6];
+    FindBoundaryPoints(grid, boundary, bounds);
+    std::vector<int> neighbors;
+    std::vector<double> neighborBounds;
+    if (!FindNeighbors(this->Controller, bounds, neighbors, neighborBounds))
+      {
+      return false;
+      }
+
+    // STEP 1: Sort the keys of the points of the grid for lookups
+    vtkDataArray* ids = this->UseIds ?
+      GetGlobalIds(grid->GetPointData(), this->IdsName) : NULL;
+    const vtkIdType numPoints = grid->GetNumberOfPoints();
+    this->Keys.resize(numPoints);
+    for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+      {
+      GetPointKey(grid, ids, ptId, this->Keys[ptId].first);
+      this->Keys[ptId].second = ptId;
+      }
+    std::sort(this->Keys.begin(), this->Keys.end(), KeyLess);
+
+    // STEP 2: Find the points this process owns that the boundary of each
+    // neighbor uses
+    std::vector<std::vector<vtkIdType> > shared;
+    bool exchanged = this->UseIds ?
+      this->MatchBoundaryPoints<vtkIdType>(neighbors, neighborBounds,
+                                           boundary, ids, shared) :
+      this->MatchBoundaryPoints<double>(neighbors, neighborBounds,
+                                        boundary, ids, shared);
+    if (!exchanged)
+      {
+      return false;
+      }
+
+    // STEP 3: Send each neighbor the cells this process owns that use
+    // these points
+    const int numNeighbors = static_cast<int>(neighbors.size());
+    std::vector<std::vector<char> > sendPieces(numNeighbors);
+    std::vector<std::vector<char> > recvPieces;
+    vtkNew<vtkIdList> pointCells;
+    for (int n = 0; n < numNeighbors; ++n)
+      {
+      std::set<vtkIdType> cells;
+      for (size_t i = 0; i < shared[n].size(); ++i)
+        {
+        grid->GetPointCells(shared[n][i], pointCells.GetPointer());
+        for (vtkIdType c = 0; c < pointCells->GetNumberOfIds(); ++c)
+          {
+          if (pointCells->GetId(c) < this->NumberOfInputCells)
+            {
+            cells.insert(pointCells->GetId(c));
+            }
+          }
+        }
+      if (!cells.empty())
+        {
+        vtkNew<vtkUnstructuredGrid> piece;
+        this->ExtractCells(cells, piece.GetPointer());
+        vtkNew<vtkCharArray> buffer;
+        vtkCommunicator::MarshalDataObject(piece.GetPointer(),
+                                           buffer.GetPointer());
+        const char* data = buffer->GetPointer(0);
+        sendPieces[n].assign(data, data + buffer->GetNumberOfTuples());
+        }
+      }
+    if (!ExchangeWithNeighbors(this->Controller, neighbors, sendPieces,
+                               recvPieces))
+      {
+      return false;
+      }
+    std::vector<std::vector<char> >().swap(sendPieces);
+
+    // STEP 4: Append the cells received
+    std::map<PointKey, vtkIdType> layerPoints;
+    for (int n = 0; n < numNeighbors; ++n)
+      {
+      if (recvPieces[n].empty())
+        {
+        continue;
+        }
+      vtkNew<vtkCharArray> buffer;
+      buffer->SetArray(&recvPieces[n][0],
+                       static_cast<vtkIdType>(recvPieces[n].size()), 1);
+      vtkNew<vtkUnstructuredGrid> piece;
+      if (!vtkCommunicator::UnMarshalDataObject(buffer.GetPointer(),
+                                                piece.GetPointer()) ||
+          !this->AppendCells(neighbors[n], piece.GetPointer(), level,
+                             layerPoints))
+        {
+        return false;
+        }
+      std::vector<char>().swap(recvPieces[n]);
+      }
+    return true;
+  }
+
+private:
+  // Description:
+  // Sends each neighbor the keys of the boundary points within its bounds.
+  // The keys received are matched against the points this process owns.
+  template <class T>
+  bool MatchBoundaryPoints(const std::vector<int>& neighbors,
+                           const std::vector<double>& neighborBounds,
+                           const std::vector<vtkIdType>& boundary,
+                           vtkDataArray* ids,
+                           std::vector<std::vector<vtkIdType> >& shared)
+  {
+    const int numNeighbors = static_cast<int>(neighbors.size());
+    std::vector<std::vector<T> > sendKeys(numNeighbors);
+    std::vector<std::vector<T> > recvKeys;
+    for (size_t i = 0; i < boundary.size(); ++i)
+      {
+      double x[3];
+      this->Output->GetPoint(boundary[i], x);
+      const double bounds[6] = { x[0], x[0], x[1], x[1], x[2], x[2] };
+      PointKey key;
+      GetPointKey(this->Output, ids, boundary[i], key);
+      for (int n = 0; n < numNeighbors; ++n)
+        {
+        if (BoundsOverlap(bounds, &neighborBounds[6*n], 0.0))
+          {
+          AppendKey(key, sendKeys[n]);
+          }
+        }
+      }
+    if (!ExchangeWithNeighbors(this->Controller, neighbors, sendKeys,
+                               recvKeys))
+      {
+      return false;
+      }
+
+    shared.assign(numNeighbors, std::vector<vtkIdType>());
+    for (int n = 0; n < numNeighbors; ++n)
+      {
+      const int keySize = GetKeySize(static_cast<T*>(NULL));
+      for (size_t i = 0; i + keySize <= recvKeys[n].size(); i += keySize)
+        {
+        KeyedPoint point;
+        ReadKey(&recvKeys[n][i], point.first);
+        std::vector<KeyedPoint>::const_iterator found = std::lower_bound(
+          this->Keys.begin(), this->Keys.end(), point, KeyLess);
+        if (found != this->Keys.end() && !KeyLess(point, *found) &&
+            found->second < this->NumberOfInputPoints)
+          {
+          shared[n].push_back(found->second);
+          }
+        }
+      }
+    return true;
+  }
+
+  // Description:
+  // Copies the given cells of the input, with their points and their point
+  // and cell data, to piece.
+  void ExtractCells(const std::set<vtkIdType>& cells,
+                    vtkUnstructuredGrid* piece)
+  {
+    vtkPointData* inPD = this->Input->GetPointData();
+    vtkCellData* inCD = this->Input->GetCellData();
+    const vtkIdType numCells = static_cast<vtkIdType>(cells.size());
+
+    vtkNew<vtkPoints> points;
+    points->SetDataType(this->Input->GetPoints()->GetDataType());
+    piece->SetPoints(points.GetPointer());
+    piece->Allocate(numCells);
+    // the global IDs are needed to match the points of the ghost layer, but
+    // vtkDataSetAttributes does not copy them by default
+    piece->GetPointData()->CopyGlobalIdsOn();
+    piece->GetCellData()->CopyGlobalIdsOn();
+    piece->GetPointData()->CopyAllocate(inPD, numCells);
+    piece->GetCellData()->CopyAllocate(inCD, numCells);
+    vtkNew<vtkIdTypeArray> ownerIds;
+    ownerIds->SetName(OWNER_CELL_IDS);
+    ownerIds->SetNumberOfTuples(numCells);
+
+    std::map<vtkIdType, vtkIdType> pointMap;
+    std::vector<vtkIdType> cellIds;
+    vtkNew<vtkIdList> cellPoints;
+    std::set<vtkIdType>::const_iterator cell;
+    for (cell = cells.begin(); cell != cells.end(); ++cell)
+      {
+      this->Input->GetCellPoints(*cell, cellPoints.GetPointer());
+      for (vtkIdType i = 0; i < cellPoints->GetNumberOfIds(); ++i)
+        {
+        const vtkIdType ptId = cellPoints->GetId(i);
+        if (pointMap.find(ptId) == pointMap.end())
+          {
+          const vtkIdType newId =
+            points->InsertNextPoint(this->Input->GetPoint(ptId));
+          piece->GetPointData()->CopyData(inPD, ptId, newId);
+          pointMap[ptId] = newId;
+          }
+        }
+      const vtkIdType newCellId =
+        InsertMappedCell(this->Input, *cell, pointMap, piece, cellIds);
+      piece->GetCellData()->CopyData(inCD, *cell, newCellId);
+      ownerIds->SetValue(newCellId, *cell);
+      }
+    piece->GetCellData()->AddArray(ownerIds.GetPointer());
+  }
+
+  // Description:
+  // Appends the cells of a piece received from a neighbor that the grid does
+  // not hold yet. The points are merged with the points of the grid and
+  // with the points of the layer appended so far.
+  bool AppendCells(int neighbor, vtkUnstructuredGrid* piece, int level,
+                   std::map<PointKey, vtkIdType>& layerPoints)
+  {
+    vtkUnstructuredGrid* grid = this->Output;
+    vtkIdTypeArray* ownerIds = vtkIdTypeArray::SafeDownCast(
+      piece->GetCellData()->GetArray(OWNER_CELL_IDS));
+    vtkDataArray* ids = this->UseIds ?
+      GetGlobalIds(piece->GetPointData(), this->IdsName) : NULL;
+    if (!ownerIds || (this->UseIds && !ids))
+      {
+      return false;
+      }
+
+    ArrayPairs pointArrays;
+    ArrayPairs cellArrays;
+    PairArrays(grid->GetPointData(), piece->GetPointData(), pointArrays);
+    PairArrays(grid->GetCellData(), piece->GetCellData(), cellArrays);
+
+    std::vector<vtkIdType> pointMap(piece->GetNumberOfPoints(), -1);
+    std::vector<vtkIdType> cellIds;
+    for (vtkIdType cellId = 0; cellId < piece->GetNumberOfCells(); ++cellId)
+      {
+      const std::pair<int, vtkIdType> owner(neighbor,
+                                            ownerIds->GetValue(cellId));
+      if (!this->ReceivedCells.insert(owner).second)
+        {
+        continue;
+        }
+
+      vtkIdType npts, *pts;
+      piece->GetCellPoints(cellId, npts, pts);
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        if (pointMap[pts[i]] >= 0)
+          {
+          continue;
+          }
+        KeyedPoint point;
+        GetPointKey(piece, ids, pts[i], point.first);
+        std::vector<KeyedPoint>::const_iterator found = std::lower_bound(
+          this->Keys.begin(), this->Keys.end(), point, KeyLess);
+        if (found != this->Keys.end() && !KeyLess(point, *found))
+          {
+          pointMap[pts[i]] = found->second;
+          continue;
+          }
+        std::map<PointKey, vtkIdType>::const_iterator added =
+          layerPoints.find(point.first);
+        if (added != layerPoints.end())
+          {
+          pointMap[pts[i]] = added->second;
+          continue;
+          }
+        const vtkIdType newId =
+          grid->GetPoints()->InsertNextPoint(piece->GetPoint(pts[i]));
+        CopyTuple(pointArrays, pts[i], newId);
+        this->PointGhosts->InsertValue(newId, static_cast<unsigned char>(level));
+        layerPoints[point.first] = newId;
+        pointMap[pts[i]] = newId;
+        }
+
+      const vtkIdType newCellId =
+        InsertMappedCell(piece, cellId, pointMap, grid, cellIds);
+      CopyTuple(cellArrays, cellId, newCellId);
+      this->CellGhosts->InsertValue(newCellId, static_cast<unsigned char>(level));
+      }
+    return true;
+  }
+
+  vtkMPIController* Controller;
+  vtkUnstructuredGrid* Input;
+  vtkUnstructuredGrid* Output;
+  const char* IdsName;
+  bool UseIds;
+  vtkIdType NumberOfInputPoints;
+  vtkIdType NumberOfInputCells;
+  vtkUnsignedCharArray* PointGhosts;
+  vtkUnsignedCharArray* CellGhosts;
+
+  // The keys of the points of the grid, sorted, at the start of a layer.
+  std::vector<KeyedPoint> Keys;
+
+  // The (rank, cell ID) of the cells received from the other processes.
+  std::set<std::pair<int, vtkIdType> > ReceivedCells;
+};
+
+} // END anonymous namespace
+
+vtkStandardNewMacro(vtkPUnstructuredGridGhostCellsGenerator);
+vtkCxxSetObjectMacro(vtkPUnstructuredGridGhostCellsGenerator, Controller,
+                     vtkMultiProcessController);
+
+//------------------------------------------------------------------------------
+vtkPUnstructuredGridGhostCellsGenerator::vtkPUnstructuredGridGhostCellsGenerator()
+{
+  this->Controller = NULL;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+  this->NumberOfGhostLayers = 1;
+  this->UseGlobalIds = 1;
+  this->GlobalIdsArrayName = NULL;
+}
+
+//------------------------------------------------------------------------------
+vtkPUnstructuredGridGhostCellsGenerator::~vtkPUnstructuredGridGhostCellsGenerator()
+{
+  this->SetController(NULL);
+  this->SetGlobalIdsArrayName(NULL);
+}
+
+//------------------------------------------------------------------------------
+void vtkPUnstructuredGridGhostCellsGenerator::PrintSelf(
+      ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "NumberOfGhostLayers: " << this->NumberOfGhostLayers << endl;
+  os << indent << "UseGlobalIds: " << this->UseGlobalIds << endl;
+  os << indent << "GlobalIdsArrayName: "
+     << (this->GlobalIdsArrayName ? this->GlobalIdsArrayName : "(none)")
+     << endl;
+}
+
+//------------------------------------------------------------------------------
+int vtkPUnstructuredGridGhostCellsGenerator::RequestUpdateExtent(
+    vtkInformation* vtkNotUsed(rqst),
+    vtkInformationVector** inputVector,
+    vtkInformationVector* vtkNotUsed(outputVector))
+{
+  // The ghost cells are built here, not upstream.
+  vtkInformation* input = inputVector[0]->GetInformationObject(0);
+  input->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(),
+             0);
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkPUnstructuredGridGhostCellsGenerator::RequestData(
+    vtkInformation* vtkNotUsed(rqst),
+    vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector)
+{
+  // STEP 0: Get the input and output grids
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkUnstructuredGrid* input = vtkUnstructuredGrid::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkUnstructuredGrid* output = vtkUnstructuredGrid::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+  assert("pre: input grid is NULL!" && (input != NULL) );
+  assert("pre: output grid is NULL!" && (output != NULL) );
+
+  int numLayers = this->NumberOfGhostLayers;
+  if (outInfo->Has(
+        vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS()))
+    {
+    numLayers = std::max(numLayers, outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS()));
+    }
+
+  // STEP 1: Copy the input, with all its cells and points at ghost level 0
+  output->DeepCopy(input);
+  if (!output->GetPoints())
+    {
+    vtkNew<vtkPoints> points;
+    output->SetPoints(points.GetPointer());
+    }
+  if (!output->GetCells())
+    {
+    output->Allocate();
+    }
+  output->GetPointData()->RemoveArray(GHOST_LEVELS);
+  output->GetCellData()->RemoveArray(GHOST_LEVELS);
+  vtkNew<vtkUnsignedCharArray> pointGhosts;
+  pointGhosts->SetName(GHOST_LEVELS);
+  pointGhosts->SetNumberOfTuples(output->GetNumberOfPoints());
+  pointGhosts->FillComponent(0, 0);
+  output->GetPointData()->AddArray(pointGhosts.GetPointer());
+  vtkNew<vtkUnsignedCharArray> cellGhosts;
+  cellGhosts->SetName(GHOST_LEVELS);
+  cellGhosts->SetNumberOfTuples(output->GetNumberOfCells());
+  cellGhosts->FillComponent(0, 0);
+  output->GetCellData()->AddArray(cellGhosts.GetPointer());
+
+  const int numProcs =
+    this->Controller ? this->Controller->GetNumberOfProcesses() : 1;
+  if (numProcs > 1 && numLayers > 0)
+    {
+    vtkMPIController* controller =
+      vtkMPIController::SafeDownCast(this->Controller);
+    if (controller == NULL)
+      {
+      vtkErrorMacro("Ghost cells across processes require a vtkMPIController.");
+      return 0;
+      }
+
+    // STEP 2: Match points by global IDs only if all processes have them
+    vtkDataArray* ids =
+      GetGlobalIds(input->GetPointData(), this->GlobalIdsArrayName);
+    int hasIds = (this->UseGlobalIds &&
+                  (ids != NULL || input->GetNumberOfPoints() == 0)) ? 1 : 0;
+    int allHaveIds = 0;
+    if (!controller->AllReduce(&hasIds, &allHaveIds, 1,
+                               vtkCommunicator::MIN_OP))
+      {
+      vtkErrorMacro("Could not agree on how to match the points.");
+      return 0;
+      }
+    if (this->UseGlobalIds && !allHaveIds)
+      {
+      vtkDebugMacro("Matching points by their coordinates since global IDs "
+                    "are missing on some processes.");
+      }
+
+    // STEP 3: Add the layers one at a time
+    GhostLayerBuilder builder(controller, input, output,
+                              (ids && allHaveIds) ? ids->GetName() : NULL,
+                              allHaveIds != 0);
+    for (int level = 1; level <= numLayers; ++level)
+      {
+      if (!builder.AddLayer(level))
+        {
+        vtkErrorMacro("Could not build ghost layer " << level << ".");
+        return 0;
+        }
+      }
+    output->Squeeze();
+    }
+
+  output->GetInformation()->Set(vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS(),
+                                numLayers);
+  return 1;
+}
@@ -0,0 +1,125 @@
+/*=========================================================================
+
+ Program:   Visualization Toolkit
+ Module:    vtkPUnstructuredGridGhostCellsGenerator.h
+
+ Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+ All rights reserved.
+ See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+ This software is distributed WITHOUT ANY WARRANTY; without even
+ the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ PURPOSE.  See the above copyright notice for more information.
+
+ =========================================================================*/
+// .NAME vtkPUnstructuredGridGhostCellsGenerator -- Builds layers of ghost
+//  cells for a distributed unstructured grid.
+//
+// .SECTION Description
+//  This filter adds to the grid of each process the cells of the other
+//  processes that are within the requested number of layers, with all their
+//  point and cell data. It marks them with the "vtkGhostLevels" point and
+//  cell arrays. No process ever holds information on all the other
+//  processes. Each layer is built as follows:
+//  <ol>
+//    <li> Each process finds the points on the boundary of its grid, i.e.,
+//         the points of the faces that no other local cell shares. </li>
+//    <li> The bounds of the boundary points are binned on a coarse grid of
+//         the global bounds, with one bin per process. Each process collides
+//         the bounds that fall in its bins and returns the overlapping
+//         processes, which become the neighbors of the layer. </li>
+//    <li> Each process sends to each neighbor the global IDs, or the
+//         coordinates, of its boundary points that lie in the bounds of the
+//         neighbor. </li>
+//    <li> Each process answers with the cells it owns that use one of the
+//         points it received, and appends the cells it receives. </li>
+//  </ol>
+//  Since the bounds are collided again for each layer, the cells of a
+//  process that only becomes a neighbor through the ghost cells of a former
+//  layer are found as well.
+//
+// .SECTION Caveats
+//  <ul>
+//    <li> The code currently assumes one grid per rank. </li>
+//    <li> The grid must be globally conforming, i.e., no hanging nodes. </li>
+//    <li> Points are matched by their coordinates when any process lacks
+//         global IDs. The coordinates of a point must then be identical on
+//         all the processes that share it. </li>
+//    <li> PointData and CellData must match across partitions/processes.
+//         The numeric arrays missing on a process are filled with zeros. </li>
+//    <li> More than one process requires a vtkMPIController. </li>
+//  </ul>
+//
+// .SECTION See Also
+//  vtkPUnstructuredGridGhostDataGenerator
+
+#ifndef VTKPUNSTRUCTUREDGRIDGHOSTCELLSGENERATOR_H_
+#define VTKPUNSTRUCTUREDGRIDGHOSTCELLSGENERATOR_H_
+
+#include "vtkFiltersParallelGeometryModule.h" // For export macro
+#include "vtkUnstructuredGridAlgorithm.h"
+
+// Forward Declarations
+class vtkInformation;
+class vtkInformationVector;
+class vtkMultiProcessController;
+
+class VTKFILTERSPARALLELGEOMETRY_EXPORT vtkPUnstructuredGridGhostCellsGenerator:
+  public vtkUnstructuredGridAlgorithm
+{
+public:
+  static vtkPUnstructuredGridGhostCellsGenerator* New();
+  vtkTypeMacro(vtkPUnstructuredGridGhostCellsGenerator,
+               vtkUnstructuredGridAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set/Get the controller used for communication. By default, the global
+  // controller.
+  virtual void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+
+  // Description:
+  // Set/Get the number of layers of ghost cells to build. A larger number of
+  // ghost levels requested downstream takes precedence. Default is 1.
+  vtkSetClampMacro(NumberOfGhostLayers, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfGhostLayers, int);
+
+  // Description:
+  // When on, points shared by processes are matched by their global IDs,
+  // from the point data array named GlobalIdsArrayName, or from the global
+  // IDs attribute when no name is set. When off, or when a process has no
+  // such array, points are matched by their coordinates. Default is on.
+  vtkSetMacro(UseGlobalIds, int);
+  vtkGetMacro(UseGlobalIds, int);
+  vtkBooleanMacro(UseGlobalIds, int);
+
+  // Description:
+  // Set/Get the name of the point data array of global IDs. By default, no
+  // name is set and the global IDs attribute is used.
+  vtkSetStringMacro(GlobalIdsArrayName);
+  vtkGetStringMacro(GlobalIdsArrayName);
+
+protected:
+  vtkPUnstructuredGridGhostCellsGenerator();
+  virtual ~vtkPUnstructuredGridGhostCellsGenerator();
+
+  // Standard VTK pipeline routines
+  virtual int RequestUpdateExtent(
+      vtkInformation *rqst, vtkInformationVector **inputVector,
+      vtkInformationVector* outputVector );
+  virtual int RequestData(
+      vtkInformation *rqst, vtkInformationVector **inputVector,
+      vtkInformationVector* outputVector );
+
+  vtkMultiProcessController* Controller;
+  int NumberOfGhostLayers;
+  int UseGlobalIds;
+  char* GlobalIdsArrayName;
+
+private:
+  vtkPUnstructuredGridGhostCellsGenerator(const vtkPUnstructuredGridGhostCellsGenerator&); // Not implemented
+  void operator=(const vtkPUnstructuredGridGhostCellsGenerator&); // Not implemented
+};
+
+#endif /* VTKPUNSTRUCTUREDGRIDGHOSTCELLSGENERATOR_H_ */
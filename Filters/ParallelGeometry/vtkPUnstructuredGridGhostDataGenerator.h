@@ -30,7 +30,7 @@
 //  </ul>
 //
 // .SECTION See Also
-//  vtkPUnstructuredGridConnectivity
+//  vtkPUnstructuredGridConnectivity, vtkPUnstructuredGridGhostCellsGenerator
 
 #ifndef VTKPUNSTRUCTUREDGRIDGHOSTDATAGENERATOR_H_
 #define VTKPUNSTRUCTUREDGRIDGHOSTDATAGENERATOR_H_
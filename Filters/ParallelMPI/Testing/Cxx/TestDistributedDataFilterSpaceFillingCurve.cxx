@@ -0,0 +1,361 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDistributedDataFilterSpaceFillingCurve.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME TestDistributedDataFilterSpaceFillingCurve.cxx -- Redistributes a
+//  grid along a space filling curve.
+//
+// .SECTION Description
+//  Each process starts with cells scattered all over a hexahedral grid.
+//  The grid is redistributed along the Morton curve with each boundary
+//  mode, and the test checks that no cell is lost or doubled, that the
+//  cells end up in the region of their process, that split cells keep
+//  the volume of the grid, and that ghost cells are added.  The parts of
+//  a grid whose cells are clustered in a corner must stay balanced too.
+
+// VTK includes
+#include "vtkCell.h"
+#include "vtkCellData.h"
+#include "vtkDistributedDataFilter.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSpaceFillingCurvePartitioner.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTetra.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+// C++ includes
+#include <cmath>
+#include <vector>
+
+namespace
+{
+// Number of cells along each axis.
+const int N = 12;
+
+//------------------------------------------------------------------------------
+// Builds the cells (i, j, k) of the grid such that i + j + k = rank modulo
+// the number of processes, with global point IDs and the index of each
+// cell as a cell array.
+vtkUnstructuredGrid* MakeScatteredGrid(int rank, int numProcs)
+{
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::New();
+  vtkPoints* points = vtkPoints::New();
+  vtkIdTypeArray* pointIds = vtkIdTypeArray::New();
+  pointIds->SetName("GlobalNodeIds");
+  for (int k = 0; k <= N; ++k)
+    {
+    for (int j = 0; j <= N; ++j)
+      {
+      for (int i = 0; i <= N; ++i)
+        {
+        points->InsertNextPoint(i, j, k);
+        pointIds->InsertNextValue(i + (N + 1)*(j + (N + 1)*k));
+        }
+      }
+    }
+  grid->SetPoints(points);
+  grid->GetPointData()->SetGlobalIds(pointIds);
+  points->Delete();
+  pointIds->Delete();
+
+  vtkIntArray* cellIndex = vtkIntArray::New();
+  cellIndex->SetName("CellIndex");
+  grid->Allocate(N*N*N/numProcs + 1);
+  for (int k = 0; k < N; ++k)
+    {
+    for (int j = 0; j < N; ++j)
+      {
+      for (int i = 0; i < N; ++i)
+        {
+        if ((i + j + k) % numProcs != rank)
+          {
+          continue;
+          }
+        vtkIdType p = i + (N + 1)*(j + (N + 1)*k);
+        const vtkIdType dj = N + 1;
+        const vtkIdType dk = (N + 1)*(N + 1);
+        vtkIdType hex[8] = { p, p + 1, p + 1 + dj, p + dj,
+                             p + dk, p + 1 + dk, p + 1 + dj + dk, p + dj + dk };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        cellIndex->InsertNextValue(i + N*(j + N*k));
+        }
+      }
+    }
+  grid->GetCellData()->AddArray(cellIndex);
+  cellIndex->Delete();
+  return grid;
+}
+
+//------------------------------------------------------------------------------
+// Checks that every cell of the grid is on exactly one process, and that
+// the center of each cell is in the region of this process.
+int CheckOneRegion(vtkMPIController* controller, vtkUnstructuredGrid* grid,
+                   vtkSpaceFillingCurvePartitioner* partitioner)
+{
+  int rank = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+  vtkDataArray* cellIndex = grid->GetCellData()->GetArray("CellIndex");
+  if (cellIndex == NULL)
+    {
+    cerr << "[ERROR]: the cell array is lost on process " << rank << endl;
+    return 1;
+    }
+
+  int errors = 0;
+  vtkIdType numCells = grid->GetNumberOfCells();
+  double sum = 0.0;
+  vtkIdList* ptIds = vtkIdList::New();
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    sum += cellIndex->GetTuple1(cellId);
+    grid->GetCellPoints(cellId, ptIds);
+    double center[3] = { 0.0, 0.0, 0.0 };
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+      double x[3];
+      grid->GetPoint(ptIds->GetId(i), x);
+      center[0] += x[0] / ptIds->GetNumberOfIds();
+      center[1] += x[1] / ptIds->GetNumberOfIds();
+      center[2] += x[2] / ptIds->GetNumberOfIds();
+      }
+    if (partitioner->GetProcessContainingPoint(
+          center[0], center[1], center[2]) != rank)
+      {
+      cerr << "[ERROR]: cell " << cellIndex->GetTuple1(cellId)
+           << " is not in the region of process " << rank << endl;
+      errors++;
+      break;
+      }
+    }
+  ptIds->Delete();
+
+  vtkIdType totalCells = 0;
+  vtkIdType maxCells = 0;
+  double totalSum = 0.0;
+  controller->AllReduce(&numCells, &totalCells, 1, vtkCommunicator::SUM_OP);
+  controller->AllReduce(&numCells, &maxCells, 1, vtkCommunicator::MAX_OP);
+  controller->AllReduce(&sum, &totalSum, 1, vtkCommunicator::SUM_OP);
+  const vtkIdType expected = N*N*N;
+  if (totalCells != expected ||
+      totalSum != 0.5*static_cast<double>(expected)*(expected - 1))
+    {
+    cerr << "[ERROR]: " << totalCells << " cells instead of " << expected
+         << " on process " << rank << endl;
+    errors++;
+    }
+  if (maxCells > 2*expected/numProcs + 1)
+    {
+    cerr << "[ERROR]: unbalanced parts with up to " << maxCells
+         << " cells" << endl;
+    errors++;
+    }
+  return errors;
+}
+
+//------------------------------------------------------------------------------
+// Checks that the cells split along the regions keep the volume of the grid.
+// The cells inside one box of the region are not split.
+int CheckSplitCells(vtkMPIController* controller, vtkUnstructuredGrid* grid)
+{
+  double volume = 0.0;
+  int errors = 0;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+    {
+    vtkCell* cell = grid->GetCell(cellId);
+    if (cell->GetCellType() == VTK_HEXAHEDRON)
+      {
+      // the cells kept whole are the unit cubes of the input
+      volume += 1.0;
+      continue;
+      }
+    if (cell->GetCellType() != VTK_TETRA)
+      {
+      cerr << "[ERROR]: split cells must be tetrahedra" << endl;
+      errors++;
+      break;
+      }
+    double x[4][3];
+    for (int i = 0; i < 4; ++i)
+      {
+      cell->GetPoints()->GetPoint(i, x[i]);
+      }
+    volume += std::fabs(vtkTetra::ComputeVolume(x[0], x[1], x[2], x[3]));
+    }
+
+  double totalVolume = 0.0;
+  controller->AllReduce(&volume, &totalVolume, 1, vtkCommunicator::SUM_OP);
+  if (std::fabs(totalVolume - N*N*N) > 1e-6*N*N*N)
+    {
+    cerr << "[ERROR]: the split cells have a volume of " << totalVolume
+         << " instead of " << N*N*N << endl;
+    errors++;
+    }
+  return errors;
+}
+
+//------------------------------------------------------------------------------
+// Checks that the parts stay balanced when the cells are clustered in a
+// corner of the bounds: the last layer of points is moved far away, so that
+// all the other cells lie in one node of the octree level of the cells.
+int CheckClusteredGrid(vtkMPIController* controller, int rank, int numProcs)
+{
+  vtkUnstructuredGrid* grid = MakeScatteredGrid(rank, numProcs);
+  vtkPoints* points = grid->GetPoints();
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+    {
+    double x[3];
+    points->GetPoint(ptId, x);
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      x[axis] = (x[axis] == N ? 1e6 : x[axis]);
+      }
+    points->SetPoint(ptId, x);
+    }
+
+  vtkSpaceFillingCurvePartitioner* partitioner =
+    vtkSpaceFillingCurvePartitioner::New();
+  partitioner->SetController(controller);
+  int errors = 0;
+  if (!partitioner->BuildPartition(grid))
+    {
+    cerr << "[ERROR]: no partition of the clustered grid" << endl;
+    errors++;
+    }
+  else
+    {
+    partitioner->CreateCellLists(grid, 0);
+    std::vector<vtkIdType> numCells(numProcs);
+    std::vector<vtkIdType> totalCells(numProcs);
+    for (int proc = 0; proc < numProcs; ++proc)
+      {
+      numCells[proc] = partitioner->GetCellList(proc)->GetNumberOfIds();
+      }
+    controller->AllReduce(&numCells[0], &totalCells[0], numProcs,
+                          vtkCommunicator::SUM_OP);
+    const vtkIdType expected = N*N*N;
+    for (int proc = 0; proc < numProcs; ++proc)
+      {
+      if (totalCells[proc] == 0 ||
+          totalCells[proc] > 3*expected/(2*numProcs) + 1)
+        {
+        cerr << "[ERROR]: process " << proc << " gets " << totalCells[proc]
+             << " cells of the clustered grid" << endl;
+        errors++;
+        break;
+        }
+      }
+    }
+  partitioner->Delete();
+  grid->Delete();
+  return errors;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestDistributedDataFilterSpaceFillingCurve(int argc, char* argv[])
+{
+  vtkMPIController* controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv, 0);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int rank = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+  int errors = 0;
+
+  vtkUnstructuredGrid* input = MakeScatteredGrid(rank, numProcs);
+
+  vtkDistributedDataFilter* d3 = vtkDistributedDataFilter::New();
+  d3->SetController(controller);
+  d3->SetPartitionMethodToSpaceFillingCurve();
+  d3->SetInputData(input);
+
+  // STEP 1: Each cell goes to the process holding its center
+  d3->SetBoundaryModeToAssignToOneRegion();
+  d3->Update();
+  vtkUnstructuredGrid* output =
+    vtkUnstructuredGrid::SafeDownCast(d3->GetOutput());
+  errors += CheckOneRegion(controller, output, d3->GetCurvePartitioner());
+  vtkIdType numOwnCells = output->GetNumberOfCells();
+
+  // STEP 2: Cells also go to the processes whose region they meet
+  d3->SetBoundaryModeToAssignToAllIntersectingRegions();
+  d3->Modified();
+  d3->Update();
+  output = vtkUnstructuredGrid::SafeDownCast(d3->GetOutput());
+  if (output->GetNumberOfCells() < numOwnCells)
+    {
+    cerr << "[ERROR]: process " << rank << " lost cells when duplicating"
+         << endl;
+    errors++;
+    }
+
+  // STEP 3: Cells are split along the regions
+  d3->SetBoundaryModeToSplitBoundaryCells();
+  d3->Modified();
+  d3->Update();
+  output = vtkUnstructuredGrid::SafeDownCast(d3->GetOutput());
+  if (numProcs > 1)
+    {
+    errors += CheckSplitCells(controller, output);
+    }
+
+  // STEP 4: One layer of ghost cells
+  d3->SetBoundaryModeToAssignToOneRegion();
+  d3->Modified();
+  d3->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+    d3->GetOutputInformation(0), rank, numProcs, 1);
+  d3->Update();
+  output = vtkUnstructuredGrid::SafeDownCast(d3->GetOutput());
+  vtkUnsignedCharArray* ghosts = vtkUnsignedCharArray::SafeDownCast(
+    output->GetCellData()->GetArray("vtkGhostLevels"));
+  if (ghosts == NULL)
+    {
+    cerr << "[ERROR]: no ghost levels on process " << rank << endl;
+    errors++;
+    }
+  else
+    {
+    vtkIdType numLevel0 = 0;
+    vtkIdType numLevel1 = 0;
+    for (vtkIdType i = 0; i < ghosts->GetNumberOfTuples(); ++i)
+      {
+      numLevel0 += (ghosts->GetValue(i) == 0);
+      numLevel1 += (ghosts->GetValue(i) == 1);
+      }
+    if (numLevel0 != numOwnCells || (numProcs > 1 && numLevel1 == 0))
+      {
+      cerr << "[ERROR]: process " << rank << " has " << numLevel0
+           << " cells and " << numLevel1 << " ghost cells" << endl;
+      errors++;
+      }
+    }
+
+  // STEP 5: Balanced parts of a clustered grid
+  errors += CheckClusteredGrid(controller, rank, numProcs);
+
+  int allErrors = 0;
+  controller->AllReduce(&errors, &allErrors, 1, vtkCommunicator::SUM_OP);
+
+  d3->Delete();
+  input->Delete();
+  controller->Finalize();
+  controller->Delete();
+  return (allErrors != 0);
+}
@@ -5,6 +5,7 @@ vtk_module(vtkFiltersParallelMPI
     vtkFiltersExtraction
     vtkFiltersGeneral
     vtkFiltersParallel
+    vtkFiltersParallelGeometry
     vtkImagingCore
     vtkParallelCore
     vtkParallelMPI
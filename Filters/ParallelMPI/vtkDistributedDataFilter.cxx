@@ -46,8 +46,11 @@
 #include "vtkPlane.h"
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPUnstructuredGridGhostCellsGenerator.h"
 #include "vtkSmartPointer.h"
 #include "vtkSocketController.h"
+#include "vtkSpaceFillingCurvePartitioner.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkToolkits.h"
 #include "vtkUnsignedCharArray.h"
@@ -85,6 +88,8 @@ public:
 vtkDistributedDataFilter::vtkDistributedDataFilter()
 {
   this->Kdtree = NULL;
+  this->CurvePartitioner = NULL;
+  this->PartitionMethod = vtkDistributedDataFilter::KD_TREE_PARTITION;
 
   this->Controller = NULL;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -118,6 +123,12 @@ vtkDistributedDataFilter::~vtkDistributedDataFilter()
     this->Kdtree = NULL;
     }
 
+  if (this->CurvePartitioner)
+    {
+    this->CurvePartitioner->Delete();
+    this->CurvePartitioner = NULL;
+    }
+
   this->SetController(NULL);
 
   delete [] this->Target;
@@ -225,6 +236,10 @@ void vtkDistributedDataFilter::SetController(vtkMultiProcessController *c)
     {
     this->Kdtree->SetController(c);
     }
+  if (this->CurvePartitioner)
+    {
+    this->CurvePartitioner->SetController(c);
+    }
 
   if ((c == NULL) || (c->GetNumberOfProcesses() == 0))
     {
@@ -574,11 +589,15 @@ int vtkDistributedDataFilter::RequestDataInternal(vtkDataSet* input,
     return 1;
     }
 
+  int alongCurve = (this->PartitionMethod ==
+                    vtkDistributedDataFilter::SPACE_FILLING_CURVE_PARTITION);
+
   // Stage (0) - If any processes have 0 cell input data sets, then
   //   spread the input data sets around (quickly) before formal
-  //   redistribution.
+  //   redistribution.  The sample sort does not need it.
 
-  vtkDataSet *splitInput = this->TestFixTooFewInputFiles(input);
+  vtkDataSet *splitInput =
+    alongCurve ? input : this->TestFixTooFewInputFiles(input);
 
   if (splitInput == NULL)
     {
@@ -594,27 +613,42 @@ int vtkDistributedDataFilter::RequestDataInternal(vtkDataSet* input,
   //
   // Note k-d tree will only be re-built if input or parameters
   // have changed on any of the processing nodes.
+  //
+  // Or sort the cells along a space filling curve.
 
-  int fail = this->PartitionDataAndAssignToProcesses(splitInput);
-
-  if (fail)
+  if (alongCurve)
     {
-    if (splitInput != input)
+    if (this->PartitionAlongCurve(splitInput))
       {
-      splitInput->Delete();
+      vtkErrorMacro(<< "vtkDistributedDataFilter::Execute "
+                    "space filling curve failure");
+      return 1;
       }
-    vtkErrorMacro(<< "vtkDistributedDataFilter::Execute k-d tree failure");
-    return 1;
+    this->UpdateProgress(this->NextProgressStep++ * this->ProgressIncrement);
     }
+  else
+    {
+    int fail = this->PartitionDataAndAssignToProcesses(splitInput);
 
-  this->UpdateProgress(this->NextProgressStep++ * this->ProgressIncrement);
-  this->SetProgressText("Compute global data array bounds");
+    if (fail)
+      {
+      if (splitInput != input)
+        {
+        splitInput->Delete();
+        }
+      vtkErrorMacro(<< "vtkDistributedDataFilter::Execute k-d tree failure");
+      return 1;
+      }
 
-  // Let the vtkPKdTree class compile global bounds for all
-  // data arrays.  These can be accessed by D3 user by getting
-  // a handle to the vtkPKdTree object and querying it.
+    this->UpdateProgress(this->NextProgressStep++ * this->ProgressIncrement);
+    this->SetProgressText("Compute global data array bounds");
+
+    // Let the vtkPKdTree class compile global bounds for all
+    // data arrays.  These can be accessed by D3 user by getting
+    // a handle to the vtkPKdTree object and querying it.
 
-  this->Kdtree->CreateGlobalDataArrayBounds();
+    this->Kdtree->CreateGlobalDataArrayBounds();
+    }
 
   this->UpdateProgress(this->NextProgressStep++ * this->ProgressIncrement);
   this->SetProgressText("Redistribute data");
@@ -631,8 +665,11 @@ int vtkDistributedDataFilter::RequestDataInternal(vtkDataSet* input,
 
   if (redistributedInput == NULL)
     {
-    this->Kdtree->Delete();
-    this->Kdtree = NULL;
+    if (this->Kdtree)
+      {
+      this->Kdtree->Delete();
+      this->Kdtree = NULL;
+      }
 
     vtkErrorMacro(<< "vtkDistributedDataFilter::Execute redistribute failure");
     return 1;
@@ -644,7 +681,15 @@ int vtkDistributedDataFilter::RequestDataInternal(vtkDataSet* input,
 
   vtkUnstructuredGrid *expandedGrid = redistributedInput;
 
-  if (this->GhostLevel > 0)
+  if (this->GhostLevel > 0 && alongCurve)
+    {
+    // Points are matched by their coordinates if there are no global
+    // node IDs, so none are created.
+
+    this->SetProgressText("Exchange ghost cells");
+    expandedGrid = this->AcquireGhostCellsAlongCurve(redistributedInput);
+    }
+  else if (this->GhostLevel > 0)
     {
     // Create global nodes IDs if we don't have them
 
@@ -699,14 +744,17 @@ int vtkDistributedDataFilter::RequestDataInternal(vtkDataSet* input,
 
   expandedGrid->Delete();
 
-  if (!this->RetainKdtree)
-    {
-    this->Kdtree->Delete();
-    this->Kdtree = NULL;
-    }
-  else
+  if (!alongCurve)
     {
-    this->Kdtree->SetDataSet(NULL);
+    if (!this->RetainKdtree)
+      {
+      this->Kdtree->Delete();
+      this->Kdtree = NULL;
+      }
+    else
+      {
+      this->Kdtree->SetDataSet(NULL);
+      }
     }
 
   this->UpdateProgress(1);
@@ -736,7 +784,17 @@ vtkUnstructuredGrid *vtkDistributedDataFilter::RedistributeDataSet(
 
   // next call deletes inputPlus at the earliest opportunity
 
-  vtkUnstructuredGrid *finalGrid = this->MPIRedistribute(inputPlus, input);
+  vtkUnstructuredGrid *finalGrid = NULL;
+
+  if (this->PartitionMethod ==
+      vtkDistributedDataFilter::SPACE_FILLING_CURVE_PARTITION)
+    {
+    finalGrid = this->CurveRedistribute(inputPlus, input);
+    }
+  else
+    {
+    finalGrid = this->MPIRedistribute(inputPlus, input);
+    }
 
   return finalGrid;
 }
@@ -941,6 +999,16 @@ void vtkDistributedDataFilter::ComputeMyRegionBounds()
   delete [] this->ConvexSubRegionBounds;
   this->ConvexSubRegionBounds = NULL;
 
+  if (this->PartitionMethod ==
+      vtkDistributedDataFilter::SPACE_FILLING_CURVE_PARTITION)
+    {
+    // The aligned boxes covered by my part of the curve.
+
+    this->NumConvexSubRegions = this->CurvePartitioner->GetRegionBoxes(
+      this->MyId, &this->ConvexSubRegionBounds);
+    return;
+    }
+
   vtkIntArray *myRegions = vtkIntArray::New();
 
   this->Kdtree->GetRegionAssignmentList(this->MyId, myRegions);
@@ -2566,6 +2634,417 @@ vtkUnstructuredGrid *vtkDistributedDataFilter::MPIRedistribute(vtkDataSet *in,
   return myNewGrid;
 }
 
+//-------------------------------------------------------------------------
+int vtkDistributedDataFilter::PartitionAlongCurve(vtkDataSet *set)
+{
+  vtkSpaceFillingCurvePartitioner *partitioner = this->GetCurvePartitioner();
+
+  partitioner->SetController(this->Controller);
+
+  // The cells are sorted by their keys with a sample sort, so
+  // processes with no cells need no special care.
+
+  if (!partitioner->BuildPartition(set))
+    {
+    return 1;
+    }
+
+  return 0;
+}
+
+//-------------------------------------------------------------------------
+vtkUnstructuredGrid *vtkDistributedDataFilter::CurveRedistribute(
+  vtkDataSet *in, vtkDataSet *input)
+{
+  int proc;
+  int nprocs = this->NumProcesses;
+
+  // A cell belongs to the process whose part of the curve holds the
+  // key of its center.  When including all intersecting cells, it
+  // also goes to every process whose region meets its bounding box.
+
+  this->CurvePartitioner->CreateCellLists(in,
+                                          this->IncludeAllIntersectingCells);
+
+  vtkIdList **procCellLists = new vtkIdList * [nprocs];
+
+  for (proc = 0; proc < nprocs; proc++)
+    {
+    procCellLists[proc] = this->CurvePartitioner->GetCellList(proc);
+    }
+
+  int deleteDataSet = DeleteNo;
+
+  if (in != input)
+    {
+    deleteDataSet = DeleteYes;
+    }
+
+  vtkUnstructuredGrid *myNewGrid =
+    this->ExchangeMergeSubGridsAllToAll(procCellLists, in, deleteDataSet);
+
+  delete [] procCellLists;
+
+  this->CurvePartitioner->DeleteCellLists();
+
+  // The vtkGhostLevels arrays are added with the ghost cells.
+
+  return myNewGrid;
+}
+
+//-------------------------------------------------------------------------
+// Extract the listed cells of a data set into a new grid.  pointMap
+// holds -1 for each point of the data set, and is restored on return,
+// so that the cost is that of the cells extracted only.
+static vtkUnstructuredGrid *vtkDistributedDataFilterExtractCells(
+  vtkDataSet *in, vtkIdList *cells, std::vector<vtkIdType> &pointMap)
+{
+  vtkIdType ncells = cells ? cells->GetNumberOfIds() : 0;
+
+  vtkPointData *inPD = in->GetPointData();
+  vtkCellData *inCD = in->GetCellData();
+  vtkUnstructuredGrid *inGrid = vtkUnstructuredGrid::SafeDownCast(in);
+
+  vtkUnstructuredGrid *piece = vtkUnstructuredGrid::New();
+  vtkPointData *pd = piece->GetPointData();
+  vtkCellData *cd = piece->GetCellData();
+
+  pd->CopyGlobalIdsOn();
+  pd->CopyAllocate(inPD, ncells);
+  cd->CopyGlobalIdsOn();
+  cd->CopyAllocate(inCD, ncells);
+  piece->Allocate(ncells > 0 ? ncells : 1);
+
+  vtkPoints *pts = vtkPoints::New();
+  vtkPointSet *inPointSet = vtkPointSet::SafeDownCast(in);
+  if (inPointSet && inPointSet->GetPoints())
+    {
+    // preserve input datatype
+    pts->SetDataType(inPointSet->GetPoints()->GetDataType());
+    }
+
+  std::vector<vtkIdType> usedPoints;
+  std::vector<vtkIdType> faces;
+  vtkIdList *ptIds = vtkIdList::New();
+  vtkIdList *faceStream = vtkIdList::New();
+
+  for (vtkIdType i=0; i < ncells; i++)
+    {
+    vtkIdType cellId = cells->GetId(i);
+
+    in->GetCellPoints(cellId, ptIds);
+
+    vtkIdType npts = ptIds->GetNumberOfIds();
+    vtkIdType *ids = ptIds->GetPointer(0);
+
+    for (vtkIdType j=0; j < npts; j++)
+      {
+      vtkIdType id = ids[j];
+
+      if (pointMap[id] < 0)
+        {
+        vtkIdType newId = pts->InsertNextPoint(in->GetPoint(id));
+        pd->CopyData(inPD, id, newId);
+        pointMap[id] = newId;
+        usedPoints.push_back(id);
+        }
+
+      ids[j] = pointMap[id];
+      }
+
+    int type = in->GetCellType(cellId);
+    vtkIdType newCellId;
+
+    if ((type == VTK_POLYHEDRON) && inGrid)
+      {
+      // The face stream holds the number of faces, then the number of
+      // points and the points of each face.
+
+      inGrid->GetFaceStream(cellId, faceStream);
+      vtkIdType *stream = faceStream->GetPointer(0);
+      vtkIdType nfaces = stream[0];
+      faces.assign(stream + 1, stream + faceStream->GetNumberOfIds());
+
+      for (size_t face=0; face < faces.size(); face += faces[face] + 1)
+        {
+        for (vtkIdType k=1; k <= faces[face]; k++)
+          {
+          faces[face + k] = pointMap[faces[face + k]];
+          }
+        }
+
+      newCellId = piece->InsertNextCell(type, npts, ids, nfaces, &faces[0]);
+      }
+    else
+      {
+      newCellId = piece->InsertNextCell(type, ptIds);
+      }
+
+    cd->CopyData(inCD, cellId, newCellId);
+    }
+
+  for (size_t i=0; i < usedPoints.size(); i++)
+    {
+    pointMap[usedPoints[i]] = -1;
+    }
+
+  ptIds->Delete();
+  faceStream->Delete();
+
+  piece->SetPoints(pts);
+  pts->Delete();
+
+  piece->Squeeze();
+
+  return piece;
+}
+
+//-------------------------------------------------------------------------
+vtkUnstructuredGrid *vtkDistributedDataFilter::ExchangeMergeSubGridsAllToAll(
+  vtkIdList **cellIds, vtkDataSet *myGrid, int deleteMyGrid)
+{
+  int proc;
+  int nprocs = this->NumProcesses;
+  int me = this->MyId;
+
+  // Pack the cells for each process, one after the other, into a single
+  // buffer.  The grids are packed as their raw arrays.
+
+  std::vector<vtkIdType> pointMap(myGrid->GetNumberOfPoints(), -1);
+  std::vector<char> sendBuffer;
+  std::vector<vtkIdType> sendLengths(nprocs, 0);
+  std::vector<vtkIdType> sendOffsets(nprocs, 0);
+  vtkUnstructuredGrid *myPiece = NULL;
+  vtkCharArray *packed = vtkCharArray::New();
+  int aok = 1;
+
+  for (proc = 0; proc < nprocs; proc++)
+    {
+    sendOffsets[proc] = static_cast<vtkIdType>(sendBuffer.size());
+
+    vtkIdList *cells = cellIds[proc];
+
+    if ((proc != me) && ((cells == NULL) || (cells->GetNumberOfIds() == 0)))
+      {
+      continue;
+      }
+
+    vtkUnstructuredGrid *piece =
+      vtkDistributedDataFilterExtractCells(myGrid, cells, pointMap);
+
+    if (proc == me)
+      {
+      // Even with no cells, this keeps the layout of the field arrays.
+      myPiece = piece;
+      continue;
+      }
+
+    aok = vtkCommunicator::MarshalDataObject(piece, packed) && aok;
+    piece->Delete();
+
+    sendLengths[proc] = packed->GetNumberOfTuples();
+    sendBuffer.insert(sendBuffer.end(), packed->GetPointer(0),
+                      packed->GetPointer(0) + sendLengths[proc]);
+    }
+
+  packed->Delete();
+
+  if (deleteMyGrid)
+    {
+    myGrid->Delete();
+    }
+
+  if (!aok)
+    {
+    vtkErrorMacro(<< "vtkDistributedDataFilter::ExchangeMergeSubGridsAllToAll"
+                     " could not pack the sub grids");
+    }
+
+  // Every process tells every other how much it sends.  Then only the
+  // processes that send or receive something exchange their data, all
+  // at once.
+
+  std::vector<int> others;
+  std::vector<vtkIdType> ones;
+  std::vector<vtkIdType> positions;
+
+  for (proc = 0; proc < nprocs; proc++)
+    {
+    if (proc != me)
+      {
+      others.push_back(proc);
+      ones.push_back(1);
+      positions.push_back(proc);
+      }
+    }
+
+  std::vector<vtkIdType> recvLengths(nprocs, 0);
+
+  if (!this->Controller->NeighborExchange(
+        &sendLengths[0], &ones[0], &positions[0],
+        &recvLengths[0], &ones[0], &positions[0],
+        static_cast<int>(others.size()), &others[0]))
+    {
+    vtkErrorMacro(<< "vtkDistributedDataFilter::ExchangeMergeSubGridsAllToAll"
+                     " could not exchange the sizes of the sub grids");
+    if (myPiece)
+      {
+      myPiece->Delete();
+      }
+    return NULL;
+    }
+
+  std::vector<int> partners;
+  std::vector<vtkIdType> partnerSendLengths;
+  std::vector<vtkIdType> partnerSendOffsets;
+  std::vector<vtkIdType> partnerRecvLengths;
+  std::vector<vtkIdType> partnerRecvOffsets;
+  vtkIdType totalRecvLength = 0;
+
+  for (proc = 0; proc < nprocs; proc++)
+    {
+    if ((proc != me) && ((sendLengths[proc] > 0) || (recvLengths[proc] > 0)))
+      {
+      partners.push_back(proc);
+      partnerSendLengths.push_back(sendLengths[proc]);
+      partnerSendOffsets.push_back(sendOffsets[proc]);
+      partnerRecvLengths.push_back(recvLengths[proc]);
+      partnerRecvOffsets.push_back(totalRecvLength);
+      totalRecvLength += recvLengths[proc];
+      }
+    }
+
+  int npartners = static_cast<int>(partners.size());
+
+  // Keep the buffers valid even when nothing moves.
+  sendBuffer.push_back(0);
+  std::vector<char> recvBuffer(totalRecvLength + 1);
+
+  if ((npartners > 0) &&
+      !this->Controller->NeighborExchange(
+        &sendBuffer[0], &partnerSendLengths[0], &partnerSendOffsets[0],
+        &recvBuffer[0], &partnerRecvLengths[0], &partnerRecvOffsets[0],
+        npartners, &partners[0]))
+    {
+    vtkErrorMacro(<< "vtkDistributedDataFilter::ExchangeMergeSubGridsAllToAll"
+                     " could not exchange the sub grids");
+    if (myPiece)
+      {
+      myPiece->Delete();
+      }
+    return NULL;
+    }
+
+  std::vector<char>().swap(sendBuffer);
+
+  // Unpack the grids received and merge them with mine.
+
+  std::vector<vtkDataSet *> grids;
+  grids.push_back(myPiece);
+
+  for (int i=0; i < npartners; i++)
+    {
+    if (partnerRecvLengths[i] == 0)
+      {
+      continue;
+      }
+
+    vtkCharArray *buf = vtkCharArray::New();
+    buf->SetArray(&recvBuffer[partnerRecvOffsets[i]], partnerRecvLengths[i], 1);
+
+    vtkUnstructuredGrid *grid = vtkUnstructuredGrid::New();
+
+    if (vtkCommunicator::UnMarshalDataObject(buf, grid))
+      {
+      grids.push_back(grid);
+      }
+    else
+      {
+      vtkErrorMacro(<< "vtkDistributedDataFilter::ExchangeMergeSubGridsAllToAll"
+                       " could not unpack the grid of process " << partners[i]);
+      grid->Delete();
+      }
+
+    buf->Delete();
+    }
+
+  std::vector<char>().swap(recvBuffer);
+
+  vtkUnstructuredGrid *mergedGrid = NULL;
+
+  if (grids.size() > 1)
+    {
+    float tolerance = (float)this->CurvePartitioner->GetFudgeFactor();
+
+    mergedGrid =
+      vtkDistributedDataFilter::MergeGrids(&grids[0],
+                                           static_cast<int>(grids.size()),
+                                           DeleteYes, 1, tolerance, 0);
+    }
+  else
+    {
+    mergedGrid = myPiece;
+    }
+
+  return mergedGrid;
+}
+
+//-------------------------------------------------------------------------
+vtkUnstructuredGrid *
+  vtkDistributedDataFilter::AcquireGhostCellsAlongCurve(vtkUnstructuredGrid *grid)
+{
+  // The regions are not boxes, so the layers of ghost cells are found
+  // through the points on the boundary of each grid.
+
+  vtkPUnstructuredGridGhostCellsGenerator *generator =
+    vtkPUnstructuredGridGhostCellsGenerator::New();
+
+  generator->SetController(this->Controller);
+  generator->SetNumberOfGhostLayers(this->GhostLevel);
+  generator->SetInputData(grid);
+  generator->Update();
+
+  vtkUnstructuredGrid *expandedGrid = vtkUnstructuredGrid::New();
+  expandedGrid->ShallowCopy(generator->GetOutput());
+
+  generator->Delete();
+  grid->Delete();
+
+  // With duplicate cell assignment, a process can get a ghost cell it
+  // already has, or the same cell from several processes.  Keep only the
+  // first copy, which has the lowest ghost level since the layers are
+  // appended in order.
+
+  vtkIdType *gidCells = this->GetGlobalElementIds(expandedGrid);
+
+  if (this->IncludeAllIntersectingCells && gidCells)
+    {
+    vtkIdType ncells = expandedGrid->GetNumberOfCells();
+    std::set<vtkIdType> seen;
+    vtkIdList *keep = vtkIdList::New();
+
+    for (vtkIdType i=0; i < ncells; i++)
+      {
+      if (seen.insert(gidCells[i]).second)
+        {
+        keep->InsertNextId(i);
+        }
+      }
+
+    if (keep->GetNumberOfIds() < ncells)
+      {
+      vtkUnstructuredGrid *uniqueGrid =
+        this->ExtractCells(keep, DeleteNo, expandedGrid);
+      expandedGrid->Delete();
+      expandedGrid = uniqueGrid;
+      }
+
+    keep->Delete();
+    }
+
+  return expandedGrid;
+}
+
 //-------------------------------------------------------------------------
 char *vtkDistributedDataFilter::MarshallDataSet(vtkUnstructuredGrid *extractedGrid, int &len)
 {
@@ -2863,6 +3342,15 @@ void vtkDistributedDataFilter::ClipWithVtkClipDataSet(
 }
 #endif
 
+//-------------------------------------------------------------------------
+static int vtkDistributedDataFilterBoundsOverlap(const double *a,
+                                                 const double *b)
+{
+  return (a[0] <= b[1]) && (a[1] >= b[0]) &&
+         (a[2] <= b[3]) && (a[3] >= b[2]) &&
+         (a[4] <= b[5]) && (a[5] >= b[4]);
+}
+
 //-------------------------------------------------------------------------
 // In general, vtkBoxClipDataSet is much faster and makes fewer errors.
 void vtkDistributedDataFilter::ClipWithBoxClipDataSet(
@@ -2905,33 +3393,207 @@ void vtkDistributedDataFilter::ClipCellsToSpatialRegion(vtkUnstructuredGrid *gri
 {
   this->ComputeMyRegionBounds();
 
-  if (this->NumConvexSubRegions > 1)
+  float tolerance;
+  if (this->PartitionMethod ==
+      vtkDistributedDataFilter::SPACE_FILLING_CURVE_PARTITION)
+    {
+    tolerance = (float)this->CurvePartitioner->GetFudgeFactor();
+    }
+  else
+    {
+    tolerance = (float)this->Kdtree->GetFudgeFactor();
+    }
+
+  int nboxes = this->NumConvexSubRegions;
+
+  // My region may be made of several boxes that don't overlap.  Then
+  // the cells inside one box are kept whole, and only the cells that
+  // cross the boundary of a box are clipped.
+
+  vtkUnstructuredGrid *interior = NULL;
+  vtkUnstructuredGrid *exterior = NULL;
+  vtkUnstructuredGrid *remaining = grid;
+
+  if (nboxes > 1)
     {
-    // here we would need to divide the grid into a separate grid for
-    // each convex region, and then do the clipping
+    vtkIdList *interiorCells = vtkIdList::New();
+    vtkIdList *crossingCells = vtkIdList::New();
+    vtkIdList *exteriorCells = vtkIdList::New();
+
+    vtkIdType ncells = grid->GetNumberOfCells();
+    double cellBounds[6];
+
+    for (vtkIdType cellId=0; cellId < ncells; cellId++)
+      {
+      grid->GetCellBounds(cellId, cellBounds);
+
+      int inside = 0;
+      int crossing = 0;
 
-    vtkErrorMacro(<<
-       "vtkDistributedDataFilter::ClipCellsToSpatialRegion - "
-       "assigned regions do not form a single convex region");
+      for (int box=0; !inside && (box < nboxes); box++)
+        {
+        double *bounds = this->ConvexSubRegionBounds + 6*box;
+
+        inside = (cellBounds[0] >= bounds[0]) && (cellBounds[1] <= bounds[1]) &&
+                 (cellBounds[2] >= bounds[2]) && (cellBounds[3] <= bounds[3]) &&
+                 (cellBounds[4] >= bounds[4]) && (cellBounds[5] <= bounds[5]);
+
+        crossing = crossing ||
+          vtkDistributedDataFilterBoundsOverlap(bounds, cellBounds);
+        }
 
-    return ;
+      if (inside)
+        {
+        interiorCells->InsertNextId(cellId);
+        }
+      else if (crossing)
+        {
+        crossingCells->InsertNextId(cellId);
+        }
+      else
+        {
+        exteriorCells->InsertNextId(cellId);
+        }
+      }
+
+    interior = this->ExtractCells(interiorCells, DeleteYes, grid);
+    remaining = this->ExtractCells(crossingCells, DeleteYes, grid);
+
+    if (this->GhostLevel > 0)
+      {
+      exterior = this->ExtractCells(exteriorCells, DeleteYes, grid);
+      }
+    else
+      {
+      exteriorCells->Delete();
+      }
     }
 
-  double *bounds = this->ConvexSubRegionBounds;
+  // Clip the cells to each box in turn, going on with the part outside
+  // of the boxes clipped so far.  Boxes that miss the cells are skipped.
+  // Clipping tetrahedralizes every cell it is given, so with several boxes
+  // only the cells that meet the box are clipped, and the others are
+  // passed on as they are.
 
-  if (this->GhostLevel > 0)
+  double remainingBounds[6];
+  remaining->GetBounds(remainingBounds);
+
+  std::vector<vtkDataSet *> insidePieces;
+
+  if (interior)
+    {
+    insidePieces.push_back(interior);
+    }
+
+  for (int box=0; (box < nboxes) && (remaining->GetNumberOfCells() > 0); box++)
     {
-    // We need cells outside the clip box as well.
+    double *bounds = this->ConvexSubRegionBounds + 6*box;
+
+    if (!vtkDistributedDataFilterBoundsOverlap(bounds, remainingBounds))
+      {
+      continue;
+      }
+
+    vtkUnstructuredGrid *toClip = remaining;
+    vtkUnstructuredGrid *passed = NULL;
+
+    if (nboxes > 1)
+      {
+      vtkIdList *meeting = vtkIdList::New();
+      vtkIdList *missing = vtkIdList::New();
+      double cellBounds[6];
+
+      for (vtkIdType cellId=0; cellId < remaining->GetNumberOfCells(); cellId++)
+        {
+        remaining->GetCellBounds(cellId, cellBounds);
+
+        if (vtkDistributedDataFilterBoundsOverlap(bounds, cellBounds))
+          {
+          meeting->InsertNextId(cellId);
+          }
+        else
+          {
+          missing->InsertNextId(cellId);
+          }
+        }
+
+      if (meeting->GetNumberOfIds() == 0)
+        {
+        meeting->Delete();
+        missing->Delete();
+        continue;
+        }
+      else if (missing->GetNumberOfIds() == 0)
+        {
+        meeting->Delete();
+        missing->Delete();
+        }
+      else
+        {
+        toClip = this->ExtractCells(meeting, DeleteYes, remaining);
+        passed = this->ExtractCells(missing, DeleteYes, remaining);
+        }
+      }
 
-    vtkUnstructuredGrid *outside;
+    vtkUnstructuredGrid *outside = NULL;
     vtkUnstructuredGrid *inside;
 
+    int needOutside = (this->GhostLevel > 0) || (box < nboxes - 1);
+
 #if 1
-    this->ClipWithBoxClipDataSet(grid, bounds, &outside, &inside);
+    this->ClipWithBoxClipDataSet(toClip, bounds,
+                                 needOutside ? &outside : NULL, &inside);
 #else
-    this->ClipWithVtkClipDataSet(grid, bounds, &outside, &inside);
+    this->ClipWithVtkClipDataSet(toClip, bounds,
+                                 needOutside ? &outside : NULL, &inside);
 #endif
 
+    insidePieces.push_back(inside);
+
+    if (toClip != remaining)
+      {
+      toClip->Delete();
+      }
+    if (remaining != grid)
+      {
+      remaining->Delete();
+      }
+
+    if (passed && outside)
+      {
+      vtkDataSet *sets[2] = {outside, passed};
+      remaining = vtkDistributedDataFilter::MergeGrids(sets, 2, DeleteYes, 0,
+                                                       tolerance, 0);
+      }
+    else
+      {
+      if (passed)
+        {
+        passed->Delete();
+        }
+      remaining = outside;
+      }
+
+    if (remaining == NULL)
+      {
+      break;
+      }
+
+    remaining->GetBounds(remainingBounds);
+    }
+
+  if (this->GhostLevel > 0)
+    {
+    // We need cells outside the clip boxes as well.
+
+    vtkUnstructuredGrid *outside = remaining;
+
+    if (outside == grid)
+      {
+      outside = grid->NewInstance();
+      outside->ShallowCopy(grid);
+      }
+
     grid->Initialize();
 
     // Mark the outside cells with a 0, the inside cells with a 1.
@@ -2939,18 +3601,28 @@ void vtkDistributedDataFilter::ClipCellsToSpatialRegion(vtkUnstructuredGrid *gri
     int arrayNameLen = static_cast<int>(strlen(TEMP_INSIDE_BOX_FLAG));
     char *arrayName = new char [arrayNameLen + 1];
     strcpy(arrayName, TEMP_INSIDE_BOX_FLAG);
-    vtkDistributedDataFilter::AddConstantUnsignedCharCellArray(outside, arrayName, 0);
-    vtkDistributedDataFilter::AddConstantUnsignedCharCellArray(inside, arrayName, 1);
 
-    // Combine inside and outside into a single ugrid.
+    std::vector<vtkDataSet *> grids(insidePieces);
+    grids.push_back(outside);
 
-    vtkDataSet *grids[2];
-    grids[0] = inside;
-    grids[1] = outside;
+    if (exterior)
+      {
+      grids.push_back(exterior);
+      }
+
+    for (size_t i=0; i < grids.size(); i++)
+      {
+      vtkDistributedDataFilter::AddConstantUnsignedCharCellArray(
+        static_cast<vtkUnstructuredGrid *>(grids[i]), arrayName,
+        (i < insidePieces.size()) ? 1 : 0);
+      }
+
+    // Combine inside and outside into a single ugrid.
 
     vtkUnstructuredGrid *combined =
-      vtkDistributedDataFilter::MergeGrids(grids, 2,  DeleteYes, 0,
-                                           (float)this->Kdtree->GetFudgeFactor(), 0);
+      vtkDistributedDataFilter::MergeGrids(&grids[0],
+                                           static_cast<int>(grids.size()),
+                                           DeleteYes, 0, tolerance, 0);
 
     // Extract the piece inside the box (level 0) and the requested
     // number of levels of ghost cells.
@@ -2978,13 +3650,27 @@ void vtkDistributedDataFilter::ClipCellsToSpatialRegion(vtkUnstructuredGrid *gri
     }
   else
     {
+    if (remaining && (remaining != grid))
+      {
+      remaining->Delete();
+      }
+
     vtkUnstructuredGrid *inside;
 
-#if 1
-    this->ClipWithBoxClipDataSet(grid, bounds, NULL, &inside);
-#else
-    this->ClipWithVtkClipDataSet(grid, bounds, NULL, &inside);
-#endif
+    if (insidePieces.empty())
+      {
+      inside = this->ExtractZeroCellGrid(grid);
+      }
+    else if (insidePieces.size() == 1)
+      {
+      inside = static_cast<vtkUnstructuredGrid *>(insidePieces[0]);
+      }
+    else
+      {
+      inside = vtkDistributedDataFilter::MergeGrids(&insidePieces[0],
+                 static_cast<int>(insidePieces.size()), DeleteYes, 0,
+                 tolerance, 0);
+      }
 
     grid->ShallowCopy(inside);
     inside->Delete();
@@ -4572,12 +5258,26 @@ vtkPKdTree *vtkDistributedDataFilter::GetKdtree()
   return this->Kdtree;
 }
 
+//-------------------------------------------------------------------------
+vtkSpaceFillingCurvePartitioner *vtkDistributedDataFilter::GetCurvePartitioner()
+{
+  if (this->CurvePartitioner == NULL)
+    {
+    this->CurvePartitioner = vtkSpaceFillingCurvePartitioner::New();
+    this->CurvePartitioner->SetController(this->Controller);
+    }
+
+  return this->CurvePartitioner;
+}
+
 //-------------------------------------------------------------------------
 void vtkDistributedDataFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "Kdtree: " << this->Kdtree << endl;
+  os << indent << "CurvePartitioner: " << this->CurvePartitioner << endl;
+  os << indent << "PartitionMethod: " << this->PartitionMethod << endl;
   os << indent << "Controller: " << this->Controller << endl;
   os << indent << "NumProcesses: " << this->NumProcesses << endl;
   os << indent << "MyId: " << this->MyId << endl;
@@ -74,6 +74,16 @@
 //   If still not found, D3 will create a temporary array of
 //   global element IDs.
 //
+// Enhancement: Instead of the k-d tree, D3 can divide the cells along a
+// space filling curve (see vtkSpaceFillingCurvePartitioner).  The cells
+// are sorted by the Morton key of their center with a distributed sample
+// sort, and each process sends its part of the data set to every other
+// process at once, as raw arrays.  Building this partition takes a fixed
+// number of collective operations, which is much faster for large data
+// sets and many processes, but the region of a process is no longer a
+// box.  Ghost cells are then built by vtkPUnstructuredGridGhostCellsGenerator,
+// and boundary cells are split against each box of the region.
+//
 // .SECTION Caveats
 // The Execute() method must be called by all processes in the
 // parallel application, or it will hang.  If you are not certain
@@ -81,7 +91,7 @@
 // you may want to use this filter in an explicit execution mode.
 //
 // .SECTION See Also
-// vtkKdTree vtkPKdTree vtkBSPCuts
+// vtkKdTree vtkPKdTree vtkBSPCuts vtkSpaceFillingCurvePartitioner
 
 #ifndef __vtkDistributedDataFilter_h
 #define __vtkDistributedDataFilter_h
@@ -98,6 +108,7 @@ class vtkIdTypeArray;
 class vtkIntArray;
 class vtkMultiProcessController;
 class vtkPKdTree;
+class vtkSpaceFillingCurvePartitioner;
 class vtkUnstructuredGrid;
 
 class VTKFILTERSPARALLELMPI_EXPORT vtkDistributedDataFilter: public vtkDataObjectAlgorithm
@@ -190,6 +201,33 @@ public:
     { this->SetBoundaryMode(vtkDistributedDataFilter::SPLIT_BOUNDARY_CELLS); }
   int GetBoundaryMode();
 
+//BTX
+  enum PartitionMethods {
+    KD_TREE_PARTITION=0,
+    SPACE_FILLING_CURVE_PARTITION=1
+  };
+//ETX
+
+  // Description:
+  //   Select how the space is divided among the processes: with a
+  //   parallel k-d tree (the default), or along a space filling curve.
+  //   The boundary modes apply to both.  The k-d tree, its cuts and
+  //   its region assignments are not used by the space filling curve.
+  vtkSetClampMacro(PartitionMethod, int,
+                   KD_TREE_PARTITION, SPACE_FILLING_CURVE_PARTITION);
+  vtkGetMacro(PartitionMethod, int);
+  void SetPartitionMethodToKdTree()
+    { this->SetPartitionMethod(vtkDistributedDataFilter::KD_TREE_PARTITION); }
+  void SetPartitionMethodToSpaceFillingCurve()
+    { this->SetPartitionMethod(
+      vtkDistributedDataFilter::SPACE_FILLING_CURVE_PARTITION);
+    }
+
+  // Description:
+  //   Get the partitioner used when the partition method is the space
+  //   filling curve, to change its parameters.
+  vtkSpaceFillingCurvePartitioner *GetCurvePartitioner();
+
   // Description:
   //   Ensure previous filters don't send up ghost cells
   virtual int RequestUpdateExtent(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
@@ -359,6 +397,20 @@ private:
   // ?
   vtkIdList **GetCellIdsForProcess(int proc, int *nlists);
 
+  // Description:
+  // The counterparts of PartitionDataAndAssignToProcesses, MPIRedistribute
+  // and AcquireGhostCells along a space filling curve.
+  int PartitionAlongCurve(vtkDataSet *set);
+  vtkUnstructuredGrid *CurveRedistribute(vtkDataSet *in, vtkDataSet *input);
+  vtkUnstructuredGrid *AcquireGhostCellsAlongCurve(vtkUnstructuredGrid *grid);
+
+  // Description:
+  // Send to each process the cells of its list, packed as raw arrays in a
+  // single all-to-all exchange, and merge the grids received.  Returns NULL
+  // if the exchange fails.
+  vtkUnstructuredGrid *ExchangeMergeSubGridsAllToAll(vtkIdList **cellIds,
+                   vtkDataSet *myGrid, int deleteMyGrid);
+
   // Description:
   // Fills in the Source and Target arrays which contain a schedule to allow
   // each processor to talk to every other.
@@ -523,6 +575,8 @@ private:
                                          int useGlobalCellIds);
 
   vtkPKdTree *Kdtree;
+  vtkSpaceFillingCurvePartitioner *CurvePartitioner;
+  int PartitionMethod;
   vtkMultiProcessController *Controller;
 
   int NumProcesses;
@@ -0,0 +1,632 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpaceFillingCurvePartitioner.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSpaceFillingCurvePartitioner.h"
+
+#include "vtkCommunicator.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+vtkStandardNewMacro(vtkSpaceFillingCurvePartitioner);
+vtkCxxSetObjectMacro(vtkSpaceFillingCurvePartitioner, Controller,
+                     vtkMultiProcessController);
+
+namespace
+{
+typedef vtkTypeUInt64 KeyType;
+
+// Number of bits of each coordinate in a key.
+const int MORTON_BITS = 21;
+const unsigned int MAX_POSITION = (1u << MORTON_BITS) - 1;
+
+//----------------------------------------------------------------------------
+// Builds a 64 bit mask from its 32 bit halves, which avoids 64 bit literals.
+inline KeyType Mask(unsigned int high, unsigned int low)
+{
+  return (static_cast<KeyType>(high) << 32) | low;
+}
+
+//----------------------------------------------------------------------------
+// Inserts two zero bits before each of the 21 lowest bits of v.
+KeyType SpreadBits(KeyType v)
+{
+  v &= MAX_POSITION;
+  v = (v | (v << 32)) & Mask(0x001f0000, 0x0000ffff);
+  v = (v | (v << 16)) & Mask(0x001f0000, 0xff0000ff);
+  v = (v | (v << 8))  & Mask(0x100f00f0, 0x0f00f00f);
+  v = (v | (v << 4))  & Mask(0x10c30c30, 0xc30c30c3);
+  v = (v | (v << 2))  & Mask(0x12492492, 0x49249249);
+  return v;
+}
+
+//----------------------------------------------------------------------------
+KeyType MortonKey(const unsigned int q[3])
+{
+  return SpreadBits(q[0]) | (SpreadBits(q[1]) << 1) | (SpreadBits(q[2]) << 2);
+}
+}
+
+//----------------------------------------------------------------------------
+class vtkSpaceFillingCurvePartitioner::vtkInternals
+{
+public:
+  // Quantized positions per unit length, and length of a position.
+  double Scale[3];
+  double Step[3];
+
+  std::vector<KeyType> Keys;
+  std::vector<KeyType> Splitters;
+  std::vector<vtkIdList *> CellLists;
+
+  unsigned int Quantize(const double *bounds, double x, int axis) const
+    {
+    double t = (x - bounds[2*axis]) * this->Scale[axis];
+    if (t <= 0.0)
+      {
+      return 0;
+      }
+    if (t >= MAX_POSITION)
+      {
+      return MAX_POSITION;
+      }
+    return static_cast<unsigned int>(t);
+    }
+
+  int GetProcess(KeyType key) const
+    {
+    return static_cast<int>(
+      std::upper_bound(this->Splitters.begin(), this->Splitters.end(), key) -
+      this->Splitters.begin());
+    }
+
+  // Gets the first and last keys of a process, and returns false if it
+  // owns no key.
+  bool GetKeyRange(int process, KeyType &first, KeyType &last) const
+    {
+    int numProcs = static_cast<int>(this->Splitters.size()) + 1;
+    first = (process == 0) ? 0 : this->Splitters[process - 1];
+    KeyType end = (process < numProcs - 1) ? this->Splitters[process] :
+      (static_cast<KeyType>(1) << (3 * MORTON_BITS));
+    if (first >= end)
+      {
+      return false;
+      }
+    last = end - 1;
+    return true;
+    }
+
+  // Gets the keys of an octree node given by its level and its position
+  // at that level.
+  void GetNodeKeys(int level, const unsigned int node[3],
+                   KeyType &first, KeyType &last) const
+    {
+    int shift = MORTON_BITS - level;
+    unsigned int corner[3] =
+      { node[0] << shift, node[1] << shift, node[2] << shift };
+    first = MortonKey(corner);
+    last = first + ((static_cast<KeyType>(1) << (3 * shift)) - 1);
+    }
+
+  // Adds the processes whose region meets the quantized box [qmin, qmax]
+  // within the given octree node.
+  void CollectProcesses(int level, const unsigned int node[3],
+                        const unsigned int qmin[3], const unsigned int qmax[3],
+                        std::vector<int> &processes) const
+    {
+    int shift = MORTON_BITS - level;
+    bool inside = true;
+    for (int axis = 0; axis < 3; axis++)
+      {
+      unsigned int lo = node[axis] << shift;
+      unsigned int hi = lo + ((1u << shift) - 1);
+      if (hi < qmin[axis] || lo > qmax[axis])
+        {
+        return;
+        }
+      inside = inside && lo >= qmin[axis] && hi <= qmax[axis];
+      }
+
+    KeyType first, last;
+    this->GetNodeKeys(level, node, first, last);
+    int firstProc = this->GetProcess(first);
+    int lastProc = this->GetProcess(last);
+    if (firstProc == lastProc || inside)
+      {
+      KeyType begin, end;
+      for (int proc = firstProc; proc <= lastProc; proc++)
+        {
+        if (this->GetKeyRange(proc, begin, end))
+          {
+          processes.push_back(proc);
+          }
+        }
+      return;
+      }
+
+    for (int child = 0; child < 8; child++)
+      {
+      unsigned int childNode[3];
+      for (int axis = 0; axis < 3; axis++)
+        {
+        childNode[axis] = 2 * node[axis] + ((child >> axis) & 1);
+        }
+      this->CollectProcesses(level + 1, childNode, qmin, qmax, processes);
+      }
+    }
+
+  // Adds the largest octree nodes whose keys all lie in [first, last].
+  void CollectNodes(int level, const unsigned int node[3],
+                    KeyType first, KeyType last,
+                    std::vector<unsigned int> &nodes) const
+    {
+    KeyType nodeFirst, nodeLast;
+    this->GetNodeKeys(level, node, nodeFirst, nodeLast);
+    if (nodeLast < first || nodeFirst > last)
+      {
+      return;
+      }
+    if (nodeFirst >= first && nodeLast <= last)
+      {
+      nodes.push_back(static_cast<unsigned int>(level));
+      nodes.insert(nodes.end(), node, node + 3);
+      return;
+      }
+
+    for (int child = 0; child < 8; child++)
+      {
+      unsigned int childNode[3];
+      for (int axis = 0; axis < 3; axis++)
+        {
+        childNode[axis] = 2 * node[axis] + ((child >> axis) & 1);
+        }
+      this->CollectNodes(level + 1, childNode, first, last, nodes);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+vtkSpaceFillingCurvePartitioner::vtkSpaceFillingCurvePartitioner()
+{
+  this->Controller = NULL;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+
+  this->SamplesPerProcess = 16;
+  for (int i = 0; i < 6; i++)
+    {
+    this->GlobalBounds[i] = 0.0;
+    }
+  this->FudgeFactor = 0.0;
+
+  this->Internals = new vtkInternals;
+  for (int axis = 0; axis < 3; axis++)
+    {
+    this->Internals->Scale[axis] = 0.0;
+    this->Internals->Step[axis] = 0.0;
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkSpaceFillingCurvePartitioner::~vtkSpaceFillingCurvePartitioner()
+{
+  this->DeleteCellLists();
+  this->SetController(NULL);
+  delete this->Internals;
+  this->Internals = NULL;
+}
+
+//----------------------------------------------------------------------------
+int vtkSpaceFillingCurvePartitioner::BuildPartition(vtkDataSet *set)
+{
+  if (this->Controller == NULL)
+    {
+    vtkErrorMacro("A controller is required.");
+    return 0;
+    }
+
+  vtkInternals *internals = this->Internals;
+  int numProcs = this->Controller->GetNumberOfProcesses();
+  vtkIdType numCells = set ? set->GetNumberOfCells() : 0;
+
+  // The global bounds, negating the maxima to take them with one reduction.
+
+  double localBounds[6];
+  double bounds[6];
+  for (int i = 0; i < 6; i++)
+    {
+    localBounds[i] = VTK_DOUBLE_MAX;
+    }
+  if (numCells > 0)
+    {
+    set->GetBounds(bounds);
+    for (int axis = 0; axis < 3; axis++)
+      {
+      localBounds[axis] = bounds[2*axis];
+      localBounds[axis + 3] = -bounds[2*axis + 1];
+      }
+    }
+  double globalBounds[6];
+  if (!this->Controller->AllReduce(localBounds, globalBounds, 6,
+                                   vtkCommunicator::MIN_OP))
+    {
+    vtkErrorMacro("Could not reduce the bounds.");
+    return 0;
+    }
+
+  double maxWidth = 0.0;
+  for (int axis = 0; axis < 3; axis++)
+    {
+    double lo = globalBounds[axis];
+    double hi = -globalBounds[axis + 3];
+    if (lo > hi)
+      {
+      lo = hi = 0.0;      // no cells on any process
+      }
+    this->GlobalBounds[2*axis] = lo;
+    this->GlobalBounds[2*axis + 1] = hi;
+    double width = hi - lo;
+    maxWidth = std::max(maxWidth, width);
+    internals->Scale[axis] =
+      (width > 0.0) ? static_cast<double>(1 << MORTON_BITS) / width : 0.0;
+    internals->Step[axis] =
+      (width > 0.0) ? width / static_cast<double>(1 << MORTON_BITS) : 0.0;
+    }
+  this->FudgeFactor = maxWidth * 10e-6;
+
+  // The key of the center of each cell.
+
+  internals->Keys.resize(numCells);
+  vtkIdList *ptIds = vtkIdList::New();
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+    {
+    set->GetCellPoints(cellId, ptIds);
+    vtkIdType npts = ptIds->GetNumberOfIds();
+    double center[3] = { 0.0, 0.0, 0.0 };
+    double x[3];
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      set->GetPoint(ptIds->GetId(i), x);
+      center[0] += x[0];
+      center[1] += x[1];
+      center[2] += x[2];
+      }
+    unsigned int q[3];
+    for (int axis = 0; axis < 3; axis++)
+      {
+      q[axis] = internals->Quantize(
+        this->GlobalBounds, npts ? center[axis] / npts : center[axis], axis);
+      }
+    internals->Keys[cellId] = MortonKey(q);
+    }
+  ptIds->Delete();
+
+  // Each process contributes regularly spaced samples of its sorted keys,
+  // as many as its share of all the cells calls for.
+
+  vtkIdType totalCells = 0;
+  if (!this->Controller->AllReduce(&numCells, &totalCells, 1,
+                                   vtkCommunicator::SUM_OP))
+    {
+    vtkErrorMacro("Could not count the cells.");
+    return 0;
+    }
+
+  vtkIdType numSamples = 0;
+  if (totalCells > 0)
+    {
+    double share = static_cast<double>(this->SamplesPerProcess) * numProcs *
+      numCells / static_cast<double>(totalCells);
+    numSamples =
+      std::min(numCells, static_cast<vtkIdType>(std::ceil(share)));
+    }
+
+  std::vector<KeyType> samples(numSamples > 0 ? numSamples : 1);
+  if (numSamples > 0)
+    {
+    std::vector<KeyType> sorted(internals->Keys);
+    std::sort(sorted.begin(), sorted.end());
+    for (vtkIdType i = 0; i < numSamples; i++)
+      {
+      samples[i] = sorted[((2*i + 1) * numCells) / (2*numSamples)];
+      }
+    }
+
+  // The keys travel as bytes since communicators have no 64 bit unsigned
+  // type.
+
+  vtkIdType sendLength = numSamples * static_cast<vtkIdType>(sizeof(KeyType));
+  std::vector<vtkIdType> recvLengths(numProcs);
+  std::vector<vtkIdType> offsets(numProcs);
+  if (!this->Controller->AllGather(&sendLength, &recvLengths[0], 1))
+    {
+    vtkErrorMacro("Could not gather the numbers of samples.");
+    return 0;
+    }
+  vtkIdType totalLength = 0;
+  for (int proc = 0; proc < numProcs; proc++)
+    {
+    offsets[proc] = totalLength;
+    totalLength += recvLengths[proc];
+    }
+  vtkIdType totalSamples =
+    totalLength / static_cast<vtkIdType>(sizeof(KeyType));
+  std::vector<KeyType> allSamples(totalSamples > 0 ? totalSamples : 1);
+  if (!this->Controller->AllGatherV(
+        reinterpret_cast<const char *>(&samples[0]),
+        reinterpret_cast<char *>(&allSamples[0]), sendLength,
+        &recvLengths[0], &offsets[0]))
+    {
+    vtkErrorMacro("Could not gather the samples.");
+    return 0;
+    }
+  allSamples.resize(totalSamples);
+  std::sort(allSamples.begin(), allSamples.end());
+
+  // Every process picks the same splitters from the sorted samples.  A
+  // splitter is rounded to the nearest corner of the coarsest octree level
+  // with at least as many nodes as there are cells, so that the regions are
+  // made of boxes about the size of the cells rather than of the
+  // quantization step.  On graded or clustered meshes many cells share a
+  // node of that level, so the rounding is only kept when it moves the
+  // splitter past no sample but its own and keeps it strictly between its
+  // neighbours; otherwise the exact splitter is used.
+
+  int level = 0;
+  while (level < MORTON_BITS &&
+         (static_cast<KeyType>(1) << (3 * level)) <
+         static_cast<KeyType>(totalCells))
+    {
+    level++;
+    }
+  int shift = 3 * (MORTON_BITS - level);
+  KeyType half = (shift > 0) ? (static_cast<KeyType>(1) << (shift - 1)) : 0;
+
+  internals->Splitters.assign(numProcs - 1, 0);
+  if (totalSamples > 0)
+    {
+    std::vector<vtkIdType> indices(numProcs - 1);
+    for (int proc = 1; proc < numProcs; proc++)
+      {
+      indices[proc - 1] = (proc * totalSamples) / numProcs;
+      internals->Splitters[proc - 1] = allSamples[indices[proc - 1]];
+      }
+    for (int i = 0; i < numProcs - 1; i++)
+      {
+      KeyType splitter = internals->Splitters[i];
+      KeyType rounded = ((splitter + half) >> shift) << shift;
+      vtkIdType idx = indices[i];
+      if (rounded != splitter &&
+          (i == 0 || rounded > internals->Splitters[i - 1]) &&
+          (i == numProcs - 2 || rounded < internals->Splitters[i + 1]) &&
+          (idx == 0 || rounded > allSamples[idx - 1]) &&
+          (idx == totalSamples - 1 || rounded <= allSamples[idx + 1]))
+        {
+        internals->Splitters[i] = rounded;
+        }
+      }
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkSpaceFillingCurvePartitioner::CreateCellLists(vtkDataSet *set,
+                                                      int includeBoundaryCells)
+{
+  this->DeleteCellLists();
+
+  vtkInternals *internals = this->Internals;
+  int numProcs = static_cast<int>(internals->Splitters.size()) + 1;
+  internals->CellLists.resize(numProcs);
+  for (int proc = 0; proc < numProcs; proc++)
+    {
+    internals->CellLists[proc] = vtkIdList::New();
+    }
+
+  vtkIdType numCells = set ? set->GetNumberOfCells() : 0;
+  if (numCells != static_cast<vtkIdType>(internals->Keys.size()))
+    {
+    vtkErrorMacro("The partition was built for another data set.");
+    return;
+    }
+
+  vtkIdList *ptIds = vtkIdList::New();
+  std::vector<int> processes;
+  const unsigned int root[3] = { 0, 0, 0 };
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+    {
+    int owner = internals->GetProcess(internals->Keys[cellId]);
+    internals->CellLists[owner]->InsertNextId(cellId);
+
+    if (!includeBoundaryCells)
+      {
+      continue;
+      }
+
+    // All the keys of the bounding box of the cell lie between the keys of
+    // its corners.  Most cells have both corners in the same region.
+
+    set->GetCellPoints(cellId, ptIds);
+    vtkIdType npts = ptIds->GetNumberOfIds();
+    if (npts == 0)
+      {
+      continue;
+      }
+    double cellBounds[6];
+    double x[3];
+    set->GetPoint(ptIds->GetId(0), x);
+    for (int axis = 0; axis < 3; axis++)
+      {
+      cellBounds[2*axis] = cellBounds[2*axis + 1] = x[axis];
+      }
+    for (vtkIdType i = 1; i < npts; i++)
+      {
+      set->GetPoint(ptIds->GetId(i), x);
+      for (int axis = 0; axis < 3; axis++)
+        {
+        cellBounds[2*axis] = std::min(cellBounds[2*axis], x[axis]);
+        cellBounds[2*axis + 1] = std::max(cellBounds[2*axis + 1], x[axis]);
+        }
+      }
+    unsigned int qmin[3];
+    unsigned int qmax[3];
+    for (int axis = 0; axis < 3; axis++)
+      {
+      qmin[axis] =
+        internals->Quantize(this->GlobalBounds, cellBounds[2*axis], axis);
+      qmax[axis] =
+        internals->Quantize(this->GlobalBounds, cellBounds[2*axis + 1], axis);
+      }
+    if (internals->GetProcess(MortonKey(qmin)) == owner &&
+        internals->GetProcess(MortonKey(qmax)) == owner)
+      {
+      continue;
+      }
+
+    processes.clear();
+    internals->CollectProcesses(0, root, qmin, qmax, processes);
+    std::sort(processes.begin(), processes.end());
+    processes.erase(std::unique(processes.begin(), processes.end()),
+                    processes.end());
+    for (size_t i = 0; i < processes.size(); i++)
+      {
+      if (processes[i] != owner)
+        {
+        internals->CellLists[processes[i]]->InsertNextId(cellId);
+        }
+      }
+    }
+  ptIds->Delete();
+}
+
+//----------------------------------------------------------------------------
+vtkIdList *vtkSpaceFillingCurvePartitioner::GetCellList(int process)
+{
+  if (process < 0 ||
+      process >= static_cast<int>(this->Internals->CellLists.size()))
+    {
+    return NULL;
+    }
+  return this->Internals->CellLists[process];
+}
+
+//----------------------------------------------------------------------------
+void vtkSpaceFillingCurvePartitioner::DeleteCellLists()
+{
+  std::vector<vtkIdList *> &lists = this->Internals->CellLists;
+  for (size_t i = 0; i < lists.size(); i++)
+    {
+    lists[i]->Delete();
+    }
+  lists.clear();
+}
+
+//----------------------------------------------------------------------------
+int vtkSpaceFillingCurvePartitioner::GetProcessContainingPoint(double x,
+                                                               double y,
+                                                               double z)
+{
+  vtkInternals *internals = this->Internals;
+  unsigned int q[3] =
+    {
+    internals->Quantize(this->GlobalBounds, x, 0),
+    internals->Quantize(this->GlobalBounds, y, 1),
+    internals->Quantize(this->GlobalBounds, z, 2)
+    };
+  return internals->GetProcess(MortonKey(q));
+}
+
+//----------------------------------------------------------------------------
+int vtkSpaceFillingCurvePartitioner::GetRegionBoxes(int process,
+                                                    double **boxes)
+{
+  *boxes = NULL;
+
+  vtkInternals *internals = this->Internals;
+  KeyType first, last;
+  if (process < 0 ||
+      process > static_cast<int>(internals->Splitters.size()) ||
+      !internals->GetKeyRange(process, first, last))
+    {
+    return 0;
+    }
+
+  // Each node is stored as its level and its position at that level.
+
+  std::vector<unsigned int> nodes;
+  const unsigned int root[3] = { 0, 0, 0 };
+  internals->CollectNodes(0, root, first, last, nodes);
+
+  std::vector<double> bounds;
+  for (size_t i = 0; i < nodes.size(); i += 4)
+    {
+    int shift = MORTON_BITS - static_cast<int>(nodes[i]);
+    double box[6];
+    bool empty = false;
+    for (int axis = 0; axis < 3; axis++)
+      {
+      unsigned int lo = nodes[i + 1 + axis] << shift;
+      KeyType hi = static_cast<KeyType>(nodes[i + 1 + axis] + 1) << shift;
+      if (internals->Step[axis] == 0.0 && lo > 0)
+        {
+        // All the points have the lowest position along a flat axis.
+        empty = true;
+        break;
+        }
+      double origin = this->GlobalBounds[2*axis];
+      box[2*axis] = origin + lo * internals->Step[axis];
+      box[2*axis + 1] = origin + hi * internals->Step[axis];
+      if (lo == 0)
+        {
+        box[2*axis] -= this->FudgeFactor;
+        }
+      if (hi == (static_cast<KeyType>(1) << MORTON_BITS) ||
+          internals->Step[axis] == 0.0)
+        {
+        box[2*axis + 1] = this->GlobalBounds[2*axis + 1] + this->FudgeFactor;
+        }
+      }
+    if (!empty)
+      {
+      bounds.insert(bounds.end(), box, box + 6);
+      }
+    }
+
+  int numBoxes = static_cast<int>(bounds.size() / 6);
+  if (numBoxes > 0)
+    {
+    *boxes = new double [bounds.size()];
+    std::copy(bounds.begin(), bounds.end(), *boxes);
+    }
+  return numBoxes;
+}
+
+//----------------------------------------------------------------------------
+void vtkSpaceFillingCurvePartitioner::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "SamplesPerProcess: " << this->SamplesPerProcess << endl;
+  os << indent << "GlobalBounds: " << this->GlobalBounds[0] << " "
+     << this->GlobalBounds[1] << " " << this->GlobalBounds[2] << " "
+     << this->GlobalBounds[3] << " " << this->GlobalBounds[4] << " "
+     << this->GlobalBounds[5] << endl;
+  os << indent << "FudgeFactor: " << this->FudgeFactor << endl;
+}
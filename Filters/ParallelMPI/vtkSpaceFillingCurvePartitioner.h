@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpaceFillingCurvePartitioner.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSpaceFillingCurvePartitioner - Divide distributed cells among
+// processes along a Morton curve
+//
+// .SECTION Description
+// This class assigns each cell of a data set distributed across processes
+// to one process, by sorting the cells along a space filling curve.  The
+// global bounds are quantized to 2^21 positions along each axis, and each
+// cell gets the Morton (Z-order) key of its center, the mean of its points.
+// A distributed sample sort then chooses the splitters: each process sorts
+// its keys and contributes regularly spaced samples, in proportion to its
+// number of cells, and every process picks the same splitters from the
+// gathered samples.  Process i owns the keys from splitter i-1 up to, but
+// not including, splitter i.  Building the partition takes a fixed number
+// of collective operations, whatever the number of processes.
+//
+// The Morton key grows with each coordinate, so all the keys of a box lie
+// between the keys of its lowest and highest corners.  This lets the
+// partitioner list the processes whose part of the curve meets the
+// bounding box of a cell, and describe the region of a process as the
+// aligned octree boxes its part of the curve covers.
+//
+// .SECTION Caveats
+// The region of a process is generally not convex.  The load balance is
+// statistical: more samples per process give more even parts.  When it
+// does not change the balance beyond one sample, a splitter is rounded to
+// the nearest corner of the octree level that has about as many nodes as
+// there are cells, which gives regions made of fewer, larger boxes.
+//
+// .SECTION See Also
+// vtkDistributedDataFilter vtkPKdTree
+
+#ifndef __vtkSpaceFillingCurvePartitioner_h
+#define __vtkSpaceFillingCurvePartitioner_h
+
+#include "vtkFiltersParallelMPIModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkDataSet;
+class vtkIdList;
+class vtkMultiProcessController;
+
+class VTKFILTERSPARALLELMPI_EXPORT vtkSpaceFillingCurvePartitioner :
+  public vtkObject
+{
+public:
+  static vtkSpaceFillingCurvePartitioner *New();
+  vtkTypeMacro(vtkSpaceFillingCurvePartitioner, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set/Get the communicator object.  By default, the global controller.
+  virtual void SetController(vtkMultiProcessController *c);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+
+  // Description:
+  // Set/Get the number of samples that a process holding the average
+  // number of cells contributes for each process.  Larger values give
+  // more even parts at the cost of a larger gather.  Default is 16.
+  vtkSetClampMacro(SamplesPerProcess, int, 1, VTK_INT_MAX);
+  vtkGetMacro(SamplesPerProcess, int);
+
+  // Description:
+  // Compute the global bounds, the keys of the cells of the data set of
+  // this process and the splitters.  It must be called by all processes.
+  // Returns 0 on failure.
+  int BuildPartition(vtkDataSet *set);
+
+  // Description:
+  // Create the list of the cells of the data set that go to each process:
+  // the cells whose center lies in its region and, if includeBoundaryCells
+  // is on, the cells whose bounding box meets its region.  The data set
+  // must be the one the partition was built with.  The lists belong to
+  // the partitioner until DeleteCellLists is called.
+  void CreateCellLists(vtkDataSet *set, int includeBoundaryCells);
+  vtkIdList *GetCellList(int process);
+  void DeleteCellLists();
+
+  // Description:
+  // Return the process whose region holds the point.
+  int GetProcessContainingPoint(double x, double y, double z);
+
+  // Description:
+  // Allocate with new[] and fill the bounds (xmin, xmax, ymin, ymax, zmin,
+  // zmax) of the boxes that make up the region of a process.  The boxes
+  // touching the global bounds are grown by the fudge factor.  Returns
+  // the number of boxes.
+  int GetRegionBoxes(int process, double **boxes);
+
+  // Description:
+  // The bounds of the data sets of all processes.
+  vtkGetVector6Macro(GlobalBounds, double);
+
+  // Description:
+  // A tolerance for merging points, relative to the global bounds.
+  vtkGetMacro(FudgeFactor, double);
+
+protected:
+  vtkSpaceFillingCurvePartitioner();
+  ~vtkSpaceFillingCurvePartitioner();
+
+  vtkMultiProcessController *Controller;
+  int SamplesPerProcess;
+  double GlobalBounds[6];
+  double FudgeFactor;
+
+private:
+  vtkSpaceFillingCurvePartitioner(const vtkSpaceFillingCurvePartitioner&); // Not implemented
+  void operator=(const vtkSpaceFillingCurvePartitioner&); // Not implemented
+
+//BTX
+  class vtkInternals;
+  vtkInternals *Internals;
+//ETX
+};
+
+#endif
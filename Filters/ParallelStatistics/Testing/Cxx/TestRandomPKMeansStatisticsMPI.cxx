@@ -236,6 +236,62 @@ void RandomSampleStatistics( vtkMultiProcessController* controller, void* arg )
         outputMeta->Dump();
       }
     }
+  // Learn again with k-means++ seeds drawn from all processes and mini-batches
+  com->Barrier();
+  timer->StartTimer();
+
+  pks->SetInputData( vtkStatisticsAlgorithm::LEARN_PARAMETERS, 0 );
+  pks->SetDefaultNumberOfClusters( nClusters );
+  pks->SetInitializationMethodToKMeansPlusPlus();
+  pks->SetMiniBatchSize( obsPerCluster / 4 );
+  pks->SetMaxNumIterations( 50 );
+  pks->SetAssessOption( false );
+  pks->Update();
+
+  com->Barrier();
+  timer->StopTimer();
+
+  if ( myRank == args->ioRank )
+    {
+    vtkMultiBlockDataSet* outputMetaDS = vtkMultiBlockDataSet::SafeDownCast( pks->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) );
+    vtkTable* outputMeta = vtkTable::SafeDownCast( outputMetaDS->GetBlock( 0 ) );
+
+    cout << "\n## Completed parallel calculation of kmeans statistics (k-means++ and mini-batches):\n"
+         << "   Wall time: "
+         << timer->GetElapsedTime()
+         << " sec.\n";
+    outputMeta->Dump();
+
+    // All clusters should be found, each with an error of about nVariables * stdev^2 per observation
+    vtkIdType testIntValue = 0;
+    double totalError = 0.;
+    for( vtkIdType r = 0; r < outputMeta->GetNumberOfRows(); r++ )
+      {
+      testIntValue += outputMeta->GetValueByName( r, "Cardinality" ).ToInt();
+      totalError += outputMeta->GetValueByName( r, "Error" ).ToDouble();
+      }
+    if ( testIntValue != nVals * args->nProcs )
+      {
+      vtkGenericWarningMacro("Sum of cluster cardinalities is incorrect: "
+                             << testIntValue
+                             << " != "
+                             << nVals * args->nProcs
+                             << ".");
+      *(args->retVal) = 1;
+      }
+    double meanError = totalError / ( nVals * args->nProcs );
+    if ( outputMeta->GetNumberOfRows() != nClusters
+         || meanError > 2. * nVariables * args->stdev * args->stdev )
+      {
+      vtkGenericWarningMacro("Clusters were not found: mean error "
+                             << meanError
+                             << " with "
+                             << outputMeta->GetNumberOfRows()
+                             << " clusters.");
+      *(args->retVal) = 1;
+      }
+    }
+
   // Clean up
   pks->Delete();
   inputData->Delete();
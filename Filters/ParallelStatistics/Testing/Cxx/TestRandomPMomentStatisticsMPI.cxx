@@ -37,6 +37,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkPPCAStatistics.h"
 
 #include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkMath.h"
@@ -846,6 +847,51 @@ void RandomSampleStatistics( vtkMultiProcessController* controller, void* arg )
         }
       }
 
+    // Learn the same model with the tall skinny QR decomposition, whose
+    // triangular factors are reduced across processes along with the moments
+    vtkMultiBlockDataSet* covMetaDS = vtkMultiBlockDataSet::New();
+    covMetaDS->DeepCopy( outputMetaDS );
+    pcas->SetDecompositionScheme( vtkPCAStatistics::TALL_SKINNY_QR );
+    pcas->SetAssessOption( false );
+    pcas->Update();
+    outputMetaDS = vtkMultiBlockDataSet::SafeDownCast( pcas->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) );
+
+    if ( myRank == args->ioRank )
+      {
+      cout << "\n## Verifying that the tall skinny QR decomposition yields the same eigenvalues (relative tolerance: "
+           << args->absTol
+           << "):\n";
+      if ( ! vtkTable::SafeDownCast( outputMetaDS->GetBlock( 0 ) )->GetFieldData()->GetArray( "PCA R Factor" ) )
+        {
+        vtkGenericWarningMacro("The triangular factors were not reduced.");
+        *(args->retVal) = 1;
+        }
+      for ( unsigned int b = 1; b < outputMetaDS->GetNumberOfBlocks(); ++ b )
+        {
+        vtkTable* qrMeta = vtkTable::SafeDownCast( outputMetaDS->GetBlock( b ) );
+        vtkTable* covMeta = vtkTable::SafeDownCast( covMetaDS->GetBlock( b ) );
+        for ( vtkIdType r = 0; r < covMeta->GetNumberOfRows(); ++ r )
+          {
+          double qrVal = qrMeta->GetValueByName( r, "Mean" ).ToDouble();
+          double covVal = covMeta->GetValueByName( r, "Mean" ).ToDouble();
+          if ( fabs( qrVal - covVal ) > args->absTol * ( 1. + fabs( covVal ) ) )
+            {
+            vtkGenericWarningMacro("Incorrect "
+                                   << covMeta->GetValueByName( r, "Column" ).ToString()
+                                   << " in request "
+                                   << b - 1
+                                   << ": "
+                                   << qrVal
+                                   << " <> "
+                                   << covVal
+                                   << ".");
+            *(args->retVal) = 1;
+            }
+          }
+        }
+      }
+    covMetaDS->Delete();
+
     // Clean up
     pcas->Delete();
     } // if ( ! args->skipPPCA )
@@ -28,6 +28,8 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkOrderStatistics.h"
 #include "vtkPOrderStatistics.h"
 
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
 #include "vtkIdTypeArray.h"
 #include "vtkIntArray.h"
 #include "vtkMath.h"
@@ -41,6 +43,9 @@ PURPOSE.  See the above copyright notice for more information.
 
 #include "vtksys/CommandLineArguments.hxx"
 
+#include <algorithm>
+#include <vector>
+
 namespace
 {
 
@@ -52,6 +57,7 @@ struct RandomOrderStatisticsArgs
   bool skipString;
   bool quantize;
   int maxHistoSize;
+  double sketchError;
   int* retVal;
   int ioRank;
 };
@@ -418,12 +424,139 @@ void RandomOrderStatistics( vtkMultiProcessController* controller, void* arg )
       } // i
     } // if ( myRank == args->ioRank )
 
+  // ********************** Sketched Order Statistics **********************
+
+  // Draw continuous values, hence with as many distinct values as there are values
+  vtkDoubleArray* doubleArray = vtkDoubleArray::New();
+  doubleArray->SetName( "Normal Double" );
+  doubleArray->SetNumberOfTuples( args->nVals );
+  for ( int r = 0; r < args->nVals; ++ r )
+    {
+    doubleArray->SetValue( r, vtkMath::Gaussian() * args->stdev );
+    }
+  vtkTable* sketchData = vtkTable::New();
+  sketchData->AddColumn( doubleArray );
+
+  // Synchronize and start clock
+  com->Barrier();
+  timer->StartTimer();
+
+  // Learn and derive quantiles with sketches reduced across processes
+  vtkPOrderStatistics* spos = vtkPOrderStatistics::New();
+  spos->SetInputData( vtkStatisticsAlgorithm::INPUT_DATA, sketchData );
+  spos->AddColumn( "Normal Double" );
+  spos->SetSketch( true );
+  spos->SetSketchError( args->sketchError );
+  spos->SetNumberOfIntervals( 10 );
+  spos->SetLearnOption( true );
+  spos->SetDeriveOption( true );
+  spos->SetAssessOption( false );
+  spos->SetTestOption( false );
+  spos->Update();
+
+  // Synchronize and stop clock
+  com->Barrier();
+  timer->StopTimer();
+
+  vtkMultiBlockDataSet* sketchModelDS = vtkMultiBlockDataSet::SafeDownCast( spos->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) );
+  vtkTable* sketchHistogram = vtkTable::SafeDownCast( sketchModelDS->GetBlock( 0 ) );
+  vtkTable* sketchQuantiles = vtkTable::SafeDownCast( sketchModelDS->GetBlock( 2 ) );
+  vtkIdTypeArray* boundArr = vtkIdTypeArray::SafeDownCast( sketchHistogram->GetFieldData()->GetArray( "Rank Error Bound" ) );
+  vtkIdType rankErrorBound = boundArr ? boundArr->GetValue( 0 ) : -1;
+  vtkIdType sketchCard = static_cast<vtkIdType>( args->nVals ) * numProcs;
+
+  // Gather all values on the I/O node in order to calculate exact ranks
+  std::vector<double> sorted( myRank == args->ioRank ? sketchCard : 0 );
+  com->Gather( doubleArray->GetPointer( 0 ),
+               myRank == args->ioRank ? &sorted[0] : 0,
+               args->nVals,
+               args->ioRank );
+
+  // Verify that all processes have the same histogram
+  int histoSize_l = static_cast<int>( sketchHistogram->GetNumberOfRows() );
+  int histoSize_min;
+  int histoSize_max;
+  com->AllReduce( &histoSize_l, &histoSize_min, 1, vtkCommunicator::MIN_OP );
+  com->AllReduce( &histoSize_l, &histoSize_max, 1, vtkCommunicator::MAX_OP );
+
+  if ( myRank == args->ioRank )
+    {
+    cout << "\n## Completed parallel calculation of sketched order statistics:\n"
+         << "   Wall time: "
+         << timer->GetElapsedTime()
+         << " sec.\n"
+         << "   Histogram size: "
+         << histoSize_l
+         << " for "
+         << sketchCard
+         << " values\n"
+         << "   Rank error bound: "
+         << rankErrorBound
+         << "\n";
+
+    if ( histoSize_min != histoSize_max )
+      {
+      vtkGenericWarningMacro("Processes have histograms of sizes "
+                             << histoSize_min
+                             << " to "
+                             << histoSize_max
+                             << ".");
+      *(args->retVal) = 1;
+      }
+
+    if ( rankErrorBound < 0
+         || rankErrorBound > static_cast<vtkIdType>( args->sketchError * sketchCard ) )
+      {
+      vtkGenericWarningMacro("Incorrect rank error bound: "
+                             << rankErrorBound
+                             << ".");
+      *(args->retVal) = 1;
+      }
+
+    // Verify that the rank of each quantile is within the error bound
+    cout << "\n## Verifying that calculated deciles are within the rank error bound:\n";
+    std::sort( sorted.begin(), sorted.end() );
+    vtkIdType nq = sketchQuantiles->GetNumberOfRows() - 1;
+    for ( vtkIdType k = 0; k <= nq; ++ k )
+      {
+      double q = sketchQuantiles->GetValueByName( k, "Normal Double" ).ToDouble();
+      vtkIdType target = ( k * sketchCard ) / nq;
+      vtkIdType below = std::lower_bound( sorted.begin(), sorted.end(), q ) - sorted.begin();
+      vtkIdType upTo = std::upper_bound( sorted.begin(), sorted.end(), q ) - sorted.begin();
+
+      cout << "   "
+           << sketchQuantiles->GetValueByName( k, "Quantile" ).ToString()
+           << ": "
+           << q
+           << " of rank "
+           << below
+           << " for a target rank of "
+           << target
+           << "\n";
+
+      // The value may also be an average of two consecutive values
+      if ( below > target + rankErrorBound + 1 || upTo < target - rankErrorBound - 1 )
+        {
+        vtkGenericWarningMacro("Incorrect rank of "
+                               << sketchQuantiles->GetValueByName( k, "Quantile" ).ToString()
+                               << ": "
+                               << below
+                               << " <> "
+                               << target);
+        *(args->retVal) = 1;
+        }
+      } // k
+    } // if ( myRank == args->ioRank )
+
   // Clean up
   delete [] card_g;
   delete [] min_g;
   delete [] max_g;
   pos->Delete();
+  spos->Delete();
   inputData->Delete();
+  sketchData->Delete();
+  doubleArray->Delete();
   timer->Delete();
 }
 
@@ -494,6 +627,7 @@ int TestRandomPOrderStatisticsMPI( int argc, char* argv[] )
   double stdev = 50.;
   bool quantize = false;
   int maxHistoSize = 500;
+  double sketchError = .001;
 
   // Initialize command line argument parser
   vtksys::CommandLineArguments clArgs;
@@ -531,6 +665,11 @@ int TestRandomPOrderStatisticsMPI( int argc, char* argv[] )
                      &quantize, "Allow re-quantizing");
 
 
+  // Parse largest relative rank error of sketched quantiles
+  clArgs.AddArgument("--sketch-error",
+                     vtksys::CommandLineArguments::SPACE_ARGUMENT,
+                     &sketchError, "Largest relative rank error of sketched quantiles");
+
   // If incorrect arguments were provided, provide some help and terminate in error.
   if ( ! clArgs.Parse() )
     {
@@ -565,6 +704,7 @@ int TestRandomPOrderStatisticsMPI( int argc, char* argv[] )
   args.skipString = skipString;
   args.quantize = quantize;
   args.maxHistoSize = maxHistoSize;
+  args.sketchError = sketchError;
   args.retVal = &testValue;
   args.ioRank = ioRank;
 
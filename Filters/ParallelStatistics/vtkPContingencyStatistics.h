@@ -22,14 +22,10 @@
 // vtkPContingencyStatistics is vtkContingencyStatistics subclass for parallel datasets.
 // It learns and derives the global statistical model on each node, but assesses each
 // individual data points on the node that owns it.
-
-// .NOTE: It is assumed that the keys in the contingency table be contained in the set {0,...,n-1}
-// of successive integers, where n is the number of rows of the summary table.
-// If this requirement is not fulfilled, then the outcome of the parallel update of contingency
-// tables is unpredictable but will most likely be a crash.
-// Note that this requirement is consistent with the way contingency tables are constructed
-// by the (serial) superclass and thus, if you are using this class as it is intended to be ran,
-// then you do not have to worry about this requirement.
+//
+// The contingency tables of all processes are aggregated by the serial
+// Aggregate operation, so that processes may see different (x,y) realizations,
+// or none at all.
 
 // .SECTION Thanks
 // Thanks to Philippe Pebay from Sandia National Laboratories for implementing this class.
@@ -40,10 +36,6 @@
 #include "vtkFiltersParallelStatisticsModule.h" // For export macro
 #include "vtkContingencyStatistics.h"
 
-//BTX
-#include <vector> // STL Header
-//ETX
-
 class vtkMultiBlockDataSet;
 class vtkMultiProcessController;
 
@@ -70,26 +62,6 @@ protected:
   vtkPContingencyStatistics();
   ~vtkPContingencyStatistics();
 
-//BTX
-  // Description:
-  // Reduce the collection of local contingency tables to the global one
-  bool Reduce( vtkIdType&,
-               char*,
-               vtkStdString&,
-               vtkIdType&,
-               vtkIdType*,
-               std::vector<vtkIdType>& );
-
-  // Description:
-  // Broadcast reduced contingency table to all processes
-  bool Broadcast( vtkIdType,
-                  vtkStdString&,
-                  std::vector<vtkStdString>&,
-                  vtkIdType,
-                  std::vector<vtkIdType>&,
-                  vtkIdType );
-//ETX
-
   vtkMultiProcessController* Controller;
 private:
   vtkPContingencyStatistics(const vtkPContingencyStatistics&); // Not implemented.
@@ -171,20 +171,6 @@ void vtkPKMeansStatistics::UpdateClusterCenters( vtkTable* newClusterElements,
                                                  globalIntElements[j*totalIntElements + nm + i], numClusterElements );
           }
         numDataElementsInCluster->SetValue( i, numClusterElements );
-
-        // check to see if need to perturb
-        if( numDataElementsInCluster->GetValue( i ) == 0 )
-          {
-          vtkWarningMacro("cluster center " << i-startRunID->GetValue(runID)
-                                            << " in run " << runID
-                                            << " is degenerate. Attempting to perturb");
-          this->DistanceFunctor->PerturbElement(newClusterElements,
-                                                curClusterElements,
-                                                i,
-                                                startRunID->GetValue(runID),
-                                                endRunID->GetValue(runID),
-                                                0.8 ) ;
-          }
         }
       }
     }
@@ -209,6 +195,14 @@ void vtkPKMeansStatistics::CreateInitialClusterCenters(vtkIdType numToAllocate,
                                                    inData, curClusterElements, newClusterElements );
     return;
     }
+
+  // k-means++ seeds are drawn from the observations of all processes
+  if ( this->InitializationMethod == KMEANS_PLUS_PLUS
+       && this->CreateKMeansPlusPlusClusterCenters( numToAllocate, numberOfClusters, inData,
+                                                    curClusterElements, newClusterElements ) )
+    {
+    return;
+    }
   // Now get ready for parallel calculations
   vtkCommunicator* com = this->Controller->GetCommunicator();
   if ( ! com )
@@ -253,3 +247,65 @@ void vtkPKMeansStatistics::CreateInitialClusterCenters(vtkIdType numToAllocate,
 
   this->DistanceFunctor->DeallocateElementArray( localElements ) ;
 }
+
+// ----------------------------------------------------------------------
+void vtkPKMeansStatistics::SelectInitialClusterCenter( double* candidate,
+                                                       int dimension,
+                                                       double weight,
+                                                       double u )
+{
+  int np = this->Controller->GetNumberOfProcesses();
+  vtkCommunicator* com = this->Controller->GetCommunicator();
+  if( np < 2 || ! com )
+    {
+    return;
+    }
+
+  // Choose a process with a probability proportional to its weight, with the
+  // same random number on all processes, then broadcast its candidate
+  double* weights = new double[np];
+  com->AllGather( &weight, weights, 1 );
+  double totalWeight = 0.;
+  for ( int j = 0; j < np; ++ j )
+    {
+    totalWeight += weights[j];
+    }
+  int chosen = 0;
+  double sum = 0.;
+  double target = u * totalWeight;
+  for ( int j = 0; j < np; ++ j )
+    {
+    if ( weights[j] > 0. )
+      {
+      chosen = j;
+      sum += weights[j];
+      if ( sum > target )
+        {
+        break;
+        }
+      }
+    }
+  delete [] weights;
+
+  if ( ! com->Broadcast( candidate, dimension, chosen ) )
+    {
+    vtkErrorMacro("Could not broadcast initial cluster coordinates");
+    }
+}
+
+// ----------------------------------------------------------------------
+void vtkPKMeansStatistics::GetTotalPotentials( double* potentials,
+                                               int numberOfCandidates )
+{
+  int np = this->Controller->GetNumberOfProcesses();
+  vtkCommunicator* com = this->Controller->GetCommunicator();
+  if( np < 2 || ! com )
+    {
+    return;
+    }
+
+  double* localPotentials = new double[numberOfCandidates];
+  memcpy( localPotentials, potentials, numberOfCandidates * sizeof( double ) );
+  com->AllReduce( localPotentials, potentials, numberOfCandidates, vtkCommunicator::SUM_OP );
+  delete [] localPotentials;
+}
@@ -22,6 +22,11 @@
 // vtkPKMeansStatistics is vtkKMeansStatistics subclass for parallel datasets.
 // It learns and derives the global statistical model on each node, but assesses each
 // individual data points on the node that owns it.
+//
+// Each process assigns its own observations to the cluster centers with the
+// kernels of vtkKMeansStatistics, including mini-batches which it draws from its
+// own observations, and the partial cluster centers of all processes are then
+// combined. k-means++ seeds are drawn from the observations of all processes.
 
 // .SECTION Thanks
 // Thanks to Janine Bennett, Philippe Pebay and David Thompson from Sandia National Laboratories for implementing this class.
@@ -49,7 +54,7 @@ public:
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
 
   // Description:
-  // Subroutine to update new cluster centers from the old centers.
+  // Subroutine to combine the new cluster centers of all processes.
   virtual void UpdateClusterCenters( vtkTable* newClusterElements,
                                      vtkTable* curClusterElements,
                                      vtkIdTypeArray* numMembershipChanges,
@@ -71,6 +76,18 @@ public:
                                            vtkTable* curClusterElements,
                                            vtkTable* newClusterElements);
 
+  // Description:
+  // Subroutine to choose the next k-means++ cluster center among the candidates
+  // of all processes.
+  virtual void SelectInitialClusterCenter( double* candidate,
+                                           int dimension,
+                                           double weight,
+                                           double u );
+
+  // Description:
+  // Subroutine to sum the potentials of candidate k-means++ cluster centers
+  // over all processes.
+  virtual void GetTotalPotentials( double* potentials, int numberOfCandidates );
 
 protected:
   vtkPKMeansStatistics();
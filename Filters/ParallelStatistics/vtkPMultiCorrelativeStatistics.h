@@ -48,7 +48,8 @@ public:
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
 
   // Description:
-  // Performs Reduction
+  // Performs Reduction: replace the sparse covariance matrix of each process
+  // with the aggregate of those of all processes.
   static void GatherStatistics( vtkMultiProcessController *curController,
                                 vtkTable *sparseCov );
 
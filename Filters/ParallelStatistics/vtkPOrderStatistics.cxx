@@ -25,6 +25,8 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkPOrderStatistics.h"
 
 #include "vtkCommunicator.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -32,6 +34,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkObjectFactory.h"
 #include "vtkMath.h"
 #include "vtkMultiProcessController.h"
+#include "vtkQuantileSketch.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariantArray.h"
@@ -40,6 +43,9 @@ PURPOSE.  See the above copyright notice for more information.
 #include <set>
 #include <vector>
 
+// Tag of the messages carrying sketches
+static const int vtkPOrderStatisticsSketchTag = 54321;
+
 vtkStandardNewMacro(vtkPOrderStatistics);
 vtkCxxSetObjectMacro(vtkPOrderStatistics, Controller, vtkMultiProcessController);
 //-----------------------------------------------------------------------------
@@ -134,6 +140,85 @@ static void StringBufferToStringVector( const vtkStdString& buffer,
     }
 }
 
+// ----------------------------------------------------------------------
+vtkIdType vtkPOrderStatistics::GetTotalNumberOfRows( vtkIdType nRow )
+{
+  if ( ! this->Controller || this->Controller->GetNumberOfProcesses() < 2 )
+    {
+    return nRow;
+    }
+
+  vtkIdType nRowTotal = 0;
+  this->Controller->AllReduce( &nRow, &nRowTotal, 1, vtkCommunicator::SUM_OP );
+  return nRowTotal;
+}
+
+// ----------------------------------------------------------------------
+bool vtkPOrderStatistics::ReduceSketch( vtkQuantileSketch* sketch )
+{
+  if ( ! this->Controller || this->Controller->GetNumberOfProcesses() < 2 )
+    {
+    return true;
+    }
+
+  int np = this->Controller->GetNumberOfProcesses();
+  int myRank = this->Controller->GetLocalProcessId();
+  vtkDoubleArray* buffer = vtkDoubleArray::New();
+  vtkQuantileSketch* other = vtkQuantileSketch::New();
+  bool ok = true;
+
+  // Merge along a binomial tree rooted at process 0: at each step, the
+  // processes whose rank has the step bit set send their sketch down and
+  // drop out, so that only log2(np) sketches go through any process
+  for ( int step = 1; step < np; step <<= 1 )
+    {
+    if ( myRank & step )
+      {
+      sketch->Serialize( buffer );
+      this->Controller->Send( buffer, myRank - step, vtkPOrderStatisticsSketchTag );
+      break;
+      }
+    else if ( myRank + step < np )
+      {
+      this->Controller->Receive( buffer, myRank + step, vtkPOrderStatisticsSketchTag );
+      if ( other->Deserialize( buffer ) )
+        {
+        sketch->Merge( other );
+        }
+      else
+        {
+        vtkErrorMacro( "Invalid sketch received by process "
+                       << myRank
+                       << " from process "
+                       << myRank + step
+                       << "." );
+        ok = false;
+        }
+      }
+    }
+
+  // Send the global sketch to all processes
+  if ( myRank == 0 )
+    {
+    sketch->Serialize( buffer );
+    }
+  this->Controller->Broadcast( buffer, 0 );
+  if ( myRank != 0 )
+    {
+    ok = sketch->Deserialize( buffer ) && ok;
+    }
+
+  buffer->Delete();
+  other->Delete();
+
+  // Agree on the result, so that all processes take the same path
+  int localOk = ok ? 1 : 0;
+  int globalOk = 0;
+  this->Controller->AllReduce( &localOk, &globalOk, 1, vtkCommunicator::MIN_OP );
+
+  return globalOk != 0;
+}
+
 // ----------------------------------------------------------------------
 void vtkPOrderStatistics::Learn( vtkTable* inData,
                                  vtkTable* inParameters,
@@ -185,6 +270,12 @@ void vtkPOrderStatistics::Learn( vtkTable* inData,
       continue;
       }
 
+    // Sketches were already reduced by the serial Learn
+    if ( histoTab->GetFieldData()->GetArray( "Quantile Sketch" ) )
+      {
+      continue;
+      }
+
     // Downcast columns to typed arrays for efficient data access
     vtkAbstractArray* vals =  histoTab->GetColumnByName( "Value" );
     vtkIdTypeArray* card = vtkIdTypeArray::SafeDownCast( histoTab->GetColumnByName( "Cardinality" ) );
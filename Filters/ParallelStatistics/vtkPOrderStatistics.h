@@ -22,6 +22,9 @@ PURPOSE.  See the above copyright notice for more information.
 // vtkPOrderStatistics is vtkOrderStatistics subclass for parallel datasets.
 // It learns and derives the global statistical model on each node, but assesses each
 // individual data points on the node that owns it.
+// With Sketch on, the sketches of numeric variables are merged along a binary tree
+// of processes instead of gathering all local histograms on one of them, so that the
+// amount of data exchanged does not depend on the number of distinct values.
 
 // .NOTE: It is assumed that the keys in the histogram table be contained in the set {0,...,n-1}
 // of successive integers, where n is the number of rows of the summary table.
@@ -47,6 +50,7 @@ PURPOSE.  See the above copyright notice for more information.
 class vtkIdTypeArray;
 class vtkMultiBlockDataSet;
 class vtkMultiProcessController;
+class vtkQuantileSketch;
 
 class VTKFILTERSPARALLELSTATISTICS_EXPORT vtkPOrderStatistics : public vtkOrderStatistics
 {
@@ -71,6 +75,16 @@ class VTKFILTERSPARALLELSTATISTICS_EXPORT vtkPOrderStatistics : public vtkOrderS
   vtkPOrderStatistics();
   ~vtkPOrderStatistics();
 
+  // Description:
+  // Return the sum of the number of rows over all processes.
+  virtual vtkIdType GetTotalNumberOfRows( vtkIdType );
+
+  // Description:
+  // Merge the sketches of all processes along a binary tree, then send the
+  // result back to all of them.  Returns false on all processes if any of
+  // them received an invalid sketch.
+  virtual bool ReduceSketch( vtkQuantileSketch* );
+
 //BTX
   // Description:
   // Reduce the collection of local histograms to the global one for data inputs
@@ -22,7 +22,6 @@
 #include "vtkPPCAStatistics.h"
 
 #include "vtkAbstractArray.h"
-#include "vtkCommunicator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
@@ -30,8 +29,8 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPOrderStatistics.h"
+#include "vtkPStatisticsModelReducer.h"
 #include "vtkTable.h"
-#include "vtkPMultiCorrelativeStatistics.h"
 
 vtkStandardNewMacro(vtkPPCAStatistics);
 vtkCxxSetObjectMacro(vtkPPCAStatistics, Controller, vtkMultiProcessController);
@@ -68,16 +67,14 @@ void vtkPPCAStatistics::Learn( vtkTable* inData,
   // First calculate correlative statistics on local data set
   this->Superclass::Learn( inData, inParameters, outMeta );
 
-  // Get a hold of the (sparse) covariance matrix
-  vtkTable* sparseCov = vtkTable::SafeDownCast( outMeta->GetBlock( 0 ) );
-  if ( ! sparseCov )
-    {
-    return;
-    }
-
+  // Then aggregate the models of all processes, unless medians were
+  // calculated, which the parallel order statistics already did globally
   if ( !this->MedianAbsoluteDeviation )
     {
-    vtkPMultiCorrelativeStatistics::GatherStatistics( this->Controller, sparseCov );
+    vtkPStatisticsModelReducer* reducer = vtkPStatisticsModelReducer::New();
+    reducer->SetController( this->Controller );
+    reducer->Reduce( this, outMeta );
+    reducer->Delete();
     }
 }
 
@@ -22,6 +22,10 @@
 // vtkPPCAStatistics is vtkPCAStatistics subclass for parallel datasets.
 // It learns and derives the global statistical model on each node, but assesses each
 // individual data points on the node that owns it.
+// With the TALL_SKINNY_QR decomposition scheme, the triangular factor of the
+// data of each node is computed by its threads, and the factors of all nodes
+// are reduced along a binomial tree (TSQR), so that the data are never
+// gathered nor is the covariance matrix decomposed.
 
 // .SECTION Thanks
 // Thanks to Philippe Pebay, David Thompson and Janine Bennett from
@@ -0,0 +1,119 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPStatisticsModelReducer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPStatisticsModelReducer.h"
+
+#include "vtkDataObjectCollection.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkStatisticsAlgorithm.h"
+
+// Tag of the messages carrying models
+static const int vtkPStatisticsModelReducerTag = 54322;
+
+vtkStandardNewMacro(vtkPStatisticsModelReducer);
+vtkCxxSetObjectMacro(vtkPStatisticsModelReducer, Controller, vtkMultiProcessController);
+//-----------------------------------------------------------------------------
+vtkPStatisticsModelReducer::vtkPStatisticsModelReducer()
+{
+  this->Controller = 0;
+  this->SetController( vtkMultiProcessController::GetGlobalController() );
+}
+
+//-----------------------------------------------------------------------------
+vtkPStatisticsModelReducer::~vtkPStatisticsModelReducer()
+{
+  this->SetController( 0 );
+}
+
+//-----------------------------------------------------------------------------
+void vtkPStatisticsModelReducer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Controller: " << this->Controller << endl;
+}
+
+// ----------------------------------------------------------------------
+bool vtkPStatisticsModelReducer::Reduce( vtkStatisticsAlgorithm* algorithm,
+                                         vtkMultiBlockDataSet* model )
+{
+  if ( ! algorithm || ! model )
+    {
+    return false;
+    }
+
+  // Make sure that parallel updates are needed, otherwise leave it at that.
+  if ( ! this->Controller || this->Controller->GetNumberOfProcesses() < 2 )
+    {
+    return true;
+    }
+
+  int np = this->Controller->GetNumberOfProcesses();
+  int myRank = this->Controller->GetLocalProcessId();
+  bool ok = true;
+
+  // Aggregate along a binomial tree rooted at process 0: at each step, the
+  // processes whose rank has the step bit set send their model down and drop
+  // out. The model of lower ranks always comes first in the collection, so
+  // that the aggregate does not depend on the timing of the messages.
+  vtkMultiBlockDataSet* other = vtkMultiBlockDataSet::New();
+  vtkDataObjectCollection* models = vtkDataObjectCollection::New();
+  for ( int step = 1; step < np; step <<= 1 )
+    {
+    if ( myRank & step )
+      {
+      if ( ! this->Controller->Send( model, myRank - step, vtkPStatisticsModelReducerTag ) )
+        {
+        vtkErrorMacro( "Process "
+                       << myRank
+                       << " could not send its model." );
+        ok = false;
+        }
+      break;
+      }
+    else if ( myRank + step < np )
+      {
+      other->Initialize();
+      if ( ! this->Controller->Receive( other, myRank + step, vtkPStatisticsModelReducerTag ) )
+        {
+        vtkErrorMacro( "Process "
+                       << myRank
+                       << " could not receive the model of process "
+                       << myRank + step
+                       << "." );
+        ok = false;
+        continue;
+        }
+
+      models->RemoveAllItems();
+      models->AddItem( model );
+      models->AddItem( other );
+      algorithm->Aggregate( models, model );
+      }
+    }
+  models->Delete();
+  other->Delete();
+
+  // Send the aggregated model to all processes
+  if ( ! this->Controller->Broadcast( model, 0 ) )
+    {
+    vtkErrorMacro( "Process "
+                   << myRank
+                   << " could not broadcast the aggregated model." );
+    ok = false;
+    }
+
+  return ok;
+}
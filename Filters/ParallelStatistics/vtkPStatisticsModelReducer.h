@@ -0,0 +1,75 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPStatisticsModelReducer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPStatisticsModelReducer - Aggregate the models learned by all
+// processes with the Aggregate operation of a statistics algorithm
+//
+// .SECTION Description
+// vtkPStatisticsModelReducer replaces the model that each process learned from
+// its piece of the data with the model of the whole data set. The models are
+// sent along a binomial tree rooted at process 0, where each process merges the
+// model it receives with its own by calling the Aggregate operation of the
+// statistics algorithm, so that no process handles more than log2(np) models;
+// the result is then broadcast to all processes. Models are sent whole, so that
+// this works for any algorithm whose models can be aggregated, including those
+// whose size depends on the data, such as contingency tables.
+//
+// Parallel statistics algorithms thus share the code path used to learn
+// chunks of a table with vtkStreamingStatistics.
+//
+// .SECTION See Also
+// vtkStatisticsAlgorithm vtkStreamingStatistics
+
+#ifndef __vtkPStatisticsModelReducer_h
+#define __vtkPStatisticsModelReducer_h
+
+#include "vtkFiltersParallelStatisticsModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkMultiBlockDataSet;
+class vtkMultiProcessController;
+class vtkStatisticsAlgorithm;
+
+class VTKFILTERSPARALLELSTATISTICS_EXPORT vtkPStatisticsModelReducer : public vtkObject
+{
+public:
+  static vtkPStatisticsModelReducer* New();
+  vtkTypeMacro(vtkPStatisticsModelReducer, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get/Set the multiprocess controller. If no controller is set,
+  // single process is assumed.
+  virtual void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+
+  // Description:
+  // Replace the model of each process with the aggregate of the models of all
+  // processes, calculated by the given algorithm. This must be called by all
+  // processes. Return false if a model could not be exchanged.
+  bool Reduce( vtkStatisticsAlgorithm* algorithm,
+               vtkMultiBlockDataSet* model );
+
+protected:
+  vtkPStatisticsModelReducer();
+  ~vtkPStatisticsModelReducer();
+
+  vtkMultiProcessController* Controller;
+
+private:
+  vtkPStatisticsModelReducer(const vtkPStatisticsModelReducer&); // Not implemented.
+  void operator=(const vtkPStatisticsModelReducer&); // Not implemented.
+};
+
+#endif
@@ -11,7 +11,12 @@
 // for implementing this test.
 
 #include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkKMeansDistanceFunctor.h"
+#include "vtkMinimalStandardRandomSequence.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkObjectFactory.h"
 #include "vtkStringArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkTable.h"
@@ -22,6 +27,236 @@
 
 #include <vtksys/ios/sstream>
 
+//=============================================================================
+// The default Euclidean distance under another class name, so that observations
+// are assigned one at a time through the distance functor
+class vtkKMeansRowByRowDistanceFunctor : public vtkKMeansDistanceFunctor
+{
+public:
+  static vtkKMeansRowByRowDistanceFunctor* New();
+  vtkTypeMacro(vtkKMeansRowByRowDistanceFunctor, vtkKMeansDistanceFunctor);
+};
+
+vtkStandardNewMacro(vtkKMeansRowByRowDistanceFunctor);
+
+//=============================================================================
+// Check that the model has nClusters clusters of nPerCluster observations,
+// each within tol of one of the true means
+static int CheckClusters( const char* name,
+                          vtkKMeansStatistics* ks,
+                          int nClusters,
+                          int nPerCluster,
+                          const double means[][3],
+                          double tol )
+{
+  vtkMultiBlockDataSet* model = vtkMultiBlockDataSet::SafeDownCast(
+    ks->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) );
+  vtkTable* centers = vtkTable::SafeDownCast( model->GetBlock( 0 ) );
+  cout << "## " << name << ":\n";
+  centers->Dump();
+
+  int status = 0;
+  if ( centers->GetNumberOfRows() != nClusters )
+    {
+    vtkGenericWarningMacro( << name << ": " << centers->GetNumberOfRows()
+                            << " clusters instead of " << nClusters << "." );
+    return 1;
+    }
+  bool found[8] = { false, false, false, false, false, false, false, false };
+  for ( vtkIdType r = 0; r < nClusters; ++ r )
+    {
+    bool matched = false;
+    for ( int m = 0; m < nClusters && ! matched; ++ m )
+      {
+      matched = ! found[m]
+        && fabs( centers->GetValueByName( r, "Int" ).ToDouble() - means[m][0] ) < tol
+        && fabs( centers->GetValueByName( r, "Float" ).ToDouble() - means[m][1] ) < tol
+        && fabs( centers->GetValueByName( r, "Double" ).ToDouble() - means[m][2] ) < tol;
+      if ( matched )
+        {
+        found[m] = true;
+        }
+      }
+    if ( ! matched
+         || centers->GetValueByName( r, "Cardinality" ).ToInt() != nPerCluster )
+      {
+      vtkGenericWarningMacro( << name << ": cluster " << r << " is not one of the true clusters." );
+      status = 1;
+      }
+    }
+  return status;
+}
+
+//=============================================================================
+// Compare the kernels used with the default distance functor to the assignment
+// of observations one at a time, and check k-means++ seeding and mini-batches
+static int TestKMeansKernels()
+{
+  int testStatus = 0;
+
+  // Well separated clusters of columns of different types
+  const int nClusters = 5;
+  const int nPerCluster = 400;
+  const double means[nClusters][3] =
+    { { 0., 0., 0. }, { 40., 0., 10. }, { 0., 40., -10. }, { -40., -40., 20. }, { 40., 40., 40. } };
+  vtkMinimalStandardRandomSequence* random = vtkMinimalStandardRandomSequence::New();
+  random->SetSeed( 2015 );
+  vtkIntArray* intCol = vtkIntArray::New();
+  intCol->SetName( "Int" );
+  vtkFloatArray* floatCol = vtkFloatArray::New();
+  floatCol->SetName( "Float" );
+  vtkDoubleArray* doubleCol = vtkDoubleArray::New();
+  doubleCol->SetName( "Double" );
+  for ( int i = 0; i < nPerCluster; ++ i )
+    {
+    for ( int m = 0; m < nClusters; ++ m )
+      {
+      double x[3];
+      for ( int c = 0; c < 3; ++ c )
+        {
+        random->Next();
+        x[c] = means[m][c] + random->GetRangeValue( -3., 3. );
+        }
+      intCol->InsertNextValue( static_cast<int>( floor( x[0] + .5 ) ) );
+      floatCol->InsertNextValue( static_cast<float>( x[1] ) );
+      doubleCol->InsertNextValue( x[2] );
+      }
+    }
+  vtkTable* inputData = vtkTable::New();
+  inputData->AddColumn( intCol );
+  inputData->AddColumn( floatCol );
+  inputData->AddColumn( doubleCol );
+  intCol->Delete();
+  floatCol->Delete();
+  doubleCol->Delete();
+
+  // Two runs with initial centers, of which one is degenerate
+  vtkTable* paramData = vtkTable::New();
+  vtkIdTypeArray* paramK = vtkIdTypeArray::New();
+  paramK->SetName( "K" );
+  vtkDoubleArray* paramCols[3];
+  const char* names[] = { "Int", "Float", "Double" };
+  for ( int c = 0; c < 3; ++ c )
+    {
+    paramCols[c] = vtkDoubleArray::New();
+    paramCols[c]->SetName( names[c] );
+    }
+  const double seeds[7][3] =
+    { { 1., 1., 1. }, { 10., 10., 10. }, { 20., 20., 20. }, { -30., -30., 0. },
+      { 0., 0., 0. }, { 30., 30., 30. }, { 500., 500., 500. } };
+  for ( int k = 0; k < 7; ++ k )
+    {
+    paramK->InsertNextValue( k < 4 ? 4 : 3 );
+    for ( int c = 0; c < 3; ++ c )
+      {
+      paramCols[c]->InsertNextValue( seeds[k][c] );
+      }
+    }
+  paramData->AddColumn( paramK );
+  paramK->Delete();
+  for ( int c = 0; c < 3; ++ c )
+    {
+    paramData->AddColumn( paramCols[c] );
+    paramCols[c]->Delete();
+    }
+
+  vtkKMeansStatistics* kernels = vtkKMeansStatistics::New();
+  vtkKMeansStatistics* rowByRow = vtkKMeansStatistics::New();
+  vtkKMeansRowByRowDistanceFunctor* rowByRowFunctor = vtkKMeansRowByRowDistanceFunctor::New();
+  rowByRow->SetDistanceFunctor( rowByRowFunctor );
+  rowByRowFunctor->Delete();
+  vtkKMeansStatistics* engines[] = { kernels, rowByRow };
+  for ( int e = 0; e < 2; ++ e )
+    {
+    engines[e]->SetInputData( vtkStatisticsAlgorithm::INPUT_DATA, inputData );
+    engines[e]->SetInputData( vtkStatisticsAlgorithm::LEARN_PARAMETERS, paramData );
+    for ( int c = 0; c < 3; ++ c )
+      {
+      engines[e]->SetColumnStatus( names[c], 1 );
+      }
+    engines[e]->RequestSelectedColumns();
+    engines[e]->SetTolerance( 0. );
+    engines[e]->SetMaxNumIterations( 5 );
+    engines[e]->SetAssessOption( true );
+    engines[e]->Update();
+    }
+
+  // Both must find the same clusters, and assess the same distances
+  vtkTable* kernelCenters = vtkTable::SafeDownCast( vtkMultiBlockDataSet::SafeDownCast(
+    kernels->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) )->GetBlock( 0 ) );
+  vtkTable* rowByRowCenters = vtkTable::SafeDownCast( vtkMultiBlockDataSet::SafeDownCast(
+    rowByRow->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) )->GetBlock( 0 ) );
+  cout << "## Clusters found by the kernels:\n";
+  kernelCenters->Dump();
+  for ( vtkIdType r = 0; r < rowByRowCenters->GetNumberOfRows(); ++ r )
+    {
+    for ( vtkIdType c = 0; c < rowByRowCenters->GetNumberOfColumns(); ++ c )
+      {
+      double x = rowByRowCenters->GetValue( r, c ).ToDouble();
+      double y = kernelCenters->GetValue( r, c ).ToDouble();
+      if ( fabs( x - y ) > 1.e-9 * ( 1. + fabs( x ) ) )
+        {
+        vtkGenericWarningMacro( "Kernels found "
+                                << y
+                                << " instead of "
+                                << x
+                                << " for "
+                                << rowByRowCenters->GetColumnName( c )
+                                << " of cluster "
+                                << r
+                                << "." );
+        testStatus = 1;
+        }
+      }
+    }
+  vtkTable* kernelAssess = kernels->GetOutput( vtkStatisticsAlgorithm::OUTPUT_DATA );
+  vtkTable* rowByRowAssess = rowByRow->GetOutput( vtkStatisticsAlgorithm::OUTPUT_DATA );
+  for ( vtkIdType r = 0; r < rowByRowAssess->GetNumberOfRows(); ++ r )
+    {
+    for ( vtkIdType c = 3; c < rowByRowAssess->GetNumberOfColumns(); ++ c )
+      {
+      double x = rowByRowAssess->GetValue( r, c ).ToDouble();
+      double y = kernelAssess->GetValue( r, c ).ToDouble();
+      if ( fabs( x - y ) > 1.e-9 * ( 1. + fabs( x ) ) )
+        {
+        vtkGenericWarningMacro( "Kernels assessed "
+                                << y
+                                << " instead of "
+                                << x
+                                << " for "
+                                << rowByRowAssess->GetColumnName( c )
+                                << " of observation "
+                                << r
+                                << "." );
+        testStatus = 1;
+        break;
+        }
+      }
+    }
+
+  // k-means++ seeds, without initial centers
+  kernels->SetInputData( vtkStatisticsAlgorithm::LEARN_PARAMETERS, 0 );
+  kernels->SetAssessOption( false );
+  kernels->SetDefaultNumberOfClusters( nClusters );
+  kernels->SetInitializationMethodToKMeansPlusPlus();
+  kernels->SetTolerance( .001 );
+  kernels->Update();
+  testStatus += CheckClusters( "k-means++ seeding", kernels, nClusters, nPerCluster, means, .5 );
+
+  // Mini-batches, which are much smaller than the table
+  kernels->SetMiniBatchSize( 100 );
+  kernels->SetMaxNumIterations( 200 );
+  kernels->Update();
+  testStatus += CheckClusters( "k-means++ seeding and mini-batches", kernels, nClusters, nPerCluster, means, .5 );
+
+  rowByRow->Delete();
+  kernels->Delete();
+  paramData->Delete();
+  inputData->Delete();
+  random->Delete();
+
+  return testStatus;
+}
 
 //=============================================================================
 int TestKMeansStatistics( int, char *[] )
@@ -249,6 +484,8 @@ int TestKMeansStatistics( int, char *[] )
   inputData->Delete();
   haruspex->Delete();
 
+  testStatus += TestKMeansKernels();
+
   return testStatus;
 }
 
@@ -11,16 +11,73 @@
 // for implementing this test.
 
 #include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkStringArray.h"
 #include "vtkMath.h"
 #include "vtkTable.h"
 #include "vtkOrderStatistics.h"
+#include "vtkQuantileSketch.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkStreamingStatistics.h"
 
+#include <vtksys/stl/algorithm>
 #include <vtksys/stl/vector>
 #include <vtksys/stl/map>
 
+//=============================================================================
+// Verify that the quantiles of a model are within the given rank error of the
+// exact quantiles of the sorted values
+static int CheckSketchQuantiles( vtkMultiBlockDataSet* model,
+                                 const vtksys_stl::vector<double>& sorted,
+                                 vtkIdType maxRankError )
+{
+  int testStatus = 0;
+  vtkIdType n = static_cast<vtkIdType>( sorted.size() );
+  vtkTable* quantiles = vtkTable::SafeDownCast( model->GetBlock( model->GetNumberOfBlocks() - 1 ) );
+  vtkAbstractArray* qCol = quantiles ? quantiles->GetColumnByName( "Sketched" ) : 0;
+  if ( ! qCol )
+    {
+    vtkGenericWarningMacro("No quantiles were calculated for sketched values.");
+    return 1;
+    }
+
+  vtkIdType nq = quantiles->GetNumberOfRows() - 1;
+  for ( vtkIdType k = 0; k <= nq; ++ k )
+    {
+    double q = quantiles->GetValueByName( k, "Sketched" ).ToDouble();
+    vtkIdType target = ( k * n ) / nq;
+    vtkIdType below = vtksys_stl::lower_bound( sorted.begin(), sorted.end(), q ) - sorted.begin();
+    vtkIdType upTo = vtksys_stl::upper_bound( sorted.begin(), sorted.end(), q ) - sorted.begin();
+
+    cout << "   "
+         << quantiles->GetValueByName( k, "Quantile" ).ToString()
+         << ": "
+         << q
+         << " of rank within ["
+         << below
+         << ", "
+         << upTo
+         << "] for a target rank of "
+         << target
+         << "\n";
+
+    // The value may also be an average of two consecutive values
+    if ( below > target + maxRankError + 1 || upTo < target - maxRankError - 1 )
+      {
+      vtkGenericWarningMacro("Rank error of "
+                             << quantiles->GetValueByName( k, "Quantile" ).ToString()
+                             << " exceeds "
+                             << maxRankError
+                             << ".");
+      testStatus = 1;
+      }
+    }
+
+  return testStatus;
+}
+
 //=============================================================================
 int TestOrderStatistics( int, char *[] )
 {
@@ -619,5 +676,156 @@ int TestOrderStatistics( int, char *[] )
   // Clean up
   os2->Delete();
 
+  // ************** Quantiles of a large data set with sketches **************
+
+  // Draw normal values
+  vtkIdType nSketchVals = 200000;
+  vtkMath::RandomSeed( 1 );
+  vtkDoubleArray* sketchedArr = vtkDoubleArray::New();
+  sketchedArr->SetName( "Sketched" );
+  sketchedArr->SetNumberOfTuples( nSketchVals );
+  for ( vtkIdType r = 0; r < nSketchVals; ++ r )
+    {
+    sketchedArr->SetValue( r, vtkMath::Gaussian() );
+    }
+  vtkTable* sketchedData = vtkTable::New();
+  sketchedData->AddColumn( sketchedArr );
+
+  vtksys_stl::vector<double> sortedVals( sketchedArr->GetPointer( 0 ), sketchedArr->GetPointer( 0 ) + nSketchVals );
+  vtksys_stl::sort( sortedVals.begin(), sortedVals.end() );
+
+  // Learn and Derive deciles with a rank error of at most 0.5%
+  double sketchError = .005;
+  vtkOrderStatistics* os3 = vtkOrderStatistics::New();
+  os3->SetInputData( vtkStatisticsAlgorithm::INPUT_DATA, sketchedData );
+  os3->AddColumn( "Sketched" );
+  os3->SetParameter( "Sketch", 0, 1 );
+  os3->SetParameter( "SketchError", 0, sketchError );
+  os3->SetNumberOfIntervals( 10 );
+  os3->SetLearnOption( true );
+  os3->SetDeriveOption( true );
+  os3->SetAssessOption( false );
+  os3->SetTestOption( false );
+  os3->Update();
+
+  vtkMultiBlockDataSet* outputModelDS3 = vtkMultiBlockDataSet::SafeDownCast( os3->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) );
+  vtkTable* outputHistogram3 = vtkTable::SafeDownCast( outputModelDS3->GetBlock( 0 ) );
+  vtkIdTypeArray* boundArr = vtkIdTypeArray::SafeDownCast( outputHistogram3->GetFieldData()->GetArray( "Rank Error Bound" ) );
+  vtkIdType maxRankError = static_cast<vtkIdType>( sketchError * nSketchVals );
+
+  cout << "\n## Deciles of "
+       << nSketchVals
+       << " normal values with a sketch of "
+       << outputHistogram3->GetNumberOfRows()
+       << " values:\n";
+
+  // Verify that the histogram is much smaller than the data, and that the
+  // error bound is as requested and holds
+  if ( ! boundArr
+       || boundArr->GetValue( 0 ) > maxRankError
+       || outputHistogram3->GetNumberOfRows() > nSketchVals / 10 )
+    {
+    vtkGenericWarningMacro("Incorrect sketch of "
+                           << outputHistogram3->GetNumberOfRows()
+                           << " values.");
+    testStatus = 1;
+    }
+  else
+    {
+    testStatus = CheckSketchQuantiles( outputModelDS3, sortedVals, boundArr->GetValue( 0 ) ) || testStatus;
+    }
+
+  // Stream the same values in chunks, aggregating sketches, then exact histograms
+  int nChunks = 4;
+  vtkIdType chunkSize = nSketchVals / nChunks;
+  for ( int exact = 0; exact < 2; ++ exact )
+    {
+    os3->SetSketch( ! exact );
+    vtkStreamingStatistics* ss = vtkStreamingStatistics::New();
+    ss->SetStatisticsAlgorithm( os3 );
+    for ( int c = 0; c < nChunks; ++ c )
+      {
+      vtkDoubleArray* chunkArr = vtkDoubleArray::New();
+      chunkArr->SetName( "Sketched" );
+      chunkArr->SetArray( sketchedArr->GetPointer( c * chunkSize ), chunkSize, 1 );
+      vtkTable* chunk = vtkTable::New();
+      chunk->AddColumn( chunkArr );
+      ss->SetInputData( chunk );
+      ss->Update();
+      chunk->Delete();
+      chunkArr->Delete();
+      }
+
+    vtkMultiBlockDataSet* streamedModel = vtkMultiBlockDataSet::SafeDownCast( ss->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) );
+    vtkTable* streamedHistogram = vtkTable::SafeDownCast( streamedModel->GetBlock( 0 ) );
+    boundArr = vtkIdTypeArray::SafeDownCast( streamedHistogram->GetFieldData()->GetArray( "Rank Error Bound" ) );
+    vtkIdType streamedRankError = exact ? 0 : ( boundArr ? boundArr->GetValue( 0 ) : -1 );
+
+    cout << "\n## Deciles of the same values streamed in "
+         << nChunks
+         << " chunks with "
+         << ( exact ? "an exact histogram" : "a sketch" )
+         << " of "
+         << streamedHistogram->GetNumberOfRows()
+         << " values and a rank error bound of "
+         << streamedRankError
+         << ":\n";
+
+    vtkIdType streamedCard = 0;
+    vtkIdTypeArray* streamedCardArr = vtkIdTypeArray::SafeDownCast( streamedHistogram->GetColumnByName( "Cardinality" ) );
+    for ( vtkIdType r = 0; r < streamedCardArr->GetNumberOfTuples(); ++ r )
+      {
+      streamedCard += streamedCardArr->GetValue( r );
+      }
+    if ( streamedCard != nSketchVals || streamedRankError < 0 )
+      {
+      vtkGenericWarningMacro("Incorrect aggregated histogram of "
+                             << streamedCard
+                             << " values.");
+      testStatus = 1;
+      }
+    else
+      {
+      testStatus = CheckSketchQuantiles( streamedModel, sortedVals, streamedRankError ) || testStatus;
+      }
+
+    ss->Delete();
+    }
+
+  // Verify that serialized sketches with a bad level size are rejected
+  vtkQuantileSketch* sketch = vtkQuantileSketch::New();
+  sketch->SetCapacity( 64 );
+  sketch->InsertValues( sketchedArr );
+  vtkDoubleArray* serialized = vtkDoubleArray::New();
+  sketch->Serialize( serialized );
+  if ( ! sketch->Deserialize( serialized ) )
+    {
+    vtkGenericWarningMacro("Could not deserialize a sketch.");
+    testStatus = 1;
+    }
+  double badSizes[] = { vtkMath::Nan(), vtkMath::Inf(), -1., 1.5,
+                        static_cast<double>( serialized->GetNumberOfTuples() ) };
+  for ( int i = 0; i < 5; ++ i )
+    {
+    // The size of the first level follows the 4 header values and its parity
+    double size = serialized->GetValue( 5 );
+    serialized->SetValue( 5, badSizes[i] );
+    if ( sketch->Deserialize( serialized ) )
+      {
+      vtkGenericWarningMacro("Deserialized a sketch with a level size of "
+                             << badSizes[i]
+                             << ".");
+      testStatus = 1;
+      }
+    serialized->SetValue( 5, size );
+    }
+  serialized->Delete();
+  sketch->Delete();
+
+  // Clean up
+  os3->Delete();
+  sketchedData->Delete();
+  sketchedArr->Delete();
+
   return testStatus;
 }
@@ -11,7 +11,11 @@
 // for implementing this test.
 // Test added for Robust PCA by Tristan Coulange, Kitware SAS 2013
 
+#include "vtkDataObjectCollection.h"
 #include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkNew.h"
 #include "vtkPCAStatistics.h"
@@ -40,6 +44,7 @@ int TestPCARobust(int argc, char* argv[]);
 int TestPCAPart(int argc, char* argv[], bool RobustPCA);
 int TestPCARobust2();
 int TestEigen();
+int TestPCATallSkinnyQR();
 
 //=============================================================================
 int TestPCAStatistics(int argc, char* argv[])
@@ -50,6 +55,7 @@ int TestPCAStatistics(int argc, char* argv[])
   result |= TestPCARobust(argc, argv);
   result |= TestPCARobust2();
   result |= TestEigen();
+  result |= TestPCATallSkinnyQR();
 
   if ( result == EXIT_FAILURE )
     {
@@ -494,3 +500,222 @@ int TestEigen()
 
   return EXIT_SUCCESS;
 }
+
+//=============================================================================
+// Learn and derive a PCA model of the given data with the given schemes
+static vtkMultiBlockDataSet* LearnPCAModel( vtkTable* data,
+                                            int decompositionScheme,
+                                            int normalizationScheme,
+                                            bool derive )
+{
+  vtkPCAStatistics* pca = vtkPCAStatistics::New();
+  pca->SetInputData( vtkStatisticsAlgorithm::INPUT_DATA, data );
+  for ( vtkIdType c = 0; c < data->GetNumberOfColumns(); ++ c )
+    {
+    pca->SetColumnStatus( data->GetColumnName( c ), 1 );
+    }
+  pca->RequestSelectedColumns();
+  pca->ResetAllColumnStates();
+  pca->SetColumnStatus( "x1", 1 );
+  pca->SetColumnStatus( "x3", 1 );
+  pca->RequestSelectedColumns();
+  pca->SetDecompositionScheme( decompositionScheme );
+  pca->SetNormalizationScheme( normalizationScheme );
+  pca->SetDeriveOption( derive );
+  pca->Update();
+
+  vtkMultiBlockDataSet* model = vtkMultiBlockDataSet::New();
+  model->DeepCopy( pca->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) );
+  pca->Delete();
+  return model;
+}
+
+//=============================================================================
+// Compare the eigenvalues and eigenvectors of two derived PCA models, which
+// are only defined up to their sign
+static bool ComparePCAModels( vtkMultiBlockDataSet* model,
+                              vtkMultiBlockDataSet* reference,
+                              const char* what )
+{
+  if ( model->GetNumberOfBlocks() != reference->GetNumberOfBlocks() )
+    {
+    cerr << what << ": the models do not have the same number of blocks.\n";
+    return false;
+    }
+
+  for ( unsigned int b = 1; b < model->GetNumberOfBlocks(); ++ b )
+    {
+    vtkTable* table = vtkTable::SafeDownCast( model->GetBlock( b ) );
+    vtkTable* refTable = vtkTable::SafeDownCast( reference->GetBlock( b ) );
+    vtkIdType m = refTable->GetNumberOfColumns() - 2;
+    if ( table->GetNumberOfRows() != refTable->GetNumberOfRows()
+         || table->GetNumberOfColumns() != refTable->GetNumberOfColumns() )
+      {
+      cerr << what << ": the tables of request " << b - 1 << " do not have the same size.\n";
+      return false;
+      }
+
+    // Covariance matrix, Cholesky decomposition, and eigenvalues
+    double scale = fabs( refTable->GetValue( m + 1, 1 ).ToDouble() );
+    for ( vtkIdType r = 0; r < refTable->GetNumberOfRows(); ++ r )
+      {
+      if ( table->GetValue( r, 0 ).ToString() != refTable->GetValue( r, 0 ).ToString()
+           || fabs( table->GetValue( r, 1 ).ToDouble() - refTable->GetValue( r, 1 ).ToDouble() )
+           > 1.e-7 * ( scale + fabs( refTable->GetValue( r, 1 ).ToDouble() ) ) )
+        {
+        cerr << what << ": request " << b - 1 << " row " << r << " "
+             << table->GetValue( r, 0 ).ToString() << " has mean or eigenvalue "
+             << table->GetValue( r, 1 ).ToDouble() << " instead of "
+             << refTable->GetValue( r, 1 ).ToDouble() << ".\n";
+        return false;
+        }
+      }
+
+    // Eigenvectors
+    for ( vtkIdType i = 0; i < m; ++ i )
+      {
+      double dot = 0.;
+      for ( vtkIdType j = 0; j < m; ++ j )
+        {
+        dot += table->GetValue( m + 1 + i, j + 2 ).ToDouble()
+          * refTable->GetValue( m + 1 + i, j + 2 ).ToDouble();
+        }
+      if ( fabs( fabs( dot ) - 1. ) > 1.e-6 )
+        {
+        cerr << what << ": eigenvector " << i << " of request " << b - 1
+             << " differs from the reference ( dot product " << dot << ").\n";
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+//=============================================================================
+int TestPCATallSkinnyQR()
+{
+  // Columns of several types, with means that are large with respect to their
+  // deviations, and two nearly collinear columns
+  vtkIdType nRow = 3000;
+  vtkNew<vtkDoubleArray> x0;
+  x0->SetName( "x0" );
+  vtkNew<vtkFloatArray> x1;
+  x1->SetName( "x1" );
+  vtkNew<vtkIntArray> x2;
+  x2->SetName( "x2" );
+  vtkNew<vtkDoubleArray> x3;
+  x3->SetName( "x3" );
+  vtkNew<vtkDoubleArray> x4;
+  x4->SetName( "x4" );
+  for ( vtkIdType i = 0; i < nRow; ++ i )
+    {
+    double u = sin( .37 * i );
+    double v = cos( 1.13 * i + .5 );
+    double w = sin( 2.71 * i + 1. );
+    x0->InsertNextValue( 1000. + 3. * u + v );
+    x1->InsertNextValue( static_cast<float>( -20. + u - 2. * w ) );
+    x2->InsertNextValue( static_cast<int>( 100. * v ) );
+    x3->InsertNextValue( 50. + .5 * w + .1 * u * v );
+    x4->InsertNextValue( 1000. + 3. * u + v + 1.e-3 * w );
+    }
+  vtkNew<vtkTable> data;
+  data->AddColumn( x0.GetPointer() );
+  data->AddColumn( x1.GetPointer() );
+  data->AddColumn( x2.GetPointer() );
+  data->AddColumn( x3.GetPointer() );
+  data->AddColumn( x4.GetPointer() );
+
+  int testStatus = EXIT_SUCCESS;
+  int normalizations[] = { vtkPCAStatistics::NONE, vtkPCAStatistics::DIAGONAL_VARIANCE };
+  for ( int k = 0; k < 2; ++ k )
+    {
+    vtkMultiBlockDataSet* covModel = LearnPCAModel(
+      data.GetPointer(), vtkPCAStatistics::COVARIANCE_SVD, normalizations[k], true );
+    vtkMultiBlockDataSet* qrModel = LearnPCAModel(
+      data.GetPointer(), vtkPCAStatistics::TALL_SKINNY_QR, normalizations[k], true );
+    cout << "## Tall skinny QR with normalization scheme "
+         << normalizations[k] << ":\n";
+    vtkTable::SafeDownCast( qrModel->GetBlock( 1 ) )->Dump();
+
+    // The raw moments must be those computed by the superclass
+    vtkTable* covMoments = vtkTable::SafeDownCast( covModel->GetBlock( 0 ) );
+    vtkTable* qrMoments = vtkTable::SafeDownCast( qrModel->GetBlock( 0 ) );
+    for ( vtkIdType r = 0; r < covMoments->GetNumberOfRows(); ++ r )
+      {
+      double ref = covMoments->GetValueByName( r, "Entries" ).ToDouble();
+      double val = qrMoments->GetValueByName( r, "Entries" ).ToDouble();
+      if ( fabs( val - ref ) > 1.e-8 * ( 1. + fabs( ref ) ) )
+        {
+        cerr << "Raw moment " << r << " is " << val << " instead of " << ref << ".\n";
+        testStatus = EXIT_FAILURE;
+        }
+      }
+
+    if ( ! ComparePCAModels( qrModel, covModel, "Tall skinny QR" ) )
+      {
+      testStatus = EXIT_FAILURE;
+      }
+    covModel->Delete();
+    qrModel->Delete();
+    }
+
+  // Learn three pieces of the data separately and aggregate their models: the
+  // triangular factors must be aggregated as well and give the same result
+  vtkMultiBlockDataSet* qrModel = LearnPCAModel(
+    data.GetPointer(), vtkPCAStatistics::TALL_SKINNY_QR, vtkPCAStatistics::NONE, true );
+  vtkNew<vtkDataObjectCollection> models;
+  vtkIdType bounds[] = { 0, 1000, 1003, nRow };
+  for ( int p = 0; p < 3; ++ p )
+    {
+    vtkNew<vtkTable> piece;
+    for ( vtkIdType c = 0; c < data->GetNumberOfColumns(); ++ c )
+      {
+      vtkDataArray* column = vtkDataArray::SafeDownCast( data->GetColumn( c ) );
+      vtkDataArray* pieceColumn = column->NewInstance();
+      pieceColumn->SetName( column->GetName() );
+      for ( vtkIdType i = bounds[p]; i < bounds[p + 1]; ++ i )
+        {
+        pieceColumn->InsertNextTuple( i, column );
+        }
+      piece->AddColumn( pieceColumn );
+      pieceColumn->Delete();
+      }
+    vtkMultiBlockDataSet* pieceModel = LearnPCAModel(
+      piece.GetPointer(), vtkPCAStatistics::TALL_SKINNY_QR, vtkPCAStatistics::NONE, false );
+    models->AddItem( pieceModel );
+    pieceModel->Delete();
+    }
+
+  vtkNew<vtkPCAStatistics> pca;
+  vtkNew<vtkMultiBlockDataSet> aggregated;
+  pca->SetDecompositionScheme( vtkPCAStatistics::TALL_SKINNY_QR );
+  pca->Aggregate( models.GetPointer(), aggregated.GetPointer() );
+  if ( ! vtkTable::SafeDownCast( aggregated->GetBlock( 0 ) )->GetFieldData()->GetArray( "PCA R Factor" ) )
+    {
+    cerr << "The aggregated model has no triangular factor.\n";
+    testStatus = EXIT_FAILURE;
+    }
+
+  for ( vtkIdType c = 0; c < data->GetNumberOfColumns(); ++ c )
+    {
+    pca->SetColumnStatus( data->GetColumnName( c ), 1 );
+    }
+  pca->RequestSelectedColumns();
+  pca->ResetAllColumnStates();
+  pca->SetColumnStatus( "x1", 1 );
+  pca->SetColumnStatus( "x3", 1 );
+  pca->RequestSelectedColumns();
+  pca->SetInputData( vtkStatisticsAlgorithm::INPUT_MODEL, aggregated.GetPointer() );
+  pca->SetLearnOption( false );
+  pca->SetDeriveOption( true );
+  pca->Update();
+  if ( ! ComparePCAModels(
+         vtkMultiBlockDataSet::SafeDownCast( pca->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) ),
+         qrModel, "Aggregated tall skinny QR" ) )
+    {
+    testStatus = EXIT_FAILURE;
+    }
+  qrModel->Delete();
+
+  return testStatus;
+}
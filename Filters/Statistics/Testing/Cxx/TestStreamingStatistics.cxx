@@ -0,0 +1,436 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStreamingStatistics.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME TestStreamingStatistics.cxx -- Learns statistics of a table in chunks
+//
+// .SECTION Description
+// A source which produces the requested piece of the rows of a table is
+// streamed through vtkStreamingStatistics in chunks, and the models of the
+// descriptive, correlative, multi-correlative, PCA, and contingency statistics
+// are compared to those learned from the whole table at once. Contingency
+// tables are also aggregated from tables pushed one after the other.
+
+#include "vtkContingencyStatistics.h"
+#include "vtkCorrelativeStatistics.h"
+#include "vtkDescriptiveStatistics.h"
+#include "vtkDoubleArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiCorrelativeStatistics.h"
+#include "vtkObjectFactory.h"
+#include "vtkPCAStatistics.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStreamingStatistics.h"
+#include "vtkTable.h"
+#include "vtkTableAlgorithm.h"
+
+#include <cmath>
+
+//=============================================================================
+// Produces the requested piece of a table of NumberOfRows rows, whose values
+// only depend on the index of the row
+class vtkChunkedTableSource : public vtkTableAlgorithm
+{
+public:
+  static vtkChunkedTableSource* New();
+  vtkTypeMacro(vtkChunkedTableSource, vtkTableAlgorithm);
+
+  vtkSetMacro(NumberOfRows, vtkIdType);
+  vtkGetMacro(NumberOfRows, vtkIdType);
+  vtkGetMacro(NumberOfExecutions, int);
+  vtkGetMacro(LargestPiece, vtkIdType);
+
+protected:
+  vtkChunkedTableSource()
+    {
+    this->SetNumberOfInputPorts( 0 );
+    this->NumberOfRows = 0;
+    this->NumberOfExecutions = 0;
+    this->LargestPiece = 0;
+    }
+
+  virtual int RequestInformation( vtkInformation*,
+                                  vtkInformationVector**,
+                                  vtkInformationVector* outputVector )
+    {
+    outputVector->GetInformationObject( 0 )->Set( CAN_HANDLE_PIECE_REQUEST(), 1 );
+    return 1;
+    }
+
+  virtual int RequestData( vtkInformation*,
+                           vtkInformationVector**,
+                           vtkInformationVector* outputVector )
+    {
+    vtkInformation* outInfo = outputVector->GetInformationObject( 0 );
+    vtkTable* output = vtkTable::GetData( outInfo );
+    int piece = outInfo->Get( vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER() );
+    int numPieces = outInfo->Get( vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES() );
+    vtkIdType begin = ( this->NumberOfRows * piece ) / numPieces;
+    vtkIdType end = ( this->NumberOfRows * ( piece + 1 ) ) / numPieces;
+
+    const char* doubleNames[] = { "Normal A", "Normal B", "Uniform C" };
+    vtkDoubleArray* doubleCols[3];
+    for ( int c = 0; c < 3; ++ c )
+      {
+      doubleCols[c] = vtkDoubleArray::New();
+      doubleCols[c]->SetName( doubleNames[c] );
+      doubleCols[c]->SetNumberOfTuples( end - begin );
+      output->AddColumn( doubleCols[c] );
+      doubleCols[c]->Delete();
+      }
+    vtkIntArray* catX = vtkIntArray::New();
+    catX->SetName( "Category X" );
+    catX->SetNumberOfTuples( end - begin );
+    output->AddColumn( catX );
+    catX->Delete();
+    vtkIntArray* catY = vtkIntArray::New();
+    catY->SetName( "Category Y" );
+    catY->SetNumberOfTuples( end - begin );
+    output->AddColumn( catY );
+    catY->Delete();
+
+    for ( vtkIdType r = begin; r < end; ++ r )
+      {
+      // Values far from 0 with a small spread challenge the stability of updates
+      double u1 = ( Hash( r, 1 ) + .5 ) / 4294967296.;
+      double u2 = ( Hash( r, 2 ) + .5 ) / 4294967296.;
+      double g1 = sqrt( -2. * log( u1 ) ) * cos( 2. * vtkMath::Pi() * u2 );
+      double g2 = sqrt( -2. * log( u1 ) ) * sin( 2. * vtkMath::Pi() * u2 );
+      doubleCols[0]->SetValue( r - begin, 1.e6 + g1 );
+      doubleCols[1]->SetValue( r - begin, 3. - .5 * g1 + g2 );
+      doubleCols[2]->SetValue( r - begin, ( Hash( r, 3 ) + .5 ) / 4294967296. );
+      catX->SetValue( r - begin, Hash( r, 4 ) % 5 );
+      catY->SetValue( r - begin, ( Hash( r, 4 ) % 5 + Hash( r, 5 ) % 3 ) % 7 );
+      }
+
+    ++ this->NumberOfExecutions;
+    if ( end - begin > this->LargestPiece )
+      {
+      this->LargestPiece = end - begin;
+      }
+
+    return 1;
+    }
+
+  static unsigned int Hash( vtkIdType r, unsigned int seed )
+    {
+    unsigned int h = static_cast<unsigned int>( r ) * 2654435761u ^ ( seed * 0x9e3779b9u );
+    h ^= h >> 15;
+    h *= 2246822519u;
+    h ^= h >> 13;
+    h *= 3266489917u;
+    h ^= h >> 16;
+    return h;
+    }
+
+  vtkIdType NumberOfRows;
+  int NumberOfExecutions;
+  vtkIdType LargestPiece;
+
+private:
+  vtkChunkedTableSource(const vtkChunkedTableSource&); // Not implemented
+  void operator=(const vtkChunkedTableSource&); // Not implemented
+};
+
+vtkStandardNewMacro(vtkChunkedTableSource);
+
+//=============================================================================
+// Compare all blocks of two models, numbers within a relative tolerance
+static int CompareModels( const char* name,
+                          vtkMultiBlockDataSet* reference,
+                          vtkMultiBlockDataSet* model,
+                          double relTol )
+{
+  if ( ! reference || ! model
+       || reference->GetNumberOfBlocks() != model->GetNumberOfBlocks() )
+    {
+    vtkGenericWarningMacro( << name << ": models have different numbers of blocks." );
+    return 1;
+    }
+
+  for ( unsigned int b = 0; b < reference->GetNumberOfBlocks(); ++ b )
+    {
+    vtkTable* refTab = vtkTable::SafeDownCast( reference->GetBlock( b ) );
+    vtkTable* tab = vtkTable::SafeDownCast( model->GetBlock( b ) );
+    if ( ! refTab || ! tab
+         || refTab->GetNumberOfRows() != tab->GetNumberOfRows()
+         || refTab->GetNumberOfColumns() != tab->GetNumberOfColumns() )
+      {
+      vtkGenericWarningMacro( << name << ": block " << b << " differs in size." );
+      return 1;
+      }
+
+    for ( vtkIdType c = 0; c < refTab->GetNumberOfColumns(); ++ c )
+      {
+      for ( vtkIdType r = 0; r < refTab->GetNumberOfRows(); ++ r )
+        {
+        vtkVariant refVal = refTab->GetValue( r, c );
+        vtkVariant val = tab->GetValue( r, c );
+        bool match;
+        if ( refVal.IsString() )
+          {
+          match = ( refVal.ToString() == val.ToString() );
+          }
+        else
+          {
+          double x = refVal.ToDouble();
+          double y = val.ToDouble();
+          match = ( x == y ) || fabs( x - y ) <= relTol * ( fabs( x ) + fabs( y ) );
+          }
+        if ( ! match )
+          {
+          vtkGenericWarningMacro( << name << ": "
+                                  << refTab->GetColumnName( c )
+                                  << " of row " << r
+                                  << " of block " << b
+                                  << " is " << val.ToString()
+                                  << " instead of " << refVal.ToString() << "." );
+          return 1;
+          }
+        }
+      }
+    }
+
+  return 0;
+}
+
+//=============================================================================
+// Learn the whole table at once, then in chunks, and compare both models
+static int CheckStreaming( const char* name,
+                           vtkStatisticsAlgorithm* algorithm,
+                           vtkIdType nRows,
+                           int nChunks,
+                           double relTol )
+{
+  algorithm->SetLearnOption( true );
+  algorithm->SetDeriveOption( true );
+  algorithm->SetAssessOption( false );
+  algorithm->SetTestOption( false );
+
+  vtkChunkedTableSource* wholeSource = vtkChunkedTableSource::New();
+  wholeSource->SetNumberOfRows( nRows );
+  algorithm->SetInputConnection( wholeSource->GetOutputPort() );
+  algorithm->Update();
+  vtkMultiBlockDataSet* reference = vtkMultiBlockDataSet::New();
+  reference->DeepCopy( algorithm->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) );
+  algorithm->SetInputConnection( 0 );
+  wholeSource->Delete();
+
+  vtkChunkedTableSource* source = vtkChunkedTableSource::New();
+  source->SetNumberOfRows( nRows );
+  vtkStreamingStatistics* ss = vtkStreamingStatistics::New();
+  ss->SetStatisticsAlgorithm( algorithm );
+  ss->SetNumberOfChunks( nChunks );
+  ss->SetInputConnection( source->GetOutputPort() );
+
+  int testStatus = 0;
+
+  // Updating twice must not aggregate the data twice
+  for ( int pass = 0; pass < 2; ++ pass )
+    {
+    source->Modified();
+    ss->Update();
+    vtkMultiBlockDataSet* model = vtkMultiBlockDataSet::SafeDownCast( ss->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) );
+    testStatus += CompareModels( name, reference, model, relTol );
+    }
+
+  cout << "## "
+       << name
+       << ": "
+       << nRows
+       << " rows learned in "
+       << source->GetNumberOfExecutions()
+       << " chunks of at most "
+       << source->GetLargestPiece()
+       << " rows.\n";
+
+  if ( source->GetNumberOfExecutions() != 2 * nChunks
+       || source->GetLargestPiece() > nRows / nChunks + 1 )
+    {
+    vtkGenericWarningMacro( << name << ": the table was not requested in "
+                            << nChunks << " chunks." );
+    ++ testStatus;
+    }
+
+  ss->Delete();
+  source->Delete();
+  reference->Delete();
+
+  return testStatus;
+}
+
+//=============================================================================
+int TestStreamingStatistics( int, char *[] )
+{
+  int testStatus = 0;
+  const vtkIdType nRows = 100003;
+  const int nChunks = 7;
+
+  vtkDescriptiveStatistics* ds = vtkDescriptiveStatistics::New();
+  ds->AddColumn( "Normal A" );
+  ds->AddColumn( "Normal B" );
+  ds->AddColumn( "Uniform C" );
+  testStatus += CheckStreaming( "Descriptive statistics", ds, nRows, nChunks, 1.e-8 );
+  ds->Delete();
+
+  vtkCorrelativeStatistics* cs = vtkCorrelativeStatistics::New();
+  cs->AddColumnPair( "Normal A", "Normal B" );
+  cs->AddColumnPair( "Normal B", "Uniform C" );
+  testStatus += CheckStreaming( "Correlative statistics", cs, nRows, nChunks, 1.e-8 );
+  cs->Delete();
+
+  // Three variables, so that pairs of variables are not in triangular order
+  vtkMultiCorrelativeStatistics* mcs = vtkMultiCorrelativeStatistics::New();
+  mcs->SetColumnStatus( "Normal A", 1 );
+  mcs->SetColumnStatus( "Normal B", 1 );
+  mcs->SetColumnStatus( "Uniform C", 1 );
+  mcs->RequestSelectedColumns();
+  testStatus += CheckStreaming( "Multi-correlative statistics", mcs, nRows, nChunks, 1.e-8 );
+  mcs->Delete();
+
+  vtkPCAStatistics* pcas = vtkPCAStatistics::New();
+  pcas->SetColumnStatus( "Normal A", 1 );
+  pcas->SetColumnStatus( "Normal B", 1 );
+  pcas->SetColumnStatus( "Uniform C", 1 );
+  pcas->RequestSelectedColumns();
+  testStatus += CheckStreaming( "PCA statistics", pcas, nRows, nChunks, 1.e-6 );
+  pcas->Delete();
+
+  vtkContingencyStatistics* cts = vtkContingencyStatistics::New();
+  cts->AddColumnPair( "Category X", "Category Y" );
+  cts->AddColumnPair( "Category X", "Normal A" );
+  testStatus += CheckStreaming( "Contingency statistics", cts, 20011, nChunks, 1.e-10 );
+
+  // Push two tables whose (x,y) realizations partly overlap, and with
+  // the pairs of variables in a different order, one after the other
+  vtkChunkedTableSource* source = vtkChunkedTableSource::New();
+  source->SetNumberOfRows( 1000 );
+  source->Update();
+  vtkTable* table = source->GetOutput();
+  vtkTable* firstHalf = vtkTable::New();
+  vtkTable* secondHalf = vtkTable::New();
+  for ( vtkIdType c = 0; c < table->GetNumberOfColumns(); ++ c )
+    {
+    vtkAbstractArray* col = table->GetColumn( c );
+    vtkAbstractArray* first = col->NewInstance();
+    vtkAbstractArray* second = col->NewInstance();
+    first->SetName( col->GetName() );
+    second->SetName( col->GetName() );
+    for ( vtkIdType r = 0; r < 1000; ++ r )
+      {
+      ( r < 400 ? first : second )->InsertNextTuple( r, col );
+      }
+    firstHalf->AddColumn( first );
+    secondHalf->AddColumn( second );
+    first->Delete();
+    second->Delete();
+    }
+
+  // The streaming filter left its model as the input model of the algorithm
+  cts->SetInputData( vtkStatisticsAlgorithm::INPUT_MODEL, 0 );
+  cts->SetInputData( table );
+  cts->ResetRequests();
+  cts->AddColumnPair( "Category X", "Category Y" );
+  cts->AddColumnPair( "Category Y", "Uniform C" );
+  cts->Update();
+  vtkMultiBlockDataSet* reference = vtkMultiBlockDataSet::New();
+  reference->DeepCopy( cts->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) );
+
+  // One of the pairs is only learned from the second table on, so that the
+  // cardinalities of the pairs differ: do not derive the model
+  vtkStreamingStatistics* ss = vtkStreamingStatistics::New();
+  ss->SetStatisticsAlgorithm( cts );
+  cts->SetDeriveOption( false );
+  cts->ResetRequests();
+  cts->AddColumnPair( "Category Y", "Uniform C" );
+  ss->SetInputData( firstHalf );
+  ss->Update();
+  cts->AddColumnPair( "Category X", "Category Y" );
+  ss->SetInputData( secondHalf );
+  ss->Update();
+
+  // The summary of the pushed model lists the pairs in order of appearance
+  vtkMultiBlockDataSet* pushed = vtkMultiBlockDataSet::SafeDownCast( ss->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) );
+  vtkTable* summary = vtkTable::SafeDownCast( pushed->GetBlock( 0 ) );
+  vtkTable* contingency = vtkTable::SafeDownCast( pushed->GetBlock( 1 ) );
+  vtkIdType total = 0;
+  for ( vtkIdType r = 1; r < contingency->GetNumberOfRows(); ++ r )
+    {
+    vtkIdType key = contingency->GetValueByName( r, "Key" ).ToTypeInt64();
+    if ( summary->GetValueByName( key, "Variable X" ).ToString() == "Category X" )
+      {
+      total += contingency->GetValueByName( r, "Cardinality" ).ToTypeInt64();
+      }
+    }
+  if ( summary->GetNumberOfRows() != 2
+       || summary->GetValueByName( 0, "Variable X" ).ToString() != "Category Y"
+       || total != 600 )
+    {
+    vtkGenericWarningMacro( "Incorrect contingency table aggregated from pushed tables." );
+    ++ testStatus;
+    }
+
+  // Pushing the whole table adds to the counts of both pairs
+  ss->SetInputData( table );
+  ss->Update();
+  pushed = vtkMultiBlockDataSet::SafeDownCast( ss->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) );
+  contingency = vtkTable::SafeDownCast( pushed->GetBlock( 1 ) );
+  vtkTable* refContingency = vtkTable::SafeDownCast( reference->GetBlock( 1 ) );
+  vtkIdType refTotal = 0;
+  total = 0;
+  for ( vtkIdType r = 1; r < refContingency->GetNumberOfRows(); ++ r )
+    {
+    refTotal += refContingency->GetValueByName( r, "Cardinality" ).ToTypeInt64();
+    }
+  for ( vtkIdType r = 1; r < contingency->GetNumberOfRows(); ++ r )
+    {
+    total += contingency->GetValueByName( r, "Cardinality" ).ToTypeInt64();
+    }
+  cout << "## Contingency statistics: "
+       << total
+       << " observations of pairs pushed, "
+       << refTotal
+       << " learned at once.\n";
+  if ( refTotal != 2000 || total != 600 + 1000 + 2000 )
+    {
+    vtkGenericWarningMacro( "Incorrect cardinalities aggregated from pushed tables." );
+    ++ testStatus;
+    }
+
+  // Both halves pushed with both pairs requested yield the model of the table
+  cts->SetDeriveOption( true );
+  vtkStreamingStatistics* ss2 = vtkStreamingStatistics::New();
+  ss2->SetStatisticsAlgorithm( cts );
+  ss2->SetInputData( firstHalf );
+  ss2->Update();
+  ss2->SetInputData( secondHalf );
+  ss2->Update();
+  testStatus += CompareModels( "Pushed contingency statistics",
+                               reference,
+                               vtkMultiBlockDataSet::SafeDownCast( ss2->GetOutputDataObject( vtkStatisticsAlgorithm::OUTPUT_MODEL ) ),
+                               1.e-10 );
+
+  ss2->Delete();
+  ss->Delete();
+  reference->Delete();
+  firstHalf->Delete();
+  secondHalf->Delete();
+  source->Delete();
+  cts->Delete();
+
+  return testStatus;
+}
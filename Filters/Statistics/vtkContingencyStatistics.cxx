@@ -23,6 +23,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkContingencyStatistics.h"
 #include "vtkStatisticsAlgorithmPrivate.h"
 
+#include "vtkDataObjectCollection.h"
 #include "vtkDoubleArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
@@ -68,6 +69,165 @@ void vtkContingencyStatistics::PrintSelf( ostream &os, vtkIndent indent )
   this->Superclass::PrintSelf( os, indent );
 }
 
+// ----------------------------------------------------------------------
+void vtkContingencyStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
+                                          vtkMultiBlockDataSet* outMeta )
+{
+  if ( ! outMeta )
+    {
+    return;
+    }
+
+  // Aggregated pairs of variables, in order of first appearance, and
+  // aggregated counts of (x,y) realizations for each of them
+  typedef vtksys_stl::pair<vtkStdString,vtkStdString> StringPair;
+  typedef vtksys_stl::map<StringPair,vtkIdType> PairCounts;
+  vtksys_stl::vector<StringPair> varPairs;
+  vtksys_stl::map<StringPair,vtkIdType> varPairIndex;
+  vtksys_stl::vector<PairCounts> counts;
+
+  vtkCollectionSimpleIterator it;
+  inMetaColl->InitTraversal( it );
+  vtkDataObject *inMetaDO;
+  while ( ( inMetaDO = inMetaColl->GetNextDataObject( it ) ) )
+    {
+    // Verify that the current model is indeed contained in a multiblock data set
+    vtkMultiBlockDataSet* inMeta = vtkMultiBlockDataSet::SafeDownCast( inMetaDO );
+    if ( ! inMeta )
+      {
+      return;
+      }
+
+    // Models without any primary table contain no statistics
+    if ( inMeta->GetNumberOfBlocks() < 2 )
+      {
+      continue;
+      }
+
+    // Verify that the current summary and contingency tables are indeed contained in tables
+    vtkTable* summaryTab = vtkTable::SafeDownCast( inMeta->GetBlock( 0 ) );
+    vtkTable* contingencyTab = vtkTable::SafeDownCast( inMeta->GetBlock( 1 ) );
+    if ( ! summaryTab || ! contingencyTab )
+      {
+      return;
+      }
+
+    vtkStringArray* varX = vtkStringArray::SafeDownCast( summaryTab->GetColumnByName( "Variable X" ) );
+    vtkStringArray* varY = vtkStringArray::SafeDownCast( summaryTab->GetColumnByName( "Variable Y" ) );
+    vtkIdTypeArray* keys = vtkIdTypeArray::SafeDownCast( contingencyTab->GetColumnByName( "Key" ) );
+    vtkStringArray* valsX = vtkStringArray::SafeDownCast( contingencyTab->GetColumnByName( "x" ) );
+    vtkStringArray* valsY = vtkStringArray::SafeDownCast( contingencyTab->GetColumnByName( "y" ) );
+    vtkIdTypeArray* cards = vtkIdTypeArray::SafeDownCast( contingencyTab->GetColumnByName( "Cardinality" ) );
+    if ( ! varX || ! varY || ! keys || ! valsX || ! valsY || ! cards )
+      {
+      vtkWarningMacro( "Model does not contain a contingency table. Cannot aggregate it." );
+      return;
+      }
+
+    // Map the keys of the current model to the aggregated pairs of variables
+    vtkIdType nRowSumm = summaryTab->GetNumberOfRows();
+    vtksys_stl::vector<vtkIdType> keyToIndex( nRowSumm );
+    for ( vtkIdType r = 0; r < nRowSumm; ++ r )
+      {
+      StringPair varPair( varX->GetValue( r ), varY->GetValue( r ) );
+      vtksys_stl::map<StringPair,vtkIdType>::iterator vit = varPairIndex.find( varPair );
+      if ( vit == varPairIndex.end() )
+        {
+        vit = varPairIndex.insert( vtksys_stl::make_pair( varPair, static_cast<vtkIdType>( varPairs.size() ) ) ).first;
+        varPairs.push_back( varPair );
+        counts.push_back( PairCounts() );
+        }
+      keyToIndex[r] = vit->second;
+      }
+
+    // Add the counts of the current model, skipping the cardinality row whose key is -1
+    vtkIdType nRowCont = contingencyTab->GetNumberOfRows();
+    for ( vtkIdType r = 0; r < nRowCont; ++ r )
+      {
+      vtkIdType key = keys->GetValue( r );
+      if ( key < 0 || key >= nRowSumm )
+        {
+        continue;
+        }
+
+      counts[keyToIndex[key]][StringPair( valsX->GetValue( r ), valsY->GetValue( r ) )]
+        += cards->GetValue( r );
+      }
+    }
+
+  // Summary table: assigns a unique key to each (variable X,variable Y) pair
+  vtkTable* summaryTab = vtkTable::New();
+
+  vtkStringArray* stringCol = vtkStringArray::New();
+  stringCol->SetName( "Variable X" );
+  summaryTab->AddColumn( stringCol );
+  stringCol->Delete();
+
+  stringCol = vtkStringArray::New();
+  stringCol->SetName( "Variable Y" );
+  summaryTab->AddColumn( stringCol );
+  stringCol->Delete();
+
+  // The actual contingency table, indexed by the key of the summary
+  vtkTable* contingencyTab = vtkTable::New();
+
+  vtkIdTypeArray* keyCol = vtkIdTypeArray::New();
+  keyCol->SetName( "Key" );
+  contingencyTab->AddColumn( keyCol );
+  keyCol->Delete();
+
+  vtkStringArray* xCol = vtkStringArray::New();
+  xCol->SetName( "x" );
+  contingencyTab->AddColumn( xCol );
+  xCol->Delete();
+
+  vtkStringArray* yCol = vtkStringArray::New();
+  yCol->SetName( "y" );
+  contingencyTab->AddColumn( yCol );
+  yCol->Delete();
+
+  vtkIdTypeArray* cardCol = vtkIdTypeArray::New();
+  cardCol->SetName( "Cardinality" );
+  contingencyTab->AddColumn( cardCol );
+  cardCol->Delete();
+
+  // First row is the (invalid) cardinality, as in Learn
+  keyCol->InsertNextValue( -1 );
+  xCol->InsertNextValue( "" );
+  yCol->InsertNextValue( "" );
+  cardCol->InsertNextValue( -1 );
+
+  for ( vtkIdType k = 0; k < static_cast<vtkIdType>( varPairs.size() ); ++ k )
+    {
+    vtkVariantArray* row2 = vtkVariantArray::New();
+    row2->SetNumberOfValues( 2 );
+    row2->SetValue( 0, varPairs[k].first );
+    row2->SetValue( 1, varPairs[k].second );
+    summaryTab->InsertNextRow( row2 );
+    row2->Delete();
+
+    // Realizations are stored in the same (x,y) order as in Learn
+    for ( PairCounts::iterator cit = counts[k].begin(); cit != counts[k].end(); ++ cit )
+      {
+      keyCol->InsertNextValue( k );
+      xCol->InsertNextValue( cit->first.first );
+      yCol->InsertNextValue( cit->first.second );
+      cardCol->InsertNextValue( cit->second );
+      }
+    }
+
+  // Finally set blocks of the aggregated model
+  outMeta->SetNumberOfBlocks( 2 );
+  outMeta->GetMetaData( static_cast<unsigned>( 0 ) )->Set( vtkCompositeDataSet::NAME(), "Summary" );
+  outMeta->SetBlock( 0, summaryTab );
+  outMeta->GetMetaData( static_cast<unsigned>( 1 ) )->Set( vtkCompositeDataSet::NAME(), "Contingency Table" );
+  outMeta->SetBlock( 1, contingencyTab );
+
+  // Clean up
+  summaryTab->Delete();
+  contingencyTab->Delete();
+}
+
 // ----------------------------------------------------------------------
 void vtkContingencyStatistics::Learn( vtkTable* inData,
                                       vtkTable* vtkNotUsed( inParameters ),
@@ -58,10 +58,13 @@ public:
   static vtkContingencyStatistics* New();
 
   // Description:
-  // Given a collection of models, calculate aggregate model
-  // NB: not implemented
+  // Given a collection of models, calculate aggregate model.
+  // Contingency tables are matched by the names of their pair of variables
+  // and the counts of identical (x,y) realizations are summed, so that
+  // models need not have the same summary table. Only the learned
+  // columns are kept: derived statistics must be derived anew.
   virtual void Aggregate( vtkDataObjectCollection*,
-                          vtkMultiBlockDataSet* ) { return; };
+                          vtkMultiBlockDataSet* );
 
 protected:
   vtkContingencyStatistics();
@@ -71,26 +71,34 @@ void vtkCorrelativeStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
     return;
     }
 
-  // Get hold of the first model (data object) in the collection
+  // Get hold of the first model (data object) in the collection which
+  // contains statistics: models learned from empty pieces of the data,
+  // or empty models used to start a stream, have no rows and are skipped
   vtkCollectionSimpleIterator it;
   inMetaColl->InitTraversal( it );
-  vtkDataObject *inMetaDO = inMetaColl->GetNextDataObject( it );
-
-  // Verify that the first input model is indeed contained in a multiblock data set
-  vtkMultiBlockDataSet* inMeta = vtkMultiBlockDataSet::SafeDownCast( inMetaDO );
-  if ( ! inMeta )
+  vtkDataObject *inMetaDO;
+  vtkMultiBlockDataSet* inMeta = 0;
+  vtkTable* primaryTab = 0;
+  vtkIdType nRow = 0;
+  while ( ! nRow && ( inMetaDO = inMetaColl->GetNextDataObject( it ) ) )
     {
-    return;
-    }
+    // Verify that the first input model is indeed contained in a multiblock data set
+    inMeta = vtkMultiBlockDataSet::SafeDownCast( inMetaDO );
+    if ( ! inMeta )
+      {
+      return;
+      }
 
-  // Verify that the first primary statistics are indeed contained in a table
-  vtkTable* primaryTab = vtkTable::SafeDownCast( inMeta->GetBlock( 0 ) );
-  if ( ! primaryTab )
-    {
-    return;
+    // Verify that the first primary statistics are indeed contained in a table
+    primaryTab = vtkTable::SafeDownCast( inMeta->GetBlock( 0 ) );
+    if ( ! primaryTab )
+      {
+      return;
+      }
+
+    nRow = primaryTab->GetNumberOfRows();
     }
 
-  vtkIdType nRow = primaryTab->GetNumberOfRows();
   if ( ! nRow )
     {
     // No statistics were calculated.
@@ -122,6 +130,12 @@ void vtkCorrelativeStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
       return;
       }
 
+    if ( ! primaryTab->GetNumberOfRows() )
+      {
+      // No statistics were calculated in this model
+      continue;
+      }
+
     if ( primaryTab->GetNumberOfRows() != nRow )
       {
       // Models do not match
@@ -144,7 +158,7 @@ void vtkCorrelativeStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
         }
 
       // Get aggregated statistics
-      int n = aggregatedTab->GetValueByName( r, "Cardinality" ).ToInt();
+      vtkIdType n = aggregatedTab->GetValueByName( r, "Cardinality" ).ToTypeInt64();
       double meanX = aggregatedTab->GetValueByName( r, "Mean X" ).ToDouble();
       double meanY = aggregatedTab->GetValueByName( r, "Mean Y" ).ToDouble();
       double M2X = aggregatedTab->GetValueByName( r, "M2 X" ).ToDouble();
@@ -152,15 +166,22 @@ void vtkCorrelativeStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
       double MXY = aggregatedTab->GetValueByName( r, "M XY" ).ToDouble();
 
       // Get current model statistics
-      int n_c = primaryTab->GetValueByName( r, "Cardinality" ).ToInt();
+      vtkIdType n_c = primaryTab->GetValueByName( r, "Cardinality" ).ToTypeInt64();
       double meanX_c = primaryTab->GetValueByName( r, "Mean X" ).ToDouble();
       double meanY_c = primaryTab->GetValueByName( r, "Mean Y" ).ToDouble();
       double M2X_c = primaryTab->GetValueByName( r, "M2 X" ).ToDouble();
       double M2Y_c = primaryTab->GetValueByName( r, "M2 Y" ).ToDouble();
       double MXY_c = primaryTab->GetValueByName( r, "M XY" ).ToDouble();
 
+      // A pair without observations in the current model leaves the
+      // aggregated statistics unchanged
+      if ( ! n_c )
+        {
+        continue;
+        }
+
       // Update global statics
-      int N = n + n_c;
+      vtkIdType N = n + n_c;
 
       double invN = 1. / static_cast<double>( N );
 
@@ -170,7 +191,10 @@ void vtkCorrelativeStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
       double deltaY = meanY_c - meanY;
       double deltaY_sur_N = deltaY * invN;
 
-      int prod_n = n * n_c;
+      // Pairwise update of the centered moments. The product of cardinalities
+      // is calculated in double precision as it overflows integers for large
+      // data sets
+      double prod_n = static_cast<double>( n ) * static_cast<double>( n_c );
 
       M2X += M2X_c
         + prod_n * deltaX * deltaX_sur_N;
@@ -181,9 +205,9 @@ void vtkCorrelativeStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
       MXY += MXY_c
         + prod_n * deltaX * deltaY_sur_N;
 
-      meanX += n_c * deltaX_sur_N;
+      meanX += static_cast<double>( n_c ) * deltaX_sur_N;
 
-      meanY += n_c * deltaY_sur_N;
+      meanY += static_cast<double>( n_c ) * deltaY_sur_N;
 
       // Store updated model
       aggregatedTab->SetValueByName( r, "Cardinality", N );
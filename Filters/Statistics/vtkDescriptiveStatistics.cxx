@@ -77,26 +77,34 @@ void vtkDescriptiveStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
     return;
     }
 
-  // Get hold of the first model (data object) in the collection
+  // Get hold of the first model (data object) in the collection which
+  // contains statistics: models learned from empty pieces of the data,
+  // or empty models used to start a stream, have no rows and are skipped
   vtkCollectionSimpleIterator it;
   inMetaColl->InitTraversal( it );
-  vtkDataObject *inMetaDO = inMetaColl->GetNextDataObject( it );
-
-  // Verify that the first input model is indeed contained in a multiblock data set
-  vtkMultiBlockDataSet* inMeta = vtkMultiBlockDataSet::SafeDownCast( inMetaDO );
-  if ( ! inMeta )
+  vtkDataObject *inMetaDO;
+  vtkMultiBlockDataSet* inMeta = 0;
+  vtkTable* primaryTab = 0;
+  vtkIdType nRow = 0;
+  while ( ! nRow && ( inMetaDO = inMetaColl->GetNextDataObject( it ) ) )
     {
-    return;
-    }
+    // Verify that the first input model is indeed contained in a multiblock data set
+    inMeta = vtkMultiBlockDataSet::SafeDownCast( inMetaDO );
+    if ( ! inMeta )
+      {
+      return;
+      }
 
-  // Verify that the first primary statistics are indeed contained in a table
-  vtkTable* primaryTab = vtkTable::SafeDownCast( inMeta->GetBlock( 0 ) );
-  if ( ! primaryTab )
-    {
-    return;
+    // Verify that the first primary statistics are indeed contained in a table
+    primaryTab = vtkTable::SafeDownCast( inMeta->GetBlock( 0 ) );
+    if ( ! primaryTab )
+      {
+      return;
+      }
+
+    nRow = primaryTab->GetNumberOfRows();
     }
 
-  vtkIdType nRow = primaryTab->GetNumberOfRows();
   if ( ! nRow )
     {
     // No statistics were calculated.
@@ -128,6 +136,12 @@ void vtkDescriptiveStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
       return;
       }
 
+    if ( ! primaryTab->GetNumberOfRows() )
+      {
+      // No statistics were calculated in this model
+      continue;
+      }
+
     if ( primaryTab->GetNumberOfRows() != nRow )
       {
       // Models do not match
@@ -149,7 +163,7 @@ void vtkDescriptiveStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
         }
 
       // Get aggregated statistics
-      int n = aggregatedTab->GetValueByName( r, "Cardinality" ).ToInt();
+      vtkIdType n = aggregatedTab->GetValueByName( r, "Cardinality" ).ToTypeInt64();
       double min = aggregatedTab->GetValueByName( r, "Minimum" ).ToDouble();
       double max = aggregatedTab->GetValueByName( r, "Maximum" ).ToDouble();
       double mean = aggregatedTab->GetValueByName( r, "Mean" ).ToDouble();
@@ -158,7 +172,7 @@ void vtkDescriptiveStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
       double M4 = aggregatedTab->GetValueByName( r, "M4" ).ToDouble();
 
       // Get current model statistics
-      int n_c = primaryTab->GetValueByName( r, "Cardinality" ).ToInt();
+      vtkIdType n_c = primaryTab->GetValueByName( r, "Cardinality" ).ToTypeInt64();
       double min_c = primaryTab->GetValueByName( r, "Minimum" ).ToDouble();
       double max_c = primaryTab->GetValueByName( r, "Maximum" ).ToDouble();
       double mean_c = primaryTab->GetValueByName( r, "Mean" ).ToDouble();
@@ -166,40 +180,52 @@ void vtkDescriptiveStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
       double M3_c = primaryTab->GetValueByName( r, "M3" ).ToDouble();
       double M4_c = primaryTab->GetValueByName( r, "M4" ).ToDouble();
 
+      // A variable without observations in the current model leaves the
+      // aggregated statistics unchanged; the extrema of a variable without
+      // observations in the aggregated model are meaningless
+      if ( ! n_c )
+        {
+        continue;
+        }
+
       // Update global statics
-      int N = n + n_c;
+      vtkIdType N = n + n_c;
 
-      if ( min_c < min )
+      if ( min_c < min || ! n )
         {
         aggregatedTab->SetValueByName( r, "Minimum", min_c );
         }
 
-      if ( max_c > max )
+      if ( max_c > max || ! n )
         {
         aggregatedTab->SetValueByName( r, "Maximum", max_c );
         }
 
+      // Pairwise update of the centered moments, with cardinality products
+      // in double precision since n^2 does not fit an int past 46340
       double delta = mean_c - mean;
       double delta_sur_N = delta / static_cast<double>( N );
       double delta2_sur_N2 = delta_sur_N * delta_sur_N;
 
-      int n2 = n * n;
-      int n_c2 = n_c * n_c;
-      int prod_n = n * n_c;
+      double n_d = static_cast<double>( n );
+      double n_c_d = static_cast<double>( n_c );
+      double n2 = n_d * n_d;
+      double n_c2 = n_c_d * n_c_d;
+      double prod_n = n_d * n_c_d;
 
       M4 += M4_c
         + prod_n * ( n2 - prod_n + n_c2 ) * delta * delta_sur_N * delta2_sur_N2
         + 6. * ( n2 * M2_c + n_c2 * M2 ) * delta2_sur_N2
-        + 4. * ( n * M3_c - n_c * M3 ) * delta_sur_N;
+        + 4. * ( n_d * M3_c - n_c_d * M3 ) * delta_sur_N;
 
       M3 += M3_c
-        + prod_n * ( n - n_c ) * delta * delta2_sur_N2
-        + 3. * ( n * M2_c - n_c * M2 ) * delta_sur_N;
+        + prod_n * ( n_d - n_c_d ) * delta * delta2_sur_N2
+        + 3. * ( n_d * M2_c - n_c_d * M2 ) * delta_sur_N;
 
       M2 += M2_c
         + prod_n * delta * delta_sur_N;
 
-      mean += n_c * delta_sur_N;
+      mean += n_c_d * delta_sur_N;
 
       // Store updated model
       aggregatedTab->SetValueByName( r, "Cardinality", N );
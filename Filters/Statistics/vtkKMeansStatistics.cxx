@@ -13,11 +13,367 @@
 #include "vtkVariantArray.h"
 #include "vtkIntArray.h"
 #include "vtkIdTypeArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 
+#include <vtksys/stl/algorithm>
 #include <vtksys/stl/map>
 #include <vtksys/stl/vector>
 #include <vtksys/ios/sstream>
 
+#include <math.h>
+#include <string.h>
+
+// Number of rows read at once from the columns of the observations
+static const vtkIdType vtkKMeansStatisticsBlockSize = 256;
+
+// ----------------------------------------------------------------------
+// Copy one column of a block of rows into the row major block of coordinates
+template <class T>
+static void vtkKMeansStatisticsReadColumn( const T* column,
+                                          const vtkIdType* rows,
+                                          vtkIdType begin,
+                                          vtkIdType end,
+                                          int dimension,
+                                          int c,
+                                          double* block )
+{
+  double* x = block + c;
+  if ( rows )
+    {
+    for ( vtkIdType i = begin; i < end; ++ i, x += dimension )
+      {
+      *x = static_cast<double>( column[rows[i]] );
+      }
+    }
+  else
+    {
+    for ( vtkIdType i = begin; i < end; ++ i, x += dimension )
+      {
+      *x = static_cast<double>( column[i] );
+      }
+    }
+}
+
+// ----------------------------------------------------------------------
+// Read the coordinates of rows begin to end (of the given rows, if any)
+static void vtkKMeansStatisticsReadBlock( const vtksys_stl::vector<vtkDataArray*>& columns,
+                                         const vtkIdType* rows,
+                                         vtkIdType begin,
+                                         vtkIdType end,
+                                         double* block )
+{
+  int dimension = static_cast<int>( columns.size() );
+  for ( int c = 0; c < dimension; ++ c )
+    {
+    switch ( columns[c]->GetDataType() )
+      {
+      vtkTemplateMacro(
+        vtkKMeansStatisticsReadColumn( static_cast<VTK_TT*>( columns[c]->GetVoidPointer( 0 ) ),
+                                       rows, begin, end, dimension, c, block ) );
+      }
+    }
+}
+
+// ----------------------------------------------------------------------
+// Return the numeric columns of a table, or false when it has other columns
+static bool vtkKMeansStatisticsGetColumns( vtkTable* data,
+                                          vtksys_stl::vector<vtkDataArray*>& columns )
+{
+  columns.clear();
+  for ( vtkIdType c = 0; c < data->GetNumberOfColumns(); ++ c )
+    {
+    vtkDataArray* column = vtkDataArray::SafeDownCast( data->GetColumn( c ) );
+    if ( ! column
+         || column->GetNumberOfComponents() != 1
+         || column->GetDataType() == VTK_BIT )
+      {
+      columns.clear();
+      return false;
+      }
+    columns.push_back( column );
+    }
+  return ! columns.empty();
+}
+
+// ----------------------------------------------------------------------
+// The kernels compute squared Euclidean distances themselves, which is only
+// valid for the default distance functor
+static bool vtkKMeansStatisticsIsEuclidean( vtkKMeansDistanceFunctor* dfunc )
+{
+  return dfunc && ! strcmp( dfunc->GetClassName(), "vtkKMeansDistanceFunctor" );
+}
+
+// ----------------------------------------------------------------------
+// Find the nearest of centers begin to end of a row major array of centers
+static inline vtkIdType vtkKMeansStatisticsNearest( const double* x,
+                                                   const double* centers,
+                                                   vtkIdType begin,
+                                                   vtkIdType end,
+                                                   int dimension,
+                                                   double& minDistance )
+{
+  vtkIdType nearest = begin;
+  minDistance = VTK_DOUBLE_MAX;
+  const double* center = centers + begin * dimension;
+  for ( vtkIdType j = begin; j < end; ++ j, center += dimension )
+    {
+    double distance = 0.;
+    for ( int c = 0; c < dimension; ++ c )
+      {
+      double d = x[c] - center[c];
+      distance += d * d;
+      }
+    if ( distance < minDistance )
+      {
+      minDistance = distance;
+      nearest = j;
+      }
+    }
+  return nearest;
+}
+
+// ----------------------------------------------------------------------
+// Assign observations to their nearest cluster center in each run being
+// computed, and accumulate the cardinalities, errors and displacements of the
+// clusters, for use with vtkSMPTools::For. As partial results are kept per
+// thread, a new functor is used for each pass over the observations.
+class vtkKMeansStatisticsAssignFunctor
+{
+public:
+  // Inputs
+  vtksys_stl::vector<vtkDataArray*> Columns;
+  const vtkIdType* Rows; // Rows of a mini-batch, or 0 for all rows
+  const double* Centers; // Row major coordinates of all cluster centers
+  const double* PreviousCenters; // To count membership changes of a mini-batch, or 0
+  const vtkIdType* StartRunID;
+  const vtkIdType* EndRunID;
+  const int* ComputeRun;
+  int NumberOfRuns;
+  vtkIdType NumberOfCenters;
+  bool Accumulate;
+
+  // Outputs per observation and run, if not 0
+  vtkIdType* MemberIDs;
+  double* Distances;
+
+  // Outputs per cluster and run, once reduced
+  vtksys_stl::vector<double> Displacements;
+  vtksys_stl::vector<double> Errors;
+  vtksys_stl::vector<vtkIdType> Cardinalities;
+  vtksys_stl::vector<vtkIdType> Changes;
+
+  vtkKMeansStatisticsAssignFunctor()
+    {
+    this->Rows = 0;
+    this->Centers = 0;
+    this->PreviousCenters = 0;
+    this->StartRunID = 0;
+    this->EndRunID = 0;
+    this->ComputeRun = 0;
+    this->NumberOfRuns = 0;
+    this->NumberOfCenters = 0;
+    this->Accumulate = true;
+    this->MemberIDs = 0;
+    this->Distances = 0;
+    }
+
+  void Initialize()
+    {
+    Partial& p = this->Partials.Local();
+    size_t dimension = this->Columns.size();
+    p.Block.resize( vtkKMeansStatisticsBlockSize * dimension );
+    p.Displacements.assign( this->NumberOfCenters * dimension, 0. );
+    p.Errors.assign( this->NumberOfCenters, 0. );
+    p.Cardinalities.assign( this->NumberOfCenters, 0 );
+    p.Changes.assign( this->NumberOfRuns, 0 );
+    }
+
+  void operator()( vtkIdType begin, vtkIdType end )
+    {
+    Partial& p = this->Partials.Local();
+    int dimension = static_cast<int>( this->Columns.size() );
+    for ( vtkIdType b = begin; b < end; b += vtkKMeansStatisticsBlockSize )
+      {
+      vtkIdType e = b + vtkKMeansStatisticsBlockSize < end ? b + vtkKMeansStatisticsBlockSize : end;
+      vtkKMeansStatisticsReadBlock( this->Columns, this->Rows, b, e, &p.Block[0] );
+
+      const double* x = &p.Block[0];
+      for ( vtkIdType i = b; i < e; ++ i, x += dimension )
+        {
+        vtkIdType observation = this->Rows ? this->Rows[i] : i;
+        for ( int runID = 0; runID < this->NumberOfRuns; ++ runID )
+          {
+          vtkIdType runStartIdx = this->StartRunID[runID];
+          vtkIdType runEndIdx = this->EndRunID[runID];
+          if ( ! this->ComputeRun[runID] || runStartIdx >= runEndIdx )
+            {
+            continue;
+            }
+          double minDistance;
+          vtkIdType nearest = vtkKMeansStatisticsNearest( x, this->Centers, runStartIdx, runEndIdx,
+                                                          dimension, minDistance );
+          vtkIdType localMemberID = nearest - runStartIdx;
+
+          // Has the nearest cluster center changed since the last iteration?
+          if ( this->PreviousCenters )
+            {
+            double previousDistance;
+            if ( vtkKMeansStatisticsNearest( x, this->PreviousCenters, runStartIdx, runEndIdx,
+                                             dimension, previousDistance ) != nearest )
+              {
+              ++ p.Changes[runID];
+              }
+            }
+          if ( this->MemberIDs )
+            {
+            vtkIdType& memberID = this->MemberIDs[observation * this->NumberOfRuns + runID];
+            if ( memberID != localMemberID )
+              {
+              ++ p.Changes[runID];
+              memberID = localMemberID;
+              }
+            }
+          if ( this->Distances )
+            {
+            this->Distances[observation * this->NumberOfRuns + runID] = minDistance;
+            }
+
+          if ( this->Accumulate )
+            {
+            // Accumulate displacements from the center rather than coordinates,
+            // so that coordinates far from the origin do not lose precision
+            const double* center = this->Centers + nearest * dimension;
+            double* displacement = &p.Displacements[nearest * dimension];
+            for ( int c = 0; c < dimension; ++ c )
+              {
+              displacement[c] += x[c] - center[c];
+              }
+            p.Errors[nearest] += minDistance;
+            ++ p.Cardinalities[nearest];
+            }
+          }
+        }
+      }
+    }
+
+  void Reduce()
+    {
+    size_t dimension = this->Columns.size();
+    this->Displacements.assign( this->NumberOfCenters * dimension, 0. );
+    this->Errors.assign( this->NumberOfCenters, 0. );
+    this->Cardinalities.assign( this->NumberOfCenters, 0 );
+    this->Changes.assign( this->NumberOfRuns, 0 );
+    for ( vtkSMPThreadLocal<Partial>::iterator it = this->Partials.begin();
+          it != this->Partials.end(); ++ it )
+      {
+      for ( size_t i = 0; i < this->Displacements.size(); ++ i )
+        {
+        this->Displacements[i] += (*it).Displacements[i];
+        }
+      for ( vtkIdType j = 0; j < this->NumberOfCenters; ++ j )
+        {
+        this->Errors[j] += (*it).Errors[j];
+        this->Cardinalities[j] += (*it).Cardinalities[j];
+        }
+      for ( int r = 0; r < this->NumberOfRuns; ++ r )
+        {
+        this->Changes[r] += (*it).Changes[r];
+        }
+      }
+    }
+
+private:
+  struct Partial
+  {
+    vtksys_stl::vector<double> Block;
+    vtksys_stl::vector<double> Displacements;
+    vtksys_stl::vector<double> Errors;
+    vtksys_stl::vector<vtkIdType> Cardinalities;
+    vtksys_stl::vector<vtkIdType> Changes;
+  };
+  vtkSMPThreadLocal<Partial> Partials;
+};
+
+// ----------------------------------------------------------------------
+// Sum the squared distances of the observations to their nearest k-means++
+// seed, were each candidate seed added, for use with vtkSMPTools::For. With a
+// single candidate, the distances to the nearest seed are also updated.
+class vtkKMeansStatisticsSeedFunctor
+{
+public:
+  vtksys_stl::vector<vtkDataArray*> Columns;
+  const double* Candidates;
+  int NumberOfCandidates;
+  double* MinDistances;
+  vtksys_stl::vector<double> Potentials;
+
+  vtkKMeansStatisticsSeedFunctor()
+    {
+    this->Candidates = 0;
+    this->NumberOfCandidates = 0;
+    this->MinDistances = 0;
+    }
+
+  void Initialize()
+    {
+    Partial& p = this->Partials.Local();
+    p.Block.resize( vtkKMeansStatisticsBlockSize * this->Columns.size() );
+    p.Potentials.assign( this->NumberOfCandidates, 0. );
+    }
+
+  void operator()( vtkIdType begin, vtkIdType end )
+    {
+    Partial& p = this->Partials.Local();
+    int dimension = static_cast<int>( this->Columns.size() );
+    for ( vtkIdType b = begin; b < end; b += vtkKMeansStatisticsBlockSize )
+      {
+      vtkIdType e = b + vtkKMeansStatisticsBlockSize < end ? b + vtkKMeansStatisticsBlockSize : end;
+      vtkKMeansStatisticsReadBlock( this->Columns, 0, b, e, &p.Block[0] );
+      const double* x = &p.Block[0];
+      for ( vtkIdType i = b; i < e; ++ i, x += dimension )
+        {
+        for ( int t = 0; t < this->NumberOfCandidates; ++ t )
+          {
+          double distance;
+          vtkKMeansStatisticsNearest( x, this->Candidates, t, t + 1, dimension, distance );
+          if ( distance > this->MinDistances[i] )
+            {
+            distance = this->MinDistances[i];
+            }
+          p.Potentials[t] += distance;
+          if ( this->NumberOfCandidates == 1 )
+            {
+            this->MinDistances[i] = distance;
+            }
+          }
+        }
+      }
+    }
+
+  void Reduce()
+    {
+    this->Potentials.assign( this->NumberOfCandidates, 0. );
+    for ( vtkSMPThreadLocal<Partial>::iterator it = this->Partials.begin();
+          it != this->Partials.end(); ++ it )
+      {
+      for ( int t = 0; t < this->NumberOfCandidates; ++ t )
+        {
+        this->Potentials[t] += (*it).Potentials[t];
+        }
+      }
+    }
+
+private:
+  struct Partial
+  {
+    vtksys_stl::vector<double> Block;
+    vtksys_stl::vector<double> Potentials;
+  };
+  vtkSMPThreadLocal<Partial> Partials;
+};
+
 vtkStandardNewMacro(vtkKMeansStatistics);
 vtkCxxSetObjectMacro(vtkKMeansStatistics,DistanceFunctor,vtkKMeansDistanceFunctor);
 
@@ -33,6 +389,9 @@ vtkKMeansStatistics::vtkKMeansStatistics()
   this->SetKValuesArrayName( "K" );
   this->MaxNumIterations = 50;
   this->DistanceFunctor = vtkKMeansDistanceFunctor::New();
+  this->MiniBatchSize = 0;
+  this->InitializationMethod = FIRST_OBSERVATIONS;
+  this->RandomSeed = 1;
 }
 
 // ----------------------------------------------------------------------
@@ -54,6 +413,11 @@ void vtkKMeansStatistics::PrintSelf( ostream& os, vtkIndent indent )
   os << indent << "MaxNumIterations: " << this->MaxNumIterations << endl;
   os << indent << "Tolerance: " << this->Tolerance << endl;
   os << indent << "DistanceFunctor: " << this->DistanceFunctor << endl;
+  os << indent << "MiniBatchSize: " << this->MiniBatchSize << endl;
+  os << indent << "InitializationMethod: "
+     << ( this->InitializationMethod == KMEANS_PLUS_PLUS ? "k-means++" : "First observations" )
+     << endl;
+  os << indent << "RandomSeed: " << this->RandomSeed << endl;
 }
 
 
@@ -144,8 +508,14 @@ int vtkKMeansStatistics::InitializeDataAndClusterCenters(vtkTable* inParameters,
     {
     // otherwise create an initial set of cluster coords
     numRuns = 1;
-    numToAllocate = this->DefaultNumberOfClusters < inData->GetNumberOfRows() ?
-                    this->DefaultNumberOfClusters : inData->GetNumberOfRows();
+    vtkIdType numAvailable = inData->GetNumberOfRows();
+    if ( this->InitializationMethod == KMEANS_PLUS_PLUS )
+      {
+      // k-means++ seeds are drawn from the observations of all processes
+      numAvailable = this->GetTotalNumberOfObservations( numAvailable );
+      }
+    numToAllocate = this->DefaultNumberOfClusters < numAvailable ?
+                    this->DefaultNumberOfClusters : numAvailable;
     startRunID->InsertNextValue( 0 );
     endRunID->InsertNextValue( numToAllocate );
     numberOfClusters->SetName( this->KValuesArrayName );
@@ -200,6 +570,13 @@ void vtkKMeansStatistics::CreateInitialClusterCenters( vtkIdType numToAllocate,
     }
   reqIt = this->Internals->Requests.begin();
 
+  if ( this->InitializationMethod == KMEANS_PLUS_PLUS
+       && this->CreateKMeansPlusPlusClusterCenters( numToAllocate, numberOfClusters, inData,
+                                                    curClusterElements, newClusterElements ) )
+    {
+    return;
+    }
+
   for ( vtkIdType i = 0; i < numToAllocate; ++ i )
     {
     numberOfClusters->InsertNextValue( numToAllocate );
@@ -227,36 +604,198 @@ vtkIdType vtkKMeansStatistics::GetTotalNumberOfObservations( vtkIdType numObserv
 }
 
 // ----------------------------------------------------------------------
-void vtkKMeansStatistics::UpdateClusterCenters( vtkTable* newClusterElements,
-                                                vtkTable* curClusterElements,
-                                                vtkIdTypeArray* vtkNotUsed( numMembershipChanges ),
-                                                vtkIdTypeArray* numDataElementsInCluster,
-                                                vtkDoubleArray* vtkNotUsed( error ),
-                                                vtkIdTypeArray* startRunID,
-                                                vtkIdTypeArray* endRunID,
-                                                vtkIntArray* computeRun )
+void vtkKMeansStatistics::GetTotalPotentials( double* vtkNotUsed( potentials ),
+                                              int vtkNotUsed( numberOfCandidates ) )
+{
+}
+
+// ----------------------------------------------------------------------
+bool vtkKMeansStatistics::CreateKMeansPlusPlusClusterCenters( vtkIdType numToAllocate,
+                                                              vtkIdTypeArray* numberOfClusters,
+                                                              vtkTable* inData,
+                                                              vtkTable* curClusterElements,
+                                                              vtkTable* newClusterElements )
 {
-  for(vtkIdType runID = 0; runID < startRunID->GetNumberOfTuples(); runID++)
+  // The observations, in the order of the coordinates of the cluster centers
+  vtkTable* observations = vtkTable::New();
+  for ( vtkIdType c = 0; c < curClusterElements->GetNumberOfColumns(); ++ c )
+    {
+    vtkAbstractArray* column = inData->GetColumnByName( curClusterElements->GetColumnName( c ) );
+    if ( column )
+      {
+      observations->AddColumn( column );
+      }
+    }
+  vtksys_stl::vector<vtkDataArray*> columns;
+  if ( observations->GetNumberOfColumns() != curClusterElements->GetNumberOfColumns()
+       || ! vtkKMeansStatisticsGetColumns( observations, columns ) )
     {
-    if( computeRun->GetValue(runID) )
+    observations->Delete();
+    vtkWarningMacro( "k-means++ seeding requires numeric columns. "
+                     "The first observations are used as initial cluster centers instead." );
+    return false;
+    }
+
+  int dimension = static_cast<int>( columns.size() );
+  vtkIdType numObservations = inData->GetNumberOfRows();
+  bool euclidean = vtkKMeansStatisticsIsEuclidean( this->DistanceFunctor );
+  vtksys_stl::vector<double> seeds( numToAllocate * dimension );
+  vtksys_stl::vector<double> minDistances( numObservations, VTK_DOUBLE_MAX );
+  vtkVariantArray* seedRow = vtkVariantArray::New();
+  seedRow->SetNumberOfValues( dimension );
+
+  // As a single draw may well fall in an already seeded cluster, several
+  // candidates are drawn for each seed, and the one which most decreases the
+  // sum of the squared distances to the nearest seed is kept
+  int numTrials = 2 + static_cast<int>( log( static_cast<double>( numToAllocate > 1 ? numToAllocate : 1 ) ) );
+  vtksys_stl::vector<double> candidates( numTrials * dimension );
+
+  // All processes draw as many random numbers, so that they agree on the
+  // process whose candidate is chosen
+  vtkMinimalStandardRandomSequence* random = vtkMinimalStandardRandomSequence::New();
+  random->SetSeed( this->RandomSeed );
+
+  // The first seed is drawn uniformly, the others with a probability
+  // proportional to the squared distance to the nearest seed
+  double weight = static_cast<double>( numObservations );
+  for ( vtkIdType k = 0; k < numToAllocate; ++ k )
+    {
+    int numCandidates = k ? numTrials : 1;
+    for ( int t = 0; t < numCandidates; ++ t )
       {
-      for(vtkIdType i = startRunID->GetValue(runID); i < endRunID->GetValue(runID); ++ i)
+      double* candidate = &candidates[t * dimension];
+      random->Next();
+      double target = random->GetValue() * weight;
+      random->Next();
+      double u = random->GetValue();
+
+      vtkIdType row = numObservations - 1;
+      if ( k )
         {
-        if( numDataElementsInCluster->GetValue( i ) == 0 )
+        double sum = 0.;
+        for ( vtkIdType i = 0; i < numObservations; ++ i )
           {
-          vtkWarningMacro("cluster center " << i-startRunID->GetValue(runID)
-                                            << " in run " << runID
-                                            << " is degenerate. Attempting to perturb");
-          this->DistanceFunctor->PerturbElement(newClusterElements,
-                                                curClusterElements,
-                                                i,
-                                                startRunID->GetValue(runID),
-                                                endRunID->GetValue(runID),
-                                                0.8 ) ;
+          sum += minDistances[i];
+          if ( sum > target && minDistances[i] > 0. )
+            {
+            row = i;
+            break;
+            }
           }
         }
+      else if ( target < weight )
+        {
+        row = static_cast<vtkIdType>( target );
+        }
+      if ( row >= 0 )
+        {
+        vtkKMeansStatisticsReadBlock( columns, 0, row, row + 1, candidate );
+        }
+      else
+        {
+        vtksys_stl::fill( candidate, candidate + dimension, 0. );
+        }
+      this->SelectInitialClusterCenter( candidate, dimension, weight, u );
       }
+
+    // Keep the best candidate, then update the squared distances to the nearest seed
+    int best = 0;
+    for ( int pass = numCandidates > 1 ? 0 : 1; pass < 2; ++ pass )
+      {
+      const double* evaluated = pass ? &candidates[best * dimension] : &candidates[0];
+      int numEvaluated = pass ? 1 : numCandidates;
+      vtksys_stl::vector<double> potentials( numEvaluated, 0. );
+      if ( numObservations > 0 && euclidean )
+        {
+        vtkKMeansStatisticsSeedFunctor update;
+        update.Columns = columns;
+        update.Candidates = evaluated;
+        update.NumberOfCandidates = numEvaluated;
+        update.MinDistances = &minDistances[0];
+        vtkSMPTools::For( 0, numObservations, 16 * vtkKMeansStatisticsBlockSize, update );
+        potentials = update.Potentials;
+        }
+      else
+        {
+        for ( int t = 0; t < numEvaluated; ++ t )
+          {
+          for ( int c = 0; c < dimension; ++ c )
+            {
+            seedRow->SetValue( c, evaluated[t * dimension + c] );
+            }
+          for ( vtkIdType i = 0; i < numObservations; ++ i )
+            {
+            double distance;
+            (*this->DistanceFunctor)( distance, seedRow, observations->GetRow( i ) );
+            if ( distance > minDistances[i] )
+              {
+              distance = minDistances[i];
+              }
+            potentials[t] += distance;
+            if ( pass )
+              {
+              minDistances[i] = distance;
+              }
+            }
+          }
+        }
+
+      if ( pass )
+        {
+        weight = potentials[0];
+        }
+      else
+        {
+        this->GetTotalPotentials( &potentials[0], numEvaluated );
+        for ( int t = 1; t < numEvaluated; ++ t )
+          {
+          if ( potentials[t] < potentials[best] )
+            {
+            best = t;
+            }
+          }
+        }
+      }
+    vtksys_stl::copy( candidates.begin() + best * dimension,
+                      candidates.begin() + ( best + 1 ) * dimension,
+                      seeds.begin() + k * dimension );
+    }
+  random->Delete();
+
+  for ( vtkIdType k = 0; k < numToAllocate; ++ k )
+    {
+    numberOfClusters->InsertNextValue( numToAllocate );
+    for ( int c = 0; c < dimension; ++ c )
+      {
+      seedRow->SetValue( c, seeds[k * dimension + c] );
+      }
+    curClusterElements->InsertNextRow( seedRow );
+    newClusterElements->InsertNextRow( seedRow );
     }
+  seedRow->Delete();
+  observations->Delete();
+
+  return true;
+}
+
+// ----------------------------------------------------------------------
+void vtkKMeansStatistics::SelectInitialClusterCenter( double* vtkNotUsed( candidate ),
+                                                      int vtkNotUsed( dimension ),
+                                                      double vtkNotUsed( weight ),
+                                                      double vtkNotUsed( u ) )
+{
+}
+
+// ----------------------------------------------------------------------
+void vtkKMeansStatistics::UpdateClusterCenters( vtkTable* vtkNotUsed( newClusterElements ),
+                                                vtkTable* vtkNotUsed( curClusterElements ),
+                                                vtkIdTypeArray* vtkNotUsed( numMembershipChanges ),
+                                                vtkIdTypeArray* vtkNotUsed( numDataElementsInCluster ),
+                                                vtkDoubleArray* vtkNotUsed( error ),
+                                                vtkIdTypeArray* vtkNotUsed( startRunID ),
+                                                vtkIdTypeArray* vtkNotUsed( endRunID ),
+                                                vtkIntArray* vtkNotUsed( computeRun ) )
+{
 }
 
 // ----------------------------------------------------------------------
@@ -293,6 +832,16 @@ bool vtkKMeansStatistics::SetParameter(
       return true;
       }
     }
+  else if ( pname == "MiniBatchSize" )
+    {
+    bool valid;
+    vtkIdType batchSize = value.ToTypeInt64( &valid );
+    if ( valid && batchSize >= 0 )
+      {
+      this->SetMiniBatchSize( batchSize );
+      return true;
+      }
+    }
 
   return false;
 }
@@ -345,8 +894,26 @@ void vtkKMeansStatistics::Learn( vtkTable* inData,
     }
 
   vtkIdType numObservations = inData->GetNumberOfRows();
-  vtkIdType totalNumberOfObservations = this->GetTotalNumberOfObservations( numObservations );
   vtkIdType numToAllocate = curClusterElements->GetNumberOfRows();
+  vtkIdType dimension = curClusterElements->GetNumberOfColumns();
+
+  // With the default distance functor and numeric columns, observations are
+  // assigned in parallel, reading their typed columns a block at a time
+  vtksys_stl::vector<vtkDataArray*> columns;
+  bool kernels = vtkKMeansStatisticsIsEuclidean( this->DistanceFunctor )
+    && vtkKMeansStatisticsGetColumns( dataElements, columns )
+    && static_cast<vtkIdType>( columns.size() ) == dimension;
+  bool miniBatch = this->MiniBatchSize > 0;
+  if ( miniBatch && ! kernels )
+    {
+    vtkWarningMacro( "Mini-batches require numeric columns and the default distance functor. "
+                     "Full iterations are performed instead." );
+    miniBatch = false;
+    }
+  vtkIdType batchSize = ( miniBatch && numObservations > 0 ) ? this->MiniBatchSize : 0;
+  vtkIdType totalNumberOfObservations
+    = this->GetTotalNumberOfObservations( miniBatch ? batchSize : numObservations );
+
   vtkIdTypeArray* numIterations = vtkIdTypeArray::New();
   vtkIdTypeArray* numDataElementsInCluster = vtkIdTypeArray::New();
   vtkDoubleArray* error = vtkDoubleArray::New();
@@ -365,7 +932,8 @@ void vtkKMeansStatistics::Learn( vtkTable* inData,
   numIterations->SetName( "Iterations" );
   numMembershipChanges->SetNumberOfValues( numRuns );
   computeRun->SetNumberOfValues( numRuns );
-  clusterMemberID->SetNumberOfValues( numObservations*numRuns );
+  // Mini-batches do not keep track of the cluster of each observation
+  clusterMemberID->SetNumberOfValues( miniBatch ? 0 : numObservations*numRuns );
   clusterMemberID->SetName( "cluster member id" );
 
   for ( int i = 0; i < numRuns; ++ i )
@@ -381,10 +949,21 @@ void vtkKMeansStatistics::Learn( vtkTable* inData,
   int allConverged, numIter = 0;
   clusterMemberID->FillComponent( 0, -1 );
 
+  // Coordinates of the cluster centers used by the kernels, and for mini-batches,
+  // those of the previous iteration, and the number of observations assigned so far
+  vtksys_stl::vector<double> centers( numToAllocate * dimension );
+  vtksys_stl::vector<double> previousCenters;
+  vtksys_stl::vector<vtkIdType> batchRows( batchSize );
+  vtksys_stl::vector<vtkIdType> numAssigned( miniBatch ? numToAllocate : 0, 0 );
+  vtkMinimalStandardRandomSequence* random = vtkMinimalStandardRandomSequence::New();
+  random->SetSeed( this->RandomSeed );
+  bool lastPass = false;
 
   // Iterate until new cluster centers have converged OR we have reached a max number of iterations
   do
     {
+    bool batch = miniBatch && ! lastPass;
+
     // Initialize coordinates, cluster sizes and errors
     numMembershipChanges->FillComponent( 0, 0 );
     for( int runID = 0; runID < numRuns; runID ++ )
@@ -402,64 +981,183 @@ void vtkKMeansStatistics::Learn( vtkTable* inData,
         }
       }
 
-    // Find minimum distance between each observation and each cluster center,
-    // then assign the observation to the nearest cluster.
-    vtkIdType localMemberID, offsetLocalMemberID;
-    double minDistance, curDistance;
-    for ( vtkIdType observation = 0; observation < dataElements->GetNumberOfRows(); observation++ )
+    if ( kernels )
       {
-      for( int runID = 0; runID < numRuns; runID++)
+      if ( batch && numIter )
+        {
+        previousCenters = centers;
+        }
+      for ( vtkIdType j = 0; j < numToAllocate; ++ j )
+        {
+        for ( vtkIdType c = 0; c < dimension; ++ c )
+          {
+          centers[j * dimension + c] = curClusterElements->GetValue( j, c ).ToDouble();
+          }
+        }
+
+      // Draw the observations of the mini-batch, in increasing order to read them faster
+      if ( batch )
+        {
+        for ( vtkIdType i = 0; i < batchSize; ++ i )
+          {
+          random->Next();
+          vtkIdType row = static_cast<vtkIdType>( random->GetValue() * numObservations );
+          batchRows[i] = row < numObservations ? row : numObservations - 1;
+          }
+        vtksys_stl::sort( batchRows.begin(), batchRows.end() );
+        }
+
+      vtkKMeansStatisticsAssignFunctor assign;
+      assign.Columns = columns;
+      assign.Rows = ( batch && batchSize ) ? &batchRows[0] : 0;
+      assign.Centers = &centers[0];
+      assign.PreviousCenters = ( batch && numIter ) ? &previousCenters[0] : 0;
+      assign.StartRunID = startRunID->GetPointer( 0 );
+      assign.EndRunID = endRunID->GetPointer( 0 );
+      assign.ComputeRun = computeRun->GetPointer( 0 );
+      assign.NumberOfRuns = numRuns;
+      assign.NumberOfCenters = numToAllocate;
+      assign.MemberIDs = miniBatch ? 0 : clusterMemberID->GetPointer( 0 );
+      vtkSMPTools::For( 0, batch ? batchSize : numObservations,
+                        16 * vtkKMeansStatisticsBlockSize, assign );
+
+      // Move each cluster center to the mean of the observations assigned to it
+      for( int runID = 0; runID < numRuns; runID ++ )
         {
-        if(computeRun->GetValue( runID ))
+        if( ! computeRun->GetValue( runID ) )
           {
-          vtkIdType runStartIdx = startRunID->GetValue( runID );
-          vtkIdType runEndIdx = endRunID->GetValue( runID );
-          if ( runStartIdx >= runEndIdx )
+          continue;
+          }
+        // Without previous centers, all observations of the first mini-batch change clusters
+        numMembershipChanges->SetValue( runID, assign.PreviousCenters ?
+                                        assign.Changes[runID] : ( batch ? batchSize : assign.Changes[runID] ) );
+        for( vtkIdType j = startRunID->GetValue(runID); j < endRunID->GetValue(runID); j++ )
+          {
+          vtkIdType cardinality = assign.Cardinalities[j];
+          numDataElementsInCluster->SetValue( j, cardinality );
+          error->SetValue( j, assign.Errors[j] );
+          for ( vtkIdType c = 0; c < dimension; ++ c )
             {
-            continue;
+            double x = centers[j * dimension + c];
+            if ( cardinality )
+              {
+              x += assign.Displacements[j * dimension + c] / static_cast<double>( cardinality );
+              }
+            newClusterElements->SetValue( j, c, x );
             }
-          vtkIdType j = runStartIdx;
-          localMemberID = 0;
-          offsetLocalMemberID = runStartIdx;
-          (*this->DistanceFunctor)( minDistance,
-            curClusterElements->GetRow( j ),
-            dataElements->GetRow( observation ) );
-          curDistance = minDistance;
-          ++ j;
-          for( /* no init */; j < runEndIdx; j ++ )
+          }
+        }
+      }
+    else
+      {
+      // Find minimum distance between each observation and each cluster center,
+      // then assign the observation to the nearest cluster.
+      vtkIdType localMemberID, offsetLocalMemberID;
+      double minDistance, curDistance;
+      for ( vtkIdType observation = 0; observation < dataElements->GetNumberOfRows(); observation++ )
+        {
+        for( int runID = 0; runID < numRuns; runID++)
+          {
+          if(computeRun->GetValue( runID ))
             {
-            (*this->DistanceFunctor)( curDistance,
+            vtkIdType runStartIdx = startRunID->GetValue( runID );
+            vtkIdType runEndIdx = endRunID->GetValue( runID );
+            if ( runStartIdx >= runEndIdx )
+              {
+              continue;
+              }
+            vtkIdType j = runStartIdx;
+            localMemberID = 0;
+            offsetLocalMemberID = runStartIdx;
+            (*this->DistanceFunctor)( minDistance,
               curClusterElements->GetRow( j ),
               dataElements->GetRow( observation ) );
-            if( curDistance < minDistance )
+            curDistance = minDistance;
+            ++ j;
+            for( /* no init */; j < runEndIdx; j ++ )
               {
-              minDistance = curDistance;
-              localMemberID = j - runStartIdx;
-              offsetLocalMemberID = j;
+              (*this->DistanceFunctor)( curDistance,
+                curClusterElements->GetRow( j ),
+                dataElements->GetRow( observation ) );
+              if( curDistance < minDistance )
+                {
+                minDistance = curDistance;
+                localMemberID = j - runStartIdx;
+                offsetLocalMemberID = j;
+                }
               }
+            // We've located the nearest cluster center. Has it changed since the last iteration?
+            if ( clusterMemberID->GetValue( observation*numRuns+runID) != localMemberID )
+              {
+              numMembershipChanges->SetValue( runID, numMembershipChanges->GetValue( runID ) + 1 );
+              clusterMemberID->SetValue( observation*numRuns+runID, localMemberID );
+              }
+            // Give the distance functor a chance to modify any derived quantities used to
+            // change the cluster centers between iterations, now that we know which cluster
+            // center the observation is assigned to.
+            vtkIdType newCardinality = numDataElementsInCluster->GetValue( offsetLocalMemberID ) + 1;
+            numDataElementsInCluster->SetValue( offsetLocalMemberID, newCardinality );
+            this->DistanceFunctor->PairwiseUpdate( newClusterElements, offsetLocalMemberID,
+              dataElements->GetRow( observation ), 1, newCardinality );
+            // Update the error for this cluster center to account for this observation.
+            error->SetValue( offsetLocalMemberID, error->GetValue( offsetLocalMemberID ) + minDistance );
             }
-          // We've located the nearest cluster center. Has it changed since the last iteration?
-          if ( clusterMemberID->GetValue( observation*numRuns+runID) != localMemberID )
-            {
-            numMembershipChanges->SetValue( runID, numMembershipChanges->GetValue( runID ) + 1 );
-            clusterMemberID->SetValue( observation*numRuns+runID, localMemberID );
-            }
-          // Give the distance functor a chance to modify any derived quantities used to
-          // change the cluster centers between iterations, now that we know which cluster
-          // center the observation is assigned to.
-          vtkIdType newCardinality = numDataElementsInCluster->GetValue( offsetLocalMemberID ) + 1;
-          numDataElementsInCluster->SetValue( offsetLocalMemberID, newCardinality );
-          this->DistanceFunctor->PairwiseUpdate( newClusterElements, offsetLocalMemberID,
-            dataElements->GetRow( observation ), 1, newCardinality );
-          // Update the error for this cluster center to account for this observation.
-          error->SetValue( offsetLocalMemberID, error->GetValue( offsetLocalMemberID ) + minDistance );
           }
         }
       }
+
     // update cluster centers
     this->UpdateClusterCenters( newClusterElements, curClusterElements, numMembershipChanges,
                                 numDataElementsInCluster, error, startRunID, endRunID, computeRun );
 
+    for( int runID = 0; runID < numRuns; runID ++ )
+      {
+      if( ! computeRun->GetValue( runID ) )
+        {
+        continue;
+        }
+      for( vtkIdType i = startRunID->GetValue(runID); i < endRunID->GetValue(runID); ++ i )
+        {
+        vtkIdType cardinality = numDataElementsInCluster->GetValue( i );
+        if ( batch )
+          {
+          // Mini-batch update: each observation assigned so far weighs as much in the center
+          numAssigned[i] += cardinality;
+          if ( cardinality )
+            {
+            double rate = static_cast<double>( cardinality ) / static_cast<double>( numAssigned[i] );
+            for ( vtkIdType c = 0; c < dimension; ++ c )
+              {
+              double x = curClusterElements->GetValue( i, c ).ToDouble();
+              newClusterElements->SetValue( i, c, x + rate * ( newClusterElements->GetValue( i, c ).ToDouble() - x ) );
+              }
+            }
+          else
+            {
+            newClusterElements->SetRow( i, curClusterElements->GetRow( i ) );
+            }
+          }
+        else if( cardinality == 0 )
+          {
+          vtkWarningMacro("cluster center " << i-startRunID->GetValue(runID)
+                                            << " in run " << runID
+                                            << " is degenerate. Attempting to perturb");
+          newClusterElements->SetRow( i, curClusterElements->GetRow( i ) );
+          this->DistanceFunctor->PerturbElement(newClusterElements,
+                                                curClusterElements,
+                                                i,
+                                                startRunID->GetValue(runID),
+                                                endRunID->GetValue(runID),
+                                                0.8 ) ;
+          }
+        }
+      }
+
+    if ( lastPass )
+      {
+      break;
+      }
+
     // check for convergence
     numIter++ ;
     allConverged = 0;
@@ -485,8 +1183,17 @@ void vtkKMeansStatistics::Learn( vtkTable* inData,
         allConverged++;
         }
       }
+
+    // Mini-batches only estimate the cluster centers: assign all observations
+    // once more, to calculate the cardinalities and errors of the clusters
+    if ( miniBatch && ( allConverged >= numRuns || numIter >= this->MaxNumIterations ) )
+      {
+      lastPass = true;
+      computeRun->FillComponent( 0, 1 );
+      }
     }
-  while ( allConverged < numRuns && numIter  < this->MaxNumIterations );
+  while ( lastPass || ( allConverged < numRuns && numIter  < this->MaxNumIterations ) );
+  random->Delete();
 
   // add columns to output table
   vtkTable* outputTable = vtkTable::New();
@@ -786,36 +1493,71 @@ bool vtkKMeansAssessFunctor::Initialize( vtkTable* inData,
   this->Distances->SetNumberOfValues( numObservations * this->NumRuns );
   this->ClusterMemberIDs->SetNumberOfValues( numObservations * this->NumRuns );
 
-  // find minimum distance between each data object and cluster center
-  for ( vtkIdType observation = 0; observation < numObservations; ++ observation )
+  // With the default distance functor and numeric columns, assess observations in parallel
+  vtksys_stl::vector<vtkDataArray*> columns;
+  if ( vtkKMeansStatisticsIsEuclidean( dfunc )
+       && vtkKMeansStatisticsGetColumns( dataElements, columns )
+       && columns.size() == static_cast<size_t>( curClusterElements->GetNumberOfColumns() )
+       && this->NumRuns > 0 )
     {
-    for( int runID = 0; runID < this->NumRuns; ++ runID )
+    int dimension = static_cast<int>( columns.size() );
+    vtkIdType numCenters = curClusterElements->GetNumberOfRows();
+    vtksys_stl::vector<double> centers( numCenters * dimension + 1 ); // Never empty
+    for ( vtkIdType j = 0; j < numCenters; ++ j )
       {
-      vtkIdType runStartIdx = startRunID->GetValue( runID );
-      vtkIdType runEndIdx = endRunID->GetValue( runID );
-      if ( runStartIdx >= runEndIdx )
+      for ( int c = 0; c < dimension; ++ c )
         {
-        continue;
+        centers[j * dimension + c] = curClusterElements->GetValue( j, c ).ToDouble();
         }
-      // Find the closest cluster center to the observation across all centers in the runID-th run.
-      vtkIdType j = runStartIdx;
-      double minDistance;
-      double curDistance;
-      (*dfunc)( minDistance, curClusterElements->GetRow( j ), dataElements->GetRow( observation ) );
-      vtkIdType localMemberID = 0;
-      for( /* no init */; j < runEndIdx; ++ j )
+      }
+    vtksys_stl::vector<int> computeRun( this->NumRuns, 1 );
+
+    vtkKMeansStatisticsAssignFunctor assign;
+    assign.Columns = columns;
+    assign.Centers = &centers[0];
+    assign.StartRunID = startRunID->GetPointer( 0 );
+    assign.EndRunID = endRunID->GetPointer( 0 );
+    assign.ComputeRun = &computeRun[0];
+    assign.NumberOfRuns = this->NumRuns;
+    assign.NumberOfCenters = numCenters;
+    assign.Accumulate = false;
+    assign.MemberIDs = this->ClusterMemberIDs->GetPointer( 0 );
+    assign.Distances = this->Distances->GetPointer( 0 );
+    vtkSMPTools::For( 0, numObservations, 16 * vtkKMeansStatisticsBlockSize, assign );
+    }
+  else
+    {
+    // find minimum distance between each data object and cluster center
+    for ( vtkIdType observation = 0; observation < numObservations; ++ observation )
+      {
+      for( int runID = 0; runID < this->NumRuns; ++ runID )
         {
-        (*dfunc)( curDistance, curClusterElements->GetRow( j ), dataElements->GetRow( observation ) );
-        if ( curDistance < minDistance )
+        vtkIdType runStartIdx = startRunID->GetValue( runID );
+        vtkIdType runEndIdx = endRunID->GetValue( runID );
+        if ( runStartIdx >= runEndIdx )
           {
-          minDistance = curDistance;
-          localMemberID = j - runStartIdx;
+          continue;
           }
+        // Find the closest cluster center to the observation across all centers in the runID-th run.
+        vtkIdType j = runStartIdx;
+        double minDistance;
+        double curDistance;
+        (*dfunc)( minDistance, curClusterElements->GetRow( j ), dataElements->GetRow( observation ) );
+        vtkIdType localMemberID = 0;
+        for( /* no init */; j < runEndIdx; ++ j )
+          {
+          (*dfunc)( curDistance, curClusterElements->GetRow( j ), dataElements->GetRow( observation ) );
+          if ( curDistance < minDistance )
+            {
+            minDistance = curDistance;
+            localMemberID = j - runStartIdx;
+            }
+          }
+        this->ClusterMemberIDs->SetValue( observation * this->NumRuns + runID, localMemberID );
+        this->Distances->SetValue( observation * this->NumRuns + runID, minDistance );
         }
-      this->ClusterMemberIDs->SetValue( observation * this->NumRuns + runID, localMemberID );
-      this->Distances->SetValue( observation * this->NumRuns + runID, minDistance );
       }
-   }
+    }
 
   dataElements->Delete();
   curClusterElements->Delete();
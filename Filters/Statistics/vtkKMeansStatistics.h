@@ -84,6 +84,25 @@ PURPOSE.  See the above copyright notice for more information.
 // and is not limited to vtkDataArrays.  A default distance functor that
 // computes the sum of the squares of the Euclidean distance between two objects is provided
 // (vtkKMeansDistanceFunctor). The default distance functor can be overridden to use alternative distance metrics.
+// With the default distance functor and numeric columns, observations are assigned
+// to their nearest cluster centers in parallel with vtkSMPTools, reading the columns
+// a block of rows at a time in their own type; other distance functors are evaluated
+// one observation at a time.
+//
+// When no initial cluster centers are provided, they are either the first
+// observations, or are drawn at random with k-means++ seeding, where each new
+// center is drawn with a probability proportional to the squared distance of
+// the observation to the nearest center already chosen. Of 2 + ln(k) such draws,
+// the one which most decreases the sum of these squared distances is kept.
+//
+// For very large tables, mini-batch k-means can be used instead of full Lloyd
+// iterations: each iteration then draws MiniBatchSize observations at random,
+// and moves each center towards the mean of the observations of the batch it is
+// nearest to, with a rate which decreases with the number of observations the
+// center has been assigned so far. Iterations stop when the fraction of the batch
+// which is assigned to another center than with the centers of the previous
+// iteration falls below the tolerance, after which a last Lloyd iteration over
+// all observations calculates the cardinalities and errors of the model.
 //
 // .SECTION Thanks
 // Thanks to Janine Bennett, David Thompson, and Philippe Pebay of
@@ -136,6 +155,40 @@ public:
   vtkSetMacro( Tolerance, double );
   vtkGetMacro( Tolerance, double );
 
+  // Description:
+  // Set/get the number of observations drawn at random by each process at
+  // each iteration of mini-batch k-means. Full Lloyd iterations are performed
+  // when 0, which is the default. Mini-batches require numeric columns and
+  // the default distance functor.
+  vtkSetClampMacro( MiniBatchSize, vtkIdType, 0, VTK_ID_MAX );
+  vtkGetMacro( MiniBatchSize, vtkIdType );
+
+  //BTX
+  enum InitializationMethodType
+    {
+    FIRST_OBSERVATIONS = 0,
+    KMEANS_PLUS_PLUS = 1
+    };
+  //ETX
+
+  // Description:
+  // Set/get how the initial cluster centers are chosen when none are provided
+  // on input port LEARN_PARAMETERS: either the first DefaultNumberOfClusters
+  // observations (the default), or with k-means++ seeding, which requires
+  // numeric columns.
+  vtkSetClampMacro( InitializationMethod, int, FIRST_OBSERVATIONS, KMEANS_PLUS_PLUS );
+  vtkGetMacro( InitializationMethod, int );
+  void SetInitializationMethodToFirstObservations()
+    { this->SetInitializationMethod( FIRST_OBSERVATIONS ); }
+  void SetInitializationMethodToKMeansPlusPlus()
+    { this->SetInitializationMethod( KMEANS_PLUS_PLUS ); }
+
+  // Description:
+  // Set/get the seed of the random numbers used by k-means++ seeding and to
+  // draw mini-batches, so that results are reproducible.
+  vtkSetMacro( RandomSeed, int );
+  vtkGetMacro( RandomSeed, int );
+
   // Description:
   // Given a collection of models, calculate aggregate model
   // NB: not implemented
@@ -184,7 +237,9 @@ protected:
                                     AssessFunctor*& dfunc );
   //ETX
   // Description:
-  // Subroutine to update new cluster centers from the old centers.
+  // Subroutine to combine the cluster centers, cardinalities, errors and numbers
+  // of membership changes calculated from the local observations into those of
+  // all observations. The serial implementation has nothing to combine.
   // Called from within Learn (and will be overridden by vtkPKMeansStatistics
   // to handle distributed datasets).
   virtual void UpdateClusterCenters( vtkTable* newClusterElements,
@@ -227,6 +282,39 @@ protected:
                                            vtkTable* newClusterElements);
 
 
+  // Description:
+  // Subroutine to sum, over all processes, the potentials of candidate k-means++
+  // cluster centers: the sums of the squared distances of the observations to
+  // their nearest cluster center, were the candidate added.
+  // Called from within CreateKMeansPlusPlusClusterCenters (and will be
+  // overridden by vtkPKMeansStatistics to handle distributed datasets).
+  virtual void GetTotalPotentials( double* potentials, int numberOfCandidates );
+
+  // Description:
+  // Subroutine to draw initial cluster centers with greedy k-means++ seeding,
+  // where the best of several candidates is kept for each center. Return
+  // false, without drawing any center, when the requested columns are not all
+  // numeric.
+  // Called from within CreateInitialClusterCenters.
+  bool CreateKMeansPlusPlusClusterCenters( vtkIdType numToAllocate,
+                                           vtkIdTypeArray* numberOfClusters,
+                                           vtkTable* inData,
+                                           vtkTable* curClusterElements,
+                                           vtkTable* newClusterElements );
+
+  // Description:
+  // Subroutine to choose the next k-means++ cluster center among the candidates
+  // drawn by all processes from their own observations, each with the given
+  // weight, with the uniform random number u. On return, candidate holds the
+  // coordinates of the chosen center. The serial implementation keeps the
+  // candidate.
+  // Called from within CreateKMeansPlusPlusClusterCenters (and will be
+  // overridden by vtkPKMeansStatistics to handle distributed datasets).
+  virtual void SelectInitialClusterCenter( double* candidate,
+                                           int dimension,
+                                           double weight,
+                                           double u );
+
   // Description:
   // This is the default number of clusters used when the user does not provide initial cluster centers.
   int DefaultNumberOfClusters;
@@ -243,6 +331,15 @@ protected:
   // Description:
   // This is the Distance functor.  The default is Euclidean distance, however this can be overridden.
   vtkKMeansDistanceFunctor* DistanceFunctor;
+  // Description:
+  // This is the number of observations drawn by each process at each iteration of mini-batch k-means.
+  vtkIdType MiniBatchSize;
+  // Description:
+  // This is how initial cluster centers are chosen when the user does not provide them.
+  int InitializationMethod;
+  // Description:
+  // This is the seed of the random numbers used by k-means++ seeding and mini-batches.
+  int RandomSeed;
 
 private:
   vtkKMeansStatistics( const vtkKMeansStatistics& ); // Not implemented
@@ -147,26 +147,41 @@ void vtkMultiCorrelativeStatistics::Aggregate( vtkDataObjectCollection* inMetaCo
     return;
     }
 
-  // Get hold of the first model (data object) in the collection
-  vtkCollectionSimpleIterator it;
-  inMetaColl->InitTraversal( it );
-  vtkDataObject *inMetaDO = inMetaColl->GetNextDataObject( it );
-
-  // Verify that the first input model is indeed contained in a multiblock data set
-  vtkMultiBlockDataSet* inMeta = vtkMultiBlockDataSet::SafeDownCast( inMetaDO );
-  if ( ! inMeta )
+  // Medians and median absolute deviations cannot be updated from those of
+  // pieces of the data; the model is then learned from all data at once
+  if ( this->MedianAbsoluteDeviation )
     {
+    vtkWarningMacro( "Models based on the median absolute deviation cannot be aggregated." );
     return;
     }
 
-  // Verify that the first covariance matrix is indeed contained in a table
-  vtkTable* inCov = vtkTable::SafeDownCast( inMeta->GetBlock( 0 ) );
-  if ( ! inCov )
+  // Get hold of the first model (data object) in the collection which
+  // contains statistics, skipping models learned from no data at all
+  vtkCollectionSimpleIterator it;
+  inMetaColl->InitTraversal( it );
+  vtkDataObject *inMetaDO;
+  vtkMultiBlockDataSet* inMeta = 0;
+  vtkTable* inCov = 0;
+  vtkIdType nRow = 0;
+  while ( ! nRow && ( inMetaDO = inMetaColl->GetNextDataObject( it ) ) )
     {
-    return;
+    // Verify that the first input model is indeed contained in a multiblock data set
+    inMeta = vtkMultiBlockDataSet::SafeDownCast( inMetaDO );
+    if ( ! inMeta )
+      {
+      return;
+      }
+
+    // Verify that the first covariance matrix is indeed contained in a table
+    inCov = vtkTable::SafeDownCast( inMeta->GetBlock( 0 ) );
+    if ( ! inCov )
+      {
+      return;
+      }
+
+    nRow = inCov->GetNumberOfRows();
     }
 
-  vtkIdType nRow = inCov->GetNumberOfRows();
   if ( ! nRow )
     {
     // No statistics were calculated.
@@ -198,6 +213,12 @@ void vtkMultiCorrelativeStatistics::Aggregate( vtkDataObjectCollection* inMetaCo
       return;
       }
 
+    if ( ! inCov->GetNumberOfRows() )
+      {
+      // No statistics were calculated in this model
+      continue;
+      }
+
     if ( inCov->GetNumberOfRows() != nRow )
       {
       // Models do not match
@@ -206,14 +227,14 @@ void vtkMultiCorrelativeStatistics::Aggregate( vtkDataObjectCollection* inMetaCo
       return;
       }
 
-    // Iterate over all model rows
-    int inN, outN;
+    // First, verify that the rows of both models match, and fetch the
+    // cardinalities and the means before any of them is updated
+    // NB: covariance entries refer to their means by name, as there is no
+    // guarantee that the pairs of variables are stored in any given order
     double muFactor = 0.;
     double covFactor = 0.;
-    std::vector<double> inMu, outMu;
-    int j = 0;
-    int k = 0;
-    for ( int r = 0; r < nRow; ++ r )
+    vtksys_stl::map<vtkStdString,vtksys_stl::pair<double,double> > mu;
+    for ( vtkIdType r = 0; r < nRow; ++ r )
       {
       // Verify that variable names match each other
       if ( inCov->GetValueByName( r, VTK_MULTICORRELATIVE_KEYCOLUMN1 ) != outCov->GetValueByName( r, VTK_MULTICORRELATIVE_KEYCOLUMN1 )
@@ -225,36 +246,49 @@ void vtkMultiCorrelativeStatistics::Aggregate( vtkDataObjectCollection* inMetaCo
         return;
         }
 
-      // Update each model parameter
-      if ( inCov->GetValueByName( r, VTK_MULTICORRELATIVE_KEYCOLUMN1 ).ToString() == "Cardinality" )
+      vtkStdString col1 = inCov->GetValueByName( r, VTK_MULTICORRELATIVE_KEYCOLUMN1 ).ToString();
+      double inEntry = inCov->GetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL ).ToDouble();
+      double outEntry = outCov->GetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL ).ToDouble();
+      if ( col1 == "Cardinality" )
         {
-        // Cardinality
-        inN = inCov->GetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL ).ToInt();
-        outN = outCov->GetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL ).ToInt();
-        int totN = inN + outN;
-        outCov->SetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL, totN );
-        muFactor = static_cast<double>( inN ) / totN;
-        covFactor = static_cast<double>( inN ) * outN / totN;
+        // NB: cardinalities are stored as doubles in the covariance table
+        double totN = inEntry + outEntry;
+        if ( totN > 0. )
+          {
+          muFactor = inEntry / totN;
+          covFactor = inEntry * outEntry / totN;
+          }
         }
       else if ( inCov->GetValueByName( r, VTK_MULTICORRELATIVE_KEYCOLUMN2 ).ToString() == "" )
+        {
+        mu[col1] = vtksys_stl::pair<double,double>( inEntry, outEntry );
+        }
+      }
+
+    // Then, update each model parameter
+    for ( vtkIdType r = 0; r < nRow; ++ r )
+      {
+      vtkStdString col1 = inCov->GetValueByName( r, VTK_MULTICORRELATIVE_KEYCOLUMN1 ).ToString();
+      vtkStdString col2 = inCov->GetValueByName( r, VTK_MULTICORRELATIVE_KEYCOLUMN2 ).ToString();
+      double inEntry = inCov->GetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL ).ToDouble();
+      double outEntry = outCov->GetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL ).ToDouble();
+      if ( col1 == "Cardinality" )
+        {
+        // Cardinality
+        outCov->SetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL, inEntry + outEntry );
+        }
+      else if ( col2 == "" )
         {
         // Mean
-        inMu.push_back( inCov->GetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL ).ToDouble() );
-        outMu.push_back( outCov->GetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL ).ToDouble() );
-        outCov->SetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL, outMu.back() + ( inMu.back() - outMu.back() ) * muFactor );
+        outCov->SetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL, outEntry + ( inEntry - outEntry ) * muFactor );
         }
       else
         {
         // M XY
-        double inCovEntry = inCov->GetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL ).ToDouble();
-        double outCovEntry = outCov->GetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL ).ToDouble();
-        outCov->SetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL, inCovEntry + outCovEntry + ( inMu[j] - outMu[j] ) * ( inMu[k] - outMu[k] ) * covFactor );
-        ++ k;
-        if ( k > j )
-          {
-          ++ j;
-          k = 0;
-          }
+        const vtksys_stl::pair<double,double>& muX = mu[col1];
+        const vtksys_stl::pair<double,double>& muY = mu[col2];
+        outCov->SetValueByName( r, VTK_MULTICORRELATIVE_ENTRIESCOL,
+                                inEntry + outEntry + ( muX.first - muX.second ) * ( muY.first - muY.second ) * covFactor );
         }
       }
     }
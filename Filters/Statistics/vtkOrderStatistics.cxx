@@ -22,13 +22,16 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkOrderStatistics.h"
 #include "vtkStatisticsAlgorithmPrivate.h"
 
+#include "vtkDataObjectCollection.h"
 #include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkQuantileSketch.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariantArray.h"
@@ -46,6 +49,8 @@ vtkOrderStatistics::vtkOrderStatistics()
   this->NumberOfIntervals = 4; // By default, calculate 5-points statistics
   this->Quantize = false; // By default, do not force quantization
   this->MaximumHistogramSize = 1000; // A large value by default
+  this->Sketch = false; // By default, calculate exact histograms
+  this->SketchError = 0.001;
   // Number of primary tables is variable
   this->NumberOfPrimaryTables = -1;
 
@@ -66,6 +71,8 @@ void vtkOrderStatistics::PrintSelf( ostream &os, vtkIndent indent )
   os << indent << "QuantileDefinition: " << this->QuantileDefinition << endl;
   os << indent << "Quantize: " << this->Quantize << endl;
   os << indent << "MaximumHistogramSize: " << this->MaximumHistogramSize << endl;
+  os << indent << "Sketch: " << this->Sketch << endl;
+  os << indent << "SketchError: " << this->SketchError << endl;
 }
 
 // ----------------------------------------------------------------------
@@ -109,6 +116,20 @@ bool vtkOrderStatistics::SetParameter( const char* parameter,
     return true;
     }
 
+  if ( ! strcmp( parameter, "Sketch" ) )
+    {
+    this->SetSketch( value.ToInt() != 0 );
+
+    return true;
+    }
+
+  if ( ! strcmp( parameter, "SketchError" ) )
+    {
+    this->SetSketchError( value.ToDouble() );
+
+    return true;
+    }
+
   return false;
 }
 
@@ -127,8 +148,12 @@ void vtkOrderStatistics::Learn( vtkTable* inData,
     return;
     }
 
-  // Loop over requests
+  // Sketches are sized after the whole data set, which the local one may
+  // only be a part of
   vtkIdType nRow = inData->GetNumberOfRows();
+  vtkIdType nRowTotal = this->Sketch ? this->GetTotalNumberOfRows( nRow ) : nRow;
+
+  // Loop over requests
   for ( vtksys_stl::set<vtksys_stl::set<vtkStdString> >::iterator rit = this->Internals->Requests.begin();
         rit != this->Internals->Requests.end(); ++ rit )
     {
@@ -195,54 +220,95 @@ void vtkOrderStatistics::Learn( vtkTable* inData,
       // Downcast column to data array for efficient data access
       vtkDataArray* dvals = vtkDataArray::SafeDownCast( vals );
 
-      // Calculate histogram
-      vtksys_stl::map<double,vtkIdType> histogram;
-      for ( vtkIdType r = 0; r < nRow; ++ r )
+      if ( this->Sketch )
         {
-        ++ histogram[dvals->GetTuple1( r )];
-        }
+        // Summarize values with a sketch of bounded size, reduced over the
+        // whole data set if it is distributed
+        vtkQuantileSketch* sketch = vtkQuantileSketch::New();
+        sketch->SetCapacity( vtkQuantileSketch::ComputeCapacity( this->SketchError, nRowTotal ) );
+        sketch->InsertValues( dvals );
+        if ( ! this->ReduceSketch( sketch ) )
+          {
+          vtkErrorMacro( "Could not reduce sketch of column "
+                         << col.c_str()
+                         << ". Ignoring it." );
+
+          sketch->Delete();
+          histogramTab->Delete();
+          row->Delete();
+          continue;
+          }
 
-      // If maximum size was requested, make sure it is satisfied
-      if ( this->Quantize )
+        // Store weighted values of sketch as histogram
+        sketch->GetHistogram( vtkDoubleArray::SafeDownCast( histogramTab->GetColumnByName( "Value" ) ),
+                              idTypeCol );
+
+        // Keep sketch along with histogram so models can be aggregated
+        vtkDoubleArray* sketchArr = vtkDoubleArray::New();
+        sketchArr->SetName( "Quantile Sketch" );
+        sketch->Serialize( sketchArr );
+        histogramTab->GetFieldData()->AddArray( sketchArr );
+        sketchArr->Delete();
+
+        vtkIdTypeArray* boundArr = vtkIdTypeArray::New();
+        boundArr->SetName( "Rank Error Bound" );
+        boundArr->InsertNextValue( sketch->GetRankErrorBound() );
+        histogramTab->GetFieldData()->AddArray( boundArr );
+        boundArr->Delete();
+
+        sketch->Delete();
+        } // if ( this->Sketch )
+      else
         {
-        // Retrieve achieved histogram size
-        vtkIdType Nq = histogram.size();
+        // Calculate histogram
+        vtksys_stl::map<double,vtkIdType> histogram;
+        for ( vtkIdType r = 0; r < nRow; ++ r )
+          {
+          ++ histogram[dvals->GetTuple1( r )];
+          }
 
-        // If histogram is too big, quantization will have to occur
-        while ( Nq > this->MaximumHistogramSize )
+        // If maximum size was requested, make sure it is satisfied
+        if ( this->Quantize )
           {
-          // Retrieve extremal values
-          double mini = histogram.begin()->first;
-          double maxi = histogram.rbegin()->first;
-
-          // Create bucket width based on target histogram size
-          // FIXME: .5 is arbitrary at this point
-          double width = ( maxi - mini ) / vtkMath::Round(  Nq / 2. );
-
-          // Now re-calculate histogram by quantizing values
-          histogram.clear();
-          double reading;
-          double quantum;
-          for ( vtkIdType r = 0; r < nRow; ++ r )
+          // Retrieve achieved histogram size
+          vtkIdType Nq = histogram.size();
+
+          // If histogram is too big, quantization will have to occur
+          while ( Nq > this->MaximumHistogramSize )
             {
-            reading = dvals->GetTuple1( r );
-            quantum = mini + vtkMath::Round( ( reading - mini ) / width ) * width;
-            ++ histogram[quantum];
-            }
+            // Retrieve extremal values
+            double mini = histogram.begin()->first;
+            double maxi = histogram.rbegin()->first;
+
+            // Create bucket width based on target histogram size
+            // FIXME: .5 is arbitrary at this point
+            double width = ( maxi - mini ) / vtkMath::Round(  Nq / 2. );
+
+            // Now re-calculate histogram by quantizing values
+            histogram.clear();
+            double reading;
+            double quantum;
+            for ( vtkIdType r = 0; r < nRow; ++ r )
+              {
+              reading = dvals->GetTuple1( r );
+              quantum = mini + vtkMath::Round( ( reading - mini ) / width ) * width;
+              ++ histogram[quantum];
+              }
 
-          // Update histogram size for conditional clause
-          Nq = histogram.size();
+            // Update histogram size for conditional clause
+            Nq = histogram.size();
+            }
           }
-        }
 
-      // Store histogram
-      for ( vtksys_stl::map<double,vtkIdType>::iterator mit = histogram.begin();
-            mit != histogram.end(); ++ mit  )
-        {
-        row->SetValue( 0, mit->first );
-        row->SetValue( 1, mit->second );
-        histogramTab->InsertNextRow( row );
-        }
+        // Store histogram
+        for ( vtksys_stl::map<double,vtkIdType>::iterator mit = histogram.begin();
+              mit != histogram.end(); ++ mit  )
+          {
+          row->SetValue( 0, mit->first );
+          row->SetValue( 1, mit->second );
+          histogramTab->InsertNextRow( row );
+          }
+        } // else
       } // if ( vals->IsA("vtkDataArray") )
     else if ( vals->IsA("vtkStringArray") )
       {
@@ -309,6 +375,142 @@ void vtkOrderStatistics::Learn( vtkTable* inData,
   return;
 }
 
+// ----------------------------------------------------------------------
+void vtkOrderStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
+                                    vtkMultiBlockDataSet* outMeta )
+{
+  if ( ! inMetaColl || ! outMeta )
+    {
+    return;
+    }
+
+  // Aggregated histogram table of each variable, in order of appearance
+  vtksys_stl::vector<vtkStdString> varNames;
+  vtksys_stl::map<vtkStdString,vtkTable*> aggregated;
+
+  // Loop over all models
+  vtkCollectionSimpleIterator it;
+  inMetaColl->InitTraversal( it );
+  while ( vtkDataObject* inMetaDO = inMetaColl->GetNextDataObject( it ) )
+    {
+    vtkMultiBlockDataSet* inMeta = vtkMultiBlockDataSet::SafeDownCast( inMetaDO );
+    if ( ! inMeta )
+      {
+      continue;
+      }
+
+    unsigned int nBlocks = inMeta->GetNumberOfBlocks();
+    for ( unsigned int b = 0; b < nBlocks; ++ b )
+      {
+      // Only histogram tables are aggregated; derived tables are not
+      vtkTable* histogramTab = vtkTable::SafeDownCast( inMeta->GetBlock( b ) );
+      if ( ! histogramTab
+           || ! histogramTab->GetColumnByName( "Value" )
+           || ! vtkIdTypeArray::SafeDownCast( histogramTab->GetColumnByName( "Cardinality" ) ) )
+        {
+        continue;
+        }
+
+      vtkStdString varName = inMeta->GetMetaData( b )->Get( vtkCompositeDataSet::NAME() );
+      vtkAbstractArray* vals = histogramTab->GetColumnByName( "Value" );
+      vtkIdTypeArray* card = vtkIdTypeArray::SafeDownCast( histogramTab->GetColumnByName( "Cardinality" ) );
+      vtkDoubleArray* sketchArr = vtkDoubleArray::SafeDownCast(
+        histogramTab->GetFieldData()->GetArray( "Quantile Sketch" ) );
+
+      // First histogram of this variable: copy its values, cardinalities and sketch
+      vtksys_stl::map<vtkStdString,vtkTable*>::iterator ait = aggregated.find( varName );
+      if ( ait == aggregated.end() )
+        {
+        vtkTable* aggregatedTab = vtkTable::New();
+        vtkAbstractArray* aggVals = vals->NewInstance();
+        aggVals->DeepCopy( vals );
+        aggVals->SetName( "Value" );
+        aggregatedTab->AddColumn( aggVals );
+        aggVals->Delete();
+        vtkIdTypeArray* aggCard = vtkIdTypeArray::New();
+        aggCard->DeepCopy( card );
+        aggCard->SetName( "Cardinality" );
+        aggregatedTab->AddColumn( aggCard );
+        aggCard->Delete();
+        aggregatedTab->GetFieldData()->DeepCopy( histogramTab->GetFieldData() );
+
+        varNames.push_back( varName );
+        aggregated[varName] = aggregatedTab;
+        continue;
+        }
+
+      vtkTable* aggregatedTab = ait->second;
+      vtkAbstractArray* aggVals = aggregatedTab->GetColumnByName( "Value" );
+      vtkIdTypeArray* aggCard = vtkIdTypeArray::SafeDownCast( aggregatedTab->GetColumnByName( "Cardinality" ) );
+      vtkDoubleArray* aggSketchArr = vtkDoubleArray::SafeDownCast(
+        aggregatedTab->GetFieldData()->GetArray( "Quantile Sketch" ) );
+      if ( ( sketchArr != 0 ) != ( aggSketchArr != 0 ) )
+        {
+        vtkWarningMacro( "Cannot aggregate a sketch with an exact histogram for variable "
+                         << varName.c_str()
+                         << ". Ignoring it." );
+        continue;
+        }
+
+      if ( sketchArr )
+        {
+        // Merge sketches and draw histogram anew from the result
+        vtkQuantileSketch* sketch = vtkQuantileSketch::New();
+        vtkQuantileSketch* other = vtkQuantileSketch::New();
+        if ( sketch->Deserialize( aggSketchArr ) && other->Deserialize( sketchArr ) )
+          {
+          sketch->Merge( other );
+          sketch->GetHistogram( vtkDoubleArray::SafeDownCast( aggVals ), aggCard );
+          sketch->Serialize( aggSketchArr );
+          vtkIdTypeArray::SafeDownCast( aggregatedTab->GetFieldData()
+            ->GetArray( "Rank Error Bound" ) )->SetValue( 0, sketch->GetRankErrorBound() );
+          }
+        else
+          {
+          vtkWarningMacro( "Invalid sketch for variable "
+                           << varName.c_str()
+                           << ". Ignoring it." );
+          }
+        sketch->Delete();
+        other->Delete();
+        continue;
+        }
+
+      // Add up cardinalities of equal values of both histograms
+      vtksys_stl::map<vtkVariant,vtkIdType> histogram;
+      for ( vtkIdType r = 0; r < aggVals->GetNumberOfTuples(); ++ r )
+        {
+        histogram[aggVals->GetVariantValue( r )] += aggCard->GetValue( r );
+        }
+      for ( vtkIdType r = 0; r < vals->GetNumberOfTuples(); ++ r )
+        {
+        histogram[vals->GetVariantValue( r )] += card->GetValue( r );
+        }
+
+      // Store aggregated histogram
+      aggVals->SetNumberOfTuples( histogram.size() );
+      aggCard->SetNumberOfTuples( histogram.size() );
+      vtkIdType r = 0;
+      for ( vtksys_stl::map<vtkVariant,vtkIdType>::iterator mit = histogram.begin();
+            mit != histogram.end(); ++ mit, ++ r )
+        {
+        aggVals->SetVariantValue( r, mit->first );
+        aggCard->SetValue( r, mit->second );
+        }
+      } // b
+    } // inMetaDO
+
+  // Replace output meta with aggregated histogram tables; derived tables
+  // will be calculated anew from them
+  outMeta->SetNumberOfBlocks( static_cast<unsigned int>( varNames.size() ) );
+  for ( unsigned int b = 0; b < varNames.size(); ++ b )
+    {
+    outMeta->GetMetaData( b )->Set( vtkCompositeDataSet::NAME(), varNames[b] );
+    outMeta->SetBlock( b, aggregated[varNames[b]] );
+    aggregated[varNames[b]]->Delete();
+    }
+}
+
 // ----------------------------------------------------------------------
 void vtkOrderStatistics::Derive( vtkMultiBlockDataSet* inMeta )
 {
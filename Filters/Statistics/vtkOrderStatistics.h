@@ -24,6 +24,12 @@ PURPOSE.  See the above copyright notice for more information.
 // class provides the following functionalities, depending on the
 // execution mode it is executed in:
 // * Learn: calculate histogram.
+//   With Sketch on, the histogram of each numeric variable is instead drawn
+//   from a vtkQuantileSketch, whose size only depends on SketchError, so
+//   that quantiles of very large data sets are computed within a
+//   guaranteed rank error of SketchError times the number of values.
+//   The sketch and its rank error bound are kept in the field data of the
+//   histogram table, as the "Quantile Sketch" and "Rank Error Bound" arrays.
 // * Derive: calculate PDFs and arbitrary quantiles. Provide specific names when 5-point
 //   statistics (minimum, 1st quartile, median, third quartile, maximum) requested.
 // * Assess: given an input data set and a set of q-quantiles, label each datum
@@ -44,6 +50,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkStatisticsAlgorithm.h"
 
 class vtkMultiBlockDataSet;
+class vtkQuantileSketch;
 class vtkStringArray;
 class vtkTable;
 class vtkVariant;
@@ -86,6 +93,23 @@ public:
   vtkSetMacro( MaximumHistogramSize, vtkIdType );
   vtkGetMacro( MaximumHistogramSize, vtkIdType );
 
+  // Description:
+  // Set/Get whether the histograms of numeric variables are approximated
+  // with a vtkQuantileSketch rather than computed exactly.  The histogram
+  // then holds a bounded number of values, whatever the number of distinct
+  // values in the input, and the rank of each quantile is within
+  // SketchError times the number of values of the exact one.
+  // Quantize is ignored for these variables.  Default is false.
+  vtkSetMacro( Sketch, bool );
+  vtkGetMacro( Sketch, bool );
+  vtkBooleanMacro( Sketch, bool );
+
+  // Description:
+  // Set/Get the largest rank error of the quantiles, relative to the
+  // number of values, when Sketch is on.  Default is 0.001.
+  vtkSetClampMacro( SketchError, double, 0., 1. );
+  vtkGetMacro( SketchError, double );
+
   // Description:
   // Get the quantile definition.
   vtkIdType GetQuantileDefinition() { return static_cast<vtkIdType>( this->QuantileDefinition ); }
@@ -99,10 +123,14 @@ public:
                              vtkVariant value );
 
   // Description:
-  // Given a collection of models, calculate aggregate model
-  // NB: not implemented
+  // Given a collection of models, calculate aggregate model.
+  // Histograms are added up, and sketches are merged, so that the model of
+  // a data set can be learned one chunk at a time with
+  // vtkStreamingStatistics.  Since the sketch of each chunk is sized after
+  // the chunk, the "Rank Error Bound" of the aggregated sketch may exceed
+  // SketchError times the number of values by a small factor.
   virtual void Aggregate( vtkDataObjectCollection*,
-                          vtkMultiBlockDataSet* ) { return; };
+                          vtkMultiBlockDataSet* );
 
 protected:
   vtkOrderStatistics();
@@ -131,6 +159,16 @@ protected:
                        vtkTable* outData )
   { this->Superclass::Assess( inData, inMeta, outData, 1 ); }
 
+  // Description:
+  // Return the number of rows of the whole data set of which inData holds
+  // nRow rows.  The capacity of the sketches is computed from it.
+  virtual vtkIdType GetTotalNumberOfRows( vtkIdType nRow ) { return nRow; }
+
+  // Description:
+  // Turn the sketch of the local data into the sketch of the whole data
+  // set.  There is nothing to do in serial.
+  virtual bool ReduceSketch( vtkQuantileSketch* ) { return true; }
+
 //BTX
   // Description:
   // Provide the appropriate assessment functor.
@@ -144,6 +182,8 @@ protected:
   QuantileDefinitionType QuantileDefinition;
   bool Quantize;
   vtkIdType MaximumHistogramSize;
+  bool Sketch;
+  double SketchError;
 
 private:
   vtkOrderStatistics(const vtkOrderStatistics&); // Not implemented
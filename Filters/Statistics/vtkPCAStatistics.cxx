@@ -1,16 +1,21 @@
 #include "vtkPCAStatistics.h"
 
+#include "vtkDataObjectCollection.h"
 #include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiCorrelativeStatisticsAssessFunctor.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
 #include <map>
 #include <vector>
 #include <vtksys/ios/sstream>
@@ -24,6 +29,7 @@
 
 #define VTK_PCA_NORMCOLUMN "PCA Cov Norm"
 #define VTK_PCA_COMPCOLUMN "PCA"
+#define VTK_PCA_RFACTOR "PCA R Factor"
 
 vtkObjectFactoryNewMacro(vtkPCAStatistics)
 
@@ -44,6 +50,13 @@ const char* vtkPCAStatistics::BasisSchemeEnumNames[NUM_BASIS_SCHEMES + 1] =
   "InvalidBasisScheme"
 };
 
+const char* vtkPCAStatistics::DecompositionSchemeEnumNames[NUM_DECOMPOSITION_SCHEMES + 1] =
+{
+  "CovarianceSVD",
+  "TallSkinnyQR",
+  "InvalidDecompositionScheme"
+};
+
 // ----------------------------------------------------------------------
 void vtkPCAStatistics::GetEigenvalues(int request, vtkDoubleArray* eigenvalues)
 {
@@ -366,6 +379,7 @@ vtkPCAStatistics::vtkPCAStatistics()
   this->BasisScheme = FULL_BASIS;
   this->FixedBasisSize = -1;
   this->FixedBasisEnergy = 1.;
+  this->DecompositionScheme = COVARIANCE_SVD;
 }
 
 // ----------------------------------------------------------------------
@@ -381,6 +395,7 @@ void vtkPCAStatistics::PrintSelf( ostream& os, vtkIndent indent )
   os << indent << "BasisScheme: " << this->GetBasisSchemeName( this->BasisScheme ) << "\n";
   os << indent << "FixedBasisSize: " << this->FixedBasisSize << "\n";
   os << indent << "FixedBasisEnergy: " << this->FixedBasisEnergy << "\n";
+  os << indent << "DecompositionScheme: " << this->GetDecompositionSchemeName( this->DecompositionScheme ) << "\n";
 }
 
 // ----------------------------------------------------------------------
@@ -416,6 +431,13 @@ bool vtkPCAStatistics::SetParameter( const char* parameter,
     return true;
     }
 
+  if ( ! strcmp( parameter, "DecompositionScheme" ) )
+    {
+    this->SetDecompositionScheme( value.ToInt() );
+
+    return true;
+    }
+
   return false;
 }
 
@@ -479,6 +501,30 @@ void vtkPCAStatistics::SetBasisSchemeByName( const char* schemeName )
   vtkErrorMacro( "Invalid basis scheme name \"" << schemeName << "\" provided." );
 }
 
+// ----------------------------------------------------------------------
+const char* vtkPCAStatistics::GetDecompositionSchemeName( int schemeIndex )
+{
+  if ( schemeIndex < 0 || schemeIndex > NUM_DECOMPOSITION_SCHEMES )
+    {
+    return vtkPCAStatistics::DecompositionSchemeEnumNames[NUM_DECOMPOSITION_SCHEMES];
+    }
+  return vtkPCAStatistics::DecompositionSchemeEnumNames[schemeIndex];
+}
+
+// ----------------------------------------------------------------------
+void vtkPCAStatistics::SetDecompositionSchemeByName( const char* schemeName )
+{
+  for ( int i = 0; i < NUM_DECOMPOSITION_SCHEMES; ++ i )
+    {
+    if ( ! strcmp( vtkPCAStatistics::DecompositionSchemeEnumNames[i], schemeName ) )
+      {
+      this->SetDecompositionScheme( i );
+      return;
+      }
+    }
+  vtkErrorMacro( "Invalid decomposition scheme name \"" << schemeName << "\" provided." );
+}
+
 // ----------------------------------------------------------------------
 int vtkPCAStatistics::FillInputPortInformation( int port, vtkInformation* info )
 {
@@ -635,6 +681,537 @@ static void vtkPCAStatisticsNormalizeVariance( vtkVariantArray* normData,
     }
 }
 
+// ----------------------------------------------------------------------
+// Number of rows of the blocks of data that are factorized at once
+static const vtkIdType vtkPCAStatisticsBlockSize = 256;
+
+// ----------------------------------------------------------------------
+// Reduce the nr x nc matrix a, stored by columns with leading dimension ld,
+// to upper triangular form with Householder reflections: its first nc rows are
+// replaced with the triangular factor R of its QR factorization and the other
+// rows are zeroed.
+static void vtkPCAStatisticsTriangularize( double* a,
+                                           vtkIdType nr,
+                                           vtkIdType nc,
+                                           vtkIdType ld )
+{
+  for ( vtkIdType k = 0; k < nc && k < nr; ++ k )
+    {
+    double* ak = a + k * ld;
+    double norm = 0.;
+    for ( vtkIdType i = k; i < nr; ++ i )
+      {
+      norm += ak[i] * ak[i];
+      }
+    norm = sqrt( norm );
+    if ( norm == 0. )
+      {
+      continue;
+      }
+
+    // Reflect column k onto -sign( a(k,k) ) * norm * e_k with the Householder
+    // vector v = a(k:,k) + sign( a(k,k) ) * norm * e_k, stored in place
+    double sign = ak[k] < 0. ? -1. : 1.;
+    double beta = 1. / ( norm * ( norm + fabs( ak[k] ) ) );
+    ak[k] += sign * norm;
+    for ( vtkIdType j = k + 1; j < nc; ++ j )
+      {
+      double* aj = a + j * ld;
+      double dot = 0.;
+      for ( vtkIdType i = k; i < nr; ++ i )
+        {
+        dot += ak[i] * aj[i];
+        }
+      dot *= beta;
+      for ( vtkIdType i = k; i < nr; ++ i )
+        {
+        aj[i] -= dot * ak[i];
+        }
+      }
+    ak[k] = - sign * norm;
+    for ( vtkIdType i = k + 1; i < nr; ++ i )
+      {
+      ak[i] = 0.;
+      }
+    }
+}
+
+// ----------------------------------------------------------------------
+// Replace the cardinality n, the means and the m x m triangular factor r (by
+// columns) of the centered data of a set of observations with those of its
+// union with another set of nb observations with means mb. The centered data
+// of the latter are given by the nr x m matrix b (by columns, with leading
+// dimension ldb), which is either the centered observations themselves or their
+// triangular factor.
+static void vtkPCAStatisticsUpdate( double& n,
+                                    double* mean,
+                                    double* r,
+                                    vtkIdType m,
+                                    double nb,
+                                    const double* mb,
+                                    const double* b,
+                                    vtkIdType nr,
+                                    vtkIdType ldb,
+                                    std::vector<double>& work )
+{
+  if ( nb <= 0. )
+    {
+    return;
+    }
+
+  // Stack both factors with the difference of the means, weighted such that
+  // the Gram matrix of the stack is the matrix of centered sums of products of
+  // the union (this is the update of the covariance matrix in R^T R form)
+  double nab = n + nb;
+  double f = sqrt( n * nb / nab );
+  vtkIdType ld = m + nr + 1;
+  work.resize( ld * m );
+  for ( vtkIdType j = 0; j < m; ++ j )
+    {
+    double* w = &work[0] + j * ld;
+    std::copy( r + j * m, r + ( j + 1 ) * m, w );
+    std::copy( b + j * ldb, b + j * ldb + nr, w + m );
+    w[m + nr] = f * ( mean[j] - mb[j] );
+    }
+  vtkPCAStatisticsTriangularize( &work[0], ld, m, ld );
+
+  for ( vtkIdType j = 0; j < m; ++ j )
+    {
+    std::copy( &work[0] + j * ld, &work[0] + j * ld + m, r + j * m );
+    mean[j] += ( mb[j] - mean[j] ) * nb / nab;
+    }
+  n = nab;
+}
+
+// ----------------------------------------------------------------------
+template <class T>
+static void vtkPCAStatisticsReadColumn( const T* column,
+                                        vtkIdType begin,
+                                        vtkIdType end,
+                                        double* x )
+{
+  for ( vtkIdType i = begin; i < end; ++ i, ++ x )
+    {
+    *x = static_cast<double>( column[i] );
+    }
+}
+
+// ======================================================== vtkPCAStatisticsQRFunctor
+// Compute the cardinality, the means and the triangular factor of the centered
+// observations. Each thread factorizes blocks of its rows into its own factor;
+// the factors of all threads are then merged.
+class vtkPCAStatisticsQRFunctor
+{
+public:
+  struct Partial
+  {
+    double Cardinality;
+    std::vector<double> Mean;
+    std::vector<double> R;
+    std::vector<double> Block;
+    std::vector<double> BlockMean;
+    std::vector<double> Work;
+  };
+
+  vtkPCAStatisticsQRFunctor( const std::vector<vtkDataArray*>& columns )
+    : Columns( columns )
+  {
+    vtkIdType m = static_cast<vtkIdType>( this->Columns.size() );
+    // Factorizing a block costs about ( m + blockSize ) m^2 operations
+    this->BlockSize = std::max( vtkPCAStatisticsBlockSize, m );
+    this->Cardinality = 0.;
+    this->Mean.assign( m, 0. );
+    this->R.assign( m * m, 0. );
+  }
+
+  void Initialize()
+  {
+    vtkIdType m = static_cast<vtkIdType>( this->Columns.size() );
+    Partial& p = this->Partials.Local();
+    p.Cardinality = 0.;
+    p.Mean.assign( m, 0. );
+    p.R.assign( m * m, 0. );
+    p.Block.resize( this->BlockSize * m );
+    p.BlockMean.resize( m );
+  }
+
+  void operator () ( vtkIdType begin, vtkIdType end )
+  {
+    vtkIdType m = static_cast<vtkIdType>( this->Columns.size() );
+    Partial& p = this->Partials.Local();
+    for ( vtkIdType b = begin; b < end; b += this->BlockSize )
+      {
+      vtkIdType e = std::min( b + this->BlockSize, end );
+      vtkIdType nb = e - b;
+      for ( vtkIdType j = 0; j < m; ++ j )
+        {
+        vtkDataArray* column = this->Columns[j];
+        double* x = &p.Block[0] + j * this->BlockSize;
+        if ( column->GetNumberOfComponents() == 1 && column->GetDataType() != VTK_BIT )
+          {
+          switch ( column->GetDataType() )
+            {
+            vtkTemplateMacro(
+              vtkPCAStatisticsReadColumn( static_cast<VTK_TT*>( column->GetVoidPointer( 0 ) ),
+                                          b, e, x ) );
+            }
+          }
+        else
+          {
+          for ( vtkIdType i = b; i < e; ++ i )
+            {
+            x[i - b] = column->GetComponent( i, 0 );
+            }
+          }
+
+        // Center the block
+        double mu = 0.;
+        for ( vtkIdType i = 0; i < nb; ++ i )
+          {
+          mu += x[i];
+          }
+        mu /= nb;
+        for ( vtkIdType i = 0; i < nb; ++ i )
+          {
+          x[i] -= mu;
+          }
+        p.BlockMean[j] = mu;
+        }
+
+      vtkPCAStatisticsUpdate( p.Cardinality, &p.Mean[0], &p.R[0], m,
+                              static_cast<double>( nb ), &p.BlockMean[0],
+                              &p.Block[0], nb, this->BlockSize, p.Work );
+      }
+  }
+
+  void Reduce()
+  {
+    vtkIdType m = static_cast<vtkIdType>( this->Columns.size() );
+    std::vector<double> work;
+    vtkSMPThreadLocal<Partial>::iterator end = this->Partials.end();
+    for ( vtkSMPThreadLocal<Partial>::iterator it = this->Partials.begin(); it != end; ++ it )
+      {
+      vtkPCAStatisticsUpdate( this->Cardinality, &this->Mean[0], &this->R[0], m,
+                              (*it).Cardinality, &(*it).Mean[0],
+                              &(*it).R[0], m, m, work );
+      }
+  }
+
+  const std::vector<vtkDataArray*>& Columns;
+  vtkIdType BlockSize;
+  vtkSMPThreadLocal<Partial> Partials;
+  double Cardinality;
+  std::vector<double> Mean;
+  std::vector<double> R;
+};
+
+// ----------------------------------------------------------------------
+// Fetch the cardinality, the means and the triangular factor (by columns) of a
+// raw model learned with the TALL_SKINNY_QR scheme, if it has a factor
+static bool vtkPCAStatisticsGetRawFactor( vtkTable* sparseCov,
+                                          std::vector<vtkStdString>& names,
+                                          double& n,
+                                          std::vector<double>& mean,
+                                          std::vector<double>& r )
+{
+  vtkStringArray* col1;
+  vtkStringArray* col2;
+  vtkDoubleArray* col3;
+  vtkDoubleArray* rFactor;
+  if (
+    ! sparseCov ||
+    ! ( col1 = vtkStringArray::SafeDownCast( sparseCov->GetColumnByName( VTK_MULTICORRELATIVE_KEYCOLUMN1 ) ) ) ||
+    ! ( col2 = vtkStringArray::SafeDownCast( sparseCov->GetColumnByName( VTK_MULTICORRELATIVE_KEYCOLUMN2 ) ) ) ||
+    ! ( col3 = vtkDoubleArray::SafeDownCast( sparseCov->GetColumnByName( VTK_MULTICORRELATIVE_ENTRIESCOL ) ) ) ||
+    ! ( rFactor = vtkDoubleArray::SafeDownCast( sparseCov->GetFieldData()->GetArray( VTK_PCA_RFACTOR ) ) ) ||
+    ! col3->GetNumberOfTuples()
+    )
+    {
+    return false;
+    }
+
+  // The cardinality comes first, then the means of the variables
+  n = col3->GetValue( 0 );
+  names.clear();
+  mean.clear();
+  vtkIdType nEntries = col3->GetNumberOfTuples();
+  for ( vtkIdType i = 1; i < nEntries && col2->GetValue( i ).empty(); ++ i )
+    {
+    names.push_back( col1->GetValue( i ) );
+    mean.push_back( col3->GetValue( i ) );
+    }
+
+  vtkIdType m = static_cast<vtkIdType>( names.size() );
+  if ( ! m
+       || rFactor->GetNumberOfComponents() != m
+       || rFactor->GetNumberOfTuples() != m )
+    {
+    return false;
+    }
+
+  // The factor is stored by rows
+  r.resize( m * m );
+  const double* x = rFactor->GetPointer( 0 );
+  for ( vtkIdType i = 0; i < m; ++ i )
+    {
+    for ( vtkIdType j = 0; j < m; ++ j, ++ x )
+      {
+      r[j * m + i] = *x;
+      }
+    }
+  return true;
+}
+
+// ----------------------------------------------------------------------
+// Store the m x m triangular factor r (by columns) with a raw model
+static void vtkPCAStatisticsSetRawFactor( vtkTable* sparseCov,
+                                          const std::vector<double>& r,
+                                          vtkIdType m )
+{
+  vtkDoubleArray* rFactor = vtkDoubleArray::New();
+  rFactor->SetName( VTK_PCA_RFACTOR );
+  rFactor->SetNumberOfComponents( static_cast<int>( m ) );
+  rFactor->SetNumberOfTuples( m );
+  double* x = rFactor->GetPointer( 0 );
+  for ( vtkIdType i = 0; i < m; ++ i )
+    {
+    for ( vtkIdType j = 0; j < m; ++ j, ++ x )
+      {
+      *x = r[j * m + i];
+      }
+    }
+  sparseCov->GetFieldData()->AddArray( rFactor );
+  rFactor->Delete();
+}
+
+// ----------------------------------------------------------------------
+void vtkPCAStatistics::Learn( vtkTable* inData,
+                              vtkTable* inParameters,
+                              vtkMultiBlockDataSet* outMeta )
+{
+  if ( this->DecompositionScheme != TALL_SKINNY_QR
+       || this->MedianAbsoluteDeviation
+       || ! inData
+       || ! outMeta )
+    {
+    this->Superclass::Learn( inData, inParameters, outMeta );
+    return;
+    }
+
+  // Let the superclass lay out the raw moments of the requested variables,
+  // from a table without rows so that it does not compute any sum
+  vtkTable* layout = vtkTable::New();
+  for ( vtkIdType c = 0; c < inData->GetNumberOfColumns(); ++ c )
+    {
+    vtkDataArray* arr = vtkDataArray::SafeDownCast( inData->GetColumn( c ) );
+    if ( arr )
+      {
+      vtkDataArray* empty = arr->NewInstance();
+      empty->SetName( arr->GetName() );
+      layout->AddColumn( empty );
+      empty->Delete();
+      }
+    }
+  this->Superclass::Learn( layout, inParameters, outMeta );
+  layout->Delete();
+
+  vtkTable* sparseCov = vtkTable::SafeDownCast( outMeta->GetBlock( 0 ) );
+  vtkStringArray* col1;
+  vtkStringArray* col2;
+  vtkDoubleArray* col3;
+  if (
+    ! sparseCov ||
+    ! ( col1 = vtkStringArray::SafeDownCast( sparseCov->GetColumnByName( VTK_MULTICORRELATIVE_KEYCOLUMN1 ) ) ) ||
+    ! ( col2 = vtkStringArray::SafeDownCast( sparseCov->GetColumnByName( VTK_MULTICORRELATIVE_KEYCOLUMN2 ) ) ) ||
+    ! ( col3 = vtkDoubleArray::SafeDownCast( sparseCov->GetColumnByName( VTK_MULTICORRELATIVE_ENTRIESCOL ) ) )
+    )
+    {
+    return;
+    }
+
+  // The cardinality comes first, then the variables sorted by name, then the
+  // pairs of variables for which a centered sum of products is needed
+  std::map<vtkStdString,vtkIdType> colNameToIdx;
+  std::vector<vtkDataArray*> columns;
+  vtkIdType nEntries = col3->GetNumberOfTuples();
+  vtkIdType i;
+  for ( i = 1; i < nEntries && col2->GetValue( i ).empty(); ++ i )
+    {
+    colNameToIdx[col1->GetValue( i )] = i - 1;
+    columns.push_back( vtkDataArray::SafeDownCast( inData->GetColumnByName( col1->GetValue( i ) ) ) );
+    }
+  vtkIdType m = static_cast<vtkIdType>( columns.size() );
+  vtkIdType nRow = inData->GetNumberOfRows();
+  double* rv = col3->GetPointer( 0 );
+  *rv = static_cast<double>( nRow );
+  if ( ! m )
+    {
+    return;
+    }
+
+  vtkPCAStatisticsQRFunctor functor( columns );
+  vtkSMPTools::For( 0, nRow, functor );
+
+  // The centered sums of products are the entries of R^T R
+  const std::vector<double>& r = functor.R;
+  std::copy( functor.Mean.begin(), functor.Mean.end(), rv + 1 );
+  for ( ; i < nEntries; ++ i )
+    {
+    vtkIdType a = colNameToIdx[col1->GetValue( i )];
+    vtkIdType b = colNameToIdx[col2->GetValue( i )];
+    double sum = 0.;
+    for ( vtkIdType k = 0; k <= a && k <= b; ++ k )
+      {
+      sum += r[a * m + k] * r[b * m + k];
+      }
+    rv[i] = sum;
+    }
+
+  // Keep the triangular factor with the raw moments, so that it is aggregated
+  // and derived along with them
+  vtkPCAStatisticsSetRawFactor( sparseCov, r, m );
+}
+
+// ----------------------------------------------------------------------
+void vtkPCAStatistics::Aggregate( vtkDataObjectCollection* inMetaColl,
+                                  vtkMultiBlockDataSet* outMeta )
+{
+  if ( ! outMeta )
+    {
+    return;
+    }
+
+  // Merge the triangular factors of the models first, because the output model
+  // may be one of them; models learned from no data are skipped, as they are
+  // by the superclass. The factors can only be aggregated if all models have one.
+  bool aggregateR = ! this->MedianAbsoluteDeviation;
+  std::vector<vtkStdString> names;
+  std::vector<vtkStdString> inNames;
+  std::vector<double> mean;
+  std::vector<double> inMean;
+  std::vector<double> r;
+  std::vector<double> inR;
+  std::vector<double> work;
+  double n = 0.;
+  double inN;
+  vtkIdType nRow = 0;
+  vtkCollectionSimpleIterator it;
+  inMetaColl->InitTraversal( it );
+  vtkDataObject* inMetaDO;
+  while ( aggregateR && ( inMetaDO = inMetaColl->GetNextDataObject( it ) ) )
+    {
+    vtkMultiBlockDataSet* inMeta = vtkMultiBlockDataSet::SafeDownCast( inMetaDO );
+    vtkTable* inCov = inMeta ? vtkTable::SafeDownCast( inMeta->GetBlock( 0 ) ) : 0;
+    if ( inCov && ! inCov->GetNumberOfRows() )
+      {
+      continue;
+      }
+
+    if ( ! vtkPCAStatisticsGetRawFactor( inCov, inNames, inN, inMean, inR )
+         || ( nRow && ( inNames != names || inCov->GetNumberOfRows() != nRow ) ) )
+      {
+      aggregateR = false;
+      }
+    else if ( ! nRow )
+      {
+      nRow = inCov->GetNumberOfRows();
+      names = inNames;
+      n = inN;
+      mean = inMean;
+      r = inR;
+      }
+    else
+      {
+      vtkIdType m = static_cast<vtkIdType>( names.size() );
+      vtkPCAStatisticsUpdate( n, &mean[0], &r[0], m,
+                              inN, &inMean[0], &inR[0], m, m, work );
+      }
+    }
+
+  this->Superclass::Aggregate( inMetaColl, outMeta );
+
+  vtkTable* outCov = vtkTable::SafeDownCast( outMeta->GetBlock( 0 ) );
+  if ( ! outCov || ! outCov->GetNumberOfRows() )
+    {
+    return;
+    }
+
+  if ( aggregateR && nRow )
+    {
+    vtkPCAStatisticsSetRawFactor( outCov, r, static_cast<vtkIdType>( names.size() ) );
+    }
+  else
+    {
+    outCov->GetFieldData()->RemoveArray( VTK_PCA_RFACTOR );
+    }
+}
+
+// ----------------------------------------------------------------------
+// Compute the eigenvalues and eigenvectors of the covariance matrix of a
+// request from the SVD of the triangular factor of its centered data. This
+// factor is that of the columns of the triangular factor of all variables
+// which belong to the request, scaled by the diagonal normalization factors
+// normData, if any. The eigenvectors are returned as the columns of u.
+static bool vtkPCAStatisticsDecomposeFactor( vtkTable* reqModel,
+                                             const std::vector<vtkStdString>& names,
+                                             const std::vector<double>& r,
+                                             double n,
+                                             vtkVariantArray* normData,
+                                             ap::real_1d_array& s,
+                                             ap::real_2d_array& u )
+{
+  vtkIdType m = reqModel->GetNumberOfColumns() - 2;
+  vtkIdType mr = static_cast<vtkIdType>( names.size() );
+  std::vector<double> a( mr * m );
+  for ( vtkIdType j = 0; j < m; ++ j )
+    {
+    std::vector<vtkStdString>::const_iterator it =
+      std::find( names.begin(), names.end(), vtkStdString( reqModel->GetColumn( j + 2 )->GetName() ) );
+    if ( it == names.end() )
+      {
+      return false;
+      }
+    vtkIdType k = static_cast<vtkIdType>( it - names.begin() );
+    double w = normData->GetNumberOfValues() == m ?
+      1. / sqrt( normData->GetValue( j ).ToDouble() ) : 1.;
+    for ( vtkIdType i = 0; i < mr; ++ i )
+      {
+      a[j * mr + i] = r[k * mr + i] * w;
+      }
+    }
+  vtkPCAStatisticsTriangularize( &a[0], mr, m, mr );
+
+  ap::real_2d_array rs;
+  rs.setbounds( 0, m - 1, 0, m - 1 );
+  for ( vtkIdType j = 0; j < m; ++ j )
+    {
+    for ( vtkIdType i = 0; i < m; ++ i )
+      {
+      rs( i, j ) = a[j * mr + i];
+      }
+    }
+
+  // The right singular vectors of R are the eigenvectors of R^T R / ( n - 1 ),
+  // and the squares of its singular values, divided by n - 1, the eigenvalues
+  ap::real_2d_array vt;
+  ap::real_2d_array unused;
+  if ( ! rmatrixsvd( rs, m, m, 0, 2, 2, s, unused, vt ) )
+    {
+    return false;
+    }
+  double scale = 1. / ( n - 1. );
+  u.setbounds( 0, m - 1, 0, m - 1 );
+  for ( vtkIdType i = 0; i < m; ++ i )
+    {
+    s( i ) *= s( i ) * scale;
+    for ( vtkIdType j = 0; j < m; ++ j )
+      {
+      u( j, i ) = vt( i, j );
+      }
+    }
+  return true;
+}
+
 // ----------------------------------------------------------------------
 void vtkPCAStatistics::Derive( vtkMultiBlockDataSet* inMeta )
 {
@@ -643,6 +1220,16 @@ void vtkPCAStatistics::Derive( vtkMultiBlockDataSet* inMeta )
     return;
     }
 
+  // Fetch the triangular factor of the data, if any, to decompose it instead
+  // of the covariance matrices when requested.
+  std::vector<vtkStdString> rNames;
+  std::vector<double> rMean;
+  std::vector<double> r;
+  double n = 0.;
+  bool useR = this->DecompositionScheme == TALL_SKINNY_QR
+    && this->NormalizationScheme != TRIANGLE_SPECIFIED
+    && vtkPCAStatisticsGetRawFactor( vtkTable::SafeDownCast( inMeta->GetBlock( 0 ) ), rNames, n, rMean, r );
+
   // Use the parent class to compute a covariance matrix for each request.
   this->Superclass::Derive( inMeta );
 
@@ -697,9 +1284,12 @@ void vtkPCAStatistics::Derive( vtkMultiBlockDataSet* inMeta )
     ap::real_2d_array u;
     ap::real_1d_array s;
     ap::real_2d_array vt;
-    // Now that we have the covariance matrix, compute the SVD.
+    // Now that we have the covariance matrix, compute the SVD, or that of the
+    // triangular factor of the data if available.
     // Note that vt is not computed since the VtNeeded parameter is 0.
-    bool status = rmatrixsvd( cov, m, m, 2, 0, 2, s, u, vt );
+    bool status = useR ?
+      vtkPCAStatisticsDecomposeFactor( reqModel, rNames, r, n, normData, s, u ) :
+      rmatrixsvd( cov, m, m, 2, 0, 2, s, u, vt );
     if ( ! status )
       {
       vtkWarningMacro( "Could not compute PCA for request " << b );
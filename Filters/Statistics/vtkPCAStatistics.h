@@ -41,6 +41,17 @@ PURPOSE.  See the above copyright notice for more information.
 // This can be done by activating the MedianAbsoluteDeviation boolean (declared in
 // the superclass).
 //
+// Forming the covariance matrix squares the condition number of the data, which
+// makes its decomposition inaccurate when there are many, nearly dependent,
+// columns. When the DecompositionScheme is set to TALL_SKINNY_QR, the learn
+// operation instead computes the triangular factor R of a QR factorization of
+// the centered data, block by block and in parallel threads, and the derive
+// operation computes the SVD of R, whose right singular vectors are the
+// eigenvectors of the covariance matrix. R is aggregated along with the
+// other moments, so that models learned from pieces of the data, including by
+// vtkPPCAStatistics, are reduced as a tree of QR factorizations (TSQR).
+// The output tables are the same for both schemes.
+//
 // .SECTION Thanks
 // Thanks to David Thompson, Philippe Pebay and Jackson Mayo from
 // Sandia National Laboratories for implementing this class.
@@ -84,6 +95,15 @@ public:
     FIXED_BASIS_ENERGY, //!< Use consecutive basis matrix entries whose energies sum to at least T
     NUM_BASIS_SCHEMES   //!< The number of schemes (not a valid scheme).
     };
+
+  // Description:
+  // These are the enumeration values that SetDecompositionScheme() accepts and GetDecompositionScheme returns.
+  enum DecompositionType
+    {
+    COVARIANCE_SVD,     //!< Decompose the covariance matrix computed from the centered sums of products
+    TALL_SKINNY_QR,     //!< Decompose the triangular factor of a QR factorization of the centered data
+    NUM_DECOMPOSITION_SCHEMES //!< The number of schemes (not a valid scheme).
+    };
   //ETX
 
   // Description:
@@ -207,6 +227,31 @@ public:
   vtkSetClampMacro(FixedBasisEnergy,double,0.,1.);
   vtkGetMacro(FixedBasisEnergy,double);
 
+  // Description:
+  // This determines how the principal components are computed.
+  //
+  // When set to vtkPCAStatistics::COVARIANCE_SVD (the default), the SVD of the
+  // covariance matrix computed by the superclass is used.
+  //
+  // When set to vtkPCAStatistics::TALL_SKINNY_QR, the learn operation also
+  // computes the triangular factor R of the centered data, and the SVD of R is
+  // used instead: the eigenvalues are the squares of its singular values
+  // divided by n - 1. This is more accurate, and faster to learn, for tables
+  // with many columns. The TRIANGLE_SPECIFIED normalization, which cannot be
+  // applied to R, and models without R (e.g., learned with the other scheme
+  // or with the MedianAbsoluteDeviation option), use the covariance matrix.
+  vtkSetMacro(DecompositionScheme,int);
+  vtkGetMacro(DecompositionScheme,int);
+  virtual const char* GetDecompositionSchemeName( int schemeIndex );
+  virtual void SetDecompositionSchemeByName( const char* schemeName );
+
+  // Description:
+  // Given a collection of models, calculate aggregate model.
+  // The triangular factors of the models, if all of them have one, are
+  // aggregated as well.
+  virtual void Aggregate( vtkDataObjectCollection*,
+                          vtkMultiBlockDataSet* );
+
   // Description:
   // A convenience method (in particular for access from other applications) to
   // set parameter values.
@@ -225,6 +270,12 @@ protected:
   // We override FillInputPortInformation to indicate this.
   virtual int FillInputPortInformation( int port, vtkInformation* info );
 
+  // Description:
+  // Execute the calculations required by the Learn option.
+  virtual void Learn( vtkTable*,
+                      vtkTable*,
+                      vtkMultiBlockDataSet* );
+
   // Description:
   // Execute the calculations required by the Derive option.
   virtual void Derive( vtkMultiBlockDataSet* );
@@ -259,10 +310,12 @@ protected:
   int BasisScheme;
   int FixedBasisSize;
   double FixedBasisEnergy;
+  int DecompositionScheme;
 
   //BTX
   static const char* BasisSchemeEnumNames[NUM_BASIS_SCHEMES + 1];
   static const char* NormalizationSchemeEnumNames[NUM_NORMALIZATION_SCHEMES + 1];
+  static const char* DecompositionSchemeEnumNames[NUM_DECOMPOSITION_SCHEMES + 1];
   //ETX
 
 private:
@@ -0,0 +1,429 @@
+/*=========================================================================
+
+Program:   Visualization Toolkit
+Module:    vtkQuantileSketch.cxx
+
+Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+All rights reserved.
+See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkQuantileSketch.h"
+
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+
+#include <vtksys/stl/algorithm>
+#include <vtksys/stl/utility>
+#include <vtksys/stl/vector>
+
+vtkStandardNewMacro(vtkQuantileSketch);
+
+// ----------------------------------------------------------------------
+class vtkQuantileSketch::vtkInternals
+{
+public:
+  // Values of each level, a value of level h standing for 2^h inputs
+  vtksys_stl::vector<vtksys_stl::vector<double> > Levels;
+
+  // Which one of each pair is promoted at the next compaction of a level.
+  // It alternates so that the errors of successive compactions cancel out.
+  vtksys_stl::vector<int> Parities;
+
+  void AddLevel()
+  {
+    this->Levels.push_back( vtksys_stl::vector<double>() );
+    this->Parities.push_back( 0 );
+  }
+};
+
+namespace
+{
+// ----------------------------------------------------------------------
+template <class T>
+void vtkQuantileSketchInsertValues( vtkQuantileSketch* sketch,
+                                    const T* data,
+                                    vtkIdType nTuples,
+                                    int nComps )
+{
+  for ( vtkIdType i = 0; i < nTuples; ++ i, data += nComps )
+    {
+    sketch->InsertValue( static_cast<double>( *data ) );
+    }
+}
+
+// ----------------------------------------------------------------------
+// Upper bound on the rank error of a sketch of count values: a compaction
+// of level h removes at least capacity values of weight 2^h from it, so
+// level h is compacted at most count / ( capacity * 2^h ) times.
+vtkIdType vtkQuantileSketchErrorBound( vtkIdType capacity, vtkIdType count )
+{
+  vtkIdType bound = 0;
+  for ( vtkIdType weight = 1; weight <= count / capacity; weight <<= 1 )
+    {
+    bound += weight * ( count / ( capacity * weight ) );
+    }
+  return bound;
+}
+
+// ----------------------------------------------------------------------
+// Whether a serialized value is a whole number between 0 and maximum, so
+// that it can be used as a count.
+bool vtkQuantileSketchIsCount( double value, double maximum )
+{
+  return vtkMath::IsFinite( value )
+    && value >= 0.
+    && value <= maximum
+    && floor( value ) == value;
+}
+}
+
+// ----------------------------------------------------------------------
+vtkQuantileSketch::vtkQuantileSketch()
+{
+  this->Capacity = 1024;
+  this->NumberOfValues = 0;
+  this->RankErrorBound = 0;
+  this->Internals = new vtkInternals;
+}
+
+// ----------------------------------------------------------------------
+vtkQuantileSketch::~vtkQuantileSketch()
+{
+  delete this->Internals;
+}
+
+// ----------------------------------------------------------------------
+void vtkQuantileSketch::PrintSelf( ostream& os, vtkIndent indent )
+{
+  this->Superclass::PrintSelf( os, indent );
+  os << indent << "Capacity: " << this->Capacity << endl;
+  os << indent << "NumberOfValues: " << this->NumberOfValues << endl;
+  os << indent << "RankErrorBound: " << this->RankErrorBound << endl;
+  os << indent << "Number of levels: " << this->Internals->Levels.size() << endl;
+}
+
+// ----------------------------------------------------------------------
+void vtkQuantileSketch::SetCapacity( vtkIdType capacity )
+{
+  capacity = capacity < 2 ? 2 : capacity + ( capacity & 1 );
+  if ( capacity == this->Capacity )
+    {
+    return;
+    }
+
+  this->Capacity = capacity;
+  this->Initialize();
+}
+
+// ----------------------------------------------------------------------
+vtkIdType vtkQuantileSketch::ComputeCapacity( double relativeError,
+                                              vtkIdType count )
+{
+  if ( count < 1 )
+    {
+    return 2;
+    }
+
+  vtkIdType tolerance = relativeError > 0. ?
+    static_cast<vtkIdType>( floor( relativeError * count ) ) : 0;
+
+  // No compaction happens with more than count values per level, hence an
+  // exact sketch
+  vtkIdType lo = 1;
+  vtkIdType hi = count / 2 + 1;
+
+  // Search for the smallest even capacity whose bound is small enough,
+  // knowing that the bound decreases as the capacity grows
+  while ( lo < hi )
+    {
+    vtkIdType mid = lo + ( hi - lo ) / 2;
+    if ( vtkQuantileSketchErrorBound( 2 * mid, count ) <= tolerance )
+      {
+      hi = mid;
+      }
+    else
+      {
+      lo = mid + 1;
+      }
+    }
+
+  return 2 * lo;
+}
+
+// ----------------------------------------------------------------------
+void vtkQuantileSketch::Initialize()
+{
+  this->NumberOfValues = 0;
+  this->RankErrorBound = 0;
+  this->Internals->Levels.clear();
+  this->Internals->Parities.clear();
+  this->Modified();
+}
+
+// ----------------------------------------------------------------------
+void vtkQuantileSketch::InsertValue( double value )
+{
+  // Values that cannot be ordered are ignored
+  if ( vtkMath::IsNan( value ) )
+    {
+    return;
+    }
+
+  if ( this->Internals->Levels.empty() )
+    {
+    this->Internals->AddLevel();
+    }
+
+  vtksys_stl::vector<double>& level0 = this->Internals->Levels[0];
+  level0.push_back( value );
+  ++ this->NumberOfValues;
+
+  if ( static_cast<vtkIdType>( level0.size() ) >= this->Capacity )
+    {
+    this->Compress();
+    }
+}
+
+// ----------------------------------------------------------------------
+void vtkQuantileSketch::InsertValues( vtkDataArray* arr )
+{
+  if ( ! arr )
+    {
+    return;
+    }
+
+  vtkIdType nTuples = arr->GetNumberOfTuples();
+  int nComps = arr->GetNumberOfComponents();
+  switch ( arr->GetDataType() )
+    {
+    vtkTemplateMacro(
+      vtkQuantileSketchInsertValues( this,
+                                     static_cast<VTK_TT*>( arr->GetVoidPointer( 0 ) ),
+                                     nTuples,
+                                     nComps ) );
+    default:
+      for ( vtkIdType i = 0; i < nTuples; ++ i )
+        {
+        this->InsertValue( arr->GetComponent( i, 0 ) );
+        }
+    }
+
+  this->Modified();
+}
+
+// ----------------------------------------------------------------------
+bool vtkQuantileSketch::Merge( vtkQuantileSketch* other )
+{
+  if ( ! other )
+    {
+    return false;
+    }
+
+  // RankErrorBound accounts for every compaction whatever the capacity it
+  // was made with, so that it remains valid
+  if ( other->Capacity > this->Capacity )
+    {
+    this->Capacity = other->Capacity;
+    }
+
+  vtksys_stl::vector<vtksys_stl::vector<double> >& levels = this->Internals->Levels;
+  const vtksys_stl::vector<vtksys_stl::vector<double> >& otherLevels = other->Internals->Levels;
+  while ( levels.size() < otherLevels.size() )
+    {
+    this->Internals->AddLevel();
+    }
+  for ( size_t h = 0; h < otherLevels.size(); ++ h )
+    {
+    levels[h].insert( levels[h].end(), otherLevels[h].begin(), otherLevels[h].end() );
+    }
+
+  this->NumberOfValues += other->NumberOfValues;
+  this->RankErrorBound += other->RankErrorBound;
+  this->Compress();
+  this->Modified();
+
+  return true;
+}
+
+// ----------------------------------------------------------------------
+void vtkQuantileSketch::Compress()
+{
+  vtksys_stl::vector<vtksys_stl::vector<double> >& levels = this->Internals->Levels;
+  for ( size_t h = 0; h < levels.size(); ++ h )
+    {
+    if ( static_cast<vtkIdType>( levels[h].size() ) < this->Capacity )
+      {
+      continue;
+      }
+
+    if ( h + 1 == levels.size() )
+      {
+      this->Internals->AddLevel();
+      }
+
+    vtksys_stl::vector<double>& level = levels[h];
+    vtksys_stl::vector<double>& next = levels[h + 1];
+    vtksys_stl::sort( level.begin(), level.end() );
+
+    // Promote one value of each pair; if their number is odd, the largest
+    // value stays in this level
+    size_t nPaired = level.size() & ~static_cast<size_t>( 1 );
+    int& parity = this->Internals->Parities[h];
+    for ( size_t i = parity; i < nPaired; i += 2 )
+      {
+      next.push_back( level[i] );
+      }
+    parity = 1 - parity;
+
+    if ( nPaired < level.size() )
+      {
+      level[0] = level.back();
+      level.resize( 1 );
+      }
+    else
+      {
+      level.clear();
+      }
+
+    this->RankErrorBound += static_cast<vtkIdType>( 1 ) << h;
+    }
+}
+
+// ----------------------------------------------------------------------
+vtkIdType vtkQuantileSketch::GetNumberOfRetainedValues()
+{
+  vtkIdType n = 0;
+  for ( size_t h = 0; h < this->Internals->Levels.size(); ++ h )
+    {
+    n += static_cast<vtkIdType>( this->Internals->Levels[h].size() );
+    }
+  return n;
+}
+
+// ----------------------------------------------------------------------
+void vtkQuantileSketch::GetHistogram( vtkDoubleArray* values,
+                                      vtkIdTypeArray* cardinalities )
+{
+  if ( ! values || ! cardinalities )
+    {
+    return;
+    }
+
+  // Pair each retained value with the number of inputs it stands for
+  vtksys_stl::vector<vtksys_stl::pair<double,vtkIdType> > weighted;
+  weighted.reserve( this->GetNumberOfRetainedValues() );
+  const vtksys_stl::vector<vtksys_stl::vector<double> >& levels = this->Internals->Levels;
+  for ( size_t h = 0; h < levels.size(); ++ h )
+    {
+    vtkIdType weight = static_cast<vtkIdType>( 1 ) << h;
+    for ( vtksys_stl::vector<double>::const_iterator it = levels[h].begin();
+          it != levels[h].end(); ++ it )
+      {
+      weighted.push_back( vtksys_stl::make_pair( *it, weight ) );
+      }
+    }
+  vtksys_stl::sort( weighted.begin(), weighted.end() );
+
+  values->SetNumberOfComponents( 1 );
+  values->SetNumberOfTuples( 0 );
+  cardinalities->SetNumberOfComponents( 1 );
+  cardinalities->SetNumberOfTuples( 0 );
+  for ( size_t i = 0; i < weighted.size(); )
+    {
+    double value = weighted[i].first;
+    vtkIdType card = 0;
+    for ( ; i < weighted.size() && weighted[i].first == value; ++ i )
+      {
+      card += weighted[i].second;
+      }
+    values->InsertNextValue( value );
+    cardinalities->InsertNextValue( card );
+    }
+}
+
+// ----------------------------------------------------------------------
+void vtkQuantileSketch::Serialize( vtkDoubleArray* arr )
+{
+  if ( ! arr )
+    {
+    return;
+    }
+
+  // Layout: capacity, number of values, error bound, number of levels, then
+  // the parity, size and values of each level
+  const vtksys_stl::vector<vtksys_stl::vector<double> >& levels = this->Internals->Levels;
+  arr->SetNumberOfComponents( 1 );
+  arr->SetNumberOfTuples( 4 + 2 * levels.size() + this->GetNumberOfRetainedValues() );
+  double* ptr = arr->GetPointer( 0 );
+  *ptr ++ = static_cast<double>( this->Capacity );
+  *ptr ++ = static_cast<double>( this->NumberOfValues );
+  *ptr ++ = static_cast<double>( this->RankErrorBound );
+  *ptr ++ = static_cast<double>( levels.size() );
+  for ( size_t h = 0; h < levels.size(); ++ h )
+    {
+    *ptr ++ = this->Internals->Parities[h];
+    *ptr ++ = static_cast<double>( levels[h].size() );
+    ptr = vtksys_stl::copy( levels[h].begin(), levels[h].end(), ptr );
+    }
+}
+
+// ----------------------------------------------------------------------
+bool vtkQuantileSketch::Deserialize( vtkDoubleArray* arr )
+{
+  if ( ! arr
+       || arr->GetNumberOfComponents() != 1
+       || arr->GetNumberOfTuples() < 4 )
+    {
+    return false;
+    }
+
+  const double* ptr = arr->GetPointer( 0 );
+  const double* end = ptr + arr->GetNumberOfTuples();
+  // Half the largest id, which a double represents exactly.
+  const double maxCount = static_cast<double>( VTK_ID_MAX >> 1 );
+  if ( ! vtkQuantileSketchIsCount( ptr[0], maxCount )
+       || ! vtkQuantileSketchIsCount( ptr[1], maxCount )
+       || ! vtkQuantileSketchIsCount( ptr[2], maxCount )
+       || ! vtkQuantileSketchIsCount( ptr[3], static_cast<double>( end - ptr - 4 ) / 2. ) )
+    {
+    return false;
+    }
+  vtkIdType capacity = static_cast<vtkIdType>( ptr[0] );
+  if ( capacity < 2 || capacity & 1 )
+    {
+    return false;
+    }
+
+  this->Capacity = capacity;
+  this->Initialize();
+  this->NumberOfValues = static_cast<vtkIdType>( ptr[1] );
+  this->RankErrorBound = static_cast<vtkIdType>( ptr[2] );
+  size_t nLevels = static_cast<size_t>( ptr[3] );
+  ptr += 4;
+  for ( size_t h = 0; h < nLevels; ++ h )
+    {
+    // A level is its parity and its size, followed by its values, which
+    // must all lie within the array.
+    if ( end - ptr < 2
+         || ! vtkQuantileSketchIsCount( ptr[1], static_cast<double>( end - ptr - 2 ) ) )
+      {
+      this->Initialize();
+      return false;
+      }
+    this->Internals->AddLevel();
+    this->Internals->Parities[h] = ptr[0] ? 1 : 0;
+    size_t size = static_cast<size_t>( ptr[1] );
+    ptr += 2;
+    this->Internals->Levels[h].assign( ptr, ptr + size );
+    ptr += size;
+    }
+
+  return true;
+}
@@ -0,0 +1,134 @@
+/*=========================================================================
+
+Program:   Visualization Toolkit
+Module:    vtkQuantileSketch.h
+
+Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+All rights reserved.
+See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkQuantileSketch - A mergeable summary of a numeric variable for
+// approximate quantiles
+//
+// .SECTION Description
+// vtkQuantileSketch summarizes a stream of values in a bounded amount of
+// memory so that the rank of any value, and thus any quantile, can be
+// recovered within a known error.  The values are kept in levels: a value
+// of level h stands for 2^h values of the input.  When a level holds
+// Capacity values, it is sorted and every other value is promoted to the
+// next level (one value is held back when their number is odd).  Each such
+// compaction of level h moves the rank of any value by at most 2^h, and
+// the sum of these moves is kept as RankErrorBound, so that the error is
+// guaranteed rather than probabilistic.
+//
+// Two sketches are merged by concatenating their levels and compacting the
+// full ones, so that partial sketches computed on separate pieces of the
+// data (on several processes, or on successive chunks of a stream) give a
+// sketch of the whole data set whose error bound still holds.
+// ComputeCapacity returns a Capacity for which the rank error is at most a
+// given fraction of the number of values, whichever the order in which
+// values are inserted and sketches of that Capacity merged.
+//
+// .SECTION See Also
+// vtkOrderStatistics vtkPOrderStatistics
+
+#ifndef __vtkQuantileSketch_h
+#define __vtkQuantileSketch_h
+
+#include "vtkFiltersStatisticsModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkDataArray;
+class vtkDoubleArray;
+class vtkIdTypeArray;
+
+class VTKFILTERSSTATISTICS_EXPORT vtkQuantileSketch : public vtkObject
+{
+public:
+  static vtkQuantileSketch* New();
+  vtkTypeMacro(vtkQuantileSketch, vtkObject);
+  void PrintSelf( ostream& os, vtkIndent indent );
+
+  // Description:
+  // Set/Get the number of values a level holds before it is compacted.
+  // It is rounded up to an even number of at least 2.  Setting it
+  // empties the sketch.  Default is 1024.
+  void SetCapacity( vtkIdType );
+  vtkGetMacro( Capacity, vtkIdType );
+
+  // Description:
+  // Return the smallest Capacity for which the rank error of a sketch of
+  // count values is at most relativeError * count.  A nonpositive
+  // relativeError asks for exact ranks, which a sketch can only give by
+  // holding all values.
+  static vtkIdType ComputeCapacity( double relativeError, vtkIdType count );
+
+  // Description:
+  // Empty the sketch.
+  void Initialize();
+
+  // Description:
+  // Add one value, or the first component of all tuples of an array, to
+  // the sketch.
+  void InsertValue( double );
+  void InsertValues( vtkDataArray* );
+
+  // Description:
+  // Add the values summarized by another sketch.  The larger Capacity of
+  // the two is kept.  Return false if there is no other sketch.
+  bool Merge( vtkQuantileSketch* );
+
+  // Description:
+  // Get the number of values summarized by the sketch.
+  vtkGetMacro( NumberOfValues, vtkIdType );
+
+  // Description:
+  // Get the largest difference between the rank of a value in the sketch
+  // and its rank among the values that were inserted.
+  vtkGetMacro( RankErrorBound, vtkIdType );
+
+  // Description:
+  // Get the number of values held by the sketch.
+  vtkIdType GetNumberOfRetainedValues();
+
+  // Description:
+  // Fill values with the distinct values held by the sketch in increasing
+  // order, and cardinalities with the number of input values each one
+  // stands for.  The cardinalities add up to NumberOfValues.
+  void GetHistogram( vtkDoubleArray* values, vtkIdTypeArray* cardinalities );
+
+  // Description:
+  // Write the sketch to a single component array, or read it back.  This
+  // is how sketches are sent between processes and stored in models.
+  // Deserialize returns false if the array does not hold a sketch.
+  void Serialize( vtkDoubleArray* );
+  bool Deserialize( vtkDoubleArray* );
+
+protected:
+  vtkQuantileSketch();
+  ~vtkQuantileSketch();
+
+  // Description:
+  // Compact all the levels that are full, from the bottom up.
+  void Compress();
+
+  vtkIdType Capacity;
+  vtkIdType NumberOfValues;
+  vtkIdType RankErrorBound;
+
+//BTX
+  class vtkInternals;
+  vtkInternals* Internals;
+//ETX
+
+private:
+  vtkQuantileSketch(const vtkQuantileSketch&); // Not implemented
+  void operator=(const vtkQuantileSketch&);   // Not implemented
+};
+
+#endif
@@ -23,6 +23,9 @@ PURPOSE.  See the above copyright notice for more information.
 // All statistics algorithms can conceptually be operated with several operations:
 // * Learn: given an input data set, calculate a minimal statistical model (e.g.,
 //   sums, raw moments, joint probabilities).
+// * Aggregate: given a collection of minimal statistical models learned from
+//   disjoint pieces of a data set, calculate the minimal model of the whole data
+//   set, as if it had been learned at once.
 // * Derive: given an input minimal statistical model, derive the full model
 //   (e.g., descriptive statistics, quantiles, correlations, conditional
 //    probabilities).
@@ -31,6 +34,13 @@ PURPOSE.  See the above copyright notice for more information.
 //   model after all partial calculations have completed. On the other hand, one
 //   can also directly provide a full model, that was previously calculated or
 //   guessed, and not derive a new one.
+// Learn, Aggregate, and Derive are what makes a statistics algorithm usable on
+// data that is not resident all at once: each chunk of a table, or the piece of
+// each process, is learned separately, the partial models are aggregated, and
+// the full model is derived once from the aggregate. This is how
+// vtkStreamingStatistics and the parallel subclasses of the algorithms proceed.
+// Aggregate must therefore ignore models learned from empty pieces, and
+// accept models to which derived statistics were added.
 // * Assess: given an input data set, input statistics, and some form of
 //   threshold, assess a subset of the data set.
 // * Test: perform at least one statistical test.
@@ -244,7 +254,8 @@ public:
                              vtkVariant value );
 
   // Description:
-  // Given a collection of models, calculate aggregate model
+  // Given a collection of models, calculate aggregate model.
+  // The output model may be one of the models of the collection.
   virtual void Aggregate( vtkDataObjectCollection*,
                           vtkMultiBlockDataSet* ) = 0;
 
@@ -21,10 +21,13 @@
 #include "vtkStreamingStatistics.h"
 
 #include "vtkDataObjectCollection.h"
+#include "vtkExecutive.h"
 #include "vtkInformation.h"
+#include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
 #include "vtkStatisticsAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
 
 vtkStandardNewMacro(vtkStreamingStatistics);
@@ -46,6 +49,10 @@ vtkStreamingStatistics::vtkStreamingStatistics()
 
   // Initialize internal model
   this->InternalModel = vtkMultiBlockDataSet::New();
+
+  // Learn the input as it comes by default
+  this->NumberOfChunks = 0;
+  this->CurrentChunk = 0;
 }
 
 // ----------------------------------------------------------------------
@@ -108,7 +115,38 @@ int vtkStreamingStatistics::FillOutputPortInformation( int port, vtkInformation*
 }
 
 // ----------------------------------------------------------------------
-int vtkStreamingStatistics::RequestData( vtkInformation*,
+int vtkStreamingStatistics::RequestUpdateExtent( vtkInformation* request,
+                                                 vtkInformationVector** inputVector,
+                                                 vtkInformationVector* outputVector )
+{
+  vtkInformation* inInfo = inputVector[INPUT_DATA]->GetInformationObject( 0 );
+  if ( this->NumberOfChunks < 1 || ! inInfo )
+    {
+    return 1;
+    }
+
+  // Split the piece requested downstream in as many chunks, and request the current one
+  int port = request->Get( vtkExecutive::FROM_OUTPUT_PORT() );
+  vtkInformation* outInfo = outputVector->GetInformationObject( port > 0 ? port : 0 );
+  int piece = 0;
+  int numPieces = 1;
+  if ( outInfo->Has( vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES() ) )
+    {
+    piece = outInfo->Get( vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER() );
+    numPieces = outInfo->Get( vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES() );
+    }
+
+  inInfo->Set( vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+               piece * this->NumberOfChunks + this->CurrentChunk );
+  inInfo->Set( vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+               numPieces * this->NumberOfChunks );
+  inInfo->Set( vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(), 0 );
+
+  return 1;
+}
+
+// ----------------------------------------------------------------------
+int vtkStreamingStatistics::RequestData( vtkInformation* request,
                                          vtkInformationVector** inputVector,
                                          vtkInformationVector* outputVector )
 {
@@ -139,6 +177,51 @@ int vtkStreamingStatistics::RequestData( vtkInformation*,
     return 0;
     }
 
+  // When learning chunks, start from an empty model, and only learn and
+  // aggregate until the last chunk, which is also derived, assessed and tested
+  bool learn = this->StatisticsAlgorithm->GetLearnOption();
+  bool derive = this->StatisticsAlgorithm->GetDeriveOption();
+  bool assess = this->StatisticsAlgorithm->GetAssessOption();
+  bool test = this->StatisticsAlgorithm->GetTestOption();
+  vtkInformation* inInfo = inputVector[INPUT_DATA]->GetInformationObject( 0 );
+  bool lastChunk = true;
+  if ( this->NumberOfChunks > 0 && inInfo )
+    {
+    if ( ! this->CurrentChunk )
+      {
+      this->InternalModel->Initialize();
+      }
+
+    // A source which does not provide pieces either does not execute again,
+    // or provides all rows for each piece: learn its output only once
+    vtkInformation* dataInfo = inData ? inData->GetInformation() : 0;
+    if ( ! dataInfo
+         || ! dataInfo->Has( vtkDataObject::DATA_PIECE_NUMBER() )
+         || dataInfo->Get( vtkDataObject::DATA_PIECE_NUMBER() )
+         != inInfo->Get( vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER() )
+         || dataInfo->Get( vtkDataObject::DATA_NUMBER_OF_PIECES() )
+         != inInfo->Get( vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES() ) )
+      {
+      vtkWarningMacro( "Input does not provide the requested pieces. It is learned as a single chunk." );
+      if ( this->CurrentChunk )
+        {
+        // These rows were already learned as the first chunk
+        this->StatisticsAlgorithm->SetLearnOption( false );
+        }
+      }
+    else
+      {
+      lastChunk = ( this->CurrentChunk + 1 >= this->NumberOfChunks );
+      }
+
+    if ( ! lastChunk )
+      {
+      this->StatisticsAlgorithm->SetDeriveOption( false );
+      this->StatisticsAlgorithm->SetAssessOption( false );
+      this->StatisticsAlgorithm->SetTestOption( false );
+      }
+    }
+
   // Set the input into my stats algorithms
   this->StatisticsAlgorithm->SetInputData(inData);
   this->StatisticsAlgorithm->SetLearnOptionParameters( inParameters );
@@ -147,6 +230,12 @@ int vtkStreamingStatistics::RequestData( vtkInformation*,
   // Force an update
   this->StatisticsAlgorithm->Update();
 
+  // Restore the options of the statistics algorithm
+  this->StatisticsAlgorithm->SetLearnOption( learn );
+  this->StatisticsAlgorithm->SetDeriveOption( derive );
+  this->StatisticsAlgorithm->SetAssessOption( assess );
+  this->StatisticsAlgorithm->SetTestOption( test );
+
   // Grab (DeepCopy) the model for next time
   this->InternalModel->DeepCopy( this->StatisticsAlgorithm->GetOutputDataObject( OUTPUT_MODEL ) );
 
@@ -155,12 +244,21 @@ int vtkStreamingStatistics::RequestData( vtkInformation*,
   outModel->ShallowCopy( this->StatisticsAlgorithm->GetOutputDataObject( OUTPUT_MODEL ) );
   outTest->ShallowCopy( this->StatisticsAlgorithm->GetOutput( OUTPUT_TEST ) );
 
+  // Request the next chunk, or get ready for the next update
+  if ( lastChunk )
+    {
+    request->Remove( vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING() );
+    this->CurrentChunk = 0;
+    }
+  else
+    {
+    request->Set( vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1 );
+    ++ this->CurrentChunk;
+    }
+
   return 1;
 }
 
-
-
-
 // ----------------------------------------------------------------------
 void vtkStreamingStatistics::PrintSelf( ostream &os, vtkIndent indent )
 {
@@ -172,4 +270,5 @@ void vtkStreamingStatistics::PrintSelf( ostream &os, vtkIndent indent )
     this->StatisticsAlgorithm->PrintSelf(os,i2);
     }
   os << indent << "InternalModel: " << this->InternalModel << "\n";
+  os << indent << "NumberOfChunks: " << this->NumberOfChunks << "\n";
 }
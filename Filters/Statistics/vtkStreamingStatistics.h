@@ -24,6 +24,20 @@ PURPOSE.  See the above copyright notice for more information.
 // A class for using the statistics filters in a streaming mode or perhaps
 // an "online, incremental, push" mode.
 //
+// By default, each update learns the input table it is given and aggregates
+// the result with the model of the previous updates, so that tables pushed
+// one after the other are summarized as if they were a single one.
+// When NumberOfChunks is positive, a single update instead requests that many
+// pieces of the input, one after the other, from the upstream pipeline: each
+// piece is learned, aggregated with the previous ones, and discarded, and the
+// full model is derived once all of them were seen. The input thus never has to
+// hold more than one piece of the rows, which makes it possible to calculate
+// statistics of tables larger than memory, provided that the source of the
+// table honors requests for pieces. If the algorithm is a parallel one, the
+// piece of each process is itself split into chunks.
+// Learn, Aggregate, and Derive are the operations of vtkStatisticsAlgorithm
+// which make this possible.
+//
 // .SECTION Thanks
 // Thanks to the Universe for unfolding in a way that allowed this class
 // to be implemented, also Godzilla for not crushing my computer.
@@ -69,6 +83,16 @@ public:
 
   virtual void SetStatisticsAlgorithm(vtkStatisticsAlgorithm*);
 
+  // Description:
+  // Set/Get the number of pieces in which the input table is requested and
+  // learned at each update. The output data is then the last piece of the
+  // input. When the input cannot provide pieces, e.g. when it is a table set
+  // with SetInputData, it is learned at once with a warning. Default is 0,
+  // which learns the input as it is at each update and aggregates it with the
+  // previous ones.
+  vtkSetClampMacro( NumberOfChunks, int, 0, VTK_INT_MAX );
+  vtkGetMacro( NumberOfChunks, int );
+
 protected:
   vtkStreamingStatistics();
   ~vtkStreamingStatistics();
@@ -76,11 +100,19 @@ protected:
   virtual int FillInputPortInformation( int port, vtkInformation* info );
   virtual int FillOutputPortInformation( int port, vtkInformation* info );
 
+  virtual int RequestUpdateExtent(
+    vtkInformation*,
+    vtkInformationVector**,
+    vtkInformationVector* );
+
   virtual int RequestData(
     vtkInformation*,
     vtkInformationVector**,
     vtkInformationVector* );
 
+  int NumberOfChunks;
+  int CurrentChunk;
+
 private:
   vtkStreamingStatistics( const vtkStreamingStatistics& ); // Not implemented
   void operator = ( const vtkStreamingStatistics& );   // Not implemented
@@ -0,0 +1,82 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestZstdCompress.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkZstdDataCompressor
+// .SECTION Description
+// Compress and uncompress a buffer at fast, default and strong levels.
+
+#include "vtkNew.h"
+#include "vtkZstdDataCompressor.h"
+
+#include <vector>
+
+int TestZstdCompress(int, char *[])
+{
+  const size_t size = 100024;
+  std::vector<unsigned char> buffer(size);
+  for (size_t i = 0; i < size; i++)
+    {
+    buffer[i] = static_cast<unsigned char>((i % 251) ^ (i / 4096));
+    }
+
+  vtkNew<vtkZstdDataCompressor> compressor;
+  int levels[3] = { -5, 3, 19 };
+  size_t previous = 0;
+  for (int l = 0; l < 3; l++)
+    {
+    compressor->SetCompressionLevel(levels[l]);
+    size_t space = compressor->GetMaximumCompressionSpace(size);
+    std::vector<unsigned char> cbuffer(space);
+    size_t clen = compressor->Compress(&buffer[0], size, &cbuffer[0], space);
+    if (clen == 0 || clen >= size)
+      {
+      cerr << "Level " << levels[l] << " did not compress: " << clen << "\n";
+      return 1;
+      }
+
+    // stronger levels must not give larger data on this input
+    if (previous && clen > previous)
+      {
+      cerr << "Level " << levels[l] << " gave " << clen
+           << " bytes instead of at most " << previous << "\n";
+      return 1;
+      }
+    previous = clen;
+
+    std::vector<unsigned char> ucbuffer(size);
+    size_t ulen = compressor->Uncompress(&cbuffer[0], clen,
+                                         &ucbuffer[0], size);
+    if (ulen != size || ucbuffer != buffer)
+      {
+      cerr << "Level " << levels[l] << " did not restore the data\n";
+      return 1;
+      }
+
+    // corrupt data must be reported, not silently accepted
+    if (l == 0)
+      {
+      int errorDisplay = vtkObject::GetGlobalWarningDisplay();
+      vtkObject::GlobalWarningDisplayOff();
+      ulen = compressor->Uncompress(&cbuffer[0], clen/2, &ucbuffer[0], size);
+      vtkObject::SetGlobalWarningDisplay(errorDisplay);
+      if (ulen != 0)
+        {
+        cerr << "Truncated data were uncompressed\n";
+        return 1;
+        }
+      }
+    }
+
+  return 0;
+}
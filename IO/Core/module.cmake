@@ -7,6 +7,7 @@ vtk_module(vtkIOCore
     vtkCommonMisc
   PRIVATE_DEPENDS
     vtkzlib
+    vtkzstd
     vtksys
   TEST_DEPENDS
     vtkTestingCore
@@ -0,0 +1,132 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryMappedFile.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMemoryMappedFile.h"
+#include "vtkInformationObjectBaseKey.h"
+#include "vtkObjectFactory.h"
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+# define VTK_MEMORY_MAPPED_FILE_WIN32
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+vtkStandardNewMacro(vtkMemoryMappedFile);
+vtkInformationKeyMacro(vtkMemoryMappedFile, MAPPED_FILE, ObjectBase);
+
+//----------------------------------------------------------------------------
+vtkMemoryMappedFile::vtkMemoryMappedFile()
+{
+  this->FileName = 0;
+  this->Data = 0;
+  this->Size = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkMemoryMappedFile::~vtkMemoryMappedFile()
+{
+  this->Close();
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryMappedFile::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "FileName: "
+     << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "Size: " << this->Size << "\n";
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryMappedFile::Open(const char* fileName)
+{
+  this->Close();
+  if (!fileName)
+    {
+    return 0;
+    }
+
+#if defined(VTK_MEMORY_MAPPED_FILE_WIN32)
+  HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    {
+    return 0;
+    }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+    CloseHandle(file);
+    return 0;
+    }
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+  CloseHandle(file);
+  if (!mapping)
+    {
+    return 0;
+    }
+  void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!data)
+    {
+    return 0;
+    }
+  this->Size = static_cast<vtkTypeUInt64>(size.QuadPart);
+#else
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+    {
+    return 0;
+    }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+    close(fd);
+    return 0;
+    }
+  void* data = mmap(0, static_cast<size_t>(st.st_size),
+                    PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    {
+    return 0;
+    }
+  this->Size = static_cast<vtkTypeUInt64>(st.st_size);
+#endif
+
+  this->Data = static_cast<unsigned char*>(data);
+  this->SetFileName(fileName);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryMappedFile::Close()
+{
+  if (this->Data)
+    {
+#if defined(VTK_MEMORY_MAPPED_FILE_WIN32)
+    UnmapViewOfFile(this->Data);
+#else
+    munmap(this->Data, static_cast<size_t>(this->Size));
+#endif
+    }
+  this->Data = 0;
+  this->Size = 0;
+  this->SetFileName(0);
+}
@@ -0,0 +1,83 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryMappedFile.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMemoryMappedFile - Map a file into memory.
+// .SECTION Description
+// vtkMemoryMappedFile maps a whole file into the address space of the
+// process, so that its contents are read from disk only when the pages
+// are first accessed.  The mapping is private: the memory can be
+// modified, for instance to swap the byte order of the data, without
+// changing the file.
+//
+// Data arrays that point into the mapping with SetVoidArray() keep the
+// mapping alive by storing it in their information under the
+// MAPPED_FILE() key.  The file is unmapped when the last reference is
+// released.
+
+#ifndef __vtkMemoryMappedFile_h
+#define __vtkMemoryMappedFile_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkInformationObjectBaseKey;
+
+class VTKIOCORE_EXPORT vtkMemoryMappedFile : public vtkObject
+{
+public:
+  vtkTypeMacro(vtkMemoryMappedFile,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+  static vtkMemoryMappedFile* New();
+
+  // Description:
+  // Map the given file, after unmapping any previous file.  Returns 1
+  // for success and 0 if the file could not be mapped.
+  int Open(const char* fileName);
+
+  // Description:
+  // Unmap the file.  This must not be called while data arrays point
+  // into the mapping; release the reference to the mapping instead.
+  void Close();
+
+  // Description:
+  // Get the name of the mapped file, or NULL.
+  vtkGetStringMacro(FileName);
+
+  // Description:
+  // Get the start and size of the mapped memory.  The data are NULL if
+  // no file is mapped.
+  unsigned char* GetData() { return this->Data; }
+  vtkTypeUInt64 GetSize() { return this->Size; }
+
+  // Description:
+  // Key used to store the mapping in the information of the data arrays
+  // that point into it.
+  static vtkInformationObjectBaseKey* MAPPED_FILE();
+
+protected:
+  vtkMemoryMappedFile();
+  ~vtkMemoryMappedFile();
+
+  vtkSetStringMacro(FileName);
+
+  char* FileName;
+  unsigned char* Data;
+  vtkTypeUInt64 Size;
+
+private:
+  vtkMemoryMappedFile(const vtkMemoryMappedFile&);  // Not implemented.
+  void operator=(const vtkMemoryMappedFile&);  // Not implemented.
+};
+
+#endif
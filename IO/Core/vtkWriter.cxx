@@ -15,24 +15,139 @@
 #include "vtkWriter.h"
 
 #include "vtkCommand.h"
+#include "vtkConditionVariable.h"
 #include "vtkDataObject.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkErrorCode.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+#include "vtkSmartPointer.h"
 
+#include <deque>
+#include <vector>
 #include <vtksys/ios/sstream>
 
+//----------------------------------------------------------------------------
+class vtkWriterInternals
+{
+public:
+  vtkWriterInternals()
+    {
+    this->Threader = vtkMultiThreader::New();
+    this->ThreadId = -1;
+    this->Lock = vtkMutexLock::New();
+    this->Condition = vtkConditionVariable::New();
+    this->StopThread = false;
+    this->NumberOfPendingWrites = 0;
+    }
+  ~vtkWriterInternals()
+    {
+    this->Condition->Delete();
+    this->Lock->Delete();
+    this->Threader->Delete();
+    }
+
+  // An asynchronous write: a copy of the writer whose inputs are the
+  // snapshots of the inputs, and the time at which they were taken.
+  struct Job
+  {
+    vtkSmartPointer<vtkWriter> Writer;
+    std::vector<vtkSmartPointer<vtkDataObject> > Inputs;
+    unsigned long InputTime;
+    int Result;
+    unsigned long ErrorCode;
+  };
+
+  static VTK_THREAD_RETURN_TYPE WriteThreadStart(void* arg);
+  void WriteThread();
+
+  // The background thread and its synchronization.  The lock protects
+  // the members below.
+  vtkMultiThreader* Threader;
+  int ThreadId;
+  vtkMutexLock* Lock;
+  vtkConditionVariable* Condition;
+  bool StopThread;
+
+  // The writes waiting for the thread, and those that it has completed
+  // but that have not been reported yet.  The jobs are only created and
+  // destroyed by the calling thread.
+  std::deque<Job*> Queue;
+  std::deque<Job*> Completed;
+  int NumberOfPendingWrites;
+};
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkWriterInternals::WriteThreadStart(void* arg)
+{
+  vtkWriterInternals* self = static_cast<vtkWriterInternals*>(
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg)->UserData);
+  self->WriteThread();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void vtkWriterInternals::WriteThread()
+{
+  this->Lock->Lock();
+  for (;;)
+    {
+    if (this->Queue.empty())
+      {
+      // The queue is drained before the thread stops.
+      if (this->StopThread)
+        {
+        break;
+        }
+      this->Condition->Wait(this->Lock);
+      continue;
+      }
+
+    Job* job = this->Queue.front();
+    this->Queue.pop_front();
+    this->Lock->Unlock();
+    job->Result = job->Writer->Write();
+    job->ErrorCode = job->Writer->GetErrorCode();
+    this->Lock->Lock();
+    this->Completed.push_back(job);
+    this->NumberOfPendingWrites--;
+    this->Condition->Broadcast();
+    }
+  this->Lock->Unlock();
+}
+
 
 // Construct with no start and end write methods or arguments.
 vtkWriter::vtkWriter()
 {
+  this->Asynchronous = 0;
+  this->MaximumNumberOfPendingWrites = 1;
+  this->DeepCopyInput = 0;
+  this->Internals = new vtkWriterInternals;
+
   this->SetNumberOfInputPorts(1);
   this->SetNumberOfOutputPorts(0);
 }
 
 vtkWriter::~vtkWriter()
 {
+  // Complete the pending writes.
+  if (this->Internals->ThreadId >= 0)
+    {
+    this->Internals->Lock->Lock();
+    this->Internals->StopThread = true;
+    this->Internals->Condition->Broadcast();
+    this->Internals->Lock->Unlock();
+    this->Internals->Threader->TerminateThread(this->Internals->ThreadId);
+    }
+  while (!this->Internals->Completed.empty())
+    {
+    delete this->Internals->Completed.front();
+    this->Internals->Completed.pop_front();
+    }
+  delete this->Internals;
 }
 
 void vtkWriter::SetInputData(vtkDataObject *input)
@@ -134,19 +249,162 @@ int vtkWriter::RequestData(
     return 1;
     }
 
+  // Write asynchronously with a copy of this writer, if possible.
+  vtkWriterInternals::Job* job = 0;
+  if (this->Asynchronous)
+    {
+    vtkWriter* writer = this->NewInstance();
+    if (this->CopyWriterSettings(writer))
+      {
+      job = new vtkWriterInternals::Job;
+      job->Writer.TakeReference(writer);
+      job->Result = 0;
+      job->ErrorCode = vtkErrorCode::NoError;
+      }
+    else
+      {
+      writer->Delete();
+      }
+    }
+
+  if (!job)
+    {
+    this->InvokeEvent(vtkCommand::StartEvent,NULL);
+    this->WriteData();
+    this->InvokeEvent(vtkCommand::EndEvent,NULL);
+
+    this->WriteTime.Modified();
+
+    return 1;
+    }
+
+  // Report the previous writes, and wait for a write to complete if
+  // there are too many.
+  this->CollectCompletedWrites();
+  this->Internals->Lock->Lock();
+  while (this->Internals->NumberOfPendingWrites >=
+         this->MaximumNumberOfPendingWrites)
+    {
+    this->Internals->Condition->Wait(this->Internals->Lock);
+    }
+  this->Internals->Lock->Unlock();
+  this->CollectCompletedWrites();
+
+  // The copy of the writer writes a snapshot of the inputs, so that the
+  // pipeline can update the inputs while the data are written.
   this->InvokeEvent(vtkCommand::StartEvent,NULL);
-  this->WriteData();
-  this->InvokeEvent(vtkCommand::EndEvent,NULL);
+  for (idx = 0; idx < this->GetNumberOfInputPorts(); ++idx)
+    {
+    vtkDataObject* input = this->GetInput(idx);
+    if (input)
+      {
+      vtkSmartPointer<vtkDataObject> snapshot;
+      snapshot.TakeReference(input->NewInstance());
+      if (this->DeepCopyInput)
+        {
+        snapshot->DeepCopy(input);
+        }
+      else
+        {
+        snapshot->ShallowCopy(input);
+        }
+      job->Writer->SetInputData(idx, snapshot);
+      job->Inputs.push_back(snapshot);
+      }
+    }
+  job->InputTime = 0;
+  for (size_t i = 0; i < job->Inputs.size(); ++i)
+    {
+    unsigned long mtime = job->Inputs[i]->GetMTime();
+    job->InputTime = (mtime > job->InputTime ? mtime : job->InputTime);
+    }
+
+  this->Internals->Lock->Lock();
+  this->Internals->Queue.push_back(job);
+  this->Internals->NumberOfPendingWrites++;
+  if (this->Internals->ThreadId < 0)
+    {
+    this->Internals->ThreadId = this->Internals->Threader->SpawnThread(
+      &vtkWriterInternals::WriteThreadStart, this->Internals);
+    }
+  this->Internals->Condition->Broadcast();
+  this->Internals->Lock->Unlock();
 
   this->WriteTime.Modified();
 
   return 1;
 }
 
+int vtkWriter::CopyWriterSettings(vtkWriter *)
+{
+  return 0;
+}
+
+int vtkWriter::CollectCompletedWrites()
+{
+  this->Internals->Lock->Lock();
+  std::deque<vtkWriterInternals::Job*> completed;
+  completed.swap(this->Internals->Completed);
+  this->Internals->Lock->Unlock();
+
+  int result = 1;
+  for (size_t i = 0; i < completed.size(); ++i)
+    {
+    vtkWriterInternals::Job* job = completed[i];
+
+    // Arrays shared with the input must not change until they are written.
+    for (size_t j = 0; j < job->Inputs.size(); ++j)
+      {
+      if (job->Inputs[j]->GetMTime() > job->InputTime)
+        {
+        vtkWarningMacro("The input was modified while it was written "
+                        "asynchronously, turn DeepCopyInput on.");
+        break;
+        }
+      }
+
+    if (!job->Result || job->ErrorCode != vtkErrorCode::NoError)
+      {
+      this->SetErrorCode(job->ErrorCode);
+      vtkErrorMacro("Asynchronous write failed: "
+                    << vtkErrorCode::GetStringFromErrorCode(job->ErrorCode));
+      result = 0;
+      }
+    delete job;
+    this->InvokeEvent(vtkCommand::EndEvent,NULL);
+    }
+
+  return result;
+}
+
+int vtkWriter::WaitForPendingWrites()
+{
+  this->Internals->Lock->Lock();
+  while (this->Internals->NumberOfPendingWrites > 0)
+    {
+    this->Internals->Condition->Wait(this->Internals->Lock);
+    }
+  this->Internals->Lock->Unlock();
+
+  return this->CollectCompletedWrites();
+}
+
+int vtkWriter::GetNumberOfPendingWrites()
+{
+  this->Internals->Lock->Lock();
+  int number = this->Internals->NumberOfPendingWrites;
+  this->Internals->Lock->Unlock();
+  return number;
+}
+
 void vtkWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
 
+  os << indent << "Asynchronous: " << this->Asynchronous << "\n";
+  os << indent << "MaximumNumberOfPendingWrites: "
+     << this->MaximumNumberOfPendingWrites << "\n";
+  os << indent << "DeepCopyInput: " << this->DeepCopyInput << "\n";
 }
 
 void vtkWriter::EncodeString(char* resname, const char* name, bool doublePercent)
@@ -18,6 +18,10 @@
 // to disk (or into a communications port). All writers respond to Write()
 // method. This method insures that there is input and input is up to date.
 
+// Writers can also write asynchronously: Write() then only updates the
+// input and takes a snapshot of it, and the data are written on a
+// background thread while the caller continues.
+
 // .SECTION Caveats
 // Every subclass of vtkWriter must implement a WriteData() method. Most likely
 // will have to create SetInput() method as well.
@@ -32,6 +36,7 @@
 #include "vtkAlgorithm.h"
 
 class vtkDataObject;
+class vtkWriterInternals;
 
 #define VTK_ASCII 1
 #define VTK_BINARY 2
@@ -72,10 +77,67 @@ public:
   vtkDataObject *GetInput(int port);
 //ETX
 
+  // Description:
+  // Turn on/off asynchronous writing.  When on, Write() updates the input
+  // and takes a shallow copy of it, and a copy of this writer serializes
+  // and writes the copy on a background thread.  The writes are done in
+  // the order of the calls to Write().  Writers that cannot copy their
+  // settings (see CopyWriterSettings()) always write synchronously.
+  // Off by default.
+  vtkSetMacro(Asynchronous, int);
+  vtkGetMacro(Asynchronous, int);
+  vtkBooleanMacro(Asynchronous, int);
+
+  // Description:
+  // The maximum number of asynchronous writes that are queued or in
+  // progress.  Write() waits for the oldest write to complete when there
+  // are already as many.  The default of 1 overlaps the writing of each
+  // data object with the computation of the next one.
+  vtkSetClampMacro(MaximumNumberOfPendingWrites, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfPendingWrites, int);
+
+  // Description:
+  // Take a deep copy of the input instead of a shallow copy when writing
+  // asynchronously.  This is needed when the memory of the input arrays
+  // is modified in place, for instance when the arrays wrap the memory of
+  // a simulation.  A shallow copy shares the arrays, and a warning is
+  // reported if they are marked as modified before they are written.
+  // Off by default.
+  vtkSetMacro(DeepCopyInput, int);
+  vtkGetMacro(DeepCopyInput, int);
+  vtkBooleanMacro(DeepCopyInput, int);
+
+  // Description:
+  // Wait for all the asynchronous writes to complete.  Returns 0 if any
+  // of them failed.  An EndEvent is invoked on the calling thread for
+  // each completed write, here or in the next call to Write(), and the
+  // ErrorCode is set when a write fails.
+  int WaitForPendingWrites();
+
+  // Description:
+  // The number of asynchronous writes that are queued or in progress.
+  int GetNumberOfPendingWrites();
+
 protected:
   vtkWriter();
   ~vtkWriter();
 
+  // Description:
+  // Copy the settings that determine what and where this writer writes
+  // to another instance of the same class, for asynchronous writing.
+  // Returns 0 if the writer cannot be copied, which is the default.
+  // Subclasses with settings of their own must extend this method.
+  virtual int CopyWriterSettings(vtkWriter *writer);
+
+  // Description:
+  // Report the asynchronous writes that have completed.  Returns 0 if
+  // any of them failed.
+  int CollectCompletedWrites();
+
+  int Asynchronous;
+  int MaximumNumberOfPendingWrites;
+  int DeepCopyInput;
+
   virtual int ProcessRequest(vtkInformation *request,
                              vtkInformationVector **inputVector,
                              vtkInformationVector *outputVector);
@@ -86,6 +148,8 @@ protected:
   virtual void WriteData() = 0; //internal method subclasses must respond to
   vtkTimeStamp WriteTime;
 private:
+  vtkWriterInternals *Internals;
+
   vtkWriter(const vtkWriter&);  // Not implemented.
   void operator=(const vtkWriter&);  // Not implemented.
 };
@@ -0,0 +1,95 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZstdDataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkZstdDataCompressor.h"
+#include "vtkObjectFactory.h"
+#include "vtk_zstd.h"
+
+vtkStandardNewMacro(vtkZstdDataCompressor);
+
+//----------------------------------------------------------------------------
+vtkZstdDataCompressor::vtkZstdDataCompressor()
+{
+  this->CompressionLevel = 3;
+}
+
+//----------------------------------------------------------------------------
+vtkZstdDataCompressor::~vtkZstdDataCompressor()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkZstdDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkZstdDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+                                      size_t uncompressedSize,
+                                      unsigned char* compressedData,
+                                      size_t compressionSpace)
+{
+  // Call zstd's compress function.  It is safe to call it from several
+  // threads at once, each call uses its own context.
+  size_t cs = ZSTD_compress(compressedData, compressionSpace,
+                            uncompressedData, uncompressedSize,
+                            this->CompressionLevel);
+  if(ZSTD_isError(cs))
+    {
+    vtkErrorMacro("Zstd error while compressing data: "
+                  << ZSTD_getErrorName(cs));
+    return 0;
+    }
+
+  return cs;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkZstdDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+                                        size_t compressedSize,
+                                        unsigned char* uncompressedData,
+                                        size_t uncompressedSize)
+{
+  // Call zstd's decompress function.
+  size_t us = ZSTD_decompress(uncompressedData, uncompressedSize,
+                              compressedData, compressedSize);
+  if(ZSTD_isError(us))
+    {
+    vtkErrorMacro("Zstd error while uncompressing data: "
+                  << ZSTD_getErrorName(us));
+    return 0;
+    }
+
+  // Make sure the output size matched that expected.
+  if(us != uncompressedSize)
+    {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected " << uncompressedSize << " and got " << us);
+    return 0;
+    }
+
+  return us;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkZstdDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  return ZSTD_compressBound(size);
+}
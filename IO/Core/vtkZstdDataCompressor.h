@@ -0,0 +1,74 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZstdDataCompressor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkZstdDataCompressor - Data compression using Zstandard.
+// .SECTION Description
+// vtkZstdDataCompressor provides a concrete vtkDataCompressor class
+// using the Zstandard (zstd) library for compressing and uncompressing
+// data.  Zstandard compresses and, above all, uncompresses much faster
+// than zlib at a similar or better ratio.  Positive compression levels
+// trade speed for ratio, up to 22.  Negative levels select the fast
+// strategies of the library, whose speed is comparable to LZ4.
+// .SECTION See Also
+// vtkZLibDataCompressor
+
+#ifndef __vtkZstdDataCompressor_h
+#define __vtkZstdDataCompressor_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkDataCompressor.h"
+
+class VTKIOCORE_EXPORT vtkZstdDataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkZstdDataCompressor,vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent);
+  static vtkZstdDataCompressor* New();
+
+  // Description:
+  // Get the maximum space that may be needed to store data of the
+  // given uncompressed size after compression.  This is the minimum
+  // size of the output buffer that can be passed to the four-argument
+  // Compress method.
+  size_t GetMaximumCompressionSpace(size_t size);
+
+  // Description:
+  // Get/Set the compression level.  The default is 3.  Levels from 1 to
+  // 22 favor the compression ratio more and more, and levels from -1 to
+  // -100 favor the speed more and more.  Level 0 is the default level.
+  vtkSetClampMacro(CompressionLevel, int, -100, 22);
+  vtkGetMacro(CompressionLevel, int);
+
+protected:
+  vtkZstdDataCompressor();
+  ~vtkZstdDataCompressor();
+
+  int CompressionLevel;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData,
+                        size_t uncompressedSize,
+                        unsigned char* compressedData,
+                        size_t compressionSpace);
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData,
+                          size_t compressedSize,
+                          unsigned char* uncompressedData,
+                          size_t uncompressedSize);
+private:
+  vtkZstdDataCompressor(const vtkZstdDataCompressor&);  // Not implemented.
+  void operator=(const vtkZstdDataCompressor&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,198 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusSharedCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that readers of the same file share their cache, and that the
+// arrays prefetched for the next time step are those read without
+// prefetching.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkExodusIICache.h"
+#include "vtkExodusIIReader.h"
+#include "vtkExodusIIWriter.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimeSourceExample.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <string>
+
+static vtkUnstructuredGrid* GetGrid(vtkExodusIIReader* reader)
+{
+  vtkMultiBlockDataSet* elementBlocks =
+    vtkMultiBlockDataSet::SafeDownCast(reader->GetOutput()->GetBlock(0));
+  return elementBlocks ?
+    vtkUnstructuredGrid::SafeDownCast(elementBlocks->GetBlock(0)) : 0;
+}
+
+// Compares two arrays value by value, and reports the first difference.
+// A missing array is a difference.
+static bool SameArrays(vtkDataArray* a, vtkDataArray* b, const char* name)
+{
+  if (!a || !b)
+    {
+    cerr << "The " << name << " array is missing\n";
+    return false;
+    }
+  if (a->GetDataType() != b->GetDataType() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents() ||
+      a->GetNumberOfTuples() != b->GetNumberOfTuples())
+    {
+    cerr << "The " << name << " array has " << a->GetNumberOfTuples()
+         << " tuples of " << a->GetNumberOfComponents() << " "
+         << a->GetDataTypeAsString() << " instead of " << b->GetNumberOfTuples()
+         << " tuples of " << b->GetNumberOfComponents() << " "
+         << b->GetDataTypeAsString() << "\n";
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); i++)
+    {
+    for (int j = 0; j < a->GetNumberOfComponents(); j++)
+      {
+      if (a->GetComponent(i, j) != b->GetComponent(i, j))
+        {
+        cerr << "The " << name << " array has " << a->GetComponent(i, j)
+             << " instead of " << b->GetComponent(i, j) << " at tuple " << i
+             << ", component " << j << "\n";
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+// Compare the result variables of two readers.
+static bool SameOutputs(vtkExodusIIReader* a, vtkExodusIIReader* b)
+{
+  vtkUnstructuredGrid* gridA = GetGrid(a);
+  vtkUnstructuredGrid* gridB = GetGrid(b);
+  return (gridA && gridB && gridA->GetNumberOfPoints() > 0 &&
+          SameArrays(gridA->GetPointData()->GetArray("Point Value"),
+                     gridB->GetPointData()->GetArray("Point Value"),
+                     "Point Value") &&
+          SameArrays(gridA->GetCellData()->GetArray("Cell Value"),
+                     gridB->GetCellData()->GetArray("Cell Value"),
+                     "Cell Value"));
+}
+
+static void SetUpReader(vtkExodusIIReader* reader, const char* fileName,
+                        int share)
+{
+  reader->SetFileName(fileName);
+  reader->SetShareCache(share);
+  reader->SetCacheSize(16.0);
+  reader->UpdateInformation();
+  reader->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+}
+
+int TestExodusSharedCache(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory.\n";
+    return 1;
+    }
+  std::string fileName = tempDir;
+  fileName += "/TestExodusSharedCache.exo";
+  delete [] tempDir;
+
+  vtkNew<vtkTimeSourceExample> source;
+  source->SetXAmplitude(1.0);
+  vtkNew<vtkExodusIIWriter> writer;
+  writer->SetInputConnection(source->GetOutputPort());
+  writer->SetFileName(fileName.c_str());
+  writer->WriteAllTimeStepsOn();
+  writer->Write();
+
+  int errors = 0;
+
+  // A second reader of the file finds the arrays read by the first one.
+  vtkNew<vtkExodusIIReader> first;
+  SetUpReader(first.GetPointer(), fileName.c_str(), 1);
+  first->SetTimeStep(2);
+  first->Update();
+  vtkExodusIICache* cache = first->GetCache();
+
+  // Arrays missing from the file are looked for each time.
+  vtkTypeInt64 misses = cache->GetNumberOfMisses();
+  first->Modified();
+  first->Update();
+  vtkTypeInt64 uncached = cache->GetNumberOfMisses() - misses;
+  misses = cache->GetNumberOfMisses();
+  vtkTypeInt64 hits = cache->GetNumberOfHits();
+
+  vtkNew<vtkExodusIIReader> second;
+  SetUpReader(second.GetPointer(), fileName.c_str(), 1);
+  second->SetTimeStep(2);
+  second->Update();
+  if (second->GetCache() != cache ||
+      cache->GetNumberOfMisses() != misses + uncached ||
+      cache->GetNumberOfHits() <= hits ||
+      !SameOutputs(first.GetPointer(), second.GetPointer()))
+    {
+    cerr << "The cache was not shared: " << cache->GetNumberOfMisses()
+         << " misses and " << cache->GetNumberOfHits() << " hits\n";
+    errors++;
+    }
+
+  // A reader that does not share reads the file itself.
+  vtkNew<vtkExodusIIReader> reference;
+  SetUpReader(reference.GetPointer(), fileName.c_str(), 0);
+  reference->SetTimeStep(2);
+  reference->Update();
+  if (reference->GetCache() == cache ||
+      reference->GetCache()->GetNumberOfMisses() == 0 ||
+      !SameOutputs(first.GetPointer(), reference.GetPointer()))
+    {
+    cerr << "A reader that does not share used the shared cache\n";
+    errors++;
+    }
+
+  // The next time step is prefetched after each one that is read.
+  first->PrefetchNextTimeStepOn();
+  for (int step = 3; step < 6; step++)
+    {
+    first->SetTimeStep(step);
+    first->Update();
+    misses = cache->GetNumberOfMisses();
+    first->SetTimeStep(step + 1);
+    first->Update();
+    reference->SetTimeStep(step + 1);
+    reference->Update();
+    if (cache->GetNumberOfMisses() != misses + uncached ||
+        !SameOutputs(first.GetPointer(), reference.GetPointer()))
+      {
+      cerr << "Time step " << step + 1 << " was not prefetched\n";
+      errors++;
+      }
+    }
+
+  // Jumping to another time step drops the prefetched arrays.
+  first->SetTimeStep(9);
+  first->Update();
+  reference->SetTimeStep(9);
+  reference->Update();
+  if (!SameOutputs(first.GetPointer(), reference.GetPointer()))
+    {
+    cerr << "Wrong arrays after skipping the prefetched time step\n";
+    errors++;
+    }
+
+  return (errors != 0);
+}
@@ -2,6 +2,7 @@
 
 #include "vtkDataArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
 
 // Define VTK_EXO_DBG_CACHE to print cache adds, drops, and replacements.
 //#undef VTK_EXO_DBG_CACHE
@@ -67,10 +68,19 @@ void printLRUBack( vtkExodusIICacheRef& cit )
 
 vtkStandardNewMacro(vtkExodusIICache);
 
+// The caches shared in this process, by name, with their number of users.
+// The map only exists while some cache is shared.
+typedef std::map<std::string,std::pair<vtkExodusIICache*,int> > vtkExodusIICacheRegistry;
+static vtkExodusIICacheRegistry* vtkExodusIISharedCaches = 0;
+static vtkSimpleCriticalSection vtkExodusIISharedCachesLock;
+
 vtkExodusIICache::vtkExodusIICache()
 {
   this->Size = 0.;
   this->Capacity = 2.;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
 }
 
 vtkExodusIICache::~vtkExodusIICache()
@@ -85,6 +95,63 @@ void vtkExodusIICache::PrintSelf( ostream& os, vtkIndent indent )
   os << indent << "Size: " << this->Size << " MiB\n";
   os << indent << "Cache: " << &this->Cache << " (" << this->Cache.size() << ")\n";
   os << indent << "LRU: " << &this->LRU << "\n";
+  os << indent << "NumberOfHits: " << this->NumberOfHits << "\n";
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << "\n";
+  os << indent << "NumberOfEvictions: " << this->NumberOfEvictions << "\n";
+  os << indent << "SharedName: " << this->SharedName << "\n";
+}
+
+void vtkExodusIICache::ResetStatistics()
+{
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+}
+
+vtkExodusIICache* vtkExodusIICache::AcquireSharedCache( const char* name )
+{
+  vtkExodusIISharedCachesLock.Lock();
+  if ( ! vtkExodusIISharedCaches )
+    {
+    vtkExodusIISharedCaches = new vtkExodusIICacheRegistry;
+    }
+  std::pair<vtkExodusIICache*,int>& entry = (*vtkExodusIISharedCaches)[name];
+  if ( ! entry.first )
+    {
+    entry.first = vtkExodusIICache::New();
+    entry.first->SharedName = name;
+    }
+  ++entry.second;
+  vtkExodusIICache* cache = entry.first;
+  vtkExodusIISharedCachesLock.Unlock();
+  return cache;
+}
+
+void vtkExodusIICache::ReleaseSharedCache( vtkExodusIICache* cache )
+{
+  if ( ! cache )
+    return;
+
+  vtkExodusIICache* unused = 0;
+  vtkExodusIISharedCachesLock.Lock();
+  vtkExodusIICacheRegistry::iterator it;
+  if ( vtkExodusIISharedCaches &&
+    ( it = vtkExodusIISharedCaches->find( cache->SharedName ) ) != vtkExodusIISharedCaches->end() &&
+    it->second.first == cache && --it->second.second == 0 )
+    {
+    unused = cache;
+    vtkExodusIISharedCaches->erase( it );
+    if ( vtkExodusIISharedCaches->empty() )
+      {
+      delete vtkExodusIISharedCaches;
+      vtkExodusIISharedCaches = 0;
+      }
+    }
+  vtkExodusIISharedCachesLock.Unlock();
+  if ( unused )
+    {
+    unused->Delete();
+    }
 }
 
 void vtkExodusIICache::Clear()
@@ -100,7 +167,7 @@ void vtkExodusIICache::SetCacheCapacity( double sizeInMiB )
 
   if ( this->Size > sizeInMiB )
     {
-    this->ReduceToSize( sizeInMiB );
+    this->MakeSpace( sizeInMiB );
     }
 
   this->Capacity =  sizeInMiB < 0 ? 0 : sizeInMiB;
@@ -149,6 +216,13 @@ int vtkExodusIICache::ReduceToSize( double newSize )
   return deletedSomething;
 }
 
+void vtkExodusIICache::MakeSpace( double newSize )
+{
+  size_t numberOfEntries = this->Cache.size();
+  this->ReduceToSize( newSize );
+  this->NumberOfEvictions += numberOfEntries - this->Cache.size();
+}
+
 void vtkExodusIICache::Insert( vtkExodusIICacheKey& key, vtkDataArray* value )
 {
   double vsize = value ? value->GetActualMemorySize() / 1024. : 0.;
@@ -165,7 +239,7 @@ void vtkExodusIICache::Insert( vtkExodusIICacheKey& key, vtkDataArray* value )
       {
       this->RecomputeSize();
       }
-    this->ReduceToSize( this->Capacity - vsize );
+    this->MakeSpace( this->Capacity - vsize );
     it->second->Value->Delete();
     it->second->Value = value;
     it->second->Value->Register( 0 ); // Since we re-use the cache entry, the constructor's Register won't get called.
@@ -178,7 +252,7 @@ void vtkExodusIICache::Insert( vtkExodusIICacheKey& key, vtkDataArray* value )
     }
   else
     {
-    this->ReduceToSize( this->Capacity - vsize );
+    this->MakeSpace( this->Capacity - vsize );
     std::pair<const vtkExodusIICacheKey,vtkExodusIICacheEntry*> entry( key, new vtkExodusIICacheEntry(value) );
     std::pair<vtkExodusIICacheSet::iterator, bool> iret = this->Cache.insert( entry );
     this->Size += vsize;
@@ -199,9 +273,11 @@ vtkDataArray*& vtkExodusIICache::Find( vtkExodusIICacheKey key )
     {
     this->LRU.erase( it->second->LRUEntry );
     it->second->LRUEntry = this->LRU.insert( this->LRU.begin(), it );
+    ++this->NumberOfHits;
     return it->second->Value;
     }
 
+  ++this->NumberOfMisses;
   dummy = 0;
   return dummy;
 }
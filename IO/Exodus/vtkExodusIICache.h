@@ -14,20 +14,26 @@
 //    object ID (if one exists). When you call Find() to
 //    retrieve a cache entry, you provide a key containing
 //    this information and the array is returned if it exists.
-// 2. The list of cache references are stored in "least-recently-used"
-//    order. The least recently referenced array is the first in
+// 2. The list of cache references are stored in "most-recently-used"
+//    order. The least recently referenced array is the last in
 //    the list. Whenever you request an entry with Find(), it is
-//    moved to the back of the list if it exists.
+//    moved to the front of the list if it exists.
 // This makes retrieving arrays O(n log n) and popping LRU
 // entries O(1). Each cache entry stores an iterator into
 // the list of references so that it can be located quickly for
 // removal.
+//
+// Readers opened on the same file can share one cache per process
+// (see AcquireSharedCache()), so that arrays read by one reader are
+// found by the others. The cache counts hits, misses and evictions
+// so that its capacity can be tuned.
 
 #include "vtkIOExodusModule.h" // For export macro
 #include "vtkObject.h"
 
 #include <map> // used for cache storage
 #include <list> // use for LRU ordering
+#include <string> // used for the name of shared caches
 
 //BTX
 class VTKIOEXODUS_EXPORT vtkExodusIICacheKey
@@ -139,6 +145,12 @@ public:
   /// Set the maximum allowable cache size. This will remove cache entries if the capacity is reduced below the current size.
   void SetCacheCapacity( double sizeInMiB );
 
+  /// Get the maximum allowable cache size in MiB.
+  vtkGetMacro(Capacity,double);
+
+  /// Get the size of the arrays held by the cache in MiB.
+  vtkGetMacro(Size,double);
+
   /** See how much cache space is left.
     * This is the difference between the capacity and the size of the cache.
     * The result is in MiB.
@@ -176,8 +188,33 @@ public:
     * It is not an error to specify an empty range -- 0 will be returned if one is given.
     */
   int Invalidate( vtkExodusIICacheKey key, vtkExodusIICacheKey pattern );
+
+  /** Determine whether a cache entry exists without marking it as used
+    * and without counting a hit or a miss.
+    */
+  int Contains( const vtkExodusIICacheKey& key ) const
+    { return this->Cache.find( key ) != this->Cache.end(); }
   //ETX
 
+  /** Statistics of the cache: the number of Find() calls that returned an
+    * array, the number that did not, and the number of entries dropped to
+    * stay within the capacity. They are cumulative until ResetStatistics().
+    */
+  vtkGetMacro(NumberOfHits,vtkTypeInt64);
+  vtkGetMacro(NumberOfMisses,vtkTypeInt64);
+  vtkGetMacro(NumberOfEvictions,vtkTypeInt64);
+  void ResetStatistics();
+
+  /** Return the cache shared by all the users of \a name in this process,
+    * creating it if needed. Readers use the name of the file they read, so
+    * that every reader opened on a file finds the arrays read by the others.
+    * Each call must be matched by a call to ReleaseSharedCache(); the cache
+    * is deleted when its last user releases it.
+    * Readers sharing a cache must be updated from the same thread.
+    */
+  static vtkExodusIICache* AcquireSharedCache( const char* name );
+  static void ReleaseSharedCache( vtkExodusIICache* cache );
+
 protected:
   /// Default constructor
   vtkExodusIICache();
@@ -189,12 +226,22 @@ protected:
   /// Avoid (some) FP problems
   void RecomputeSize();
 
+  /// Call ReduceToSize() and count the entries it drops as evictions.
+  void MakeSpace( double newSize );
+
   /// The capacity of the cache (i.e., the maximum size of all arrays it contains) in MiB.
   double Capacity;
 
   /// The current size of the cache (i.e., the size of the all the arrays it currently contains) in MiB.
   double Size;
 
+  vtkTypeInt64 NumberOfHits;
+  vtkTypeInt64 NumberOfMisses;
+  vtkTypeInt64 NumberOfEvictions;
+
+  /// The name under which the cache is shared (empty if it is not shared).
+  std::string SharedName;
+
   //BTX
   /** A least-recently-used (LRU) cache to hold arrays.
     * During RequestData the cache may contain more than its maximum size since
@@ -204,7 +251,7 @@ protected:
     */
   vtkExodusIICacheSet Cache;
 
-  /// The actual LRU list (indices into the cache ordered least to most recently used).
+  /// The actual LRU list (indices into the cache ordered most to least recently used).
   vtkExodusIICacheLRU LRU;
   //ETX
 
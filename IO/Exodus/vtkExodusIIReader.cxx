@@ -31,12 +31,15 @@
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
 #include "vtkMutableDirectedGraph.h"
+#include "vtkMutexLock.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSimpleCriticalSection.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -373,6 +376,127 @@ void vtkExodusIIReaderPrivate::ArrayInfoType::Reset()
   this->ObjectTruth.clear();
 }
 
+// ------------------------------------------------------------- PREFETCHING
+// Variables stored in the file for each time step.
+static bool vtkExodusIIReaderIsResultVariable( int otyp )
+{
+  switch ( otyp )
+    {
+  case vtkExodusIIReader::GLOBAL:
+  case vtkExodusIIReader::NODAL:
+  case vtkExodusIIReader::EDGE_BLOCK:
+  case vtkExodusIIReader::FACE_BLOCK:
+  case vtkExodusIIReader::ELEM_BLOCK:
+  case vtkExodusIIReader::NODE_SET:
+  case vtkExodusIIReader::EDGE_SET:
+  case vtkExodusIIReader::FACE_SET:
+  case vtkExodusIIReader::SIDE_SET:
+  case vtkExodusIIReader::ELEM_SET:
+    return true;
+  default:
+    return false;
+    }
+}
+
+// The Exodus and netCDF libraries are not thread safe. Readers hold this
+// lock while they access their files, and prefetching threads while they
+// read an array.
+static vtkSimpleCriticalSection vtkExodusIIFileLock;
+
+class vtkExodusIIReaderFileLocker
+{
+public:
+  vtkExodusIIReaderFileLocker() { vtkExodusIIReaderPrivate::LockFiles(); }
+  ~vtkExodusIIReaderFileLocker() { vtkExodusIIReaderPrivate::UnlockFiles(); }
+};
+
+// The result variables of a time step being read by a background thread
+// from its own handle on the file. The arrays are only created and
+// inserted in the cache by the reader's thread.
+class vtkExodusIIReaderPrefetch
+{
+public:
+  vtkExodusIIReaderPrefetch()
+    {
+    this->Threader = vtkMultiThreader::New();
+    this->ThreadId = -1;
+    this->Lock = vtkMutexLock::New();
+    this->Cancelled = false;
+    this->AppWordSize = 8;
+    this->TimeStep = -1;
+    }
+  ~vtkExodusIIReaderPrefetch()
+    {
+    for ( size_t i = 0; i < this->Variables.size(); ++i )
+      {
+      this->Variables[i].Array->Delete();
+      }
+    this->Lock->Delete();
+    this->Threader->Delete();
+    }
+
+  static VTK_THREAD_RETURN_TYPE PrefetchThreadStart( void* arg );
+  void PrefetchThread();
+
+  std::string FileName;
+  int AppWordSize;
+  int TimeStep;
+  std::vector<vtkExodusIIReaderPrivate::ResultVariableType> Variables;
+  std::vector<int> Read;
+
+  vtkMultiThreader* Threader;
+  int ThreadId;
+  // Protects Cancelled.
+  vtkMutexLock* Lock;
+  bool Cancelled;
+};
+
+VTK_THREAD_RETURN_TYPE vtkExodusIIReaderPrefetch::PrefetchThreadStart( void* arg )
+{
+  vtkExodusIIReaderPrefetch* self = static_cast<vtkExodusIIReaderPrefetch*>(
+    static_cast<vtkMultiThreader::ThreadInfo*>( arg )->UserData );
+  self->PrefetchThread();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+void vtkExodusIIReaderPrefetch::PrefetchThread()
+{
+  int exoid = -1;
+  for ( size_t i = 0; i < this->Variables.size(); ++i )
+    {
+    this->Lock->Lock();
+    bool cancelled = this->Cancelled;
+    this->Lock->Unlock();
+    if ( cancelled )
+      {
+      break;
+      }
+
+    // Release the files between arrays so that readers are not kept waiting.
+    vtkExodusIIReaderFileLocker locker;
+    if ( exoid < 0 )
+      {
+      int appWordSize = this->AppWordSize;
+      int diskWordSize = 0;
+      float version;
+      exoid = ex_open( this->FileName.c_str(), EX_READ,
+        &appWordSize, &diskWordSize, &version );
+      if ( exoid < 0 )
+        {
+        break;
+        }
+      }
+    this->Read[i] = vtkExodusIIReaderPrivate::ReadResultVariable(
+      exoid, this->Variables[i] );
+    }
+
+  if ( exoid >= 0 )
+    {
+    vtkExodusIIReaderFileLocker locker;
+    ex_close( exoid );
+    }
+}
+
 // ------------------------------------------------------- PRIVATE CLASS MEMBERS
 vtkStandardNewMacro(vtkExodusIIReaderPrivate);
 
@@ -387,6 +511,9 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 
   this->Cache = vtkExodusIICache::New();
   this->CacheSize = 0;
+  this->ShareCache = 0;
+  this->PrefetchNextTimeStep = 0;
+  this->Prefetch = 0;
 
   this->TimeStep = 0;
   this->HasModeShapes = 0;
@@ -416,8 +543,16 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 //-----------------------------------------------------------------------------
 vtkExodusIIReaderPrivate::~vtkExodusIIReaderPrivate()
 {
+  this->FinishPrefetch( -1 );
   this->CloseFile();
-  this->Cache->Delete();
+  if ( this->SharedCacheName.empty() )
+    {
+    this->Cache->Delete();
+    }
+  else
+    {
+    vtkExodusIICache::ReleaseSharedCache( this->Cache );
+    }
   this->CacheSize = 0;
   this->ClearConnectivityCaches();
   if(this->Parser)
@@ -1613,6 +1748,13 @@ void vtkExodusIIReaderPrivate::InsertSetSides(
 vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key )
 {
   vtkDataArray* arr;
+  // Result variables read at a time step are prefetched for the next one.
+  if ( this->PrefetchNextTimeStep && key.Time >= 0 &&
+    vtkExodusIIReaderIsResultVariable( key.ObjectType ) )
+    {
+    this->PrefetchKeys.insert( key );
+    }
+
   // Never cache points deflected for a mode shape animation... doubles don't make good keys.
   if ( this->HasModeShapes && key.ObjectType == vtkExodusIIReader::NODAL_COORDS )
     {
@@ -1632,84 +1774,17 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
   int exoid = this->Exoid;
 
   // If array is NULL, try reading it from file.
-  if ( key.ObjectType == vtkExodusIIReader::GLOBAL )
+  ResultVariableType var;
+  if ( this->PrepareResultVariable( key, var ) )
     {
-    // need to assemble result array from smaller ones.
-    // call GetCacheOrRead() for each smaller array
-    // pay attention to SqueezePoints
-
-    //ArrayInfoType* ainfop = &this->ArrayInfo[vtkExodusIIReader::GLOBAL][key.ArrayId];
-    arr = vtkDataArray::CreateDataArray( VTK_DOUBLE );
-    arr->SetName( this->GetGlobalVariableValuesArrayName() );
-    arr->SetNumberOfComponents( 1 );
-    arr->SetNumberOfTuples( this->ArrayInfo[ vtkExodusIIReader::GLOBAL ].size() );
-
-    if ( ex_get_glob_vars( exoid, key.Time + 1, arr->GetNumberOfTuples(),
-        arr->GetVoidPointer( 0 ) ) < 0 )
+    arr = var.Array;
+    if ( ! vtkExodusIIReaderPrivate::ReadResultVariable( exoid, var ) )
       {
-      vtkErrorMacro( "Could not read global variable " << this->GetGlobalVariableValuesArrayName() << "." );
+      vtkErrorMacro( "Could not read result variable " << arr->GetName() << " at time step " << key.Time << "." );
       arr->Delete();
       arr = 0;
       }
     }
-  else if ( key.ObjectType == vtkExodusIIReader::NODAL )
-    {
-    // read nodal array
-    ArrayInfoType* ainfop = &this->ArrayInfo[vtkExodusIIReader::NODAL][key.ArrayId];
-    int ncomps = ( this->ModelParameters.num_dim == 2 && ainfop->Components == 2 ) ? 3 : ainfop->Components;
-    arr = vtkDataArray::CreateDataArray( ainfop->StorageType );
-    arr->SetName( ainfop->Name.c_str() );
-    arr->SetNumberOfComponents( ncomps );
-    arr->SetNumberOfTuples( this->ModelParameters.num_nodes );
-    if ( ncomps != ainfop->Components )
-      {
-      arr->FillComponent( 2, 0. );
-      }
-    if ( ncomps == 1 )
-      {
-      if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
-          ainfop->OriginalIndices[0], 0, arr->GetNumberOfTuples(),
-          arr->GetVoidPointer( 0 ) ) < 0 )
-        {
-        vtkErrorMacro( "Could not read nodal result variable " << ainfop->Name.c_str() << "." );
-        arr->Delete();
-        arr = 0;
-        }
-      }
-    else
-      {
-      // Exodus doesn't support reading with a stride, so we have to manually interleave the arrays. Bleh.
-      std::vector<std::vector<double> > tmpVal;
-      tmpVal.resize( ainfop->Components );
-      int c;
-      for ( c = 0; c < ainfop->Components; ++c )
-        {
-        vtkIdType N = this->ModelParameters.num_nodes;
-        tmpVal[c].resize( N );
-        if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
-            ainfop->OriginalIndices[c], 0, arr->GetNumberOfTuples(),
-            &tmpVal[c][0] ) < 0)
-          {
-          vtkErrorMacro( "Could not read nodal result variable " << ainfop->OriginalNames[c].c_str() << "." );
-          arr->Delete();
-          arr = 0;
-          return 0;
-          }
-        }
-      int t;
-      std::vector<double> tmpTuple;
-      tmpTuple.resize( ncomps );
-      tmpTuple[ncomps - 1] = 0.; // In case we're embedding a 2-D vector in 3-D
-      for ( t = 0; t < arr->GetNumberOfTuples(); ++t )
-        {
-        for ( c = 0; c < ainfop->Components; ++c )
-          {
-          tmpTuple[c] = tmpVal[c][t];
-          }
-        arr->SetTuple( t, &tmpTuple[0] );
-        }
-      }
-    }
   else if ( key.ObjectType == vtkExodusIIReader::GLOBAL_TEMPORAL )
     {
     // read temporal nodal array
@@ -1870,82 +1945,6 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         }
       }
     }
-  else if (
-    key.ObjectType == vtkExodusIIReader::EDGE_BLOCK ||
-    key.ObjectType == vtkExodusIIReader::FACE_BLOCK ||
-    key.ObjectType == vtkExodusIIReader::ELEM_BLOCK ||
-    key.ObjectType == vtkExodusIIReader::NODE_SET ||
-    key.ObjectType == vtkExodusIIReader::EDGE_SET ||
-    key.ObjectType == vtkExodusIIReader::FACE_SET ||
-    key.ObjectType == vtkExodusIIReader::SIDE_SET ||
-    key.ObjectType == vtkExodusIIReader::ELEM_SET
-    )
-    {
-    int otypidx = this->GetObjectTypeIndexFromObjectType( key.ObjectType );
-    ArrayInfoType* ainfop = &this->ArrayInfo[key.ObjectType][key.ArrayId];
-    ObjectInfoType* oinfop = this->GetObjectInfo( otypidx, key.ObjectId );
-
-    arr = vtkDataArray::CreateDataArray( ainfop->StorageType );
-    arr->SetName( ainfop->Name.c_str() );
-    if ( ainfop->Components == 2 && this->ModelParameters.num_dim == 2 )
-      {
-      // Promote 2-component arrays to 3-component arrays when we have 2-D coordinates
-      arr->SetNumberOfComponents( 3 );
-      }
-    else
-      {
-      arr->SetNumberOfComponents( ainfop->Components );
-      }
-    arr->SetNumberOfTuples( oinfop->Size );
-    if ( ainfop->Components == 1 )
-      {
-      if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
-          ainfop->OriginalIndices[0], oinfop->Id, arr->GetNumberOfTuples(),
-          arr->GetVoidPointer( 0 ) ) < 0)
-        {
-        vtkErrorMacro( "Could not read result variable " << ainfop->Name.c_str() <<
-          " for " << objtype_names[otypidx] << " " << oinfop->Id << "." );
-        arr->Delete();
-        arr = 0;
-        }
-      }
-    else
-      {
-      // Exodus doesn't support reading with a stride, so we have to manually interleave the arrays. Bleh.
-      std::vector<std::vector<double> > tmpVal;
-      tmpVal.resize( ainfop->Components );
-      int c;
-      for ( c = 0; c < ainfop->Components; ++c )
-        {
-        vtkIdType N = arr->GetNumberOfTuples();
-        tmpVal[c].resize( N+1 ); // + 1 to avoid errors when N == 0.
-                                 // BUG #8746.
-        if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
-            ainfop->OriginalIndices[c], oinfop->Id, arr->GetNumberOfTuples(),
-            &tmpVal[c][0] ) < 0)
-          {
-          vtkErrorMacro( "Could not read result variable " << ainfop->OriginalNames[c].c_str() <<
-            " for " << objtype_names[otypidx] << " " << oinfop->Id << "." );
-          arr->Delete();
-          arr = 0;
-          }
-        }
-      // Carefully use arr->GetNumberOfComponents() when sizing
-      // output as we may have promoted 2-D arrays to 3-D.
-      int t = arr->GetNumberOfComponents();
-      std::vector<double> tmpTuple;
-      tmpTuple.resize( t );
-      tmpTuple[t - 1] = 0.;
-      for ( t = 0; t < arr->GetNumberOfTuples(); ++t )
-        {
-        for ( c = 0; c < ainfop->Components; ++c )
-          {
-          tmpTuple[c] = tmpVal[c][t];
-          }
-        arr->SetTuple( t, &tmpTuple[0] );
-        }
-      }
-    }
   else if (
     key.ObjectType == vtkExodusIIReader::NODE_MAP ||
     key.ObjectType == vtkExodusIIReader::EDGE_MAP ||
@@ -2853,6 +2852,237 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
   return arr;
 }
 
+//-----------------------------------------------------------------------------
+int vtkExodusIIReaderPrivate::PrepareResultVariable(
+  vtkExodusIICacheKey key, ResultVariableType& var )
+{
+  if ( ! vtkExodusIIReaderIsResultVariable( key.ObjectType ) )
+    {
+    return 0;
+    }
+
+  var.Key = key;
+  var.ExodusType = key.ObjectType;
+  var.ExodusId = 0;
+  var.Indices.clear();
+  if ( key.ObjectType == vtkExodusIIReader::GLOBAL )
+    {
+    // All the global variables at once.
+    var.Array = vtkDataArray::CreateDataArray( VTK_DOUBLE );
+    var.Array->SetName( this->GetGlobalVariableValuesArrayName() );
+    var.Array->SetNumberOfComponents( 1 );
+    var.Array->SetNumberOfTuples( this->ArrayInfo[ vtkExodusIIReader::GLOBAL ].size() );
+    return 1;
+    }
+
+  ArrayInfoType* ainfop = &this->ArrayInfo[key.ObjectType][key.ArrayId];
+  vtkIdType numTuples;
+  if ( key.ObjectType == vtkExodusIIReader::NODAL )
+    {
+    numTuples = this->ModelParameters.num_nodes;
+    }
+  else
+    {
+    ObjectInfoType* oinfop = this->GetObjectInfo(
+      this->GetObjectTypeIndexFromObjectType( key.ObjectType ), key.ObjectId );
+    var.ExodusId = oinfop->Id;
+    numTuples = oinfop->Size;
+    }
+  var.Indices = ainfop->OriginalIndices;
+
+  var.Array = vtkDataArray::CreateDataArray( ainfop->StorageType );
+  var.Array->SetName( ainfop->Name.c_str() );
+  // Promote 2-component arrays to 3-component arrays when we have 2-D coordinates
+  var.Array->SetNumberOfComponents(
+    ( ainfop->Components == 2 && this->ModelParameters.num_dim == 2 ) ? 3 : ainfop->Components );
+  var.Array->SetNumberOfTuples( numTuples );
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+int vtkExodusIIReaderPrivate::ReadResultVariable( int exoid, ResultVariableType& var )
+{
+  vtkDataArray* arr = var.Array;
+  vtkIdType numTuples = arr->GetNumberOfTuples();
+  if ( var.Key.ObjectType == vtkExodusIIReader::GLOBAL )
+    {
+    return ex_get_glob_vars( exoid, var.Key.Time + 1, numTuples, arr->GetVoidPointer( 0 ) ) >= 0;
+    }
+
+  int ncomps = static_cast<int>( var.Indices.size() );
+  if ( ncomps == 1 && arr->GetNumberOfComponents() == 1 )
+    {
+    return ex_get_var( exoid, var.Key.Time + 1, static_cast<ex_entity_type>( var.ExodusType ),
+      var.Indices[0], var.ExodusId, numTuples, arr->GetVoidPointer( 0 ) ) >= 0;
+    }
+
+  // Exodus doesn't support reading with a stride, so we have to manually interleave the arrays. Bleh.
+  std::vector<double> tmpVal( numTuples + 1 ); // + 1 to avoid errors when N == 0. BUG #8746.
+  for ( int c = 0; c < ncomps; ++c )
+    {
+    if ( ex_get_var( exoid, var.Key.Time + 1, static_cast<ex_entity_type>( var.ExodusType ),
+        var.Indices[c], var.ExodusId, numTuples, &tmpVal[0] ) < 0 )
+      {
+      return 0;
+      }
+    for ( vtkIdType t = 0; t < numTuples; ++t )
+      {
+      arr->SetComponent( t, c, tmpVal[t] );
+      }
+    }
+  // In case we're embedding a 2-D vector in 3-D
+  for ( int c = ncomps; c < arr->GetNumberOfComponents(); ++c )
+    {
+    arr->FillComponent( c, 0. );
+    }
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::LockFiles()
+{
+  vtkExodusIIFileLock.Lock();
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::UnlockFiles()
+{
+  vtkExodusIIFileLock.Unlock();
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::StartPrefetch( int timeStep )
+{
+  std::set<vtkExodusIICacheKey> keys;
+  keys.swap( this->PrefetchKeys );
+  if ( ! this->PrefetchNextTimeStep || this->HasModeShapes || this->Prefetch ||
+    timeStep <= 0 || timeStep >= static_cast<int>( this->Times.size() ) ||
+    this->OpenFileName.empty() )
+    {
+    return;
+    }
+
+  vtkExodusIIReaderPrefetch* prefetch = new vtkExodusIIReaderPrefetch;
+  prefetch->FileName = this->OpenFileName;
+  prefetch->AppWordSize = this->AppWordSize;
+  prefetch->TimeStep = timeStep;
+  std::set<vtkExodusIICacheKey>::iterator it;
+  for ( it = keys.begin(); it != keys.end(); ++it )
+    {
+    vtkExodusIICacheKey key = *it;
+    if ( key.Time != timeStep - 1 )
+      {
+      continue;
+      }
+    key.Time = timeStep;
+    ResultVariableType var;
+    // Another reader sharing the cache may have read it already.
+    if ( ! this->Cache->Contains( key ) && this->PrepareResultVariable( key, var ) )
+      {
+      prefetch->Variables.push_back( var );
+      }
+    }
+  if ( prefetch->Variables.empty() )
+    {
+    delete prefetch;
+    return;
+    }
+
+  prefetch->Read.resize( prefetch->Variables.size(), 0 );
+  prefetch->ThreadId = prefetch->Threader->SpawnThread(
+    &vtkExodusIIReaderPrefetch::PrefetchThreadStart, prefetch );
+  this->Prefetch = prefetch;
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::FinishPrefetch( int timeStep )
+{
+  vtkExodusIIReaderPrefetch* prefetch = this->Prefetch;
+  if ( ! prefetch )
+    {
+    return;
+    }
+
+  bool wanted = ( prefetch->TimeStep == timeStep );
+  if ( ! wanted )
+    {
+    prefetch->Lock->Lock();
+    prefetch->Cancelled = true;
+    prefetch->Lock->Unlock();
+    }
+  prefetch->Threader->TerminateThread( prefetch->ThreadId );
+
+  for ( size_t i = 0; wanted && i < prefetch->Variables.size(); ++i )
+    {
+    ResultVariableType& var = prefetch->Variables[i];
+    if ( prefetch->Read[i] && ! this->Cache->Contains( var.Key ) )
+      {
+      this->Cache->Insert( var.Key, var.Array );
+      }
+    }
+  delete prefetch;
+  this->Prefetch = 0;
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::UpdateCache( const char* filename )
+{
+  std::string name;
+  if ( this->ShareCache && filename )
+    {
+    // Arrays derived from the file depend on these settings, and the
+    // arrays of a file that has been written again are stale.
+    char settings[256];
+    SNPRINTF( settings, sizeof( settings ), "|%lu|%d|%.9g|%d",
+      static_cast<unsigned long>( vtksys::SystemTools::ModifiedTime( filename ) ),
+      this->ApplyDisplacements, this->DisplacementMagnitude, this->SqueezePoints );
+    name = vtksys::SystemTools::CollapseFullPath( filename ) + settings;
+    }
+  if ( name == this->SharedCacheName )
+    {
+    return;
+    }
+
+  this->FinishPrefetch( -1 );
+  if ( this->SharedCacheName.empty() )
+    {
+    this->Cache->Delete();
+    }
+  else
+    {
+    vtkExodusIICache::ReleaseSharedCache( this->Cache );
+    }
+  this->SharedCacheName = name;
+  if ( name.empty() )
+    {
+    this->Cache = vtkExodusIICache::New();
+    this->Cache->SetCacheCapacity( this->CacheSize );
+    }
+  else
+    {
+    // A shared cache is as large as any of its readers asks.
+    this->Cache = vtkExodusIICache::AcquireSharedCache( name.c_str() );
+    if ( this->Cache->GetCapacity() < this->CacheSize )
+      {
+      this->Cache->SetCacheCapacity( this->CacheSize );
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::SetShareCache( int share )
+{
+  if ( this->ShareCache == share )
+    {
+    return;
+    }
+  this->ShareCache = share;
+  if ( ! share )
+    {
+    this->UpdateCache( 0 );
+    }
+}
+
 //-----------------------------------------------------------------------------
 int vtkExodusIIReaderPrivate::GetConnTypeIndexFromConnType( int ctyp )
 {
@@ -3645,6 +3875,8 @@ void vtkExodusIIReaderPrivate::PrintData( ostream& os, vtkIndent indent )
 
   os << indent << "Array Cache:\n";
   this->Cache->PrintSelf( os, inden2 );
+  os << indent << "ShareCache: " << this->ShareCache << "\n";
+  os << indent << "PrefetchNextTimeStep: " << this->PrefetchNextTimeStep << "\n";
 
   os << indent << "SqueezePoints: " << this->SqueezePoints << "\n";
   os << indent << "ApplyDisplacements: " << this->ApplyDisplacements << "\n";
@@ -3681,6 +3913,9 @@ int vtkExodusIIReaderPrivate::OpenFile( const char* filename )
   float dummyFloat;
   ex_inquire(this->Exoid, EX_INQ_NODES, &numNodesInFile, &dummyFloat, &dummyChar);
 
+  this->OpenFileName = filename;
+  this->UpdateCache( filename );
+
   return 1;
 }
 
@@ -4348,6 +4583,7 @@ int vtkExodusIIReaderPrivate::RequestData( vtkIdType timeStep, vtkMultiBlockData
     }
 
   this->CloseFile();
+  this->StartPrefetch( timeStep + 1 );
 
   return 0;
 }
@@ -4532,8 +4768,17 @@ void vtkExodusIIReaderPrivate::ResetSettings()
 
 void vtkExodusIIReaderPrivate::ResetCache()
 {
-  this->Cache->Clear();
-  this->Cache->SetCacheCapacity(this->CacheSize); // FIXME: Perhaps Cache should have a Reset and a Clear method?
+  if ( this->SharedCacheName.empty() )
+    {
+    this->FinishPrefetch( -1 );
+    this->Cache->Clear();
+    this->Cache->SetCacheCapacity(this->CacheSize); // FIXME: Perhaps Cache should have a Reset and a Clear method?
+    }
+  else
+    {
+    // Other readers use the entries of a shared cache: only stop using it.
+    this->UpdateCache( 0 );
+    }
   this->ClearConnectivityCaches();
 }
 
@@ -4542,7 +4787,10 @@ void vtkExodusIIReaderPrivate::SetCacheSize( double size )
   if (this->CacheSize != size)
     {
     this->CacheSize = size;
-    this->Cache->SetCacheCapacity(this->CacheSize);
+    if ( this->SharedCacheName.empty() || this->Cache->GetCapacity() < size )
+      {
+      this->Cache->SetCacheCapacity(this->CacheSize);
+      }
     this->Modified();
     }
 }
@@ -4990,10 +5238,14 @@ void vtkExodusIIReaderPrivate::SetApplyDisplacements( int d )
   this->ApplyDisplacements = d;
   this->Modified();
 
-  // Require the coordinates to be recomputed:
-  this->Cache->Invalidate(
-    vtkExodusIICacheKey( 0, vtkExodusIIReader::NODAL_COORDS, 0, 0 ),
-    vtkExodusIICacheKey( 0, 1, 0, 0 ) );
+  // Require the coordinates to be recomputed (a shared cache is replaced
+  // when the file is next opened):
+  if ( this->SharedCacheName.empty() )
+    {
+    this->Cache->Invalidate(
+      vtkExodusIICacheKey( 0, vtkExodusIIReader::NODAL_COORDS, 0, 0 ),
+      vtkExodusIICacheKey( 0, 1, 0, 0 ) );
+    }
 }
 
 void vtkExodusIIReaderPrivate::SetDisplacementMagnitude( double s )
@@ -5004,10 +5256,14 @@ void vtkExodusIIReaderPrivate::SetDisplacementMagnitude( double s )
   this->DisplacementMagnitude = s;
   this->Modified();
 
-  // Require the coordinates to be recomputed:
-  this->Cache->Invalidate(
-    vtkExodusIICacheKey( 0, vtkExodusIIReader::NODAL_COORDS, 0, 0 ),
-    vtkExodusIICacheKey( 0, 1, 0, 0 ) );
+  // Require the coordinates to be recomputed (a shared cache is replaced
+  // when the file is next opened):
+  if ( this->SharedCacheName.empty() )
+    {
+    this->Cache->Invalidate(
+      vtkExodusIICacheKey( 0, vtkExodusIIReader::NODAL_COORDS, 0, 0 ),
+      vtkExodusIICacheKey( 0, 1, 0, 0 ) );
+    }
 }
 
 vtkDataArray* vtkExodusIIReaderPrivate::FindDisplacementVectors( int timeStep )
@@ -5058,6 +5314,12 @@ vtkExodusIIReader::~vtkExodusIIReader()
   this->SetXMLFileName( 0 );
   this->SetFileName( 0 );
 
+  if ( this->Metadata )
+    {
+    this->Metadata->FinishPrefetch( -1 );
+    vtkExodusIIReaderFileLocker locker;
+    this->Metadata->CloseFile();
+    }
   this->SetMetadata( 0 );
   //this->SetExodusModel( 0 );
 }
@@ -5073,6 +5335,7 @@ int vtkExodusIIReader::CanReadFile( const char* fname )
   int diskWordSize = 8;
   float version;
 
+  vtkExodusIIReaderFileLocker locker;
   if ( (exoid = ex_open( fname, EX_READ, &appWordSize, &diskWordSize, &version )) < 0 )
     {
     return 0;
@@ -5195,6 +5458,9 @@ int vtkExodusIIReader::RequestInformation(
   // If the metadata is older than the filename
   if ( this->GetMetadataMTime() < this->FileNameMTime )
     {
+    // The arrays being prefetched belong to the old metadata.
+    this->Metadata->FinishPrefetch( -1 );
+    vtkExodusIIReaderFileLocker locker;
     if ( this->Metadata->OpenFile( this->FileName ) )
       {
       // We need to initialize the XML parser before calling RequestInformation
@@ -5259,9 +5525,9 @@ int vtkExodusIIReader::RequestData(
   vtkInformationVector** vtkNotUsed(inputVector),
   vtkInformationVector* outputVector )
 {
-  if ( ! this->FileName || ! this->Metadata->OpenFile( this->FileName ) )
+  if ( ! this->FileName )
     {
-    vtkErrorMacro( "Unable to open file \"" << (this->FileName ? this->FileName : "(null)") << "\" to read data" );
+    vtkErrorMacro( "Unable to open file \"(null)\" to read data" );
     return 0;
     }
 
@@ -5316,6 +5582,16 @@ int vtkExodusIIReader::RequestData(
       }
     }
 
+  // Use the arrays prefetched for this time step, if any, before taking the
+  // lock that the prefetching thread needs.
+  this->Metadata->FinishPrefetch( this->GetHasModeShapes() ? -1 : this->TimeStep );
+  vtkExodusIIReaderFileLocker locker;
+  if ( ! this->Metadata->OpenFile( this->FileName ) )
+    {
+    vtkErrorMacro( "Unable to open file \"" << this->FileName << "\" to read data" );
+    return 0;
+    }
+
   //cout << "Requesting step " << this->TimeStep << " for output " << output << "\n";
   this->Metadata->RequestData( this->TimeStep, output );
 
@@ -6242,8 +6518,35 @@ void vtkExodusIIReader::ResetCache()
   this->Metadata->ResetCache();
 }
 
+void vtkExodusIIReader::SetShareCache( int share )
+{
+  this->Metadata->SetShareCache( share );
+}
+
+int vtkExodusIIReader::GetShareCache()
+{
+  return this->Metadata->GetShareCache();
+}
+
+void vtkExodusIIReader::SetPrefetchNextTimeStep( int prefetch )
+{
+  this->Metadata->SetPrefetchNextTimeStep( prefetch );
+}
+
+int vtkExodusIIReader::GetPrefetchNextTimeStep()
+{
+  return this->Metadata->GetPrefetchNextTimeStep();
+}
+
+vtkExodusIICache* vtkExodusIIReader::GetCache()
+{
+  return this->Metadata->GetCache();
+}
+
 void vtkExodusIIReader::UpdateTimeInformation()
 {
+  this->Metadata->FinishPrefetch( -1 );
+  vtkExodusIIReaderFileLocker locker;
   if ( this->Metadata->OpenFile( this->FileName ) )
     {
     this->Metadata->UpdateTimeInformation();
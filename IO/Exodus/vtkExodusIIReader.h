@@ -668,6 +668,30 @@ public:
   // Get the size of the cache in MiB.
   double GetCacheSize();
 
+  // Description:
+  // Share the cache with the other readers of the same file in this
+  // process, so that arrays read by one reader are not read again by the
+  // others (as when several views show the same database). A shared cache
+  // holds as much as the largest cache size of its readers. Readers
+  // sharing a cache must be updated from the same thread.
+  // Off by default.
+  void SetShareCache(int share);
+  int GetShareCache();
+  vtkBooleanMacro(ShareCache, int);
+
+  // Description:
+  // After reading a time step, read the same result variables for the
+  // next time step in a background thread, so that they are in the cache
+  // when that time step is requested. The cache must be large enough to
+  // hold a time step. Off by default.
+  void SetPrefetchNextTimeStep(int prefetch);
+  int GetPrefetchNextTimeStep();
+  vtkBooleanMacro(PrefetchNextTimeStep, int);
+
+  // Description:
+  // Return the cache used by the reader, for its statistics.
+  vtkExodusIICache* GetCache();
+
   // Description:
   // Should the reader output only points used by elements in the output mesh,
   // or all the points. Outputting all the points is much faster since the
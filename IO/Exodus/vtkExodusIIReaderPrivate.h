@@ -9,11 +9,14 @@
 #include "vtksys/RegularExpression.hxx"
 
 #include <map>
+#include <set>
+#include <string>
 #include <vector>
 
 #include "vtk_exodusII.h"
 #include "vtkIOExodusModule.h" // For export macro
 class vtkExodusIIReaderParser;
+class vtkExodusIIReaderPrefetch;
 class vtkMutableDirectedGraph;
 
 /** This class holds metadata for an Exodus file.
@@ -77,6 +80,35 @@ public:
   /// Get the size of the cache in MiB.
   vtkGetMacro(CacheSize, double);
 
+  /** Set whether the cache is shared with the other readers of the same
+    * file in this process. This takes effect when the file is next opened.
+    */
+  void SetShareCache( int share );
+  vtkGetMacro(ShareCache, int);
+
+  /** Set whether the result variables read for a time step are read for
+    * the next time step in the background, ready for the next request.
+    */
+  void SetPrefetchNextTimeStep( int prefetch )
+    { this->PrefetchNextTimeStep = prefetch; }
+  vtkGetMacro(PrefetchNextTimeStep, int);
+
+  /// Return the cache currently used by the reader.
+  vtkExodusIICache* GetCache()
+    { return this->Cache; }
+
+  /** Wait for the arrays being prefetched and insert them in the cache if
+    * they are for \a timeStep; otherwise stop prefetching and drop them.
+    * This must be called before the file lock is taken.
+    */
+  void FinishPrefetch( int timeStep );
+
+  /** Acquire and release the lock that serializes Exodus library calls
+    * between readers and their prefetching threads.
+    */
+  static void LockFiles();
+  static void UnlockFiles();
+
   /** Return the number of time steps in the open file.
     * You must have called RequestInformation() before
     * invoking this member function.
@@ -486,6 +518,32 @@ public:
 
   bool ProducedFastPathOutput;
 
+  /** A result variable (global, nodal, or defined over blocks and sets) at
+    * one time step, with what is needed to read it from any file handle.
+    */
+  struct ResultVariableType
+  {
+    vtkExodusIICacheKey Key;
+    /// The Exodus type and ID of the object the variable is defined over.
+    int ExodusType;
+    int ExodusId;
+    /// The 1-based index of the variable of each component in the file.
+    std::vector<int> Indices;
+    /// The array to read into, sized and named.
+    vtkDataArray* Array;
+  };
+
+  /** Create the array for a result variable and fill in \a var.
+    * Returns 0 if the key is not a result variable.
+    */
+  int PrepareResultVariable( vtkExodusIICacheKey key, ResultVariableType& var );
+
+  /** Read a result variable prepared by PrepareResultVariable() from
+    * the file \a exoid. This does not access the reader, so that it can be
+    * called from other threads. Returns 1 on success.
+    */
+  static int ReadResultVariable( int exoid, ResultVariableType& var );
+
 protected:
   vtkExodusIIReaderPrivate();
   ~vtkExodusIIReaderPrivate();
@@ -712,6 +770,14 @@ protected:
   /// Delete any cached connectivity information (for all blocks and sets)
   void ClearConnectivityCaches();
 
+  /** Use the shared cache of \a filename, or a cache of its own, as
+    * ShareCache requires.
+    */
+  void UpdateCache( const char* filename );
+
+  /// Start reading the result variables read for the previous time step.
+  void StartPrefetch( int timeStep );
+
   /** Maps a block type (EX_ELEM_BLOCK, EX_FACE_BLOCK, ...) to a list of blocks
     * of that type.
     */
@@ -797,6 +863,22 @@ protected:
   /// The size of the cache in MiB.
   double CacheSize;
 
+  /** Whether the cache is shared, and the name it is shared under (empty
+    * while the reader uses a cache of its own).
+    */
+  int ShareCache;
+  std::string SharedCacheName;
+
+  /// The name of the file opened by OpenFile().
+  std::string OpenFileName;
+
+  /** Whether to prefetch, the result variables requested since the last
+    * RequestData(), and the prefetch in progress (if any).
+    */
+  int PrefetchNextTimeStep;
+  std::set<vtkExodusIICacheKey> PrefetchKeys;
+  vtkExodusIIReaderPrefetch* Prefetch;
+
   int ApplyDisplacements;
   float DisplacementMagnitude;
   int HasModeShapes;
@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOBJReaderCoordinates.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the coordinates, texture coordinates and normals read from a
+// file with more lines than are converted at once, where faces refer to
+// vertices relative to the last one read.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkOBJReader.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+static bool SameValues(vtkDataArray* array, const std::vector<float>& values)
+{
+  return (array &&
+          array->GetNumberOfTuples()*array->GetNumberOfComponents() ==
+          static_cast<vtkIdType>(values.size()) &&
+          memcmp(array->GetVoidPointer(0), &values[0],
+                 values.size()*sizeof(float)) == 0);
+}
+
+int TestOBJReaderCoordinates(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory.\n";
+    return 1;
+    }
+  std::string fileName = tempDir;
+  fileName += "/TestOBJReaderCoordinates.obj";
+  delete [] tempDir;
+
+  // Groups of triangles, each followed by its faces.  The values are
+  // written as the sscanf() in the reader used to parse them.
+  vtkMath::RandomSeed(8642);
+  std::vector<float> points, tcoords, normals;
+  FILE* fp = fopen(fileName.c_str(), "w");
+  fprintf(fp, "# coordinates\n");
+  const int numGroups = 40;
+  const int groupSize = 3*1200;
+  for (int g = 0; g < numGroups; g++)
+    {
+    for (int i = 0; i < groupSize; i++)
+      {
+      float x[3];
+      char text[3][32];
+      for (int j = 0; j < 3; j++)
+        {
+        sprintf(text[j], "%.8g", vtkMath::Random(-1e3, 1e3));
+        sscanf(text[j], "%f", x + j);
+        }
+      fprintf(fp, (i % 2 ? "v %s %s %s\n" : "  v\t%s  %s %s \r\n"),
+              text[0], text[1], text[2]);
+      points.insert(points.end(), x, x + 3);
+      fprintf(fp, "vt %s %s\n", text[0], text[1]);
+      tcoords.insert(tcoords.end(), x, x + 2);
+      fprintf(fp, "vn %s %s %s\n", text[2], text[1], text[0]);
+      normals.push_back(x[2]);
+      normals.push_back(x[1]);
+      normals.push_back(x[0]);
+      }
+    for (int i = groupSize; i > 0; i -= 3)
+      {
+      fprintf(fp, "f %d/%d/%d %d/%d/%d %d/%d/%d\n",
+              -i, g*groupSize + groupSize - i + 1,
+              g*groupSize + groupSize - i + 1,
+              -i + 1, g*groupSize + groupSize - i + 2,
+              g*groupSize + groupSize - i + 2,
+              -i + 2, g*groupSize + groupSize - i + 3,
+              g*groupSize + groupSize - i + 3);
+      }
+    }
+  fclose(fp);
+
+  int errors = 0;
+  vtkNew<vtkOBJReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+  if (!SameValues(output->GetPoints()->GetData(), points) ||
+      !SameValues(output->GetPointData()->GetTCoords(), tcoords) ||
+      !SameValues(output->GetPointData()->GetNormals(), normals))
+    {
+    cerr << "Wrong coordinates read\n";
+    errors++;
+    }
+  vtkIdType numCells = output->GetNumberOfPolys();
+  if (numCells != numGroups*groupSize/3)
+    {
+    cerr << "Wrong number of faces read: " << numCells << "\n";
+    errors++;
+    }
+  vtkIdType npts, *pts;
+  vtkIdType cellId = 0;
+  vtkCellArray* polys = output->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); cellId++)
+    {
+    if (npts != 3 || pts[0] != 3*cellId || pts[2] != 3*cellId + 2)
+      {
+      cerr << "Wrong face " << cellId << "\n";
+      errors++;
+      break;
+      }
+    }
+
+  // A bad vertex in the middle of a batch is reported.
+  fp = fopen(fileName.c_str(), "w");
+  for (int i = 0; i < 20; i++)
+    {
+    fprintf(fp, (i == 12 ? "v 1 2 x\n" : "v 1 2 3\n"));
+    }
+  fprintf(fp, "f 1 2 3\n");
+  fclose(fp);
+  reader->Modified();
+  reader->Update();
+  if (reader->GetOutput()->GetNumberOfPoints() != 0)
+    {
+    cerr << "A bad vertex was not detected\n";
+    errors++;
+    }
+
+  return (errors != 0);
+}
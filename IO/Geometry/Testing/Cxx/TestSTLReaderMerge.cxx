@@ -0,0 +1,218 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSTLReaderMerge.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that binary and ASCII files are read with the coordinates of the
+// file, and that merging the points without a locator gives the same
+// result as merging them with vtkMergePoints.
+
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkMath.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSTLReader.h"
+#include "vtkTestUtilities.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// Write the triangles to a binary file.
+static void WriteBinary(const std::vector<float>& x, const char* fileName)
+{
+  FILE* fp = fopen(fileName, "wb");
+  char header[80];
+  memset(header, ' ', 80);
+  memcpy(header, "binary", 6);
+  fwrite(header, 1, 80, fp);
+  unsigned int numTris = static_cast<unsigned int>(x.size()/9);
+  vtkByteSwap::Swap4LE(&numTris);
+  fwrite(&numTris, 4, 1, fp);
+  for (size_t i = 0; i < x.size(); i += 9)
+    {
+    float facet[12] = { 0.0f, 0.0f, 1.0f };
+    memcpy(facet + 3, &x[i], 9*sizeof(float));
+    vtkByteSwap::Swap4LERange(facet, 12);
+    fwrite(facet, 4, 12, fp);
+    fwrite("\0\0", 1, 2, fp);
+    }
+  fclose(fp);
+}
+
+// Write the triangles to an ASCII file, as two solids.
+static void WriteASCII(const std::vector<float>& x, const char* fileName)
+{
+  FILE* fp = fopen(fileName, "w");
+  size_t half = (x.size()/18)*9;
+  for (size_t i = 0; i < x.size(); i += 9)
+    {
+    if (i == 0 || i == half)
+      {
+      fprintf(fp, "solid part%d\n", (i == 0 ? 1 : 2));
+      }
+    fprintf(fp, "  facet normal 0 0 1\n    outer loop\n");
+    for (int j = 0; j < 9; j += 3)
+      {
+      fprintf(fp, "      vertex %.9g %.9g %.9g\n", x[i + j], x[i + j + 1],
+              x[i + j + 2]);
+      }
+    fprintf(fp, "    endloop\n  endfacet\n");
+    if (i + 9 == half || i + 9 == x.size())
+      {
+      fprintf(fp, "endsolid part%d\n", (i + 9 == half ? 1 : 2));
+      }
+    }
+  fclose(fp);
+}
+
+// Compares two arrays value by value, and reports the first difference.
+// A missing array is a difference.
+static bool SameArrays(vtkDataArray* a, vtkDataArray* b, const char* name)
+{
+  if (!a || !b)
+    {
+    cerr << "The " << name << " array is missing\n";
+    return false;
+    }
+  if (a->GetDataType() != b->GetDataType() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents() ||
+      a->GetNumberOfTuples() != b->GetNumberOfTuples())
+    {
+    cerr << "The " << name << " array has " << a->GetNumberOfTuples()
+         << " tuples of " << a->GetNumberOfComponents() << " "
+         << a->GetDataTypeAsString() << " instead of " << b->GetNumberOfTuples()
+         << " tuples of " << b->GetNumberOfComponents() << " "
+         << b->GetDataTypeAsString() << "\n";
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); i++)
+    {
+    for (int j = 0; j < a->GetNumberOfComponents(); j++)
+      {
+      if (a->GetComponent(i, j) != b->GetComponent(i, j))
+        {
+        cerr << "The " << name << " array has " << a->GetComponent(i, j)
+             << " instead of " << b->GetComponent(i, j) << " at tuple " << i
+             << ", component " << j << "\n";
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+static int CheckFile(const std::vector<float>& x, const char* fileName,
+                     int scalarTags)
+{
+  int errors = 0;
+
+  // Without merging, the coordinates are those of the file.
+  vtkNew<vtkSTLReader> reader;
+  reader->SetFileName(fileName);
+  reader->MergingOff();
+  reader->SetScalarTags(scalarTags);
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+  if (output->GetNumberOfPoints() != static_cast<vtkIdType>(x.size()/3) ||
+      output->GetNumberOfPolys() != static_cast<vtkIdType>(x.size()/9) ||
+      memcmp(output->GetPoints()->GetVoidPointer(0), &x[0],
+             x.size()*sizeof(float)) != 0)
+    {
+    cerr << "Wrong triangles read from " << fileName << "\n";
+    errors++;
+    }
+
+  // Merging without a locator, and with the default locator.
+  reader->MergingOn();
+  reader->Update();
+  vtkNew<vtkMergePoints> locator;
+  vtkNew<vtkSTLReader> locatorReader;
+  locatorReader->SetFileName(fileName);
+  locatorReader->SetScalarTags(scalarTags);
+  locatorReader->SetLocator(locator.GetPointer());
+  locatorReader->Update();
+  vtkPolyData* expected = locatorReader->GetOutput();
+  output = reader->GetOutput();
+
+  if (!SameArrays(output->GetPoints()->GetData(),
+                  expected->GetPoints()->GetData(), "points") ||
+      !SameArrays(output->GetPolys()->GetData(),
+                  expected->GetPolys()->GetData(), "triangles") ||
+      (scalarTags &&
+       !SameArrays(output->GetCellData()->GetScalars(),
+                   expected->GetCellData()->GetScalars(), "scalars")))
+    {
+    cerr << "Merged triangles differ from the locator in " << fileName
+         << "\n";
+    errors++;
+    }
+  if (output->GetNumberOfPoints() >= static_cast<vtkIdType>(x.size()/3) ||
+      output->GetNumberOfPolys() >= static_cast<vtkIdType>(x.size()/9))
+    {
+    cerr << "Points were not merged in " << fileName << "\n";
+    errors++;
+    }
+  if (scalarTags && (!output->GetCellData()->GetScalars() ||
+      output->GetCellData()->GetScalars()->GetRange()[1] != 1.0))
+    {
+    cerr << "Solids were not tagged in " << fileName << "\n";
+    errors++;
+    }
+
+  return errors;
+}
+
+int TestSTLReaderMerge(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory.\n";
+    return 1;
+    }
+  std::string prefix = tempDir;
+  prefix += "/TestSTLReaderMerge";
+  delete [] tempDir;
+
+  // Triangles with corners on a coarse lattice share many points, and
+  // some of them are degenerate.  Both zeros must merge.
+  vtkMath::RandomSeed(1357);
+  std::vector<float> x;
+  for (int i = 0; i < 30000; i++)
+    {
+    for (int j = 0; j < 9; j++)
+      {
+      float value = static_cast<float>(
+        static_cast<int>(vtkMath::Random(-8.0, 8.0))*0.125);
+      x.push_back(value == 0.0f && (i + j) % 2 ? -0.0f : value);
+      }
+    }
+
+  int errors = 0;
+  std::string fileName = prefix + ".stl";
+  WriteBinary(x, fileName.c_str());
+  errors += CheckFile(x, fileName.c_str(), 0);
+
+  fileName = prefix + "-ascii.stl";
+  WriteASCII(x, fileName.c_str());
+  errors += CheckFile(x, fileName.c_str(), 1);
+
+  return (errors != 0);
+}
@@ -50,6 +50,20 @@ vtkCGMWriter::~vtkCGMWriter()
     }
 }
 
+int vtkCGMWriter::CopyWriterSettings(vtkWriter *writer)
+{
+  if (this->Viewport || !this->Superclass::CopyWriterSettings(writer))
+    {
+    return 0;
+    }
+  vtkCGMWriter *copy = static_cast<vtkCGMWriter *>(writer);
+  copy->SetSort(this->Sort);
+  copy->SetResolution(this->Resolution);
+  copy->SetColorMode(this->ColorMode);
+  copy->SetSpecifiedColor(this->SpecifiedColor);
+  return 1;
+}
+
 //--------------------------#defines and method descriptions for CGM output
 //---defines.h
 #define b0 01
@@ -110,6 +110,12 @@ protected:
   ~vtkCGMWriter();
   void WriteData();
 
+  // Description:
+  // Copy the sort, resolution and color settings along with the settings
+  // of the superclass.  A writer with a viewport cannot be copied, since
+  // the viewport cannot be used from another thread.
+  virtual int CopyWriterSettings(vtkWriter *writer);
+
   vtkViewport *Viewport;
   int         ColorMode;
   float       SpecifiedColor[3];
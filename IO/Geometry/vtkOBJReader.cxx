@@ -21,10 +21,172 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
 #include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkOBJReader);
 
+namespace {
+
+//----------------------------------------------------------------------------
+// Reads the lines of a file exactly like fgets() does, but from large
+// blocks of the file.
+class vtkOBJReaderLineSource
+{
+public:
+  vtkOBJReaderLineSource(FILE *file)
+    : File(file), Buffer(1024*1024), Position(0), Length(0) {}
+
+  char *GetLine(char *line, int size)
+  {
+    size_t n = 0;
+    while (n + 1 < static_cast<size_t>(size))
+      {
+      if (this->Position == this->Length)
+        {
+        this->Position = 0;
+        this->Length = fread(&this->Buffer[0], 1, this->Buffer.size(),
+                             this->File);
+        if (this->Length == 0)
+          {
+          break;
+          }
+        }
+      const char *start = &this->Buffer[this->Position];
+      size_t count = std::min(this->Length - this->Position, size - 1 - n);
+      const char *newLine = static_cast<const char *>(
+        memchr(start, '\n', count));
+      if (newLine)
+        {
+        count = newLine - start + 1;
+        }
+      memcpy(line + n, start, count);
+      n += count;
+      this->Position += count;
+      if (newLine)
+        {
+        break;
+        }
+      }
+    if (n == 0)
+      {
+      return NULL;
+      }
+    line[n] = '\0';
+    return line;
+  }
+
+private:
+  FILE *File;
+  std::vector<char> Buffer;
+  size_t Position;
+  size_t Length;
+};
+
+//----------------------------------------------------------------------------
+// The 'v', 'vt' and 'vn' lines, which are kept until they can be converted
+// together.
+class vtkOBJReaderCoordinates
+{
+public:
+  enum { Vertex = 0, TCoord = 1, Normal = 2, BatchSize = 65536 };
+
+  struct Line
+  {
+    int Type;
+    int LineNumber;
+    size_t Offset;
+    float *Values;
+  };
+
+  std::vector<Line> Lines;
+  std::vector<char> Text;
+  mutable std::vector<char> Valid;
+
+  void Add(int type, int lineNumber, const char *text)
+  {
+    Line line;
+    line.Type = type;
+    line.LineNumber = lineNumber;
+    line.Offset = this->Text.size();
+    line.Values = NULL;
+    this->Lines.push_back(line);
+    this->Text.insert(this->Text.end(), text, text + strlen(text) + 1);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      const Line &line = this->Lines[i];
+      const char *text = &this->Text[line.Offset];
+      int n = (line.Type == TCoord ? 2 : 3);
+      char *next;
+      bool valid = true;
+      for (int j = 0; j < n && valid; j++)
+        {
+        line.Values[j] = strtof(text, &next);
+        valid = (next != text);
+        text = next;
+        }
+      this->Valid[i] = valid;
+      }
+  }
+
+  // Convert the lines and append the values to the arrays.  Returns false
+  // and reports the first line that could not be converted on error.
+  bool Flush(vtkObject *reader, vtkFloatArray *points,
+             vtkFloatArray *tcoords, vtkFloatArray *normals)
+  {
+    vtkFloatArray *arrays[3] = { points, tcoords, normals };
+    vtkIdType counts[3] = { 0, 0, 0 };
+    for (size_t i = 0; i < this->Lines.size(); i++)
+      {
+      counts[this->Lines[i].Type]++;
+      }
+    float *values[3];
+    for (int t = 0; t < 3; t++)
+      {
+      int numComponents = (t == TCoord ? 2 : 3);
+      values[t] = arrays[t]->WritePointer(
+        arrays[t]->GetNumberOfTuples()*numComponents,
+        counts[t]*numComponents);
+      }
+    for (size_t i = 0; i < this->Lines.size(); i++)
+      {
+      int t = this->Lines[i].Type;
+      this->Lines[i].Values = values[t];
+      values[t] += (t == TCoord ? 2 : 3);
+      }
+
+    vtkIdType numLines = static_cast<vtkIdType>(this->Lines.size());
+    this->Valid.resize(numLines);
+    vtkSMPTools::For(0, numLines, 4096, *this);
+
+    std::vector<char>::iterator invalid =
+      std::find(this->Valid.begin(), this->Valid.end(), 0);
+    if (invalid != this->Valid.end())
+      {
+      const Line &line = this->Lines[invalid - this->Valid.begin()];
+      const char *names[3] = { "v", "vt", "vn" };
+      vtkErrorWithObjectMacro(reader, <<"Error reading '" << names[line.Type]
+                              << "' at line " << line.LineNumber);
+      return false;
+      }
+    this->Lines.clear();
+    this->Text.clear();
+    return true;
+  }
+};
+
+} // end anonymous namespace
+
+
 // Description:
 // Instantiate object with NULL filename.
 vtkOBJReader::vtkOBJReader()
@@ -151,11 +313,15 @@ int vtkOBJReader::RequestData(
 
   const int MAX_LINE = 1024;
   char rawLine[MAX_LINE];
-  float xyz[3];
+
+  // the coordinates are converted in batches, the cells as they are read
+  vtkOBJReaderLineSource lines(in);
+  vtkOBJReaderCoordinates coordinates;
+  vtkFloatArray *pointArray = vtkFloatArray::SafeDownCast(points->GetData());
 
   int lineNr = 0;
   int numPoints = 0;
-  while (everything_ok && fgets(rawLine, MAX_LINE, in) != NULL)
+  while (everything_ok && lines.GetLine(rawLine, MAX_LINE) != NULL)
     {
     lineNr++;
     char *pLine = rawLine;
@@ -177,47 +343,36 @@ int vtkOBJReader::RequestData(
       pLine++;
       }
 
+    // the cells may refer to any of the coordinates read so far
+    if (!coordinates.Lines.empty() &&
+        (strcmp(cmd, "p") == 0 || strcmp(cmd, "l") == 0 ||
+         strcmp(cmd, "f") == 0 ||
+         coordinates.Lines.size() >= vtkOBJReaderCoordinates::BatchSize))
+      {
+      everything_ok = coordinates.Flush(this, pointArray, tcoords, normals);
+      if (!everything_ok)
+        {
+        break;
+        }
+      }
+
     // in the OBJ format the first characters determine how to interpret the line:
     if (strcmp(cmd, "v") == 0)
       {
       // this is a vertex definition, expect three floats, separated by whitespace:
-      if (sscanf(pLine, "%f %f %f", xyz, xyz+1, xyz+2) == 3)
-        {
-        points->InsertNextPoint(xyz);
-        numPoints++;
-        }
-      else
-        {
-        vtkErrorMacro(<<"Error reading 'v' at line " << lineNr);
-        everything_ok = false;
-        }
+      coordinates.Add(vtkOBJReaderCoordinates::Vertex, lineNr, pLine);
+      numPoints++;
       }
     else if (strcmp(cmd, "vt") == 0)
       {
       // this is a tcoord, expect two floats, separated by whitespace:
-      if (sscanf(pLine, "%f %f", xyz, xyz+1) == 2)
-        {
-        tcoords->InsertNextTuple(xyz);
-        }
-      else
-        {
-        vtkErrorMacro(<<"Error reading 'vt' at line " << lineNr);
-        everything_ok = false;
-        }
+      coordinates.Add(vtkOBJReaderCoordinates::TCoord, lineNr, pLine);
       }
     else if (strcmp(cmd, "vn") == 0)
       {
       // this is a normal, expect three floats, separated by whitespace:
-      if (sscanf(pLine, "%f %f %f", xyz, xyz+1, xyz+2) == 3)
-        {
-        normals->InsertNextTuple(xyz);
-        hasNormals = true;
-        }
-      else
-        {
-        vtkErrorMacro(<<"Error reading 'vn' at line " << lineNr);
-        everything_ok = false;
-        }
+      coordinates.Add(vtkOBJReaderCoordinates::Normal, lineNr, pLine);
+      hasNormals = true;
       }
     else if (strcmp(cmd, "p") == 0)
       {
@@ -249,7 +404,7 @@ int vtkOBJReader::RequestData(
           else if (strcmp(pLine, "\\\n") == 0)
             {
             // handle backslash-newline continuation
-            if (fgets(rawLine, MAX_LINE, in) != NULL)
+            if (lines.GetLine(rawLine, MAX_LINE) != NULL)
               {
               lineNr++;
               pLine = rawLine;
@@ -329,7 +484,7 @@ int vtkOBJReader::RequestData(
           else if (strcmp(pLine, "\\\n") == 0)
             {
             // handle backslash-newline continuation
-            if (fgets(rawLine, MAX_LINE, in) != NULL)
+            if (lines.GetLine(rawLine, MAX_LINE) != NULL)
               {
               lineNr++;
               pLine = rawLine;
@@ -451,7 +606,7 @@ int vtkOBJReader::RequestData(
           else if (strcmp(pLine, "\\\n") == 0)
             {
             // handle backslash-newline continuation
-            if (fgets(rawLine, MAX_LINE, in) != NULL)
+            if (lines.GetLine(rawLine, MAX_LINE) != NULL)
               {
               lineNr++;
               pLine = rawLine;
@@ -505,6 +660,12 @@ int vtkOBJReader::RequestData(
 
     } // (end of while loop)
 
+  if (everything_ok && !coordinates.Lines.empty())
+    {
+    everything_ok = coordinates.Flush(this, pointArray, tcoords, normals);
+    }
+  points->Modified();
+
   } // (end of local scope section)
 
   // we have finished with the file
@@ -41,6 +41,11 @@
 #define VTK_FOAMFILE_OUTBUFSIZE (131072)
 #define VTK_FOAMFILE_INCLUDE_STACK_SIZE (10)
 
+// The minimum number of values of an ASCII list to be converted
+// concurrently, and the size of the pieces the list is cut into in bytes.
+#define VTK_FOAMFILE_PARALLEL_LIST_SIZE (16384)
+#define VTK_FOAMFILE_PARALLEL_PIECE_SIZE (65536)
+
 #if defined(_MSC_VER) && (_MSC_VER >= 1400)
 #define _CRT_SECURE_NO_WARNINGS 1
 #endif
@@ -54,6 +59,7 @@
 
 #include "vtkOpenFOAMReader.h"
 
+#include <algorithm>
 #include <vector>
 #include "vtksys/SystemTools.hxx"
 #include <vtksys/ios/sstream>
@@ -80,6 +86,8 @@
 #include "vtkPolygon.h"
 #include "vtkPyramid.h"
 #include "vtkQuad.h"
+#include "vtkSMPTools.h"
+#include "vtkSimpleCriticalSection.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -109,6 +117,10 @@ uLong ZEXPORT crc32(uLong, const Bytef *, uInt)
 
 vtkStandardNewMacro(vtkOpenFOAMReader);
 
+// guards the reader counts of the parent, which the readers of the
+// processor directories of a decomposed case update concurrently
+static vtkSimpleCriticalSection vtkOpenFOAMReaderParentLock;
+
 // forward declarations
 template <typename T> struct vtkFoamArrayVector
   : public std::vector<T *>
@@ -1533,6 +1545,7 @@ public:
 
   int ReadIntValue();
   float ReadFloatValue();
+  int ReadListBody(std::vector<char>& text);
 };
 
 int vtkFoamFile::ReadNext()
@@ -1735,6 +1748,81 @@ float vtkFoamFile::ReadFloatValue()
   return static_cast<float>(nonNegative ? num : -num);
 }
 
+// reads the body of a list up to the parenthesis that closes it, which is
+// put back. parentheses and comments are replaced by spaces so that only
+// the values are left. returns the number of sublists.
+int vtkFoamFile::ReadListBody(std::vector<char>& text)
+{
+  text.clear();
+  int depth = 0, nSublists = 0;
+  for (;;)
+    {
+    int c = this->Getc();
+    if (c == EOF)
+      {
+      this->ThrowUnexpectedEOFException();
+      }
+    else if (c == '\n')
+      {
+      ++this->Superclass::LineNumber;
+      }
+    else if (c == '(')
+      {
+      depth++;
+      nSublists++;
+      c = ' ';
+      }
+    else if (c == ')')
+      {
+      if (depth == 0)
+        {
+        this->PutBack(c);
+        break;
+        }
+      depth--;
+      c = ' ';
+      }
+    else if (c == '/')
+      {
+      const int c2 = this->Getc();
+      if (c2 == '/')
+        {
+        while ((c = this->Getc()) != EOF && c != '\n')
+          ;
+        if (c == EOF)
+          {
+          this->ThrowUnexpectedEOFException();
+          }
+        ++this->Superclass::LineNumber;
+        }
+      else if (c2 == '*')
+        {
+        int prev = 0;
+        while ((c = this->Getc()) != EOF && !(prev == '*' && c == '/'))
+          {
+          if (c == '\n')
+            {
+            ++this->Superclass::LineNumber;
+            }
+          prev = c;
+          }
+        if (c == EOF)
+          {
+          this->ThrowUnexpectedEOFException();
+          }
+        c = ' ';
+        }
+      else
+        {
+        this->PutBack(c2); // may be an EOF
+        }
+      }
+    text.push_back(static_cast<char>(c));
+    }
+  text.push_back('\0');
+  return nSublists;
+}
+
 // hacks to keep exception throwing code out-of-line to make
 // putBack() and readExpecting() inline expandable
 void vtkFoamFile::ThrowUnexpectedEOFException()
@@ -2006,6 +2094,264 @@ VTK_TEMPLATE_SPECIALIZE inline float vtkFoamReadValue<float>::ReadValue(vtkFoamI
   return io.ReadFloatValue();
 }
 
+//-----------------------------------------------------------------------------
+// conversion of the values of large ASCII lists in pieces that are
+// converted concurrently. the values are converted exactly as
+// vtkFoamFile::ReadIntValue() and ReadFloatValue() do.
+static inline bool vtkFoamIsDigit(const char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+static inline bool vtkFoamIsSpace(const char c)
+{
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f'
+      || c == '\v';
+}
+
+static bool vtkFoamConvertValue(const char *&p, int& value)
+{
+  const char *c = p;
+  const bool negative = (*c == '-');
+  if (*c == '-' || *c == '+')
+    {
+    c++;
+    }
+  if (!vtkFoamIsDigit(*c))
+    {
+    return false;
+    }
+  int num = 0;
+  while (vtkFoamIsDigit(*c))
+    {
+    num = 10 * num + (*c++ - '0');
+    }
+  value = (negative ? -num : num);
+  p = c;
+  return true;
+}
+
+static bool vtkFoamConvertValue(const char *&p, float& value)
+{
+  const char *c = p;
+  const bool negative = (*c == '-');
+  if (*c == '-' || *c == '+')
+    {
+    c++;
+    }
+  if (!vtkFoamIsDigit(*c) && *c != '.')
+    {
+    return false;
+    }
+
+  // read integer part
+  double num = 0.0;
+  while (vtkFoamIsDigit(*c))
+    {
+    num = num * 10.0 + (*c++ - '0');
+    }
+
+  // read decimal part
+  if (*c == '.')
+    {
+    double divisor = 1.0;
+    c++;
+    while (vtkFoamIsDigit(*c))
+      {
+      num = num * 10.0 + (*c++ - '0');
+      divisor *= 10.0;
+      }
+    num /= divisor;
+    }
+
+  // read exponent part
+  if (*c == 'E' || *c == 'e')
+    {
+    int esign = 1;
+    int eval = 0;
+    double scale = 1.0;
+
+    c++;
+    if (*c == '-')
+      {
+      esign = -1;
+      c++;
+      }
+    else if (*c == '+')
+      {
+      c++;
+      }
+    while (vtkFoamIsDigit(*c))
+      {
+      eval = eval * 10 + (*c++ - '0');
+      }
+
+    while (eval >= 64)
+      {
+      scale *= 1.0e+64;
+      eval -= 64;
+      }
+    while (eval >= 16)
+      {
+      scale *= 1.0e+16;
+      eval -= 16;
+      }
+    while (eval >= 4)
+      {
+      scale *= 1.0e+4;
+      eval -= 4;
+      }
+    while (eval >= 1)
+      {
+      scale *= 1.0e+1;
+      eval -= 1;
+      }
+
+    if (esign < 0)
+      {
+      num /= scale;
+      }
+    else
+      {
+      num *= scale;
+      }
+    }
+
+  value = static_cast<float>(negative ? -num : num);
+  p = c;
+  return true;
+}
+
+// counts, then converts the values of each piece of the body of a list.
+// every stride-th value is a tuple of which the first nComponents values
+// are kept.
+template <typename T> struct vtkFoamListConverter
+{
+  const char *Text;
+  std::vector<size_t> Pieces;
+  mutable std::vector<vtkIdType> Offsets;
+  mutable std::vector<char> Valid;
+  T *Values;
+  int NComponents;
+  int Stride;
+  bool Counting;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType pieceI = begin; pieceI < end; pieceI++)
+      {
+      const char *c = this->Text + this->Pieces[pieceI];
+      const char *pieceEnd = this->Text + this->Pieces[pieceI + 1];
+      vtkIdType valueI = (this->Counting ? 0 : this->Offsets[pieceI]);
+      bool valid = true;
+      for (;;)
+        {
+        while (c < pieceEnd && vtkFoamIsSpace(*c))
+          {
+          c++;
+          }
+        if (c == pieceEnd)
+          {
+          break;
+          }
+        if (this->Counting)
+          {
+          while (c < pieceEnd && !vtkFoamIsSpace(*c))
+            {
+            c++;
+            }
+          }
+        else
+          {
+          T value;
+          if (!vtkFoamConvertValue(c, value)
+              || (c < pieceEnd && !vtkFoamIsSpace(*c)))
+            {
+            valid = false;
+            break;
+            }
+          const int componentI = static_cast<int>(valueI % this->Stride);
+          if (componentI < this->NComponents)
+            {
+            this->Values[valueI / this->Stride * this->NComponents
+                + componentI] = value;
+            }
+          }
+        valueI++;
+        }
+      if (this->Counting)
+        {
+        this->Offsets[pieceI] = valueI;
+        }
+      this->Valid[pieceI] = valid;
+      }
+  }
+};
+
+// reads the body of a nonuniform ASCII list of size tuples and converts
+// its values concurrently. nSublists is the number of parenthesized
+// tuples expected in the list.
+template <typename T> void vtkFoamReadAsciiList(vtkFoamIOobject& io,
+    T *values, const int size, const int nComponents, const int stride,
+    const int nSublists)
+{
+  std::vector<char> text;
+  if (io.ReadListBody(text) != nSublists)
+    {
+    throw vtkFoamError() << "Expected " << nSublists
+    << " parenthesized elements in the list";
+    }
+
+  vtkFoamListConverter<T> converter;
+  converter.Text = &text[0];
+  converter.Values = values;
+  converter.NComponents = nComponents;
+  converter.Stride = stride;
+
+  // cut the text at whitespace so that no value is split
+  const size_t length = text.size() - 1;
+  size_t pieceStart = 0;
+  converter.Pieces.push_back(0);
+  while (pieceStart < length)
+    {
+    size_t pieceEnd = std::min(pieceStart + VTK_FOAMFILE_PARALLEL_PIECE_SIZE,
+        length);
+    while (pieceEnd < length && !vtkFoamIsSpace(text[pieceEnd]))
+      {
+      pieceEnd++;
+      }
+    converter.Pieces.push_back(pieceEnd);
+    pieceStart = pieceEnd;
+    }
+  const vtkIdType nPieces =
+      static_cast<vtkIdType>(converter.Pieces.size()) - 1;
+  converter.Offsets.resize(nPieces);
+  converter.Valid.resize(nPieces);
+
+  converter.Counting = true;
+  vtkSMPTools::For(0, nPieces, 1, converter);
+  vtkIdType nValues = 0;
+  for (vtkIdType pieceI = 0; pieceI < nPieces; pieceI++)
+    {
+    const vtkIdType n = converter.Offsets[pieceI];
+    converter.Offsets[pieceI] = nValues;
+    nValues += n;
+    }
+  if (nValues != static_cast<vtkIdType>(size) * stride)
+    {
+    throw vtkFoamError() << "Expected " << static_cast<vtkIdType>(size)
+    * stride << " values in the list, found " << nValues;
+    }
+
+  converter.Counting = false;
+  vtkSMPTools::For(0, nPieces, 1, converter);
+  if (std::find(converter.Valid.begin(), converter.Valid.end(), 0)
+      != converter.Valid.end())
+    {
+    throw vtkFoamError() << "Expected a number, found a non-digit character";
+    }
+}
+
 //-----------------------------------------------------------------------------
 // class vtkFoamEntryValue
 // a class that represents a value of a dictionary entry that corresponds to
@@ -2052,6 +2398,11 @@ public:
     }
     void ReadAsciiList(vtkFoamIOobject& io, const int size)
     {
+      if (size >= VTK_FOAMFILE_PARALLEL_LIST_SIZE)
+        {
+        vtkFoamReadAsciiList(io, this->Ptr->GetPointer(0), size, 1, 1, 0);
+        return;
+        }
       for (int i = 0; i < size; i++)
         {
         this->Ptr->SetValue(i, vtkFoamReadValue<primitiveT>::ReadValue(io));
@@ -2113,6 +2464,14 @@ public:
     }
     void ReadAsciiList(vtkFoamIOobject& io, const int size)
     {
+      if (static_cast<vtkIdType>(size) * nComponents
+          >= VTK_FOAMFILE_PARALLEL_LIST_SIZE)
+        {
+        // the label celli of positions is skipped
+        vtkFoamReadAsciiList(io, this->Ptr->GetPointer(0), size, nComponents,
+            isPositions ? nComponents + 1 : nComponents, size);
+        return;
+        }
       for (int i = 0; i < size; i++)
         {
         io.ReadExpecting('(');
@@ -4937,6 +5296,21 @@ bool vtkOpenFOAMReaderPrivate::CheckFacePoints(
   return true;
 }
 
+//-----------------------------------------------------------------------------
+// returns true if value is one of the first n values of list. the loop
+// does not exit early so that it is vectorized; the lists are the few
+// points of a cell.
+template <typename T> static inline bool vtkFoamContains(const T *list,
+    const int n, const T value)
+{
+  int found = 0;
+  for (int i = 0; i < n; i++)
+    {
+    found |= (list[i] == value);
+    }
+  return found != 0;
+}
+
 //-----------------------------------------------------------------------------
 // determine cell shape and insert the cell into the mesh
 // hexahedron, prism, pyramid, tetrahedron and decompose polyhedron
@@ -5478,16 +5852,9 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
           for (size_t k = 0; k < nFaceJPoints; k++)
             {
             const int faceJPointK = faceJPoints[k];
-            bool foundDup = false;
-            for (vtkIdType l = 0; l < static_cast<vtkIdType>(polyCellPoints->GetDataSize()); l++)
-              {
-              if (polyCellPoints->GetValue(l) == faceJPointK)
-                {
-                foundDup = true;
-                break; // look no more
-                }
-              }
-            if (!foundDup)
+            if (!vtkFoamContains(polyCellPoints->GetPointer(0),
+                static_cast<int>(polyCellPoints->GetNumberOfTuples()),
+                faceJPointK))
               {
               polyCellPoints->InsertNextValue(faceJPointK);
               float *pointK = pointArray->GetPointer(3 * faceJPointK);
@@ -5680,16 +6047,8 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
           for (size_t k = 0; k < nFaceJPoints; k++, pointI += delta)
             {
             const int faceJPointK = faceJPoints[pointI];
-            bool foundDup = false;
-            for (int l = 0; l < nPoints; l++)
-              {
-              if (cellPoints->GetId(l) == faceJPointK)
-                {
-                foundDup = true;
-                break; // look no more
-                }
-              }
-            if (!foundDup)
+            if (!vtkFoamContains(cellPoints->GetPointer(0), nPoints,
+                static_cast<vtkIdType>(faceJPointK)))
               {
               if (nPoints >= maxNPoints)
                 {
@@ -8144,6 +8503,7 @@ vtkOpenFOAMReader::vtkOpenFOAMReader()
 
   this->CurrentReaderIndex = 0;
   this->NumberOfReaders = 0;
+  this->UpdatingReadersConcurrently = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -8365,7 +8725,9 @@ int vtkOpenFOAMReader::RequestData(vtkInformation *vtkNotUsed(request), vtkInfor
     {
     ret = reader->RequestData(output, recreateInternalMesh,
         recreateBoundaryMesh, updateVariables);
+    vtkOpenFOAMReaderParentLock.Lock();
     this->Parent->CurrentReaderIndex++;
+    vtkOpenFOAMReaderParentLock.Unlock();
     }
   else
     {
@@ -8392,7 +8754,9 @@ int vtkOpenFOAMReader::RequestData(vtkInformation *vtkNotUsed(request), vtkInfor
         ret = 0;
         }
       subOutput->Delete();
+      vtkOpenFOAMReaderParentLock.Lock();
       this->Parent->CurrentReaderIndex++;
+      vtkOpenFOAMReaderParentLock.Unlock();
       }
     }
 
@@ -8488,7 +8852,9 @@ int vtkOpenFOAMReader::MakeInformationVector(
     }
   dir->Delete();
   masterReader->Delete();
+  vtkOpenFOAMReaderParentLock.Lock();
   this->Parent->NumberOfReaders += this->Readers->GetNumberOfItems();
+  vtkOpenFOAMReaderParentLock.Unlock();
 
   if (this->Parent == this)
     {
@@ -8651,6 +9017,10 @@ void vtkOpenFOAMReader::UpdateStatus()
 //-----------------------------------------------------------------------------
 void vtkOpenFOAMReader::UpdateProgress(double amount)
 {
+  if (this->UpdatingReadersConcurrently)
+    {
+    return;
+    }
   this->vtkAlgorithm::UpdateProgress((static_cast<double>(this->Parent->CurrentReaderIndex)
       + amount) / static_cast<double>(this->Parent->NumberOfReaders));
 }
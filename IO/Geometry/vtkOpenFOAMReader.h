@@ -288,6 +288,9 @@ protected:
   int NumberOfReaders;
   // index of the active reader
   int CurrentReaderIndex;
+  // set while vtkPOpenFOAMReader updates the readers of the processor
+  // directories concurrently, when they do not report progress
+  bool UpdatingReadersConcurrently;
 
   vtkOpenFOAMReader();
   ~vtkOpenFOAMReader();
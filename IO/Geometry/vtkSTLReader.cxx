@@ -21,14 +21,23 @@
 #include "vtkFloatArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 vtkStandardNewMacro(vtkSTLReader);
@@ -38,6 +47,243 @@ vtkStandardNewMacro(vtkSTLReader);
 
 vtkCxxSetObjectMacro(vtkSTLReader,Locator,vtkIncrementalPointLocator);
 
+namespace {
+
+// Size of the blocks in which ASCII files are read.
+const size_t vtkSTLReaderBlockSize = 16*1024*1024;
+
+// Number of values converted by each task of a parallel loop.
+const vtkIdType vtkSTLReaderGrain = 4096;
+
+//----------------------------------------------------------------------------
+// Decodes the vertices of the facets of a binary file, and makes one
+// triangle of each facet.
+class vtkSTLReaderBinaryFunctor
+{
+public:
+  const char* Facets;
+  float* Points;
+  vtkIdType* Cells;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      // skip the normal, and ignore the attribute byte count
+      float* x = this->Points + 9*i;
+      memcpy(x, this->Facets + 50*i + 12, 9*sizeof(float));
+      vtkByteSwap::Swap4LERange(x, 9);
+      vtkIdType* cell = this->Cells + 4*i;
+      cell[0] = 3;
+      cell[1] = 3*i;
+      cell[2] = 3*i + 1;
+      cell[3] = 3*i + 2;
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Converts the coordinates of the vertex lines of an ASCII file.
+class vtkSTLReaderASCIIFunctor
+{
+public:
+  const char* const* Lines;
+  float* Points;
+  char* Valid;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      const char* text = this->Lines[i];
+      char* next;
+      bool valid = true;
+      for (int j = 0; j < 3; j++)
+        {
+        this->Points[3*i + j] = strtof(text, &next);
+        valid = valid && (next != text);
+        text = next;
+        }
+      this->Valid[i] = valid;
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Orders point ids by coordinates, and ids with the same coordinates by
+// value.  Coordinates are compared like vtkMergePoints does, so that 0.0
+// and -0.0 are the same, but NaN must be excluded.
+class vtkSTLReaderPointLess
+{
+public:
+  const float* Points;
+
+  bool operator()(vtkIdType a, vtkIdType b) const
+  {
+    const float* x = this->Points + 3*a;
+    const float* y = this->Points + 3*b;
+    for (int j = 0; j < 3; j++)
+      {
+      if (x[j] != y[j])
+        {
+        return (x[j] < y[j]);
+        }
+      }
+    return (a < b);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Sorts the ids in each range of Width ids.
+class vtkSTLReaderSortFunctor
+{
+public:
+  vtkIdType* Ids;
+  vtkIdType NumberOfIds;
+  vtkIdType Width;
+  vtkSTLReaderPointLess Less;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType first = i*this->Width;
+      vtkIdType last = std::min(first + this->Width, this->NumberOfIds);
+      std::sort(this->Ids + first, this->Ids + last, this->Less);
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Merges the pairs of consecutive sorted ranges of Width ids.
+class vtkSTLReaderMergeFunctor
+{
+public:
+  vtkIdType* Ids;
+  vtkIdType NumberOfIds;
+  vtkIdType Width;
+  vtkSTLReaderPointLess Less;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType first = 2*i*this->Width;
+      vtkIdType middle = std::min(first + this->Width, this->NumberOfIds);
+      vtkIdType last = std::min(middle + this->Width, this->NumberOfIds);
+      std::inplace_merge(this->Ids + first, this->Ids + middle,
+                         this->Ids + last, this->Less);
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Merge coincident points and remove the triangles that become degenerate.
+// The result is the same as inserting the points of each triangle in turn
+// into a vtkMergePoints locator: the points keep the order of their first
+// occurrence and the coordinates of that occurrence.  The coincident
+// points are found by sorting instead of with a locator so that the work
+// can be shared between threads.
+void vtkSTLReaderMergePoints(vtkFloatArray* points, vtkIdTypeArray* cells,
+                             vtkFloatArray* scalars, vtkPoints* mergedPts,
+                             vtkCellArray* mergedPolys,
+                             vtkFloatArray* mergedScalars)
+{
+  vtkIdType numPts = points->GetNumberOfTuples();
+  const float* x = points->GetPointer(0);
+
+  // Sort the points, but keep the points with a NaN coordinate apart
+  // since they are never merged.
+  std::vector<vtkIdType> ids;
+  ids.reserve(numPts);
+  for (vtkIdType i = 0; i < numPts; i++)
+    {
+    if (!vtkMath::IsNan(x[3*i]) && !vtkMath::IsNan(x[3*i + 1]) &&
+        !vtkMath::IsNan(x[3*i + 2]))
+      {
+      ids.push_back(i);
+      }
+    }
+  vtkIdType numIds = static_cast<vtkIdType>(ids.size());
+  vtkSTLReaderPointLess less;
+  less.Points = x;
+  if (numIds > 0)
+    {
+    vtkIdType width = 65536;
+    vtkSTLReaderSortFunctor sorter;
+    sorter.Ids = &ids[0];
+    sorter.NumberOfIds = numIds;
+    sorter.Width = width;
+    sorter.Less = less;
+    vtkSMPTools::For(0, (numIds + width - 1)/width, 1, sorter);
+    for (; width < numIds; width *= 2)
+      {
+      vtkSTLReaderMergeFunctor merger;
+      merger.Ids = &ids[0];
+      merger.NumberOfIds = numIds;
+      merger.Width = width;
+      merger.Less = less;
+      vtkSMPTools::For(0, (numIds + 2*width - 1)/(2*width), 1, merger);
+      }
+    }
+
+  // The first id of each run of coincident points is the smallest.
+  std::vector<vtkIdType> first(numPts);
+  for (vtkIdType i = 0; i < numPts; i++)
+    {
+    first[i] = i;
+    }
+  for (vtkIdType i = 1; i < numIds; i++)
+    {
+    const float* p = x + 3*ids[i];
+    const float* q = x + 3*ids[i - 1];
+    if (p[0] == q[0] && p[1] == q[1] && p[2] == q[2])
+      {
+      first[ids[i]] = first[ids[i - 1]];
+      }
+    }
+
+  // Number the points in the order of their first occurrence.
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkIdType numMerged = 0;
+  for (vtkIdType i = 0; i < numPts; i++)
+    {
+    pointMap[i] = (first[i] == i ? numMerged++ : pointMap[first[i]]);
+    }
+  mergedPts->SetNumberOfPoints(numMerged);
+  for (vtkIdType i = 0; i < numPts; i++)
+    {
+    if (first[i] == i)
+      {
+      mergedPts->SetPoint(pointMap[i], x + 3*i);
+      }
+    }
+
+  vtkIdType numCells = cells->GetNumberOfTuples()/4;
+  const vtkIdType* cell = cells->GetPointer(0);
+  vtkNew<vtkIdTypeArray> mergedCells;
+  mergedCells->Allocate(4*numCells);
+  for (vtkIdType i = 0; i < numCells; i++, cell += 4)
+    {
+    vtkIdType nodes[4] = { 3, pointMap[cell[1]], pointMap[cell[2]],
+                           pointMap[cell[3]] };
+    if (nodes[1] != nodes[2] && nodes[1] != nodes[3] && nodes[2] != nodes[3])
+      {
+      vtkIdType* merged =
+        mergedCells->WritePointer(mergedCells->GetNumberOfTuples(), 4);
+      memcpy(merged, nodes, sizeof(nodes));
+      if (scalars)
+        {
+        mergedScalars->InsertNextValue(scalars->GetValue(i));
+        }
+      }
+    }
+  mergedPolys->SetCells(mergedCells->GetNumberOfTuples()/4,
+                        mergedCells.GetPointer());
+}
+
+} // end anonymous namespace
+
 // Construct object with merging set to true.
 vtkSTLReader::vtkSTLReader()
 {
@@ -176,32 +422,45 @@ int vtkSTLReader::RequestData(
       mergedScalars->Allocate(newPolys->GetSize());
       }
 
-    vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
-    if (this->Locator == NULL)
+    // Without a locator, the points are merged in bulk with the same
+    // result as the default locator.
+    vtkFloatArray *points = vtkFloatArray::SafeDownCast(newPts->GetData());
+    if (this->Locator == NULL && points &&
+        newPolys->GetNumberOfConnectivityEntries() ==
+        4*newPolys->GetNumberOfCells())
       {
-      locator.TakeReference(this->NewDefaultLocator());
+      vtkSTLReaderMergePoints(points, newPolys->GetData(), newScalars,
+                              mergedPts, mergedPolys, mergedScalars);
       }
-    locator->InitPointInsertion (mergedPts, newPts->GetBounds());
-
-    for (newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts); )
+    else
       {
-      for (i=0; i < 3; i++)
+      vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
+      if (this->Locator == NULL)
         {
-        newPts->GetPoint(pts[i],x);
-        locator->InsertUniquePoint(x, nodes[i]);
+        locator.TakeReference(this->NewDefaultLocator());
         }
+      locator->InitPointInsertion (mergedPts, newPts->GetBounds());
 
-      if ( nodes[0] != nodes[1] &&
-           nodes[0] != nodes[2] &&
-           nodes[1] != nodes[2] )
+      for (newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts); )
         {
-        mergedPolys->InsertNextCell(3,nodes);
-        if (newScalars)
+        for (i=0; i < 3; i++)
           {
-          mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+          newPts->GetPoint(pts[i],x);
+          locator->InsertUniquePoint(x, nodes[i]);
           }
+
+        if ( nodes[0] != nodes[1] &&
+             nodes[0] != nodes[2] &&
+             nodes[1] != nodes[2] )
+          {
+          mergedPolys->InsertNextCell(3,nodes);
+          if (newScalars)
+            {
+            mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+            }
+          }
+        nextCell++;
         }
-      nextCell++;
       }
 
     newPts->Delete();
@@ -250,13 +509,9 @@ int vtkSTLReader::RequestData(
 bool vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
                                  vtkCellArray *newPolys)
 {
-  int i, numTris;
-  vtkIdType pts[3];
+  int numTris;
   unsigned long   ulint;
-  unsigned short  ibuff2;
   char    header[81];
-  typedef struct  {float  n[3], v1[3], v2[3], v3[3];} facet_t;
-  facet_t facet;
 
   vtkDebugMacro(<< " Reading BINARY STL file");
 
@@ -285,189 +540,183 @@ bool vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
     << numTris << ")");
     }
 
-  // Verify the numTris with the length of the file
-  unsigned long ulFileLength = vtksys::SystemTools::FileLength(this->FileName);
-  ulFileLength -= (80 + 4); // 80 byte - header, 4 byte - tringle count
-  ulFileLength /= 50;       // 50 byte - twelve 32-bit-floating point numbers + 2 byte for attribute byte count
-
-  if (numTris < static_cast<int>(ulFileLength))
-    numTris = static_cast<int>(ulFileLength);
-
-  // now we can allocate the memory we need for this STL file
-  newPts->Allocate(numTris*3,10000);
-  newPolys->Allocate(numTris,20000);
-
-  for ( i=0; fread(&facet,48,1,fp) > 0; i++ )
+  // The facets are decoded straight from a mapping of the file, or from a
+  // copy of the file if it cannot be mapped.
+  vtkNew<vtkMemoryMappedFile> mappedFile;
+  std::vector<char> buffer;
+  const char *facets;
+  vtkTypeUInt64 length;
+  if (mappedFile->Open(this->FileName) && mappedFile->GetSize() >= 84)
     {
-    if (fread(&ibuff2,2,1,fp) != 1) //read extra junk
-      {
-      vtkErrorMacro ("STLReader error reading file: " << this->FileName
-                     << " Premature EOF while reading extra junk.");
-      return false;
-      }
-
-    vtkByteSwap::Swap4LE (facet.n);
-    vtkByteSwap::Swap4LE (facet.n+1);
-    vtkByteSwap::Swap4LE (facet.n+2);
-
-    vtkByteSwap::Swap4LE (facet.v1);
-    vtkByteSwap::Swap4LE (facet.v1+1);
-    vtkByteSwap::Swap4LE (facet.v1+2);
-    pts[0] = newPts->InsertNextPoint(facet.v1);
-
-    vtkByteSwap::Swap4LE (facet.v2);
-    vtkByteSwap::Swap4LE (facet.v2+1);
-    vtkByteSwap::Swap4LE (facet.v2+2);
-    pts[1] = newPts->InsertNextPoint(facet.v2);
-
-    vtkByteSwap::Swap4LE (facet.v3);
-    vtkByteSwap::Swap4LE (facet.v3+1);
-    vtkByteSwap::Swap4LE (facet.v3+2);
-    pts[2] = newPts->InsertNextPoint(facet.v3);
-
-    newPolys->InsertNextCell(3,pts);
+    facets = reinterpret_cast<const char *>(mappedFile->GetData()) + 84;
+    length = mappedFile->GetSize() - 84;
+    }
+  else
+    {
+    length = vtksys::SystemTools::FileLength(this->FileName);
+    length = (length > 84 ? length - 84 : 0);
+    buffer.resize(length + 1);
+    length = fread(&buffer[0], 1, length, fp);
+    facets = &buffer[0];
+    }
 
-    if ( (i % 5000) == 0 && i != 0 )
-      {
-      vtkDebugMacro(<< "triangle# " << i);
-      this->UpdateProgress(static_cast<double>(i)/numTris);
-      }
+  // Each facet holds twelve 32-bit floating point numbers and a 2 byte
+  // attribute byte count.  A facet without the attribute byte count is an
+  // error, a shorter facet is ignored.
+  vtkIdType numFacets = static_cast<vtkIdType>(length / 50);
+  if (length % 50 >= 48)
+    {
+    vtkErrorMacro ("STLReader error reading file: " << this->FileName
+                   << " Premature EOF while reading extra junk.");
+    return false;
     }
 
+  vtkNew<vtkFloatArray> points;
+  points->SetNumberOfComponents(3);
+  points->SetNumberOfTuples(3*numFacets);
+  vtkNew<vtkIdTypeArray> cells;
+  cells->SetNumberOfValues(4*numFacets);
+  vtkSTLReaderBinaryFunctor functor;
+  functor.Facets = facets;
+  functor.Points = points->GetPointer(0);
+  functor.Cells = cells->GetPointer(0);
+  vtkSMPTools::For(0, numFacets, vtkSTLReaderGrain, functor);
+
+  newPts->SetData(points.GetPointer());
+  newPolys->SetCells(numFacets, cells.GetPointer());
+  this->UpdateProgress(1.0);
+
   return true;
 }
 
 bool vtkSTLReader::ReadASCIISTL(FILE *fp, vtkPoints *newPts,
                                 vtkCellArray *newPolys, vtkFloatArray *scalars)
 {
-  char line[256];
-  float x[3];
-  vtkIdType pts[3];
-  int done;
   int currentSolid = 0;
 
   vtkDebugMacro(<< " Reading ASCII STL file");
 
-  //  Ingest header and junk to get to first vertex
-  //
-  if (!fgets (line, 255, fp))
-    {
-    vtkErrorMacro ("STLReader error reading file: " << this->FileName
-                   << " Premature EOF while reading header.");
-    return false;
-    }
-
-  done = (fscanf(fp,"%s %*s %f %f %f\n", line, x, x+1, x+2)==EOF);
-  if ((strcmp(line, "COLOR") == 0) || (strcmp(line, "color") == 0))
-    {
-      done = (fscanf(fp,"%s %*s %f %f %f\n", line, x, x+1, x+2)==EOF);
-    }
-
-  //  Go into loop, reading  facet normal and vertices
-  //
-//  while (fscanf(fp,"%*s %*s %f %f %f\n", x, x+1, x+2)!=EOF)
+  // The file is read in large blocks of whole lines.  The vertex lines of
+  // each block are found first, and their coordinates are then converted
+  // in parallel.  Only the vertex and endsolid keywords matter, the facets
+  // are made of each three consecutive vertices.
+  vtkNew<vtkFloatArray> points;
+  points->SetNumberOfComponents(3);
+  std::vector<char> block;
+  std::vector<const char *> lines;
+  std::vector<char> valid;
+  size_t carry = 0;
+  unsigned long fileLength = vtksys::SystemTools::FileLength(this->FileName);
+  unsigned long bytesRead = 0;
+  bool done = false;
   while (!done)
     {
-//if (ctr>=253840) {
-//    fprintf(stdout, "Reading record %d\n", ctr);
-//}
-//ctr += 7;
-    if (!fgets (line, 255, fp))
+    block.resize(carry + vtkSTLReaderBlockSize + 1);
+    size_t n = fread(&block[carry], 1, vtkSTLReaderBlockSize, fp);
+    size_t length = carry + n;
+    bytesRead += static_cast<unsigned long>(n);
+    done = (n < vtkSTLReaderBlockSize);
+
+    // Keep the last incomplete line for the next block.
+    size_t end = length;
+    if (!done)
       {
-      vtkErrorMacro ("STLReader error reading file: " << this->FileName
-                     << " Premature EOF while reading header.");
-      return false;
+      while (end > 0 && block[end - 1] != '\n')
+        {
+        --end;
+        }
+      if (end == 0)
+        {
+        carry = length;
+        continue;
+        }
       }
 
-    if (fscanf (fp, "%*s %f %f %f\n", x,x+1,x+2) != 3)
+    lines.clear();
+    char *text = &block[0];
+    char *blockEnd = text + end;
+    while (text < blockEnd)
       {
-      vtkErrorMacro ("STLReader error reading file: " << this->FileName
-                     << " Premature EOF while reading point.");
-      return false;
-      }
+      char *lineEnd =
+        static_cast<char *>(memchr(text, '\n', blockEnd - text));
+      if (!lineEnd)
+        {
+        lineEnd = blockEnd;
+        }
+      *lineEnd = '\0';
 
-    pts[0] = newPts->InsertNextPoint(x);
-    if (fscanf (fp, "%*s %f %f %f\n", x,x+1,x+2) != 3)
-      {
-      vtkErrorMacro ("STLReader error reading file: " << this->FileName
-                     << " Premature EOF while reading point.");
-      return false;
+      while (*text == ' ' || *text == '\t' || *text == '\r')
+        {
+        ++text;
+        }
+      if (strncmp(text, "vertex", 6) == 0 || strncmp(text, "VERTEX", 6) == 0)
+        {
+        lines.push_back(text + 6);
+        if (scalars && (points->GetNumberOfTuples() + lines.size()) % 3 == 0)
+          {
+          scalars->InsertNextValue(currentSolid);
+          }
+        }
+      else if (strncmp(text, "endsolid", 8) == 0 ||
+               strncmp(text, "ENDSOLID", 8) == 0)
+        {
+        currentSolid++;
+        }
+      text = lineEnd + 1;
       }
 
-    pts[1] = newPts->InsertNextPoint(x);
-    if (fscanf (fp, "%*s %f %f %f\n", x,x+1,x+2) != 3)
+    vtkIdType numLines = static_cast<vtkIdType>(lines.size());
+    if (numLines > 0)
       {
-      vtkErrorMacro ("STLReader error reading file: " << this->FileName
-                     << " Premature EOF while reading point.");
-      return false;
+      valid.resize(numLines);
+      vtkSTLReaderASCIIFunctor functor;
+      functor.Lines = &lines[0];
+      functor.Points =
+        points->WritePointer(3*points->GetNumberOfTuples(), 3*numLines);
+      functor.Valid = &valid[0];
+      vtkSMPTools::For(0, numLines, vtkSTLReaderGrain, functor);
+      if (std::find(valid.begin(), valid.end(), 0) != valid.end())
+        {
+        vtkErrorMacro ("STLReader error reading file: " << this->FileName
+                       << " Premature EOF while reading point.");
+        return false;
+        }
       }
 
-    pts[2] = newPts->InsertNextPoint(x);
-    if (!fgets (line, 255, fp)) // end loop
+    carry = (end < length ? length - end : 0);
+    if (carry > 0)
       {
-      vtkErrorMacro ("STLReader error reading file: " << this->FileName
-                     << " Premature EOF while reading end loop.");
-      return false;
+      memmove(&block[0], &block[end], carry);
       }
-    if (!fgets (line, 255, fp)) // end facet
+    if (fileLength > 0)
       {
-      vtkErrorMacro ("STLReader error reading file: " << this->FileName
-                     << " Premature EOF while reading end facet.");
-      return false;
+      this->UpdateProgress(static_cast<double>(bytesRead)/fileLength);
       }
+    }
 
-    newPolys->InsertNextCell(3,pts);
-    if (scalars)
-      {
-      scalars->InsertNextValue(currentSolid);
-      }
+  vtkIdType numPts = points->GetNumberOfTuples();
+  if (numPts % 3 != 0)
+    {
+    vtkErrorMacro ("STLReader error reading file: " << this->FileName
+                   << " Premature EOF while reading point.");
+    return false;
+    }
 
-    if ( (newPolys->GetNumberOfCells() % 5000) == 0 )
-      {
-      vtkDebugMacro(<< "triangle# " << newPolys->GetNumberOfCells());
-      this->UpdateProgress((newPolys->GetNumberOfCells()%50000)/50000.0);
-      }
-    done = (fscanf(fp,"%s", line)==EOF);
-    if ((strcmp(line, "ENDSOLID") == 0) || (strcmp(line, "endsolid") == 0))
-      {
-      currentSolid++;
-      if (!fgets(line, 255, fp))
-        {
-        vtkErrorMacro ("STLReader error reading file: " << this->FileName
-                       << " Premature EOF while reading solid.");
-        return false;
-        }
+  vtkIdType numTris = numPts/3;
+  vtkNew<vtkIdTypeArray> cells;
+  cells->SetNumberOfValues(4*numTris);
+  vtkIdType *cell = cells->GetPointer(0);
+  for (vtkIdType i = 0; i < numPts; i += 3, cell += 4)
+    {
+    cell[0] = 3;
+    cell[1] = i;
+    cell[2] = i + 1;
+    cell[3] = i + 2;
+    }
 
-      done = feof(fp);
-      while ((strstr(line, "SOLID") == 0) && (strstr(line, "solid") == 0) && !done)
-        {
-        if (!fgets(line, 255, fp))
-          {
-          // if fgets() returns an error, it may be due to the fact that the EOF
-          // is reached (BUG #13101) hence we test again.
-          done = feof(fp);
-          if (!done)
-            {
-            vtkErrorMacro ("STLReader error reading file: " << this->FileName
-              << " Premature EOF while reading end solid.");
-            return false;
-            }
-          }
-        done = feof(fp);
-        }
+  newPts->SetData(points.GetPointer());
+  newPolys->SetCells(numTris, cells.GetPointer());
 
-      done = (fscanf(fp,"%s", line)==EOF);
-      if ((strstr(line, "COLOR") == 0) || (strstr(line, "color") == 0))
-        {
-          done = (fscanf(fp,"%f %f %f\n", x,x+1,x+2)==EOF);
-          done = done || (fscanf(fp,"%s", line)==EOF);
-        }
-      }
-    if (!done) {
-    done = (fscanf(fp,"%*s %f %f %f\n", x, x+1, x+2)==EOF);
-    }
-    }
-  //fprintf(stdout, "Maximum ctr val %d\n", ctr);
   return true;
 }
 
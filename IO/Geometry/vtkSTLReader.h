@@ -74,7 +74,9 @@ public:
 
   // Description:
   // Specify a spatial locator for merging points. By
-  // default an instance of vtkMergePoints is used.
+  // default an instance of vtkMergePoints is used.  When no locator is
+  // set, the points are merged by sorting them on multiple threads, with
+  // the same result as the default locator.
   void SetLocator(vtkIncrementalPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkIncrementalPointLocator);
 
@@ -0,0 +1,186 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageReaderSliceSeries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that a sub-extent of a PNG, JPEG or TIFF series read with the
+// slices decoded concurrently is the one read slice by slice.
+
+#include "vtkImageData.h"
+#include "vtkImageReader2.h"
+#include "vtkImageWriter.h"
+#include "vtkJPEGReader.h"
+#include "vtkJPEGWriter.h"
+#include "vtkNew.h"
+#include "vtkPNGReader.h"
+#include "vtkPNGWriter.h"
+#include "vtkSmartPointer.h"
+#include "vtkTIFFReader.h"
+#include "vtkTIFFWriter.h"
+#include "vtkTestUtilities.h"
+
+#include <string.h>
+#include <string>
+
+static const int Dimensions[3] = { 64, 48, 12 };
+
+static void MakeImage(vtkImageData* image, int numComponents)
+{
+  image->SetDimensions(Dimensions[0], Dimensions[1], Dimensions[2]);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, numComponents);
+  for (int k = 0; k < Dimensions[2]; k++)
+    {
+    for (int j = 0; j < Dimensions[1]; j++)
+      {
+      for (int i = 0; i < Dimensions[0]; i++)
+        {
+        unsigned char* pixel =
+          static_cast<unsigned char*>(image->GetScalarPointer(i, j, k));
+        for (int c = 0; c < numComponents; c++)
+          {
+          pixel[c] = static_cast<unsigned char>(4*i + 5*j + 20*k + 60*c);
+          }
+        }
+      }
+    }
+}
+
+// Compare the pixels of the extent of a with those of b.
+static bool SamePixels(vtkImageData* a, vtkImageData* b)
+{
+  int extent[6];
+  a->GetExtent(extent);
+  int n = a->GetNumberOfScalarComponents();
+  if (n != b->GetNumberOfScalarComponents() ||
+      a->GetScalarType() != b->GetScalarType())
+    {
+    return false;
+    }
+  for (int k = extent[4]; k <= extent[5]; k++)
+    {
+    for (int j = extent[2]; j <= extent[3]; j++)
+      {
+      if (memcmp(a->GetScalarPointer(extent[0], j, k),
+                 b->GetScalarPointer(extent[0], j, k),
+                 n*(extent[1] - extent[0] + 1)) != 0)
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+static vtkSmartPointer<vtkImageData> ReadSeries(vtkImageReader2* reader,
+                                                const std::string& prefix,
+                                                const char* pattern,
+                                                int* extent, int concurrently)
+{
+  reader->SetFilePrefix(prefix.c_str());
+  reader->SetFilePattern(pattern);
+  reader->SetDataExtent(0, Dimensions[0] - 1, 0, Dimensions[1] - 1,
+                        0, Dimensions[2] - 1);
+  reader->SetReadSlicesConcurrently(concurrently);
+  reader->UpdateInformation();
+  reader->SetUpdateExtent(0, extent);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+// Write the image as a series and compare the sub-extent read in both
+// ways with the whole series, and with the image itself if exact.
+static int TestSeries(vtkImageWriter* writer, const std::string& prefix,
+                      const char* pattern, int numComponents, bool exact,
+                      vtkImageReader2* serialReader,
+                      vtkImageReader2* concurrentReader)
+{
+  vtkNew<vtkImageData> image;
+  MakeImage(image.GetPointer(), numComponents);
+  writer->SetInputData(image.GetPointer());
+  writer->SetFilePrefix(prefix.c_str());
+  writer->SetFilePattern(pattern);
+  writer->SetFileDimensionality(2);
+  writer->Write();
+
+  int wholeExtent[6] = { 0, Dimensions[0] - 1, 0, Dimensions[1] - 1,
+                         0, Dimensions[2] - 1 };
+  int subExtent[6] = { 5, 40, 3, 20, 4, 9 };
+  vtkSmartPointer<vtkImageData> whole =
+    ReadSeries(serialReader, prefix, pattern, wholeExtent, 0);
+  vtkSmartPointer<vtkImageData> serial =
+    ReadSeries(serialReader, prefix, pattern, subExtent, 0);
+  vtkSmartPointer<vtkImageData> concurrent =
+    ReadSeries(concurrentReader, prefix, pattern, subExtent, 1);
+
+  int extent[6];
+  concurrent->GetExtent(extent);
+  for (int i = 0; i < 6; i++)
+    {
+    if (extent[i] != subExtent[i])
+      {
+      cerr << prefix << ": wrong extent read\n";
+      return 1;
+      }
+    }
+  if (!SamePixels(concurrent, serial) || !SamePixels(concurrent, whole) ||
+      (exact && !SamePixels(concurrent, image.GetPointer())))
+    {
+    cerr << prefix << ": the slices read concurrently differ\n";
+    return 1;
+    }
+  return 0;
+}
+
+int TestImageReaderSliceSeries(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory.\n";
+    return 1;
+    }
+  std::string prefix = tempDir;
+  prefix += "/TestImageReaderSliceSeries";
+  delete [] tempDir;
+
+  int errors = 0;
+  vtkNew<vtkPNGWriter> pngWriter;
+  vtkNew<vtkPNGReader> pngSerial;
+  vtkNew<vtkPNGReader> pngConcurrent;
+  errors += TestSeries(pngWriter.GetPointer(), prefix + "-png",
+                       "%s.%03d.png", 3, true,
+                       pngSerial.GetPointer(), pngConcurrent.GetPointer());
+
+  vtkNew<vtkJPEGWriter> jpegWriter;
+  vtkNew<vtkJPEGReader> jpegSerial;
+  vtkNew<vtkJPEGReader> jpegConcurrent;
+  errors += TestSeries(jpegWriter.GetPointer(), prefix + "-jpeg",
+                       "%s.%03d.jpg", 3, false,
+                       jpegSerial.GetPointer(), jpegConcurrent.GetPointer());
+
+  // The TIFF reader flips the rows written by the TIFF writer, and reads
+  // the grayscale rows of compressed files only from the top.
+  vtkNew<vtkTIFFWriter> tiffWriter;
+  tiffWriter->SetCompressionToNoCompression();
+  vtkNew<vtkTIFFReader> tiffSerial;
+  vtkNew<vtkTIFFReader> tiffConcurrent;
+  errors += TestSeries(tiffWriter.GetPointer(), prefix + "-tiff",
+                       "%s.%03d.tif", 1, false,
+                       tiffSerial.GetPointer(), tiffConcurrent.GetPointer());
+  tiffWriter->SetCompressionToDeflate();
+  errors += TestSeries(tiffWriter.GetPointer(), prefix + "-tiff-rgb",
+                       "%s.%03d.tif", 3, false,
+                       tiffSerial.GetPointer(), tiffConcurrent.GetPointer());
+
+  return (errors != 0);
+}
@@ -72,6 +72,8 @@ vtkImageReader2::vtkImageReader2()
   this->FileNameSliceOffset = 0;
   this->FileNameSliceSpacing = 1;
 
+  this->ReadSlicesConcurrently = 0;
+
   // Left over from short reader
   this->SwapBytes = 0;
   this->FileLowerLeft = 0;
@@ -119,17 +121,25 @@ void vtkImageReader2::ComputeInternalFileName(int slice)
     return;
     }
 
+  this->InternalFileName = this->ComputeFileName(slice);
+}
+
+//----------------------------------------------------------------------------
+char *vtkImageReader2::ComputeFileName(int slice)
+{
+  char *fileName = NULL;
+
   // make sure we figure out a filename to open
   if (this->FileNames)
     {
     const char *filename = this->FileNames->GetValue(slice);
-    this->InternalFileName = new char [strlen(filename) + 10];
-    sprintf(this->InternalFileName,"%s",filename);
+    fileName = new char [strlen(filename) + 10];
+    sprintf(fileName,"%s",filename);
     }
   else if (this->FileName)
     {
-    this->InternalFileName = new char [strlen(this->FileName) + 10];
-    sprintf(this->InternalFileName,"%s",this->FileName);
+    fileName = new char [strlen(this->FileName) + 10];
+    sprintf(fileName,"%s",this->FileName);
     }
   else
     {
@@ -138,14 +148,14 @@ void vtkImageReader2::ComputeInternalFileName(int slice)
       + this->FileNameSliceOffset;
     if (this->FilePrefix && this->FilePattern)
       {
-      this->InternalFileName = new char [strlen(this->FilePrefix) +
-                                        strlen(this->FilePattern) + 10];
-      sprintf (this->InternalFileName, this->FilePattern,
+      fileName = new char [strlen(this->FilePrefix) +
+                           strlen(this->FilePattern) + 10];
+      sprintf (fileName, this->FilePattern,
                this->FilePrefix, slicenum);
       }
     else if (this->FilePattern)
       {
-      this->InternalFileName = new char [strlen(this->FilePattern) + 10];
+      fileName = new char [strlen(this->FilePattern) + 10];
       int len = static_cast<int>(strlen(this->FilePattern));
       int hasPercentS = 0;
       for(int i =0; i < len-1; ++i)
@@ -158,22 +168,17 @@ void vtkImageReader2::ComputeInternalFileName(int slice)
         }
       if(hasPercentS)
         {
-        sprintf (this->InternalFileName, this->FilePattern, "", slicenum);
+        sprintf (fileName, this->FilePattern, "", slicenum);
         }
       else
         {
-        sprintf (this->InternalFileName, this->FilePattern, slicenum);
+        sprintf (fileName, this->FilePattern, slicenum);
         }
       }
-    else
-      {
-      delete [] this->InternalFileName;
-      this->InternalFileName = 0;
-      }
     }
+  return fileName;
 }
 
-
 //----------------------------------------------------------------------------
 // This function sets the name of the file.
 void vtkImageReader2::SetFileName(const char *name)
@@ -410,6 +415,8 @@ void vtkImageReader2::PrintSelf(ostream& os, vtkIndent indent)
      << this->FileNameSliceOffset << "\n";
   os << indent << "FileNameSliceSpacing: "
      << this->FileNameSliceSpacing << "\n";
+  os << indent << "ReadSlicesConcurrently: "
+     << (this->ReadSlicesConcurrently ? "On\n" : "Off\n");
 
   os << indent << "DataScalarType: "
      << vtkImageScalarTypeNameMacro(this->DataScalarType) << "\n";
@@ -184,6 +184,15 @@ public:
   vtkSetMacro(FileNameSliceSpacing,int);
   vtkGetMacro(FileNameSliceSpacing,int);
 
+  // Description:
+  // When reading a series with one file per slice, decode the slices in
+  // the update extent concurrently, each straight into its place in the
+  // output.  This is used by the readers of PNG, JPEG and TIFF series
+  // (default = off).
+  vtkSetMacro(ReadSlicesConcurrently,int);
+  vtkGetMacro(ReadSlicesConcurrently,int);
+  vtkBooleanMacro(ReadSlicesConcurrently,int);
+
 
   // Description:
   // Set/Get the byte swapping to explicitly swap the bytes of a file.
@@ -211,6 +220,13 @@ public:
   virtual void ComputeInternalFileName(int slice);
   vtkGetStringMacro(InternalFileName);
 
+  // Description:
+  // Return the name of the file of the given slice in a new array that the
+  // caller must delete, or NULL if no file name is set.  Unlike
+  // ComputeInternalFileName, this does not change the reader, so several
+  // threads may call it at once.
+  char *ComputeFileName(int slice);
+
   // Description:
   // Return non zero if the reader can read the given file name.
   // Should be implemented by all sub-classes of vtkImageReader2.
@@ -270,6 +286,7 @@ protected:
 
   int FileNameSliceOffset;
   int FileNameSliceSpacing;
+  int ReadSlicesConcurrently;
 
   virtual int RequestInformation(vtkInformation* request,
                                  vtkInformationVector** inputVector,
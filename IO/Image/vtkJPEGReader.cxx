@@ -18,8 +18,12 @@
 #include "vtkImageData.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkToolkits.h"
 
+#include <vector>
+
 extern "C" {
 #include "vtk_jpeg.h"
 #if defined(__sgi) && !defined(__GNUC__)
@@ -225,8 +229,9 @@ void vtkJPEGReader::ExecuteInformation()
 }
 
 template <class OT>
-int vtkJPEGReaderUpdate2(vtkJPEGReader *self, OT *outPtr,
-                          int *outExt, vtkIdType *outInc, long)
+int vtkJPEGReaderUpdate2(vtkJPEGReader *self, const char *fileName,
+                         OT *outPtr, int *outExt, vtkIdType *outInc,
+                         std::vector<unsigned char> &buffer)
 {
   // certain variables must be stored here for longjmp
   struct vtk_jpeg_error_mgr jerr;
@@ -235,7 +240,7 @@ int vtkJPEGReaderUpdate2(vtkJPEGReader *self, OT *outPtr,
 
   if (!self->GetMemoryBuffer())
     {
-    jerr.fp = fopen(self->GetInternalFileName(), "rb");
+    jerr.fp = fopen(fileName, "rb");
     if (!jerr.fp)
       {
       return 1;
@@ -284,44 +289,35 @@ int vtkJPEGReaderUpdate2(vtkJPEGReader *self, OT *outPtr,
   // prepare to read the bulk data
   jpeg_start_decompress(&cinfo);
 
-
+  // The rows are stored from the top, so the rows of the extent are the
+  // scanlines firstRow to lastRow, in reverse order.  Decode the scanlines
+  // one at a time, and none below the extent.
   int rowbytes = cinfo.output_components * cinfo.output_width;
-  unsigned char *tempImage = new unsigned char [rowbytes*cinfo.output_height];
-  JSAMPROW *row_pointers = new JSAMPROW [cinfo.output_height];
-  for (unsigned int ui = 0; ui < cinfo.output_height; ++ui)
+  unsigned int firstRow = cinfo.output_height - outExt[3] - 1;
+  unsigned int lastRow = cinfo.output_height - outExt[2] - 1;
+  long outSize = cinfo.output_components*(outExt[1] - outExt[0] + 1);
+  buffer.resize(rowbytes);
+  JSAMPROW row = &buffer[0];
+  while (cinfo.output_scanline <= lastRow)
     {
-    row_pointers[ui] = tempImage + rowbytes*ui;
+    unsigned int scanline = cinfo.output_scanline;
+    jpeg_read_scanlines(&cinfo, &row, 1);
+    if (scanline >= firstRow)
+      {
+      memcpy(outPtr + (lastRow - scanline)*outInc[1],
+             row + outExt[0]*cinfo.output_components, outSize);
+      }
     }
 
-  // read the bulk data
-  unsigned int remainingRows;
-  while (cinfo.output_scanline < cinfo.output_height)
+  // finish the decompression step, unless it stopped early
+  if (cinfo.output_scanline == cinfo.output_height)
     {
-    remainingRows = cinfo.output_height - cinfo.output_scanline;
-    jpeg_read_scanlines(&cinfo, &row_pointers[cinfo.output_scanline],
-                        remainingRows);
+    jpeg_finish_decompress(&cinfo);
     }
 
-  // finish the decompression step
-  jpeg_finish_decompress(&cinfo);
-
   // destroy the decompression object
   jpeg_destroy_decompress(&cinfo);
 
-  // copy the data into the outPtr
-  OT *outPtr2 = outPtr;
-  long outSize = cinfo.output_components*(outExt[1] - outExt[0] + 1);
-  for (int i = outExt[2]; i <= outExt[3]; ++i)
-    {
-    memcpy(outPtr2,
-           row_pointers[cinfo.output_height - i - 1]
-           + outExt[0]*cinfo.output_components,
-           outSize);
-    outPtr2 += outInc[1];
-    }
-  delete [] tempImage;
-  delete [] row_pointers;
-
   // close the file
   if (jerr.fp)
     {
@@ -330,6 +326,38 @@ int vtkJPEGReaderUpdate2(vtkJPEGReader *self, OT *outPtr,
   return 0;
 }
 
+//----------------------------------------------------------------------------
+// Reads a range of slices, each thread with its own scanline buffer.
+template <class OT>
+class vtkJPEGReaderSlices
+{
+public:
+  vtkJPEGReader *Reader;
+  OT *OutPtr;
+  int *OutExt;
+  vtkIdType *OutInc;
+  mutable vtkSMPThreadLocal<std::vector<unsigned char> > Buffers;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    std::vector<unsigned char> &buffer = this->Buffers.Local();
+    for (vtkIdType idx2 = begin; idx2 < end; ++idx2)
+      {
+      char *fileName = this->Reader->ComputeFileName(idx2);
+      if (fileName &&
+          vtkJPEGReaderUpdate2(this->Reader, fileName,
+                               this->OutPtr + (idx2 - this->OutExt[4])*
+                                              this->OutInc[2],
+                               this->OutExt, this->OutInc, buffer) == 2)
+        {
+        vtkErrorWithObjectMacro(this->Reader,
+                                "libjpeg could not read file: " << fileName);
+        }
+      delete [] fileName;
+      }
+  }
+};
+
 //----------------------------------------------------------------------------
 // This function reads in one data of data.
 // templated to handle different data types.
@@ -343,17 +371,28 @@ void vtkJPEGReaderUpdate(vtkJPEGReader *self, vtkImageData *data, OT *outPtr)
   data->GetExtent(outExtent);
   data->GetIncrements(outIncr);
 
-  long pixSize = data->GetNumberOfScalarComponents()*sizeof(OT);
+  if (self->GetReadSlicesConcurrently() && outExtent[5] > outExtent[4])
+    {
+    vtkJPEGReaderSlices<OT> slices;
+    slices.Reader = self;
+    slices.OutPtr = outPtr;
+    slices.OutExt = outExtent;
+    slices.OutInc = outIncr;
+    vtkSMPTools::For(outExtent[4], outExtent[5] + 1, 1, slices);
+    return;
+    }
 
+  std::vector<unsigned char> buffer;
   outPtr2 = outPtr;
   int idx2;
   for (idx2 = outExtent[4]; idx2 <= outExtent[5]; ++idx2)
     {
     self->ComputeInternalFileName(idx2);
     // read in a JPEG file
-    if ( vtkJPEGReaderUpdate2(self, outPtr2, outExtent, outIncr, pixSize) == 2 )
+    const char* fn = self->GetInternalFileName();
+    if ( vtkJPEGReaderUpdate2(self, fn, outPtr2, outExtent, outIncr,
+                              buffer) == 2 )
       {
-      const char* fn = self->GetInternalFileName();
       vtkErrorWithObjectMacro(self, "libjpeg could not read file: " << fn);
       }
 
@@ -18,8 +18,12 @@
 #include "vtkImageData.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtk_png.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkPNGReader);
 
 #ifdef _MSC_VER
@@ -161,14 +165,22 @@ void vtkPNGReader::ExecuteInformation()
 }
 
 
+//----------------------------------------------------------------------------
+// The memory used to decode a file, kept from one file to the next.
+struct vtkPNGReaderBuffers
+{
+  std::vector<unsigned char> Image;
+  std::vector<png_bytep> Rows;
+};
+
 //----------------------------------------------------------------------------
 template <class OT>
-void vtkPNGReaderUpdate2(vtkPNGReader *self, OT *outPtr,
-                         int *outExt, vtkIdType *outInc, long pixSize)
+void vtkPNGReaderUpdate2(const char *fileName, OT *outPtr,
+                         int *outExt, vtkIdType *outInc, long pixSize,
+                         vtkPNGReaderBuffers &buffers)
 {
-  unsigned int ui;
-  int i;
-  FILE *fp = fopen(self->GetInternalFileName(), "rb");
+  png_uint_32 ui;
+  FILE *fp = fopen(fileName, "rb");
   if (!fp)
     {
     return;
@@ -176,7 +188,7 @@ void vtkPNGReaderUpdate2(vtkPNGReader *self, OT *outPtr,
   unsigned char header[8];
   if (fread(header, 1, 8, fp) != 8)
     {
-    vtkGenericWarningMacro ("PNGReader error reading file: " << self->GetInternalFileName()
+    vtkGenericWarningMacro ("PNGReader error reading file: " << fileName
                    << " Premature EOF while reading header.");
     fclose (fp);
     return;
@@ -270,33 +282,88 @@ void vtkPNGReaderUpdate2(vtkPNGReader *self, OT *outPtr,
   // update the info now that we have defined the filters
   png_read_update_info(png_ptr, info_ptr);
 
-  int rowbytes = png_get_rowbytes(png_ptr, info_ptr);
-  unsigned char *tempImage = new unsigned char [rowbytes*height];
-  png_bytep *row_pointers = new png_bytep [height];
-  for (ui = 0; ui < height; ++ui)
-    {
-    row_pointers[ui] = tempImage + rowbytes*ui;
-    }
-  png_read_image(png_ptr, row_pointers);
-
-  // copy the data into the outPtr
-  OT *outPtr2;
-  outPtr2 = outPtr;
+  // The rows are stored from the top, so the rows of the extent are the
+  // file rows firstRow to lastRow, in reverse order.
+  png_size_t rowbytes = png_get_rowbytes(png_ptr, info_ptr);
+  png_uint_32 firstRow = height - outExt[3] - 1;
+  png_uint_32 lastRow = height - outExt[2] - 1;
   long outSize = pixSize*(outExt[1] - outExt[0] + 1);
-  for (i = outExt[2]; i <= outExt[3]; ++i)
+  if (interlace_type == PNG_INTERLACE_NONE)
+    {
+    // decode the rows one at a time, and none below the extent
+    buffers.Image.resize(rowbytes);
+    for (ui = 0; ui <= lastRow; ++ui)
+      {
+      png_read_row(png_ptr, &buffers.Image[0], NULL);
+      if (ui >= firstRow)
+        {
+        memcpy(outPtr + (lastRow - ui)*outInc[1],
+               &buffers.Image[0] + outExt[0]*pixSize, outSize);
+        }
+      }
+    if (lastRow + 1 == height)
+      {
+      png_read_end(png_ptr, NULL);
+      }
+    }
+  else
     {
-    memcpy(outPtr2,row_pointers[height - i - 1] + outExt[0]*pixSize,outSize);
-    outPtr2 += outInc[1];
+    buffers.Image.resize(rowbytes*height);
+    buffers.Rows.resize(height);
+    for (ui = 0; ui < height; ++ui)
+      {
+      buffers.Rows[ui] = &buffers.Image[0] + rowbytes*ui;
+      }
+    png_read_image(png_ptr, &buffers.Rows[0]);
+
+    // copy the data into the outPtr
+    OT *outPtr2 = outPtr;
+    for (int i = outExt[2]; i <= outExt[3]; ++i)
+      {
+      memcpy(outPtr2, buffers.Rows[height - i - 1] + outExt[0]*pixSize,
+             outSize);
+      outPtr2 += outInc[1];
+      }
+    png_read_end(png_ptr, NULL);
     }
-  delete [] tempImage;
-  delete [] row_pointers;
 
   // close the file
-  png_read_end(png_ptr, NULL);
   png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
   fclose(fp);
 }
 
+//----------------------------------------------------------------------------
+// Reads a range of slices, each thread with its own buffers.
+template <class OT>
+class vtkPNGReaderSlices
+{
+public:
+  vtkPNGReader *Reader;
+  OT *OutPtr;
+  int *OutExt;
+  vtkIdType *OutInc;
+  long PixSize;
+  mutable vtkSMPThreadLocal<vtkPNGReaderBuffers> Buffers;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    vtkPNGReaderBuffers &buffers = this->Buffers.Local();
+    for (vtkIdType idx2 = begin; idx2 < end; ++idx2)
+      {
+      char *fileName = this->Reader->ComputeFileName(idx2);
+      if (fileName)
+        {
+        vtkPNGReaderUpdate2(fileName,
+                            this->OutPtr + (idx2 - this->OutExt[4])*
+                                           this->OutInc[2],
+                            this->OutExt, this->OutInc, this->PixSize,
+                            buffers);
+        delete [] fileName;
+        }
+      }
+  }
+};
+
 //----------------------------------------------------------------------------
 // This function reads in one data of data.
 // templated to handle different data types.
@@ -312,13 +379,27 @@ void vtkPNGReaderUpdate(vtkPNGReader *self, vtkImageData *data, OT *outPtr)
 
   long pixSize = data->GetNumberOfScalarComponents()*sizeof(OT);
 
+  if (self->GetReadSlicesConcurrently() && outExtent[5] > outExtent[4])
+    {
+    vtkPNGReaderSlices<OT> slices;
+    slices.Reader = self;
+    slices.OutPtr = outPtr;
+    slices.OutExt = outExtent;
+    slices.OutInc = outIncr;
+    slices.PixSize = pixSize;
+    vtkSMPTools::For(outExtent[4], outExtent[5] + 1, 1, slices);
+    return;
+    }
+
+  vtkPNGReaderBuffers buffers;
   outPtr2 = outPtr;
   int idx2;
   for (idx2 = outExtent[4]; idx2 <= outExtent[5]; ++idx2)
     {
     self->ComputeInternalFileName(idx2);
     // read in a PNG file
-    vtkPNGReaderUpdate2(self, outPtr2, outExtent, outIncr, pixSize);
+    vtkPNGReaderUpdate2(self->GetInternalFileName(), outPtr2, outExtent,
+                        outIncr, pixSize, buffers);
     self->UpdateProgress((idx2 - outExtent[4])/
                          (outExtent[5] - outExtent[4] + 1.0));
     outPtr2 += outIncr[2];
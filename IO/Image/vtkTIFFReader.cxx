@@ -19,6 +19,8 @@
 #include "vtkPointData.h"
 #include "vtkErrorCode.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 
 #include "vtksys/SystemTools.hxx"
 
@@ -606,6 +608,54 @@ void vtkTIFFReader::Process2(OT *outPtr, int *)
 
 }
 
+//----------------------------------------------------------------------------
+// Reads a range of slices, one file per slice.  Each thread decodes with a
+// reader of its own, set up like this one and reused for all its files.
+class vtkTIFFReader::vtkTIFFReaderSlices
+{
+public:
+  vtkTIFFReader *Reader;
+  void *OutPtr;
+  mutable vtkSMPThreadLocalObject<vtkTIFFReader> Readers;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    vtkTIFFReader *self = this->Reader;
+    vtkTIFFReader *reader = this->Readers.Local();
+    reader->DataScalarType = self->DataScalarType;
+    reader->OrientationType = self->OrientationType;
+    reader->OrientationTypeSpecifiedFlag = self->OrientationTypeSpecifiedFlag;
+    for (int i = 0; i < 6; ++i)
+      {
+      reader->OutputExtent[i] = self->OutputExtent[i];
+      }
+    for (int i = 0; i < 3; ++i)
+      {
+      reader->OutputIncrements[i] = self->OutputIncrements[i];
+      }
+
+    for (vtkIdType idx2 = begin; idx2 < end; ++idx2)
+      {
+      delete [] reader->InternalFileName;
+      reader->InternalFileName = self->ComputeFileName(idx2);
+      if (!reader->InternalFileName)
+        {
+        continue;
+        }
+      vtkIdType offset =
+        (idx2 - self->OutputExtent[4])*self->OutputIncrements[2];
+      switch (self->DataScalarType)
+        {
+        vtkTemplateMacro(
+          reader->Process2(static_cast<VTK_TT*>(this->OutPtr) + offset,
+                           reader->OutputExtent));
+        }
+      // close the TIFF file
+      reader->InternalImage->Clean();
+      }
+  }
+};
+
 //----------------------------------------------------------------------------
 // This function reads in one data of data.
 // templated to handle different data types.
@@ -635,6 +685,15 @@ void vtkTIFFReader::Process(OT *outPtr, int outExtent[6], vtkIdType outIncr[3])
   // file
   this->InternalImage->Clean();
 
+  if (this->ReadSlicesConcurrently && outExtent[5] > outExtent[4])
+    {
+    vtkTIFFReaderSlices slices;
+    slices.Reader = this;
+    slices.OutPtr = outPtr;
+    vtkSMPTools::For(outExtent[4], outExtent[5] + 1, 1, slices);
+    return;
+    }
+
   OT *outPtr2 = outPtr;
   for (int idx2 = outExtent[4]; idx2 <= outExtent[5]; ++idx2)
     {
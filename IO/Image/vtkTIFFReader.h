@@ -147,6 +147,7 @@ private:
   void Process2(T *outPtr, int *outExt);
 
   class vtkTIFFReaderInternal;
+  class vtkTIFFReaderSlices;
 
   unsigned short *ColorRed;
   unsigned short *ColorGreen;
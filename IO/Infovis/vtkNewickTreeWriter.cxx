@@ -117,6 +117,19 @@ void vtkNewickTreeWriter::WriteVertex(ostream *fp, vtkTree* const input,
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkNewickTreeWriter::CopyWriterSettings(vtkWriter *writer)
+{
+  if (!this->Superclass::CopyWriterSettings(writer))
+    {
+    return 0;
+    }
+  vtkNewickTreeWriter *copy = static_cast<vtkNewickTreeWriter *>(writer);
+  copy->SetEdgeWeightArrayName(this->EdgeWeightArrayName);
+  copy->SetNodeNameArrayName(this->NodeNameArrayName);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkNewickTreeWriter::FillInputPortInformation(int, vtkInformation *info)
 {
@@ -69,6 +69,10 @@ protected:
 
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
+  // Description:
+  // Copy the array names along with the settings of the superclass.
+  virtual int CopyWriterSettings(vtkWriter *writer);
+
   vtkStdString EdgeWeightArrayName;
   vtkStdString NodeNameArrayName;
 
@@ -0,0 +1,175 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLegacyASCIIParsing.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the values of an ASCII file are identical to those parsed
+// with operator>> in the classic locale, for numbers written in many
+// different ways.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <vtksys/ios/sstream>
+
+// Append the tokens to the file and parse them with operator>>.
+template <class T>
+static void AddTokens(const std::vector<std::string>& tokens,
+                      std::string& file, std::vector<T>& values)
+{
+  for (size_t i = 0; i < tokens.size(); i++)
+    {
+    file += tokens[i];
+    file += ((i % 7) == 6 ? "\n" : " \t ");
+    vtksys_ios::istringstream is(tokens[i]);
+    is.imbue(std::locale::classic());
+    T value;
+    is >> value;
+    values.push_back(value);
+    }
+  file += "\n";
+}
+
+template <class T>
+static int CompareValues(vtkDataArray* array, const std::vector<T>& values,
+                         const char* name)
+{
+  if (!array ||
+      array->GetNumberOfTuples()*array->GetNumberOfComponents() !=
+      static_cast<vtkIdType>(values.size()))
+    {
+    cerr << "Array " << name << " was not read\n";
+    return 1;
+    }
+  for (size_t i = 0; i < values.size(); i++)
+    {
+    if (memcmp(array->GetVoidPointer(i), &values[i], sizeof(T)) != 0)
+      {
+      cerr << "Value " << i << " of " << name << " differs: "
+           << array->GetComponent(i / array->GetNumberOfComponents(),
+                                  i % array->GetNumberOfComponents())
+           << " != " << values[i] << "\n";
+      return 1;
+      }
+    }
+  return 0;
+}
+
+int TestLegacyASCIIParsing(int, char*[])
+{
+  // numbers in every notation accepted by operator>>, within the range
+  // of floats
+  const char* special[] = {
+    "0", "-0", "+0.0", "5.", ".5", "-.25", "+3", "1e5", "1E-5", "2.5e+3",
+    "0.000000000000000000000000001", "123456789012345678901234567890",
+    "9007199254740993", "0.1", "0.3", "1e-310", "4.9406564584124654e-324",
+    "3.4028234e38", "1e-40", "16777217", "0.33333333333333331483",
+    "000123.4500", "1.00000000000000000001" };
+  std::vector<std::string> realTokens(special, special + 23);
+
+  vtkMath::RandomSeed(2468);
+  char buffer[64];
+  const char* formats[] = { "%.17g", "%.9g", "%g", "%.3f", "%.12e" };
+  for (int i = 0; i < 20000; i++)
+    {
+    double x = vtkMath::Random(-1.0, 1.0) *
+      pow(10.0, static_cast<int>(vtkMath::Random(-30.0, 30.0)));
+    sprintf(buffer, formats[i % 5], x);
+    realTokens.push_back(buffer);
+    }
+  // a multiple of 3 tokens for the points
+  realTokens.resize(realTokens.size() - realTokens.size() % 3);
+  vtkIdType numPts = static_cast<vtkIdType>(realTokens.size() / 3);
+
+  std::vector<std::string> intTokens;
+  const char* specialInts[] = {
+    "0", "-0", "+7", "-2147483648", "2147483647", "000042" };
+  intTokens.assign(specialInts, specialInts + 6);
+  for (int i = 0; i < 3000; i++)
+    {
+    sprintf(buffer, "%d", static_cast<int>(vtkMath::Random(-1e9, 1e9)));
+    intTokens.push_back(buffer);
+    }
+  std::vector<std::string> shortTokens;
+  for (int i = 0; i < 3000; i++)
+    {
+    sprintf(buffer, "%d", static_cast<int>(vtkMath::Random(-32768, 32767)));
+    shortTokens.push_back(buffer);
+    }
+
+  std::string file = "# vtk DataFile Version 3.0\nparsing\nASCII\n"
+    "DATASET POLYDATA\n";
+  sprintf(buffer, "POINTS %lld double\n", static_cast<long long>(numPts));
+  file += buffer;
+  std::vector<double> points;
+  AddTokens(realTokens, file, points);
+
+  // one vertex per point
+  sprintf(buffer, "VERTICES %lld %lld\n", static_cast<long long>(numPts),
+          static_cast<long long>(2*numPts));
+  file += buffer;
+  for (vtkIdType i = 0; i < numPts; i++)
+    {
+    sprintf(buffer, "1 %lld\n", static_cast<long long>(i));
+    file += buffer;
+    }
+
+  sprintf(buffer, "POINT_DATA %lld\nSCALARS floats float 3\n"
+          "LOOKUP_TABLE default\n", static_cast<long long>(numPts));
+  file += buffer;
+  std::vector<float> floats;
+  AddTokens(realTokens, file, floats);
+
+  sprintf(buffer, "FIELD FieldData 2\nints 1 %d int\n",
+          static_cast<int>(intTokens.size()));
+  file += buffer;
+  std::vector<int> ints;
+  AddTokens(intTokens, file, ints);
+  sprintf(buffer, "shorts 1 %d short\n", static_cast<int>(shortTokens.size()));
+  file += buffer;
+  std::vector<short> shorts;
+  AddTokens(shortTokens, file, shorts);
+
+  vtkNew<vtkPolyDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(file);
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+
+  int errors = 0;
+  errors += CompareValues(
+    output->GetPoints() ? output->GetPoints()->GetData() : 0, points,
+    "points");
+  errors += CompareValues(output->GetPointData()->GetArray("floats"), floats,
+                          "floats");
+  errors += CompareValues(output->GetPointData()->GetArray("ints"), ints,
+                          "ints");
+  errors += CompareValues(output->GetPointData()->GetArray("shorts"),
+                          shorts, "shorts");
+  if (output->GetNumberOfVerts() != numPts)
+    {
+    cerr << "Vertices were not read\n";
+    errors++;
+    }
+
+  return (errors != 0);
+}
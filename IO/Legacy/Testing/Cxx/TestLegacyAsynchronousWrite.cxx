@@ -0,0 +1,166 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLegacyAsynchronousWrite.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that asynchronous writes write the input as it was when Write()
+// was called, in order, and that completion and failures are reported.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkErrorCode.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkPolyDataWriter.h"
+#include "vtkSimplePointsWriter.h"
+#include "vtkTestUtilities.h"
+
+#include <stdio.h>
+#include <fstream>
+#include <string>
+
+static void CountEvent(vtkObject*, unsigned long, void* clientData, void*)
+{
+  ++*static_cast<int*>(clientData);
+}
+
+static std::string StepFileName(const std::string& prefix, int step)
+{
+  char text[16];
+  sprintf(text, "%d.vtk", step);
+  return prefix + text;
+}
+
+int TestLegacyAsynchronousWrite(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory.\n";
+    return 1;
+    }
+  std::string prefix = tempDir;
+  prefix += "/TestLegacyAsynchronousWrite";
+  delete [] tempDir;
+
+  int errors = 0;
+  int numEndEvents = 0;
+  int numErrorEvents = 0;
+  vtkNew<vtkCallbackCommand> endCallback;
+  endCallback->SetCallback(CountEvent);
+  endCallback->SetClientData(&numEndEvents);
+  vtkNew<vtkCallbackCommand> errorCallback;
+  errorCallback->SetCallback(CountEvent);
+  errorCallback->SetClientData(&numErrorEvents);
+
+  vtkNew<vtkPolyData> polyData;
+  vtkNew<vtkPolyDataWriter> writer;
+  writer->SetInputData(polyData.GetPointer());
+  writer->SetFileTypeToBinary();
+  writer->AsynchronousOn();
+  writer->SetMaximumNumberOfPendingWrites(2);
+  writer->AddObserver(vtkCommand::EndEvent, endCallback.GetPointer());
+  writer->AddObserver(vtkCommand::ErrorEvent, errorCallback.GetPointer());
+
+  // The points are replaced as soon as each step has been handed over.
+  const int numSteps = 6;
+  const vtkIdType numPts = 100000;
+  for (int step = 0; step < numSteps; step++)
+    {
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(numPts);
+    for (vtkIdType i = 0; i < numPts; i++)
+      {
+      points->SetPoint(i, i, step, 0.5*step);
+      }
+    polyData->SetPoints(points.GetPointer());
+    writer->SetFileName(StepFileName(prefix, step).c_str());
+    writer->Write();
+    if (writer->GetNumberOfPendingWrites() > 2)
+      {
+      cerr << "Too many pending writes\n";
+      errors++;
+      }
+    }
+
+  // The executive ends each update too.
+  if (!writer->WaitForPendingWrites() ||
+      writer->GetNumberOfPendingWrites() != 0 ||
+      numEndEvents != 2*numSteps || numErrorEvents != 0)
+    {
+    cerr << "The writes did not complete: " << numEndEvents << " events for "
+         << numSteps << " writes\n";
+    errors++;
+    }
+
+  for (int step = 0; step < numSteps; step++)
+    {
+    vtkNew<vtkPolyDataReader> reader;
+    reader->SetFileName(StepFileName(prefix, step).c_str());
+    reader->Update();
+    vtkPoints* points = reader->GetOutput()->GetPoints();
+    double x[3];
+    if (!points || points->GetNumberOfPoints() != numPts ||
+        (points->GetPoint(numPts - 1, x), x[0] != numPts - 1) ||
+        x[1] != step || x[2] != 0.5*step)
+      {
+      cerr << "Step " << step << " was not written correctly\n";
+      errors++;
+      }
+    }
+
+  // A write that fails is reported on the calling thread.
+  writer->SetFileName((prefix + "/missing/directory.vtk").c_str());
+  writer->Write();
+  if (writer->WaitForPendingWrites() ||
+      writer->GetErrorCode() == vtkErrorCode::NoError ||
+      numErrorEvents != 1)
+    {
+    cerr << "The failed write was not reported\n";
+    errors++;
+    }
+
+  // The settings of subclasses are written asynchronously too.
+  vtkNew<vtkPoints> point;
+  point->InsertNextPoint(1.23456, 0.0, 0.0);
+  polyData->SetPoints(point.GetPointer());
+  vtkNew<vtkSimplePointsWriter> pointsWriter;
+  pointsWriter->SetInputData(polyData.GetPointer());
+  pointsWriter->SetDecimalPrecision(3);
+  pointsWriter->AsynchronousOn();
+  pointsWriter->SetFileName((prefix + "Points.xyz").c_str());
+  pointsWriter->Write();
+  pointsWriter->WaitForPendingWrites();
+  std::ifstream pointsFile((prefix + "Points.xyz").c_str());
+  std::string line;
+  std::getline(pointsFile, line);
+  if (line != "1.23 0 0")
+    {
+    cerr << "The decimal precision was not used: " << line << "\n";
+    errors++;
+    }
+
+  // Writers to a string write synchronously.
+  writer->WriteToOutputStringOn();
+  writer->Write();
+  if (writer->GetNumberOfPendingWrites() != 0 ||
+      writer->GetOutputStringLength() == 0)
+    {
+    cerr << "Writing to a string was not synchronous\n";
+    errors++;
+    }
+
+  return (errors != 0);
+}
@@ -34,6 +34,7 @@
 #include "vtkPointSet.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkShortArray.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
@@ -52,8 +53,14 @@
 #include "vtkTypeUInt64Array.h"
 #endif
 
+#include <algorithm>
 #include <ctype.h>
+#include <limits>
+#include <locale.h>
+#include <locale>
+#include <string>
 #include <sys/stat.h>
+#include <vector>
 
 // I need a safe way to read a line of arbitrary length.  It exists on
 // some platforms but not others so I'm afraid I have to write it
@@ -232,156 +239,453 @@ int vtkDataReader::ReadString(char result[256])
   return 1;
 }
 
-// Internal function to read in an integer value.
-// Returns zero if there was an error.
-int vtkDataReader::Read(char *result)
+//----------------------------------------------------------------------------
+// The numbers of ASCII files are parsed without the locale machinery of
+// operator>>.  Tokens are copied directly from the stream buffer and
+// checked against the grammar accepted by operator>> for the type.
+// Decimal numbers short enough to be converted exactly with a single
+// floating point operation take a fast path, others are converted with
+// strtod() or strtof() as the C++ library does, so that the values are
+// identical to those read by operator>>.
+
+// The white space skipped by operator>> in the classic locale.
+static inline bool vtkDataReaderIsSpace(int c)
 {
-  int intData;
-  *this->IS >> intData;
-  if (this->IS->fail())
+  return (c == ' ' || (c >= '\t' && c <= '\r'));
+}
+
+// Skip white space and append the next token of the stream and a
+// terminating null to the container.  Returns false if there are no
+// more tokens, setting the state of the stream as operator>> does.
+template <class C>
+static bool vtkDataReaderNextToken(istream* IS, C& token)
+{
+  typedef std::char_traits<char> traits;
+  if (!IS->good())
     {
-    return 0;
+    IS->setstate(ios::failbit);
+    return false;
+    }
+  std::streambuf* sb = IS->rdbuf();
+  int c = sb->sgetc();
+  while (c != traits::eof() && vtkDataReaderIsSpace(c))
+    {
+    c = sb->snextc();
+    }
+  if (c == traits::eof())
+    {
+    IS->setstate(ios::eofbit | ios::failbit);
+    return false;
     }
+  do
+    {
+    token.push_back(static_cast<char>(c));
+    c = sb->snextc();
+    }
+  while (c != traits::eof() && !vtkDataReaderIsSpace(c));
+  if (c == traits::eof())
+    {
+    IS->setstate(ios::eofbit);
+    }
+  token.push_back('\0');
+  return true;
+}
 
-  *result = (char) intData;
-  return 1;
+// Parse an integer token.  As for operator>>, values out of range are
+// errors and negative values of unsigned types wrap around.
+template <class T>
+static bool vtkDataReaderParseValue(const char* s, T* value)
+{
+  bool negative = (*s == '-');
+  if (*s == '-' || *s == '+')
+    {
+    ++s;
+    }
+  if (*s < '0' || *s > '9')
+    {
+    return false;
+    }
+  vtkTypeUInt64 limit =
+    static_cast<vtkTypeUInt64>(std::numeric_limits<T>::max());
+  if (negative && std::numeric_limits<T>::is_signed)
+    {
+    ++limit;
+    }
+  vtkTypeUInt64 m = 0;
+  for (; *s >= '0' && *s <= '9'; ++s)
+    {
+    unsigned int d = static_cast<unsigned int>(*s - '0');
+    if (m > (limit - d) / 10)
+      {
+      return false;
+      }
+    m = 10*m + d;
+    }
+  if (*s != '\0')
+    {
+    return false;
+    }
+  if (!negative)
+    {
+    *value = static_cast<T>(m);
+    }
+  else if (std::numeric_limits<T>::is_signed)
+    {
+    *value = static_cast<T>(-static_cast<vtkTypeInt64>(m - 1) - 1);
+    }
+  else
+    {
+    *value = static_cast<T>(static_cast<T>(0) - static_cast<T>(m));
+    }
+  return true;
 }
 
-int vtkDataReader::Read(unsigned char *result)
+// Characters are read as integers.
+static bool vtkDataReaderParseValue(const char* s, char* value)
 {
-  int intData;
-  *this->IS >> intData;
-  if (this->IS->fail())
+  int i;
+  if (!vtkDataReaderParseValue(s, &i))
     {
-    return 0;
+    return false;
     }
+  *value = static_cast<char>(i);
+  return true;
+}
 
-  *result = (unsigned char) intData;
-  return 1;
+static bool vtkDataReaderParseValue(const char* s, unsigned char* value)
+{
+  int i;
+  if (!vtkDataReaderParseValue(s, &i))
+    {
+    return false;
+    }
+  *value = static_cast<unsigned char>(i);
+  return true;
 }
 
-int vtkDataReader::Read(short *result)
+// Check that a token is a decimal number and split it into its sign,
+// its significant digits and a power of ten.  Returns 0 if the token is
+// not a number, 1 if the digits fit the mantissa, and 2 if there are too
+// many digits to convert the number exactly.
+static int vtkDataReaderParseDecimal(const char* s, bool& negative,
+                                     vtkTypeUInt64& mantissa, int& exponent)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  negative = (*s == '-');
+  if (*s == '-' || *s == '+')
+    {
+    ++s;
+    }
+  mantissa = 0;
+  exponent = 0;
+  int digits = 0;
+  bool hasDigits = false;
+  for (; *s >= '0' && *s <= '9'; ++s, hasDigits = true)
+    {
+    if (digits < 19)
+      {
+      mantissa = 10*mantissa + (*s - '0');
+      digits += (mantissa != 0);
+      }
+    else
+      {
+      // Further digits only matter to the fallback conversion.
+      ++exponent;
+      digits += (*s != '0') ? 20 : 0;
+      }
+    }
+  if (*s == '.')
+    {
+    for (++s; *s >= '0' && *s <= '9'; ++s, hasDigits = true)
+      {
+      if (digits < 19)
+        {
+        mantissa = 10*mantissa + (*s - '0');
+        digits += (mantissa != 0);
+        --exponent;
+        }
+      else
+        {
+        digits += (*s != '0') ? 20 : 0;
+        }
+      }
+    }
+  if (!hasDigits)
     {
     return 0;
     }
-  return 1;
+  if (*s == 'e' || *s == 'E')
+    {
+    ++s;
+    bool negativeExponent = (*s == '-');
+    if (*s == '-' || *s == '+')
+      {
+      ++s;
+      }
+    if (*s < '0' || *s > '9')
+      {
+      return 0;
+      }
+    int e = 0;
+    for (; *s >= '0' && *s <= '9'; ++s)
+      {
+      if (e < 100000)
+        {
+        e = 10*e + (*s - '0');
+        }
+      }
+    exponent += (negativeExponent ? -e : e);
+    }
+  if (*s != '\0')
+    {
+    return 0;
+    }
+  return (digits <= 19) ? 1 : 2;
 }
 
-int vtkDataReader::Read(unsigned short *result)
+// The powers of ten that are exactly representable as doubles.
+static const double vtkDataReaderPowersOfTen[23] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+// Whether strtod() can be used on numbers with a '.' decimal point.
+static bool vtkDataReaderUseStrtod()
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  const char* point = localeconv()->decimal_point;
+  return (point[0] == '.' && point[1] == '\0');
+}
+
+// Convert a decimal token with the C++ library, for numbers that cannot
+// be converted exactly by the fast path.  Overflow is an error.
+template <class T>
+static bool vtkDataReaderConvertDecimal(const char* s, T* value)
+{
+#if !defined(_MSC_VER) || _MSC_VER >= 1800
+  if (vtkDataReaderUseStrtod())
     {
-    return 0;
+    char* end;
+    *value = (sizeof(T) == sizeof(float)) ?
+      static_cast<T>(strtof(s, &end)) : static_cast<T>(strtod(s, &end));
+    return (*end == '\0' && *value <= std::numeric_limits<T>::max() &&
+            *value >= -std::numeric_limits<T>::max());
     }
-  return 1;
+#endif
+  vtksys_ios::istringstream is(s);
+  is.imbue(std::locale::classic());
+  is >> *value;
+  return !is.fail();
 }
 
-int vtkDataReader::Read(int *result)
+static bool vtkDataReaderParseValue(const char* s, double* value)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  bool negative;
+  vtkTypeUInt64 mantissa;
+  int exponent;
+  int result = vtkDataReaderParseDecimal(s, negative, mantissa, exponent);
+  if (result == 0)
     {
-    return 0;
+    return false;
     }
-  return 1;
+  // Both the mantissa and the power of ten are exact, so the result of
+  // a single operation is correctly rounded.
+  if (result == 1 && mantissa <= (static_cast<vtkTypeUInt64>(1) << 53) &&
+      exponent >= -22 && exponent <= 22)
+    {
+    double d = static_cast<double>(mantissa);
+    d = (exponent >= 0) ? d*vtkDataReaderPowersOfTen[exponent] :
+                          d/vtkDataReaderPowersOfTen[-exponent];
+    *value = negative ? -d : d;
+    return true;
+    }
+  return vtkDataReaderConvertDecimal(s, value);
 }
 
-int vtkDataReader::Read(unsigned int *result)
+static bool vtkDataReaderParseValue(const char* s, float* value)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  bool negative;
+  vtkTypeUInt64 mantissa;
+  int exponent;
+  int result = vtkDataReaderParseDecimal(s, negative, mantissa, exponent);
+  if (result == 0)
     {
-    return 0;
+    return false;
     }
-  return 1;
+  // The mantissa and the power of ten are exact floats.  The operation
+  // is done in double precision, which is wide enough for rounding the
+  // result to float to be correct.
+  if (result == 1 && mantissa <= (static_cast<vtkTypeUInt64>(1) << 24) &&
+      exponent >= -10 && exponent <= 10)
+    {
+    double d = static_cast<double>(mantissa);
+    d = (exponent >= 0) ? d*vtkDataReaderPowersOfTen[exponent] :
+                          d/vtkDataReaderPowersOfTen[-exponent];
+    *value = static_cast<float>(negative ? -d : d);
+    return true;
+    }
+  return vtkDataReaderConvertDecimal(s, value);
 }
 
-int vtkDataReader::Read(long *result)
+// Read a single value.
+template <class T>
+static int vtkDataReaderReadValue(istream* IS, T* value)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  std::string token;
+  if (!vtkDataReaderNextToken(IS, token))
     {
     return 0;
     }
+  if (!vtkDataReaderParseValue(token.c_str(), value))
+    {
+    IS->setstate(ios::failbit);
+    return 0;
+    }
   return 1;
 }
 
-int vtkDataReader::Read(unsigned long *result)
+// Converts the tokens of a block of values.
+template <class T>
+class vtkDataReaderParseFunctor
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+public:
+  const char* Text;
+  const size_t* Starts;
+  T* Data;
+  unsigned char* Valid;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Valid[i] = vtkDataReaderParseValue(this->Text + this->Starts[i],
+                                               this->Data + i);
+      }
+  }
+};
+
+// Read a block of values.  The tokens of up to a batch of values are
+// collected from the stream, and then converted in parallel.  Returns
+// the number of values read.
+template <class T>
+static vtkIdType vtkDataReaderReadValues(istream* IS, T* data, vtkIdType n)
+{
+  const vtkIdType batchSize = 65536;
+  std::vector<char> text;
+  std::vector<size_t> starts;
+  std::vector<unsigned char> valid;
+  vtkIdType numRead = 0;
+  while (numRead < n)
     {
-    return 0;
+    vtkIdType count = std::min(batchSize, n - numRead);
+    text.clear();
+    starts.clear();
+    for (vtkIdType i = 0; i < count; ++i)
+      {
+      starts.push_back(text.size());
+      if (!vtkDataReaderNextToken(IS, text))
+        {
+        count = i;
+        break;
+        }
+      }
+
+    valid.resize(count);
+    vtkDataReaderParseFunctor<T> functor;
+    functor.Text = count ? &text[0] : 0;
+    functor.Starts = count ? &starts[0] : 0;
+    functor.Data = data + numRead;
+    functor.Valid = count ? &valid[0] : 0;
+    vtkSMPTools::For(0, count, 4096, functor);
+
+    for (vtkIdType i = 0; i < count; ++i)
+      {
+      if (!valid[i])
+        {
+        IS->setstate(ios::failbit);
+        return numRead + i;
+        }
+      }
+    numRead += count;
+    if (count < batchSize && numRead < n)
+      {
+      break;
+      }
     }
-  return 1;
+  return numRead;
+}
+
+// Internal function to read in an integer value.
+// Returns zero if there was an error.
+int vtkDataReader::Read(char *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(unsigned char *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(short *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(unsigned short *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(int *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(unsigned int *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(long *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(unsigned long *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 #if defined(VTK_TYPE_USE___INT64)
 int vtkDataReader::Read(__int64 *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned __int64 *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 #endif
 
 #if defined(VTK_TYPE_USE_LONG_LONG)
 int vtkDataReader::Read(long long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned long long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 #endif
 
 int vtkDataReader::Read(float *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(double *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 
@@ -1347,19 +1651,12 @@ int vtkReadBinaryData(istream *IS, T *data, int numTuples, int numComp)
 template <class T>
 int vtkReadASCIIData(vtkDataReader *self, T *data, int numTuples, int numComp)
 {
-  int i, j;
-
-  for (i=0; i<numTuples; i++)
+  vtkIdType n = static_cast<vtkIdType>(numTuples)*numComp;
+  if (vtkDataReaderReadValues(self->GetIStream(), data, n) != n)
     {
-    for (j=0; j<numComp; j++)
-      {
-      if ( !self->Read(data++) )
-        {
-        vtkGenericWarningMacro(<<"Error reading ascii data. Possible mismatch of "
-          "datasize with declaration.");
-        return 0;
-        }
-      }
+    vtkGenericWarningMacro(<<"Error reading ascii data. Possible mismatch of "
+      "datasize with declaration.");
+    return 0;
     }
   return 1;
 }
@@ -2605,7 +2902,6 @@ int vtkDataReader::ReadLutData(vtkDataSetAttributes *a)
 int vtkDataReader::ReadCells(int size, int *data)
 {
   char line[256];
-  int i;
 
   if ( this->FileType == VTK_BINARY)
     {
@@ -2622,14 +2918,11 @@ int vtkDataReader::ReadCells(int size, int *data)
     }
   else // ascii
     {
-    for (i=0; i<size; i++)
+    if (vtkDataReaderReadValues(this->IS, data, size) != size)
       {
-      if (!this->Read(data+i))
-        {
-        vtkErrorMacro(<<"Error reading ascii cell data!" << " for file: "
-                      << (this->FileName?this->FileName:"(Null FileName)"));
-        return 0;
-        }
+      vtkErrorMacro(<<"Error reading ascii cell data!" << " for file: "
+                    << (this->FileName?this->FileName:"(Null FileName)"));
+      return 0;
       }
     }
 
@@ -1925,6 +1925,32 @@ void vtkDataWriter::WriteData()
   vtkErrorMacro(<<"WriteData() should be implemented in concrete subclass");
 }
 
+int vtkDataWriter::CopyWriterSettings(vtkWriter *writer)
+{
+  // Subclasses with settings of their own extend this method, so only
+  // the instances of the same class can be copied.
+  vtkDataWriter *copy = vtkDataWriter::SafeDownCast(writer);
+  if (!copy || this->WriteToOutputString ||
+      strcmp(copy->GetClassName(), this->GetClassName()) != 0)
+    {
+    return 0;
+    }
+  copy->SetFileName(this->FileName);
+  copy->SetHeader(this->Header);
+  copy->SetFileType(this->FileType);
+  copy->SetScalarsName(this->ScalarsName);
+  copy->SetVectorsName(this->VectorsName);
+  copy->SetTensorsName(this->TensorsName);
+  copy->SetNormalsName(this->NormalsName);
+  copy->SetTCoordsName(this->TCoordsName);
+  copy->SetGlobalIdsName(this->GlobalIdsName);
+  copy->SetPedigreeIdsName(this->PedigreeIdsName);
+  copy->SetEdgeFlagsName(this->EdgeFlagsName);
+  copy->SetLookupTableName(this->LookupTableName);
+  copy->SetFieldDataName(this->FieldDataName);
+  return 1;
+}
+
 // Close a vtk file.
 void vtkDataWriter::CloseVTKFile(ostream *fp)
 {
@@ -222,6 +222,13 @@ protected:
 
   void WriteData(); //dummy method to allow this class to be instantiated and delegated to
 
+  // Description:
+  // Copy the file name, file type, header and array names to an instance
+  // of the same class.  Writers to an output string cannot be copied.
+  // Subclasses that add settings must extend this method, chaining to
+  // their superclass.
+  virtual int CopyWriterSettings(vtkWriter *writer);
+
   char *FileName;
   char *Header;
   int FileType;
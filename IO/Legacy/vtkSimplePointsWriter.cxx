@@ -34,6 +34,17 @@ vtkSimplePointsWriter::vtkSimplePointsWriter()
   this->DecimalPrecision = fout.precision();
 }
 
+int vtkSimplePointsWriter::CopyWriterSettings(vtkWriter *writer)
+{
+  if (!this->Superclass::CopyWriterSettings(writer))
+    {
+    return 0;
+    }
+  vtkSimplePointsWriter *copy = static_cast<vtkSimplePointsWriter *>(writer);
+  copy->SetDecimalPrecision(this->DecimalPrecision);
+  return 1;
+}
+
 void vtkSimplePointsWriter::WriteData()
 {
   vtkPointSet *input = vtkPointSet::SafeDownCast(this->GetInput());
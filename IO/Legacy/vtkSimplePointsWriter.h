@@ -41,6 +41,10 @@ protected:
 
   void WriteData();
 
+  // Description:
+  // Copy the decimal precision along with the settings of the superclass.
+  virtual int CopyWriterSettings(vtkWriter *writer);
+
   int DecimalPrecision;
 
 private:
@@ -0,0 +1,242 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMPIXMLUnstructuredGrid.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the pieces written by all processes into shared files with
+// vtkMPIXMLUnstructuredGridWriter are read back by
+// vtkMPIXMLUnstructuredGridReader on the processes that wrote them, and by
+// the serial readers as a whole.
+
+#include "vtkCell.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkMPIXMLUnstructuredGridReader.h"
+#include "vtkMPIXMLUnstructuredGridWriter.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLPUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridReader.h"
+
+#include <string>
+
+// The piece of each process is a polyline of a different length.
+static vtkIdType NumberOfPoints(int rank)
+{
+  return 10 + 7*rank;
+}
+
+static void CreatePiece(int rank, vtkUnstructuredGrid* grid)
+{
+  vtkIdType numberOfPoints = NumberOfPoints(rank);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Id");
+  vtkNew<vtkIntArray> ranks;
+  ranks->SetName("Rank");
+  grid->Allocate(numberOfPoints-1);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+    points->InsertNextPoint(i, rank, 0.);
+    ids->InsertNextValue(static_cast<int>(1000*rank + i));
+    if (i > 0)
+      {
+      vtkIdType line[2] = { i-1, i };
+      grid->InsertNextCell(VTK_LINE, 2, line);
+      ranks->InsertNextValue(rank);
+      }
+    }
+  grid->SetPoints(points.GetPointer());
+  grid->GetPointData()->AddArray(ids.GetPointer());
+  grid->GetCellData()->AddArray(ranks.GetPointer());
+
+  vtkNew<vtkDoubleArray> time;
+  time->SetName("Time");
+  time->InsertNextValue(1.5);
+  grid->GetFieldData()->AddArray(time.GetPointer());
+}
+
+static bool CheckPiece(int rank, vtkUnstructuredGrid* grid, const char* what)
+{
+  vtkIdType numberOfPoints = NumberOfPoints(rank);
+  vtkIntArray* ids = vtkIntArray::SafeDownCast(
+    grid->GetPointData()->GetArray("Id"));
+  vtkIntArray* ranks = vtkIntArray::SafeDownCast(
+    grid->GetCellData()->GetArray("Rank"));
+  vtkDoubleArray* time = vtkDoubleArray::SafeDownCast(
+    grid->GetFieldData()->GetArray("Time"));
+  if (grid->GetNumberOfPoints() != numberOfPoints ||
+      grid->GetNumberOfCells() != numberOfPoints-1 || !ids || !ranks ||
+      !time || time->GetValue(0) != 1.5)
+    {
+    cerr << "Process " << rank << " read a wrong piece from " << what
+         << ": " << grid->GetNumberOfPoints() << " points, "
+         << grid->GetNumberOfCells() << " cells.\n";
+    return false;
+    }
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+    double* x = grid->GetPoint(i);
+    if (ids->GetValue(i) != 1000*rank + i || x[0] != i || x[1] != rank)
+      {
+      cerr << "Process " << rank << " read a wrong point " << i << " from "
+           << what << ".\n";
+      return false;
+      }
+    }
+  for (vtkIdType i = 0; i < numberOfPoints-1; ++i)
+    {
+    if (ranks->GetValue(i) != rank || grid->GetCell(i)->GetPointId(1) != i+1)
+      {
+      cerr << "Process " << rank << " read a wrong cell " << i << " from "
+           << what << ".\n";
+      return false;
+      }
+    }
+  return true;
+}
+
+static void UpdatePiece(vtkAlgorithm* reader, int piece, int numberOfPieces)
+{
+  reader->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+    reader->GetOutputInformation(0), piece, numberOfPieces, 0);
+  reader->Update();
+}
+
+static bool CheckWhole(int numberOfProcesses, vtkUnstructuredGrid* grid,
+                       const char* what)
+{
+  vtkIdType numberOfPoints = 0;
+  for (int rank = 0; rank < numberOfProcesses; ++rank)
+    {
+    numberOfPoints += NumberOfPoints(rank);
+    }
+  vtkIntArray* ids = vtkIntArray::SafeDownCast(
+    grid->GetPointData()->GetArray("Id"));
+  if (grid->GetNumberOfPoints() != numberOfPoints ||
+      grid->GetNumberOfCells() != numberOfPoints-numberOfProcesses || !ids ||
+      ids->GetValue(numberOfPoints-1) !=
+        1000*(numberOfProcesses-1) + NumberOfPoints(numberOfProcesses-1)-1)
+    {
+    cerr << "Wrong data read from " << what << ": "
+         << grid->GetNumberOfPoints() << " points, "
+         << grid->GetNumberOfCells() << " cells.\n";
+    return false;
+    }
+  return true;
+}
+
+int TestMPIXMLUnstructuredGrid(int argc, char* argv[])
+{
+  vtkMPIController* controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv, 0);
+  controller->SetGlobalController(controller);
+  int numberOfProcesses = controller->GetNumberOfProcesses();
+  int rank = controller->GetLocalProcessId();
+
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string prefix = std::string(tempDir) + "/TestMPIXMLUnstructuredGrid";
+  delete [] tempDir;
+
+  vtkNew<vtkUnstructuredGrid> piece;
+  CreatePiece(rank, piece.GetPointer());
+  bool ok = true;
+
+  // Write all pieces into a single file with the default settings, which
+  // compress and encode the appended data.
+  std::string single = prefix + ".vtu";
+  vtkNew<vtkMPIXMLUnstructuredGridWriter> writer;
+  writer->SetInputData(piece.GetPointer());
+  writer->SetNumberOfPieces(numberOfProcesses);
+  writer->SetStartPiece(rank);
+  writer->SetEndPiece(rank);
+  writer->SetFileName(single.c_str());
+  if (!writer->Write())
+    {
+    cerr << "Process " << rank << " could not write " << single << ".\n";
+    ok = false;
+    }
+
+  vtkNew<vtkMPIXMLUnstructuredGridReader> reader;
+  reader->SetFileName(single.c_str());
+  UpdatePiece(reader.GetPointer(), rank, numberOfProcesses);
+  ok = CheckPiece(rank, reader->GetOutput(), single.c_str()) && ok;
+
+  // Write raw appended data into two files, with a summary file, when
+  // there are enough processes.
+  if (numberOfProcesses > 1)
+    {
+    std::string summary = prefix + "_Files.pvtu";
+    writer->SetFileName(summary.c_str());
+    writer->SetNumberOfFiles(2);
+    writer->SetCompressorTypeToNone();
+    writer->SetEncodeAppendedData(0);
+    if (!writer->Write())
+      {
+      cerr << "Process " << rank << " could not write " << summary << ".\n";
+      ok = false;
+      }
+    controller->Barrier();
+
+    if (rank == 0)
+      {
+      vtkNew<vtkXMLPUnstructuredGridReader> summaryReader;
+      summaryReader->SetFileName(summary.c_str());
+      summaryReader->Update();
+      ok = CheckWhole(numberOfProcesses, summaryReader->GetOutput(),
+                      summary.c_str()) && ok;
+      }
+
+    // Each process reads its piece from the file its group wrote.
+    int group = (rank * 2) / numberOfProcesses;
+    int firstRank = (group * numberOfProcesses + 1) / 2;
+    std::string groupFile =
+      prefix + (group == 0 ? "_Files_0.vtu" : "_Files_1.vtu");
+    vtkMultiProcessController* groupController =
+      controller->PartitionController(group, rank);
+    vtkNew<vtkMPIXMLUnstructuredGridReader> groupReader;
+    groupReader->SetController(groupController);
+    groupReader->SetFileName(groupFile.c_str());
+    UpdatePiece(groupReader.GetPointer(), rank - firstRank,
+                groupController->GetNumberOfProcesses());
+    ok = CheckPiece(rank, groupReader->GetOutput(), groupFile.c_str()) && ok;
+    groupController->Delete();
+    }
+
+  // Read the whole single file back with the serial reader.
+  controller->Barrier();
+  if (rank == 0)
+    {
+    vtkNew<vtkXMLUnstructuredGridReader> serialReader;
+    serialReader->SetFileName(single.c_str());
+    serialReader->Update();
+    ok = CheckWhole(numberOfProcesses, serialReader->GetOutput(),
+                    single.c_str()) && ok;
+    }
+
+  int localResult = ok ? 1 : 0;
+  int result = 0;
+  controller->AllReduce(&localResult, &result, 1, vtkCommunicator::MIN_OP);
+  controller->Finalize();
+  controller->Delete();
+  return result ? 0 : 1;
+}
@@ -5,6 +5,8 @@ vtk_module(vtkIOMPIParallel
     MPI
   DEPENDS
     vtkIOGeometry
+    vtkIOParallelXML
+    vtkIOXML
     vtkParallelMPI
   PRIVATE_DEPENDS
     vtksys
@@ -0,0 +1,539 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMPIXMLUnstructuredGridReader.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMPIXMLUnstructuredGridReader.h"
+
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+
+// Include the MPI headers and then determine if MPIIO is available.
+#include "vtkMPI.h"
+
+#ifdef MPI_VERSION
+#  if (MPI_VERSION >= 2)
+#    define VTK_USE_MPI_IO 1
+#  endif
+#endif
+#if !defined(VTK_USE_MPI_IO) && defined(ROMIO_VERSION)
+#  define VTK_USE_MPI_IO 1
+#endif
+#if !defined(VTK_USE_MPI_IO) && defined(MPI_SEEK_SET)
+#  define VTK_USE_MPI_IO 1
+#endif
+
+// If VTK_USE_MPI_IO is set, that means we will read the file ourself using
+// MPIIO.  Otherwise, just delegate everything to the superclass.
+
+#ifdef VTK_USE_MPI_IO
+
+#include "vtkInformation.h"
+#include "vtkMPICommunicator.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkXMLDataElement.h"
+#include "vtkXMLDataParser.h"
+
+#include <algorithm>
+#include <istream>
+#include <map>
+#include <streambuf>
+#include <vector>
+
+// This macro can be wrapped around MPI function calls to report errors.
+// Unlike network I/O, file I/O errors usually do not terminate the program,
+// so the failure is also recorded in the local variable "result".
+#define MPICall(funcall) \
+  { \
+  int __my_result = funcall; \
+  if (__my_result != MPI_SUCCESS) \
+    { \
+    char errormsg[MPI_MAX_ERROR_STRING]; \
+    int dummy; \
+    MPI_Error_string(__my_result, errormsg, &dummy); \
+    vtkErrorMacro(<< "Received error when calling" << endl \
+                  << #funcall << endl << endl \
+                  << errormsg); \
+    result = 0; \
+    } \
+  }
+
+//----------------------------------------------------------------------------
+// A read-only stream buffer over the parts of a file that were read, each
+// at its position in the file. Reading outside of them gives end-of-file.
+class vtkMPIXMLSegmentBuffer : public std::streambuf
+{
+public:
+  vtkMPIXMLSegmentBuffer() : Position(0) {}
+
+  // Forget all parts of the file.
+  void Clear()
+    {
+    this->Segments.clear();
+    this->setg(0, 0, 0);
+    this->Position = 0;
+    }
+
+  // Return the storage of the part of the file at the given position.
+  std::vector<char>& GetSegment(vtkTypeInt64 position)
+    {
+    return this->Segments[position];
+    }
+
+protected:
+  typedef std::map<vtkTypeInt64, std::vector<char> > SegmentsType;
+
+  // The file position of the next character.
+  vtkTypeInt64 Tell() const
+    {
+    return this->Position + (this->gptr() - this->eback());
+    }
+
+  // Use the part of the file holding the given position as get area.
+  bool Seek(vtkTypeInt64 position)
+    {
+    SegmentsType::iterator i = this->Segments.upper_bound(position);
+    if (i != this->Segments.begin())
+      {
+      --i;
+      vtkTypeInt64 size = static_cast<vtkTypeInt64>(i->second.size());
+      if (position < i->first + size)
+        {
+        char* begin = &i->second[0];
+        this->setg(begin, begin + (position - i->first), begin + size);
+        this->Position = i->first;
+        return true;
+        }
+      }
+    this->setg(0, 0, 0);
+    this->Position = position;
+    return false;
+    }
+
+  virtual int_type underflow()
+    {
+    if (this->gptr() < this->egptr() || this->Seek(this->Tell()))
+      {
+      return traits_type::to_int_type(*this->gptr());
+      }
+    return traits_type::eof();
+    }
+
+  virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                           std::ios_base::openmode which)
+    {
+    vtkTypeInt64 position = off;
+    if (dir == std::ios_base::cur)
+      {
+      position += this->Tell();
+      }
+    else if (dir == std::ios_base::end)
+      {
+      SegmentsType::reverse_iterator last = this->Segments.rbegin();
+      if (last != this->Segments.rend())
+        {
+        position += last->first + static_cast<vtkTypeInt64>(last->second.size());
+        }
+      }
+    if (!(which & std::ios_base::in) || position < 0)
+      {
+      return pos_type(off_type(-1));
+      }
+    this->Seek(position);
+    return pos_type(off_type(position));
+    }
+
+  virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which)
+    {
+    return this->seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+  SegmentsType Segments;
+  vtkTypeInt64 Position;
+};
+
+//----------------------------------------------------------------------------
+class vtkMPIXMLUnstructuredGridReader::vtkInternals
+{
+public:
+  vtkInternals() : Comm(MPI_COMM_NULL), FileSize(0), Stream(&this->Buffer) {}
+
+  vtkMPIOpaqueFileHandle File;
+  MPI_Comm Comm;
+  vtkTypeInt64 FileSize;
+  vtkMPIXMLSegmentBuffer Buffer;
+  std::istream Stream;
+};
+
+//----------------------------------------------------------------------------
+// Read the beginning of the file, up to the first character of the appended
+// data, or the whole file if it has none.
+static int vtkMPIXMLReadHeader(MPI_File file, vtkTypeInt64 fileSize,
+                               std::vector<char>& header)
+{
+  const vtkTypeInt64 blockSize = 65536;
+  const char tag[] = "<AppendedData";
+  const char* tagEnd = tag + sizeof(tag)-1;
+  size_t searchStart = 0;
+  size_t tagPosition = 0;
+  bool tagFound = false;
+  header.clear();
+  while (static_cast<vtkTypeInt64>(header.size()) < fileSize)
+    {
+    size_t start = header.size();
+    int count = static_cast<int>(
+      std::min(blockSize, fileSize - static_cast<vtkTypeInt64>(start)));
+    header.resize(start + count);
+    MPI_Status status;
+    int error = MPI_File_read_at(file, start, &header[start], count,
+                                 MPI_BYTE, &status);
+    if (error != MPI_SUCCESS)
+      {
+      return error;
+      }
+
+    if (!tagFound)
+      {
+      std::vector<char>::iterator i =
+        std::search(header.begin() + searchStart, header.end(), tag, tagEnd);
+      tagFound = (i != header.end());
+      tagPosition = i - header.begin();
+      searchStart = header.size() - std::min(header.size(), sizeof(tag)-2);
+      }
+    if (tagFound)
+      {
+      // Skip the rest of the tag and the white space after it.
+      std::vector<char>::iterator i =
+        std::find(header.begin() + tagPosition, header.end(), '>');
+      while (i != header.end() &&
+             (*i == '>' || *i == ' ' || *i == '\t' || *i == '\n' ||
+              *i == '\r'))
+        {
+        ++i;
+        }
+      if (i != header.end())
+        {
+        header.erase(i + 1, header.end());
+        break;
+        }
+      }
+    }
+  return MPI_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+// Read the given number of bytes at the given offset of a file opened by all
+// the processes of comm, in chunks whose size fits the int count of MPI.
+// All processes make the same number of collective calls, even after one of
+// them failed: the remaining calls then read nothing. Returns the first
+// error.
+static int vtkMPIXMLReadAtAll(MPI_File file, MPI_Comm comm,
+                              MPI_Offset offset, char* buffer,
+                              vtkTypeInt64 size)
+{
+  const long long chunkSize = 1 << 30;
+  long long numberOfChunks = (size + chunkSize - 1) / chunkSize;
+  long long maxNumberOfChunks = 0;
+  int error = MPI_Allreduce(&numberOfChunks, &maxNumberOfChunks, 1,
+                            MPI_LONG_LONG, MPI_MAX, comm);
+  if (error != MPI_SUCCESS)
+    {
+    return error;
+    }
+  for (long long i = 0; i < maxNumberOfChunks; ++i)
+    {
+    long long start = std::min(i*chunkSize, static_cast<long long>(size));
+    int count = static_cast<int>(std::min(chunkSize, size - start));
+    if (error != MPI_SUCCESS)
+      {
+      count = 0;
+      }
+    MPI_Status status;
+    int chunkError = MPI_File_read_at_all(file, offset + start,
+                                          buffer + start, count, MPI_BYTE,
+                                          &status);
+    if (error == MPI_SUCCESS)
+      {
+      error = chunkError;
+      }
+    }
+  return error;
+}
+
+//----------------------------------------------------------------------------
+// Append the offsets of the appended arrays of the given element and its
+// nested elements.
+static void vtkMPIXMLCollectOffsets(vtkXMLDataElement* element,
+                                    std::vector<vtkTypeInt64>& offsets)
+{
+  const char* format = element->GetAttribute("format");
+  vtkTypeInt64 offset = 0;
+  if (format && strcmp(format, "appended") == 0 &&
+      element->GetScalarAttribute("offset", offset))
+    {
+    offsets.push_back(offset);
+    }
+  for (int i = 0; i < element->GetNumberOfNestedElements(); ++i)
+    {
+    vtkMPIXMLCollectOffsets(element->GetNestedElement(i), offsets);
+    }
+}
+
+#else // VTK_USE_MPI_IO
+
+class vtkMPIXMLUnstructuredGridReader::vtkInternals
+{
+};
+
+#endif // VTK_USE_MPI_IO
+
+//=============================================================================
+vtkStandardNewMacro(vtkMPIXMLUnstructuredGridReader);
+
+vtkCxxSetObjectMacro(vtkMPIXMLUnstructuredGridReader, Controller,
+                     vtkMultiProcessController);
+
+//----------------------------------------------------------------------------
+vtkMPIXMLUnstructuredGridReader::vtkMPIXMLUnstructuredGridReader()
+{
+  this->Controller = 0;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+  this->Internals = new vtkInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkMPIXMLUnstructuredGridReader::~vtkMPIXMLUnstructuredGridReader()
+{
+  this->SetController(0);
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIXMLUnstructuredGridReader::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Controller: " << this->Controller << "\n";
+}
+
+//----------------------------------------------------------------------------
+#ifdef VTK_USE_MPI_IO
+int vtkMPIXMLUnstructuredGridReader::OpenVTKFile()
+{
+  vtkMPICommunicator* communicator = this->Controller ?
+    vtkMPICommunicator::SafeDownCast(this->Controller->GetCommunicator()) : 0;
+  if (!communicator || this->Stream || !this->FileName)
+    {
+    return this->Superclass::OpenVTKFile();
+    }
+
+  vtkInternals* internals = this->Internals;
+  if (internals->File.Handle != MPI_FILE_NULL)
+    {
+    vtkErrorMacro("File already open.");
+    return 1;
+    }
+
+  internals->Comm = *communicator->GetMPIComm()->GetHandle();
+  int error = MPI_File_open(internals->Comm, this->FileName, MPI_MODE_RDONLY,
+                            MPI_INFO_NULL, &internals->File.Handle);
+  if (error != MPI_SUCCESS)
+    {
+    vtkErrorMacro("Error opening file " << this->FileName);
+    internals->File.Handle = MPI_FILE_NULL;
+    return 0;
+    }
+  int result = 1;
+  MPI_Offset fileSize = 0;
+  MPICall(MPI_File_get_size(internals->File.Handle, &fileSize));
+  internals->FileSize = fileSize;
+
+  // Only the first process reads the XML, and sends it to the others.
+  std::vector<char> header;
+  long long headerSize = 0;
+  if (this->Controller->GetLocalProcessId() == 0)
+    {
+    MPICall(vtkMPIXMLReadHeader(internals->File.Handle, fileSize, header));
+    headerSize = result ? static_cast<long long>(header.size()) : -1;
+    }
+  MPICall(MPI_Bcast(&headerSize, 1, MPI_LONG_LONG, 0, internals->Comm));
+  if (headerSize <= 0 || headerSize > VTK_INT_MAX)
+    {
+    vtkErrorMacro("Cannot read the XML of file " << this->FileName);
+    this->CloseVTKFile();
+    return 0;
+    }
+  header.resize(headerSize);
+  MPICall(MPI_Bcast(&header[0], static_cast<int>(headerSize), MPI_BYTE, 0,
+                    internals->Comm));
+
+  // Use the XML as the beginning of the stream.
+  internals->Buffer.Clear();
+  internals->Buffer.GetSegment(0).swap(header);
+  internals->Stream.clear();
+  internals->Stream.seekg(0);
+  this->Stream = &internals->Stream;
+
+  return result;
+}
+#else // VTK_USE_MPI_IO
+int vtkMPIXMLUnstructuredGridReader::OpenVTKFile()
+{
+  return this->Superclass::OpenVTKFile();
+}
+#endif // VTK_USE_MPI_IO
+
+//----------------------------------------------------------------------------
+#ifdef VTK_USE_MPI_IO
+void vtkMPIXMLUnstructuredGridReader::CloseVTKFile()
+{
+  vtkInternals* internals = this->Internals;
+  if (internals->File.Handle == MPI_FILE_NULL)
+    {
+    this->Superclass::CloseVTKFile();
+    return;
+    }
+
+  int result = 1;
+  MPICall(MPI_File_close(&internals->File.Handle));
+  internals->File.Handle = MPI_FILE_NULL;
+  internals->Buffer.Clear();
+}
+#else // VTK_USE_MPI_IO
+void vtkMPIXMLUnstructuredGridReader::CloseVTKFile()
+{
+  this->Superclass::CloseVTKFile();
+}
+#endif // VTK_USE_MPI_IO
+
+//----------------------------------------------------------------------------
+void vtkMPIXMLUnstructuredGridReader::ReadXMLData()
+{
+#ifdef VTK_USE_MPI_IO
+  if (this->Internals->File.Handle != MPI_FILE_NULL)
+    {
+    this->ReadAppendedDataRange();
+    }
+#endif // VTK_USE_MPI_IO
+  this->Superclass::ReadXMLData();
+}
+
+//----------------------------------------------------------------------------
+#ifdef VTK_USE_MPI_IO
+void vtkMPIXMLUnstructuredGridReader::ReadAppendedDataRange()
+{
+  vtkInternals* internals = this->Internals;
+  vtkTypeInt64 appendedDataPosition =
+    this->XMLParser->GetAppendedDataPosition();
+  if (!appendedDataPosition)
+    {
+    // All data are inline, and were read with the XML.
+    return;
+    }
+
+  // Find the range of pieces to read, as the superclass will.
+  vtkInformation* outInfo = this->GetCurrentOutputInformation();
+  this->SetupUpdateExtent(
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()),
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES()),
+    outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS()));
+
+  // Find the offsets of all appended arrays, and those needed for the
+  // pieces to read. The arrays outside of the Piece elements, such as field
+  // data, are needed by all processes.
+  std::vector<vtkTypeInt64> offsets;
+  std::vector<vtkTypeInt64> neededOffsets;
+  vtkXMLDataElement* eVTKFile = this->XMLParser->GetRootElement();
+  for (int i = 0; i < eVTKFile->GetNumberOfNestedElements(); ++i)
+    {
+    vtkXMLDataElement* ePrimary = eVTKFile->GetNestedElement(i);
+    int piece = 0;
+    for (int j = 0; j < ePrimary->GetNumberOfNestedElements(); ++j)
+      {
+      vtkXMLDataElement* eNested = ePrimary->GetNestedElement(j);
+      size_t numberOfOffsets = offsets.size();
+      vtkMPIXMLCollectOffsets(eNested, offsets);
+      if (strcmp(eNested->GetName(), "Piece") != 0 ||
+          (piece >= this->StartPiece && piece < this->EndPiece))
+        {
+        neededOffsets.insert(neededOffsets.end(),
+                             offsets.begin() + numberOfOffsets,
+                             offsets.end());
+        }
+      if (strcmp(eNested->GetName(), "Piece") == 0)
+        {
+        ++piece;
+        }
+      }
+    }
+  std::sort(offsets.begin(), offsets.end());
+  std::sort(neededOffsets.begin(), neededOffsets.end());
+  neededOffsets.erase(
+    std::unique(neededOffsets.begin(), neededOffsets.end()),
+    neededOffsets.end());
+
+  // The data of an array end where those of the next one start. Merge the
+  // needed arrays that follow each other into ranges.
+  vtkTypeInt64 appendedDataSize = internals->FileSize - appendedDataPosition;
+  std::vector<std::pair<vtkTypeInt64, vtkTypeInt64> > ranges;
+  for (size_t i = 0; i < neededOffsets.size(); ++i)
+    {
+    std::vector<vtkTypeInt64>::iterator next =
+      std::upper_bound(offsets.begin(), offsets.end(), neededOffsets[i]);
+    vtkTypeInt64 end = (next != offsets.end()) ? *next : appendedDataSize;
+    if (!ranges.empty() && ranges.back().second == neededOffsets[i])
+      {
+      ranges.back().second = end;
+      }
+    else
+      {
+      ranges.push_back(std::make_pair(neededOffsets[i], end));
+      }
+    }
+
+  // Read the ranges with collective calls. Every process makes the same
+  // number of calls, so a process whose read failed goes on with empty
+  // reads, and all processes then agree on the result.
+  int result = 1;
+  long long numberOfRanges = static_cast<long long>(ranges.size());
+  long long maxNumberOfRanges = 0;
+  MPICall(MPI_Allreduce(&numberOfRanges, &maxNumberOfRanges, 1,
+                        MPI_LONG_LONG, MPI_MAX, internals->Comm));
+  for (long long i = 0; i < maxNumberOfRanges; ++i)
+    {
+    vtkTypeInt64 position = appendedDataPosition;
+    vtkTypeInt64 size = 0;
+    char* buffer = 0;
+    if (result && i < numberOfRanges)
+      {
+      position += ranges[i].first;
+      size = std::min(ranges[i].second, appendedDataSize) - ranges[i].first;
+      std::vector<char>& segment = internals->Buffer.GetSegment(position);
+      segment.resize(std::max(size, vtkTypeInt64(0)));
+      buffer = segment.empty() ? 0 : &segment[0];
+      }
+    MPICall(vtkMPIXMLReadAtAll(internals->File.Handle, internals->Comm,
+                               position, buffer, size));
+    }
+  int localResult = result;
+  MPICall(MPI_Allreduce(&localResult, &result, 1, MPI_INT, MPI_MIN,
+                        internals->Comm));
+  if (!result)
+    {
+    this->DataError = 1;
+    }
+}
+#else // VTK_USE_MPI_IO
+void vtkMPIXMLUnstructuredGridReader::ReadAppendedDataRange()
+{
+}
+#endif // VTK_USE_MPI_IO
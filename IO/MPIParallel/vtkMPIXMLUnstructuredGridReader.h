@@ -0,0 +1,87 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMPIXMLUnstructuredGridReader.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMPIXMLUnstructuredGridReader - Read the pieces of a shared VTK
+// XML UnstructuredGrid file with collective MPI-IO.
+//
+// .SECTION Description
+// vtkMPIXMLUnstructuredGridReader reads a multi-piece .vtu file, such as
+// those written by vtkMPIXMLUnstructuredGridWriter, from all processes at
+// once. The first process reads the XML part of the file and sends it to
+// the others, so that the file system only sees one small read of it. Then
+// each process reads, in a single collective MPI-IO call, only the byte
+// range of the appended data holding the pieces it was asked for.
+//
+// All the processes of the controller must update the reader together. The
+// data of pieces stored inline in the XML, rather than appended, are read
+// along with the XML by all processes.
+//
+// If MPI-IO is not available or the controller is not a vtkMPIController,
+// this reader works exactly like its superclass.
+//
+// .SECTION See Also
+// vtkXMLUnstructuredGridReader vtkMPIXMLUnstructuredGridWriter
+
+#ifndef __vtkMPIXMLUnstructuredGridReader_h
+#define __vtkMPIXMLUnstructuredGridReader_h
+
+#include "vtkIOMPIParallelModule.h" // For export macro
+#include "vtkXMLUnstructuredGridReader.h"
+
+class vtkMultiProcessController;
+
+class VTKIOMPIPARALLEL_EXPORT vtkMPIXMLUnstructuredGridReader : public vtkXMLUnstructuredGridReader
+{
+public:
+  static vtkMPIXMLUnstructuredGridReader* New();
+  vtkTypeMacro(vtkMPIXMLUnstructuredGridReader,vtkXMLUnstructuredGridReader);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get/Set the multi process controller to use for coordinated reads.  By
+  // default, set to the global controller.
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  virtual void SetController(vtkMultiProcessController *);
+
+protected:
+  vtkMPIXMLUnstructuredGridReader();
+  ~vtkMPIXMLUnstructuredGridReader();
+
+  // Description:
+  // Open the file with all processes, and read the XML part of the file
+  // on the first process only.
+  virtual int OpenVTKFile();
+  virtual void CloseVTKFile();
+
+  // Description:
+  // Read the appended data of the requested pieces before reading them.
+  virtual void ReadXMLData();
+
+  // Description:
+  // Read the byte range of the appended data used by the pieces to read.
+  void ReadAppendedDataRange();
+
+  vtkMultiProcessController* Controller;
+
+  //BTX
+  class vtkInternals;
+  vtkInternals* Internals;
+  //ETX
+
+private:
+  vtkMPIXMLUnstructuredGridReader(const vtkMPIXMLUnstructuredGridReader&);  // Not implemented.
+  void operator=(const vtkMPIXMLUnstructuredGridReader&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,433 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMPIXMLUnstructuredGridWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMPIXMLUnstructuredGridWriter.h"
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+// Include the MPI headers and then determine if MPIIO is available.
+#include "vtkMPI.h"
+
+#ifdef MPI_VERSION
+#  if (MPI_VERSION >= 2)
+#    define VTK_USE_MPI_IO 1
+#  endif
+#endif
+#if !defined(VTK_USE_MPI_IO) && defined(ROMIO_VERSION)
+#  define VTK_USE_MPI_IO 1
+#endif
+#if !defined(VTK_USE_MPI_IO) && defined(MPI_SEEK_SET)
+#  define VTK_USE_MPI_IO 1
+#endif
+
+// If VTK_USE_MPI_IO is set, that means we will write the shared files
+// ourself using MPIIO.  Otherwise, just delegate everything to the
+// superclass.
+
+#ifdef VTK_USE_MPI_IO
+
+#include "vtkMPICommunicator.h"
+
+#include <vtksys/ios/sstream>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// This macro can be wrapped around MPI function calls to report errors.
+// Unlike network I/O, file I/O errors usually do not terminate the program,
+// so the failure is also recorded in the local variable "result".
+#define MPICall(funcall) \
+  { \
+  int __my_result = funcall; \
+  if (__my_result != MPI_SUCCESS) \
+    { \
+    char errormsg[MPI_MAX_ERROR_STRING]; \
+    int dummy; \
+    MPI_Error_string(__my_result, errormsg, &dummy); \
+    vtkErrorMacro(<< "Received error when calling" << endl \
+                  << #funcall << endl << endl \
+                  << errormsg); \
+    result = 0; \
+    } \
+  }
+
+//----------------------------------------------------------------------------
+// Return a copy of the given XML text in which the appended data offsets
+// are moved forward by the given amount.
+static std::string vtkMPIXMLShiftOffsets(const std::string& xml,
+                                         vtkTypeInt64 shift)
+{
+  const char key[] = " offset=\"";
+  const size_t keyLength = sizeof(key)-1;
+  std::string shifted;
+  shifted.reserve(xml.size());
+  size_t pos = 0;
+  size_t next;
+  while ((next = xml.find(key, pos)) != std::string::npos)
+    {
+    next += keyLength;
+    shifted.append(xml, pos, next-pos);
+    vtkTypeInt64 offset = 0;
+    for (pos = next; pos < xml.size() && xml[pos] >= '0' && xml[pos] <= '9';
+         ++pos)
+      {
+      offset = offset*10 + (xml[pos] - '0');
+      }
+    vtksys_ios::ostringstream value;
+    value << (offset + shift);
+    shifted += value.str();
+    }
+  shifted.append(xml, pos, std::string::npos);
+  return shifted;
+}
+
+//----------------------------------------------------------------------------
+// The parts of a serialized single piece file. Only the Piece element and
+// the appended data differ from one piece to another.
+struct vtkMPIXMLPieceParts
+{
+  std::string Prefix;
+  std::string Piece;
+  std::string Middle;
+  std::string Data;
+  std::string Suffix;
+};
+
+//----------------------------------------------------------------------------
+// Split a file written by vtkXMLUnstructuredGridWriter for a single piece
+// into its parts. Return false if the file does not have the expected
+// layout.
+static bool vtkMPIXMLSplitPiece(const std::string& file,
+                                vtkMPIXMLPieceParts& parts)
+{
+  // The Piece element spans whole lines.
+  size_t begin = file.find("<Piece");
+  size_t end = file.rfind("</Piece>");
+  if (begin == std::string::npos || end == std::string::npos ||
+      (begin = file.rfind('\n', begin)) == std::string::npos ||
+      (end = file.find('\n', end)) == std::string::npos)
+    {
+    return false;
+    }
+  ++begin;
+  ++end;
+
+  // The appended data starts after the underscore that follows the
+  // AppendedData tag, and ends before the line of its closing tag.
+  size_t dataBegin = file.size();
+  size_t dataEnd = file.size();
+  size_t appended = file.find("<AppendedData", end);
+  if (appended != std::string::npos)
+    {
+    dataBegin = file.find('_', file.find('>', appended));
+    dataEnd = file.rfind("</AppendedData>");
+    if (dataBegin == std::string::npos || dataEnd == std::string::npos ||
+        (dataEnd = file.rfind('\n', dataEnd)) == std::string::npos ||
+        dataEnd <= dataBegin)
+      {
+      return false;
+      }
+    ++dataBegin;
+    }
+
+  parts.Prefix.assign(file, 0, begin);
+  parts.Piece.assign(file, begin, end-begin);
+  parts.Middle.assign(file, end, dataBegin-end);
+  parts.Data.assign(file, dataBegin, dataEnd-dataBegin);
+  parts.Suffix.assign(file, dataEnd, std::string::npos);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Write the given bytes at the given offset of a file opened by all the
+// processes of comm, in chunks whose size fits the int count of MPI. All
+// processes make the same number of collective calls.
+static int vtkMPIXMLWriteAtAll(MPI_File file, MPI_Comm comm,
+                               MPI_Offset offset, const std::string& bytes)
+{
+  const long long chunkSize = 1 << 30;
+  long long size = static_cast<long long>(bytes.size());
+  long long numberOfChunks = (size + chunkSize - 1) / chunkSize;
+  long long maxNumberOfChunks = 0;
+  int error = MPI_Allreduce(&numberOfChunks, &maxNumberOfChunks, 1,
+                            MPI_LONG_LONG, MPI_MAX, comm);
+  for (long long i = 0; error == MPI_SUCCESS && i < maxNumberOfChunks; ++i)
+    {
+    long long start = std::min(i*chunkSize, size);
+    int count = static_cast<int>(std::min(chunkSize, size - start));
+    MPI_Status status;
+    error = MPI_File_write_at_all(file, offset + start,
+                                  const_cast<char*>(bytes.data()) + start,
+                                  count, MPI_BYTE, &status);
+    }
+  return error;
+}
+
+#endif // VTK_USE_MPI_IO
+
+//=============================================================================
+vtkStandardNewMacro(vtkMPIXMLUnstructuredGridWriter);
+
+//----------------------------------------------------------------------------
+vtkMPIXMLUnstructuredGridWriter::vtkMPIXMLUnstructuredGridWriter()
+{
+  this->NumberOfFiles = 1;
+}
+
+//----------------------------------------------------------------------------
+vtkMPIXMLUnstructuredGridWriter::~vtkMPIXMLUnstructuredGridWriter()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIXMLUnstructuredGridWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfFiles: " << this->NumberOfFiles << "\n";
+}
+
+//----------------------------------------------------------------------------
+#ifdef VTK_USE_MPI_IO
+int vtkMPIXMLUnstructuredGridWriter::WriteInternal()
+{
+  if (this->NumberOfFiles < 1 || !this->Controller ||
+      !vtkMPICommunicator::SafeDownCast(this->Controller->GetCommunicator()))
+    {
+    return this->Superclass::WriteInternal();
+    }
+
+  // Prepare the file names. The shared files are named like piece files.
+  this->SplitFileName();
+  if (!this->PieceFileNameExtension)
+    {
+    vtkXMLUnstructuredGridWriter* pWriter =
+      vtkXMLUnstructuredGridWriter::New();
+    const char* ext = pWriter->GetDefaultFileExtension();
+    this->PieceFileNameExtension = new char[strlen(ext)+2];
+    this->PieceFileNameExtension[0] = '.';
+    strcpy(this->PieceFileNameExtension+1, ext);
+    pWriter->Delete();
+    }
+
+  int numberOfProcesses = this->Controller->GetNumberOfProcesses();
+  int rank = this->Controller->GetLocalProcessId();
+  int numberOfFiles = std::min(this->NumberOfFiles, numberOfProcesses);
+  if (numberOfFiles == 1)
+    {
+    return this->WriteSharedFile(this->Controller, this->FileName);
+    }
+
+  // Each group of consecutive processes writes one file.
+  int group = static_cast<int>(
+    (static_cast<vtkTypeInt64>(rank) * numberOfFiles) / numberOfProcesses);
+  vtkMultiProcessController* groupController =
+    this->Controller->PartitionController(group, rank);
+  char* fileName = this->CreatePieceFileName(group, this->PathName);
+  int localResult = this->WriteSharedFile(groupController, fileName);
+  delete [] fileName;
+  groupController->Delete();
+
+  // Only refer to the files if all of them were written.
+  int result = 0;
+  this->Controller->AllReduce(&localResult, &result, 1,
+                              vtkCommunicator::MIN_OP);
+  if (result && this->WriteSummaryFile && rank == 0)
+    {
+    result = this->WriteSharedSummaryFile(numberOfFiles);
+    }
+  return result;
+}
+#else // VTK_USE_MPI_IO
+int vtkMPIXMLUnstructuredGridWriter::WriteInternal()
+{
+  return this->Superclass::WriteInternal();
+}
+#endif // VTK_USE_MPI_IO
+
+//----------------------------------------------------------------------------
+int vtkMPIXMLUnstructuredGridWriter::SerializePiece(int index,
+                                                    std::string& output)
+{
+  // Create the writer for the piece.  Its configuration should match
+  // our own writer.
+  vtkXMLWriter* pWriter = this->CreatePieceWriter(index);
+  pWriter->AddObserver(vtkCommand::ProgressEvent, this->ProgressObserver);
+  pWriter->SetWriteToOutputString(1);
+
+  // Copy the writer settings.
+  pWriter->SetDebug(this->Debug);
+  pWriter->SetCompressor(this->Compressor);
+  pWriter->SetDataMode(this->DataMode);
+  pWriter->SetByteOrder(this->ByteOrder);
+  pWriter->SetEncodeAppendedData(this->EncodeAppendedData);
+  pWriter->SetHeaderType(this->HeaderType);
+  pWriter->SetBlockSize(this->BlockSize);
+
+  // Write the piece.
+  int result = pWriter->Write();
+  this->SetErrorCode(pWriter->GetErrorCode());
+  output = pWriter->GetOutputString();
+
+  // Cleanup.
+  pWriter->RemoveObserver(this->ProgressObserver);
+  pWriter->Delete();
+
+  return result;
+}
+
+//----------------------------------------------------------------------------
+#ifdef VTK_USE_MPI_IO
+int vtkMPIXMLUnstructuredGridWriter::WriteSharedFile(
+  vtkMultiProcessController* controller, const char* fileName)
+{
+  MPI_Comm comm = *vtkMPICommunicator::SafeDownCast(
+    controller->GetCommunicator())->GetMPIComm()->GetHandle();
+  int numberOfProcesses = controller->GetNumberOfProcesses();
+  int rank = controller->GetLocalProcessId();
+
+  // Serialize the local pieces. The offsets of each Piece element are
+  // moved past the appended data of the previous local pieces.
+  float progressRange[2] = { 0.f, 0.f };
+  this->GetProgressRange(progressRange);
+  vtkMPIXMLPieceParts parts;
+  std::vector<std::string> pieces;
+  std::string prefix;
+  std::string data;
+  int result = 1;
+  for (int i = this->StartPiece; result && i <= this->EndPiece; ++i)
+    {
+    this->SetProgressRange(progressRange, i-this->StartPiece,
+      this->EndPiece-this->StartPiece + 1);
+    std::string output;
+    if (!this->SerializePiece(i, output))
+      {
+      result = 0;
+      }
+    else if (!vtkMPIXMLSplitPiece(output, parts))
+      {
+      vtkErrorMacro("Unexpected layout of the XML of piece " << i << ".");
+      result = 0;
+      }
+    else
+      {
+      // The field data of the first piece, if any, is in the first lines.
+      if (pieces.empty())
+        {
+        prefix = parts.Prefix;
+        }
+      pieces.push_back(vtkMPIXMLShiftOffsets(parts.Piece, data.size()));
+      data += parts.Data;
+      }
+    }
+
+  // Agree on success, and find the first and last processes with pieces.
+  // They write the beginning and the end of the file.
+  int local[3] = { result, pieces.empty() ? numberOfProcesses : rank,
+                   pieces.empty() ? 1 : -rank };
+  int global[3] = { 0, 0, 0 };
+  MPICall(MPI_Allreduce(local, global, 3, MPI_INT, MPI_MIN, comm));
+  if (!global[0])
+    {
+    return 0;
+    }
+  if (global[1] == numberOfProcesses)
+    {
+    vtkErrorMacro("No pieces to write into " << fileName << ".");
+    return 0;
+    }
+  int first = global[1];
+  int last = -global[2];
+
+  // The appended data of the processes follow each other in rank order.
+  long long dataSize = static_cast<long long>(data.size());
+  long long dataOffset = 0;
+  MPICall(MPI_Exscan(&dataSize, &dataOffset, 1, MPI_LONG_LONG, MPI_SUM,
+                     comm));
+  if (rank == 0)
+    {
+    dataOffset = 0;
+    }
+
+  // So do the Piece elements, between the first lines of the file and
+  // the start of the appended data.
+  std::string xml;
+  if (rank == first)
+    {
+    xml = prefix;
+    }
+  for (size_t i = 0; i < pieces.size(); ++i)
+    {
+    xml += vtkMPIXMLShiftOffsets(pieces[i], dataOffset);
+    }
+  if (rank == last)
+    {
+    xml += parts.Middle;
+    data += parts.Suffix;
+    }
+  long long xmlSize = static_cast<long long>(xml.size());
+  long long xmlOffset = 0;
+  long long headerSize = 0;
+  MPICall(MPI_Exscan(&xmlSize, &xmlOffset, 1, MPI_LONG_LONG, MPI_SUM, comm));
+  MPICall(MPI_Allreduce(&xmlSize, &headerSize, 1, MPI_LONG_LONG, MPI_SUM,
+                        comm));
+  if (rank == 0)
+    {
+    xmlOffset = 0;
+    }
+
+  // Write both regions with collective calls.
+  vtkMPIOpaqueFileHandle file;
+  int error = MPI_File_open(comm, const_cast<char*>(fileName),
+                            MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                            MPI_INFO_NULL, &file.Handle);
+  if (error != MPI_SUCCESS)
+    {
+    vtkErrorMacro("Could not open file: " << fileName);
+    return 0;
+    }
+  MPICall(MPI_File_set_size(file.Handle, 0));
+  MPICall(vtkMPIXMLWriteAtAll(file.Handle, comm, xmlOffset, xml));
+  MPICall(vtkMPIXMLWriteAtAll(file.Handle, comm, headerSize + dataOffset,
+                              data));
+  MPICall(MPI_File_close(&file.Handle));
+
+  local[0] = result;
+  MPICall(MPI_Allreduce(local, global, 1, MPI_INT, MPI_MIN, comm));
+  return result && global[0];
+}
+#else // VTK_USE_MPI_IO
+int vtkMPIXMLUnstructuredGridWriter::WriteSharedFile(
+  vtkMultiProcessController*, const char*)
+{
+  vtkErrorMacro(<< "vtkMPIXMLUnstructuredGridWriter::WriteSharedFile() "
+                << "called when MPIIO not available.");
+  return 0;
+}
+#endif // VTK_USE_MPI_IO
+
+//----------------------------------------------------------------------------
+int vtkMPIXMLUnstructuredGridWriter::WriteSharedSummaryFile(int numberOfFiles)
+{
+  // The summary refers to the shared files as if they were the pieces.
+  int numberOfPieces = this->NumberOfPieces;
+  this->NumberOfPieces = numberOfFiles;
+  int result = this->vtkXMLWriter::WriteInternal();
+  this->NumberOfPieces = numberOfPieces;
+  return result;
+}
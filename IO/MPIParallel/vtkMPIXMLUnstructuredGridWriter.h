@@ -0,0 +1,99 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMPIXMLUnstructuredGridWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMPIXMLUnstructuredGridWriter - Write the pieces of an
+// unstructured grid into shared VTK XML files with collective MPI-IO.
+//
+// .SECTION Description
+// vtkMPIXMLUnstructuredGridWriter writes the pieces assigned to all
+// processes into a small number of VTK XML UnstructuredGrid files instead of
+// one file per piece. Each process serializes its pieces with
+// vtkXMLUnstructuredGridWriter, the processes find where their piece
+// elements and appended data go with a prefix sum of their sizes, and then
+// write them at once with collective MPI-IO calls. The result is a regular
+// multi-piece .vtu file: every reader of the format can read it, and
+// vtkMPIXMLUnstructuredGridReader reads only the bytes of its own pieces.
+//
+// The processes are split into NumberOfFiles groups of consecutive ranks,
+// each of which writes one file. With a single file, it is written at
+// FileName, which should then have the .vtu extension. With several files,
+// they are named like the piece files of the superclass, and the first
+// process writes a .pvtu summary file at FileName referring to them.
+//
+// The appended data mode, the default, makes the most of this writer: the
+// array values are then written in a single contiguous region after the XML
+// of all pieces.
+//
+// If MPI-IO is not available, the controller is not a vtkMPIController, or
+// NumberOfFiles is not positive, this writer works exactly like its
+// superclass and writes one file per piece.
+//
+// .SECTION See Also
+// vtkXMLPUnstructuredGridWriter vtkMPIXMLUnstructuredGridReader
+
+#ifndef __vtkMPIXMLUnstructuredGridWriter_h
+#define __vtkMPIXMLUnstructuredGridWriter_h
+
+#include "vtkIOMPIParallelModule.h" // For export macro
+#include "vtkXMLPUnstructuredGridWriter.h"
+
+class vtkMultiProcessController;
+
+class VTKIOMPIPARALLEL_EXPORT vtkMPIXMLUnstructuredGridWriter : public vtkXMLPUnstructuredGridWriter
+{
+public:
+  static vtkMPIXMLUnstructuredGridWriter* New();
+  vtkTypeMacro(vtkMPIXMLUnstructuredGridWriter,vtkXMLPUnstructuredGridWriter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get/Set the number of files shared by the processes. When zero or
+  // less, each piece is written to its own file like the superclass
+  // does. The default is 1, a single file holding all pieces. There are
+  // never more files than processes.
+  vtkSetMacro(NumberOfFiles, int);
+  vtkGetMacro(NumberOfFiles, int);
+
+protected:
+  vtkMPIXMLUnstructuredGridWriter();
+  ~vtkMPIXMLUnstructuredGridWriter();
+
+  // Override writing method from superclass.
+  virtual int WriteInternal();
+
+  //BTX
+  // Description:
+  // Serialize the piece of the given index with a piece writer into the
+  // given string. Return 0 on failure.
+  int SerializePiece(int index, std::string& output);
+  //ETX
+
+  // Description:
+  // Write the local pieces into the file of the given name, opened by all
+  // processes of the given controller. Return 0 on failure on any process.
+  int WriteSharedFile(vtkMultiProcessController* controller,
+                      const char* fileName);
+
+  // Description:
+  // Write the summary file referring to the given number of shared files.
+  int WriteSharedSummaryFile(int numberOfFiles);
+
+  int NumberOfFiles;
+
+private:
+  vtkMPIXMLUnstructuredGridWriter(const vtkMPIXMLUnstructuredGridWriter&);  // Not implemented.
+  void operator=(const vtkMPIXMLUnstructuredGridWriter&);  // Not implemented.
+};
+
+#endif
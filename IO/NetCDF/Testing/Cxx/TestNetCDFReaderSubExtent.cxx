@@ -0,0 +1,191 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestNetCDFReaderSubExtent.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that a sub-extent of a time step is read, and that fill values,
+// scale_factor and add_offset are applied to it.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMath.h"
+#include "vtkNetCDFReader.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+
+#include "vtk_netcdf.h"
+
+#include <string>
+#include <vector>
+
+static const int NX = 12;
+static const int NY = 8;
+static const int NZ = 5;
+static const int NT = 3;
+
+// The packed value stored at a point, or the fill value.
+static short PackedValue(int t, int k, int j, int i)
+{
+  if ((i + j + k) % 7 == 0)
+    {
+    return -999;
+    }
+  return static_cast<short>(i + 10*j + 100*k + 1000*t);
+}
+
+static float FloatValue(int t, int k, int j, int i)
+{
+  if ((i*j) % 5 == 1)
+    {
+    return 1.0e20f;
+    }
+  return 0.5f*i - j + 0.25f*k + t;
+}
+
+static bool WriteFile(const char* fileName)
+{
+  int ncFD;
+  if (nc_create(fileName, NC_CLOBBER, &ncFD) != NC_NOERR)
+    {
+    return false;
+    }
+  int dims[4];
+  nc_def_dim(ncFD, "time", NC_UNLIMITED, &dims[0]);
+  nc_def_dim(ncFD, "z", NZ, &dims[1]);
+  nc_def_dim(ncFD, "y", NY, &dims[2]);
+  nc_def_dim(ncFD, "x", NX, &dims[3]);
+
+  int packedId, floatId;
+  const short packedFill = -999;
+  const double scale = 0.5;
+  const double offset = -10.0;
+  const float floatFill = 1.0e20f;
+  nc_def_var(ncFD, "packed", NC_SHORT, 4, dims, &packedId);
+  nc_put_att_short(ncFD, packedId, "_FillValue", NC_SHORT, 1, &packedFill);
+  nc_put_att_double(ncFD, packedId, "scale_factor", NC_DOUBLE, 1, &scale);
+  nc_put_att_double(ncFD, packedId, "add_offset", NC_DOUBLE, 1, &offset);
+  nc_def_var(ncFD, "temperature", NC_FLOAT, 4, dims, &floatId);
+  nc_put_att_float(ncFD, floatId, "_FillValue", NC_FLOAT, 1, &floatFill);
+  nc_enddef(ncFD);
+
+  std::vector<short> packed;
+  std::vector<float> values;
+  for (int t = 0; t < NT; t++)
+    {
+    for (int k = 0; k < NZ; k++)
+      {
+      for (int j = 0; j < NY; j++)
+        {
+        for (int i = 0; i < NX; i++)
+          {
+          packed.push_back(PackedValue(t, k, j, i));
+          values.push_back(FloatValue(t, k, j, i));
+          }
+        }
+      }
+    }
+  size_t start[4] = { 0, 0, 0, 0 };
+  size_t count[4] = { NT, NZ, NY, NX };
+  bool success =
+    (nc_put_vara_short(ncFD, packedId, start, count, &packed[0]) == NC_NOERR &&
+     nc_put_vara_float(ncFD, floatId, start, count, &values[0]) == NC_NOERR);
+  return (nc_close(ncFD) == NC_NOERR && success);
+}
+
+int TestNetCDFReaderSubExtent(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory.\n";
+    return 1;
+    }
+  std::string fileName = tempDir;
+  fileName += "/TestNetCDFReaderSubExtent.nc";
+  delete [] tempDir;
+
+  if (!WriteFile(fileName.c_str()))
+    {
+    cerr << "Could not write " << fileName << "\n";
+    return 1;
+    }
+
+  vtkNew<vtkNetCDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->ReplaceFillValueWithNanOn();
+  reader->UpdateInformation();
+  reader->SetVariableArrayStatus("packed", 1);
+  reader->SetVariableArrayStatus("temperature", 1);
+
+  // One level of the second time step, within a smaller box.
+  const int t = 1;
+  int extent[6] = { 3, 9, 2, 6, 4, 4 };
+  vtkInformation* outInfo = reader->GetOutputInformation(0);
+  outInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(),
+               static_cast<double>(t));
+  reader->SetUpdateExtent(0, extent);
+  reader->Update();
+
+  vtkImageData* output = vtkImageData::SafeDownCast(reader->GetOutput());
+  vtkDataArray* packed = output ?
+    output->GetPointData()->GetArray("packed") : 0;
+  vtkDataArray* temperature = output ?
+    output->GetPointData()->GetArray("temperature") : 0;
+  const vtkIdType numPoints = 7*5*1;
+  if (!packed || !temperature ||
+      packed->GetDataType() != VTK_DOUBLE ||
+      temperature->GetDataType() != VTK_FLOAT ||
+      packed->GetNumberOfTuples() != numPoints ||
+      temperature->GetNumberOfTuples() != numPoints)
+    {
+    cerr << "The variables were not read on the requested extent\n";
+    return 1;
+    }
+
+  int errors = 0;
+  vtkIdType index = 0;
+  for (int k = extent[4]; k <= extent[5]; k++)
+    {
+    for (int j = extent[2]; j <= extent[3]; j++)
+      {
+      for (int i = extent[0]; i <= extent[1]; i++, index++)
+        {
+        short value = PackedValue(t, k, j, i);
+        double expected = (value == -999 ? vtkMath::Nan() : 0.5*value - 10.0);
+        double actual = packed->GetComponent(index, 0);
+        if (vtkMath::IsNan(expected) ? !vtkMath::IsNan(actual)
+                                     : actual != expected)
+          {
+          cerr << "Wrong packed value at " << i << " " << j << " " << k
+               << ": " << actual << " instead of " << expected << "\n";
+          errors++;
+          }
+        float floatValue = FloatValue(t, k, j, i);
+        expected = (floatValue == 1.0e20f ? vtkMath::Nan() : floatValue);
+        actual = temperature->GetComponent(index, 0);
+        if (vtkMath::IsNan(expected) ? !vtkMath::IsNan(actual)
+                                     : actual != expected)
+          {
+          cerr << "Wrong temperature at " << i << " " << j << " " << k
+               << ": " << actual << " instead of " << expected << "\n";
+          errors++;
+          }
+        }
+      }
+    }
+
+  return (errors != 0);
+}
@@ -13,6 +13,7 @@ vtk_module(vtkIONetCDF
     vtkRendering${VTK_RENDERING_BACKEND}
     vtkTestingRendering
     vtkInteractionStyle
+    vtknetcdf
   KIT
     vtkIO
   )
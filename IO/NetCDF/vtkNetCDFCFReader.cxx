@@ -328,7 +328,7 @@ int vtkNetCDFCFReader::vtkDimensionInfo::LoadMetaData(int ncFD)
       // bound value of the next entry anyway.
       size_t start[2];  start[0] = start[1] = 0;
       size_t count[2];  count[0] = dimLen;  count[1] = 1;
-      CALL_NETCDF_GW(nc_get_vars_double(ncFD, boundsVarId, start, count, NULL,
+      CALL_NETCDF_GW(nc_get_vara_double(ncFD, boundsVarId, start, count,
                                         this->Bounds->GetPointer(0)));
 
       // Read in the last value for the bounds array.  It will be the second
@@ -336,7 +336,7 @@ int vtkNetCDFCFReader::vtkDimensionInfo::LoadMetaData(int ncFD)
       // dimension is a longitudinal one that wraps all the way around.
       start[0] = dimLen-1;  start[1] = 1;
       count[0] = 1;  count[1] = 1;
-      CALL_NETCDF_GW(nc_get_vars_double(ncFD, boundsVarId, start, count, NULL,
+      CALL_NETCDF_GW(nc_get_vara_double(ncFD, boundsVarId, start, count,
                                         this->Bounds->GetPointer(dimLen)));
       }
     else
@@ -34,6 +34,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkStructuredGrid.h"
@@ -42,7 +43,6 @@
 #define VTK_CREATE(type, name) \
   vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
-#include <algorithm>
 #include <map>
 #include <set>
 #include <string>
@@ -95,6 +95,81 @@ static int NetCDFTypeToVTKType(nc_type type)
     }
 }
 
+//=============================================================================
+namespace {
+
+// Replaces the fill values of a float or double array with NaN in place.
+template <class T>
+class vtkNetCDFReaderReplaceFill
+{
+public:
+  T *Values;
+  T FillValue;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const T nan = static_cast<T>(vtkMath::Nan());
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      if (this->Values[i] == this->FillValue)
+        {
+        this->Values[i] = nan;
+        }
+      }
+  }
+};
+
+// Converts packed values with scale_factor and add_offset to double.  Fill
+// values become NaN if requested.
+template <class T>
+class vtkNetCDFReaderUnpack
+{
+public:
+  const T *Input;
+  double *Output;
+  double Scale;
+  double Offset;
+  bool ReplaceFill;
+  double FillValue;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const double nan = vtkMath::Nan();
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      const double value = static_cast<double>(this->Input[i]);
+      this->Output[i] = ((this->ReplaceFill && value == this->FillValue)
+                         ? nan : value*this->Scale + this->Offset);
+      }
+  }
+};
+
+template <class T>
+void vtkNetCDFReaderUnpackValues(const T *input, double *output,
+                                 vtkIdType size, double scale, double offset,
+                                 bool replaceFill, double fillValue)
+{
+  vtkNetCDFReaderUnpack<T> unpack;
+  unpack.Input = input;
+  unpack.Output = output;
+  unpack.Scale = scale;
+  unpack.Offset = offset;
+  unpack.ReplaceFill = replaceFill;
+  unpack.FillValue = fillValue;
+  vtkSMPTools::For(0, size, 65536, unpack);
+}
+
+template <class T>
+void vtkNetCDFReaderReplaceFillValues(T *values, vtkIdType size, T fillValue)
+{
+  vtkNetCDFReaderReplaceFill<T> replace;
+  replace.Values = values;
+  replace.FillValue = fillValue;
+  vtkSMPTools::For(0, size, 65536, replace);
+}
+
+} // end anonymous namespace
+
 //=============================================================================
 vtkStandardNewMacro(vtkNetCDFReader);
 
@@ -817,42 +892,21 @@ int vtkNetCDFReader::LoadVariable(int ncFD, const char *varName, double time,
   dataArray->SetNumberOfComponents(1);
   dataArray->SetNumberOfTuples(arraySize);
 
-  // Read the array from the file.
-  CALL_NETCDF(nc_get_vars(ncFD, varId, start, count, NULL,
+  // Read the array from the file.  The extent is contiguous, so read it as
+  // one hyperslab; nc_get_vars() without a stride maps every value.
+  CALL_NETCDF(nc_get_vara(ncFD, varId, start, count,
                           dataArray->GetVoidPointer(0)));
 
   // Check for a fill value.
   size_t attribLength;
-  if (   (nc_inq_attlen(ncFD, varId, "_FillValue", &attribLength) == NC_NOERR)
+  bool replaceFill = false;
+  double fillValue = 0.0;
+  if (   this->ReplaceFillValueWithNan
+      && (nc_inq_attlen(ncFD, varId, "_FillValue", &attribLength) == NC_NOERR)
       && (attribLength == 1) )
     {
-    if (this->ReplaceFillValueWithNan)
-      {
-      // NaN only available with float and double.
-      if (dataArray->GetDataType() == VTK_FLOAT)
-        {
-        float fillValue;
-        nc_get_att_float(ncFD, varId, "_FillValue", &fillValue);
-        std::replace(reinterpret_cast<float*>(dataArray->GetVoidPointer(0)),
-                        reinterpret_cast<float*>(dataArray->GetVoidPointer(
-                                               dataArray->GetNumberOfTuples())),
-                        fillValue, static_cast<float>(vtkMath::Nan()));
-        }
-      else if (dataArray->GetDataType() == VTK_DOUBLE)
-        {
-        double fillValue;
-        nc_get_att_double(ncFD, varId, "_FillValue", &fillValue);
-        std::replace(reinterpret_cast<double*>(dataArray->GetVoidPointer(0)),
-                        reinterpret_cast<double*>(dataArray->GetVoidPointer(
-                                               dataArray->GetNumberOfTuples())),
-                        fillValue, vtkMath::Nan());
-        }
-      else
-        {
-        vtkDebugMacro(<< "No NaN available for data of type "
-                      << dataArray->GetDataType());
-        }
-      }
+    replaceFill
+      = (nc_get_att_double(ncFD, varId, "_FillValue", &fillValue) == NC_NOERR);
     }
 
   // Check to see if there is a scale or offset.
@@ -874,12 +928,36 @@ int vtkNetCDFReader::LoadVariable(int ncFD, const char *varName, double time,
     VTK_CREATE(vtkDoubleArray, adjustedArray);
     adjustedArray->SetNumberOfComponents(1);
     adjustedArray->SetNumberOfTuples(arraySize);
-    for (vtkIdType i = 0; i < arraySize; i++)
+    switch (dataArray->GetDataType())
       {
-      adjustedArray->SetValue(i, dataArray->GetTuple1(i)*scale + offset);
+      vtkTemplateMacro(vtkNetCDFReaderUnpackValues(
+                         static_cast<VTK_TT*>(dataArray->GetVoidPointer(0)),
+                         adjustedArray->GetPointer(0), arraySize,
+                         scale, offset, replaceFill, fillValue));
       }
     dataArray = adjustedArray;
     }
+  else if (replaceFill)
+    {
+    // NaN only available with float and double.
+    if (dataArray->GetDataType() == VTK_FLOAT)
+      {
+      vtkNetCDFReaderReplaceFillValues(
+        static_cast<float*>(dataArray->GetVoidPointer(0)), arraySize,
+        static_cast<float>(fillValue));
+      }
+    else if (dataArray->GetDataType() == VTK_DOUBLE)
+      {
+      vtkNetCDFReaderReplaceFillValues(
+        static_cast<double*>(dataArray->GetVoidPointer(0)), arraySize,
+        fillValue);
+      }
+    else
+      {
+      vtkDebugMacro(<< "No NaN available for data of type "
+                    << dataArray->GetDataType());
+      }
+    }
 
   // Add data to the output.
   dataArray->SetName(varName);
@@ -104,7 +104,9 @@ public:
 
   // Description:
   // If on, any float or double variable read that has a _FillValue attribute
-  // will have that fill value replaced with a not-a-number (NaN) value.  The
+  // will have that fill value replaced with a not-a-number (NaN) value.  So
+  // will variables of any type that are converted to double because they
+  // have a scale_factor or add_offset attribute.  The
   // advantage of setting these to NaN values is that, if implemented properly
   // by the system and careful math operations are used, they can implicitly be
   // ignored by calculations like finding the range of the values.  That said,
@@ -0,0 +1,274 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPLYReaderBinary.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that binary files in both byte orders are read exactly like the
+// same ASCII file, with properties of several types, lists of different
+// lengths, and elements that are not read.
+
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPLYReader.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+enum { ASCII = 0, BINARY_LE = 1, BINARY_BE = 2 };
+
+// Write a value in the format of the file.
+template <class T>
+static void WriteValue(FILE* fp, int format, T value, const char* text)
+{
+  if (format == ASCII)
+    {
+    fprintf(fp, "%s ", text);
+    return;
+    }
+  char bytes[sizeof(T)];
+  memcpy(bytes, &value, sizeof(T));
+  if (format == BINARY_LE)
+    {
+    vtkByteSwap::SwapLERange(reinterpret_cast<T*>(bytes), 1);
+    }
+  else
+    {
+    vtkByteSwap::SwapBERange(reinterpret_cast<T*>(bytes), 1);
+    }
+  fwrite(bytes, 1, sizeof(T), fp);
+}
+
+static void WriteFloat(FILE* fp, int format, float value)
+{
+  char text[32];
+  sprintf(text, "%.9g", value);
+  WriteValue(fp, format, value, text);
+}
+
+static void WriteDouble(FILE* fp, int format, double value)
+{
+  char text[32];
+  sprintf(text, "%.17g", value);
+  WriteValue(fp, format, value, text);
+}
+
+static void WriteInt(FILE* fp, int format, int value)
+{
+  char text[32];
+  sprintf(text, "%d", value);
+  WriteValue(fp, format, value, text);
+}
+
+static void WriteUChar(FILE* fp, int format, unsigned char value)
+{
+  char text[32];
+  sprintf(text, "%d", value);
+  WriteValue(fp, format, value, text);
+}
+
+static void WriteFile(const char* fileName, int format)
+{
+  const int numPts = 3000;
+  const int numFaces = 2000;
+  const char* formats[3] = {
+    "ascii", "binary_little_endian", "binary_big_endian" };
+  FILE* fp = fopen(fileName, "wb");
+  fprintf(fp, "ply\nformat %s 1.0\ncomment test\n"
+          "element vertex %d\n"
+          "property float x\nproperty float y\nproperty float z\n"
+          "property int id\n"
+          "property double nx\nproperty double ny\nproperty double nz\n"
+          "property float u\nproperty float v\n"
+          "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+          "element face %d\n"
+          "property uchar intensity\n"
+          "property list uchar int vertex_indices\n"
+          "property list int float weights\n"
+          "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+          "element edge 2\n"
+          "property list uchar int vertex_indices\n"
+          "end_header\n", formats[format], numPts, numFaces);
+
+  vtkMath::RandomSeed(4321);
+  for (int i = 0; i < numPts; i++)
+    {
+    for (int j = 0; j < 3; j++)
+      {
+      WriteFloat(fp, format, static_cast<float>(vtkMath::Random(-5, 5)));
+      }
+    WriteInt(fp, format, i);
+    for (int j = 0; j < 3; j++)
+      {
+      WriteDouble(fp, format, vtkMath::Random(-1, 1));
+      }
+    for (int j = 0; j < 2; j++)
+      {
+      WriteFloat(fp, format, static_cast<float>(vtkMath::Random(0, 1)));
+      }
+    for (int j = 0; j < 3; j++)
+      {
+      WriteUChar(fp, format,
+                 static_cast<unsigned char>(vtkMath::Random(0, 255)));
+      }
+    if (format == ASCII)
+      {
+      fprintf(fp, "\n");
+      }
+    }
+  for (int i = 0; i < numFaces; i++)
+    {
+    WriteUChar(fp, format, static_cast<unsigned char>(i % 256));
+    int n = 3 + i % 3;
+    WriteUChar(fp, format, static_cast<unsigned char>(n));
+    for (int j = 0; j < n; j++)
+      {
+      WriteInt(fp, format, static_cast<int>(vtkMath::Random(0, numPts)));
+      }
+    n = i % 4;
+    WriteInt(fp, format, n);
+    for (int j = 0; j < n; j++)
+      {
+      WriteFloat(fp, format, static_cast<float>(j));
+      }
+    for (int j = 0; j < 3; j++)
+      {
+      WriteUChar(fp, format,
+                 static_cast<unsigned char>(vtkMath::Random(0, 255)));
+      }
+    if (format == ASCII)
+      {
+      fprintf(fp, "\n");
+      }
+    }
+  for (int i = 0; i < 2; i++)
+    {
+    WriteUChar(fp, format, 2);
+    WriteInt(fp, format, i);
+    WriteInt(fp, format, i + 1);
+    if (format == ASCII)
+      {
+      fprintf(fp, "\n");
+      }
+    }
+  fclose(fp);
+}
+
+// Compares two arrays value by value, and reports the first difference.
+// A missing array is a difference.
+static bool SameArrays(vtkDataArray* a, vtkDataArray* b, const char* name)
+{
+  if (!a || !b)
+    {
+    cerr << "The " << name << " array is missing\n";
+    return false;
+    }
+  if (a->GetDataType() != b->GetDataType() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents() ||
+      a->GetNumberOfTuples() != b->GetNumberOfTuples())
+    {
+    cerr << "The " << name << " array has " << a->GetNumberOfTuples()
+         << " tuples of " << a->GetNumberOfComponents() << " "
+         << a->GetDataTypeAsString() << " instead of " << b->GetNumberOfTuples()
+         << " tuples of " << b->GetNumberOfComponents() << " "
+         << b->GetDataTypeAsString() << "\n";
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); i++)
+    {
+    for (int j = 0; j < a->GetNumberOfComponents(); j++)
+      {
+      if (a->GetComponent(i, j) != b->GetComponent(i, j))
+        {
+        cerr << "The " << name << " array has " << a->GetComponent(i, j)
+             << " instead of " << b->GetComponent(i, j) << " at tuple " << i
+             << ", component " << j << "\n";
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+static vtkSmartPointer<vtkPolyData> ReadFile(const char* fileName)
+{
+  vtkNew<vtkPLYReader> reader;
+  reader->SetFileName(fileName);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+int TestPLYReaderBinary(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory.\n";
+    return 1;
+    }
+  std::string prefix = tempDir;
+  prefix += "/TestPLYReaderBinary";
+  delete [] tempDir;
+
+  std::string fileName = prefix + "-ascii.ply";
+  WriteFile(fileName.c_str(), ASCII);
+  vtkSmartPointer<vtkPolyData> expected = ReadFile(fileName.c_str());
+
+  int errors = 0;
+  for (int format = BINARY_LE; format <= BINARY_BE; format++)
+    {
+    fileName = prefix + (format == BINARY_LE ? "-le.ply" : "-be.ply");
+    WriteFile(fileName.c_str(), format);
+    vtkSmartPointer<vtkPolyData> output = ReadFile(fileName.c_str());
+
+    vtkPointData* pd = output->GetPointData();
+    vtkCellData* cd = output->GetCellData();
+    if (!SameArrays(output->GetPoints()->GetData(),
+                    expected->GetPoints()->GetData(), "points") ||
+        !SameArrays(output->GetPolys()->GetData(),
+                    expected->GetPolys()->GetData(), "faces") ||
+        !SameArrays(pd->GetNormals(), expected->GetPointData()->GetNormals(),
+                    "normals") ||
+        !SameArrays(pd->GetTCoords(), expected->GetPointData()->GetTCoords(),
+                    "texture coordinates") ||
+        !SameArrays(pd->GetArray("RGB"),
+                    expected->GetPointData()->GetArray("RGB"), "point RGB") ||
+        !SameArrays(cd->GetArray("intensity"),
+                    expected->GetCellData()->GetArray("intensity"),
+                    "intensity") ||
+        !SameArrays(cd->GetArray("RGB"),
+                    expected->GetCellData()->GetArray("RGB"), "face RGB"))
+      {
+      cerr << "Binary file " << fileName << " differs from the ASCII file\n";
+      errors++;
+      }
+    }
+
+  if (expected->GetNumberOfPoints() != 3000 ||
+      expected->GetNumberOfPolys() != 2000)
+    {
+    cerr << "Wrong number of points or faces\n";
+    errors++;
+    }
+
+  return (errors != 0);
+}
@@ -2239,18 +2239,57 @@ void vtkPLY::get_binary_item(
   unsigned int *uint_val,
   double *double_val
 )
+{
+  if (type <= PLY_START_TYPE || type >= PLY_END_TYPE) {
+    fprintf (stderr, "get_binary_item: bad type = %d\n", type);
+    assert (0);
+    return;
+  }
+
+  char data[8];
+  if (fread (data, ply_type_size[type], 1, plyfile->fp) != 1)
+    {
+    vtkGenericWarningMacro ("PLY error reading file."
+                            << " Premature EOF while reading "
+                            << type_names[type] << ".");
+    fclose (plyfile->fp);
+    return;
+    }
+
+  get_binary_item (data, plyfile->file_type, type,
+                   int_val, uint_val, double_val);
+}
+
+
+/******************************************************************************
+Get the value of an item of a binary file from memory, and place the
+result into an integer, an unsigned integer and a double.
+
+Entry:
+  data      - memory holding the item
+  file_type - PLY_BINARY_BE or PLY_BINARY_LE
+  type      - data type of the item
+
+Exit:
+  int_val    - integer value
+  uint_val   - unsigned integer value
+  double_val - double-precision floating point value
+******************************************************************************/
+
+void vtkPLY::get_binary_item(
+  const char *data,
+  int file_type,
+  int type,
+  int *int_val,
+  unsigned int *uint_val,
+  double *double_val
+)
 {
   switch (type) {
     case PLY_CHAR:
       {
-      vtkTypeInt8 value = 0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-        {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading char.");
-        fclose (plyfile->fp);
-        return;
-        }
+      vtkTypeInt8 value;
+      memcpy (&value, data, sizeof(value));
       *int_val = value;
       *uint_val = value;
       *double_val = value;
@@ -2259,14 +2298,8 @@ void vtkPLY::get_binary_item(
     case PLY_UCHAR:
     case PLY_UINT8:
       {
-      vtkTypeUInt8 value = 0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-        {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading uchar or uint8.");
-        fclose (plyfile->fp);
-        return;
-        }
+      vtkTypeUInt8 value;
+      memcpy (&value, data, sizeof(value));
       *int_val = value;
       *uint_val = value;
       *double_val = value;
@@ -2274,15 +2307,9 @@ void vtkPLY::get_binary_item(
       break;
     case PLY_SHORT:
       {
-      vtkTypeInt16 value = 0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-        {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading short.");
-        fclose (plyfile->fp);
-        return;
-        }
-      plyfile->file_type == PLY_BINARY_BE ?
+      vtkTypeInt16 value;
+      memcpy (&value, data, sizeof(value));
+      file_type == PLY_BINARY_BE ?
         vtkByteSwap::Swap2BE(&value) :
         vtkByteSwap::Swap2LE(&value);
       *int_val = value;
@@ -2292,15 +2319,9 @@ void vtkPLY::get_binary_item(
       break;
     case PLY_USHORT:
       {
-      vtkTypeUInt16 value = 0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-        {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading ushort.");
-        fclose (plyfile->fp);
-        return;
-        }
-      plyfile->file_type == PLY_BINARY_BE ?
+      vtkTypeUInt16 value;
+      memcpy (&value, data, sizeof(value));
+      file_type == PLY_BINARY_BE ?
         vtkByteSwap::Swap2BE(&value) :
         vtkByteSwap::Swap2LE(&value);
       *int_val = value;
@@ -2311,15 +2332,9 @@ void vtkPLY::get_binary_item(
     case PLY_INT:
     case PLY_INT32:
       {
-      vtkTypeInt32 value = 0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-        {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading int or int32.");
-        fclose (plyfile->fp);
-        return;
-        }
-      plyfile->file_type == PLY_BINARY_BE ?
+      vtkTypeInt32 value;
+      memcpy (&value, data, sizeof(value));
+      file_type == PLY_BINARY_BE ?
         vtkByteSwap::Swap4BE(&value) :
         vtkByteSwap::Swap4LE(&value);
       *int_val = value;
@@ -2329,15 +2344,9 @@ void vtkPLY::get_binary_item(
       break;
     case PLY_UINT:
       {
-      vtkTypeUInt32 value = 0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-        {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading uint");
-        fclose (plyfile->fp);
-        return;
-        }
-      plyfile->file_type == PLY_BINARY_BE ?
+      vtkTypeUInt32 value;
+      memcpy (&value, data, sizeof(value));
+      file_type == PLY_BINARY_BE ?
         vtkByteSwap::Swap4BE(&value) :
         vtkByteSwap::Swap4LE(&value);
       *int_val = value;
@@ -2348,15 +2357,9 @@ void vtkPLY::get_binary_item(
     case PLY_FLOAT:
     case PLY_FLOAT32:
       {
-      vtkTypeFloat32 value = 0.0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-        {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading float of float32.");
-        fclose (plyfile->fp);
-        return;
-        }
-      plyfile->file_type == PLY_BINARY_BE ?
+      vtkTypeFloat32 value;
+      memcpy (&value, data, sizeof(value));
+      file_type == PLY_BINARY_BE ?
         vtkByteSwap::Swap4BE(&value) :
         vtkByteSwap::Swap4LE(&value);
       *int_val = static_cast<int>(value);
@@ -2366,15 +2369,9 @@ void vtkPLY::get_binary_item(
       break;
     case PLY_DOUBLE:
       {
-      vtkTypeFloat64 value = 0.0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-        {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading double.");
-        fclose (plyfile->fp);
-        return;
-        }
-      plyfile->file_type == PLY_BINARY_BE ?
+      vtkTypeFloat64 value;
+      memcpy (&value, data, sizeof(value));
+      file_type == PLY_BINARY_BE ?
         vtkByteSwap::Swap8BE(&value) :
         vtkByteSwap::Swap8LE(&value);
       *int_val = static_cast<int>(value);
@@ -2389,6 +2386,18 @@ void vtkPLY::get_binary_item(
 }
 
 
+/******************************************************************************
+Get the size in bytes of an item of the given type in a binary file.
+******************************************************************************/
+
+int vtkPLY::get_type_size(int type)
+{
+  if (type <= PLY_START_TYPE || type >= PLY_END_TYPE)
+    return 0;
+  return ply_type_size[type];
+}
+
+
 /******************************************************************************
 Extract the value of an item from an ascii word, and place the result
 into an integer, an unsigned integer and a double.
@@ -205,6 +205,8 @@ public:
   static double get_item_value(const char *, int);
   static void get_ascii_item(const char *, int, int *, unsigned int *, double *);
   static void get_binary_item(PlyFile *, int, int *, unsigned int *, double *);
+  static void get_binary_item(const char *, int, int, int *, unsigned int *, double *);
+  static int get_type_size(int);
   static void ascii_get_element(PlyFile *, char *);
   static void binary_get_element(PlyFile *, char *);
   static void *my_alloc(size_t, int, const char *);
@@ -18,15 +18,22 @@
 #include "vtkCellData.h"
 #include "vtkPointData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryMappedFile.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPLY.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
 
 #include <ctype.h>
 #include <cstddef>
+#include <string.h>
+#include <vector>
 
 vtkStandardNewMacro(vtkPLYReader);
 
@@ -62,6 +69,368 @@ typedef struct _plyFace {
   int *verts;             // vertex index list
 } plyFace;
 
+//----------------------------------------------------------------------------
+// Binary files are decoded directly from a memory mapping of the file.
+// The start of each element instance is found with a sequential pass when
+// the element holds lists, and the instances are then decoded in
+// parallel.  The values are converted exactly as vtkPLY::ply_get_element
+// would.
+
+// The output arrays of the vertex and face elements.
+struct vtkPLYReaderOutput
+{
+  float* Points;
+  float* TCoords;
+  float* Normals;
+  unsigned char* RGBPoints;
+  vtkIdType* Connectivity;
+  const vtkIdType* CellLocations;
+  unsigned char* Intensity;
+  unsigned char* RGBCells;
+};
+
+// A binary element of the file.
+class vtkPLYReaderElement
+{
+public:
+  PlyElement* Element;
+  int FileType;
+  const char* Data;
+  vtkIdType Stride;
+  std::vector<const char*> Starts;
+
+  // Find the start of each instance of the element, and the end of the
+  // element.  Returns NULL if the element runs past the end of the file.
+  const char* Locate(const char* data, const char* end)
+  {
+    this->Data = data;
+    this->Stride = 0;
+    bool hasLists = false;
+    for (int j = 0; j < this->Element->nprops; j++)
+      {
+      PlyProperty* prop = this->Element->props[j];
+      hasLists = hasLists || prop->is_list;
+      this->Stride += vtkPLY::get_type_size(prop->external_type);
+      }
+    if (!hasLists)
+      {
+      vtkIdType size = this->Stride * this->Element->num;
+      return (end - data >= size) ? data + size : NULL;
+      }
+
+    this->Starts.resize(this->Element->num);
+    const char* p = data;
+    for (int i = 0; i < this->Element->num; i++)
+      {
+      this->Starts[i] = p;
+      for (int j = 0; j < this->Element->nprops; j++)
+        {
+        PlyProperty* prop = this->Element->props[j];
+        int size = vtkPLY::get_type_size(prop->external_type);
+        if (prop->is_list)
+          {
+          int countSize = vtkPLY::get_type_size(prop->count_external);
+          if (end - p < countSize)
+            {
+            return NULL;
+            }
+          int count;
+          unsigned int uCount;
+          double dCount;
+          vtkPLY::get_binary_item(p, this->FileType, prop->count_external,
+                                  &count, &uCount, &dCount);
+          if (count < 0)
+            {
+            return NULL;
+            }
+          p += countSize;
+          size *= count;
+          }
+        if (end - p < size)
+          {
+          return NULL;
+          }
+        p += size;
+        }
+      }
+    return p;
+  }
+
+  const char* GetStart(vtkIdType i) const
+  {
+    return this->Starts.empty() ? this->Data + i*this->Stride : this->Starts[i];
+  }
+};
+
+// Decode a scalar property stored as float.
+static inline float vtkPLYReaderGetFloat(const char* p, int fileType, int type)
+{
+  int i;
+  unsigned int u;
+  double d;
+  vtkPLY::get_binary_item(p, fileType, type, &i, &u, &d);
+  return static_cast<float>(d);
+}
+
+// Decode a scalar property stored as unsigned char.
+static inline unsigned char vtkPLYReaderGetUChar(const char* p, int fileType,
+                                                 int type)
+{
+  int i;
+  unsigned int u;
+  double d;
+  vtkPLY::get_binary_item(p, fileType, type, &i, &u, &d);
+  return static_cast<unsigned char>(u);
+}
+
+// Decodes the properties of a range of element instances.
+class vtkPLYReaderDecodeFunctor
+{
+public:
+  const vtkPLYReaderElement* Element;
+  vtkPLYReaderOutput Output;
+  bool IsFace;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    PlyElement* elem = this->Element->Element;
+    int fileType = this->Element->FileType;
+    const vtkPLYReaderOutput& out = this->Output;
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      const char* p = this->Element->GetStart(i);
+      for (int j = 0; j < elem->nprops; j++)
+        {
+        PlyProperty* prop = elem->props[j];
+        int size = vtkPLY::get_type_size(prop->external_type);
+        const char* name = prop->name;
+        if (prop->is_list)
+          {
+          int count;
+          unsigned int uCount;
+          double dCount;
+          vtkPLY::get_binary_item(p, fileType, prop->count_external,
+                                  &count, &uCount, &dCount);
+          p += vtkPLY::get_type_size(prop->count_external);
+          if (this->IsFace && !strcmp(name, "vertex_indices"))
+            {
+            // The number of vertices is stored as unsigned char.
+            vtkIdType* cell = out.Connectivity + out.CellLocations[i];
+            int nverts = static_cast<unsigned char>(uCount);
+            *cell++ = nverts;
+            for (int k = 0; k < nverts; k++)
+              {
+              int index;
+              unsigned int uIndex;
+              double dIndex;
+              vtkPLY::get_binary_item(p + k*size, fileType,
+                                      prop->external_type,
+                                      &index, &uIndex, &dIndex);
+              *cell++ = index;
+              }
+            }
+          p += size*count;
+          continue;
+          }
+
+        int type = prop->external_type;
+        if (!this->IsFace)
+          {
+          if (!strcmp(name, "x") || !strcmp(name, "y") || !strcmp(name, "z"))
+            {
+            out.Points[3*i + (name[0] - 'x')] =
+              vtkPLYReaderGetFloat(p, fileType, type);
+            }
+          else if (out.TCoords && (!strcmp(name, "u") || !strcmp(name, "v")))
+            {
+            out.TCoords[2*i + (name[0] - 'u')] =
+              vtkPLYReaderGetFloat(p, fileType, type);
+            }
+          else if (out.Normals && (!strcmp(name, "nx") ||
+                   !strcmp(name, "ny") || !strcmp(name, "nz")))
+            {
+            out.Normals[3*i + (name[1] - 'x')] =
+              vtkPLYReaderGetFloat(p, fileType, type);
+            }
+          else if (out.RGBPoints && !strcmp(name, "red"))
+            {
+            out.RGBPoints[3*i] = vtkPLYReaderGetUChar(p, fileType, type);
+            }
+          else if (out.RGBPoints && !strcmp(name, "green"))
+            {
+            out.RGBPoints[3*i + 1] = vtkPLYReaderGetUChar(p, fileType, type);
+            }
+          else if (out.RGBPoints && !strcmp(name, "blue"))
+            {
+            out.RGBPoints[3*i + 2] = vtkPLYReaderGetUChar(p, fileType, type);
+            }
+          }
+        else
+          {
+          if (out.Intensity && !strcmp(name, "intensity"))
+            {
+            out.Intensity[i] = vtkPLYReaderGetUChar(p, fileType, type);
+            }
+          else if (out.RGBCells && !strcmp(name, "red"))
+            {
+            out.RGBCells[3*i] = vtkPLYReaderGetUChar(p, fileType, type);
+            }
+          else if (out.RGBCells && !strcmp(name, "green"))
+            {
+            out.RGBCells[3*i + 1] = vtkPLYReaderGetUChar(p, fileType, type);
+            }
+          else if (out.RGBCells && !strcmp(name, "blue"))
+            {
+            out.RGBCells[3*i + 2] = vtkPLYReaderGetUChar(p, fileType, type);
+            }
+          }
+        p += size;
+        }
+      }
+  }
+};
+
+// Read the vertex and face elements of a binary file.  Returns -1 if the
+// file cannot be mapped, 0 if it is truncated, and 1 for success.
+static int vtkPLYReaderReadBinary(
+  PlyFile* ply, const char* fileName, vtkPolyData* output,
+  vtkFloatArray* tcoords, vtkFloatArray* normals,
+  vtkUnsignedCharArray* rgbPoints, vtkUnsignedCharArray* intensity,
+  vtkUnsignedCharArray* rgbCells)
+{
+  long start = ftell(ply->fp);
+  vtkNew<vtkMemoryMappedFile> mappedFile;
+  if (start < 0 || !mappedFile->Open(fileName) ||
+      mappedFile->GetSize() < static_cast<vtkTypeUInt64>(start))
+    {
+    return -1;
+    }
+  const char* data =
+    reinterpret_cast<const char*>(mappedFile->GetData()) + start;
+  const char* end =
+    reinterpret_cast<const char*>(mappedFile->GetData()) +
+    mappedFile->GetSize();
+
+  vtkPLYReaderOutput out;
+  memset(&out, 0, sizeof(out));
+  for (int e = 0; e < ply->nelems; e++)
+    {
+    vtkPLYReaderElement element;
+    element.Element = ply->elems[e];
+    element.FileType = ply->file_type;
+    data = element.Locate(data, end);
+    if (!data)
+      {
+      return 0;
+      }
+    vtkIdType num = element.Element->num;
+    vtkPLYReaderDecodeFunctor functor;
+    functor.Element = &element;
+
+    if (!strcmp(element.Element->name, "vertex"))
+      {
+      vtkPoints* pts = vtkPoints::New();
+      pts->SetDataTypeToFloat();
+      pts->SetNumberOfPoints(num);
+      out.Points = static_cast<float*>(pts->GetVoidPointer(0));
+      if (tcoords)
+        {
+        tcoords->SetNumberOfTuples(num);
+        out.TCoords = tcoords->GetPointer(0);
+        }
+      if (normals)
+        {
+        normals->SetNumberOfTuples(num);
+        out.Normals = normals->GetPointer(0);
+        }
+      if (rgbPoints)
+        {
+        rgbPoints->SetNumberOfTuples(num);
+        out.RGBPoints = rgbPoints->GetPointer(0);
+        }
+      functor.Output = out;
+      functor.IsFace = false;
+      vtkSMPTools::For(0, num, 4096, functor);
+      output->SetPoints(pts);
+      pts->Delete();
+      }
+    else if (!strcmp(element.Element->name, "face"))
+      {
+      // Find where each cell starts in the connectivity.
+      int index;
+      PlyProperty* prop =
+        vtkPLY::find_property(element.Element, "vertex_indices", &index);
+      if (!prop || !prop->is_list)
+        {
+        return 0;
+        }
+      int countOffset = 0;
+      for (int j = 0; j < index && element.Starts.empty(); j++)
+        {
+        countOffset +=
+          vtkPLY::get_type_size(element.Element->props[j]->external_type);
+        }
+      std::vector<vtkIdType> locations(num + 1);
+      locations[0] = 0;
+      for (vtkIdType i = 0; i < num; i++)
+        {
+        const char* p = element.GetStart(i);
+        for (int j = 0; j < index; j++)
+          {
+          PlyProperty* before = element.Element->props[j];
+          if (before->is_list)
+            {
+            int count;
+            unsigned int uCount;
+            double dCount;
+            vtkPLY::get_binary_item(p, ply->file_type, before->count_external,
+                                    &count, &uCount, &dCount);
+            p += vtkPLY::get_type_size(before->count_external) +
+              count*vtkPLY::get_type_size(before->external_type);
+            }
+          else
+            {
+            p += vtkPLY::get_type_size(before->external_type);
+            }
+          }
+        int count;
+        unsigned int uCount;
+        double dCount;
+        vtkPLY::get_binary_item(p, ply->file_type, prop->count_external,
+                                &count, &uCount, &dCount);
+        locations[i + 1] =
+          locations[i] + 1 + static_cast<unsigned char>(uCount);
+        }
+
+      vtkIdTypeArray* connectivity = vtkIdTypeArray::New();
+      connectivity->SetNumberOfValues(locations[num]);
+      out.Connectivity = connectivity->GetPointer(0);
+      out.CellLocations = &locations[0];
+      if (intensity)
+        {
+        intensity->SetNumberOfTuples(num);
+        out.Intensity = intensity->GetPointer(0);
+        }
+      if (rgbCells)
+        {
+        rgbCells->SetNumberOfComponents(3);
+        rgbCells->SetNumberOfTuples(num);
+        out.RGBCells = rgbCells->GetPointer(0);
+        }
+      functor.Output = out;
+      functor.IsFace = true;
+      vtkSMPTools::For(0, num, 4096, functor);
+
+      vtkCellArray* polys = vtkCellArray::New();
+      polys->SetCells(num, connectivity);
+      output->SetPolys(polys);
+      polys->Delete();
+      connectivity->Delete();
+      }
+    }
+  return 1;
+}
+
 int vtkPLYReader::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **vtkNotUsed(inputVector),
@@ -138,6 +507,7 @@ int vtkPLYReader::RequestData(
     {
     vtkErrorMacro(<<"Cannot read geometry");
     vtkPLY::ply_close (ply);
+    return 0;
     }
 
   // Check for optional attribute data. We can handle intensity; and the
@@ -210,6 +580,33 @@ int vtkPLYReader::RequestData(
     output->GetPointData()->SetTCoords(TexCoordsPoints);
     }
 
+  // Binary files are decoded in bulk when the faces are lists of indices.
+  elem = vtkPLY::find_element(ply, "face");
+  PlyProperty *indices = vtkPLY::find_property(elem, "vertex_indices", &index);
+  if ( fileType != PLY_ASCII && indices->is_list )
+    {
+    int result = vtkPLYReaderReadBinary(
+      ply, this->FileName, output, TexCoordsPoints, Normals, RGBPoints,
+      intensity, RGBCells);
+    if ( result >= 0 )
+      {
+      for (int i = 0; i < nelems; i++)
+        {
+        free(elist[i]); //allocated by ply_open_for_reading
+        }
+      free(elist);
+      vtkPLY::ply_close (ply);
+      if ( result == 0 )
+        {
+        vtkErrorMacro(<<"Premature EOF while reading " << this->FileName);
+        return 0;
+        }
+      vtkDebugMacro( <<"Read: " << output->GetNumberOfPoints() << " points, "
+                     << output->GetNumberOfPolys() << " polygons");
+      return 1;
+      }
+    }
+
   // Okay, now we can grab the data
   int numPts = 0, numPolys = 0;
   for (int i = 0; i < nelems; i++)
@@ -291,8 +688,7 @@ int vtkPLYReader::RequestData(
       if ( intensityAvailable )
         {
         vtkPLY::ply_get_property (ply, elemName, &faceProps[1]);
-        RGBCells->SetNumberOfComponents(1);
-        RGBCells->SetNumberOfTuples(numPolys);
+        intensity->SetNumberOfTuples(numPolys);
         }
       if ( RGBCellsAvailable )
         {
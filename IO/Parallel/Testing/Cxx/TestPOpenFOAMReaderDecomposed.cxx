@@ -0,0 +1,304 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPOpenFOAMReaderDecomposed.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the meshes and fields read from the processor directories of a
+// decomposed case, one with lists long enough to be converted
+// concurrently and one with short lists.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkDirectory.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPOpenFOAMReader.h"
+#include "vtkPoints.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+static FILE* OpenFoamFile(const std::string& path, const char* className,
+                          const char* object)
+{
+  FILE* fp = fopen(path.c_str(), "w");
+  if (fp)
+    {
+    fprintf(fp, "FoamFile\n{\n    version 2.0;\n    format ascii;\n"
+            "    class %s;\n    object %s;\n}\n\n", className, object);
+    }
+  return fp;
+}
+
+// The value of a cell, written differently for odd and even cells.
+static float CellValue(int proc, int cellI)
+{
+  return (proc == 0 ? 1.0f : -1.0f)*0.25f*cellI;
+}
+
+static void WriteCellValue(FILE* fp, int proc, int cellI)
+{
+  if (cellI % 2)
+    {
+    fprintf(fp, "%.2fe-1\n", 10.0*CellValue(proc, cellI));
+    }
+  else
+    {
+    fprintf(fp, "%g\n", CellValue(proc, cellI));
+    }
+}
+
+// Writes a block of nx*ny*nz hexahedra, shifted by offset along x, as the
+// mesh of a processor directory, with the fields p and U.
+static bool WriteProcessor(const std::string& dir, int proc, int nx, int ny,
+                           int nz, double offset)
+{
+  std::string meshDir = dir + "/constant/polyMesh";
+  if (!vtkDirectory::MakeDirectory(meshDir.c_str()) ||
+      !vtkDirectory::MakeDirectory((dir + "/0").c_str()))
+    {
+    return false;
+    }
+
+  FILE* fp = OpenFoamFile(meshDir + "/points", "vectorField", "points");
+  if (!fp)
+    {
+    return false;
+    }
+  fprintf(fp, "%d\n(\n", (nx + 1)*(ny + 1)*(nz + 1));
+  for (int k = 0; k <= nz; k++)
+    {
+    for (int j = 0; j <= ny; j++)
+      {
+      for (int i = 0; i <= nx; i++)
+        {
+        fprintf(fp, "(%g %g %g)\n", offset + 0.5*i, 0.25*j, -0.5*k);
+        }
+      }
+    }
+  fprintf(fp, ")\n");
+  fclose(fp);
+
+  // internal faces first, then the boundary faces, each oriented out of
+  // its owner
+  std::vector<std::vector<int> > faces;
+  std::vector<int> owner, neighbour;
+  const int px = 1, py = nx + 1, pz = (nx + 1)*(ny + 1);
+  for (int pass = 0; pass < 2; pass++)
+    {
+    for (int k = 0; k < nz; k++)
+      {
+      for (int j = 0; j < ny; j++)
+        {
+        for (int i = 0; i < nx; i++)
+          {
+          const int cell = i + nx*(j + ny*k);
+          const int p = i*px + j*py + k*pz;
+          const int sides[3][4] = {
+            { p + px, p + px + py, p + px + py + pz, p + px + pz },
+            { p + py, p + py + pz, p + px + py + pz, p + px + py },
+            { p + pz, p + px + pz, p + px + py + pz, p + py + pz } };
+          const int strides[3] = { 1, nx, nx*ny };
+          const int lasts[3] = { i == nx - 1, j == ny - 1, k == nz - 1 };
+          const int firsts[3] = { i == 0, j == 0, k == 0 };
+          const int shifts[3] = { px, py, pz };
+          for (int d = 0; d < 3; d++)
+            {
+            if (pass == 0 && !lasts[d])
+              {
+              faces.push_back(std::vector<int>(sides[d], sides[d] + 4));
+              owner.push_back(cell);
+              neighbour.push_back(cell + strides[d]);
+              }
+            else if (pass == 1 && lasts[d])
+              {
+              faces.push_back(std::vector<int>(sides[d], sides[d] + 4));
+              owner.push_back(cell);
+              }
+            if (pass == 1 && firsts[d])
+              {
+              std::vector<int> face(4);
+              for (int n = 0; n < 4; n++)
+                {
+                face[n] = sides[d][3 - n] - shifts[d];
+                }
+              faces.push_back(face);
+              owner.push_back(cell);
+              }
+            }
+          }
+        }
+      }
+    }
+  const int nInternalFaces = static_cast<int>(neighbour.size());
+  const int nFaces = static_cast<int>(faces.size());
+
+  fp = OpenFoamFile(meshDir + "/faces", "faceList", "faces");
+  fprintf(fp, "%d\n(\n", nFaces);
+  for (int f = 0; f < nFaces; f++)
+    {
+    fprintf(fp, "4(%d %d %d %d)\n",
+            faces[f][0], faces[f][1], faces[f][2], faces[f][3]);
+    }
+  fprintf(fp, ")\n");
+  fclose(fp);
+
+  fp = OpenFoamFile(meshDir + "/owner", "labelList", "owner");
+  fprintf(fp, "%d\n(\n", nFaces);
+  for (int f = 0; f < nFaces; f++)
+    {
+    fprintf(fp, "%d\n", owner[f]);
+    }
+  fprintf(fp, ")\n");
+  fclose(fp);
+
+  fp = OpenFoamFile(meshDir + "/neighbour", "labelList", "neighbour");
+  fprintf(fp, "%d\n(\n", nInternalFaces);
+  for (int f = 0; f < nInternalFaces; f++)
+    {
+    fprintf(fp, "%d\n", neighbour[f]);
+    }
+  fprintf(fp, ")\n");
+  fclose(fp);
+
+  fp = OpenFoamFile(meshDir + "/boundary", "polyBoundaryMesh", "boundary");
+  fprintf(fp, "1\n(\n    walls\n    {\n        type wall;\n"
+          "        nFaces %d;\n        startFace %d;\n    }\n)\n",
+          nFaces - nInternalFaces, nInternalFaces);
+  fclose(fp);
+
+  const int nCells = nx*ny*nz;
+  fp = OpenFoamFile(dir + "/0/p", "volScalarField", "p");
+  fprintf(fp, "dimensions [0 2 -2 0 0 0 0];\n\n"
+          "internalField nonuniform List<scalar>\n%d\n(\n", nCells);
+  for (int c = 0; c < nCells; c++)
+    {
+    if (c == nCells/2)
+      {
+      fprintf(fp, "// halfway /* through */\n");
+      }
+    WriteCellValue(fp, proc, c);
+    }
+  fprintf(fp, ")\n;\n\nboundaryField\n{\n    walls\n    {\n"
+          "        type calculated;\n        value uniform 0;\n    }\n}\n");
+  fclose(fp);
+
+  fp = OpenFoamFile(dir + "/0/U", "volVectorField", "U");
+  fprintf(fp, "dimensions [0 1 -1 0 0 0 0];\n\n"
+          "internalField nonuniform List<vector>\n%d\n(\n", nCells);
+  for (int c = 0; c < nCells; c++)
+    {
+    fprintf(fp, "(%d %g /* z */ 0.5)\n", c, CellValue(proc, c));
+    }
+  fprintf(fp, ")\n;\n\nboundaryField\n{\n    walls\n    {\n"
+          "        type calculated;\n        value uniform (0 0 0);\n"
+          "    }\n}\n");
+  fclose(fp);
+  return true;
+}
+
+int TestPOpenFOAMReaderDecomposed(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory.\n";
+    return 1;
+    }
+  std::string caseDir = tempDir;
+  caseDir += "/TestPOpenFOAMReaderDecomposed";
+  delete [] tempDir;
+
+  // processor0 has lists converted concurrently, processor1 does not
+  const int sizes[2][3] = { { 30, 20, 30 }, { 4, 3, 2 } };
+  vtkDirectory::DeleteDirectory(caseDir.c_str());
+  if (!vtkDirectory::MakeDirectory((caseDir + "/system").c_str()) ||
+      !WriteProcessor(caseDir + "/processor0", 0,
+                      sizes[0][0], sizes[0][1], sizes[0][2], 0.0) ||
+      !WriteProcessor(caseDir + "/processor1", 1,
+                      sizes[1][0], sizes[1][1], sizes[1][2], 100.0))
+    {
+    cerr << "Could not write the case\n";
+    return 1;
+    }
+  FILE* fp = OpenFoamFile(caseDir + "/system/controlDict", "dictionary",
+                          "controlDict");
+  fprintf(fp, "application icoFoam;\nstartTime 0;\nendTime 1;\n"
+          "deltaT 1;\nwriteControl timeStep;\nwriteInterval 1;\n");
+  fclose(fp);
+  fp = fopen((caseDir + "/case.foam").c_str(), "w");
+  fclose(fp);
+
+  vtkNew<vtkPOpenFOAMReader> reader;
+  reader->SetCaseType(vtkPOpenFOAMReader::DECOMPOSED_CASE);
+  reader->SetFileName((caseDir + "/case.foam").c_str());
+  reader->Update();
+
+  int errors = 0;
+  vtkUnstructuredGrid* mesh =
+    vtkUnstructuredGrid::SafeDownCast(reader->GetOutput()->GetBlock(0));
+  const int nCells0 = sizes[0][0]*sizes[0][1]*sizes[0][2];
+  const int nCells1 = sizes[1][0]*sizes[1][1]*sizes[1][2];
+  const int nPoints0 = (sizes[0][0] + 1)*(sizes[0][1] + 1)*(sizes[0][2] + 1);
+  if (!mesh || mesh->GetNumberOfCells() != nCells0 + nCells1)
+    {
+    cerr << "Wrong number of cells read\n";
+    return 1;
+    }
+
+  vtkDataArray* p = mesh->GetCellData()->GetArray("p");
+  vtkDataArray* u = mesh->GetCellData()->GetArray("U");
+  if (!p || !u || u->GetNumberOfComponents() != 3)
+    {
+    cerr << "The fields were not read\n";
+    return 1;
+    }
+  for (int c = 0; c < nCells0 + nCells1; c++)
+    {
+    const int proc = (c < nCells0 ? 0 : 1);
+    const int cellI = (proc == 0 ? c : c - nCells0);
+    double* vector = u->GetTuple3(c);
+    if (mesh->GetCellType(c) != VTK_HEXAHEDRON ||
+        p->GetComponent(c, 0) != CellValue(proc, cellI) ||
+        vector[0] != cellI || vector[1] != CellValue(proc, cellI) ||
+        vector[2] != 0.5)
+      {
+      cerr << "Wrong cell " << cellI << " of processor" << proc << "\n";
+      errors++;
+      break;
+      }
+    }
+
+  // the last point of each processor directory
+  double x[3];
+  mesh->GetPoints()->GetPoint(nPoints0 - 1, x);
+  if (x[0] != 0.5*sizes[0][0] || x[1] != 0.25*sizes[0][1] ||
+      x[2] != -0.5*sizes[0][2])
+    {
+    cerr << "Wrong points read from processor0\n";
+    errors++;
+    }
+  mesh->GetPoints()->GetPoint(mesh->GetNumberOfPoints() - 1, x);
+  if (x[0] != 100.0 + 0.5*sizes[1][0] || x[1] != 0.25*sizes[1][1] ||
+      x[2] != -0.5*sizes[1][2])
+    {
+    cerr << "Wrong points read from processor1\n";
+    errors++;
+    }
+
+  return (errors != 0);
+}
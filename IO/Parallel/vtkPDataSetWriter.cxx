@@ -600,6 +600,24 @@ void vtkPDataSetWriter::DeleteFiles()
   delete [] fileRoot;
 }
 
+//----------------------------------------------------------------------------
+int vtkPDataSetWriter::CopyWriterSettings(vtkWriter *writer)
+{
+  if (!this->Superclass::CopyWriterSettings(writer))
+    {
+    return 0;
+    }
+  vtkPDataSetWriter *copy = static_cast<vtkPDataSetWriter *>(writer);
+  copy->SetNumberOfPieces(this->NumberOfPieces);
+  copy->SetStartPiece(this->StartPiece);
+  copy->SetEndPiece(this->EndPiece);
+  copy->SetGhostLevel(this->GhostLevel);
+  copy->SetFilePattern(this->FilePattern);
+  copy->SetUseRelativeFileNames(this->UseRelativeFileNames);
+  copy->SetController(this->Controller);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkPDataSetWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -113,6 +113,11 @@ protected:
 
   void DeleteFiles();
 
+  // Description:
+  // Copy the piece, ghost level and file pattern settings and the
+  // controller along with the settings of the superclass.
+  virtual int CopyWriterSettings(vtkWriter *writer);
+
   typedef std::map<int, std::vector<int> > ExtentsType;
   ExtentsType Extents;
 
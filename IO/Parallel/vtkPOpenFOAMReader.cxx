@@ -30,14 +30,58 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkPOpenFOAMReader);
 vtkCxxSetObjectMacro(vtkPOpenFOAMReader, Controller, vtkMultiProcessController);
 
+namespace {
+
+//-----------------------------------------------------------------------------
+// Lists the time directories and regions of processor subdirectories
+// concurrently.
+class vtkPOpenFOAMReaderInformation
+{
+public:
+  std::vector<vtkOpenFOAMReader *> Readers;
+  std::vector<vtkStdString> ProcNames;
+  mutable std::vector<char> Succeeded;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Succeeded[i] = (this->Readers[i]->MakeInformationVector(NULL,
+          this->ProcNames[i]) != 0);
+      }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Updates the readers of processor subdirectories concurrently. Each
+// reader reads its own files into its own output.
+class vtkPOpenFOAMReaderUpdater
+{
+public:
+  std::vector<vtkOpenFOAMReader *> Readers;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Readers[i]->Update();
+      }
+  }
+};
+
+} // end anonymous namespace
+
 //-----------------------------------------------------------------------------
 vtkPOpenFOAMReader::vtkPOpenFOAMReader()
 {
@@ -257,14 +301,28 @@ int vtkPOpenFOAMReader::RequestInformation(vtkInformation *request,
 
     // create reader instances for other processor subdirectories
     // skip processor0 since it's already created
+    vtkPOpenFOAMReaderInformation information;
     for (int procI = (this->ProcessId ? this->ProcessId : this->NumProcesses); procI
         < procNames->GetNumberOfTuples(); procI += this->NumProcesses)
       {
       vtkOpenFOAMReader *subReader = vtkOpenFOAMReader::New();
       subReader->SetFileName(this->FileName);
       subReader->SetParent(this);
+      information.Readers.push_back(subReader);
+      information.ProcNames.push_back(procNames->GetValue(procI));
+      }
+
+    // list the time directories of the subdirectories concurrently. the
+    // metadata is gathered into the selections of this reader, in order
+    const vtkIdType nSubReaders =
+        static_cast<vtkIdType>(information.Readers.size());
+    information.Succeeded.resize(nSubReaders);
+    vtkSMPTools::For(0, nSubReaders, 1, information);
+    for (vtkIdType readerI = 0; readerI < nSubReaders; readerI++)
+      {
+      vtkOpenFOAMReader *subReader = information.Readers[readerI];
       // if getting metadata failed simply delete the reader instance
-      if (subReader->MakeInformationVector(NULL, procNames->GetValue(procI))
+      if (information.Succeeded[readerI]
           && subReader->MakeMetaDataAtTimeStep(true))
         {
         this->Superclass::Readers->AddItem(subReader);
@@ -272,7 +330,7 @@ int vtkPOpenFOAMReader::RequestInformation(vtkInformation *request,
       else
         {
         vtkWarningMacro(<<"Removing reader for processor subdirectory "
-            << procNames->GetValue(procI).c_str());
+            << information.ProcNames[readerI].c_str());
         }
       subReader->Delete();
       }
@@ -330,6 +388,7 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
     vtkAppendCompositeDataLeaves *append = vtkAppendCompositeDataLeaves::New();
     // append->AppendFieldDataOn();
 
+    vtkPOpenFOAMReaderUpdater updater;
     vtkOpenFOAMReader *reader;
     this->Superclass::CurrentReaderIndex = 0;
     this->Superclass::Readers->InitTraversal();
@@ -348,6 +407,7 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
       if (reader->MakeMetaDataAtTimeStep(false))
         {
         append->AddInputConnection(reader->GetOutputPort());
+        updater.Readers.push_back(reader);
         }
       }
 
@@ -361,7 +421,13 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
     else
       {
       // reader->RequestInformation() and RequestData() are called
-      // for all reader instances without setting UPDATE_TIME_STEPS
+      // for all reader instances without setting UPDATE_TIME_STEPS.
+      // the readers are updated concurrently first, so that the append
+      // filter finds them up to date
+      this->Superclass::UpdatingReadersConcurrently = true;
+      vtkSMPTools::For(0, static_cast<vtkIdType>(updater.Readers.size()), 1,
+          updater);
+      this->Superclass::UpdatingReadersConcurrently = false;
       append->Update();
       output->ShallowCopy(append->GetOutput());
       }
@@ -0,0 +1,140 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLCompressionBatch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that compressing the blocks of an array in batches writes the
+// same file as compressing them one at a time, and that the file reads
+// back correctly, with each of the compressors.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <string>
+#include <vtksys/ios/sstream>
+
+// Write the image and return the contents of the file.
+static std::string WriteImage(vtkImageData* image, const char* fileName,
+                              int compressor, int dataMode,
+                              int blocksPerBatch)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName);
+  writer->SetCompressorType(compressor);
+  writer->SetDataMode(dataMode);
+  writer->SetBlockSize(1024);
+  writer->SetBlocksPerCompressionBatch(blocksPerBatch);
+  writer->Write();
+
+  ifstream file(fileName, ios::in | ios::binary);
+  vtksys_ios::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+int TestXMLCompressionBatch(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory.\n";
+    return 1;
+    }
+  std::string fileName = tempDir;
+  fileName += "/TestXMLCompressionBatch.vti";
+  delete [] tempDir;
+
+  // arrays of 48 and 24 blocks, with a partial last block
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(37, 41, 4);
+  vtkIdType n = image->GetNumberOfPoints();
+
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("values");
+  values->SetNumberOfTuples(n);
+  vtkNew<vtkIntArray> labels;
+  labels->SetName("labels");
+  labels->SetNumberOfTuples(n);
+  vtkMath::RandomSeed(4321);
+  for (vtkIdType i = 0; i < n; i++)
+    {
+    values->SetValue(i, (i % 7 == 0 ? vtkMath::Random() : 0.5*(i % 13)));
+    labels->SetValue(i, static_cast<int>(i/10));
+    }
+  image->GetPointData()->SetScalars(values.GetPointer());
+  image->GetPointData()->AddArray(labels.GetPointer());
+
+  int errors = 0;
+  int compressors[2] = { vtkXMLWriter::ZLIB, vtkXMLWriter::ZSTD };
+  int dataModes[2] = { vtkXMLWriter::Binary, vtkXMLWriter::Appended };
+  for (int c = 0; c < 4; c++)
+    {
+    int m = c % 2;
+    std::string batched[3];
+    for (int b = 0; b < 3; b++)
+      {
+      batched[b] = WriteImage(image.GetPointer(), fileName.c_str(),
+                              compressors[c/2], dataModes[m], 1 << (3*b));
+      }
+    for (int b = 1; b < 3; b++)
+      {
+      if (batched[b] != batched[0])
+        {
+        cerr << "Batches of " << (1 << (3*b)) << " blocks change the output"
+             << " in data mode " << dataModes[m]
+             << " with compressor " << compressors[c/2] << "\n";
+        errors++;
+        }
+      }
+
+    vtkNew<vtkXMLImageDataReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    vtkPointData* pd = reader->GetOutput()->GetPointData();
+    vtkDoubleArray* readValues =
+      vtkDoubleArray::SafeDownCast(pd->GetArray("values"));
+    vtkIntArray* readLabels =
+      vtkIntArray::SafeDownCast(pd->GetArray("labels"));
+    if (!readValues || !readLabels ||
+        readValues->GetNumberOfTuples() != n ||
+        readLabels->GetNumberOfTuples() != n)
+      {
+      cerr << "Arrays were not read in data mode " << dataModes[m]
+           << " with compressor " << compressors[c/2] << "\n";
+      errors++;
+      continue;
+      }
+    for (vtkIdType i = 0; i < n; i++)
+      {
+      if (readValues->GetValue(i) != values->GetValue(i) ||
+          readLabels->GetValue(i) != labels->GetValue(i))
+        {
+        cerr << "Wrong value read at " << i << " in data mode "
+             << dataModes[m] << " with compressor " << compressors[c/2]
+             << "\n";
+        errors++;
+        break;
+        }
+      }
+    }
+
+  return (errors != 0);
+}
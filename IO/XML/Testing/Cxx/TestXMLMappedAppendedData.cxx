@@ -0,0 +1,171 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLMappedAppendedData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that arrays stored raw in the appended data section are mapped
+// from the file in both byte orders, that the mapping outlives the
+// reader, and that encoded or compressed arrays are still read.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMemoryMappedFile.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkShortArray.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <string>
+
+static void WriteImage(vtkImageData* image, const char* fileName,
+                       int byteOrder, int compressor, int encode)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName);
+  writer->SetDataModeToAppended();
+  writer->SetHeaderTypeToUInt64();
+  writer->SetByteOrder(byteOrder);
+  writer->SetCompressorType(compressor);
+  writer->SetEncodeAppendedData(encode);
+  writer->Write();
+}
+
+// Read the image and compare it to the original.  Returns the number of
+// arrays that were mapped, or -1 if the values differ.
+static int ReadImage(vtkImageData* image, const char* fileName,
+                     int memoryMap)
+{
+  vtkSmartPointer<vtkImageData> output;
+    {
+    vtkNew<vtkXMLImageDataReader> reader;
+    reader->SetFileName(fileName);
+    reader->SetMemoryMapAppendedData(memoryMap);
+    reader->Update();
+    output = reader->GetOutput();
+    }
+
+  // The reader is gone, the mapped arrays must still be valid.
+  int mapped = 0;
+  vtkPointData* pd = image->GetPointData();
+  for (int a = 0; a < pd->GetNumberOfArrays(); a++)
+    {
+    vtkDataArray* array = pd->GetArray(a);
+    vtkDataArray* readArray =
+      output->GetPointData()->GetArray(array->GetName());
+    if (!readArray || readArray->GetDataType() != array->GetDataType() ||
+        readArray->GetNumberOfTuples() != array->GetNumberOfTuples())
+      {
+      cerr << "Array " << array->GetName() << " was not read\n";
+      return -1;
+      }
+    for (vtkIdType i = 0; i < array->GetNumberOfTuples(); i++)
+      {
+      if (readArray->GetTuple1(i) != array->GetTuple1(i))
+        {
+        cerr << "Wrong value read at " << i << " in array "
+             << array->GetName() << "\n";
+        return -1;
+        }
+      }
+    if (readArray->GetInformation()->Has(vtkMemoryMappedFile::MAPPED_FILE()))
+      {
+      mapped++;
+      }
+    }
+  return mapped;
+}
+
+int TestXMLMappedAppendedData(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+    {
+    cerr << "Could not determine temporary directory.\n";
+    return 1;
+    }
+  std::string fileName = tempDir;
+  fileName += "/TestXMLMappedAppendedData.vti";
+  delete [] tempDir;
+
+  // both arrays hold a multiple of 8 bytes
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(20, 15, 10);
+  vtkIdType n = image->GetNumberOfPoints();
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("values");
+  values->SetNumberOfTuples(n);
+  vtkNew<vtkShortArray> labels;
+  labels->SetNumberOfTuples(n);
+  for (vtkIdType i = 0; i < n; i++)
+    {
+    values->SetValue(i, 0.25*i - 100.0);
+    labels->SetValue(i, static_cast<short>(i % 1000 - 500));
+    }
+  image->GetPointData()->SetScalars(values.GetPointer());
+  image->GetPointData()->AddArray(labels.GetPointer());
+
+  int errors = 0;
+  int byteOrders[2] = { vtkXMLWriter::BigEndian, vtkXMLWriter::LittleEndian };
+  for (int b = 0; b < 2; b++)
+    {
+    // The position of the appended data depends on the length of the
+    // XML.  Lengthen the name of the labels until the data are aligned
+    // for doubles and both arrays are mapped.
+    std::string name = "labels";
+    int mapped = 0;
+    for (int pad = 0; pad < 8 && mapped >= 0 && mapped < 2;
+         pad++, name += "_")
+      {
+      labels->SetName(name.c_str());
+      WriteImage(image.GetPointer(), fileName.c_str(), byteOrders[b],
+                 vtkXMLWriter::NONE, 0);
+      mapped = ReadImage(image.GetPointer(), fileName.c_str(), 1);
+      }
+    if (mapped != 2)
+      {
+      cerr << "Arrays were not mapped in byte order " << byteOrders[b] << "\n";
+      errors++;
+      }
+
+    // Swapping the mapped data must not change the file.
+    if (ReadImage(image.GetPointer(), fileName.c_str(), 0) != 0)
+      {
+      cerr << "Mapping changed the file in byte order " << byteOrders[b]
+           << "\n";
+      errors++;
+      }
+    }
+
+  // Encoded and compressed data are read instead.
+  WriteImage(image.GetPointer(), fileName.c_str(), vtkXMLWriter::BigEndian,
+             vtkXMLWriter::NONE, 1);
+  if (ReadImage(image.GetPointer(), fileName.c_str(), 1) != 0)
+    {
+    cerr << "Encoded data were not read correctly\n";
+    errors++;
+    }
+  WriteImage(image.GetPointer(), fileName.c_str(), vtkXMLWriter::BigEndian,
+             vtkXMLWriter::ZLIB, 0);
+  if (ReadImage(image.GetPointer(), fileName.c_str(), 1) != 0)
+    {
+    cerr << "Compressed data were not read correctly\n";
+    errors++;
+    }
+
+  return (errors != 0);
+}
@@ -14,17 +14,21 @@
 =========================================================================*/
 #include "vtkXMLReader.h"
 
+#include "vtkByteSwap.h"
 #include "vtkCallbackCommand.h"
+#include "vtkDataArray.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDataCompressor.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkInstantiator.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkObjectFactory.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataParser.h"
 #include "vtkXMLFileReadTester.h"
 #include "vtkZLibDataCompressor.h"
+#include "vtkZstdDataCompressor.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -87,6 +91,8 @@ vtkXMLReader::vtkXMLReader()
   this->StringStream = 0;
   this->ReadFromInputString = 0;
   this->InputString = "";
+  this->MemoryMapAppendedData = 0;
+  this->MappedFile = 0;
   this->XMLParser = 0;
   this->FieldDataElement = 0;
   this->PointDataArraySelection = vtkDataArraySelection::New();
@@ -138,6 +144,10 @@ vtkXMLReader::~vtkXMLReader()
     this->DestroyXMLParser();
     }
   this->CloseStream();
+  if (this->MappedFile)
+    {
+    this->MappedFile->Delete();
+    }
   this->CellDataArraySelection->RemoveObserver(this->SelectionObserver);
   this->PointDataArraySelection->RemoveObserver(this->SelectionObserver);
   this->SelectionObserver->Delete();
@@ -164,6 +174,8 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "Stream: (none)\n";
     }
+  os << indent << "MemoryMapAppendedData: " << this->MemoryMapAppendedData
+     << "\n";
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
   os << indent << "TimeStepRange:(" << this->TimeStepRange[0] << ","
@@ -382,12 +394,17 @@ void vtkXMLReader::SetupCompressor(const char* type)
   vtkObject* object = vtkInstantiator::CreateInstance(type);
   vtkDataCompressor* compressor = vtkDataCompressor::SafeDownCast(object);
 
-  // In static builds, the vtkZLibDataCompressor may not have been
-  // registered with the vtkInstantiator.  Check for it here.
+  // In static builds, the vtkZLibDataCompressor and
+  // vtkZstdDataCompressor may not have been registered with the
+  // vtkInstantiator.  Check for them here.
   if (!compressor && (strcmp(type, "vtkZLibDataCompressor") == 0))
     {
     compressor = vtkZLibDataCompressor::New();
     }
+  else if (!compressor && (strcmp(type, "vtkZstdDataCompressor") == 0))
+    {
+    compressor = vtkZstdDataCompressor::New();
+    }
 
   if (!compressor)
     {
@@ -606,8 +623,14 @@ int vtkXMLReader::RequestData(vtkInformation *vtkNotUsed(request),
   // We have finished reading.
   this->UpdateProgressDiscrete(1);
 
-  // Close the input stream to prevent resource leaks.
+  // Close the input stream to prevent resource leaks.  The arrays that
+  // were mapped keep the mapping alive.
   this->CloseStream();
+  if (this->MappedFile)
+    {
+    this->MappedFile->Delete();
+    this->MappedFile = 0;
+    }
   if( this->TimeSteps )
     {
     // The SetupOutput should not reallocate this should be done only in a TimeStep case
@@ -992,6 +1015,107 @@ void vtkXMLReader::ReadAttributeIndices(
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLReader::MapArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
+                                 vtkAbstractArray* array, vtkIdType startIndex,
+                                 vtkIdType numValues)
+{
+  // Only whole arrays of the appended data section of a file can be
+  // mapped.
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+  if (!this->MemoryMapAppendedData || this->ReadFromInputString ||
+      !this->FileName || !dataArray || dataArray->GetDataType() == VTK_BIT ||
+      !da->GetAttribute("offset") || arrayIndex != 0 || startIndex != 0 ||
+      numValues != dataArray->GetNumberOfTuples() *
+                   dataArray->GetNumberOfComponents())
+    {
+    return 0;
+    }
+
+  // The data must be stored raw and uncompressed.
+  vtkTypeInt64 offset = 0;
+  da->GetScalarAttribute("offset", offset);
+  vtkTypeInt64 position = 0;
+  vtkTypeUInt64 size = 0;
+  int wordSize = dataArray->GetDataTypeSize();
+  if (!this->XMLParser->FindRawAppendedData(offset, position, size) ||
+      size != static_cast<vtkTypeUInt64>(numValues) * wordSize)
+    {
+    return 0;
+    }
+
+  // Map the file on first use.
+  if (!this->MappedFile)
+    {
+    this->MappedFile = vtkMemoryMappedFile::New();
+    if (!this->MappedFile->Open(this->FileName))
+      {
+      vtkWarningMacro("Cannot map file " << this->FileName
+                      << ", reading appended data instead.");
+      this->MemoryMapAppendedData = 0;
+      this->MappedFile->Delete();
+      this->MappedFile = 0;
+      return 0;
+      }
+    }
+  if (position < 0 ||
+      static_cast<vtkTypeUInt64>(position) + size > this->MappedFile->GetSize())
+    {
+    return 0;
+    }
+  unsigned char* data = this->MappedFile->GetData() + position;
+  if (reinterpret_cast<size_t>(data) % wordSize != 0)
+    {
+    return 0;
+    }
+
+  // Swap the values in place.  These are no-ops when the byte order of
+  // the file matches the host.
+  int byteOrder = this->XMLParser->GetByteOrder();
+  size_t num = static_cast<size_t>(numValues);
+  switch (wordSize)
+    {
+    case 2:
+      if (byteOrder == vtkXMLDataParser::BigEndian)
+        {
+        vtkByteSwap::Swap2BERange(data, num);
+        }
+      else
+        {
+        vtkByteSwap::Swap2LERange(data, num);
+        }
+      break;
+    case 4:
+      if (byteOrder == vtkXMLDataParser::BigEndian)
+        {
+        vtkByteSwap::Swap4BERange(data, num);
+        }
+      else
+        {
+        vtkByteSwap::Swap4LERange(data, num);
+        }
+      break;
+    case 8:
+      if (byteOrder == vtkXMLDataParser::BigEndian)
+        {
+        vtkByteSwap::Swap8BERange(data, num);
+        }
+      else
+        {
+        vtkByteSwap::Swap8LERange(data, num);
+        }
+      break;
+    default:
+      break;
+    }
+
+  // The array keeps a reference to the mapping in its information.
+  dataArray->SetVoidArray(data, numValues, 1);
+  dataArray->GetInformation()->Set(vtkMemoryMappedFile::MAPPED_FILE(),
+                                   this->MappedFile);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 char** vtkXMLReader::CreateStringArray(int numStrings)
 {
@@ -35,6 +35,7 @@ class vtkXMLDataElement;
 class vtkXMLDataParser;
 class vtkInformationVector;
 class vtkInformation;
+class vtkMemoryMappedFile;
 
 class VTKIOXML_EXPORT vtkXMLReader : public vtkAlgorithm
 {
@@ -54,6 +55,17 @@ public:
   vtkBooleanMacro(ReadFromInputString,int);
   void SetInputString(std::string s) { this->InputString = s; }
 
+  // Description:
+  // Enable memory mapping of the appended data section.  When the
+  // appended data are stored raw and uncompressed, whole arrays are
+  // exposed directly from a private mapping of the file instead of being
+  // copied, and are byte swapped in place only when the byte order of
+  // the file differs from the host.  The mapping stays alive as long as
+  // arrays use it.  Other arrays are read as usual.  Default is 0.
+  vtkSetMacro(MemoryMapAppendedData,int);
+  vtkGetMacro(MemoryMapAppendedData,int);
+  vtkBooleanMacro(MemoryMapAppendedData,int);
+
   // Description:
   // Test whether the file with the given name can be read by this
   // reader.
@@ -195,6 +207,15 @@ protected:
   void ReadAttributeIndices(vtkXMLDataElement* eDSA,
                             vtkDataSetAttributes* dsa);
   char** CreateStringArray(int numStrings);
+
+  // Description:
+  // Expose the values of an array from the memory mapped file instead of
+  // reading them.  Only whole arrays stored raw and uncompressed in the
+  // appended data section can be mapped.  Returns 0 if the array must be
+  // read instead.
+  int MapArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
+                     vtkAbstractArray* array, vtkIdType startIndex,
+                     vtkIdType numValues);
   void DestroyStringArray(int numStrings, char** strings);
 
   // Setup the data array selections for the input's set of arrays.
@@ -233,6 +254,11 @@ protected:
   // The input string.
   std::string InputString;
 
+  // Whether to memory map the appended data section, and the mapping of
+  // the input file used by the current execution.
+  int MemoryMapAppendedData;
+  vtkMemoryMappedFile* MappedFile;
+
   // The array selections.
   vtkDataArraySelection* PointDataArraySelection;
   vtkDataArraySelection* CellDataArraySelection;
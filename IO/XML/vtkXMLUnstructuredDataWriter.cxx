@@ -114,7 +114,7 @@ int vtkXMLUnstructuredDataWriter::ProcessRequest(vtkInformation* request,
     {
     this->SetErrorCode(vtkErrorCode::NoError);
 
-    if(!this->Stream && !this->FileName)
+    if(!this->Stream && !this->FileName && !this->WriteToOutputString)
       {
       this->SetErrorCode(vtkErrorCode::NoFileNameError);
       vtkErrorMacro("The FileName or Stream must be set first.");
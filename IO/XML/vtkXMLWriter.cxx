@@ -28,10 +28,12 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZLibDataCompressor.h"
+#include "vtkZstdDataCompressor.h"
 #define vtkXMLOffsetsManager_DoNotInclude
 #include "vtkXMLOffsetsManager.h"
 #undef  vtkXMLOffsetsManager_DoNotInclude
@@ -47,6 +49,7 @@
 
 #include <cassert>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 # include <unistd.h> /* unlink */
@@ -284,6 +287,59 @@ static int vtkXMLWriterWriteBinaryDataBlocks(
   return result;
 }
 //*****************************************************************************
+// The blocks of a compressed array that are waiting to be compressed
+// and written.  The uncompressed blocks are stored one after another,
+// and each block has a fixed slot in the compressed data buffer.
+class vtkXMLWriterCompressionBatch
+{
+public:
+  std::vector<unsigned char> Data;
+  std::vector<size_t> Offsets;
+  std::vector<unsigned char> CompressedData;
+  std::vector<size_t> CompressedSizes;
+  size_t CompressionSpace;
+
+  vtkXMLWriterCompressionBatch() : CompressionSpace(0) {}
+
+  size_t GetNumberOfBlocks() { return this->CompressedSizes.size(); }
+
+  void Clear()
+    {
+    this->Data.clear();
+    this->Offsets.clear();
+    this->CompressedSizes.clear();
+    }
+};
+
+//----------------------------------------------------------------------------
+// Compress a range of blocks of a batch, each into its own slot.
+class vtkXMLWriterCompressFunctor
+{
+public:
+  vtkXMLWriterCompressFunctor(vtkDataCompressor* compressor,
+                              vtkXMLWriterCompressionBatch* batch)
+    : Compressor(compressor), Batch(batch) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    vtkXMLWriterCompressionBatch* batch = this->Batch;
+    size_t space = batch->CompressionSpace;
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      size_t offset = batch->Offsets[i];
+      size_t size = (static_cast<size_t>(i+1) < batch->Offsets.size() ?
+                     batch->Offsets[i+1] : batch->Data.size()) - offset;
+      batch->CompressedSizes[i] =
+        this->Compressor->Compress(&batch->Data[offset], size,
+                                   &batch->CompressedData[i*space], space);
+      }
+    }
+
+private:
+  vtkDataCompressor* Compressor;
+  vtkXMLWriterCompressionBatch* Batch;
+};
+//*****************************************************************************
 
 vtkCxxSetObjectMacro(vtkXMLWriter, Compressor, vtkDataCompressor);
 //----------------------------------------------------------------------------
@@ -315,6 +371,8 @@ vtkXMLWriter::vtkXMLWriter()
   this->BlockSize = 32768; //2^15
   this->Compressor = vtkZLibDataCompressor::New();
   this->CompressionHeader = 0;
+  this->BlocksPerCompressionBatch = 64;
+  this->CompressionBatch = new vtkXMLWriterCompressionBatch;
   this->Int32IdTypeBuffer = 0;
   this->ByteSwapBuffer = 0;
 
@@ -360,6 +418,7 @@ vtkXMLWriter::~vtkXMLWriter()
 
   delete this->FieldDataOM;
   delete[] this->NumberOfTimeValues;
+  delete this->CompressionBatch;
 }
 
 //----------------------------------------------------------------------------
@@ -378,7 +437,11 @@ void vtkXMLWriter::SetCompressorType(int compressorType)
 
   if (compressorType == ZLIB)
     {
-    if (this->Compressor && !this->Compressor->IsTypeOf("vtkZLibDataCompressor"))
+    if (this->Compressor && this->Compressor->IsTypeOf("vtkZLibDataCompressor"))
+      {
+      return;
+      }
+    if (this->Compressor)
       {
       this->Compressor->Delete();
       }
@@ -387,6 +450,22 @@ void vtkXMLWriter::SetCompressorType(int compressorType)
     this->Modified();
     return;
     }
+
+  if (compressorType == ZSTD)
+    {
+    if (this->Compressor && this->Compressor->IsTypeOf("vtkZstdDataCompressor"))
+      {
+      return;
+      }
+    if (this->Compressor)
+      {
+      this->Compressor->Delete();
+      }
+
+    this->Compressor = vtkZstdDataCompressor::New();
+    this->Modified();
+    return;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -433,6 +512,8 @@ void vtkXMLWriter::PrintSelf(ostream& os, vtkIndent indent)
     }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "BlocksPerCompressionBatch: "
+     << this->BlocksPerCompressionBatch << "\n";
   if (this->Stream)
     {
     os << indent << "Stream: " << this->Stream << "\n";
@@ -1134,6 +1215,13 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
       }
 
+    // Compress and write the blocks still waiting in the batch.
+    if (result && !this->FlushCompressionBatch())
+      {
+      result = 0;
+      }
+    this->CompressionBatch->Clear();
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
       {
@@ -1457,6 +1545,22 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //----------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
+  // Queue the block to compress it concurrently with the next ones.
+  // The batch is flushed when full and at the end of the array.
+  if (this->BlocksPerCompressionBatch > 1)
+    {
+    vtkXMLWriterCompressionBatch* batch = this->CompressionBatch;
+    batch->Offsets.push_back(batch->Data.size());
+    batch->Data.insert(batch->Data.end(), data, data + size);
+    batch->CompressedSizes.push_back(0);
+    if (batch->GetNumberOfBlocks() <
+        static_cast<size_t>(this->BlocksPerCompressionBatch))
+      {
+      return 1;
+      }
+    return this->FlushCompressionBatch();
+    }
+
   // Compress the data.
   vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
 
@@ -1480,6 +1584,50 @@ int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
   return result;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBatch()
+{
+  vtkXMLWriterCompressionBatch* batch = this->CompressionBatch;
+  size_t numBlocks = batch->GetNumberOfBlocks();
+  if (numBlocks == 0)
+    {
+    return 1;
+    }
+
+  // Compress all the blocks.  No block is larger than BlockSize.
+  batch->CompressionSpace =
+    this->Compressor->GetMaximumCompressionSpace(this->BlockSize);
+  batch->CompressedData.resize(numBlocks*batch->CompressionSpace);
+  vtkXMLWriterCompressFunctor functor(this->Compressor, batch);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1, functor);
+
+  // Write the compressed blocks in order, exactly as they would be
+  // written one at a time.
+  int result = 1;
+  for (size_t i = 0; i < numBlocks && result; ++i)
+    {
+    size_t outputSize = batch->CompressedSizes[i];
+    if (outputSize == 0)
+      {
+      vtkErrorMacro("Error compressing block " << this->CompressionBlockNumber);
+      result = 0;
+      break;
+      }
+    result = this->DataStream->Write(
+      &batch->CompressedData[i*batch->CompressionSpace], outputSize);
+    this->CompressionHeader->Set(3+this->CompressionBlockNumber++, outputSize);
+    }
+  this->Stream->flush();
+  if (this->Stream->fail())
+    {
+    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    result = 0;
+    }
+
+  batch->Clear();
+  return result;
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionHeader()
 {
@@ -41,6 +41,7 @@ class vtkPointData;
 class vtkPoints;
 class vtkFieldData;
 class vtkXMLDataHeader;
+class vtkXMLWriterCompressionBatch;
 //BTX
 class vtkStdString;
 class OffsetsManager;      // one per piece/per time
@@ -129,12 +130,16 @@ public:
   enum CompressorType
     {
     NONE,
-    ZLIB
+    ZLIB,
+    ZSTD
     };
 //ETX
 
   // Description:
   // Convenience functions to set the compressor to certain known types.
+  // Zstd compresses several times faster than zlib; its compression
+  // level can be set on the vtkZstdDataCompressor given by
+  // GetCompressor().
   void SetCompressorType(int compressorType);
   void SetCompressorTypeToNone()
     {
@@ -144,6 +149,10 @@ public:
     {
     this->SetCompressorType(ZLIB);
     }
+  void SetCompressorTypeToZstd()
+    {
+    this->SetCompressorType(ZSTD);
+    }
 
   // Description:
   // Get/Set the block size used in compression.  When reading, this
@@ -153,6 +162,17 @@ public:
   virtual void SetBlockSize(size_t blockSize);
   vtkGetMacro(BlockSize, size_t);
 
+  // Description:
+  // Get/Set the number of blocks that are compressed concurrently with
+  // vtkSMPTools.  The blocks are compressed independently and written
+  // in order, so the file does not depend on this value.  At most this
+  // many blocks are held in memory, before and after compression.  A
+  // value of 1 compresses the blocks one at a time.  The compressor
+  // must support concurrent calls to Compress() unless this is 1.  The
+  // default is 64.
+  vtkSetClampMacro(BlocksPerCompressionBatch, int, 1, VTK_INT_MAX);
+  vtkGetMacro(BlocksPerCompressionBatch, int);
+
   // Description:
   // Get/Set the data mode used for the file's data.  The options are
   // vtkXMLWriter::Ascii, vtkXMLWriter::Binary, and
@@ -290,6 +310,10 @@ protected:
   size_t CompressionBlockNumber;
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
+  int BlocksPerCompressionBatch;
+
+  // The blocks waiting to be compressed.
+  vtkXMLWriterCompressionBatch* CompressionBatch;
 
   // The output stream used to write binary and appended data.  May
   // transparently encode the data.
@@ -422,6 +446,7 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int FlushCompressionBatch();
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
@@ -20,6 +20,7 @@
 #include "vtkDataCompressor.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
@@ -28,6 +29,8 @@
 #include <vtksys/auto_ptr.hxx>
 #include <vtksys/ios/sstream>
 
+#include <vector>
+
 #include "vtkXMLUtilities.h"
 
 
@@ -49,6 +52,7 @@ vtkXMLDataParser::vtkXMLDataParser()
 
   this->BlockCompressedSizes = 0;
   this->BlockStartOffsets = 0;
+  this->BlocksPerCompressionBatch = 64;
   this->Compressor = 0;
 
   this->AsciiDataBuffer = 0;
@@ -93,6 +97,8 @@ void vtkXMLDataParser::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "AppendedDataPosition: "
      << this->AppendedDataPosition << "\n";
+  os << indent << "BlocksPerCompressionBatch: "
+     << this->BlocksPerCompressionBatch << "\n";
   if(this->RootElement)
     {
     this->RootElement->PrintXML(os, indent);
@@ -588,6 +594,89 @@ unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
   return decompressBuffer;
 }
 
+//----------------------------------------------------------------------------
+// Uncompress a range of blocks that were read one after another.
+class vtkXMLDataParserUncompressFunctor
+{
+public:
+  vtkXMLDataParserUncompressFunctor(vtkDataCompressor* compressor,
+                                    const unsigned char* compressedData,
+                                    const vtkTypeInt64* compressedOffsets,
+                                    const size_t* compressedSizes,
+                                    unsigned char* data,
+                                    size_t blockSize,
+                                    std::vector<size_t>* results)
+    : Compressor(compressor), CompressedData(compressedData),
+      CompressedOffsets(compressedOffsets), CompressedSizes(compressedSizes),
+      Data(data), BlockSize(blockSize), Results(results) {}
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for(vtkIdType i = begin; i < end; ++i)
+      {
+      (*this->Results)[i] = this->Compressor->Uncompress(
+        this->CompressedData + (this->CompressedOffsets[i] -
+                                this->CompressedOffsets[0]),
+        this->CompressedSizes[i], this->Data + i*this->BlockSize,
+        this->BlockSize);
+      }
+    }
+
+private:
+  vtkDataCompressor* Compressor;
+  const unsigned char* CompressedData;
+  const vtkTypeInt64* CompressedOffsets;
+  const size_t* CompressedSizes;
+  unsigned char* Data;
+  size_t BlockSize;
+  std::vector<size_t>* Results;
+};
+
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::ReadBlocks(vtkTypeUInt64 firstBlock,
+                                 vtkTypeUInt64 endBlock,
+                                 unsigned char* buffer)
+{
+  // All the blocks are complete blocks, stored one after another, so
+  // they are read at once and then uncompressed concurrently.
+  size_t numBlocks = static_cast<size_t>(endBlock - firstBlock);
+  vtkTypeInt64 compressedSize = 0;
+  for(size_t i = 0; i < numBlocks; ++i)
+    {
+    compressedSize += this->BlockCompressedSizes[firstBlock+i];
+    }
+
+  if(!this->DataStream->Seek(this->BlockStartOffsets[firstBlock]))
+    {
+    return 0;
+    }
+
+  std::vector<unsigned char> readBuffer(compressedSize);
+  if(compressedSize > 0 &&
+     this->DataStream->Read(&readBuffer[0], compressedSize) <
+     static_cast<size_t>(compressedSize))
+    {
+    return 0;
+    }
+
+  std::vector<size_t> results(numBlocks, 0);
+  vtkXMLDataParserUncompressFunctor functor(
+    this->Compressor, compressedSize > 0 ? &readBuffer[0] : 0,
+    this->BlockStartOffsets + firstBlock,
+    this->BlockCompressedSizes + firstBlock,
+    buffer, this->BlockUncompressedSize, &results);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1, functor);
+
+  for(size_t i = 0; i < numBlocks; ++i)
+    {
+    if(results[i] == 0)
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadUncompressedData(unsigned char* data,
                                               vtkTypeUInt64 startWord,
@@ -762,18 +851,32 @@ size_t vtkXMLDataParser::ReadCompressedData(unsigned char* data,
     // Report progress.
     this->UpdateProgress(float(outputPointer-data)/length);
 
-    unsigned int currentBlock = firstBlock+1;
-    for(;currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the complete blocks in between in batches that are
+    // uncompressed concurrently.
+    vtkTypeUInt64 currentBlock = firstBlock+1;
+    vtkTypeUInt64 batchSize = this->BlocksPerCompressionBatch;
+    while(currentBlock < lastBlock && !this->Abort)
       {
-      // Read this block.
-      if(!this->ReadBlock(currentBlock, outputPointer)) { return 0; }
+      vtkTypeUInt64 endBlock = currentBlock + batchSize;
+      if(endBlock > lastBlock)
+        {
+        endBlock = lastBlock;
+        }
+
+      // Read this batch of blocks.
+      if(!this->ReadBlocks(currentBlock, endBlock, outputPointer))
+        {
+        return 0;
+        }
 
-      // Byte swap this block.  Note that blockSize will always be an
+      // Byte swap these blocks.  Note that blockSize will always be an
       // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
+      size_t n = static_cast<size_t>(endBlock - currentBlock)*blockSize;
+      this->PerformByteSwap(outputPointer, n / wordSize, wordSize);
 
-      // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      // Advance the pointer to the beginning of the next batch.
+      outputPointer += n;
+      currentBlock = endBlock;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer-data)/length);
@@ -922,6 +1025,40 @@ size_t vtkXMLDataParser::ReadAppendedData(vtkTypeInt64 offset,
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::FindRawAppendedData(vtkTypeInt64 offset,
+                                          vtkTypeInt64& position,
+                                          vtkTypeUInt64& size)
+{
+  // The data must be neither base64 encoded nor compressed.
+  if(this->Compressor || this->AppendedDataStream->IsA("vtkBase64InputStream"))
+    {
+    return 0;
+    }
+
+  // Read the header giving the length of the data.
+  this->DataStream = this->AppendedDataStream;
+  this->SeekG(this->AppendedDataPosition+offset);
+  this->DataStream->SetStream(this->Stream);
+  vtksys::auto_ptr<vtkXMLDataHeader>
+    uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  this->DataStream->StartReading();
+  size_t r = this->DataStream->Read(uh->Data(), headerSize);
+  this->DataStream->EndReading();
+  if(r < headerSize)
+    {
+    vtkErrorMacro("Error reading uncompressed binary data header.  "
+                  "Read " << r << " of " << headerSize << " bytes.");
+    return 0;
+    }
+  this->PerformByteSwap(uh->Data(), uh->WordCount(), uh->WordSize());
+
+  position = this->AppendedDataPosition + offset + headerSize;
+  size = uh->Get(0);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
@@ -73,6 +73,15 @@ public:
   { return this->ReadAppendedData(offset, buffer, startWord, numWords,
                                     VTK_CHAR); }
 
+  // Description:
+  // Find the data of an array stored raw and uncompressed in the
+  // appended data section, starting at the given appended data offset.
+  // The position of the data in the stream, after the header, and their
+  // size in bytes are returned.  Returns 0 if the appended data are
+  // encoded or compressed.
+  int FindRawAppendedData(vtkTypeInt64 offset, vtkTypeInt64& position,
+                          vtkTypeUInt64& size);
+
   // Description:
   // Read from an ascii data section starting at the current position in
   // the stream.  Returns the number of words read.
@@ -92,10 +101,24 @@ public:
   virtual void SetCompressor(vtkDataCompressor*);
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
 
+  // Description:
+  // Get/Set the number of compressed blocks that are read together and
+  // decompressed concurrently with vtkSMPTools.  This bounds the extra
+  // memory used for the compressed data.  A value of 1 decompresses the
+  // blocks one at a time.  The compressor must support concurrent calls
+  // to Uncompress() unless this is 1.  The default is 64.
+  vtkSetClampMacro(BlocksPerCompressionBatch, int, 1, VTK_INT_MAX);
+  vtkGetMacro(BlocksPerCompressionBatch, int);
+
   // Description:
   // Get the size of a word of the given type.
   size_t GetWordTypeSize(int wordType);
 
+  // Description:
+  // Get the byte order of the binary input, BigEndian or LittleEndian.
+  // Valid after the XML is parsed.
+  vtkGetMacro(ByteOrder, int);
+
   // Description:
   // Parse the XML input and check that the file is safe to read.
   // Returns 1 for okay, 0 for error.
@@ -166,6 +189,8 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadBlocks(vtkTypeUInt64 firstBlock, vtkTypeUInt64 endBlock,
+                 unsigned char* buffer);
   size_t ReadUncompressedData(unsigned char* data,
                               vtkTypeUInt64 startWord,
                               size_t numWords,
@@ -223,6 +248,7 @@ protected:
   size_t PartialLastBlockUncompressedSize;
   size_t* BlockCompressedSizes;
   vtkTypeInt64* BlockStartOffsets;
+  int BlocksPerCompressionBatch;
 
   // Ascii data parsing.
   unsigned char* AsciiDataBuffer;
@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    ImageHistogramSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the filters that keep per-thread results, vtkImageHistogram
+// and vtkImageDifference, give the same results when SMP is enabled for
+// imaging filters, even though the image is split into many more pieces
+// than there are threads.
+
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkImageDifference.h"
+#include "vtkImageHistogram.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+
+#include <vector>
+
+static vtkSmartPointer<vtkImageHistogram> ComputeHistogram(
+  vtkImageData *image, bool smp)
+{
+  vtkSmartPointer<vtkImageHistogram> histogram =
+    vtkSmartPointer<vtkImageHistogram>::New();
+  histogram->SetInputData(image);
+  histogram->SetEnableSMP(smp);
+  histogram->SetNumberOfBins(1000);
+  histogram->GenerateHistogramImageOff();
+  histogram->Update();
+  return histogram;
+}
+
+static void ComputeDifference(
+  vtkImageData *image1, vtkImageData *image2, bool smp, double error[2])
+{
+  vtkNew<vtkImageDifference> difference;
+  difference->SetInputData(image1);
+  difference->SetImageData(image2);
+  difference->SetEnableSMP(smp);
+  difference->Update();
+  error[0] = difference->GetError();
+  error[1] = difference->GetThresholdedError();
+}
+
+int ImageHistogramSMP(int, char *[])
+{
+  bool retVal = true;
+
+  // a 4MB image gives about 60 pieces with the default piece size
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 255, 0, 255, 0, 31);
+  image->AllocateScalars(VTK_UNSIGNED_SHORT, 1);
+  unsigned short *ptr =
+    static_cast<unsigned short *>(image->GetScalarPointer());
+  vtkIdType n = image->GetNumberOfPoints();
+  std::vector<vtkIdType> expected(1000, 0);
+  for (vtkIdType i = 0; i < n; i++)
+    {
+    ptr[i] = static_cast<unsigned short>((i*i + 7*i) % 997);
+    expected[ptr[i]]++;
+    }
+
+  vtkThreadedImageAlgorithm::SetGlobalDefaultEnableSMP(true);
+
+  vtkSmartPointer<vtkImageHistogram> serial =
+    ComputeHistogram(image.GetPointer(), false);
+  vtkSmartPointer<vtkImageHistogram> smp =
+    ComputeHistogram(image.GetPointer(), true);
+
+  vtkIdTypeArray *h1 = serial->GetHistogram();
+  vtkIdTypeArray *h2 = smp->GetHistogram();
+  if (serial->GetTotal() != n || smp->GetTotal() != n)
+    {
+    cerr << "Histogram total is " << serial->GetTotal() << " without SMP and "
+         << smp->GetTotal() << " with SMP, should be " << n << "\n";
+    retVal = false;
+    }
+  for (vtkIdType i = 0; i < 1000 && retVal; i++)
+    {
+    if (h1->GetValue(i) != expected[i] || h2->GetValue(i) != expected[i])
+      {
+      cerr << "Histogram bin " << i << " is " << h1->GetValue(i)
+           << " without SMP and " << h2->GetValue(i) << " with SMP, should be "
+           << expected[i] << "\n";
+      retVal = false;
+      }
+    }
+
+  // two color images that differ in a few places
+  vtkNew<vtkImageData> image1;
+  vtkNew<vtkImageData> image2;
+  image1->SetExtent(0, 511, 0, 511, 0, 0);
+  image2->SetExtent(0, 511, 0, 511, 0, 0);
+  image1->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
+  image2->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
+  unsigned char *ptr1 =
+    static_cast<unsigned char *>(image1->GetScalarPointer());
+  unsigned char *ptr2 =
+    static_cast<unsigned char *>(image2->GetScalarPointer());
+  n = 3*image1->GetNumberOfPoints();
+  for (vtkIdType i = 0; i < n; i++)
+    {
+    ptr1[i] = static_cast<unsigned char>(i % 251);
+    ptr2[i] = ptr1[i];
+    if ((i/3) % 1009 == 0)
+      {
+      ptr2[i] = static_cast<unsigned char>(255 - ptr1[i]);
+      }
+    }
+
+  double error1[2];
+  double error2[2];
+  ComputeDifference(image1.GetPointer(), image2.GetPointer(), false, error1);
+  ComputeDifference(image1.GetPointer(), image2.GetPointer(), true, error2);
+  if (error1[0] <= 0 || error1[0] != error2[0] || error1[1] != error2[1])
+    {
+    cerr << "Image difference is " << error1[0] << " " << error1[1]
+         << " without SMP and " << error2[0] << " " << error2[1]
+         << " with SMP\n";
+    retVal = false;
+    }
+
+  vtkThreadedImageAlgorithm::SetGlobalDefaultEnableSMP(false);
+
+  return !retVal;
+}
@@ -0,0 +1,128 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageInterpolateLine.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that interpolating a line of samples gives exactly the same
+// values as interpolating the samples one at a time.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageInterpolator.h"
+#include "vtkImageSincInterpolator.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <vector>
+
+template<class F>
+static int CompareLineToPoints(vtkAbstractImageInterpolator *interpolator,
+                               const F origin[3], const F delta[3],
+                               int idX, int n)
+{
+  int numComponents = interpolator->GetNumberOfComponents();
+  std::vector<F> line(n*numComponents);
+  std::vector<F> point(numComponents);
+
+  interpolator->InterpolateLineIJK(origin, delta, idX, n, &line[0]);
+
+  for (int i = 0; i < n; i++)
+    {
+    F x[3];
+    x[0] = origin[0] + (idX + i)*delta[0];
+    x[1] = origin[1] + (idX + i)*delta[1];
+    x[2] = origin[2] + (idX + i)*delta[2];
+    interpolator->InterpolateIJK(x, &point[0]);
+    for (int c = 0; c < numComponents; c++)
+      {
+      if (line[i*numComponents + c] != point[c])
+        {
+        cerr << interpolator->GetClassName() << " differs at sample " << i
+             << " component " << c << ": " << line[i*numComponents + c]
+             << " != " << point[c] << "\n";
+        return 1;
+        }
+      }
+    }
+
+  return 0;
+}
+
+int TestImageInterpolateLine(int, char *[])
+{
+  int scalarTypes[3] = { VTK_UNSIGNED_CHAR, VTK_SHORT, VTK_FLOAT };
+  int borderModes[3] = { VTK_IMAGE_BORDER_CLAMP, VTK_IMAGE_BORDER_REPEAT,
+                         VTK_IMAGE_BORDER_MIRROR };
+
+  vtkMath::RandomSeed(1234);
+
+  int errors = 0;
+  for (int t = 0; t < 3; t++)
+    {
+    for (int numComponents = 1; numComponents <= 3; numComponents += 2)
+      {
+      vtkNew<vtkImageData> image;
+      image->SetExtent(0, 31, 0, 23, 0, 15);
+      image->AllocateScalars(scalarTypes[t], numComponents);
+      vtkDataArray *scalars = image->GetPointData()->GetScalars();
+      vtkIdType n = scalars->GetNumberOfTuples()*numComponents;
+      for (vtkIdType i = 0; i < n; i++)
+        {
+        scalars->SetComponent(i/numComponents, i%numComponents,
+                              vtkMath::Random(0.0, 100.0));
+        }
+
+      // an oblique line that crosses the whole volume, and a line that
+      // runs out of the volume to exercise the border modes
+      double origin[2][3] = { { 0.3, 1.7, 2.1 }, { -0.4, 22.9, 14.6 } };
+      double delta[2][3] = { { 0.61, 0.29, 0.17 }, { 0.35, 0.01, 0.002 } };
+
+      for (int b = 0; b < 3; b++)
+        {
+        for (int mode = VTK_NEAREST_INTERPOLATION;
+             mode <= VTK_CUBIC_INTERPOLATION; mode++)
+          {
+          vtkNew<vtkImageInterpolator> interpolator;
+          interpolator->SetInterpolationMode(mode);
+          interpolator->SetBorderMode(borderModes[b]);
+          interpolator->Initialize(image.GetPointer());
+          interpolator->Update();
+
+          for (int l = 0; l < 2; l++)
+            {
+            float forigin[3], fdelta[3];
+            for (int k = 0; k < 3; k++)
+              {
+              forigin[k] = static_cast<float>(origin[l][k]);
+              fdelta[k] = static_cast<float>(delta[l][k]);
+              }
+            errors += CompareLineToPoints(interpolator.GetPointer(),
+                                          origin[l], delta[l], 0, 50);
+            errors += CompareLineToPoints(interpolator.GetPointer(),
+                                          forigin, fdelta, 3, 97);
+            }
+          }
+
+        // interpolators without line kernels use the point function
+        vtkNew<vtkImageSincInterpolator> sinc;
+        sinc->SetBorderMode(borderModes[b]);
+        sinc->Initialize(image.GetPointer());
+        sinc->Update();
+        errors += CompareLineToPoints(sinc.GetPointer(),
+                                      origin[0], delta[0], 2, 30);
+        }
+      }
+    }
+
+  return (errors != 0);
+}
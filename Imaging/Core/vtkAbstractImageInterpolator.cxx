@@ -89,6 +89,8 @@ vtkAbstractImageInterpolator::vtkAbstractImageInterpolator()
     &(vtkInterpolateNOP<double>::RowInterpolationFunc);
   this->RowInterpolationFuncFloat =
     &(vtkInterpolateNOP<float>::RowInterpolationFunc);
+  this->LineInterpolationFuncDouble = NULL;
+  this->LineInterpolationFuncFloat = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -302,6 +304,8 @@ void vtkAbstractImageInterpolator::Update()
       &(vtkInterpolateNOP<double>::RowInterpolationFunc);
     this->RowInterpolationFuncFloat =
       &(vtkInterpolateNOP<float>::RowInterpolationFunc);
+    this->LineInterpolationFuncDouble = NULL;
+    this->LineInterpolationFuncFloat = NULL;
 
     return;
     }
@@ -379,6 +383,58 @@ void vtkAbstractImageInterpolator::Update()
   this->GetInterpolationFunc(&this->InterpolationFuncFloat);
   this->GetRowInterpolationFunc(&this->RowInterpolationFuncDouble);
   this->GetRowInterpolationFunc(&this->RowInterpolationFuncFloat);
+  this->LineInterpolationFuncDouble = NULL;
+  this->LineInterpolationFuncFloat = NULL;
+  this->GetLineInterpolationFunc(&this->LineInterpolationFuncDouble);
+  this->GetLineInterpolationFunc(&this->LineInterpolationFuncFloat);
+}
+
+//----------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::InterpolateLineIJK(
+  const double origin[3], const double delta[3], int idX, int n,
+  double *value)
+{
+  if (this->LineInterpolationFuncDouble)
+    {
+    this->LineInterpolationFuncDouble(
+      this->InterpolationInfo, origin, delta, idX, n, value);
+    return;
+    }
+
+  int numscalars = this->InterpolationInfo->NumberOfComponents;
+  for (int i = idX; i < idX + n; i++)
+    {
+    double point[3];
+    point[0] = origin[0] + i*delta[0];
+    point[1] = origin[1] + i*delta[1];
+    point[2] = origin[2] + i*delta[2];
+    this->InterpolationFuncDouble(this->InterpolationInfo, point, value);
+    value += numscalars;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::InterpolateLineIJK(
+  const float origin[3], const float delta[3], int idX, int n,
+  float *value)
+{
+  if (this->LineInterpolationFuncFloat)
+    {
+    this->LineInterpolationFuncFloat(
+      this->InterpolationInfo, origin, delta, idX, n, value);
+    return;
+    }
+
+  int numscalars = this->InterpolationInfo->NumberOfComponents;
+  for (int i = idX; i < idX + n; i++)
+    {
+    float point[3];
+    point[0] = origin[0] + i*delta[0];
+    point[1] = origin[1] + i*delta[1];
+    point[2] = origin[2] + i*delta[2];
+    this->InterpolationFuncFloat(this->InterpolationInfo, point, value);
+    value += numscalars;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -463,6 +519,20 @@ void vtkAbstractImageInterpolator::GetRowInterpolationFunc(
 {
 }
 
+//----------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::GetLineInterpolationFunc(
+  void (**)(vtkInterpolationInfo *, const double [3], const double [3],
+            int, int, double *))
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::GetLineInterpolationFunc(
+  void (**)(vtkInterpolationInfo *, const float [3], const float [3],
+            int, int, float *))
+{
+}
+
 //----------------------------------------------------------------------------
 void vtkAbstractImageInterpolator::PrecomputeWeightsForExtent(
   const double [16], const int [6], int [6], vtkInterpolationWeights *&)
@@ -128,6 +128,18 @@ public:
   void InterpolateIJK(const double point[3], double *value);
   void InterpolateIJK(const float point[3], float *value);
 
+  // Description:
+  // Interpolate n samples along a line in structured coords.  The samples
+  // are located at origin + i*delta for i = idX, idX + 1, ..., idX + n - 1
+  // and their components are stored consecutively in value.  All of the
+  // samples must be within the bounds, see CheckBoundsIJK.  This gives
+  // the same result as calling InterpolateIJK for each sample, but is
+  // much faster for interpolators that provide row kernels.
+  void InterpolateLineIJK(const double origin[3], const double delta[3],
+                          int idX, int n, double *value);
+  void InterpolateLineIJK(const float origin[3], const float delta[3],
+                          int idX, int n, float *value);
+
   // Description:
   // Check an x,y,z point to see if it is within the bounds for the
   // structured coords of the image.  This is meant to be called prior
@@ -245,6 +257,18 @@ protected:
     void (**floatfunc)(
       vtkInterpolationWeights *, int, int, int, float *, int));
 
+  // Description:
+  // Get the line interpolation functions.  If a subclass does not
+  // provide them, lines are interpolated one sample at a time.
+  virtual void GetLineInterpolationFunc(
+    void (**doublefunc)(
+      vtkInterpolationInfo *, const double [3], const double [3],
+      int, int, double *));
+  virtual void GetLineInterpolationFunc(
+    void (**floatfunc)(
+      vtkInterpolationInfo *, const float [3], const float [3],
+      int, int, float *));
+
   vtkDataArray *Scalars;
   double StructuredBoundsDouble[6];
   float StructuredBoundsFloat[6];
@@ -272,6 +296,12 @@ protected:
   void (*RowInterpolationFuncFloat)(
     vtkInterpolationWeights *weights, int idX, int idY, int idZ,
     float *outPtr, int n);
+  void (*LineInterpolationFuncDouble)(
+    vtkInterpolationInfo *info, const double origin[3],
+    const double delta[3], int idX, int n, double *outPtr);
+  void (*LineInterpolationFuncFloat)(
+    vtkInterpolationInfo *info, const float origin[3],
+    const float delta[3], int idX, int n, float *outPtr);
 
 private:
 
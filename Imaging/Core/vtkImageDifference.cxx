@@ -35,6 +35,9 @@ vtkImageDifference::vtkImageDifference()
   this->AllowShift = 1;
   this->Averaging = 1;
   this->SetNumberOfInputPorts(2);
+
+  // the errors are kept per thread, so the pieces cannot be run with SMP
+  this->SMPSupported = false;
 }
 
 
@@ -2083,6 +2083,13 @@ void vtkImageResliceExecute(vtkImageReslice *self,
     optimizeNearest = 1;
     }
 
+  // for affine transformations, each row can be interpolated at once
+  bool optimizeLine = 0;
+  if (!optimizeNearest && !(newtrans || perspective) && nsamples <= 1)
+    {
+    optimizeLine = 1;
+    }
+
   // get Increments to march through data
   vtkIdType outIncX, outIncY, outIncZ;
   outData->GetContinuousIncrements(outExt, outIncX, outIncY, outIncZ);
@@ -2170,7 +2177,73 @@ void vtkImageResliceExecute(vtkImageReslice *self,
                                      outPtr, background, outComponents,
                                      setpixels, iter))
         {
-        if (!optimizeNearest)
+        if (optimizeLine)
+          {
+          int startIdX = idXmin;
+          while (startIdX <= idXmax)
+            {
+            // find the span of pixels that are all in or all out of bounds
+            F inPoint[3];
+            inPoint[0] = inPoint1[0] + startIdX*xAxis[0];
+            inPoint[1] = inPoint1[1] + startIdX*xAxis[1];
+            inPoint[2] = inPoint1[2] + startIdX*xAxis[2];
+            bool isInBounds = interpolator->CheckBoundsIJK(inPoint);
+
+            int idX = startIdX + 1;
+            for (; idX <= idXmax; idX++)
+              {
+              inPoint[0] = inPoint1[0] + idX*xAxis[0];
+              inPoint[1] = inPoint1[1] + idX*xAxis[1];
+              inPoint[2] = inPoint1[2] + idX*xAxis[2];
+              if (interpolator->CheckBoundsIJK(inPoint) != isInBounds)
+                {
+                break;
+                }
+              }
+            int numpixels = idX - startIdX;
+
+            if (isInBounds)
+              {
+              if (outputStencil)
+                {
+                outputStencil->InsertNextExtent(startIdX, idX - 1, idY, idZ);
+                }
+
+              // interpolate the whole span at once
+              interpolator->InterpolateLineIJK(
+                inPoint1, xAxis, startIdX, numpixels, floatPtr);
+
+              if (rescaleScalars)
+                {
+                vtkImageResliceRescaleScalars(floatPtr, inComponents,
+                                              numpixels,
+                                              scalarShift, scalarScale);
+                }
+
+              if (convertScalars)
+                {
+                (self->*convertScalars)(floatPtr, outPtr,
+                                        vtkTypeTraits<F>::VTKTypeID(),
+                                        inComponents, numpixels,
+                                        startIdX, idY, idZ, threadId);
+
+                outPtr = static_cast<void *>(static_cast<char *>(outPtr)
+                           + numpixels*outComponents*scalarSize);
+                }
+              else
+                {
+                convertpixels(outPtr, floatPtr, outComponents, numpixels);
+                }
+              }
+            else
+              {
+              setpixels(outPtr, background, outComponents, numpixels);
+              }
+
+            startIdX = idX;
+            }
+          }
+        else if (!optimizeNearest)
           {
           bool wasInBounds = 1;
           bool isInBounds = 1;
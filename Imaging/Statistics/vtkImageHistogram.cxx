@@ -57,6 +57,9 @@ vtkImageHistogram::vtkImageHistogram()
 
   this->SetNumberOfInputPorts(2);
   this->SetNumberOfOutputPorts(1);
+
+  // the partial histograms are kept per thread, so use vtkMultiThreader
+  this->SMPSupported = false;
 }
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,400 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataObjectMarshaling.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that data sets and composite data sets marshaled by
+// vtkCommunicator are unmarshaled with the same structure, arrays and
+// attributes, and that objects the binary format does not cover still
+// go through the legacy format.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCharArray.h"
+#include "vtkCommunicator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkStructuredGrid.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <string.h>
+
+static bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b)
+    {
+    return (a == b);
+    }
+  vtkIdType n = a->GetNumberOfTuples()*a->GetNumberOfComponents();
+  return (a->GetDataType() == b->GetDataType() &&
+          a->GetNumberOfComponents() == b->GetNumberOfComponents() &&
+          b->GetNumberOfTuples()*b->GetNumberOfComponents() == n &&
+          (a->GetName() ? (b->GetName() &&
+                           strcmp(a->GetName(), b->GetName()) == 0) :
+                          !b->GetName()) &&
+          (n == 0 || memcmp(a->GetVoidPointer(0), b->GetVoidPointer(0),
+                            n*a->GetDataTypeSize()) == 0));
+}
+
+static bool SameFieldData(vtkFieldData* a, vtkFieldData* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+    {
+    return false;
+    }
+  for (int i = 0; i < a->GetNumberOfArrays(); i++)
+    {
+    if (!SameArrays(a->GetArray(i), b->GetArray(i)))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+static bool SameAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  int indicesA[vtkDataSetAttributes::NUM_ATTRIBUTES];
+  int indicesB[vtkDataSetAttributes::NUM_ATTRIBUTES];
+  a->GetAttributeIndices(indicesA);
+  b->GetAttributeIndices(indicesB);
+  return (SameFieldData(a, b) &&
+          memcmp(indicesA, indicesB, sizeof(indicesA)) == 0);
+}
+
+static bool SameCells(vtkCellArray* a, vtkCellArray* b)
+{
+  return (a->GetNumberOfCells() == b->GetNumberOfCells() &&
+          SameArrays(a->GetData(), b->GetData()));
+}
+
+static bool SameDataObjects(vtkDataObject* a, vtkDataObject* b)
+{
+  if (!a || !b)
+    {
+    return (a == b);
+    }
+  if (a->GetDataObjectType() != b->GetDataObjectType())
+    {
+    return false;
+    }
+
+  vtkMultiBlockDataSet* mbA = vtkMultiBlockDataSet::SafeDownCast(a);
+  vtkMultiPieceDataSet* mpA = vtkMultiPieceDataSet::SafeDownCast(a);
+  if (mbA || mpA)
+    {
+    vtkMultiBlockDataSet* mbB = vtkMultiBlockDataSet::SafeDownCast(b);
+    vtkMultiPieceDataSet* mpB = vtkMultiPieceDataSet::SafeDownCast(b);
+    unsigned int n = mbA ? mbA->GetNumberOfBlocks() : mpA->GetNumberOfPieces();
+    if (n != (mbB ? mbB->GetNumberOfBlocks() : mpB->GetNumberOfPieces()))
+      {
+      return false;
+      }
+    for (unsigned int i = 0; i < n; i++)
+      {
+      bool hasName = (mbA ? mbA->HasMetaData(i) : mpA->HasMetaData(i)) &&
+        (mbA ? mbA->GetMetaData(i) : mpA->GetMetaData(i))->Has(
+          vtkCompositeDataSet::NAME());
+      if (hasName &&
+          strcmp((mbA ? mbA->GetMetaData(i) : mpA->GetMetaData(i))->Get(
+                   vtkCompositeDataSet::NAME()),
+                 (mbB ? mbB->GetMetaData(i) : mpB->GetMetaData(i))->Get(
+                   vtkCompositeDataSet::NAME())) != 0)
+        {
+        return false;
+        }
+      if (!SameDataObjects(
+            mbA ? mbA->GetBlock(i) : mpA->GetPieceAsDataObject(i),
+            mbB ? mbB->GetBlock(i) : mpB->GetPieceAsDataObject(i)))
+        {
+        return false;
+        }
+      }
+    return true;
+    }
+
+  vtkDataSet* dsA = vtkDataSet::SafeDownCast(a);
+  vtkDataSet* dsB = vtkDataSet::SafeDownCast(b);
+  if (!dsA || dsA->GetNumberOfPoints() != dsB->GetNumberOfPoints() ||
+      dsA->GetNumberOfCells() != dsB->GetNumberOfCells() ||
+      !SameFieldData(dsA->GetFieldData(), dsB->GetFieldData()) ||
+      !SameAttributes(dsA->GetPointData(), dsB->GetPointData()) ||
+      !SameAttributes(dsA->GetCellData(), dsB->GetCellData()))
+    {
+    return false;
+    }
+  double boundsA[6], boundsB[6];
+  dsA->GetBounds(boundsA);
+  dsB->GetBounds(boundsB);
+  if (memcmp(boundsA, boundsB, sizeof(boundsA)) != 0)
+    {
+    return false;
+    }
+
+  if (vtkImageData* image = vtkImageData::SafeDownCast(a))
+    {
+    int* extent = vtkImageData::SafeDownCast(b)->GetExtent();
+    return (memcmp(image->GetExtent(), extent, 6*sizeof(int)) == 0);
+    }
+  if (vtkPolyData* pd = vtkPolyData::SafeDownCast(a))
+    {
+    vtkPolyData* pdB = vtkPolyData::SafeDownCast(b);
+    return (SameArrays(pd->GetPoints()->GetData(),
+                       pdB->GetPoints()->GetData()) &&
+            SameCells(pd->GetVerts(), pdB->GetVerts()) &&
+            SameCells(pd->GetLines(), pdB->GetLines()) &&
+            SameCells(pd->GetPolys(), pdB->GetPolys()) &&
+            SameCells(pd->GetStrips(), pdB->GetStrips()));
+    }
+  if (vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(a))
+    {
+    vtkUnstructuredGrid* ugB = vtkUnstructuredGrid::SafeDownCast(b);
+    return (SameArrays(ug->GetPoints()->GetData(),
+                       ugB->GetPoints()->GetData()) &&
+            SameCells(ug->GetCells(), ugB->GetCells()) &&
+            SameArrays(ug->GetCellTypesArray(), ugB->GetCellTypesArray()) &&
+            SameArrays(ug->GetFaceLocations(), ugB->GetFaceLocations()) &&
+            SameArrays(ug->GetFaces(), ugB->GetFaces()));
+    }
+  return true;
+}
+
+// Adds point and cell arrays of several types to a data set, with
+// attributes set on some of them.
+static void AddArrays(vtkDataSet* ds)
+{
+  vtkIdType numPts = ds->GetNumberOfPoints();
+  vtkNew<vtkFloatArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  normals->SetNumberOfTuples(numPts);
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; i++)
+    {
+    normals->SetTuple3(i, 0.0, i, -0.5*i);
+    ids->SetValue(i, static_cast<int>(i));
+    }
+  ds->GetPointData()->AddArray(ids.GetPointer());
+  ds->GetPointData()->SetNormals(normals.GetPointer());
+
+  vtkIdType numCells = ds->GetNumberOfCells();
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(numCells);
+  for (vtkIdType i = 0; i < numCells; i++)
+    {
+    scalars->SetValue(i, 1.0/(i + 1));
+    }
+  ds->GetCellData()->SetScalars(scalars.GetPointer());
+
+  vtkNew<vtkUnsignedCharArray> unnamed;
+  unnamed->SetNumberOfComponents(2);
+  unnamed->SetNumberOfTuples(3);
+  unnamed->FillComponent(0, 7);
+  unnamed->FillComponent(1, 200);
+  ds->GetFieldData()->AddArray(unnamed.GetPointer());
+}
+
+static vtkSmartPointer<vtkImageData> MakeImage()
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(2, 6, -1, 3, 4, 5);
+  image->SetOrigin(0.5, -1.0, 3.25);
+  image->SetSpacing(0.1, 0.2, 0.3);
+  AddArrays(image);
+  return image;
+}
+
+static vtkSmartPointer<vtkPoints> MakePoints(vtkIdType numPts)
+{
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; i++)
+    {
+    points->SetPoint(i, i % 3, (i/3) % 3, i/9);
+    }
+  return points;
+}
+
+static vtkSmartPointer<vtkRectilinearGrid> MakeRectilinearGrid()
+{
+  vtkSmartPointer<vtkRectilinearGrid> grid =
+    vtkSmartPointer<vtkRectilinearGrid>::New();
+  grid->SetExtent(0, 3, 1, 2, 0, 0);
+  vtkNew<vtkDoubleArray> x;
+  vtkNew<vtkFloatArray> y;
+  vtkNew<vtkFloatArray> z;
+  x->InsertNextValue(0.0);
+  x->InsertNextValue(0.5);
+  x->InsertNextValue(2.0);
+  x->InsertNextValue(4.5);
+  y->InsertNextValue(-1.0f);
+  y->InsertNextValue(1.0f);
+  z->InsertNextValue(3.0f);
+  grid->SetXCoordinates(x.GetPointer());
+  grid->SetYCoordinates(y.GetPointer());
+  grid->SetZCoordinates(z.GetPointer());
+  AddArrays(grid);
+  return grid;
+}
+
+static vtkSmartPointer<vtkStructuredGrid> MakeStructuredGrid()
+{
+  vtkSmartPointer<vtkStructuredGrid> grid =
+    vtkSmartPointer<vtkStructuredGrid>::New();
+  grid->SetExtent(0, 2, 0, 2, 0, 2);
+  grid->SetPoints(MakePoints(27));
+  AddArrays(grid);
+  return grid;
+}
+
+static vtkSmartPointer<vtkPolyData> MakePolyData()
+{
+  vtkSmartPointer<vtkPolyData> pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(MakePoints(27));
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  vtkIdType ids[4] = { 0, 1, 4, 3 };
+  verts->InsertNextCell(1, ids);
+  lines->InsertNextCell(3, ids);
+  polys->InsertNextCell(4, ids);
+  polys->InsertNextCell(3, ids + 1);
+  pd->SetVerts(verts.GetPointer());
+  pd->SetLines(lines.GetPointer());
+  pd->SetPolys(polys.GetPointer());
+  AddArrays(pd);
+  return pd;
+}
+
+static vtkSmartPointer<vtkUnstructuredGrid> MakeUnstructuredGrid()
+{
+  vtkSmartPointer<vtkUnstructuredGrid> ug =
+    vtkSmartPointer<vtkUnstructuredGrid>::New();
+  ug->SetPoints(MakePoints(27));
+  ug->Allocate(4);
+  vtkIdType hex[8] = { 0, 1, 4, 3, 9, 10, 13, 12 };
+  ug->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+  vtkIdType tet[4] = { 1, 2, 5, 10 };
+  ug->InsertNextCell(VTK_TETRA, 4, tet);
+
+  // a tetrahedron given as a polyhedron
+  vtkIdType faces[16] = { 3, 4, 5, 13,  3, 4, 13, 14,  3, 5, 14, 13,
+                          3, 4, 14, 5 };
+  ug->InsertNextCell(VTK_POLYHEDRON, 4, tet, 4, faces);
+  AddArrays(ug);
+  return ug;
+}
+
+static bool RoundTrip(vtkDataObject* object, vtkDataObject* output,
+                      bool binary)
+{
+  vtkNew<vtkCharArray> buffer;
+  if (!vtkCommunicator::MarshalDataObject(object, buffer.GetPointer()))
+    {
+    return false;
+    }
+  bool isBinary = (buffer->GetNumberOfTuples() > 3 &&
+                   strncmp(buffer->GetPointer(0), "vtk", 3) == 0);
+  return (isBinary == binary &&
+          vtkCommunicator::UnMarshalDataObject(buffer.GetPointer(), output) &&
+          SameDataObjects(object, output));
+}
+
+int TestDataObjectMarshaling(int, char*[])
+{
+  int errors = 0;
+
+  vtkSmartPointer<vtkDataObject> datasets[5] = {
+    MakeImage(), MakeRectilinearGrid(), MakeStructuredGrid(), MakePolyData(),
+    MakeUnstructuredGrid() };
+  for (int i = 0; i < 5; i++)
+    {
+    vtkSmartPointer<vtkDataObject> output;
+    output.TakeReference(datasets[i]->NewInstance());
+    if (!RoundTrip(datasets[i], output, true))
+      {
+      cerr << datasets[i]->GetClassName() << " was not unmarshaled\n";
+      errors++;
+      }
+    }
+
+  // nested composites with names and empty blocks
+  vtkNew<vtkMultiPieceDataSet> pieces;
+  pieces->SetNumberOfPieces(3);
+  pieces->SetPiece(0, datasets[3]);
+  pieces->SetPiece(2, datasets[4]);
+  vtkNew<vtkMultiBlockDataSet> inner;
+  inner->SetBlock(0, datasets[0]);
+  inner->SetBlock(1, pieces.GetPointer());
+  inner->GetMetaData(1u)->Set(vtkCompositeDataSet::NAME(), "pieces");
+  vtkNew<vtkMultiBlockDataSet> outer;
+  outer->SetNumberOfBlocks(4);
+  outer->SetBlock(0, datasets[1]);
+  outer->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "rectilinear");
+  outer->SetBlock(2, inner.GetPointer());
+  outer->SetBlock(3, datasets[2]);
+  vtkNew<vtkMultiBlockDataSet> composite;
+  if (!RoundTrip(outer.GetPointer(), composite.GetPointer(), true))
+    {
+    cerr << "The composite data set was not unmarshaled\n";
+    errors++;
+    }
+
+  // Objects unmarshaled into objects of another type are rejected.
+  vtkNew<vtkPolyData> wrongType;
+  if (RoundTrip(datasets[0], wrongType.GetPointer(), true))
+    {
+    cerr << "Image data was unmarshaled into poly data\n";
+    errors++;
+    }
+
+  // String arrays are not covered by the binary format.
+  vtkSmartPointer<vtkPolyData> withStrings = MakePolyData();
+  vtkNew<vtkStringArray> strings;
+  strings->SetName("Strings");
+  strings->InsertNextValue("one");
+  withStrings->GetFieldData()->AddArray(strings.GetPointer());
+  vtkNew<vtkPolyData> legacy;
+  vtkNew<vtkCharArray> buffer;
+  if (!vtkCommunicator::MarshalDataObject(withStrings, buffer.GetPointer()) ||
+      strncmp(buffer->GetPointer(0), "vtk", 3) == 0 ||
+      !vtkCommunicator::UnMarshalDataObject(buffer.GetPointer(),
+                                            legacy.GetPointer()) ||
+      legacy->GetNumberOfPolys() != 2 ||
+      !legacy->GetFieldData()->GetAbstractArray("Strings"))
+    {
+    cerr << "Poly data with string arrays was not unmarshaled\n";
+    errors++;
+    }
+
+  return (errors != 0);
+}
@@ -0,0 +1,86 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestNoBlockCollectives.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the collective operations that do not block, and the neighbor
+// exchange, with a single process.
+
+#include "vtkCommunicator.h"
+#include "vtkDummyController.h"
+#include "vtkNew.h"
+
+int TestNoBlockCollectives(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  controller->Initialize(0, 0);
+  int errors = 0;
+
+  double values[4] = { 1.0, -2.0, 3.5, 8.0 };
+  double sums[4] = { 0.0, 0.0, 0.0, 0.0 };
+  int data[3] = { 5, 6, 7 };
+  vtkIdType ids[3] = { 10, 20, 30 };
+  vtkIdType gathered[4] = { -1, -1, -1, -1 };
+  vtkIdType length = 3;
+  vtkIdType offset = 1;
+
+  vtkCommunicator::CollectiveRequest requests[3];
+  if (!controller->NoBlockAllReduce(values, sums, 4, vtkCommunicator::SUM_OP,
+                                    requests[0]) ||
+      !controller->NoBlockBroadcast(data, 3, 0, requests[1]) ||
+      !controller->NoBlockAllGatherV(ids, gathered, 3, &length, &offset,
+                                     requests[2]) ||
+      !vtkCommunicator::WaitAll(3, requests))
+    {
+    cerr << "The operations did not complete\n";
+    errors++;
+    }
+  if (requests[0].IsPending() || !requests[0].Test() ||
+      sums[2] != 3.5 || sums[3] != 8.0 || data[2] != 7 ||
+      gathered[0] != -1 || gathered[1] != 10 || gathered[3] != 30)
+    {
+    cerr << "Wrong results of the operations that do not block\n";
+    errors++;
+    }
+
+  // A process that is its own neighbor copies its values.
+  int self = controller->GetLocalProcessId();
+  float sendBuffer[5] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+  float recvBuffer[5] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+  vtkIdType sendLength = 3, sendOffset = 2;
+  vtkIdType recvOffset = 0;
+  vtkCommunicator::CollectiveRequest exchange;
+  if (!controller->NoBlockNeighborExchange(sendBuffer, &sendLength,
+                                           &sendOffset, recvBuffer,
+                                           &sendLength, &recvOffset,
+                                           1, &self, exchange) ||
+      !exchange.Wait() ||
+      recvBuffer[0] != 3.0f || recvBuffer[2] != 5.0f || recvBuffer[3] != 0.0f)
+    {
+    cerr << "Wrong values exchanged with the process itself\n";
+    errors++;
+    }
+
+  // Lengths that do not match are an error.
+  vtkIdType wrongLength = 2;
+  cerr << "Expecting an error:\n";
+  if (controller->NeighborExchange(sendBuffer, &sendLength, &sendOffset,
+                                   recvBuffer, &wrongLength, &recvOffset,
+                                   1, &self))
+    {
+    cerr << "A mismatched exchange succeeded\n";
+    errors++;
+    }
+
+  controller->Finalize();
+  return (errors != 0);
+}
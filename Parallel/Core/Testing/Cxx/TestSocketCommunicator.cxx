@@ -22,6 +22,7 @@
 #include "vtkDoubleArray.h"
 
 #include <vtksys/ios/sstream>
+#include <vector>
 
 #define MESSAGE(x)\
   cout << (is_server? "SERVER" : "CLIENT") << ":" x << endl;
@@ -111,6 +112,25 @@ int main(int argc, char *argv[])
     // ship messages around.
     is_server = !is_server;
     }
+
+  // Both ends send more than the socket buffers hold, which must not deadlock.
+  MESSAGE("---- Neighbor exchange ----");
+  const vtkIdType numValues = 1000000;
+  std::vector<double> sendValues(numValues, is_server ? 1.0 : 2.0);
+  std::vector<double> recvValues(numValues + 1, 0.0);
+  vtkIdType sendOffset = 0;
+  vtkIdType recvOffset = 1;
+  int remote = 1;
+  if (!controller->NeighborExchange(&sendValues[0], &numValues, &sendOffset,
+                                    &recvValues[0], &numValues, &recvOffset,
+                                    1, &remote) ||
+      recvValues[0] != 0.0 || recvValues[1] != (is_server ? 2.0 : 1.0) ||
+      recvValues[numValues] != recvValues[1])
+    {
+    MESSAGE("ERROR: Neighbor exchange failed!!!");
+    return EXIT_FAILURE;
+    }
+  MESSAGE("   .... PASSED!");
   MESSAGE("All's well!");
   return EXIT_SUCCESS;
 }
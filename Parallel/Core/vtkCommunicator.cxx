@@ -15,6 +15,9 @@
 #include "vtkCommunicator.h"
 
 #include "vtkBoundingBox.h"
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataObjectTypes.h"
@@ -26,9 +29,15 @@
 #include "vtkGenericDataObjectWriter.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
+#include "vtkInformation.h"
 #include "vtkIntArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredGrid.h"
@@ -36,6 +45,7 @@
 #include "vtkTypeTraits.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedLongArray.h"
+#include "vtkUnstructuredGrid.h"
 
 #define VTK_CREATE(type, name) \
   vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
@@ -99,6 +109,737 @@ STANDARD_OPERATION_DEFINITION(LogicalXor, (!A[i] && B[i]) || (A[i] && !B[i]));
 STANDARD_OPERATION_FLOAT_OVERRIDE(BitwiseXor);
 STANDARD_OPERATION_DEFINITION(BitwiseXor, A[i] ^ B[i]);
 
+//=============================================================================
+// The binary format of data objects.  An object is described by a header of
+// 64 bit integers and by the names of its arrays and blocks.  The values of
+// its arrays follow, in the order the arrays appear in the header, as they
+// are in memory.  Send() sends each array as a message of its own, straight
+// from the array, and Receive() receives it straight into a new array.
+namespace
+{
+enum { VTK_COMMUNICATOR_LEGACY_FORMAT = 0, VTK_COMMUNICATOR_BINARY_FORMAT = 1 };
+
+// Marks a buffer from MarshalDataObject() in the binary format.
+const char vtkCommunicatorBinaryMagic[8] =
+  { 'v', 't', 'k', 'B', 'I', 'N', '1', '\0' };
+
+// The magic, the byte order mark and the sizes of the header and names.
+const size_t vtkCommunicatorBinaryPrefixSize = 8 + 3*sizeof(vtkTypeInt64);
+
+//-----------------------------------------------------------------------------
+// Describes an object in the binary format.
+class vtkCommunicatorObjectWriter
+{
+public:
+  std::vector<vtkTypeInt64> Header;
+  std::vector<char> Names;
+  std::vector<vtkDataArray*> Arrays;
+
+  // Returns false for objects the format does not cover, which are then
+  // sent in the legacy format.
+  bool AddObject(vtkDataObject *object)
+  {
+    if (!object)
+      {
+      this->Add(-1);
+      return true;
+      }
+    int type = object->GetDataObjectType();
+    this->Add(type);
+    if (type == VTK_MULTIBLOCK_DATA_SET || type == VTK_MULTIPIECE_DATA_SET)
+      {
+      return this->AddComposite(object);
+      }
+    vtkDataSet *ds = vtkDataSet::SafeDownCast(object);
+    return (ds && this->AddDataSet(ds, type));
+  }
+
+private:
+  void Add(vtkTypeInt64 value)
+  {
+    this->Header.push_back(value);
+  }
+
+  void AddDouble(double value)
+  {
+    vtkTypeInt64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    this->Header.push_back(bits);
+  }
+
+  void AddName(const char *name)
+  {
+    this->Add(name != NULL);
+    if (name)
+      {
+      this->Names.insert(this->Names.end(), name, name + strlen(name) + 1);
+      }
+  }
+
+  bool AddArray(vtkAbstractArray *array)
+  {
+    if (!array)
+      {
+      this->Add(-1);
+      return true;
+      }
+    vtkDataArray *da = vtkDataArray::SafeDownCast(array);
+    if (!da || da->GetDataType() == VTK_BIT)
+      {
+      return false;
+      }
+    this->Add(da->GetDataType());
+    this->Add(da->GetNumberOfTuples());
+    this->Add(da->GetNumberOfComponents());
+    this->AddName(da->GetName());
+    this->Arrays.push_back(da);
+    return true;
+  }
+
+  bool AddPoints(vtkPoints *points)
+  {
+    return this->AddArray(points ? points->GetData() : NULL);
+  }
+
+  bool AddCells(vtkCellArray *cells)
+  {
+    this->Add(cells ? cells->GetNumberOfCells() : -1);
+    return (!cells || this->AddArray(cells->GetData()));
+  }
+
+  bool AddFieldData(vtkFieldData *fd)
+  {
+    int numArrays = fd ? fd->GetNumberOfArrays() : 0;
+    this->Add(numArrays);
+    for (int i = 0; i < numArrays; i++)
+      {
+      if (!this->AddArray(fd->GetAbstractArray(i)))
+        {
+        return false;
+        }
+      }
+    return true;
+  }
+
+  bool AddAttributes(vtkDataSetAttributes *dsa)
+  {
+    if (!this->AddFieldData(dsa))
+      {
+      return false;
+      }
+    int indices[vtkDataSetAttributes::NUM_ATTRIBUTES];
+    dsa->GetAttributeIndices(indices);
+    for (int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; i++)
+      {
+      this->Add(indices[i]);
+      }
+    return true;
+  }
+
+  bool AddDataSet(vtkDataSet *ds, int type)
+  {
+    bool added = true;
+    int extent[6];
+    switch (type)
+      {
+      case VTK_IMAGE_DATA:
+      case VTK_STRUCTURED_POINTS:
+        {
+        vtkImageData *image = vtkImageData::SafeDownCast(ds);
+        image->GetExtent(extent);
+        this->Header.insert(this->Header.end(), extent, extent + 6);
+        for (int i = 0; i < 3; i++)
+          {
+          this->AddDouble(image->GetOrigin()[i]);
+          }
+        for (int i = 0; i < 3; i++)
+          {
+          this->AddDouble(image->GetSpacing()[i]);
+          }
+        }
+        break;
+      case VTK_RECTILINEAR_GRID:
+        {
+        vtkRectilinearGrid *grid = vtkRectilinearGrid::SafeDownCast(ds);
+        grid->GetExtent(extent);
+        this->Header.insert(this->Header.end(), extent, extent + 6);
+        added = (this->AddArray(grid->GetXCoordinates()) &&
+                 this->AddArray(grid->GetYCoordinates()) &&
+                 this->AddArray(grid->GetZCoordinates()));
+        }
+        break;
+      case VTK_STRUCTURED_GRID:
+        {
+        vtkStructuredGrid *grid = vtkStructuredGrid::SafeDownCast(ds);
+        grid->GetExtent(extent);
+        this->Header.insert(this->Header.end(), extent, extent + 6);
+        added = this->AddPoints(grid->GetPoints());
+        }
+        break;
+      case VTK_POLY_DATA:
+        {
+        vtkPolyData *pd = vtkPolyData::SafeDownCast(ds);
+        added = (this->AddPoints(pd->GetPoints()) &&
+                 this->AddCells(pd->GetVerts()) &&
+                 this->AddCells(pd->GetLines()) &&
+                 this->AddCells(pd->GetPolys()) &&
+                 this->AddCells(pd->GetStrips()));
+        }
+        break;
+      case VTK_UNSTRUCTURED_GRID:
+        {
+        vtkUnstructuredGrid *ug = vtkUnstructuredGrid::SafeDownCast(ds);
+        added = (this->AddPoints(ug->GetPoints()) &&
+                 this->AddCells(ug->GetCells()) &&
+                 this->AddArray(ug->GetCellTypesArray()) &&
+                 this->AddArray(ug->GetCellLocationsArray()) &&
+                 this->AddArray(ug->GetFaceLocations()) &&
+                 this->AddArray(ug->GetFaces()));
+        }
+        break;
+      default:
+        return false;
+      }
+    return (added &&
+            this->AddFieldData(ds->GetFieldData()) &&
+            this->AddAttributes(ds->GetPointData()) &&
+            this->AddAttributes(ds->GetCellData()));
+  }
+
+  bool AddComposite(vtkDataObject *object)
+  {
+    vtkMultiBlockDataSet *mb = vtkMultiBlockDataSet::SafeDownCast(object);
+    vtkMultiPieceDataSet *mp = vtkMultiPieceDataSet::SafeDownCast(object);
+    unsigned int numChildren =
+      mb ? mb->GetNumberOfBlocks() : mp->GetNumberOfPieces();
+    this->Add(numChildren);
+    for (unsigned int i = 0; i < numChildren; i++)
+      {
+      vtkInformation *metaData = NULL;
+      if (mb ? mb->HasMetaData(i) : mp->HasMetaData(i))
+        {
+        metaData = mb ? mb->GetMetaData(i) : mp->GetMetaData(i);
+        }
+      this->AddName(
+        (metaData && metaData->Has(vtkCompositeDataSet::NAME())) ?
+        metaData->Get(vtkCompositeDataSet::NAME()) : NULL);
+      if (!this->AddObject(mb ? mb->GetBlock(i) :
+                                mp->GetPieceAsDataObject(i)))
+        {
+        return false;
+        }
+      }
+    return true;
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Builds an object from its description in the binary format, with its
+// arrays allocated but not filled.  Their values are then read into Arrays,
+// in order.
+class vtkCommunicatorObjectReader
+{
+public:
+  std::vector<vtkSmartPointer<vtkDataArray> > Arrays;
+
+  vtkCommunicatorObjectReader(const vtkTypeInt64 *header, size_t headerSize,
+                              const char *names, size_t namesSize)
+    : Header(header), HeaderSize(headerSize), HeaderPosition(0),
+      Names(names), NamesSize(namesSize), NamesPosition(0), Failed(false)
+  {
+  }
+
+  // Returns false if the description is not of an object like the given one.
+  bool ReadObject(vtkDataObject *object)
+  {
+    vtkTypeInt64 type = this->Next();
+    if (this->Failed || type != object->GetDataObjectType())
+      {
+      return false;
+      }
+    object->Initialize();
+    if (type == VTK_MULTIBLOCK_DATA_SET || type == VTK_MULTIPIECE_DATA_SET)
+      {
+      return this->ReadComposite(object);
+      }
+    vtkDataSet *ds = vtkDataSet::SafeDownCast(object);
+    return (ds && this->ReadDataSet(ds, static_cast<int>(type)) &&
+            this->HeaderPosition <= this->HeaderSize);
+  }
+
+private:
+  vtkTypeInt64 Next()
+  {
+    if (this->HeaderPosition >= this->HeaderSize)
+      {
+      this->Failed = true;
+      return 0;
+      }
+    return this->Header[this->HeaderPosition++];
+  }
+
+  double NextDouble()
+  {
+    vtkTypeInt64 bits = this->Next();
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  const char *NextName()
+  {
+    if (!this->Next())
+      {
+      return NULL;
+      }
+    const char *name = this->Names + this->NamesPosition;
+    const char *end = static_cast<const char*>(
+      memchr(name, '\0', this->NamesSize - this->NamesPosition));
+    if (!end)
+      {
+      this->Failed = true;
+      return NULL;
+      }
+    this->NamesPosition += end - name + 1;
+    return name;
+  }
+
+  vtkSmartPointer<vtkDataArray> NextArray()
+  {
+    vtkSmartPointer<vtkDataArray> array;
+    vtkTypeInt64 type = this->Next();
+    if (type < 0)
+      {
+      return array;
+      }
+    vtkTypeInt64 numTuples = this->Next();
+    vtkTypeInt64 numComponents = this->Next();
+    const char *name = this->NextName();
+    if (this->Failed || numTuples < 0 || numComponents < 1 ||
+        type == VTK_BIT)
+      {
+      this->Failed = true;
+      return array;
+      }
+    array.TakeReference(vtkDataArray::CreateDataArray(static_cast<int>(type)));
+    if (!array || array->GetDataType() != type)
+      {
+      this->Failed = true;
+      return NULL;
+      }
+    array->SetNumberOfComponents(static_cast<int>(numComponents));
+    array->SetNumberOfTuples(numTuples);
+    array->SetName(name);
+    this->Arrays.push_back(array);
+    return array;
+  }
+
+  vtkSmartPointer<vtkPoints> NextPoints()
+  {
+    vtkSmartPointer<vtkPoints> points;
+    vtkDataArray *array = this->NextArray();
+    if (array)
+      {
+      points = vtkSmartPointer<vtkPoints>::New();
+      points->SetData(array);
+      }
+    return points;
+  }
+
+  vtkSmartPointer<vtkCellArray> NextCells()
+  {
+    vtkSmartPointer<vtkCellArray> cells;
+    vtkTypeInt64 numCells = this->Next();
+    if (numCells < 0)
+      {
+      return cells;
+      }
+    vtkIdTypeArray *ids = vtkIdTypeArray::SafeDownCast(this->NextArray());
+    if (!ids)
+      {
+      this->Failed = true;
+      return cells;
+      }
+    cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetCells(numCells, ids);
+    return cells;
+  }
+
+  bool ReadFieldData(vtkFieldData *fd)
+  {
+    vtkTypeInt64 numArrays = this->Next();
+    for (vtkTypeInt64 i = 0; i < numArrays && !this->Failed; i++)
+      {
+      vtkDataArray *array = this->NextArray();
+      if (array)
+        {
+        fd->AddArray(array);
+        }
+      }
+    return !this->Failed;
+  }
+
+  bool ReadAttributes(vtkDataSetAttributes *dsa)
+  {
+    if (!this->ReadFieldData(dsa))
+      {
+      return false;
+      }
+    for (int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; i++)
+      {
+      vtkTypeInt64 index = this->Next();
+      if (index >= 0 && index < dsa->GetNumberOfArrays())
+        {
+        dsa->SetActiveAttribute(static_cast<int>(index), i);
+        }
+      }
+    return !this->Failed;
+  }
+
+  void NextExtent(int extent[6])
+  {
+    for (int i = 0; i < 6; i++)
+      {
+      extent[i] = static_cast<int>(this->Next());
+      }
+  }
+
+  bool ReadDataSet(vtkDataSet *ds, int type)
+  {
+    int extent[6];
+    switch (type)
+      {
+      case VTK_IMAGE_DATA:
+      case VTK_STRUCTURED_POINTS:
+        {
+        vtkImageData *image = vtkImageData::SafeDownCast(ds);
+        this->NextExtent(extent);
+        double origin[3], spacing[3];
+        for (int i = 0; i < 3; i++)
+          {
+          origin[i] = this->NextDouble();
+          }
+        for (int i = 0; i < 3; i++)
+          {
+          spacing[i] = this->NextDouble();
+          }
+        image->SetExtent(extent);
+        image->SetOrigin(origin);
+        image->SetSpacing(spacing);
+        }
+        break;
+      case VTK_RECTILINEAR_GRID:
+        {
+        vtkRectilinearGrid *grid = vtkRectilinearGrid::SafeDownCast(ds);
+        this->NextExtent(extent);
+        grid->SetExtent(extent);
+        grid->SetXCoordinates(this->NextArray());
+        grid->SetYCoordinates(this->NextArray());
+        grid->SetZCoordinates(this->NextArray());
+        }
+        break;
+      case VTK_STRUCTURED_GRID:
+        {
+        vtkStructuredGrid *grid = vtkStructuredGrid::SafeDownCast(ds);
+        this->NextExtent(extent);
+        grid->SetExtent(extent);
+        grid->SetPoints(this->NextPoints());
+        }
+        break;
+      case VTK_POLY_DATA:
+        {
+        vtkPolyData *pd = vtkPolyData::SafeDownCast(ds);
+        pd->SetPoints(this->NextPoints());
+        pd->SetVerts(this->NextCells());
+        pd->SetLines(this->NextCells());
+        pd->SetPolys(this->NextCells());
+        pd->SetStrips(this->NextCells());
+        }
+        break;
+      case VTK_UNSTRUCTURED_GRID:
+        {
+        vtkUnstructuredGrid *ug = vtkUnstructuredGrid::SafeDownCast(ds);
+        ug->SetPoints(this->NextPoints());
+        vtkSmartPointer<vtkCellArray> cells = this->NextCells();
+        vtkSmartPointer<vtkDataArray> types = this->NextArray();
+        vtkSmartPointer<vtkDataArray> locations = this->NextArray();
+        vtkSmartPointer<vtkDataArray> faceLocations = this->NextArray();
+        vtkSmartPointer<vtkDataArray> faces = this->NextArray();
+        if (cells)
+          {
+          ug->SetCells(vtkUnsignedCharArray::SafeDownCast(types),
+                       vtkIdTypeArray::SafeDownCast(locations), cells,
+                       vtkIdTypeArray::SafeDownCast(faceLocations),
+                       vtkIdTypeArray::SafeDownCast(faces));
+          }
+        }
+        break;
+      default:
+        return false;
+      }
+    return (!this->Failed &&
+            this->ReadFieldData(ds->GetFieldData()) &&
+            this->ReadAttributes(ds->GetPointData()) &&
+            this->ReadAttributes(ds->GetCellData()));
+  }
+
+  bool ReadComposite(vtkDataObject *object)
+  {
+    vtkMultiBlockDataSet *mb = vtkMultiBlockDataSet::SafeDownCast(object);
+    vtkMultiPieceDataSet *mp = vtkMultiPieceDataSet::SafeDownCast(object);
+    vtkTypeInt64 numChildren = this->Next();
+    if (this->Failed || numChildren < 0)
+      {
+      return false;
+      }
+    unsigned int n = static_cast<unsigned int>(numChildren);
+    if (mb)
+      {
+      mb->SetNumberOfBlocks(n);
+      }
+    else
+      {
+      mp->SetNumberOfPieces(n);
+      }
+    for (unsigned int i = 0; i < n; i++)
+      {
+      const char *name = this->NextName();
+      if (this->Failed)
+        {
+        return false;
+        }
+      if (name)
+        {
+        (mb ? mb->GetMetaData(i) : mp->GetMetaData(i))->Set(
+          vtkCompositeDataSet::NAME(), name);
+        }
+      if (this->HeaderPosition < this->HeaderSize &&
+          this->Header[this->HeaderPosition] < 0)
+        {
+        // an empty block
+        this->HeaderPosition++;
+        continue;
+        }
+      vtkSmartPointer<vtkDataObject> child;
+      if (this->HeaderPosition < this->HeaderSize)
+        {
+        child.TakeReference(vtkDataObjectTypes::NewDataObject(
+          static_cast<int>(this->Header[this->HeaderPosition])));
+        }
+      if (!child || !this->ReadObject(child))
+        {
+        return false;
+        }
+      if (mb)
+        {
+        mb->SetBlock(i, child);
+        }
+      else
+        {
+        mp->SetPiece(i, child);
+        }
+      }
+    return true;
+  }
+
+  const vtkTypeInt64 *Header;
+  size_t HeaderSize;
+  size_t HeaderPosition;
+  const char *Names;
+  size_t NamesSize;
+  size_t NamesPosition;
+  bool Failed;
+};
+
+//-----------------------------------------------------------------------------
+inline vtkIdType vtkCommunicatorNumberOfValues(vtkDataArray *array)
+{
+  return array->GetNumberOfTuples()*array->GetNumberOfComponents();
+}
+
+//-----------------------------------------------------------------------------
+// Sends the description of an object, then its arrays one by one.
+int vtkCommunicatorSendObject(vtkCommunicator *comm,
+                              vtkCommunicatorObjectWriter &writer,
+                              int remoteHandle, int tag)
+{
+  vtkTypeInt64 sizes[2];
+  sizes[0] = static_cast<vtkTypeInt64>(writer.Header.size());
+  sizes[1] = static_cast<vtkTypeInt64>(writer.Names.size());
+  if (!comm->SendVoidArray(sizes, 2, VTK_TYPE_INT64, remoteHandle, tag) ||
+      !comm->SendVoidArray(&writer.Header[0], sizes[0], VTK_TYPE_INT64,
+                           remoteHandle, tag) ||
+      (sizes[1] > 0 &&
+       !comm->SendVoidArray(&writer.Names[0], sizes[1], VTK_CHAR,
+                            remoteHandle, tag)))
+    {
+    return 0;
+    }
+  for (size_t i = 0; i < writer.Arrays.size(); i++)
+    {
+    vtkDataArray *array = writer.Arrays[i];
+    vtkIdType numValues = vtkCommunicatorNumberOfValues(array);
+    if (numValues > 0 &&
+        !comm->SendVoidArray(array->GetVoidPointer(0), numValues,
+                             array->GetDataType(), remoteHandle, tag))
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicatorReceiveObject(vtkCommunicator *comm, vtkDataObject *object,
+                                 int remoteHandle, int tag)
+{
+  vtkTypeInt64 sizes[2];
+  if (!comm->ReceiveVoidArray(sizes, 2, VTK_TYPE_INT64, remoteHandle, tag) ||
+      sizes[0] < 1 || sizes[1] < 0)
+    {
+    return 0;
+    }
+  std::vector<vtkTypeInt64> header(sizes[0]);
+  std::vector<char> names(sizes[1] + 1);
+  if (!comm->ReceiveVoidArray(&header[0], sizes[0], VTK_TYPE_INT64,
+                              remoteHandle, tag) ||
+      (sizes[1] > 0 &&
+       !comm->ReceiveVoidArray(&names[0], sizes[1], VTK_CHAR,
+                               remoteHandle, tag)))
+    {
+    return 0;
+    }
+  vtkCommunicatorObjectReader reader(&header[0], header.size(),
+                                     &names[0], sizes[1]);
+  if (!reader.ReadObject(object))
+    {
+    vtkGenericWarningMacro("Type mismatch while receiving data.");
+    return 0;
+    }
+  for (size_t i = 0; i < reader.Arrays.size(); i++)
+    {
+    vtkDataArray *array = reader.Arrays[i];
+    vtkIdType numValues = vtkCommunicatorNumberOfValues(array);
+    if (numValues > 0 &&
+        !comm->ReceiveVoidArray(array->GetVoidPointer(0), numValues,
+                                array->GetDataType(), remoteHandle, tag))
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+// Packs an object into one buffer, in native byte order.
+void vtkCommunicatorMarshalObject(vtkCommunicatorObjectWriter &writer,
+                                  vtkCharArray *buffer)
+{
+  vtkTypeInt64 prefix[3];
+  prefix[0] = 1;
+  prefix[1] = static_cast<vtkTypeInt64>(writer.Header.size());
+  prefix[2] = static_cast<vtkTypeInt64>(writer.Names.size());
+  size_t headerBytes = writer.Header.size()*sizeof(vtkTypeInt64);
+  size_t size = vtkCommunicatorBinaryPrefixSize + headerBytes +
+    writer.Names.size();
+  for (size_t i = 0; i < writer.Arrays.size(); i++)
+    {
+    size += vtkCommunicatorNumberOfValues(writer.Arrays[i])*
+      writer.Arrays[i]->GetDataTypeSize();
+    }
+
+  buffer->SetNumberOfTuples(static_cast<vtkIdType>(size));
+  char *p = buffer->GetPointer(0);
+  memcpy(p, vtkCommunicatorBinaryMagic, 8);
+  memcpy(p + 8, prefix, sizeof(prefix));
+  p += vtkCommunicatorBinaryPrefixSize;
+  memcpy(p, &writer.Header[0], headerBytes);
+  p += headerBytes;
+  if (!writer.Names.empty())
+    {
+    memcpy(p, &writer.Names[0], writer.Names.size());
+    p += writer.Names.size();
+    }
+  for (size_t i = 0; i < writer.Arrays.size(); i++)
+    {
+    vtkDataArray *array = writer.Arrays[i];
+    size_t bytes = vtkCommunicatorNumberOfValues(array)*
+      array->GetDataTypeSize();
+    if (bytes > 0)
+      {
+      memcpy(p, array->GetVoidPointer(0), bytes);
+      p += bytes;
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Unpacks an object packed by vtkCommunicatorMarshalObject(), swapping the
+// bytes if it was packed on a machine of the other byte order.
+int vtkCommunicatorUnMarshalObject(const char *buffer, size_t size,
+                                   vtkDataObject *object)
+{
+  vtkTypeInt64 prefix[3];
+  memcpy(prefix, buffer + 8, sizeof(prefix));
+  bool swap = (prefix[0] != 1);
+  if (swap)
+    {
+    vtkByteSwap::SwapVoidRange(prefix, 3, sizeof(vtkTypeInt64));
+    }
+  size_t headerBytes = static_cast<size_t>(prefix[1])*sizeof(vtkTypeInt64);
+  if (prefix[0] != 1 || prefix[1] < 1 || prefix[2] < 0 ||
+      vtkCommunicatorBinaryPrefixSize + headerBytes +
+      static_cast<size_t>(prefix[2]) > size)
+    {
+    vtkGenericWarningMacro("Corrupt buffer while unmarshaling data.");
+    return 0;
+    }
+  const char *p = buffer + vtkCommunicatorBinaryPrefixSize;
+  std::vector<vtkTypeInt64> header(prefix[1]);
+  memcpy(&header[0], p, headerBytes);
+  if (swap)
+    {
+    vtkByteSwap::SwapVoidRange(&header[0], header.size(),
+                               sizeof(vtkTypeInt64));
+    }
+  p += headerBytes;
+
+  vtkCommunicatorObjectReader reader(&header[0], header.size(),
+                                     p, static_cast<size_t>(prefix[2]));
+  if (!reader.ReadObject(object))
+    {
+    vtkGenericWarningMacro("Type mismatch while unmarshaling data.");
+    return 0;
+    }
+  p += prefix[2];
+
+  const char *end = buffer + size;
+  for (size_t i = 0; i < reader.Arrays.size(); i++)
+    {
+    vtkDataArray *array = reader.Arrays[i];
+    vtkIdType numValues = vtkCommunicatorNumberOfValues(array);
+    int valueSize = array->GetDataTypeSize();
+    size_t bytes = numValues*valueSize;
+    if (static_cast<size_t>(end - p) < bytes)
+      {
+      vtkGenericWarningMacro("Corrupt buffer while unmarshaling data.");
+      return 0;
+      }
+    if (bytes > 0)
+      {
+      memcpy(array->GetVoidPointer(0), p, bytes);
+      if (swap && valueSize > 1)
+        {
+        vtkByteSwap::SwapVoidRange(array->GetVoidPointer(0), numValues,
+                                   valueSize);
+        }
+      p += bytes;
+      }
+    }
+  return 1;
+}
+}
+
 //=============================================================================
 vtkCommunicator::vtkCommunicator()
 {
@@ -207,6 +948,7 @@ int vtkCommunicator::Send(vtkDataObject* data, int remoteHandle,
     case VTK_TREE:
     case VTK_UNSTRUCTURED_GRID:
     case VTK_MULTIBLOCK_DATA_SET:
+    case VTK_MULTIPIECE_DATA_SET:
     case VTK_UNIFORM_GRID_AMR:
       return this->SendElementalDataObject(data, remoteHandle, tag);
     }
@@ -217,6 +959,19 @@ int vtkCommunicator::SendElementalDataObject(
   vtkDataObject* data, int remoteHandle,
   int tag)
 {
+  // Send the arrays as they are if the binary format covers the object.
+  vtkCommunicatorObjectWriter writer;
+  int format = writer.AddObject(data) ?
+    VTK_COMMUNICATOR_BINARY_FORMAT : VTK_COMMUNICATOR_LEGACY_FORMAT;
+  if (!this->Send(&format, 1, remoteHandle, tag))
+    {
+    return 0;
+    }
+  if (format == VTK_COMMUNICATOR_BINARY_FORMAT)
+    {
+    return vtkCommunicatorSendObject(this, writer, remoteHandle, tag);
+    }
+
   VTK_CREATE(vtkCharArray, buffer);
   if (vtkCommunicator::MarshalDataObject(data, buffer))
     {
@@ -401,6 +1156,7 @@ int vtkCommunicator::ReceiveDataObject(vtkDataObject* data, int remoteHandle,
     case VTK_TREE:
     case VTK_UNSTRUCTURED_GRID:
     case VTK_MULTIBLOCK_DATA_SET:
+    case VTK_MULTIPIECE_DATA_SET:
     case VTK_UNIFORM_GRID_AMR:
       return this->ReceiveElementalDataObject(data, remoteHandle, tag);
     }
@@ -411,6 +1167,16 @@ int vtkCommunicator::ReceiveElementalDataObject(
   vtkDataObject* data, int remoteHandle,
   int tag)
 {
+  int format;
+  if (!this->Receive(&format, 1, remoteHandle, tag))
+    {
+    return 0;
+    }
+  if (format == VTK_COMMUNICATOR_BINARY_FORMAT)
+    {
+    return vtkCommunicatorReceiveObject(this, data, remoteHandle, tag);
+    }
+
   VTK_CREATE(vtkCharArray, buffer);
   if (!this->Receive(buffer, remoteHandle, tag))
     {
@@ -520,6 +1286,13 @@ int vtkCommunicator::MarshalDataObject(vtkDataObject *object,
     return 1;
     }
 
+  vtkCommunicatorObjectWriter objectWriter;
+  if (objectWriter.AddObject(object))
+    {
+    vtkCommunicatorMarshalObject(objectWriter, buffer);
+    return 1;
+    }
+
   VTK_CREATE(vtkGenericDataObjectWriter, writer);
 
   vtkSmartPointer<vtkDataObject> copy;
@@ -596,6 +1369,13 @@ int vtkCommunicator::UnMarshalDataObject(vtkCharArray *buffer,
     return 1;
     }
 
+  if (static_cast<size_t>(bufferSize) >= vtkCommunicatorBinaryPrefixSize &&
+      memcmp(buffer->GetPointer(0), vtkCommunicatorBinaryMagic, 8) == 0)
+    {
+    return vtkCommunicatorUnMarshalObject(buffer->GetPointer(0), bufferSize,
+                                          object);
+    }
+
   // You would think that the extent information would be properly saved, but
   // no, it is not.
   int extent[6] = {0,0,0,0,0,0};
@@ -1480,6 +2260,192 @@ int vtkCommunicator::AllReduce(vtkDataArray *sendBuffer,
                                   components*tuples, type, operation);
 }
 
+//-----------------------------------------------------------------------------
+int vtkCommunicator::NeighborExchangeVoidArray(const void *sendBuffer,
+                                               const vtkIdType *sendLengths,
+                                               const vtkIdType *sendOffsets,
+                                               void *recvBuffer,
+                                               const vtkIdType *recvLengths,
+                                               const vtkIdType *recvOffsets,
+                                               int type,
+                                               int numberOfNeighbors,
+                                               const int *neighbors)
+{
+  int typeSize = vtkAbstractArray::GetDataTypeSize(type);
+  const char *sendBytes = reinterpret_cast<const char *>(sendBuffer);
+  char *recvBytes = reinterpret_cast<char *>(recvBuffer);
+
+  // Exchanging with the neighbors in increasing order of their ids, and
+  // letting the process with the lower id send first, exchanges the messages
+  // of all pairs of processes in the same order on both sides.  Blocking
+  // sends then cannot deadlock.
+  std::vector<std::pair<int, int> > order(numberOfNeighbors);
+  for (int i = 0; i < numberOfNeighbors; i++)
+    {
+    order[i] = std::make_pair(neighbors[i], i);
+    }
+  std::sort(order.begin(), order.end());
+
+  for (int n = 0; n < numberOfNeighbors; n++)
+    {
+    int neighbor = order[n].first;
+    int i = order[n].second;
+    const char *sendPtr = sendBytes + sendOffsets[i]*typeSize;
+    char *recvPtr = recvBytes + recvOffsets[i]*typeSize;
+    if (neighbor == this->LocalProcessId)
+      {
+      if (sendLengths[i] != recvLengths[i])
+        {
+        vtkErrorMacro("A process must receive from itself what it sends.");
+        return 0;
+        }
+      memcpy(recvPtr, sendPtr, sendLengths[i]*typeSize);
+      continue;
+      }
+    for (int step = 0; step < 2; step++)
+      {
+      if ((step == 0) == (this->LocalProcessId < neighbor))
+        {
+        if (sendLengths[i] > 0 &&
+            !this->SendVoidArray(sendPtr, sendLengths[i], type, neighbor,
+                                 NEIGHBOR_EXCHANGE_TAG))
+          {
+          return 0;
+          }
+        }
+      else if (recvLengths[i] > 0 &&
+               !this->ReceiveVoidArray(recvPtr, recvLengths[i], type,
+                                       neighbor, NEIGHBOR_EXCHANGE_TAG))
+        {
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::NoBlockBroadcastVoidArray(void *data, vtkIdType length,
+                                               int type, int srcProcessId,
+                                               CollectiveRequest &req)
+{
+  req.Complete(this->BroadcastVoidArray(data, length, type, srcProcessId));
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::NoBlockAllGatherVVoidArray(const void *sendBuffer,
+                                                void *recvBuffer,
+                                                vtkIdType sendLength,
+                                                vtkIdType *recvLengths,
+                                                vtkIdType *offsets, int type,
+                                                CollectiveRequest &req)
+{
+  req.Complete(this->AllGatherVVoidArray(sendBuffer, recvBuffer, sendLength,
+                                         recvLengths, offsets, type));
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::NoBlockAllReduceVoidArray(const void *sendBuffer,
+                                               void *recvBuffer,
+                                               vtkIdType length, int type,
+                                               int operation,
+                                               CollectiveRequest &req)
+{
+  req.Complete(this->AllReduceVoidArray(sendBuffer, recvBuffer, length, type,
+                                        operation));
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::NoBlockNeighborExchangeVoidArray(
+  const void *sendBuffer, const vtkIdType *sendLengths,
+  const vtkIdType *sendOffsets, void *recvBuffer,
+  const vtkIdType *recvLengths, const vtkIdType *recvOffsets, int type,
+  int numberOfNeighbors, const int *neighbors, CollectiveRequest &req)
+{
+  req.Complete(this->NeighborExchangeVoidArray(sendBuffer, sendLengths,
+                                               sendOffsets, recvBuffer,
+                                               recvLengths, recvOffsets, type,
+                                               numberOfNeighbors, neighbors));
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::WaitAll(int count, CollectiveRequest requests[])
+{
+  int result = 1;
+  for (int i = 0; i < count; i++)
+    {
+    if (!requests[i].Wait())
+      {
+      result = 0;
+      }
+    }
+  return result;
+}
+
+//-----------------------------------------------------------------------------
+vtkCommunicator::CollectiveRequest::CollectiveRequest()
+  : Operation(0), Result(1)
+{
+}
+
+//-----------------------------------------------------------------------------
+vtkCommunicator::CollectiveRequest::~CollectiveRequest()
+{
+  this->Wait();
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::CollectiveRequest::Wait()
+{
+  if (this->Operation)
+    {
+    this->Result = this->Operation->Wait();
+    delete this->Operation;
+    this->Operation = 0;
+    }
+  return this->Result;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCommunicator::CollectiveRequest::Test()
+{
+  if (this->Operation)
+    {
+    int done = 0;
+    if (!this->Operation->Test(done))
+      {
+      this->Result = 0;
+      done = 1;
+      }
+    if (!done)
+      {
+      return 0;
+      }
+    delete this->Operation;
+    this->Operation = 0;
+    }
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+void vtkCommunicator::CollectiveRequest::Start(Pending *operation)
+{
+  this->Wait();
+  this->Operation = operation;
+  this->Result = 1;
+}
+
+//-----------------------------------------------------------------------------
+void vtkCommunicator::CollectiveRequest::Complete(int result)
+{
+  this->Wait();
+  this->Result = result;
+}
+
 //-----------------------------------------------------------------------------
 int vtkCommunicator::Broadcast(vtkMultiProcessStream& stream, int srcProcessId)
 {
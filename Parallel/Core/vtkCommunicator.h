@@ -70,7 +70,8 @@ public:
     SCATTER_TAG         = 13,
     SCATTERV_TAG        = 14,
     REDUCE_TAG          = 15,
-    BARRIER_TAG         = 16
+    BARRIER_TAG         = 16,
+    NEIGHBOR_EXCHANGE_TAG = 17
   };
 
   enum StandardOperations
@@ -113,6 +114,64 @@ public:
     virtual ~Operation() {}
   };
 
+  // Description:
+  // A handle to a collective operation that does not block, as started by
+  // the NoBlock methods below.  The buffers given to the operation must not
+  // be used until Wait() or Test() report that it completed.  A request
+  // that is destroyed waits for its operation first.
+  class VTKPARALLELCORE_EXPORT CollectiveRequest
+  {
+  public:
+    // Description:
+    // An operation that completes in the background.  Communicators that
+    // can overlap collective operations with computation subclass this to
+    // hand their operations to requests.
+    class Pending
+    {
+    public:
+      // Description:
+      // Blocks until the operation completes.  Returns 1 on success.
+      virtual int Wait() = 0;
+
+      // Description:
+      // Sets done to 1 if the operation completed, without blocking.
+      // Returns 0 on failure.
+      virtual int Test(int &done) = 0;
+
+      virtual ~Pending() {}
+    };
+
+    CollectiveRequest();
+    ~CollectiveRequest();
+
+    // Description:
+    // Blocks until the operation completes.  Returns 1 if it succeeded.
+    int Wait();
+
+    // Description:
+    // Returns 1 if the operation completed, without blocking.  Wait() then
+    // returns at once whether it succeeded.
+    int Test();
+
+    // Description:
+    // Returns 1 while the operation is not known to have completed.
+    int IsPending() const { return this->Operation != 0; }
+
+    // Description:
+    // Used by communicators to hand over an operation in progress, which
+    // the request then owns, or the result of one that already completed.
+    // The operation the request held before is waited for first.
+    void Start(Pending *operation);
+    void Complete(int result);
+
+  private:
+    CollectiveRequest(const CollectiveRequest&);  // Not implemented.
+    void operator=(const CollectiveRequest&);  // Not implemented.
+
+    Pending *Operation;
+    int Result;
+  };
+
 //ETX
 
   // Description:
@@ -765,6 +824,287 @@ public:
   int AllReduce(vtkDataArray *sendBuffer, vtkDataArray *recvBuffer,
                 Operation *operation);
 
+//BTX
+  // Description:
+  // Nonblocking versions of Broadcast, AllGatherV and AllReduce, which
+  // start the operation and return at once.  \c req tells when the
+  // operation completed.  All processes must start the same collective
+  // operations in the same order.  Communicators that cannot overlap
+  // collective operations with computation complete them before returning.
+  int NoBlockBroadcast(int *data, vtkIdType length, int srcProcessId,
+                       CollectiveRequest &req) {
+    return this->NoBlockBroadcastVoidArray(data, length, VTK_INT, srcProcessId,
+                                           req);
+  }
+  int NoBlockBroadcast(unsigned char *data, vtkIdType length, int srcProcessId,
+                       CollectiveRequest &req) {
+    return this->NoBlockBroadcastVoidArray(data, length, VTK_UNSIGNED_CHAR, srcProcessId,
+                                           req);
+  }
+  int NoBlockBroadcast(char *data, vtkIdType length, int srcProcessId,
+                       CollectiveRequest &req) {
+    return this->NoBlockBroadcastVoidArray(data, length, VTK_CHAR, srcProcessId,
+                                           req);
+  }
+  int NoBlockBroadcast(float *data, vtkIdType length, int srcProcessId,
+                       CollectiveRequest &req) {
+    return this->NoBlockBroadcastVoidArray(data, length, VTK_FLOAT, srcProcessId,
+                                           req);
+  }
+  int NoBlockBroadcast(double *data, vtkIdType length, int srcProcessId,
+                       CollectiveRequest &req) {
+    return this->NoBlockBroadcastVoidArray(data, length, VTK_DOUBLE, srcProcessId,
+                                           req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int NoBlockBroadcast(vtkIdType *data, vtkIdType length, int srcProcessId,
+                       CollectiveRequest &req) {
+    return this->NoBlockBroadcastVoidArray(data, length, VTK_ID_TYPE, srcProcessId,
+                                           req);
+  }
+#endif
+  int NoBlockAllGatherV(const int *sendBuffer, int *recvBuffer,
+                       vtkIdType sendLength, vtkIdType *recvLengths,
+                       vtkIdType *offsets, CollectiveRequest &req) {
+    return this->NoBlockAllGatherVVoidArray(sendBuffer, recvBuffer,
+                                            sendLength, recvLengths, offsets,
+                                            VTK_INT, req);
+  }
+  int NoBlockAllGatherV(const unsigned char *sendBuffer, unsigned char *recvBuffer,
+                       vtkIdType sendLength, vtkIdType *recvLengths,
+                       vtkIdType *offsets, CollectiveRequest &req) {
+    return this->NoBlockAllGatherVVoidArray(sendBuffer, recvBuffer,
+                                            sendLength, recvLengths, offsets,
+                                            VTK_UNSIGNED_CHAR, req);
+  }
+  int NoBlockAllGatherV(const char *sendBuffer, char *recvBuffer,
+                       vtkIdType sendLength, vtkIdType *recvLengths,
+                       vtkIdType *offsets, CollectiveRequest &req) {
+    return this->NoBlockAllGatherVVoidArray(sendBuffer, recvBuffer,
+                                            sendLength, recvLengths, offsets,
+                                            VTK_CHAR, req);
+  }
+  int NoBlockAllGatherV(const float *sendBuffer, float *recvBuffer,
+                       vtkIdType sendLength, vtkIdType *recvLengths,
+                       vtkIdType *offsets, CollectiveRequest &req) {
+    return this->NoBlockAllGatherVVoidArray(sendBuffer, recvBuffer,
+                                            sendLength, recvLengths, offsets,
+                                            VTK_FLOAT, req);
+  }
+  int NoBlockAllGatherV(const double *sendBuffer, double *recvBuffer,
+                       vtkIdType sendLength, vtkIdType *recvLengths,
+                       vtkIdType *offsets, CollectiveRequest &req) {
+    return this->NoBlockAllGatherVVoidArray(sendBuffer, recvBuffer,
+                                            sendLength, recvLengths, offsets,
+                                            VTK_DOUBLE, req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int NoBlockAllGatherV(const vtkIdType *sendBuffer, vtkIdType *recvBuffer,
+                       vtkIdType sendLength, vtkIdType *recvLengths,
+                       vtkIdType *offsets, CollectiveRequest &req) {
+    return this->NoBlockAllGatherVVoidArray(sendBuffer, recvBuffer,
+                                            sendLength, recvLengths, offsets,
+                                            VTK_ID_TYPE, req);
+  }
+#endif
+  int NoBlockAllReduce(const int *sendBuffer, int *recvBuffer,
+                       vtkIdType length, int operation,
+                       CollectiveRequest &req) {
+    return this->NoBlockAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                           VTK_INT, operation, req);
+  }
+  int NoBlockAllReduce(const unsigned char *sendBuffer, unsigned char *recvBuffer,
+                       vtkIdType length, int operation,
+                       CollectiveRequest &req) {
+    return this->NoBlockAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                           VTK_UNSIGNED_CHAR, operation, req);
+  }
+  int NoBlockAllReduce(const char *sendBuffer, char *recvBuffer,
+                       vtkIdType length, int operation,
+                       CollectiveRequest &req) {
+    return this->NoBlockAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                           VTK_CHAR, operation, req);
+  }
+  int NoBlockAllReduce(const float *sendBuffer, float *recvBuffer,
+                       vtkIdType length, int operation,
+                       CollectiveRequest &req) {
+    return this->NoBlockAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                           VTK_FLOAT, operation, req);
+  }
+  int NoBlockAllReduce(const double *sendBuffer, double *recvBuffer,
+                       vtkIdType length, int operation,
+                       CollectiveRequest &req) {
+    return this->NoBlockAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                           VTK_DOUBLE, operation, req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int NoBlockAllReduce(const vtkIdType *sendBuffer, vtkIdType *recvBuffer,
+                       vtkIdType length, int operation,
+                       CollectiveRequest &req) {
+    return this->NoBlockAllReduceVoidArray(sendBuffer, recvBuffer, length,
+                                           VTK_ID_TYPE, operation, req);
+  }
+#endif
+
+  // Description:
+  // NeighborExchange sends parts of the send buffer to a sparse set of
+  // processes and receives parts of the receive buffer from them, without
+  // involving the other processes.  The process \c neighbors[i] receives
+  // \c sendLengths[i] values from \c sendOffsets[i] in \c sendBuffer,
+  // and the \c recvLengths[i] values it sends are stored at
+  // \c recvOffsets[i] in \c recvBuffer.  Neighborhoods must be symmetric
+  // and the lengths must match on both sides.  A process may list itself,
+  // in which case its values are copied.  NoBlockNeighborExchange only
+  // starts the exchange, so that computation can overlap with it.
+  int NeighborExchange(const int *sendBuffer, const vtkIdType *sendLengths,
+                       const vtkIdType *sendOffsets, int *recvBuffer,
+                       const vtkIdType *recvLengths,
+                       const vtkIdType *recvOffsets,
+                       int numberOfNeighbors, const int *neighbors) {
+    return this->NeighborExchangeVoidArray(sendBuffer, sendLengths,
+                                           sendOffsets, recvBuffer,
+                                           recvLengths, recvOffsets, VTK_INT,
+                                           numberOfNeighbors, neighbors);
+  }
+  int NeighborExchange(const unsigned char *sendBuffer, const vtkIdType *sendLengths,
+                       const vtkIdType *sendOffsets, unsigned char *recvBuffer,
+                       const vtkIdType *recvLengths,
+                       const vtkIdType *recvOffsets,
+                       int numberOfNeighbors, const int *neighbors) {
+    return this->NeighborExchangeVoidArray(sendBuffer, sendLengths,
+                                           sendOffsets, recvBuffer,
+                                           recvLengths, recvOffsets, VTK_UNSIGNED_CHAR,
+                                           numberOfNeighbors, neighbors);
+  }
+  int NeighborExchange(const char *sendBuffer, const vtkIdType *sendLengths,
+                       const vtkIdType *sendOffsets, char *recvBuffer,
+                       const vtkIdType *recvLengths,
+                       const vtkIdType *recvOffsets,
+                       int numberOfNeighbors, const int *neighbors) {
+    return this->NeighborExchangeVoidArray(sendBuffer, sendLengths,
+                                           sendOffsets, recvBuffer,
+                                           recvLengths, recvOffsets, VTK_CHAR,
+                                           numberOfNeighbors, neighbors);
+  }
+  int NeighborExchange(const float *sendBuffer, const vtkIdType *sendLengths,
+                       const vtkIdType *sendOffsets, float *recvBuffer,
+                       const vtkIdType *recvLengths,
+                       const vtkIdType *recvOffsets,
+                       int numberOfNeighbors, const int *neighbors) {
+    return this->NeighborExchangeVoidArray(sendBuffer, sendLengths,
+                                           sendOffsets, recvBuffer,
+                                           recvLengths, recvOffsets, VTK_FLOAT,
+                                           numberOfNeighbors, neighbors);
+  }
+  int NeighborExchange(const double *sendBuffer, const vtkIdType *sendLengths,
+                       const vtkIdType *sendOffsets, double *recvBuffer,
+                       const vtkIdType *recvLengths,
+                       const vtkIdType *recvOffsets,
+                       int numberOfNeighbors, const int *neighbors) {
+    return this->NeighborExchangeVoidArray(sendBuffer, sendLengths,
+                                           sendOffsets, recvBuffer,
+                                           recvLengths, recvOffsets, VTK_DOUBLE,
+                                           numberOfNeighbors, neighbors);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int NeighborExchange(const vtkIdType *sendBuffer, const vtkIdType *sendLengths,
+                       const vtkIdType *sendOffsets, vtkIdType *recvBuffer,
+                       const vtkIdType *recvLengths,
+                       const vtkIdType *recvOffsets,
+                       int numberOfNeighbors, const int *neighbors) {
+    return this->NeighborExchangeVoidArray(sendBuffer, sendLengths,
+                                           sendOffsets, recvBuffer,
+                                           recvLengths, recvOffsets, VTK_ID_TYPE,
+                                           numberOfNeighbors, neighbors);
+  }
+#endif
+  int NoBlockNeighborExchange(const int *sendBuffer,
+                              const vtkIdType *sendLengths,
+                              const vtkIdType *sendOffsets, int *recvBuffer,
+                              const vtkIdType *recvLengths,
+                              const vtkIdType *recvOffsets,
+                              int numberOfNeighbors, const int *neighbors,
+                              CollectiveRequest &req) {
+    return this->NoBlockNeighborExchangeVoidArray(sendBuffer, sendLengths,
+                                                  sendOffsets, recvBuffer,
+                                                  recvLengths, recvOffsets,
+                                                  VTK_INT, numberOfNeighbors,
+                                                  neighbors, req);
+  }
+  int NoBlockNeighborExchange(const unsigned char *sendBuffer,
+                              const vtkIdType *sendLengths,
+                              const vtkIdType *sendOffsets, unsigned char *recvBuffer,
+                              const vtkIdType *recvLengths,
+                              const vtkIdType *recvOffsets,
+                              int numberOfNeighbors, const int *neighbors,
+                              CollectiveRequest &req) {
+    return this->NoBlockNeighborExchangeVoidArray(sendBuffer, sendLengths,
+                                                  sendOffsets, recvBuffer,
+                                                  recvLengths, recvOffsets,
+                                                  VTK_UNSIGNED_CHAR, numberOfNeighbors,
+                                                  neighbors, req);
+  }
+  int NoBlockNeighborExchange(const char *sendBuffer,
+                              const vtkIdType *sendLengths,
+                              const vtkIdType *sendOffsets, char *recvBuffer,
+                              const vtkIdType *recvLengths,
+                              const vtkIdType *recvOffsets,
+                              int numberOfNeighbors, const int *neighbors,
+                              CollectiveRequest &req) {
+    return this->NoBlockNeighborExchangeVoidArray(sendBuffer, sendLengths,
+                                                  sendOffsets, recvBuffer,
+                                                  recvLengths, recvOffsets,
+                                                  VTK_CHAR, numberOfNeighbors,
+                                                  neighbors, req);
+  }
+  int NoBlockNeighborExchange(const float *sendBuffer,
+                              const vtkIdType *sendLengths,
+                              const vtkIdType *sendOffsets, float *recvBuffer,
+                              const vtkIdType *recvLengths,
+                              const vtkIdType *recvOffsets,
+                              int numberOfNeighbors, const int *neighbors,
+                              CollectiveRequest &req) {
+    return this->NoBlockNeighborExchangeVoidArray(sendBuffer, sendLengths,
+                                                  sendOffsets, recvBuffer,
+                                                  recvLengths, recvOffsets,
+                                                  VTK_FLOAT, numberOfNeighbors,
+                                                  neighbors, req);
+  }
+  int NoBlockNeighborExchange(const double *sendBuffer,
+                              const vtkIdType *sendLengths,
+                              const vtkIdType *sendOffsets, double *recvBuffer,
+                              const vtkIdType *recvLengths,
+                              const vtkIdType *recvOffsets,
+                              int numberOfNeighbors, const int *neighbors,
+                              CollectiveRequest &req) {
+    return this->NoBlockNeighborExchangeVoidArray(sendBuffer, sendLengths,
+                                                  sendOffsets, recvBuffer,
+                                                  recvLengths, recvOffsets,
+                                                  VTK_DOUBLE, numberOfNeighbors,
+                                                  neighbors, req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int NoBlockNeighborExchange(const vtkIdType *sendBuffer,
+                              const vtkIdType *sendLengths,
+                              const vtkIdType *sendOffsets, vtkIdType *recvBuffer,
+                              const vtkIdType *recvLengths,
+                              const vtkIdType *recvOffsets,
+                              int numberOfNeighbors, const int *neighbors,
+                              CollectiveRequest &req) {
+    return this->NoBlockNeighborExchangeVoidArray(sendBuffer, sendLengths,
+                                                  sendOffsets, recvBuffer,
+                                                  recvLengths, recvOffsets,
+                                                  VTK_ID_TYPE, numberOfNeighbors,
+                                                  neighbors, req);
+  }
+#endif
+
+  // Description:
+  // Waits for all the given requests.  Returns 1 if all their operations
+  // succeeded.
+  static int WaitAll(int count, CollectiveRequest requests[]);
+//ETX
+
   // Description:
   // Subclasses should reimplement these if they have a more efficient
   // implementation.
@@ -798,6 +1138,43 @@ public:
   virtual int AllReduceVoidArray(const void *sendBuffer, void *recvBuffer,
                                  vtkIdType length, int type,
                                  Operation *operation);
+  virtual int NeighborExchangeVoidArray(const void *sendBuffer,
+                                        const vtkIdType *sendLengths,
+                                        const vtkIdType *sendOffsets,
+                                        void *recvBuffer,
+                                        const vtkIdType *recvLengths,
+                                        const vtkIdType *recvOffsets,
+                                        int type, int numberOfNeighbors,
+                                        const int *neighbors);
+
+//BTX
+  // Description:
+  // Subclasses that can overlap collective operations with computation
+  // reimplement these.  By default they complete the blocking operation.
+  virtual int NoBlockBroadcastVoidArray(void *data, vtkIdType length,
+                                        int type, int srcProcessId,
+                                        CollectiveRequest &req);
+  virtual int NoBlockAllGatherVVoidArray(const void *sendBuffer,
+                                         void *recvBuffer,
+                                         vtkIdType sendLength,
+                                         vtkIdType *recvLengths,
+                                         vtkIdType *offsets, int type,
+                                         CollectiveRequest &req);
+  virtual int NoBlockAllReduceVoidArray(const void *sendBuffer,
+                                        void *recvBuffer, vtkIdType length,
+                                        int type, int operation,
+                                        CollectiveRequest &req);
+  virtual int NoBlockNeighborExchangeVoidArray(const void *sendBuffer,
+                                               const vtkIdType *sendLengths,
+                                               const vtkIdType *sendOffsets,
+                                               void *recvBuffer,
+                                               const vtkIdType *recvLengths,
+                                               const vtkIdType *recvOffsets,
+                                               int type,
+                                               int numberOfNeighbors,
+                                               const int *neighbors,
+                                               CollectiveRequest &req);
+//ETX
 
   static void SetUseCopy(int useCopy);
 
@@ -830,7 +1207,10 @@ public:
 
   // Description:
   // Convert a data object into a string that can be transmitted and vice versa.
-  // Returns 1 for success and 0 for failure.
+  // Returns 1 for success and 0 for failure.  Data sets, multiblock and
+  // multipiece data sets whose field data holds only data arrays are
+  // packed as their raw arrays, in a binary format that Send() also uses
+  // without packing.  Other objects are converted with the legacy writer.
   // WARNING: This will only work for types that have a vtkDataWriter class.
   static int MarshalDataObject(vtkDataObject *object, vtkCharArray *buffer);
   static int UnMarshalDataObject(vtkCharArray *buffer, vtkDataObject *object);
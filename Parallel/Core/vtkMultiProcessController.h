@@ -989,6 +989,266 @@ public:
   }
 //ETX
 
+//BTX
+  // Description:
+  // Nonblocking versions of Broadcast, AllGatherV and AllReduce.  See
+  // vtkCommunicator.
+  int NoBlockBroadcast(int *data, vtkIdType length, int srcProcessId,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockBroadcast(data, length, srcProcessId,
+                                                req);
+  }
+  int NoBlockBroadcast(unsigned char *data, vtkIdType length, int srcProcessId,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockBroadcast(data, length, srcProcessId,
+                                                req);
+  }
+  int NoBlockBroadcast(char *data, vtkIdType length, int srcProcessId,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockBroadcast(data, length, srcProcessId,
+                                                req);
+  }
+  int NoBlockBroadcast(float *data, vtkIdType length, int srcProcessId,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockBroadcast(data, length, srcProcessId,
+                                                req);
+  }
+  int NoBlockBroadcast(double *data, vtkIdType length, int srcProcessId,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockBroadcast(data, length, srcProcessId,
+                                                req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int NoBlockBroadcast(vtkIdType *data, vtkIdType length, int srcProcessId,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockBroadcast(data, length, srcProcessId,
+                                                req);
+  }
+#endif
+  int NoBlockAllGatherV(const int *sendBuffer, int *recvBuffer,
+                       vtkIdType sendLength, vtkIdType *recvLengths,
+                       vtkIdType *offsets,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockAllGatherV(sendBuffer, recvBuffer,
+                                                 sendLength, recvLengths,
+                                                 offsets, req);
+  }
+  int NoBlockAllGatherV(const unsigned char *sendBuffer, unsigned char *recvBuffer,
+                       vtkIdType sendLength, vtkIdType *recvLengths,
+                       vtkIdType *offsets,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockAllGatherV(sendBuffer, recvBuffer,
+                                                 sendLength, recvLengths,
+                                                 offsets, req);
+  }
+  int NoBlockAllGatherV(const char *sendBuffer, char *recvBuffer,
+                       vtkIdType sendLength, vtkIdType *recvLengths,
+                       vtkIdType *offsets,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockAllGatherV(sendBuffer, recvBuffer,
+                                                 sendLength, recvLengths,
+                                                 offsets, req);
+  }
+  int NoBlockAllGatherV(const float *sendBuffer, float *recvBuffer,
+                       vtkIdType sendLength, vtkIdType *recvLengths,
+                       vtkIdType *offsets,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockAllGatherV(sendBuffer, recvBuffer,
+                                                 sendLength, recvLengths,
+                                                 offsets, req);
+  }
+  int NoBlockAllGatherV(const double *sendBuffer, double *recvBuffer,
+                       vtkIdType sendLength, vtkIdType *recvLengths,
+                       vtkIdType *offsets,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockAllGatherV(sendBuffer, recvBuffer,
+                                                 sendLength, recvLengths,
+                                                 offsets, req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int NoBlockAllGatherV(const vtkIdType *sendBuffer, vtkIdType *recvBuffer,
+                       vtkIdType sendLength, vtkIdType *recvLengths,
+                       vtkIdType *offsets,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockAllGatherV(sendBuffer, recvBuffer,
+                                                 sendLength, recvLengths,
+                                                 offsets, req);
+  }
+#endif
+  int NoBlockAllReduce(const int *sendBuffer, int *recvBuffer,
+                       vtkIdType length, int operation,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockAllReduce(sendBuffer, recvBuffer,
+                                                length, operation, req);
+  }
+  int NoBlockAllReduce(const unsigned char *sendBuffer, unsigned char *recvBuffer,
+                       vtkIdType length, int operation,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockAllReduce(sendBuffer, recvBuffer,
+                                                length, operation, req);
+  }
+  int NoBlockAllReduce(const char *sendBuffer, char *recvBuffer,
+                       vtkIdType length, int operation,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockAllReduce(sendBuffer, recvBuffer,
+                                                length, operation, req);
+  }
+  int NoBlockAllReduce(const float *sendBuffer, float *recvBuffer,
+                       vtkIdType length, int operation,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockAllReduce(sendBuffer, recvBuffer,
+                                                length, operation, req);
+  }
+  int NoBlockAllReduce(const double *sendBuffer, double *recvBuffer,
+                       vtkIdType length, int operation,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockAllReduce(sendBuffer, recvBuffer,
+                                                length, operation, req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int NoBlockAllReduce(const vtkIdType *sendBuffer, vtkIdType *recvBuffer,
+                       vtkIdType length, int operation,
+                       vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockAllReduce(sendBuffer, recvBuffer,
+                                                length, operation, req);
+  }
+#endif
+
+  // Description:
+  // Exchange parts of arrays with a sparse set of processes.  See
+  // vtkCommunicator.
+  int NeighborExchange(const int *sendBuffer, const vtkIdType *sendLengths,
+                       const vtkIdType *sendOffsets, int *recvBuffer,
+                       const vtkIdType *recvLengths,
+                       const vtkIdType *recvOffsets,
+                       int numberOfNeighbors, const int *neighbors) {
+    return this->Communicator->NeighborExchange(sendBuffer, sendLengths,
+                                                sendOffsets, recvBuffer,
+                                                recvLengths, recvOffsets,
+                                                numberOfNeighbors, neighbors);
+  }
+  int NeighborExchange(const unsigned char *sendBuffer, const vtkIdType *sendLengths,
+                       const vtkIdType *sendOffsets, unsigned char *recvBuffer,
+                       const vtkIdType *recvLengths,
+                       const vtkIdType *recvOffsets,
+                       int numberOfNeighbors, const int *neighbors) {
+    return this->Communicator->NeighborExchange(sendBuffer, sendLengths,
+                                                sendOffsets, recvBuffer,
+                                                recvLengths, recvOffsets,
+                                                numberOfNeighbors, neighbors);
+  }
+  int NeighborExchange(const char *sendBuffer, const vtkIdType *sendLengths,
+                       const vtkIdType *sendOffsets, char *recvBuffer,
+                       const vtkIdType *recvLengths,
+                       const vtkIdType *recvOffsets,
+                       int numberOfNeighbors, const int *neighbors) {
+    return this->Communicator->NeighborExchange(sendBuffer, sendLengths,
+                                                sendOffsets, recvBuffer,
+                                                recvLengths, recvOffsets,
+                                                numberOfNeighbors, neighbors);
+  }
+  int NeighborExchange(const float *sendBuffer, const vtkIdType *sendLengths,
+                       const vtkIdType *sendOffsets, float *recvBuffer,
+                       const vtkIdType *recvLengths,
+                       const vtkIdType *recvOffsets,
+                       int numberOfNeighbors, const int *neighbors) {
+    return this->Communicator->NeighborExchange(sendBuffer, sendLengths,
+                                                sendOffsets, recvBuffer,
+                                                recvLengths, recvOffsets,
+                                                numberOfNeighbors, neighbors);
+  }
+  int NeighborExchange(const double *sendBuffer, const vtkIdType *sendLengths,
+                       const vtkIdType *sendOffsets, double *recvBuffer,
+                       const vtkIdType *recvLengths,
+                       const vtkIdType *recvOffsets,
+                       int numberOfNeighbors, const int *neighbors) {
+    return this->Communicator->NeighborExchange(sendBuffer, sendLengths,
+                                                sendOffsets, recvBuffer,
+                                                recvLengths, recvOffsets,
+                                                numberOfNeighbors, neighbors);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int NeighborExchange(const vtkIdType *sendBuffer, const vtkIdType *sendLengths,
+                       const vtkIdType *sendOffsets, vtkIdType *recvBuffer,
+                       const vtkIdType *recvLengths,
+                       const vtkIdType *recvOffsets,
+                       int numberOfNeighbors, const int *neighbors) {
+    return this->Communicator->NeighborExchange(sendBuffer, sendLengths,
+                                                sendOffsets, recvBuffer,
+                                                recvLengths, recvOffsets,
+                                                numberOfNeighbors, neighbors);
+  }
+#endif
+  int NoBlockNeighborExchange(const int *sendBuffer,
+                              const vtkIdType *sendLengths,
+                              const vtkIdType *sendOffsets, int *recvBuffer,
+                              const vtkIdType *recvLengths,
+                              const vtkIdType *recvOffsets,
+                              int numberOfNeighbors, const int *neighbors,
+                              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockNeighborExchange(
+      sendBuffer, sendLengths, sendOffsets, recvBuffer, recvLengths,
+      recvOffsets, numberOfNeighbors, neighbors, req);
+  }
+  int NoBlockNeighborExchange(const unsigned char *sendBuffer,
+                              const vtkIdType *sendLengths,
+                              const vtkIdType *sendOffsets, unsigned char *recvBuffer,
+                              const vtkIdType *recvLengths,
+                              const vtkIdType *recvOffsets,
+                              int numberOfNeighbors, const int *neighbors,
+                              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockNeighborExchange(
+      sendBuffer, sendLengths, sendOffsets, recvBuffer, recvLengths,
+      recvOffsets, numberOfNeighbors, neighbors, req);
+  }
+  int NoBlockNeighborExchange(const char *sendBuffer,
+                              const vtkIdType *sendLengths,
+                              const vtkIdType *sendOffsets, char *recvBuffer,
+                              const vtkIdType *recvLengths,
+                              const vtkIdType *recvOffsets,
+                              int numberOfNeighbors, const int *neighbors,
+                              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockNeighborExchange(
+      sendBuffer, sendLengths, sendOffsets, recvBuffer, recvLengths,
+      recvOffsets, numberOfNeighbors, neighbors, req);
+  }
+  int NoBlockNeighborExchange(const float *sendBuffer,
+                              const vtkIdType *sendLengths,
+                              const vtkIdType *sendOffsets, float *recvBuffer,
+                              const vtkIdType *recvLengths,
+                              const vtkIdType *recvOffsets,
+                              int numberOfNeighbors, const int *neighbors,
+                              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockNeighborExchange(
+      sendBuffer, sendLengths, sendOffsets, recvBuffer, recvLengths,
+      recvOffsets, numberOfNeighbors, neighbors, req);
+  }
+  int NoBlockNeighborExchange(const double *sendBuffer,
+                              const vtkIdType *sendLengths,
+                              const vtkIdType *sendOffsets, double *recvBuffer,
+                              const vtkIdType *recvLengths,
+                              const vtkIdType *recvOffsets,
+                              int numberOfNeighbors, const int *neighbors,
+                              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockNeighborExchange(
+      sendBuffer, sendLengths, sendOffsets, recvBuffer, recvLengths,
+      recvOffsets, numberOfNeighbors, neighbors, req);
+  }
+#ifdef VTK_USE_64BIT_IDS
+  int NoBlockNeighborExchange(const vtkIdType *sendBuffer,
+                              const vtkIdType *sendLengths,
+                              const vtkIdType *sendOffsets, vtkIdType *recvBuffer,
+                              const vtkIdType *recvLengths,
+                              const vtkIdType *recvOffsets,
+                              int numberOfNeighbors, const int *neighbors,
+                              vtkCommunicator::CollectiveRequest &req) {
+    return this->Communicator->NoBlockNeighborExchange(
+      sendBuffer, sendLengths, sendOffsets, recvBuffer, recvLengths,
+      recvOffsets, numberOfNeighbors, neighbors, req);
+  }
+#endif
+//ETX
+
 // Internally implemented RMI to break the process loop.
 
 protected:
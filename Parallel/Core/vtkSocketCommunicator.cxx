@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkSocketCommunicator.h"
 
+#include "vtkAbstractArray.h"
 #include "vtkClientSocket.h"
 #include "vtkCommand.h"
 #include "vtkObjectFactory.h"
@@ -1182,6 +1183,52 @@ int vtkSocketCommunicator::AllReduceVoidArray(const void *, void *,
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+int vtkSocketCommunicator::NeighborExchangeVoidArray(
+  const void *sendBuffer, const vtkIdType *sendLengths,
+  const vtkIdType *sendOffsets, void *recvBuffer,
+  const vtkIdType *recvLengths, const vtkIdType *recvOffsets, int type,
+  int numberOfNeighbors, const int *neighbors)
+{
+  int typeSize = vtkAbstractArray::GetDataTypeSize(type);
+  for (int i = 0; i < numberOfNeighbors; i++)
+    {
+    const char *sendPtr =
+      reinterpret_cast<const char *>(sendBuffer) + sendOffsets[i]*typeSize;
+    char *recvPtr =
+      reinterpret_cast<char *>(recvBuffer) + recvOffsets[i]*typeSize;
+    if (neighbors[i] == 0)
+      {
+      if (sendLengths[i] != recvLengths[i])
+        {
+        vtkErrorMacro("A process must receive from itself what it sends.");
+        return 0;
+        }
+      memcpy(recvPtr, sendPtr, sendLengths[i]*typeSize);
+      continue;
+      }
+    for (int step = 0; step < 2; step++)
+      {
+      if ((step == 0) == (this->IsServer != 0))
+        {
+        if (sendLengths[i] > 0 &&
+            !this->SendVoidArray(sendPtr, sendLengths[i], type, neighbors[i],
+                                 NEIGHBOR_EXCHANGE_TAG))
+          {
+          return 0;
+          }
+        }
+      else if (recvLengths[i] > 0 &&
+               !this->ReceiveVoidArray(recvPtr, recvLengths[i], type,
+                                       neighbors[i], NEIGHBOR_EXCHANGE_TAG))
+        {
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
 //-----------------------------------------------------------------------------
 int vtkSocketCommunicator::GetVersion()
 {
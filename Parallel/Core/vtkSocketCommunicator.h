@@ -135,6 +135,18 @@ public:
                                  vtkIdType length, int type,
                                  Operation *operation);
 
+  // Description:
+  // Both ends of a socket are process 0 to themselves and process 1 to each
+  // other, so the server sends first.
+  virtual int NeighborExchangeVoidArray(const void *sendBuffer,
+                                        const vtkIdType *sendLengths,
+                                        const vtkIdType *sendOffsets,
+                                        void *recvBuffer,
+                                        const vtkIdType *recvLengths,
+                                        const vtkIdType *recvOffsets,
+                                        int type, int numberOfNeighbors,
+                                        const int *neighbors);
+
   // Description:
   // Set or get the PerformHandshake ivar. If it is on, the communicator
   // will try to perform a handshake when connected.
@@ -0,0 +1,167 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestNonBlockingCollectives.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME TestNonBlockingCollectives.cxx -- Tests collectives that do not block.
+//
+// .SECTION Description
+//  This test starts a reduction, a broadcast and a gather of variable
+//  lengths together, waits on all of them, and then exchanges values with
+//  the two neighbors of each process on a ring, blocking and not blocking.
+
+// VTK includes
+#include "vtkMPIController.h"
+
+// C++ includes
+#include <vector>
+
+// MPI
+#include <mpi.h>
+
+//------------------------------------------------------------------------------
+static int TestExchange(vtkMPIController* controller, bool block)
+{
+  int numProcs = controller->GetNumberOfProcesses();
+  int rank = controller->GetLocalProcessId();
+
+  // The left and right neighbors on the ring, which are the same process
+  // with 2 processes and this process with 1.
+  std::vector<int> neighbors;
+  neighbors.push_back((rank + numProcs - 1) % numProcs);
+  if (numProcs > 2)
+    {
+    neighbors.push_back((rank + 1) % numProcs);
+    }
+  int numNeighbors = static_cast<int>(neighbors.size());
+
+  // Each process sends rank + 1 values of its rank to each neighbor.
+  std::vector<vtkIdType> sendLengths(numNeighbors, rank + 1);
+  std::vector<vtkIdType> sendOffsets(numNeighbors, 0);
+  std::vector<vtkIdType> recvLengths(numNeighbors);
+  std::vector<vtkIdType> recvOffsets(numNeighbors);
+  vtkIdType total = 0;
+  for (int i = 0; i < numNeighbors; ++i)
+    {
+    recvLengths[i] = neighbors[i] + 1;
+    recvOffsets[i] = total;
+    total += recvLengths[i];
+    }
+  std::vector<int> sendValues(rank + 1, rank);
+  std::vector<int> recvValues(total, -1);
+
+  int success;
+  if (block)
+    {
+    success = controller->NeighborExchange(
+      &sendValues[0], &sendLengths[0], &sendOffsets[0],
+      &recvValues[0], &recvLengths[0], &recvOffsets[0],
+      numNeighbors, &neighbors[0]);
+    }
+  else
+    {
+    vtkCommunicator::CollectiveRequest request;
+    success = controller->NoBlockNeighborExchange(
+      &sendValues[0], &sendLengths[0], &sendOffsets[0],
+      &recvValues[0], &recvLengths[0], &recvOffsets[0],
+      numNeighbors, &neighbors[0], request);
+    success = request.Wait() && success;
+    }
+  if (!success)
+    {
+    cerr << "Neighbor exchange failed on process " << rank << "\n";
+    return 1;
+    }
+  for (int i = 0; i < numNeighbors; ++i)
+    {
+    for (vtkIdType j = 0; j < recvLengths[i]; ++j)
+      {
+      if (recvValues[recvOffsets[i] + j] != neighbors[i])
+        {
+        cerr << "Wrong value received from " << neighbors[i]
+             << " on process " << rank << "\n";
+        return 1;
+        }
+      }
+    }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+int TestNonBlockingCollectives(int argc, char *argv[])
+{
+  vtkMPIController *controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv, 0);
+
+  int numProcs = controller->GetNumberOfProcesses();
+  int rank = controller->GetLocalProcessId();
+  int errors = 0;
+
+  double value = rank + 1.0;
+  double sum = 0.0;
+  int broadcast[2] = { -1, -1 };
+  if (rank == numProcs - 1)
+    {
+    broadcast[0] = 42;
+    broadcast[1] = numProcs;
+    }
+  std::vector<vtkIdType> sendIds(rank + 1, rank);
+  std::vector<vtkIdType> recvLengths(numProcs);
+  std::vector<vtkIdType> offsets(numProcs);
+  vtkIdType total = 0;
+  for (int i = 0; i < numProcs; ++i)
+    {
+    recvLengths[i] = i + 1;
+    offsets[i] = total;
+    total += recvLengths[i];
+    }
+  std::vector<vtkIdType> recvIds(total, -1);
+
+  vtkCommunicator::CollectiveRequest requests[3];
+  int success =
+    controller->NoBlockAllReduce(&value, &sum, 1, vtkCommunicator::SUM_OP,
+                                 requests[0]) &&
+    controller->NoBlockBroadcast(broadcast, 2, numProcs - 1, requests[1]) &&
+    controller->NoBlockAllGatherV(&sendIds[0], &recvIds[0], rank + 1,
+                                  &recvLengths[0], &offsets[0], requests[2]);
+  if (!vtkCommunicator::WaitAll(3, requests) || !success)
+    {
+    cerr << "The collectives did not complete on process " << rank << "\n";
+    errors++;
+    }
+  if (sum != 0.5*numProcs*(numProcs + 1) ||
+      broadcast[0] != 42 || broadcast[1] != numProcs)
+    {
+    cerr << "Wrong reduction or broadcast on process " << rank << "\n";
+    errors++;
+    }
+  for (int i = 0; i < numProcs; ++i)
+    {
+    if (recvIds[offsets[i]] != i || recvIds[offsets[i] + i] != i)
+      {
+      cerr << "Wrong values gathered from " << i
+           << " on process " << rank << "\n";
+      errors++;
+      break;
+      }
+    }
+
+  errors += TestExchange(controller, true);
+  errors += TestExchange(controller, false);
+
+  int allErrors = 0;
+  controller->AllReduce(&errors, &allErrors, 1, vtkCommunicator::SUM_OP);
+
+  controller->Finalize();
+  controller->Delete();
+  return (allErrors != 0);
+}
@@ -304,6 +304,29 @@ int vtkMPICommunicatorNoBlockReceiveData(T* data, int length,
   return MPI_Irecv(data, length, datatype, remoteProcessId, tag,
                    *(Handle), &req.Req->Handle);
 }
+//----------------------------------------------------------------------------
+// Converts one of vtkCommunicator::StandardOperations.  Returns 0 for
+// operations MPI does not provide.
+int vtkMPICommunicatorGetMPIOp(int operation, MPI_Op *mpiOp)
+{
+  switch (operation)
+    {
+    case vtkCommunicator::MAX_OP:         *mpiOp = MPI_MAX;     break;
+    case vtkCommunicator::MIN_OP:         *mpiOp = MPI_MIN;     break;
+    case vtkCommunicator::SUM_OP:         *mpiOp = MPI_SUM;     break;
+    case vtkCommunicator::PRODUCT_OP:     *mpiOp = MPI_PROD;    break;
+    case vtkCommunicator::LOGICAL_AND_OP: *mpiOp = MPI_LAND;    break;
+    case vtkCommunicator::BITWISE_AND_OP: *mpiOp = MPI_BAND;    break;
+    case vtkCommunicator::LOGICAL_OR_OP:  *mpiOp = MPI_LOR;     break;
+    case vtkCommunicator::BITWISE_OR_OP:  *mpiOp = MPI_BOR;     break;
+    case vtkCommunicator::LOGICAL_XOR_OP: *mpiOp = MPI_LXOR;    break;
+    case vtkCommunicator::BITWISE_XOR_OP: *mpiOp = MPI_BXOR;    break;
+    default:
+      return 0;
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkMPICommunicatorReduceData(const void *sendBuffer, void *recvBuffer,
                                  vtkIdType length, int type,
@@ -1413,21 +1436,10 @@ int vtkMPICommunicator::ReduceVoidArray(const void *sendBuffer,
 {
   vtkMPICommunicatorDebugBarrier(this->MPIComm->Handle);
   MPI_Op mpiOp;
-  switch (operation)
+  if (!vtkMPICommunicatorGetMPIOp(operation, &mpiOp))
     {
-    case MAX_OP:                mpiOp = MPI_MAX;        break;
-    case MIN_OP:                mpiOp = MPI_MIN;        break;
-    case SUM_OP:                mpiOp = MPI_SUM;        break;
-    case PRODUCT_OP:            mpiOp = MPI_PROD;       break;
-    case LOGICAL_AND_OP:        mpiOp = MPI_LAND;       break;
-    case BITWISE_AND_OP:        mpiOp = MPI_BAND;       break;
-    case LOGICAL_OR_OP:         mpiOp = MPI_LOR;        break;
-    case BITWISE_OR_OP:         mpiOp = MPI_BOR;        break;
-    case LOGICAL_XOR_OP:        mpiOp = MPI_LXOR;       break;
-    case BITWISE_XOR_OP:        mpiOp = MPI_BXOR;       break;
-    default:
-      vtkWarningMacro(<< "Operation number " << operation << " not supported.");
-      return 0;
+    vtkWarningMacro(<< "Operation number " << operation << " not supported.");
+    return 0;
     }
   return CheckForMPIError(vtkMPICommunicatorReduceData(sendBuffer, recvBuffer,
                                                        length, type,
@@ -1468,21 +1480,10 @@ int vtkMPICommunicator::AllReduceVoidArray(const void *sendBuffer,
 {
   vtkMPICommunicatorDebugBarrier(this->MPIComm->Handle);
   MPI_Op mpiOp;
-  switch (operation)
+  if (!vtkMPICommunicatorGetMPIOp(operation, &mpiOp))
     {
-    case MAX_OP:         mpiOp = MPI_MAX;     break;
-    case MIN_OP:         mpiOp = MPI_MIN;     break;
-    case SUM_OP:         mpiOp = MPI_SUM;     break;
-    case PRODUCT_OP:     mpiOp = MPI_PROD;    break;
-    case LOGICAL_AND_OP: mpiOp = MPI_LAND;    break;
-    case BITWISE_AND_OP: mpiOp = MPI_BAND;    break;
-    case LOGICAL_OR_OP:  mpiOp = MPI_LOR;     break;
-    case BITWISE_OR_OP:  mpiOp = MPI_BOR;     break;
-    case LOGICAL_XOR_OP: mpiOp = MPI_LXOR;    break;
-    case BITWISE_XOR_OP: mpiOp = MPI_BXOR;    break;
-    default:
-      vtkWarningMacro(<< "Operation number " << operation << " not supported.");
-      return 0;
+    vtkWarningMacro(<< "Operation number " << operation << " not supported.");
+    return 0;
     }
   return CheckForMPIError(vtkMPICommunicatorAllReduceData(sendBuffer,
                                                           recvBuffer,
@@ -1518,6 +1519,265 @@ int vtkMPICommunicator::AllReduceVoidArray(
   return res;
 }
 
+//-----------------------------------------------------------------------------
+// The MPI requests of a collective operation in progress, with the counts
+// and offsets MPI reads until it completes.
+class vtkMPICommunicatorPendingOperation
+  : public vtkCommunicator::CollectiveRequest::Pending
+{
+public:
+  std::vector<MPI_Request> Handles;
+  std::vector<int> Counts;
+  std::vector<int> Offsets;
+
+  virtual int Wait()
+  {
+    if (this->Handles.empty())
+      {
+      return 1;
+      }
+    return this->CheckError(
+      MPI_Waitall(static_cast<int>(this->Handles.size()), &this->Handles[0],
+                  MPI_STATUSES_IGNORE));
+  }
+
+  virtual int Test(int &done)
+  {
+    done = 1;
+    if (this->Handles.empty())
+      {
+      return 1;
+      }
+    return this->CheckError(
+      MPI_Testall(static_cast<int>(this->Handles.size()), &this->Handles[0],
+                  &done, MPI_STATUSES_IGNORE));
+  }
+
+private:
+  int CheckError(int err)
+  {
+    if (err == MPI_SUCCESS)
+      {
+      return 1;
+      }
+    char *msg = vtkMPIController::ErrorString(err);
+    vtkGenericWarningMacro("MPI error occurred: " << msg);
+    delete[] msg;
+    return 0;
+  }
+};
+
+//-----------------------------------------------------------------------------
+int vtkMPICommunicator::NoBlockBroadcastVoidArray(void *data, vtkIdType length,
+                                                  int type, int srcProcessId,
+                                                  CollectiveRequest &req)
+{
+#if MPI_VERSION >= 3
+  if (!vtkMPICommunicatorCheckSize(type, length)) return 0;
+  vtkMPICommunicatorPendingOperation *pending =
+    new vtkMPICommunicatorPendingOperation;
+  pending->Handles.resize(1);
+  if (!CheckForMPIError(MPI_Ibcast(data, length,
+                                   vtkMPICommunicatorGetMPIType(type),
+                                   srcProcessId, *this->MPIComm->Handle,
+                                   &pending->Handles[0])))
+    {
+    delete pending;
+    return 0;
+    }
+  req.Start(pending);
+  return 1;
+#else
+  return this->Superclass::NoBlockBroadcastVoidArray(data, length, type,
+                                                     srcProcessId, req);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+int vtkMPICommunicator::NoBlockAllGatherVVoidArray(const void *sendBuffer,
+                                                   void *recvBuffer,
+                                                   vtkIdType sendLength,
+                                                   vtkIdType *recvLengths,
+                                                   vtkIdType *offsets,
+                                                   int type,
+                                                   CollectiveRequest &req)
+{
+#if MPI_VERSION >= 3
+  if (!vtkMPICommunicatorCheckSize(type, sendLength)) return 0;
+  vtkMPICommunicatorPendingOperation *pending =
+    new vtkMPICommunicatorPendingOperation;
+  pending->Counts.resize(this->NumberOfProcesses);
+  pending->Offsets.resize(this->NumberOfProcesses);
+  for (int i = 0; i < this->NumberOfProcesses; i++)
+    {
+    if (!vtkMPICommunicatorCheckSize(type, recvLengths[i] + offsets[i]))
+      {
+      delete pending;
+      return 0;
+      }
+    pending->Counts[i] = recvLengths[i];
+    pending->Offsets[i] = offsets[i];
+    }
+  MPI_Datatype mpiType = vtkMPICommunicatorGetMPIType(type);
+  pending->Handles.resize(1);
+  if (!CheckForMPIError(MPI_Iallgatherv(const_cast<void *>(sendBuffer),
+                                        sendLength, mpiType, recvBuffer,
+                                        &pending->Counts[0],
+                                        &pending->Offsets[0], mpiType,
+                                        *this->MPIComm->Handle,
+                                        &pending->Handles[0])))
+    {
+    delete pending;
+    return 0;
+    }
+  req.Start(pending);
+  return 1;
+#else
+  return this->Superclass::NoBlockAllGatherVVoidArray(sendBuffer, recvBuffer,
+                                                      sendLength, recvLengths,
+                                                      offsets, type, req);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+int vtkMPICommunicator::NoBlockAllReduceVoidArray(const void *sendBuffer,
+                                                  void *recvBuffer,
+                                                  vtkIdType length, int type,
+                                                  int operation,
+                                                  CollectiveRequest &req)
+{
+#if MPI_VERSION >= 3
+  MPI_Op mpiOp;
+  if (!vtkMPICommunicatorGetMPIOp(operation, &mpiOp))
+    {
+    vtkWarningMacro(<< "Operation number " << operation << " not supported.");
+    return 0;
+    }
+  if (!vtkMPICommunicatorCheckSize(type, length)) return 0;
+  vtkMPICommunicatorPendingOperation *pending =
+    new vtkMPICommunicatorPendingOperation;
+  pending->Handles.resize(1);
+  if (!CheckForMPIError(MPI_Iallreduce(const_cast<void *>(sendBuffer),
+                                       recvBuffer, length,
+                                       vtkMPICommunicatorGetMPIType(type),
+                                       mpiOp, *this->MPIComm->Handle,
+                                       &pending->Handles[0])))
+    {
+    delete pending;
+    return 0;
+    }
+  req.Start(pending);
+  return 1;
+#else
+  return this->Superclass::NoBlockAllReduceVoidArray(sendBuffer, recvBuffer,
+                                                     length, type, operation,
+                                                     req);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+int vtkMPICommunicator::NoBlockNeighborExchangeVoidArray(
+  const void *sendBuffer, const vtkIdType *sendLengths,
+  const vtkIdType *sendOffsets, void *recvBuffer,
+  const vtkIdType *recvLengths, const vtkIdType *recvOffsets, int type,
+  int numberOfNeighbors, const int *neighbors, CollectiveRequest &req)
+{
+  int typeSize;
+  switch(type)
+    {
+    vtkTemplateMacro(typeSize = sizeof(VTK_TT));
+    default:
+      vtkWarningMacro(<< "Invalid data type " << type);
+      return 0;
+    }
+  MPI_Datatype mpiType = vtkMPICommunicatorGetMPIType(type);
+  const char *sendBytes = static_cast<const char *>(sendBuffer);
+  char *recvBytes = static_cast<char *>(recvBuffer);
+
+  // Receives are posted before sends so that messages do not have to be
+  // buffered.
+  vtkMPICommunicatorPendingOperation *pending =
+    new vtkMPICommunicatorPendingOperation;
+  pending->Handles.reserve(2*numberOfNeighbors);
+  int result = 1;
+  for (int i = 0; i < numberOfNeighbors && result; i++)
+    {
+    if (neighbors[i] == this->LocalProcessId || recvLengths[i] < 1)
+      {
+      continue;
+      }
+    MPI_Request handle;
+    result = (vtkMPICommunicatorCheckSize(type, recvLengths[i]) &&
+              CheckForMPIError(MPI_Irecv(recvBytes + recvOffsets[i]*typeSize,
+                                         recvLengths[i], mpiType,
+                                         neighbors[i], NEIGHBOR_EXCHANGE_TAG,
+                                         *this->MPIComm->Handle, &handle)));
+    if (result)
+      {
+      pending->Handles.push_back(handle);
+      }
+    }
+  for (int i = 0; i < numberOfNeighbors && result; i++)
+    {
+    const char *sendPtr = sendBytes + sendOffsets[i]*typeSize;
+    if (neighbors[i] == this->LocalProcessId)
+      {
+      if (sendLengths[i] != recvLengths[i])
+        {
+        vtkErrorMacro("A process must receive from itself what it sends.");
+        result = 0;
+        break;
+        }
+      memcpy(recvBytes + recvOffsets[i]*typeSize, sendPtr,
+             sendLengths[i]*typeSize);
+      continue;
+      }
+    if (sendLengths[i] < 1)
+      {
+      continue;
+      }
+    MPI_Request handle;
+    result = (vtkMPICommunicatorCheckSize(type, sendLengths[i]) &&
+              CheckForMPIError(MPI_Isend(const_cast<char *>(sendPtr),
+                                         sendLengths[i], mpiType,
+                                         neighbors[i], NEIGHBOR_EXCHANGE_TAG,
+                                         *this->MPIComm->Handle, &handle)));
+    if (result)
+      {
+      pending->Handles.push_back(handle);
+      }
+    }
+  if (!result)
+    {
+    // Do not leave messages in flight to buffers the caller may free.
+    for (size_t i = 0; i < pending->Handles.size(); i++)
+      {
+      MPI_Cancel(&pending->Handles[i]);
+      }
+    pending->Wait();
+    delete pending;
+    return 0;
+    }
+  req.Start(pending);
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+int vtkMPICommunicator::NeighborExchangeVoidArray(
+  const void *sendBuffer, const vtkIdType *sendLengths,
+  const vtkIdType *sendOffsets, void *recvBuffer,
+  const vtkIdType *recvLengths, const vtkIdType *recvOffsets, int type,
+  int numberOfNeighbors, const int *neighbors)
+{
+  CollectiveRequest req;
+  return (this->NoBlockNeighborExchangeVoidArray(sendBuffer, sendLengths,
+                                                 sendOffsets, recvBuffer,
+                                                 recvLengths, recvOffsets,
+                                                 type, numberOfNeighbors,
+                                                 neighbors, req) &&
+          req.Wait());
+}
+
 //-----------------------------------------------------------------------------
 int vtkMPICommunicator::WaitAll(const int count, Request requests[])
 {
@@ -179,6 +179,45 @@ public:
   virtual int AllReduceVoidArray(const void *sendBuffer, void *recvBuffer,
                                  vtkIdType length, int type,
                                  Operation *operation);
+  virtual int NeighborExchangeVoidArray(const void *sendBuffer,
+                                        const vtkIdType *sendLengths,
+                                        const vtkIdType *sendOffsets,
+                                        void *recvBuffer,
+                                        const vtkIdType *recvLengths,
+                                        const vtkIdType *recvOffsets,
+                                        int type, int numberOfNeighbors,
+                                        const int *neighbors);
+
+//BTX
+  // Description:
+  // Collective operations that do not block.  Broadcast, AllGatherV and
+  // AllReduce use the nonblocking MPI collectives when MPI provides them
+  // and block otherwise.  The neighbor exchange posts a receive and a send
+  // per neighbor.
+  virtual int NoBlockBroadcastVoidArray(void *data, vtkIdType length,
+                                        int type, int srcProcessId,
+                                        CollectiveRequest &req);
+  virtual int NoBlockAllGatherVVoidArray(const void *sendBuffer,
+                                         void *recvBuffer,
+                                         vtkIdType sendLength,
+                                         vtkIdType *recvLengths,
+                                         vtkIdType *offsets, int type,
+                                         CollectiveRequest &req);
+  virtual int NoBlockAllReduceVoidArray(const void *sendBuffer,
+                                        void *recvBuffer, vtkIdType length,
+                                        int type, int operation,
+                                        CollectiveRequest &req);
+  virtual int NoBlockNeighborExchangeVoidArray(const void *sendBuffer,
+                                               const vtkIdType *sendLengths,
+                                               const vtkIdType *sendOffsets,
+                                               void *recvBuffer,
+                                               const vtkIdType *recvLengths,
+                                               const vtkIdType *recvOffsets,
+                                               int type,
+                                               int numberOfNeighbors,
+                                               const int *neighbors,
+                                               CollectiveRequest &req);
+//ETX
 
   // Description:
   // Nonblocking test for a message.  Inputs are: source -- the source rank
@@ -204,6 +243,12 @@ public:
   // Given the request objects of a set of non-blocking operations
   // (send and/or receive) this method blocks until all requests are complete.
   int WaitAll(const int count, Request requests[]);
+//BTX
+  int WaitAll(const int count, CollectiveRequest requests[])
+    {
+    return this->Superclass::WaitAll(count, requests);
+    }
+//ETX
 
   // Description:
   // Blocks until *one* of the specified requests in the given request array
@@ -0,0 +1,272 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestRadixKCompositer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME TestRadixKCompositer.cxx -- Composites synthetic images with
+//  binary-swap and radix-k.
+//
+// .SECTION Description
+//  Each process makes an image where a disc of pixels, placed by its
+//  process id, is active.  The images are composited in the Z-buffer and
+//  the alpha-blending modes for several radices and pixel formats, and
+//  process 0 checks the result against the images of all processes
+//  composited one after the other.  The image size can be given with
+//  --width and --height, for example to composite 3840x2160 frames on
+//  many processes with mpirun.
+
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkRadixKCompositer.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+int Width = 160;
+int Height = 120;
+
+//------------------------------------------------------------------------------
+unsigned int Hash(unsigned int a, unsigned int b)
+{
+  unsigned int h = a * 2654435761u ^ (b + 0x9e3779b9u + (a << 6) + (a >> 2));
+  h ^= h >> 15;
+  h *= 2246822519u;
+  h ^= h >> 13;
+  return h;
+}
+
+//------------------------------------------------------------------------------
+// The pixels of a process: active inside its disc, with a depth that no
+// other process shares and a random premultiplied color.
+bool IsActive(int rank, int numProcs, vtkIdType pixel)
+{
+  const double angle = 6.2831853 * rank / numProcs;
+  const double cx = Width * (0.5 + 0.25 * std::cos(angle));
+  const double cy = Height * (0.5 + 0.25 * std::sin(angle));
+  const double x = static_cast<double>(pixel % Width) - cx;
+  const double y = static_cast<double>(pixel / Width) - cy;
+  const double radius = 0.3 * (Width < Height ? Width : Height);
+  return x*x + y*y < radius*radius;
+}
+
+float Depth(int rank, int numProcs, vtkIdType pixel)
+{
+  if (!IsActive(rank, numProcs, pixel))
+    {
+    return 1.0f;
+    }
+  const unsigned int h = Hash(static_cast<unsigned int>(pixel), rank) % 4096;
+  return static_cast<float>(h * numProcs + rank) /
+    static_cast<float>(4096 * numProcs + 1);
+}
+
+void Color(int rank, int numProcs, vtkIdType pixel, double rgba[4])
+{
+  if (!IsActive(rank, numProcs, pixel))
+    {
+    rgba[0] = rgba[1] = rgba[2] = rgba[3] = 0.0;
+    return;
+    }
+  const unsigned int h = Hash(rank, static_cast<unsigned int>(pixel));
+  rgba[3] = (h % 256) / 255.0;
+  for (int c = 0; c < 3; c++)
+    {
+    rgba[c] = rgba[3] * ((h >> (8 * (c + 1))) % 256) / 255.0;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Fills the buffers of a process.
+void FillImage(int rank, int numProcs, vtkDataArray* colors,
+               vtkFloatArray* depths, bool useChar)
+{
+  const int numComp = colors->GetNumberOfComponents();
+  const vtkIdType numPixels = colors->GetNumberOfTuples();
+  for (vtkIdType i = 0; i < numPixels; i++)
+    {
+    double rgba[4];
+    Color(rank, numProcs, i, rgba);
+    for (int c = 0; c < numComp; c++)
+      {
+      colors->SetComponent(i, c, useChar ?
+                           std::floor(255.0 * rgba[c] + 0.5) : rgba[c]);
+      }
+    depths->SetValue(i, Depth(rank, numProcs, i));
+    }
+}
+
+//------------------------------------------------------------------------------
+// Composites the pixel of all processes one after the other.
+void ExpectedPixel(int numProcs, bool blend, const std::vector<int>& order,
+                   bool useChar, vtkIdType pixel, double rgba[4],
+                   float& depth)
+{
+  depth = 1.0f;
+  rgba[0] = rgba[1] = rgba[2] = rgba[3] = 0.0;
+  for (int p = 0; p < numProcs; p++)
+    {
+    const int rank = order[p];
+    double color[4];
+    Color(rank, numProcs, pixel, color);
+    if (useChar)
+      {
+      for (int c = 0; c < 4; c++)
+        {
+        color[c] = std::floor(255.0 * color[c] + 0.5) / 255.0;
+        }
+      }
+    if (blend)
+      {
+      const double transparency = 1.0 - rgba[3];
+      for (int c = 0; c < 4; c++)
+        {
+        rgba[c] += transparency * color[c];
+        }
+      }
+    else
+      {
+      const float z = Depth(rank, numProcs, pixel);
+      if (z < depth)
+        {
+        depth = z;
+        memcpy(rgba, color, sizeof(color));
+        }
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+int CheckComposite(vtkMPIController* controller, vtkRadixKCompositer* comp,
+                   bool useChar, int numComp, bool blend, bool reverse)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+  const vtkIdType numPixels = static_cast<vtkIdType>(Width) * Height;
+
+  vtkDataArray* colors = useChar ?
+    static_cast<vtkDataArray*>(vtkUnsignedCharArray::New()) :
+    static_cast<vtkDataArray*>(vtkFloatArray::New());
+  vtkDataArray* colorsTmp = colors->NewInstance();
+  colors->SetNumberOfComponents(numComp);
+  colors->SetNumberOfTuples(numPixels);
+  colorsTmp->SetNumberOfComponents(numComp);
+  colorsTmp->SetNumberOfTuples(numPixels);
+  vtkFloatArray* depths = vtkFloatArray::New();
+  vtkFloatArray* depthsTmp = vtkFloatArray::New();
+  depths->SetNumberOfTuples(numPixels);
+  depthsTmp->SetNumberOfTuples(numPixels);
+  FillImage(rank, numProcs, colors, depths, useChar);
+
+  std::vector<int> order(numProcs);
+  vtkIntArray* processOrder = vtkIntArray::New();
+  for (int p = 0; p < numProcs; p++)
+    {
+    order[p] = reverse ? numProcs - 1 - p : p;
+    processOrder->InsertNextValue(order[p]);
+    }
+  comp->SetProcessOrder(reverse ? processOrder : NULL);
+  comp->SetCompositeMode(blend ? vtkRadixKCompositer::ALPHA_BLEND :
+                         vtkRadixKCompositer::Z_BUFFER);
+  comp->CompositeBuffer(colors, depths, colorsTmp, depthsTmp);
+
+  // Blending 8 bit colors in another order rounds differently.
+  const double tolerance = useChar ? (blend ? 0.5 + numProcs : 0.5) : 1e-5;
+  const double scale = useChar ? 255.0 : 1.0;
+  int errors = 0;
+  if (rank == 0)
+    {
+    // Check a subset of the pixels of large images.
+    const vtkIdType step = 1 + (numPixels * numProcs) / (1 << 24);
+    for (vtkIdType i = 0; i < numPixels && errors == 0; i += step)
+      {
+      double rgba[4];
+      float depth;
+      ExpectedPixel(numProcs, blend, order, useChar, i, rgba, depth);
+      for (int c = 0; c < numComp; c++)
+        {
+        if (std::fabs(colors->GetComponent(i, c) - scale * rgba[c]) >
+            tolerance)
+          {
+          cerr << "[ERROR]: pixel " << i << " component " << c << " is "
+               << colors->GetComponent(i, c) << " instead of "
+               << scale * rgba[c] << " (radix " << comp->GetRadix()
+               << (blend ? ", blend" : ", z-buffer") << ")" << endl;
+          errors++;
+          break;
+          }
+        }
+      if (!blend && depths->GetValue(i) != depth)
+        {
+        cerr << "[ERROR]: pixel " << i << " has depth "
+             << depths->GetValue(i) << " instead of " << depth << endl;
+        errors++;
+        }
+      }
+    }
+
+  processOrder->Delete();
+  colors->Delete();
+  colorsTmp->Delete();
+  depths->Delete();
+  depthsTmp->Delete();
+  return errors;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestRadixKCompositer(int argc, char* argv[])
+{
+  vtkMPIController* controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv, 0);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  for (int i = 1; i + 1 < argc; i++)
+    {
+    if (strcmp(argv[i], "--width") == 0)
+      {
+      Width = atoi(argv[i + 1]);
+      }
+    else if (strcmp(argv[i], "--height") == 0)
+      {
+      Height = atoi(argv[i + 1]);
+      }
+    }
+
+  vtkRadixKCompositer* comp = vtkRadixKCompositer::New();
+  comp->SetController(controller);
+
+  int errors = 0;
+  const int radices[3] = { 2, 3, 8 };
+  for (int r = 0; r < 3; r++)
+    {
+    comp->SetRadix(radices[r]);
+    errors += CheckComposite(controller, comp, true, 4, false, false);
+    errors += CheckComposite(controller, comp, true, 3, false, false);
+    errors += CheckComposite(controller, comp, false, 4, false, false);
+    errors += CheckComposite(controller, comp, true, 4, true, false);
+    errors += CheckComposite(controller, comp, false, 4, true, true);
+    }
+
+  int allErrors = 0;
+  controller->AllReduce(&errors, &allErrors, 1, vtkCommunicator::SUM_OP);
+
+  comp->Delete();
+  controller->Finalize();
+  controller->Delete();
+  return (allErrors != 0);
+}
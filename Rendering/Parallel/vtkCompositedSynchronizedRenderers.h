@@ -35,6 +35,8 @@ public:
 
   // Description:
   // Get/Set the composite. vtkTreeCompositer is used by default.
+  // vtkRadixKCompositer spreads the work over all processes and scales
+  // better to many processes and large images.
   void SetCompositer(vtkCompositer*);
   vtkGetObjectMacro(Compositer, vtkCompositer);
 
@@ -0,0 +1,554 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkRadixKCompositer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkRadixKCompositer.h"
+#include "vtkObjectFactory.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMultiProcessController.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+vtkStandardNewMacro(vtkRadixKCompositer);
+vtkCxxSetObjectMacro(vtkRadixKCompositer, ProcessOrder, vtkIntArray);
+
+//-------------------------------------------------------------------------
+vtkRadixKCompositer::vtkRadixKCompositer()
+{
+  this->Radix = 8;
+  this->CompositeMode = vtkRadixKCompositer::Z_BUFFER;
+  this->ProcessOrder = NULL;
+}
+
+//-------------------------------------------------------------------------
+vtkRadixKCompositer::~vtkRadixKCompositer()
+{
+  this->SetProcessOrder(NULL);
+}
+
+namespace
+{
+//-------------------------------------------------------------------------
+// Factors the number of processes into the sizes of the groups of each
+// round: the largest divisor not above the radix, or else the smallest
+// prime factor.
+void vtkRadixKFactor(int numProcs, int radix, std::vector<int> &factors)
+{
+  factors.clear();
+  while (numProcs > 1)
+    {
+    int k = std::min(radix, numProcs);
+    while (numProcs % k)
+      {
+      k--;
+      }
+    if (k == 1)
+      {
+      k = radix + 1;
+      while (numProcs % k)
+        {
+        k++;
+        }
+      }
+    factors.push_back(k);
+    numProcs /= k;
+    }
+}
+
+//-------------------------------------------------------------------------
+// The bytes of a piece are padded so that the depths of the next piece
+// stay aligned.
+inline vtkIdType vtkRadixKPad(vtkIdType size)
+{
+  return (size + 7) & ~static_cast<vtkIdType>(7);
+}
+
+//-------------------------------------------------------------------------
+// The range of pixels that a position in the compositing order holds after
+// the given number of rounds.
+void vtkRadixKSpan(int position, const std::vector<int> &factors,
+                   size_t numRounds, vtkIdType totalPixels,
+                   vtkIdType &begin, vtkIdType &end)
+{
+  begin = 0;
+  end = totalPixels;
+  int stride = 1;
+  for (size_t round = 0; round < numRounds; round++)
+    {
+    int k = factors[round];
+    int digit = (position / stride) % k;
+    vtkIdType length = end - begin;
+    end = begin + (length * (digit + 1)) / k;
+    begin = begin + (length * digit) / k;
+    stride *= k;
+    }
+}
+
+//-------------------------------------------------------------------------
+// Finds the first and one past the last active pixel of a range.
+template <class T>
+void vtkRadixKActiveRange(const T *color, const float *depth, int numComp,
+                          int blend, vtkIdType begin, vtkIdType end,
+                          vtkIdType &first, vtkIdType &last)
+{
+  first = begin;
+  last = end;
+  if (blend)
+    {
+    while (first < last && color[first*numComp + 3] == 0)
+      {
+      first++;
+      }
+    while (last > first && color[(last - 1)*numComp + 3] == 0)
+      {
+      last--;
+      }
+    }
+  else
+    {
+    while (first < last && depth[first] >= 1.0f)
+      {
+      first++;
+      }
+    while (last > first && depth[last - 1] >= 1.0f)
+      {
+      last--;
+      }
+    }
+}
+
+//-------------------------------------------------------------------------
+// Keeps the nearer of the local and the remote pixels.
+template <class T>
+class vtkRadixKZComposite
+{
+public:
+  T *LocalColor;
+  float *LocalDepth;
+  const T *RemoteColor;
+  const float *RemoteDepth;
+  int NumberOfComponents;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const int numComp = this->NumberOfComponents;
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      if (this->RemoteDepth[i] < this->LocalDepth[i])
+        {
+        this->LocalDepth[i] = this->RemoteDepth[i];
+        for (int c = 0; c < numComp; c++)
+          {
+          this->LocalColor[i*numComp + c] = this->RemoteColor[i*numComp + c];
+          }
+        }
+      }
+  }
+};
+
+//-------------------------------------------------------------------------
+// Blends the remote pixels behind the local ones.  The colors are RGBA
+// with premultiplied alpha.
+inline void vtkRadixKOver(unsigned char *front, const unsigned char *back)
+{
+  const unsigned int transparency = 255 - front[3];
+  for (int c = 0; c < 4; c++)
+    {
+    const unsigned int value =
+      front[c] + (transparency * back[c] + 127) / 255;
+    front[c] = static_cast<unsigned char>(std::min(value, 255u));
+    }
+}
+
+inline void vtkRadixKOver(float *front, const float *back)
+{
+  const float transparency = 1.0f - front[3];
+  for (int c = 0; c < 4; c++)
+    {
+    front[c] += transparency * back[c];
+    }
+}
+
+template <class T>
+class vtkRadixKBlend
+{
+public:
+  T *Front;
+  const T *Back;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      vtkRadixKOver(this->Front + 4*i, this->Back + 4*i);
+      }
+  }
+};
+
+//-------------------------------------------------------------------------
+// The pixels of one process, received or local, over a part of the image.
+struct vtkRadixKPiece
+{
+  vtkIdType First;
+  vtkIdType Last;
+  const char *Color;
+  const float *Depth;
+};
+
+//-------------------------------------------------------------------------
+template <class T>
+void vtkRadixKCompositePieces(T *color, float *depth, T *scratch,
+                              int numComp, int blend,
+                              vtkIdType begin, vtkIdType end,
+                              const std::vector<vtkRadixKPiece> &pieces)
+{
+  const vtkIdType grain = 16384;
+  if (!blend)
+    {
+    for (size_t p = 0; p < pieces.size(); p++)
+      {
+      const vtkRadixKPiece &piece = pieces[p];
+      if (piece.Color == NULL || piece.Last <= piece.First)
+        {
+        continue;
+        }
+      vtkRadixKZComposite<T> composite;
+      composite.LocalColor = color + piece.First*numComp;
+      composite.LocalDepth = depth + piece.First;
+      composite.RemoteColor = reinterpret_cast<const T*>(piece.Color);
+      composite.RemoteDepth = piece.Depth;
+      composite.NumberOfComponents = numComp;
+      vtkSMPTools::For(0, piece.Last - piece.First, grain, composite);
+      }
+    return;
+    }
+
+  // Blend front to back in the scratch buffer, starting from transparent
+  // black, and copy the result back.  The local pixels are the piece with
+  // no buffer of their own.
+  std::fill(scratch + begin*numComp, scratch + end*numComp, T(0));
+  for (size_t p = 0; p < pieces.size(); p++)
+    {
+    const vtkRadixKPiece &piece = pieces[p];
+    if (piece.Last <= piece.First)
+      {
+      continue;
+      }
+    vtkRadixKBlend<T> over;
+    over.Front = scratch + piece.First*numComp;
+    over.Back = piece.Color ? reinterpret_cast<const T*>(piece.Color) :
+      color + piece.First*numComp;
+    vtkSMPTools::For(0, piece.Last - piece.First, grain, over);
+    }
+  std::copy(scratch + begin*numComp, scratch + end*numComp,
+            color + begin*numComp);
+}
+}
+
+//-------------------------------------------------------------------------
+void vtkRadixKCompositer::CompositeBuffer(vtkDataArray *pBuf,
+                                          vtkFloatArray *zBuf,
+                                          vtkDataArray *pTmp,
+                                          vtkFloatArray *zTmp)
+{
+  int numProcs = this->NumberOfProcesses;
+  if (numProcs <= 1 || !this->Controller)
+    {
+    return;
+    }
+  if (numProcs != this->Controller->GetNumberOfProcesses())
+    {
+    vtkErrorMacro("NumberOfProcesses (" << numProcs << ") must be the number "
+                  "of processes of the controller ("
+                  << this->Controller->GetNumberOfProcesses() << ").");
+    return;
+    }
+
+  int myId = this->Controller->GetLocalProcessId();
+  int numComp = pBuf->GetNumberOfComponents();
+  int useChar = (pBuf->GetDataType() == VTK_UNSIGNED_CHAR);
+  int blend = (this->CompositeMode == vtkRadixKCompositer::ALPHA_BLEND);
+  vtkIdType totalPixels = pBuf->GetNumberOfTuples();
+
+  if (!useChar && pBuf->GetDataType() != VTK_FLOAT)
+    {
+    vtkErrorMacro("Colors must be unsigned char or float.");
+    return;
+    }
+  if (blend && numComp != 4)
+    {
+    vtkErrorMacro("Alpha blending requires RGBA colors.");
+    return;
+    }
+
+  // The position of each process in the compositing order.  Only blending
+  // depends on it.
+
+  std::vector<int> order(numProcs);
+  for (int i = 0; i < numProcs; i++)
+    {
+    order[i] = i;
+    }
+  if (blend && this->ProcessOrder &&
+      this->ProcessOrder->GetNumberOfTuples() == numProcs)
+    {
+    std::vector<int> seen(numProcs, 0);
+    int valid = 1;
+    for (int i = 0; valid && i < numProcs; i++)
+      {
+      int id = this->ProcessOrder->GetValue(i);
+      valid = (id >= 0 && id < numProcs && !seen[id]);
+      if (valid)
+        {
+        seen[id] = 1;
+        order[i] = id;
+        }
+      }
+    if (!valid)
+      {
+      vtkErrorMacro("ProcessOrder is not an order of the processes.");
+      return;
+      }
+    }
+  int position = static_cast<int>(
+    std::find(order.begin(), order.end(), myId) - order.begin());
+
+  std::vector<int> factors;
+  vtkRadixKFactor(numProcs, this->Radix, factors);
+
+  const int colorSize = numComp *
+    static_cast<int>(useChar ? sizeof(unsigned char) : sizeof(float));
+  const int pixelSize =
+    colorSize + (blend ? 0 : static_cast<int>(sizeof(float)));
+
+  char *color = static_cast<char*>(pBuf->GetVoidPointer(0));
+  float *depth = zBuf->GetPointer(0);
+
+  vtkIdType begin = 0;
+  vtkIdType end = totalPixels;
+  int stride = 1;
+
+  for (size_t round = 0; round < factors.size(); round++)
+    {
+    const int k = factors[round];
+    const int digit = (position / stride) % k;
+    const vtkIdType length = end - begin;
+
+    std::vector<vtkIdType> pieceBegin(k + 1);
+    for (int j = 0; j <= k; j++)
+      {
+      pieceBegin[j] = begin + (length * j) / k;
+      }
+
+    // The other members of the group, in the compositing order.
+
+    const int numNeighbors = k - 1;
+    std::vector<int> neighbors;
+    std::vector<int> members;
+    for (int m = 0; m < k; m++)
+      {
+      if (m != digit)
+        {
+        neighbors.push_back(order[position + (m - digit) * stride]);
+        members.push_back(m);
+        }
+      }
+
+    // Send the active range of the piece each neighbor composites, then
+    // the depths and colors of that range.
+
+    std::vector<int> sendRanges(2*numNeighbors);
+    std::vector<int> recvRanges(2*numNeighbors);
+    std::vector<vtkIdType> rangeLengths(numNeighbors, 2);
+    std::vector<vtkIdType> rangeOffsets(numNeighbors);
+    std::vector<vtkIdType> sendLengths(numNeighbors);
+    std::vector<vtkIdType> sendOffsets(numNeighbors);
+    vtkIdType sendTotal = 0;
+
+    for (int n = 0; n < numNeighbors; n++)
+      {
+      vtkIdType first, last;
+      if (useChar)
+        {
+        vtkRadixKActiveRange(reinterpret_cast<unsigned char*>(color), depth,
+                             numComp, blend, pieceBegin[members[n]],
+                             pieceBegin[members[n] + 1], first, last);
+        }
+      else
+        {
+        vtkRadixKActiveRange(reinterpret_cast<float*>(color), depth,
+                             numComp, blend, pieceBegin[members[n]],
+                             pieceBegin[members[n] + 1], first, last);
+        }
+      sendRanges[2*n] = static_cast<int>(first - pieceBegin[members[n]]);
+      sendRanges[2*n + 1] = static_cast<int>(last - pieceBegin[members[n]]);
+      rangeOffsets[n] = 2*n;
+      sendOffsets[n] = sendTotal;
+      sendLengths[n] = vtkRadixKPad((last - first) * pixelSize);
+      sendTotal += sendLengths[n];
+      }
+
+    if (!this->Controller->NeighborExchange(
+          &sendRanges[0], &rangeLengths[0], &rangeOffsets[0],
+          &recvRanges[0], &rangeLengths[0], &rangeOffsets[0],
+          numNeighbors, &neighbors[0]))
+      {
+      vtkErrorMacro("Could not exchange the active pixel ranges.");
+      return;
+      }
+
+    std::vector<char> sendBuffer(sendTotal > 0 ? sendTotal : 1);
+    for (int n = 0; n < numNeighbors; n++)
+      {
+      vtkIdType first = pieceBegin[members[n]] + sendRanges[2*n];
+      vtkIdType count = sendRanges[2*n + 1] - sendRanges[2*n];
+      char *out = &sendBuffer[0] + sendOffsets[n];
+      if (!blend)
+        {
+        memcpy(out, depth + first, count * sizeof(float));
+        out += count * sizeof(float);
+        }
+      memcpy(out, color + first * colorSize, count * colorSize);
+      }
+
+    const vtkIdType myBegin = pieceBegin[digit];
+    const vtkIdType myEnd = pieceBegin[digit + 1];
+    std::vector<vtkIdType> recvLengths(numNeighbors);
+    std::vector<vtkIdType> recvOffsets(numNeighbors);
+    vtkIdType recvTotal = 0;
+    for (int n = 0; n < numNeighbors; n++)
+      {
+      recvOffsets[n] = recvTotal;
+      recvLengths[n] =
+        vtkRadixKPad((recvRanges[2*n + 1] - recvRanges[2*n]) * pixelSize);
+      recvTotal += recvLengths[n];
+      }
+    std::vector<char> recvBuffer(recvTotal > 0 ? recvTotal : 1);
+
+    if (!this->Controller->NeighborExchange(
+          &sendBuffer[0], &sendLengths[0], &sendOffsets[0],
+          &recvBuffer[0], &recvLengths[0], &recvOffsets[0],
+          numNeighbors, &neighbors[0]))
+      {
+      vtkErrorMacro("Could not exchange the pixels.");
+      return;
+      }
+    std::vector<char>().swap(sendBuffer);
+
+    // Composite the pieces of the group in order; the local one is the
+    // piece without a buffer.
+
+    std::vector<vtkRadixKPiece> pieces(k);
+    for (int m = 0, n = 0; m < k; m++)
+      {
+      vtkRadixKPiece &piece = pieces[m];
+      if (m == digit)
+        {
+        piece.First = myBegin;
+        piece.Last = myEnd;
+        piece.Color = NULL;
+        piece.Depth = NULL;
+        continue;
+        }
+      piece.First = myBegin + recvRanges[2*n];
+      piece.Last = myBegin + recvRanges[2*n + 1];
+      const char *in = &recvBuffer[0] + recvOffsets[n];
+      piece.Depth = blend ? NULL : reinterpret_cast<const float*>(in);
+      piece.Color = blend ? in :
+        in + (piece.Last - piece.First) * sizeof(float);
+      n++;
+      }
+
+    if (useChar)
+      {
+      vtkRadixKCompositePieces(
+        reinterpret_cast<unsigned char*>(color), depth,
+        static_cast<unsigned char*>(pTmp->GetVoidPointer(0)),
+        numComp, blend, myBegin, myEnd, pieces);
+      }
+    else
+      {
+      vtkRadixKCompositePieces(
+        reinterpret_cast<float*>(color), depth,
+        static_cast<float*>(pTmp->GetVoidPointer(0)),
+        numComp, blend, myBegin, myEnd, pieces);
+      }
+
+    begin = myBegin;
+    end = myEnd;
+    stride *= k;
+    }
+
+  // Process 0 gathers the composited pieces in place.
+
+  std::vector<vtkIdType> colorLengths(numProcs);
+  std::vector<vtkIdType> colorOffsets(numProcs);
+  std::vector<vtkIdType> depthLengths(numProcs);
+  std::vector<vtkIdType> depthOffsets(numProcs);
+  for (int p = 0; p < numProcs; p++)
+    {
+    vtkIdType b, e;
+    vtkRadixKSpan(p, factors, factors.size(), totalPixels, b, e);
+    colorLengths[order[p]] = (e - b) * colorSize;
+    colorOffsets[order[p]] = b * colorSize;
+    depthLengths[order[p]] = (e - b) * static_cast<vtkIdType>(sizeof(float));
+    depthOffsets[order[p]] = b * static_cast<vtkIdType>(sizeof(float));
+    }
+
+  char *colorResult = static_cast<char*>(pTmp->GetVoidPointer(0));
+  if (!this->Controller->GatherV(color + begin * colorSize, colorResult,
+                                 (end - begin) * colorSize, &colorLengths[0],
+                                 &colorOffsets[0], 0))
+    {
+    vtkErrorMacro("Could not gather the image.");
+    return;
+    }
+  if (!blend)
+    {
+    char *depthResult = reinterpret_cast<char*>(zTmp->GetPointer(0));
+    if (!this->Controller->GatherV(
+          reinterpret_cast<char*>(depth + begin), depthResult,
+          (end - begin) * static_cast<vtkIdType>(sizeof(float)),
+          &depthLengths[0], &depthOffsets[0], 0))
+      {
+      vtkErrorMacro("Could not gather the depth buffer.");
+      return;
+      }
+    }
+
+  if (myId == 0)
+    {
+    memcpy(color, colorResult, totalPixels * colorSize);
+    if (!blend)
+      {
+      memcpy(depth, zTmp->GetPointer(0), totalPixels * sizeof(float));
+      }
+    }
+}
+
+//-------------------------------------------------------------------------
+void vtkRadixKCompositer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Radix: " << this->Radix << endl;
+  os << indent << "CompositeMode: "
+     << (this->CompositeMode == vtkRadixKCompositer::ALPHA_BLEND ?
+         "AlphaBlend" : "ZBuffer") << endl;
+  os << indent << "ProcessOrder: " << this->ProcessOrder << endl;
+}
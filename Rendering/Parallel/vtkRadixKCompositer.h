@@ -0,0 +1,105 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkRadixKCompositer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkRadixKCompositer - Implements radix-k and binary-swap compositing.
+//
+// .SECTION Description
+// vtkRadixKCompositer composites the images of all processes by dividing
+// the image among them, so that no process handles more than its share of
+// the pixels.  The number of processes is factored into rounds of at most
+// Radix processes (a factor that is a prime larger than Radix is used as
+// is).  In each round, the processes of a group split the part of the
+// image they hold into as many pieces, exchange them, and each composites
+// one piece.  A Radix of 2 gives binary-swap compositing.  At the end,
+// process 0 gathers the pieces into the final image.  All the processes
+// of the controller take part, so NumberOfProcesses must be left to the
+// number of processes of the controller.
+//
+// Only the bounding range of the active pixels of each piece is sent: the
+// pixels nearer than the far plane in the Z-buffer mode, the pixels with a
+// nonzero alpha in the alpha-blending mode.  The pixels are composited
+// with vtkSMPTools.
+//
+// In the alpha-blending mode, the colors must be RGBA with the alpha
+// premultiplied, and they are blended with the "over" operator in the
+// front to back order of the processes given by ProcessOrder.  The depth
+// buffer is then ignored.
+//
+// .SECTION See Also
+// vtkTreeCompositer vtkCompressCompositer vtkCompositedSynchronizedRenderers
+
+#ifndef __vtkRadixKCompositer_h
+#define __vtkRadixKCompositer_h
+
+#include "vtkRenderingParallelModule.h" // For export macro
+#include "vtkCompositer.h"
+
+class vtkIntArray;
+
+class VTKRENDERINGPARALLEL_EXPORT vtkRadixKCompositer : public vtkCompositer
+{
+public:
+  static vtkRadixKCompositer *New();
+  vtkTypeMacro(vtkRadixKCompositer,vtkCompositer);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  virtual void CompositeBuffer(vtkDataArray *pBuf, vtkFloatArray *zBuf,
+                               vtkDataArray *pTmp, vtkFloatArray *zTmp);
+
+  // Description:
+  // The largest number of processes that exchange pieces in one round.
+  // 2 gives binary-swap compositing.  Default is 8.
+  vtkSetClampMacro(Radix, int, 2, VTK_INT_MAX);
+  vtkGetMacro(Radix, int);
+
+//BTX
+  enum CompositeModes
+  {
+    Z_BUFFER = 0,
+    ALPHA_BLEND = 1
+  };
+//ETX
+
+  // Description:
+  // Keep the nearest pixel of each process (the default), or blend the
+  // pixels of all processes in the order given by ProcessOrder.
+  vtkSetClampMacro(CompositeMode, int, Z_BUFFER, ALPHA_BLEND);
+  vtkGetMacro(CompositeMode, int);
+  void SetCompositeModeToZBuffer()
+    { this->SetCompositeMode(vtkRadixKCompositer::Z_BUFFER); }
+  void SetCompositeModeToAlphaBlend()
+    { this->SetCompositeMode(vtkRadixKCompositer::ALPHA_BLEND); }
+
+  // Description:
+  // The process ids from front to back, as given for example by
+  // vtkPKdTree::ViewOrderAllProcessesInDirection, for the alpha-blending
+  // mode.  If it is not set, the processes are blended in the order of
+  // their ids, process 0 in front.
+  virtual void SetProcessOrder(vtkIntArray *order);
+  vtkGetObjectMacro(ProcessOrder, vtkIntArray);
+
+protected:
+  vtkRadixKCompositer();
+  ~vtkRadixKCompositer();
+
+  int Radix;
+  int CompositeMode;
+  vtkIntArray *ProcessOrder;
+
+private:
+  vtkRadixKCompositer(const vtkRadixKCompositer&); // Not implemented
+  void operator=(const vtkRadixKCompositer&); // Not implemented
+};
+
+#endif
@@ -0,0 +1 @@
+vtk_module(vtkzstd EXCLUDE_FROM_WRAPPING)